@@ -0,0 +1,283 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Measure the CRC16 and CRC32 throughput.
+ *
+ * The library CRCs are compared with byte-wise table implementations, the way they used to be
+ * computed, over chunks from the size of a small frame up to bulk conversions of captures.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <crc/sbgCrc.h>
+
+// Standard headers
+#include <time.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define CRC_BENCH_BUFFER_SIZE               (1024 * 1024)   /*!< Size of the data the CRCs are computed over, in bytes. */
+#define CRC_BENCH_MIN_DURATION              (0.25)          /*!< Minimum duration of each measurement, in s. */
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Byte-wise lookup tables of the reference implementations.
+ */
+static uint16_t             gCrcBenchCrc16Table[256];
+static uint32_t             gCrcBenchCrc32Table[256];
+
+/*!
+ * Sizes of the data the CRCs are computed over, in bytes.
+ */
+static const size_t         gCrcBenchSizes[] = { 16, 64, 256, 1024, 4096, CRC_BENCH_BUFFER_SIZE };
+
+/*!
+ * Sink of the computed CRCs, so that they aren't optimized out.
+ */
+static volatile uint32_t    gCrcBenchSink;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get the processor time used by the program.
+ *
+ * \return                              Processor time, in s.
+ */
+static double crcBenchGetTime(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*!
+ * Build the byte-wise lookup tables of the reference implementations.
+ */
+static void crcBenchBuildTables(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint16_t            crc16 = (uint16_t)i;
+        uint32_t            crc32 = i << 24;
+
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            crc16 = (crc16 & 1) ? ((crc16 >> 1) ^ 0x8408) : (crc16 >> 1);
+            crc32 = (crc32 & 0x80000000) ? ((crc32 << 1) ^ 0x04C11DB7) : (crc32 << 1);
+        }
+
+        gCrcBenchCrc16Table[i] = crc16;
+        gCrcBenchCrc32Table[i] = crc32;
+    }
+}
+
+/*!
+ * Compute a CRC16 one byte at a time, the way sbgCrc16Compute() used to.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC16.
+ */
+static uint32_t crcBenchReferenceCrc16(const uint8_t *pData, size_t dataSize)
+{
+    uint16_t                crc = 0;
+
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        crc = (crc >> 8) ^ gCrcBenchCrc16Table[(crc ^ pData[i]) & 0xff];
+    }
+
+    return crc;
+}
+
+/*!
+ * Compute a CRC32 one byte at a time, the way sbgCrc32Compute() used to.
+ *
+ * The data is processed as 32-bit words in reversed byte order, the remaining bytes in reversed order.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC32.
+ */
+static uint32_t crcBenchReferenceCrc32(const uint8_t *pData, size_t dataSize)
+{
+    uint32_t                crc = 0xFFFFFFFF;
+    size_t                  nrWordBytes;
+
+    nrWordBytes = dataSize & ~(size_t)0x03;
+
+    for (size_t i = 0; i < nrWordBytes; i++)
+    {
+        crc = (crc << 8) ^ gCrcBenchCrc32Table[(crc >> 24) ^ pData[i ^ 0x03]];
+    }
+
+    for (size_t i = dataSize; i > nrWordBytes; i--)
+    {
+        crc = (crc << 8) ^ gCrcBenchCrc32Table[(crc >> 24) ^ pData[i - 1]];
+    }
+
+    return crc;
+}
+
+/*!
+ * Library CRC16, with the signature of the reference implementations.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC16.
+ */
+static uint32_t crcBenchCrc16(const uint8_t *pData, size_t dataSize)
+{
+    return sbgCrc16Compute(pData, dataSize);
+}
+
+/*!
+ * Library CRC32, with the signature of the reference implementations.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC32.
+ */
+static uint32_t crcBenchCrc32(const uint8_t *pData, size_t dataSize)
+{
+    return sbgCrc32Compute(pData, dataSize);
+}
+
+/*!
+ * Measure the throughput of a CRC implementation.
+ *
+ * The CRC is computed over consecutive chunks of the buffer, until the minimum duration elapses.
+ *
+ * \param[in]   pCrcFunc                CRC implementation.
+ * \param[in]   pBuffer                 Buffer, CRC_BENCH_BUFFER_SIZE bytes.
+ * \param[in]   size                    Size of each chunk, in bytes.
+ * \return                              Throughput, in MB/s.
+ */
+static double crcBenchMeasure(uint32_t (*pCrcFunc)(const uint8_t *pData, size_t dataSize), const uint8_t *pBuffer, size_t size)
+{
+    double                  startTime;
+    double                  duration;
+    size_t                  nrBytes = 0;
+    uint32_t                crc = 0;
+
+    assert(pCrcFunc);
+    assert(pBuffer);
+
+    startTime = crcBenchGetTime();
+
+    do
+    {
+        for (size_t offset = 0; (offset + size) <= CRC_BENCH_BUFFER_SIZE; offset += size)
+        {
+            crc ^= pCrcFunc(&pBuffer[offset], size);
+        }
+
+        nrBytes     += CRC_BENCH_BUFFER_SIZE - (CRC_BENCH_BUFFER_SIZE % size);
+        duration    = crcBenchGetTime() - startTime;
+    } while (duration < CRC_BENCH_MIN_DURATION);
+
+    gCrcBenchSink = crc;
+
+    return (double)nrBytes / duration / 1e6;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    uint8_t                *pBuffer;
+    uint32_t                state = 0x12345678;
+    int                     exitCode = EXIT_SUCCESS;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    pBuffer = malloc(CRC_BENCH_BUFFER_SIZE);
+
+    if (pBuffer)
+    {
+        crcBenchBuildTables();
+
+        for (size_t i = 0; i < CRC_BENCH_BUFFER_SIZE; i++)
+        {
+            state       = state * 1664525 + 1013904223;
+            pBuffer[i]  = (uint8_t)(state >> 24);
+        }
+
+        if ((crcBenchCrc16(pBuffer, CRC_BENCH_BUFFER_SIZE - 3) != crcBenchReferenceCrc16(pBuffer, CRC_BENCH_BUFFER_SIZE - 3)) ||
+            (crcBenchCrc32(pBuffer, CRC_BENCH_BUFFER_SIZE - 3) != crcBenchReferenceCrc32(pBuffer, CRC_BENCH_BUFFER_SIZE - 3)))
+        {
+            printf("CRC mismatch with the byte-wise references\n");
+            exitCode = EXIT_FAILURE;
+        }
+        else
+        {
+            printf("%10s %14s %14s %8s %14s %14s %8s\n", "size", "crc16 ref", "crc16", "speedup", "crc32 ref", "crc32", "speedup");
+
+            for (size_t i = 0; i < SBG_ARRAY_SIZE(gCrcBenchSizes); i++)
+            {
+                size_t      size = gCrcBenchSizes[i];
+                double      crc16Reference;
+                double      crc16;
+                double      crc32Reference;
+                double      crc32;
+
+                crc16Reference  = crcBenchMeasure(crcBenchReferenceCrc16, pBuffer, size);
+                crc16           = crcBenchMeasure(crcBenchCrc16, pBuffer, size);
+                crc32Reference  = crcBenchMeasure(crcBenchReferenceCrc32, pBuffer, size);
+                crc32           = crcBenchMeasure(crcBenchCrc32, pBuffer, size);
+
+                printf("%10zu %9.1f MB/s %9.1f MB/s %7.2fx %9.1f MB/s %9.1f MB/s %7.2fx\n",
+                       size, crc16Reference, crc16, crc16 / crc16Reference, crc32Reference, crc32, crc32 / crc32Reference);
+            }
+        }
+
+        free(pBuffer);
+    }
+    else
+    {
+        printf("unable to allocate the buffer\n");
+        exitCode = EXIT_FAILURE;
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,435 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Measure the payload copies and the time spent per log at 1 kHz.
+ *
+ * One second of IMU short, EKF quaternion and EKF navigation logs at 1 kHz is received through
+ * three paths: sbgEComProtocolReceive() copying each payload into an array before parsing it, the
+ * way sbgEComHandleOneLog() used to, sbgEComProtocolReceive2() parsing each payload in the work
+ * buffer, and sbgEComHandleOneLog() up to the receive log callback.
+ *
+ * The load is the share of one core spent receiving the logs at their nominal rate.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Standard headers
+#include <time.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define LOG_BENCH_RATE                      (1000)          /*!< Output rate of each log, in Hz. */
+#define LOG_BENCH_NR_LOGS_PER_PERIOD        (3)             /*!< Number of logs sent every period. */
+#define LOG_BENCH_DATA_SIZE                 (512 * 1024)    /*!< Size of the buffer holding one second of logs, in bytes. */
+#define LOG_BENCH_MIN_DURATION              (0.5)           /*!< Minimum duration of each measurement, in s. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Read-only interface replaying a stream of logs.
+ */
+typedef struct _LogBenchInterface
+{
+    const uint8_t                       *pData;                     /*!< Stream. */
+    size_t                               size;                      /*!< Stream size, in bytes. */
+    size_t                               offset;                    /*!< Offset of the next byte to read. */
+    size_t                               nrBytesLeft;               /*!< Number of bytes left to read before the interface runs dry. */
+} LogBenchInterface;
+
+/*!
+ * Reception path measured.
+ */
+typedef enum _LogBenchPath
+{
+    LOG_BENCH_PATH_COPY,                                    /*!< sbgEComProtocolReceive() into an array, then sbgEComLogParse(). */
+    LOG_BENCH_PATH_IN_PLACE,                                /*!< sbgEComProtocolReceive2(), then sbgEComLogParse() on the work buffer. */
+    LOG_BENCH_PATH_HANDLE_ONE_LOG,                          /*!< sbgEComHandleOneLog(), up to the receive log callback. */
+} LogBenchPath;
+
+/*!
+ * Results of a measurement.
+ */
+typedef struct _LogBenchResult
+{
+    size_t                               nrLogs;                    /*!< Number of logs received. */
+    bool                                 copiesMeasured;            /*!< True if the payload copies are observable on this path. */
+    size_t                               nrCopiedBytes;             /*!< Number of payload bytes copied before parsing. */
+    double                               duration;                  /*!< Processor time, in s. */
+} LogBenchResult;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get the processor time used by the program.
+ *
+ * \return                              Processor time, in s.
+ */
+static double logBenchGetTime(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*!
+ * Read bytes from the stream, wrapping around at its end.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[out]  pReadBytes              Number of bytes read.
+ * \param[in]   bytesToRead             Maximum number of bytes to read.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode logBenchInterfaceRead(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead)
+{
+    LogBenchInterface                   *pBenchInterface;
+    size_t                               size;
+
+    assert(pInterface);
+    assert(pBuffer);
+    assert(pReadBytes);
+
+    pBenchInterface = pInterface->handle;
+
+    size = sbgMin(bytesToRead, pBenchInterface->nrBytesLeft);
+    size = sbgMin(size, pBenchInterface->size - pBenchInterface->offset);
+
+    memcpy(pBuffer, &pBenchInterface->pData[pBenchInterface->offset], size);
+
+    pBenchInterface->offset         = (pBenchInterface->offset + size) % pBenchInterface->size;
+    pBenchInterface->nrBytesLeft    -= size;
+    *pReadBytes                     = size;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Callback counting the logs received.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msg                     Message ID.
+ * \param[in]   pLogData                Log data.
+ * \param[in]   pUserArg                Number of logs received.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode logBenchOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    size_t                  *pNrLogs = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+    SBG_UNUSED_PARAMETER(msgClass);
+    SBG_UNUSED_PARAMETER(msg);
+    SBG_UNUSED_PARAMETER(pLogData);
+
+    (*pNrLogs)++;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Generate one second of IMU short, EKF quaternion and EKF navigation logs.
+ *
+ * \param[out]  pData                   Stream.
+ * \param[in]   size                    Stream buffer size, in bytes.
+ * \param[out]  pStreamSize             Stream size, in bytes.
+ * \return                              SBG_NO_ERROR if the stream has been generated.
+ */
+static SbgErrorCode logBenchGenerateStream(uint8_t *pData, size_t size, size_t *pStreamSize)
+{
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    SbgStreamBuffer         outputStream;
+
+    assert(pData);
+    assert(pStreamSize);
+
+    sbgStreamBufferInitForWrite(&outputStream, pData, size);
+
+    for (uint32_t i = 0; (i < LOG_BENCH_RATE) && (errorCode == SBG_NO_ERROR); i++)
+    {
+        SbgEComLogImuShort  imuShort;
+        SbgEComLogEkfQuat   ekfQuat;
+        SbgEComLogEkfNav    ekfNav;
+        size_t              streamCursor;
+
+        memset(&imuShort, 0, sizeof(imuShort));
+        memset(&ekfQuat, 0, sizeof(ekfQuat));
+        memset(&ekfNav, 0, sizeof(ekfNav));
+
+        imuShort.timeStamp      = i * (1000000 / LOG_BENCH_RATE);
+        ekfQuat.timeStamp       = imuShort.timeStamp;
+        ekfQuat.quaternion[0]   = 1.0f;
+        ekfNav.timeStamp        = imuShort.timeStamp;
+        ekfNav.position[0]      = 48.8566;
+        ekfNav.position[1]      = 2.3522;
+
+        errorCode = sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, &streamCursor);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComLogImuShortWriteToStream(&imuShort, &outputStream);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_QUAT, &streamCursor);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComLogEkfQuatWriteToStream(&ekfQuat, &outputStream);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, &streamCursor);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComLogEkfNavWriteToStream(&ekfNav, &outputStream);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+        }
+    }
+
+    *pStreamSize = sbgStreamBufferGetLength(&outputStream);
+
+    return errorCode;
+}
+
+/*!
+ * Receive the stream through a reception path until the minimum duration elapses.
+ *
+ * \param[in]   path                    Reception path.
+ * \param[in]   pData                   Stream.
+ * \param[in]   size                    Stream size, in bytes.
+ * \param[out]  pResult                 Results.
+ */
+static void logBenchMeasure(LogBenchPath path, const uint8_t *pData, size_t size, LogBenchResult *pResult)
+{
+    LogBenchInterface       benchInterface;
+    SbgInterface            interface;
+    SbgEComHandle           handle;
+    SbgEComProtocolPayload  payload;
+    double                  startTime;
+
+    assert(pData);
+    assert(pResult);
+
+    memset(pResult, 0, sizeof(*pResult));
+
+    pResult->copiesMeasured = (path != LOG_BENCH_PATH_HANDLE_ONE_LOG);
+
+    benchInterface.pData        = pData;
+    benchInterface.size         = size;
+    benchInterface.offset       = 0;
+    benchInterface.nrBytesLeft  = 0;
+
+    sbgInterfaceZeroInit(&interface);
+
+    interface.handle    = &benchInterface;
+    interface.pReadFunc = logBenchInterfaceRead;
+
+    sbgEComInit(&handle, &interface);
+    sbgEComSetReceiveLogCallback(&handle, logBenchOnLogReceived, &pResult->nrLogs);
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    startTime = logBenchGetTime();
+
+    do
+    {
+        SbgErrorCode        errorCode = SBG_NO_ERROR;
+
+        benchInterface.nrBytesLeft = size;
+
+        while ((benchInterface.nrBytesLeft != 0) || (errorCode == SBG_NO_ERROR))
+        {
+            uint8_t         payloadData[SBG_ECOM_MAX_PAYLOAD_SIZE];
+            SbgEComLogUnion logData;
+            uint8_t         msgClass;
+            uint8_t         msgId;
+            size_t          payloadSize;
+
+            if (path == LOG_BENCH_PATH_COPY)
+            {
+                errorCode = sbgEComProtocolReceive(&handle.protocolHandle, &msgClass, &msgId, payloadData, &payloadSize, sizeof(payloadData));
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    sbgEComLogParse((SbgEComClass)msgClass, (SbgEComMsgId)msgId, payloadData, payloadSize, &logData);
+
+                    pResult->nrCopiedBytes  += payloadSize;
+                    pResult->nrLogs++;
+                }
+            }
+            else if (path == LOG_BENCH_PATH_IN_PLACE)
+            {
+                errorCode = sbgEComProtocolReceive2(&handle.protocolHandle, &msgClass, &msgId, &payload);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    const uint8_t  *pPayloadData = sbgEComProtocolPayloadGetBuffer(&payload);
+
+                    payloadSize = sbgEComProtocolPayloadGetSize(&payload);
+
+                    sbgEComLogParse((SbgEComClass)msgClass, (SbgEComMsgId)msgId, pPayloadData, payloadSize, &logData);
+
+                    //
+                    // Payloads outside of the work buffer have been copied, or reassembled from a large transfer.
+                    //
+                    if ((pPayloadData < handle.protocolHandle.rxBuffer) || (pPayloadData >= &handle.protocolHandle.rxBuffer[sizeof(handle.protocolHandle.rxBuffer)]))
+                    {
+                        pResult->nrCopiedBytes += payloadSize;
+                    }
+
+                    pResult->nrLogs++;
+                }
+            }
+            else
+            {
+                errorCode = sbgEComHandleOneLog(&handle);
+            }
+        }
+
+        pResult->duration = logBenchGetTime() - startTime;
+    } while (pResult->duration < LOG_BENCH_MIN_DURATION);
+
+    sbgEComProtocolPayloadDestroy(&payload);
+    sbgEComClose(&handle);
+}
+
+/*!
+ * Print the results of a measurement.
+ *
+ * \param[in]   pName                   Reception path name.
+ * \param[in]   pResult                 Results.
+ */
+static void logBenchPrint(const char *pName, const LogBenchResult *pResult)
+{
+    double                  timePerLog;
+    double                  load;
+
+    assert(pName);
+    assert(pResult);
+
+    timePerLog  = pResult->duration / pResult->nrLogs;
+    load        = timePerLog * LOG_BENCH_NR_LOGS_PER_PERIOD * LOG_BENCH_RATE;
+
+    if (pResult->copiesMeasured)
+    {
+        printf("%-24s %16.1f %10.1f ns %10.4f %%\n", pName, (double)pResult->nrCopiedBytes / pResult->nrLogs, timePerLog * 1e9, load * 100.0);
+    }
+    else
+    {
+        printf("%-24s %16s %10.1f ns %10.4f %%\n", pName, "-", timePerLog * 1e9, load * 100.0);
+    }
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode;
+    uint8_t                *pData;
+    size_t                  size;
+    int                     exitCode = EXIT_SUCCESS;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    pData = malloc(LOG_BENCH_DATA_SIZE);
+
+    if (pData)
+    {
+        errorCode = logBenchGenerateStream(pData, LOG_BENCH_DATA_SIZE, &size);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            LogBenchResult  result;
+
+            printf("%d Hz IMU short, EKF quaternion and EKF navigation logs, %zu bytes per second\n\n", LOG_BENCH_RATE, size);
+            printf("%-24s %16s %13s %12s\n", "path", "copied bytes/log", "time/log", "load");
+
+            logBenchMeasure(LOG_BENCH_PATH_COPY, pData, size, &result);
+            logBenchPrint("receive and parse", &result);
+
+            logBenchMeasure(LOG_BENCH_PATH_IN_PLACE, pData, size, &result);
+            logBenchPrint("receive2 and parse", &result);
+
+            logBenchMeasure(LOG_BENCH_PATH_HANDLE_ONE_LOG, pData, size, &result);
+            logBenchPrint("sbgEComHandleOneLog", &result);
+        }
+        else
+        {
+            printf("unable to generate the logs: %s\n", sbgErrorCodeToString(errorCode));
+            exitCode = EXIT_FAILURE;
+        }
+
+        free(pData);
+    }
+    else
+    {
+        printf("unable to allocate the stream\n");
+        exitCode = EXIT_FAILURE;
+    }
+
+    return exitCode;
+}
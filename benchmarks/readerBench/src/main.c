@@ -0,0 +1,422 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Measure the reception latency and throughput under a slow consumer.
+ *
+ * IMU short logs are received from a simulated 921600 bd UART, its driver FIFO holding 4 KiB, by
+ * a consumer that stalls 100 ms every 500 logs. They are handled inline by sbgEComHandle(), then
+ * through the reader thread with two frame ring depths.
+ *
+ * Bytes lost in FIFO overflows, frames dropped by the ring, the ring high-water mark, the
+ * throughput and the latency from the arrival of each log to its callback are reported.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define READER_BENCH_NR_LOGS                (4000)          /*!< Number of IMU short logs sent in each run. */
+#define READER_BENCH_BAUD_RATE              (921600)        /*!< Simulated UART baud rate, in bit/s. */
+#define READER_BENCH_FIFO_SIZE              (4096)          /*!< Simulated UART driver FIFO size, in bytes. */
+#define READER_BENCH_SLOW_PERIOD            (500)           /*!< Number of logs between two stalls of the consumer. */
+#define READER_BENCH_STALL_DURATION         (100)           /*!< Duration of a consumer stall, in ms. */
+#define READER_BENCH_DRAIN_DURATION         (500)           /*!< Time given to the consumer to handle the last logs, in ms. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Simulated UART, delivering a stream at its baud rate through a driver FIFO.
+ *
+ * Bytes not read before the FIFO overflows are lost.
+ */
+typedef struct _ReaderBenchUart
+{
+    const uint8_t                       *pData;                     /*!< Stream. */
+    size_t                               size;                      /*!< Stream size, in bytes. */
+    uint32_t                             startTime;                 /*!< Time the first byte has been received, in ms. */
+    size_t                               readOffset;                /*!< Offset of the next byte to read. */
+    size_t                               nrLostBytes;               /*!< Number of bytes lost in FIFO overflows. */
+} ReaderBenchUart;
+
+/*!
+ * Benchmark context.
+ */
+typedef struct _ReaderBenchContext
+{
+    const size_t                        *pEndOffsets;               /*!< Offset of the end of each log in the stream. */
+    uint32_t                             startTime;                 /*!< Time the first byte has been received, in ms. */
+    size_t                               nrLogs;                    /*!< Number of logs received. */
+    uint32_t                             lastLogTime;               /*!< Time the last log has been received, in ms. */
+    uint64_t                             totalLatency;              /*!< Sum of the latencies, in ms. */
+    uint32_t                             maxLatency;                /*!< Maximum latency, in ms. */
+} ReaderBenchContext;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get the time a stream offset is received by the simulated UART.
+ *
+ * \param[in]   offset                  Stream offset.
+ * \return                              Time elapsed since the first byte, in ms.
+ */
+static uint32_t readerBenchGetArrivalTime(size_t offset)
+{
+    return (uint32_t)(((uint64_t)offset * 10 * 1000) / READER_BENCH_BAUD_RATE);
+}
+
+/*!
+ * Log function, discarding the errors reported for the frames truncated by FIFO overflows.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void readerBenchOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Read bytes from the simulated UART FIFO.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[out]  pReadBytes              Number of bytes read.
+ * \param[in]   bytesToRead             Maximum number of bytes to read.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode readerBenchUartRead(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead)
+{
+    ReaderBenchUart                     *pUart;
+    size_t                               nrReceivedBytes;
+    size_t                               size;
+
+    assert(pInterface);
+    assert(pBuffer);
+    assert(pReadBytes);
+
+    pUart = pInterface->handle;
+
+    //
+    // A UART frame is 10 bits long, with its start and stop bits
+    //
+    nrReceivedBytes = (size_t)(((uint64_t)(sbgGetTime() - pUart->startTime) * READER_BENCH_BAUD_RATE) / (10 * 1000));
+    nrReceivedBytes = sbgMin(nrReceivedBytes, pUart->size);
+
+    if ((nrReceivedBytes - pUart->readOffset) > READER_BENCH_FIFO_SIZE)
+    {
+        pUart->nrLostBytes  += nrReceivedBytes - pUart->readOffset - READER_BENCH_FIFO_SIZE;
+        pUart->readOffset   = nrReceivedBytes - READER_BENCH_FIFO_SIZE;
+    }
+
+    size = sbgMin(bytesToRead, nrReceivedBytes - pUart->readOffset);
+
+    memcpy(pBuffer, &pUart->pData[pUart->readOffset], size);
+
+    pUart->readOffset   += size;
+    *pReadBytes         = size;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Callback measuring the latency of the logs, and stalling regularly.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msg                     Message ID.
+ * \param[in]   pLogData                Log data.
+ * \param[in]   pUserArg                Benchmark context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode readerBenchOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msg, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    ReaderBenchContext                  *pContext = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pLogData);
+    assert(pContext);
+
+    if ((msgClass == SBG_ECOM_CLASS_LOG_ECOM_0) && (msg == SBG_ECOM_LOG_IMU_SHORT) && (pLogData->imuShort.timeStamp < READER_BENCH_NR_LOGS))
+    {
+        uint32_t                         time;
+        uint32_t                         latency;
+
+        time    = sbgGetTime() - pContext->startTime;
+        latency = time - sbgMin(time, readerBenchGetArrivalTime(pContext->pEndOffsets[pLogData->imuShort.timeStamp]));
+
+        pContext->nrLogs++;
+        pContext->lastLogTime   = time;
+        pContext->totalLatency  += latency;
+        pContext->maxLatency    = sbgMax(pContext->maxLatency, latency);
+
+        if ((pContext->nrLogs % READER_BENCH_SLOW_PERIOD) == 0)
+        {
+            sbgSleep(READER_BENCH_STALL_DURATION);
+        }
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Generate the IMU short logs, their time stamps holding their index.
+ *
+ * \param[out]  pData                   Stream.
+ * \param[in]   size                    Stream buffer size, in bytes.
+ * \param[out]  pEndOffsets             Offset of the end of each log in the stream.
+ * \param[out]  pStreamSize             Stream size, in bytes.
+ * \return                              SBG_NO_ERROR if the stream has been generated.
+ */
+static SbgErrorCode readerBenchGenerateStream(uint8_t *pData, size_t size, size_t *pEndOffsets, size_t *pStreamSize)
+{
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    SbgStreamBuffer         outputStream;
+
+    assert(pData);
+    assert(pEndOffsets);
+    assert(pStreamSize);
+
+    sbgStreamBufferInitForWrite(&outputStream, pData, size);
+
+    for (uint32_t i = 0; (i < READER_BENCH_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+    {
+        SbgEComLogImuShort  imuShort;
+        size_t              streamCursor;
+
+        memset(&imuShort, 0, sizeof(imuShort));
+
+        imuShort.timeStamp = i;
+
+        errorCode = sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, &streamCursor);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComLogImuShortWriteToStream(&imuShort, &outputStream);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+        }
+
+        pEndOffsets[i] = sbgStreamBufferGetLength(&outputStream);
+    }
+
+    *pStreamSize = sbgStreamBufferGetLength(&outputStream);
+
+    return errorCode;
+}
+
+/*!
+ * Receive the stream from the simulated UART, with or without the reader thread.
+ *
+ * \param[in]   pName                   Run name.
+ * \param[in]   pData                   Stream.
+ * \param[in]   size                    Stream size, in bytes.
+ * \param[in]   pEndOffsets             Offset of the end of each log in the stream.
+ * \param[in]   depth                   Frame ring depth of the reader thread, 0 to handle the logs inline.
+ * \return                              SBG_NO_ERROR if the run has completed.
+ */
+static SbgErrorCode readerBenchRun(const char *pName, const uint8_t *pData, size_t size, const size_t *pEndOffsets, size_t depth)
+{
+    SbgErrorCode            errorCode;
+    ReaderBenchUart         uart;
+    ReaderBenchContext      context;
+    SbgInterface            interface;
+    SbgEComHandle           handle;
+    size_t                  nrDroppedFrames = 0;
+    size_t                  highWaterMark = 0;
+    uint32_t                endTime;
+
+    assert(pName);
+    assert(pData);
+    assert(pEndOffsets);
+
+    memset(&uart, 0, sizeof(uart));
+    memset(&context, 0, sizeof(context));
+
+    uart.pData          = pData;
+    uart.size           = size;
+    context.pEndOffsets = pEndOffsets;
+
+    sbgInterfaceZeroInit(&interface);
+
+    interface.handle    = &uart;
+    interface.pReadFunc = readerBenchUartRead;
+
+    errorCode = sbgEComInit(&handle, &interface);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        sbgEComSetReceiveLogCallback(&handle, readerBenchOnLogReceived, &context);
+
+        uart.startTime      = sbgGetTime();
+        context.startTime   = uart.startTime;
+        endTime             = readerBenchGetArrivalTime(size) + READER_BENCH_DRAIN_DURATION;
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+        if (depth != 0)
+        {
+            SbgEComFrameRingConfig      config;
+
+            config.depth        = depth;
+            config.slotSize     = SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE;
+            config.dropPolicy   = SBG_ECOM_FRAME_RING_DROP_NEWEST;
+
+            errorCode = sbgEComStartReader(&handle, &config);
+        }
+#else
+        SBG_UNUSED_PARAMETER(depth);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+        while ((errorCode == SBG_NO_ERROR) && ((sbgGetTime() - context.startTime) < endTime))
+        {
+            if (sbgEComHandle(&handle) == SBG_NOT_READY)
+            {
+                sbgSleep(1);
+            }
+        }
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+        if ((depth != 0) && (errorCode == SBG_NO_ERROR))
+        {
+            SbgEComFrameRingStats       stats;
+
+            sbgEComGetReaderStats(&handle, &stats);
+            sbgEComStopReader(&handle);
+
+            nrDroppedFrames = stats.nrDroppedFrames;
+            highWaterMark   = stats.highWaterMark;
+        }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+        sbgEComClose(&handle);
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        printf("%-20s %7.1f %% %10zu %10zu %8zu %10.0f %9.1f ms %6" PRIu32 " ms\n", pName,
+               context.nrLogs * 100.0 / READER_BENCH_NR_LOGS, uart.nrLostBytes, nrDroppedFrames, highWaterMark,
+               (context.lastLogTime != 0) ? (context.nrLogs * 1000.0 / context.lastLogTime) : 0.0,
+               (context.nrLogs != 0) ? ((double)context.totalLatency / context.nrLogs) : 0.0, context.maxLatency);
+    }
+    else
+    {
+        printf("%-20s unable to run: %s\n", pName, sbgErrorCodeToString(errorCode));
+    }
+
+    return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode = SBG_MALLOC_FAILED;
+    uint8_t                *pData;
+    size_t                 *pEndOffsets;
+    size_t                  size;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(readerBenchOnLog);
+
+    pData       = malloc(READER_BENCH_NR_LOGS * SBG_ECOM_MAX_BUFFER_SIZE / 8);
+    pEndOffsets = malloc(READER_BENCH_NR_LOGS * sizeof(*pEndOffsets));
+
+    if (pData && pEndOffsets)
+    {
+        errorCode = readerBenchGenerateStream(pData, READER_BENCH_NR_LOGS * SBG_ECOM_MAX_BUFFER_SIZE / 8, pEndOffsets, &size);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            printf("%d IMU short logs, %zu bytes at %d bd, %d bytes FIFO, consumer stalled %d ms every %d logs\n\n",
+                   READER_BENCH_NR_LOGS, size, READER_BENCH_BAUD_RATE, READER_BENCH_FIFO_SIZE, READER_BENCH_STALL_DURATION, READER_BENCH_SLOW_PERIOD);
+            printf("%-20s %9s %10s %10s %8s %10s %12s %9s\n", "mode", "received", "lost bytes", "dropped", "high", "logs/s", "latency", "max");
+
+            errorCode = readerBenchRun("inline", pData, size, pEndOffsets, 0);
+        }
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = readerBenchRun("reader, depth 64", pData, size, pEndOffsets, 64);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = readerBenchRun("reader, depth 256", pData, size, pEndOffsets, SBG_ECOM_FRAME_RING_DEFAULT_DEPTH);
+        }
+#else
+        printf("threads are disabled, the reader thread isn't measured\n");
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    }
+    else
+    {
+        printf("unable to allocate the stream\n");
+    }
+
+    free(pData);
+    free(pEndOffsets);
+
+    return (errorCode == SBG_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,386 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Measure the stream buffer read throughput.
+ *
+ * The little endian scalar readers are compared, at an aligned and an unaligned offset, with
+ * readers assembling each value one byte at a time, the way stream buffers used to without
+ * unaligned access. The time taken by the log parsers to read random payloads is then measured.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Standard headers
+#include <time.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define STREAM_BENCH_BUFFER_SIZE            (64 * 1024)     /*!< Size of the buffer values are read from, in bytes. */
+#define STREAM_BENCH_MIN_DURATION           (0.25)          /*!< Minimum duration of each measurement, in s. */
+#define STREAM_BENCH_NR_PAYLOADS            (64)            /*!< Number of random payloads parsed. */
+#define STREAM_BENCH_PAYLOAD_SIZE           (256)           /*!< Size of the random payloads, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Scalar reader measured.
+ */
+typedef struct _StreamBenchReader
+{
+    const char                          *pName;                                                     /*!< Name. */
+    size_t                               valueSize;                                                 /*!< Value size, in bytes. */
+    uint64_t                           (*pReadFunc)(const uint8_t *pBuffer, size_t size);           /*!< Library reader. */
+    uint64_t                           (*pReferenceFunc)(const uint8_t *pBuffer, size_t size);      /*!< Byte by byte reader. */
+} StreamBenchReader;
+
+/*!
+ * Log parser measured.
+ */
+typedef struct _StreamBenchParser
+{
+    const char                          *pName;                                                     /*!< Name. */
+    SbgErrorCode                       (*pParseFunc)(const uint8_t *pPayload, size_t size);         /*!< Parser. */
+} StreamBenchParser;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Sink of the values read, so that they aren't optimized out.
+ */
+static volatile uint64_t                gStreamBenchSink;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t streamBenchRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Get the processor time used by the program.
+ *
+ * \return                              Processor time, in s.
+ */
+static double streamBenchGetTime(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*!
+ * Read a little endian value one byte at a time, the way stream buffers used to.
+ *
+ * \param[in]   pHandle                 Stream buffer.
+ * \param[in]   size                    Value size, in bytes.
+ * \return                              Value read, 0 on overflow.
+ */
+SBG_INLINE uint64_t streamBenchReferenceRead(SbgStreamBuffer *pHandle, size_t size)
+{
+    uint64_t                value = 0;
+
+    assert(pHandle);
+
+    if (pHandle->errorCode == SBG_NO_ERROR)
+    {
+        if (sbgStreamBufferGetSpace(pHandle) >= size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                value |= (uint64_t)*(pHandle->pCurrentPtr++) << (i * 8);
+            }
+        }
+        else
+        {
+            pHandle->errorCode = SBG_BUFFER_OVERFLOW;
+        }
+    }
+
+    return value;
+}
+
+/*!
+ * Define the library and byte by byte readers of a type.
+ *
+ * Both sum the bit patterns of the values read from a buffer.
+ *
+ * \param[in]   name                    Type name.
+ * \param[in]   type                    Type.
+ * \param[in]   bitsType                Unsigned integer type of the same size.
+ * \param[in]   readFunc                Stream buffer read function.
+ */
+#define STREAM_BENCH_DEFINE(name, type, bitsType, readFunc)                      \
+static uint64_t streamBenchRead##name(const uint8_t *pBuffer, size_t size)       \
+{                                                                                \
+    SbgStreamBuffer         inputStream;                                         \
+    uint64_t                sum = 0;                                             \
+                                                                                 \
+    sbgStreamBufferInitForRead(&inputStream, pBuffer, size);                     \
+                                                                                 \
+    for (size_t i = 0; i < (size / sizeof(type)); i++)                           \
+    {                                                                            \
+        type                value;                                               \
+        bitsType            bits;                                                \
+                                                                                 \
+        value = readFunc(&inputStream);                                          \
+        memcpy(&bits, &value, sizeof(bits));                                     \
+        sum += bits;                                                             \
+    }                                                                            \
+                                                                                 \
+    return sum;                                                                  \
+}                                                                                \
+                                                                                 \
+static uint64_t streamBenchReference##name(const uint8_t *pBuffer, size_t size)  \
+{                                                                                \
+    SbgStreamBuffer         inputStream;                                         \
+    uint64_t                sum = 0;                                             \
+                                                                                 \
+    sbgStreamBufferInitForRead(&inputStream, pBuffer, size);                     \
+                                                                                 \
+    for (size_t i = 0; i < (size / sizeof(type)); i++)                           \
+    {                                                                            \
+        sum += (bitsType)streamBenchReferenceRead(&inputStream, sizeof(type));   \
+    }                                                                            \
+                                                                                 \
+    return sum;                                                                  \
+}
+
+STREAM_BENCH_DEFINE(Uint16, uint16_t, uint16_t, sbgStreamBufferReadUint16LE)
+STREAM_BENCH_DEFINE(Uint32, uint32_t, uint32_t, sbgStreamBufferReadUint32LE)
+STREAM_BENCH_DEFINE(Uint64, uint64_t, uint64_t, sbgStreamBufferReadUint64LE)
+STREAM_BENCH_DEFINE(Float,  float,    uint32_t, sbgStreamBufferReadFloatLE)
+STREAM_BENCH_DEFINE(Double, double,   uint64_t, sbgStreamBufferReadDoubleLE)
+
+/*!
+ * Define the parser of a log, reading a payload into a local log structure.
+ *
+ * \param[in]   name                    Log name.
+ * \param[in]   type                    Log structure type.
+ * \param[in]   readFunc                Log read function.
+ */
+#define STREAM_BENCH_DEFINE_LOG(name, type, readFunc)                            \
+static SbgErrorCode streamBenchParse##name(const uint8_t *pPayload, size_t size) \
+{                                                                                \
+    SbgStreamBuffer         inputStream;                                         \
+    type                    logData;                                             \
+    SbgErrorCode            errorCode;                                           \
+                                                                                 \
+    sbgStreamBufferInitForRead(&inputStream, pPayload, size);                    \
+                                                                                 \
+    errorCode = readFunc(&logData, &inputStream);                                \
+    gStreamBenchSink += *(const uint8_t *)&logData;                              \
+                                                                                 \
+    return errorCode;                                                            \
+}
+
+STREAM_BENCH_DEFINE_LOG(ImuShort,   SbgEComLogImuShort,     sbgEComLogImuShortReadFromStream)
+STREAM_BENCH_DEFINE_LOG(ImuLegacy,  SbgEComLogImuLegacy,    sbgEComLogImuLegacyReadFromStream)
+STREAM_BENCH_DEFINE_LOG(EkfEuler,   SbgEComLogEkfEuler,     sbgEComLogEkfEulerReadFromStream)
+STREAM_BENCH_DEFINE_LOG(EkfQuat,    SbgEComLogEkfQuat,      sbgEComLogEkfQuatReadFromStream)
+STREAM_BENCH_DEFINE_LOG(EkfNav,     SbgEComLogEkfNav,       sbgEComLogEkfNavReadFromStream)
+STREAM_BENCH_DEFINE_LOG(GnssPos,    SbgEComLogGnssPos,      sbgEComLogGnssPosReadFromStream)
+STREAM_BENCH_DEFINE_LOG(Status,     SbgEComLogStatus,       sbgEComLogStatusReadFromStream)
+STREAM_BENCH_DEFINE_LOG(ShipMotion, SbgEComLogShipMotion,   sbgEComLogShipMotionReadFromStream)
+
+/*!
+ * Measure the throughput of a scalar reader.
+ *
+ * \param[in]   pReadFunc               Reader.
+ * \param[in]   pBuffer                 Buffer, STREAM_BENCH_BUFFER_SIZE bytes.
+ * \param[in]   offset                  Offset of the first value in the buffer.
+ * \param[out]  pSum                    Sum of the bit patterns of the values read.
+ * \return                              Throughput, in MB/s.
+ */
+static double streamBenchMeasureReader(uint64_t (*pReadFunc)(const uint8_t *pBuffer, size_t size), const uint8_t *pBuffer, size_t offset, uint64_t *pSum)
+{
+    double                  startTime;
+    double                  duration;
+    size_t                  nrBytes = 0;
+
+    assert(pReadFunc);
+    assert(pBuffer);
+    assert(pSum);
+
+    startTime = streamBenchGetTime();
+
+    do
+    {
+        *pSum       = pReadFunc(&pBuffer[offset], STREAM_BENCH_BUFFER_SIZE - offset);
+        nrBytes     += STREAM_BENCH_BUFFER_SIZE - offset;
+        duration    = streamBenchGetTime() - startTime;
+    } while (duration < STREAM_BENCH_MIN_DURATION);
+
+    gStreamBenchSink += *pSum;
+
+    return (double)nrBytes / duration / 1e6;
+}
+
+/*!
+ * Measure the time taken to parse a log.
+ *
+ * \param[in]   pParseFunc              Parser.
+ * \param[in]   pPayloads               Random payloads, STREAM_BENCH_NR_PAYLOADS of STREAM_BENCH_PAYLOAD_SIZE bytes.
+ * \return                              Time per log, in ns.
+ */
+static double streamBenchMeasureParser(SbgErrorCode (*pParseFunc)(const uint8_t *pPayload, size_t size), const uint8_t *pPayloads)
+{
+    double                  startTime;
+    double                  duration;
+    size_t                  nrLogs = 0;
+
+    assert(pParseFunc);
+    assert(pPayloads);
+
+    startTime = streamBenchGetTime();
+
+    do
+    {
+        for (size_t i = 0; i < STREAM_BENCH_NR_PAYLOADS; i++)
+        {
+            pParseFunc(&pPayloads[i * STREAM_BENCH_PAYLOAD_SIZE], STREAM_BENCH_PAYLOAD_SIZE);
+        }
+
+        nrLogs      += STREAM_BENCH_NR_PAYLOADS;
+        duration    = streamBenchGetTime() - startTime;
+    } while (duration < STREAM_BENCH_MIN_DURATION);
+
+    return duration / nrLogs * 1e9;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static const StreamBenchReader      readers[] =
+    {
+        { "uint16",     sizeof(uint16_t),   streamBenchReadUint16,  streamBenchReferenceUint16  },
+        { "uint32",     sizeof(uint32_t),   streamBenchReadUint32,  streamBenchReferenceUint32  },
+        { "uint64",     sizeof(uint64_t),   streamBenchReadUint64,  streamBenchReferenceUint64  },
+        { "float",      sizeof(float),      streamBenchReadFloat,   streamBenchReferenceFloat   },
+        { "double",     sizeof(double),     streamBenchReadDouble,  streamBenchReferenceDouble  },
+    };
+    static const StreamBenchParser      parsers[] =
+    {
+        { "IMU short",      streamBenchParseImuShort    },
+        { "IMU legacy",     streamBenchParseImuLegacy   },
+        { "EKF Euler",      streamBenchParseEkfEuler    },
+        { "EKF quaternion", streamBenchParseEkfQuat     },
+        { "EKF navigation", streamBenchParseEkfNav      },
+        { "GNSS position",  streamBenchParseGnssPos     },
+        { "status",         streamBenchParseStatus      },
+        { "ship motion",    streamBenchParseShipMotion  },
+    };
+    uint8_t                            *pBuffer;
+    uint32_t                            state = 0x12345678;
+    int                                 exitCode = EXIT_SUCCESS;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    pBuffer = malloc(STREAM_BENCH_BUFFER_SIZE);
+
+    if (pBuffer)
+    {
+        for (size_t i = 0; i < STREAM_BENCH_BUFFER_SIZE; i++)
+        {
+            pBuffer[i] = (uint8_t)streamBenchRandom(&state);
+        }
+
+        printf("%-8s %6s %14s %14s %8s\n", "type", "offset", "byte by byte", "stream buffer", "speedup");
+
+        for (size_t i = 0; i < SBG_ARRAY_SIZE(readers); i++)
+        {
+            for (size_t offset = 0; offset < 2; offset++)
+            {
+                double          reference;
+                double          library;
+                uint64_t        referenceSum;
+                uint64_t        librarySum;
+
+                reference   = streamBenchMeasureReader(readers[i].pReferenceFunc, pBuffer, offset, &referenceSum);
+                library     = streamBenchMeasureReader(readers[i].pReadFunc, pBuffer, offset, &librarySum);
+
+                printf("%-8s %6zu %9.1f MB/s %9.1f MB/s %7.2fx\n", readers[i].pName, offset, reference, library, library / reference);
+
+                if (referenceSum != librarySum)
+                {
+                    printf("%s values mismatch at offset %zu\n", readers[i].pName, offset);
+                    exitCode = EXIT_FAILURE;
+                }
+            }
+        }
+
+        printf("\n%-16s %12s\n", "log", "parse time");
+
+        for (size_t i = 0; i < SBG_ARRAY_SIZE(parsers); i++)
+        {
+            printf("%-16s %9.1f ns\n", parsers[i].pName, streamBenchMeasureParser(parsers[i].pParseFunc, pBuffer));
+        }
+
+        free(pBuffer);
+    }
+    else
+    {
+        printf("unable to allocate the buffer\n");
+        exitCode = EXIT_FAILURE;
+    }
+
+    return exitCode;
+}
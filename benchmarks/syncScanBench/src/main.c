@@ -0,0 +1,486 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Measure the SYNC bytes scanning throughput.
+ *
+ * Random data, where SYNC sequences are rare, measures the scanner alone. A capture of NMEA
+ * sentences interleaved with sbgECom logs measures a realistic mix of scanning and frame
+ * validation. Capture files can be given as arguments.
+ *
+ * Each data set is scanned with a byte pair loop, the way the SYNC bytes used to be searched, and
+ * received by the protocol.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Standard headers
+#include <time.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SYNC_BENCH_DATA_SIZE                (8 * 1024 * 1024)   /*!< Size of the generated data sets, in bytes. */
+#define SYNC_BENCH_MIN_DURATION             (0.5)               /*!< Minimum duration of each measurement, in s. */
+#define SYNC_BENCH_MAX_PAYLOAD_SIZE         (120)               /*!< Maximum payload size of the generated frames, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Read-only interface replaying a data set.
+ */
+typedef struct _SyncBenchInterface
+{
+    const uint8_t                       *pData;                     /*!< Data set. */
+    size_t                               size;                      /*!< Data set size, in bytes. */
+    size_t                               offset;                    /*!< Offset of the next byte to read. */
+    size_t                               nrBytesLeft;               /*!< Number of bytes left to read before the interface runs dry. */
+} SyncBenchInterface;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Sink of the reference scanner results, so that they aren't optimized out.
+ */
+static volatile size_t                  gSyncBenchSink;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t syncBenchRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Get the processor time used by the program.
+ *
+ * \return                              Processor time, in s.
+ */
+static double syncBenchGetTime(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/*!
+ * Log function, discarding the errors reported for the SYNC sequences found in random data.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void syncBenchOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Read bytes from the data set, wrapping around at its end.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[out]  pReadBytes              Number of bytes read.
+ * \param[in]   bytesToRead             Maximum number of bytes to read.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode syncBenchInterfaceRead(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead)
+{
+    SyncBenchInterface                  *pBenchInterface;
+    size_t                               size;
+
+    assert(pInterface);
+    assert(pBuffer);
+    assert(pReadBytes);
+
+    pBenchInterface = pInterface->handle;
+
+    size = sbgMin(bytesToRead, pBenchInterface->nrBytesLeft);
+    size = sbgMin(size, pBenchInterface->size - pBenchInterface->offset);
+
+    memcpy(pBuffer, &pBenchInterface->pData[pBenchInterface->offset], size);
+
+    pBenchInterface->offset         = (pBenchInterface->offset + size) % pBenchInterface->size;
+    pBenchInterface->nrBytesLeft    -= size;
+    *pReadBytes                     = size;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Generate random bytes.
+ *
+ * \param[out]  pData                   Data set.
+ * \param[in]   size                    Data set size, in bytes.
+ * \param[in]   pState                  Generator state.
+ */
+static void syncBenchGenerateRandom(uint8_t *pData, size_t size, uint32_t *pState)
+{
+    assert(pData);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pData[i] = (uint8_t)syncBenchRandom(pState);
+    }
+}
+
+/*!
+ * Generate a capture of NMEA sentences interleaved with sbgECom logs.
+ *
+ * \param[out]  pData                   Data set.
+ * \param[in]   size                    Data set size, in bytes.
+ * \param[in]   pState                  Generator state.
+ */
+static void syncBenchGenerateCapture(uint8_t *pData, size_t size, uint32_t *pState)
+{
+    static const char       sentence[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    SbgStreamBuffer         outputStream;
+    size_t                  length = 0;
+
+    assert(pData);
+
+    sbgStreamBufferInitForWrite(&outputStream, pData, size);
+
+    while (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgStreamBufferWriteBuffer(&outputStream, sentence, sizeof(sentence) - 1);
+
+        for (size_t i = 0; (i < 3) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            uint8_t             payload[SYNC_BENCH_MAX_PAYLOAD_SIZE];
+            size_t              payloadSize;
+            size_t              streamCursor;
+
+            payloadSize = syncBenchRandom(pState) % (SYNC_BENCH_MAX_PAYLOAD_SIZE + 1);
+            syncBenchGenerateRandom(payload, payloadSize, pState);
+
+            errorCode = sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(syncBenchRandom(pState) % 128), &streamCursor);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgStreamBufferWriteBuffer(&outputStream, payload, payloadSize);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                length = sbgStreamBufferGetLength(&outputStream);
+            }
+        }
+    }
+
+    //
+    // Fill the end of the buffer, too small for another frame, with NMEA sentence characters.
+    //
+    memset(&pData[length], 'A', size - length);
+}
+
+/*!
+ * Load a capture file.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[out]  ppData                  Data set, allocated with malloc().
+ * \param[out]  pSize                   Data set size, in bytes.
+ * \return                              SBG_NO_ERROR if the capture has been loaded.
+ */
+static SbgErrorCode syncBenchLoadCapture(const char *pFileName, uint8_t **ppData, size_t *pSize)
+{
+    SbgErrorCode            errorCode = SBG_READ_ERROR;
+    FILE                   *pFile;
+
+    assert(pFileName);
+    assert(ppData);
+    assert(pSize);
+
+    pFile = fopen(pFileName, "rb");
+
+    if (pFile)
+    {
+        long                fileSize;
+
+        if (fseek(pFile, 0, SEEK_END) == 0)
+        {
+            fileSize = ftell(pFile);
+
+            if ((fileSize > 0) && (fseek(pFile, 0, SEEK_SET) == 0))
+            {
+                *ppData = malloc((size_t)fileSize);
+
+                if (*ppData)
+                {
+                    if (fread(*ppData, 1, (size_t)fileSize, pFile) == (size_t)fileSize)
+                    {
+                        *pSize      = (size_t)fileSize;
+                        errorCode   = SBG_NO_ERROR;
+                    }
+                    else
+                    {
+                        free(*ppData);
+                    }
+                }
+                else
+                {
+                    errorCode = SBG_MALLOC_FAILED;
+                }
+            }
+        }
+
+        fclose(pFile);
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Measure the throughput of a byte pair scanner, the way the SYNC bytes used to be searched.
+ *
+ * \param[in]   pData                   Data set.
+ * \param[in]   size                    Data set size, in bytes.
+ * \return                              Throughput, in GB/s.
+ */
+static double syncBenchMeasureReference(const uint8_t *pData, size_t size)
+{
+    double                  startTime;
+    double                  duration;
+    size_t                  nrBytes = 0;
+    size_t                  nrSyncs = 0;
+
+    assert(pData);
+
+    startTime = syncBenchGetTime();
+
+    do
+    {
+        for (size_t i = 0; (i + 1) < size; i++)
+        {
+            if ((pData[i] == SBG_ECOM_SYNC_1) && (pData[i + 1] == SBG_ECOM_SYNC_2))
+            {
+                nrSyncs++;
+            }
+        }
+
+        nrBytes     += size;
+        duration    = syncBenchGetTime() - startTime;
+    } while (duration < SYNC_BENCH_MIN_DURATION);
+
+    gSyncBenchSink = nrSyncs;
+
+    return (double)nrBytes / duration / 1e9;
+}
+
+/*!
+ * Measure the throughput of the protocol receiving a data set.
+ *
+ * \param[in]   pData                   Data set.
+ * \param[in]   size                    Data set size, in bytes.
+ * \param[out]  pNrFrames               Number of frames received in each pass over the data set.
+ * \return                              Throughput, in GB/s.
+ */
+static double syncBenchMeasureProtocol(const uint8_t *pData, size_t size, size_t *pNrFrames)
+{
+    SyncBenchInterface      benchInterface;
+    SbgInterface            interface;
+    SbgEComProtocol         protocol;
+    SbgEComProtocolPayload  payload;
+    double                  startTime;
+    double                  duration;
+    size_t                  nrBytes = 0;
+    size_t                  nrFrames = 0;
+    size_t                  nrPasses = 0;
+
+    assert(pData);
+    assert(pNrFrames);
+
+    benchInterface.pData        = pData;
+    benchInterface.size         = size;
+    benchInterface.offset       = 0;
+    benchInterface.nrBytesLeft  = 0;
+
+    sbgInterfaceZeroInit(&interface);
+
+    interface.handle    = &benchInterface;
+    interface.pReadFunc = syncBenchInterfaceRead;
+
+    sbgEComProtocolInit(&protocol, &interface);
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    startTime = syncBenchGetTime();
+
+    do
+    {
+        SbgErrorCode        errorCode = SBG_NO_ERROR;
+
+        benchInterface.nrBytesLeft = size;
+
+        while ((benchInterface.nrBytesLeft != 0) || (errorCode == SBG_NO_ERROR))
+        {
+            uint8_t         msgClass;
+            uint8_t         msgId;
+
+            errorCode = sbgEComProtocolReceive2(&protocol, &msgClass, &msgId, &payload);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                nrFrames++;
+            }
+        }
+
+        nrBytes     += size;
+        nrPasses++;
+        duration    = syncBenchGetTime() - startTime;
+    } while (duration < SYNC_BENCH_MIN_DURATION);
+
+    sbgEComProtocolPayloadDestroy(&payload);
+    sbgEComProtocolClose(&protocol);
+
+    *pNrFrames = nrFrames / nrPasses;
+
+    return (double)nrBytes / duration / 1e9;
+}
+
+/*!
+ * Measure and print the throughputs for a data set.
+ *
+ * \param[in]   pName                   Data set name.
+ * \param[in]   pData                   Data set.
+ * \param[in]   size                    Data set size, in bytes.
+ */
+static void syncBenchRun(const char *pName, const uint8_t *pData, size_t size)
+{
+    double                  reference;
+    double                  protocol;
+    size_t                  nrFrames;
+
+    assert(pName);
+    assert(pData);
+
+    reference   = syncBenchMeasureReference(pData, size);
+    protocol    = syncBenchMeasureProtocol(pData, size, &nrFrames);
+
+    printf("%-24s %12zu %10zu %8.3f GB/s %8.3f GB/s\n", pName, size, nrFrames, reference, protocol);
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * Capture files given as arguments are measured after the generated data sets.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    uint8_t                *pData;
+    uint32_t                state = 0xdeadbeef;
+    int                     exitCode = EXIT_SUCCESS;
+
+    sbgCommonLibSetLogCallback(syncBenchOnLog);
+
+    pData = malloc(SYNC_BENCH_DATA_SIZE);
+
+    if (pData)
+    {
+        printf("%-24s %12s %10s %13s %13s\n", "data set", "size", "frames", "byte pairs", "protocol");
+
+        syncBenchGenerateRandom(pData, SYNC_BENCH_DATA_SIZE, &state);
+        syncBenchRun("random", pData, SYNC_BENCH_DATA_SIZE);
+
+        syncBenchGenerateCapture(pData, SYNC_BENCH_DATA_SIZE, &state);
+        syncBenchRun("NMEA and sbgECom", pData, SYNC_BENCH_DATA_SIZE);
+
+        free(pData);
+    }
+    else
+    {
+        printf("unable to allocate the data set\n");
+        exitCode = EXIT_FAILURE;
+    }
+
+    for (int i = 1; (i < argc) && (exitCode == EXIT_SUCCESS); i++)
+    {
+        SbgErrorCode        errorCode;
+        size_t              size;
+
+        errorCode = syncBenchLoadCapture(argv[i], &pData, &size);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            syncBenchRun(argv[i], pData, size);
+            free(pData);
+        }
+        else
+        {
+            printf("unable to load %s: %s\n", argv[i], sbgErrorCodeToString(errorCode));
+            exitCode = EXIT_FAILURE;
+        }
+    }
+
+    return exitCode;
+}
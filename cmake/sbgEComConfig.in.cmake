@@ -2,4 +2,10 @@
 
 @PACKAGE_INIT@
 
+include(CMakeFindDependencyMacro)
+
+if (@USE_THREADS@)
+    find_dependency(Threads)
+endif()
+
 include("${CMAKE_CURRENT_LIST_DIR}/sbgEComTargets.cmake")
\ No newline at end of file
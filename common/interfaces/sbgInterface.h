@@ -83,6 +83,15 @@ typedef struct _SbgInterface SbgInterface;
  */
 typedef void* SbgInterfaceHandle;
 
+/*!
+ * Buffer descriptor used for scatter-gather write operations.
+ */
+typedef struct _SbgInterfaceIoVec
+{
+    const void                  *pBuffer;                           /*!< Buffer that contains the data to write. */
+    size_t                       size;                              /*!< Buffer size in bytes (can be zero). */
+} SbgInterfaceIoVec;
+
 //----------------------------------------------------------------------//
 //- Callbacks definitions                                              -//
 //----------------------------------------------------------------------//
@@ -108,6 +117,19 @@ typedef SbgErrorCode (*SbgInterfaceDestroyFunc)(SbgInterface *pInterface);
  */
 typedef SbgErrorCode (*SbgInterfaceWriteFunc)(SbgInterface *pInterface, const void *pBuffer, size_t bytesToWrite);
 
+/*!
+ * Method to implement to write several buffers to an interface in a single operation.
+ *
+ * The buffers are written in order, as if they were concatenated. This method should return an
+ * error only if all bytes were not written successfully.
+ *
+ * \param[in]   pInterface                              Interface instance.
+ * \param[in]   pIoVecs                                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                                Number of buffer descriptors (can be zero).
+ * \return                                              SBG_NO_ERROR if all bytes have been written successfully.
+ */
+typedef SbgErrorCode (*SbgInterfaceWriteVFunc)(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs);
+
 /*!
  * Method to implement to read data from an interface.
  *
@@ -123,6 +145,18 @@ typedef SbgErrorCode (*SbgInterfaceWriteFunc)(SbgInterface *pInterface, const vo
  */
 typedef SbgErrorCode (*SbgInterfaceReadFunc)(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead);
 
+/*!
+ * Method to implement to wait until data can be read from an interface.
+ *
+ * The method may return early, for example when interrupted by a signal, the caller then
+ * tries to read and waits again if no data is available.
+ *
+ * \param[in]   pInterface                              Interface instance.
+ * \param[in]   timeOut                                 Maximum time to wait, in us.
+ * \return                                              SBG_NO_ERROR if data may be read, SBG_TIME_OUT if no data has been received in time.
+ */
+typedef SbgErrorCode (*SbgInterfaceWaitFunc)(SbgInterface *pInterface, uint32_t timeOut);
+
 /*!
  * Make an interface flush pending input and/or output data.
  *
@@ -202,6 +236,8 @@ struct _SbgInterface
     SbgInterfaceSetSpeed         pSetSpeedFunc;                     /*!< Optional method used to set the interface speed in bps. */
     SbgInterfaceGetSpeed         pGetSpeedFunc;                     /*!< Optional method used to retrieve the interface speed in bps. */
     SbgInterfaceGetDelayFunc     pDelayFunc;                        /*!< Optional method used to compute an expected delay to transmit/receive X bytes */
+    SbgInterfaceWriteVFunc       pWriteVFunc;                       /*!< Optional method used to write several buffers to this interface at once. */
+    SbgInterfaceWaitFunc         pWaitFunc;                         /*!< Optional method used to wait until data can be read from this interface. */
 };
 
 //----------------------------------------------------------------------//
@@ -304,6 +340,50 @@ SBG_INLINE SbgErrorCode sbgInterfaceWrite(SbgInterface *pInterface, const void *
     return errorCode;
 }
 
+/*!
+ * Write several buffers to an interface.
+ *
+ * The buffers are written in order, as if they were concatenated. If the interface doesn't
+ * implement scatter-gather writes, each buffer is written in turn, which may not be appropriate
+ * for datagram based interfaces.
+ *
+ * \param[in]   pInterface                              Interface instance.
+ * \param[in]   pIoVecs                                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                                Number of buffer descriptors (can be zero).
+ * \return                                              SBG_NO_ERROR if all bytes have been written successfully.
+ *                                                      SBG_INVALID_PARAMETER if the interface doesn't support write operations.
+ */
+SBG_INLINE SbgErrorCode sbgInterfaceWriteV(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs)
+{
+    SbgErrorCode    errorCode;
+
+    assert(pInterface);
+    assert(pIoVecs || (nrIoVecs == 0));
+
+    if (pInterface->pWriteVFunc)
+    {
+        errorCode = pInterface->pWriteVFunc(pInterface, pIoVecs, nrIoVecs);
+    }
+    else if (pInterface->pWriteFunc)
+    {
+        errorCode = SBG_NO_ERROR;
+
+        for (size_t i = 0; (i < nrIoVecs) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            if (pIoVecs[i].size != 0)
+            {
+                errorCode = pInterface->pWriteFunc(pInterface, pIoVecs[i].pBuffer, pIoVecs[i].size);
+            }
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+    }
+
+    return errorCode;
+}
+
 /*!
  * Try to read some data from an interface.
  *
@@ -339,6 +419,39 @@ SBG_INLINE SbgErrorCode sbgInterfaceRead(SbgInterface *pInterface, void *pBuffer
     return errorCode;
 }
 
+/*!
+ * Wait until data can be read from an interface.
+ *
+ * If the interface can't wait for incoming data, this method sleeps for 1 ms, or returns
+ * immediately if the time out is zero, and reports that data may be read.
+ *
+ * \param[in]   pInterface                              Interface instance.
+ * \param[in]   timeOut                                 Maximum time to wait, in us.
+ * \return                                              SBG_NO_ERROR if data may be read, SBG_TIME_OUT if no data has been received in time.
+ */
+SBG_INLINE SbgErrorCode sbgInterfaceWait(SbgInterface *pInterface, uint32_t timeOut)
+{
+    SbgErrorCode    errorCode;
+
+    assert(pInterface);
+
+    if (pInterface->pWaitFunc)
+    {
+        errorCode = pInterface->pWaitFunc(pInterface, timeOut);
+    }
+    else
+    {
+        if (timeOut != 0)
+        {
+            sbgSleep(1);
+        }
+
+        errorCode = SBG_NO_ERROR;
+    }
+
+    return errorCode;
+}
+
 /*!
  * Make an interface flush pending input and/or output data.
  *
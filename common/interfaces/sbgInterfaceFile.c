@@ -80,6 +80,38 @@ static SbgErrorCode sbgInterfaceFileWrite(SbgInterface *pInterface, const void *
     }
 }
 
+/*!
+ * Write several buffers to the file.
+ *
+ * \param[in]   pInterface                              Valid handle on an initialized interface.
+ * \param[in]   pIoVecs                                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                                Number of buffer descriptors.
+ * \return                                              SBG_NO_ERROR if all bytes have been written successfully.
+ */
+static SbgErrorCode sbgInterfaceFileWriteV(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs)
+{
+    FILE    *pOutputFile;
+
+    assert(pInterface);
+    assert(pInterface->type == SBG_IF_TYPE_FILE);
+    assert(pIoVecs || (nrIoVecs == 0));
+
+    pOutputFile = sbgInterfaceFileGetDesc(pInterface);
+
+    //
+    // The file stream is buffered, so each buffer is simply written in turn
+    //
+    for (size_t i = 0; i < nrIoVecs; i++)
+    {
+        if (fwrite(pIoVecs[i].pBuffer, sizeof(uint8_t), pIoVecs[i].size, pOutputFile) != pIoVecs[i].size)
+        {
+            return SBG_WRITE_ERROR;
+        }
+    }
+
+    return SBG_NO_ERROR;
+}
+
 /*!
  * Try to read some data from an interface.
  * 
@@ -209,6 +241,7 @@ SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceFileOpen(SbgInterface *pInterface, c
         pInterface->pDestroyFunc    = sbgInterfaceFileDestroy;
         pInterface->pReadFunc       = sbgInterfaceFileRead;
         pInterface->pWriteFunc      = NULL;
+        pInterface->pWriteVFunc     = NULL;
         pInterface->pFlushFunc      = sbgInterfaceFileFlush;
     }
     else
@@ -257,6 +290,7 @@ SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceFileWriteOpen(SbgInterface *pInterfa
         pInterface->pDestroyFunc    = sbgInterfaceFileDestroy;
         pInterface->pReadFunc       = NULL;
         pInterface->pWriteFunc      = sbgInterfaceFileWrite;
+        pInterface->pWriteVFunc     = sbgInterfaceFileWriteV;
         pInterface->pFlushFunc      = sbgInterfaceFileFlush;
     }
     else
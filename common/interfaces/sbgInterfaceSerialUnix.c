@@ -5,7 +5,9 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <termios.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 
 // sbgCommonLib headers
 #include <sbgCommon.h>
@@ -16,6 +18,7 @@
 //----------------------------------------------------------------------//
 #define SBG_IF_SERIAL_TX_BUFFER_SIZE            (4096u)                 /*!< Define the transmission buffer size for the serial port. */
 #define SBG_IF_SERIAL_RX_BUFFER_SIZE            (4096u)                 /*!< Define the reception buffer size for the serial port. */
+#define SBG_IF_SERIAL_MAX_IOVECS                (16u)                   /*!< Maximum number of buffers written by a single writev() call. */
 
 //----------------------------------------------------------------------//
 //- Private methods declarations                                       -//
@@ -336,6 +339,90 @@ static SbgErrorCode sbgInterfaceSerialWrite(SbgInterface *pInterface, const void
     return SBG_NO_ERROR;
 }
 
+/*!
+ * Try to write several buffers to an interface.
+ *
+ * \param[in]   pInterface                              Valid handle on an initialized interface.
+ * \param[in]   pIoVecs                                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                                Number of buffer descriptors.
+ * \return                                              SBG_NO_ERROR if all bytes have been written successfully.
+ */
+static SbgErrorCode sbgInterfaceSerialWriteV(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs)
+{
+    size_t          index = 0;
+    size_t          offset = 0;
+    int             hSerialHandle;
+
+    assert(pInterface);
+    assert(pInterface->type == SBG_IF_TYPE_SERIAL);
+    assert(pIoVecs || (nrIoVecs == 0));
+
+    //
+    // Get the internal serial handle
+    //
+    hSerialHandle = *((int*)pInterface->handle);
+
+    //
+    // Write all buffers, the index and offset locate the first byte not written yet
+    //
+    while (index < nrIoVecs)
+    {
+        struct iovec    ioVecs[SBG_IF_SERIAL_MAX_IOVECS];
+        int             nrUnixIoVecs = 0;
+        ssize_t         numBytesWritten;
+
+        for (size_t i = index; (i < nrIoVecs) && (nrUnixIoVecs < (int)SBG_IF_SERIAL_MAX_IOVECS); i++)
+        {
+            size_t      skipSize = (i == index) ? offset : 0;
+
+            if (pIoVecs[i].size > skipSize)
+            {
+                ioVecs[nrUnixIoVecs].iov_base   = (uint8_t*)pIoVecs[i].pBuffer + skipSize;
+                ioVecs[nrUnixIoVecs].iov_len    = pIoVecs[i].size - skipSize;
+                nrUnixIoVecs++;
+            }
+        }
+
+        if (nrUnixIoVecs == 0)
+        {
+            break;
+        }
+
+        numBytesWritten = writev(hSerialHandle, ioVecs, nrUnixIoVecs);
+
+        if (numBytesWritten == -1)
+        {
+            if (errno == EAGAIN)
+            {
+                sbgSleep(1);
+            }
+            else
+            {
+                SBG_LOG_ERROR(SBG_WRITE_ERROR, "unable to write to the device: %s", strerror(errno));
+                return SBG_WRITE_ERROR;
+            }
+        }
+        else
+        {
+            size_t      numBytesLeft = (size_t)numBytesWritten;
+
+            //
+            // Skip the buffers written, the last one may have been partially written
+            //
+            while ((index < nrIoVecs) && (numBytesLeft >= (pIoVecs[index].size - offset)))
+            {
+                numBytesLeft -= pIoVecs[index].size - offset;
+                index++;
+                offset = 0;
+            }
+
+            offset += numBytesLeft;
+        }
+    }
+
+    return SBG_NO_ERROR;
+}
+
 /*!
  * Try to read some data from an interface.
  * 
@@ -395,6 +482,55 @@ static SbgErrorCode sbgInterfaceSerialRead(SbgInterface *pInterface, void *pBuff
     return errorCode;
 }
 
+/*!
+ * Wait until data can be read from an interface.
+ *
+ * \param[in]   pInterface                              Valid handle on an initialized interface.
+ * \param[in]   timeOut                                 Maximum time to wait, in us.
+ * \return                                              SBG_NO_ERROR if data may be read, SBG_TIME_OUT if no data has been received in time.
+ */
+static SbgErrorCode sbgInterfaceSerialWait(SbgInterface *pInterface, uint32_t timeOut)
+{
+    SbgErrorCode    errorCode;
+    struct pollfd   pollFd;
+    int             ret;
+
+    assert(pInterface);
+    assert(pInterface->type == SBG_IF_TYPE_SERIAL);
+
+    pollFd.fd       = *((int*)pInterface->handle);
+    pollFd.events   = POLLIN;
+    pollFd.revents  = 0;
+
+    //
+    // Round the time out up to the poll() resolution
+    //
+    ret = poll(&pollFd, 1, (int)((timeOut / 1000) + (((timeOut % 1000) != 0) ? 1 : 0)));
+
+    if (ret > 0)
+    {
+        //
+        // Errors and hang ups are reported by the next read
+        //
+        errorCode = SBG_NO_ERROR;
+    }
+    else if (ret == 0)
+    {
+        errorCode = SBG_TIME_OUT;
+    }
+    else if (errno == EINTR)
+    {
+        errorCode = SBG_NO_ERROR;
+    }
+    else
+    {
+        errorCode = SBG_READ_ERROR;
+        SBG_LOG_ERROR(errorCode, "unable to wait for data: %s", strerror(errno));
+    }
+
+    return errorCode;
+}
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
@@ -495,6 +631,8 @@ SbgErrorCode sbgInterfaceSerialCreate(SbgInterface *pInterface, const char *devi
                         pInterface->pDestroyFunc    = sbgInterfaceSerialDestroy;
                         pInterface->pReadFunc       = sbgInterfaceSerialRead;
                         pInterface->pWriteFunc      = sbgInterfaceSerialWrite;
+                        pInterface->pWriteVFunc     = sbgInterfaceSerialWriteV;
+                        pInterface->pWaitFunc       = sbgInterfaceSerialWait;
                         pInterface->pFlushFunc      = sbgInterfaceSerialFlush;
                         pInterface->pSetSpeedFunc   = sbgInterfaceSerialChangeBaudrate;
 
@@ -12,12 +12,14 @@
 #define SOCKLEN             int
 #else // WIN32
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #define SOCKADDR_IN         struct sockaddr_in
 #define SOCKADDR            struct sockaddr
@@ -36,6 +38,7 @@
 //----------------------------------------------------------------------//
 
 #define SBG_INTERFACE_UDP_PACKET_MAX_SIZE       (1400)
+#define SBG_INTERFACE_UDP_MAX_IOVECS            (16)
 
 /*!
  * Structure that stores all internal data used by the UDP interface.
@@ -261,6 +264,94 @@ static SbgErrorCode sbgInterfaceUdpWrite(SbgInterface *pInterface, const void *p
     return errorCode;
 }
 
+#ifndef WIN32
+/*!
+ * Try to write several buffers to an interface.
+ *
+ * Buffers are gathered in datagrams of at most SBG_INTERFACE_UDP_PACKET_MAX_SIZE bytes.
+ *
+ * \param[in]   pInterface                              Valid handle on an initialized interface.
+ * \param[in]   pIoVecs                                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                                Number of buffer descriptors.
+ * \return                                              SBG_NO_ERROR if all bytes have been written successfully.
+ */
+static SbgErrorCode sbgInterfaceUdpWriteV(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs)
+{
+    SbgErrorCode             errorCode = SBG_NO_ERROR;
+    SbgInterfaceUdp         *pUdpHandle;
+    SOCKADDR_IN              outAddr;
+    size_t                   index = 0;
+    size_t                   offset = 0;
+
+    assert(pInterface);
+    assert(pInterface->type == SBG_IF_TYPE_ETH_UDP);
+    assert(pIoVecs || (nrIoVecs == 0));
+
+    pUdpHandle = sbgInterfaceUdpGet(pInterface);
+
+    outAddr.sin_family      = AF_INET;
+    outAddr.sin_addr.s_addr = pUdpHandle->remoteAddr;
+    outAddr.sin_port        = htons((uint16_t)pUdpHandle->remotePort);
+
+    while (index < nrIoVecs)
+    {
+        struct iovec         ioVecs[SBG_INTERFACE_UDP_MAX_IOVECS];
+        struct msghdr        message;
+        size_t               nrUnixIoVecs = 0;
+        size_t               datagramSize = 0;
+        ssize_t              nrBytesSent;
+
+        //
+        // Gather the next datagram, the index and offset locate the first byte not sent yet
+        //
+        while ((index < nrIoVecs) && (nrUnixIoVecs < SBG_INTERFACE_UDP_MAX_IOVECS) && (datagramSize < SBG_INTERFACE_UDP_PACKET_MAX_SIZE))
+        {
+            size_t           size;
+
+            size = sbgMin(pIoVecs[index].size - offset, SBG_INTERFACE_UDP_PACKET_MAX_SIZE - datagramSize);
+
+            if (size != 0)
+            {
+                ioVecs[nrUnixIoVecs].iov_base   = (uint8_t *)pIoVecs[index].pBuffer + offset;
+                ioVecs[nrUnixIoVecs].iov_len    = size;
+                nrUnixIoVecs++;
+
+                datagramSize    += size;
+                offset          += size;
+            }
+
+            if (offset == pIoVecs[index].size)
+            {
+                index++;
+                offset = 0;
+            }
+        }
+
+        if (datagramSize == 0)
+        {
+            break;
+        }
+
+        memset(&message, 0x00, sizeof(message));
+
+        message.msg_name        = &outAddr;
+        message.msg_namelen     = sizeof(outAddr);
+        message.msg_iov         = ioVecs;
+        message.msg_iovlen      = nrUnixIoVecs;
+
+        nrBytesSent = sendmsg(pUdpHandle->udpSocket, &message, 0);
+
+        if (nrBytesSent != (ssize_t)datagramSize)
+        {
+            errorCode = SBG_WRITE_ERROR;
+            break;
+        }
+    }
+
+    return errorCode;
+}
+#endif // WIN32
+
 /*!
  * Try to read some data from an interface.
  *
@@ -327,6 +418,74 @@ static SbgErrorCode sbgInterfaceUdpRead(SbgInterface *pInterface, void *pBuffer,
     return errorCode;
 }
 
+/*!
+ * Wait until data can be read from an interface.
+ *
+ * \param[in]   pInterface                              Valid handle on an initialized interface.
+ * \param[in]   timeOut                                 Maximum time to wait, in us.
+ * \return                                              SBG_NO_ERROR if data may be read, SBG_TIME_OUT if no data has been received in time.
+ */
+static SbgErrorCode sbgInterfaceUdpWait(SbgInterface *pInterface, uint32_t timeOut)
+{
+    SbgErrorCode             errorCode;
+    SbgInterfaceUdp         *pUdpHandle;
+    int                      ret;
+
+    assert(pInterface);
+    assert(pInterface->type == SBG_IF_TYPE_ETH_UDP);
+
+    pUdpHandle = sbgInterfaceUdpGet(pInterface);
+
+#ifdef WIN32
+    {
+        fd_set                   readFds;
+        struct timeval           timeVal;
+
+        FD_ZERO(&readFds);
+        FD_SET(pUdpHandle->udpSocket, &readFds);
+
+        timeVal.tv_sec  = (long)(timeOut / 1000000);
+        timeVal.tv_usec = (long)(timeOut % 1000000);
+
+        ret = select(0, &readFds, NULL, NULL, &timeVal);
+    }
+#else // WIN32
+    {
+        struct pollfd            pollFd;
+
+        pollFd.fd       = pUdpHandle->udpSocket;
+        pollFd.events   = POLLIN;
+        pollFd.revents  = 0;
+
+        //
+        // Round the time out up to the poll() resolution
+        //
+        ret = poll(&pollFd, 1, (int)((timeOut / 1000) + (((timeOut % 1000) != 0) ? 1 : 0)));
+
+        if ((ret == -1) && (errno == EINTR))
+        {
+            ret = 1;
+        }
+    }
+#endif // WIN32
+
+    if (ret > 0)
+    {
+        errorCode = SBG_NO_ERROR;
+    }
+    else if (ret == 0)
+    {
+        errorCode = SBG_TIME_OUT;
+    }
+    else
+    {
+        errorCode = SBG_READ_ERROR;
+        SBG_LOG_ERROR(errorCode, "unable to wait for data");
+    }
+
+    return errorCode;
+}
+
 //----------------------------------------------------------------------//
 //- Public functions                                                   -//
 //----------------------------------------------------------------------//
@@ -401,6 +560,10 @@ SBG_COMMON_LIB_API SbgErrorCode sbgInterfaceUdpCreate(SbgInterface *pInterface,
                         pInterface->pDestroyFunc    = sbgInterfaceUdpDestroy;
                         pInterface->pReadFunc       = sbgInterfaceUdpRead;
                         pInterface->pWriteFunc      = sbgInterfaceUdpWrite;
+                        pInterface->pWaitFunc       = sbgInterfaceUdpWait;
+#ifndef WIN32
+                        pInterface->pWriteVFunc     = sbgInterfaceUdpWriteV;
+#endif // WIN32
 
                         return SBG_NO_ERROR;
                     }
@@ -12,6 +12,10 @@
     #include <unistd.h>
 #endif
 
+#if (SBG_CONFIG_ENABLE_THREADS != 0) && !defined(WIN32)
+    #include <pthread.h>
+#endif
+
 //----------------------------------------------------------------------//
 //- Global singleton for the log callback                              -//
 //----------------------------------------------------------------------//
@@ -144,3 +148,344 @@ SBG_COMMON_LIB_API void sbgPlatformDebugLogMsg(const char *pFileName, const char
         }
     }
 }
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Threading structure definitions                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Thread.
+ */
+struct _SbgThread
+{
+#ifdef WIN32
+    HANDLE                       handle;                    /*!< Thread handle. */
+#else
+    pthread_t                    thread;                    /*!< Thread. */
+#endif
+    SbgThreadFunc                pFunc;                     /*!< Entry point. */
+    void                        *pArg;                      /*!< Entry point argument. */
+};
+
+/*!
+ * Mutex.
+ */
+struct _SbgMutex
+{
+#ifdef WIN32
+    CRITICAL_SECTION             criticalSection;           /*!< Critical section. */
+#else
+    pthread_mutex_t              mutex;                     /*!< Mutex. */
+#endif
+};
+
+/*!
+ * Condition variable.
+ */
+struct _SbgCondition
+{
+#ifdef WIN32
+    CONDITION_VARIABLE           condition;                 /*!< Condition variable. */
+#else
+    pthread_cond_t               condition;                 /*!< Condition variable. */
+#endif
+};
+
+//----------------------------------------------------------------------//
+//- Threading private functions                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Thread entry point wrapper.
+ *
+ * \param[in]   pArg                        Thread.
+ * \return                                  Exit code, unused.
+ */
+#ifdef WIN32
+static DWORD WINAPI sbgThreadStart(LPVOID pArg)
+#else
+static void *sbgThreadStart(void *pArg)
+#endif
+{
+    SbgThread                   *pThread = pArg;
+
+    assert(pThread);
+
+    pThread->pFunc(pThread->pArg);
+
+#ifdef WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+//----------------------------------------------------------------------//
+//- Threading public functions                                         -//
+//----------------------------------------------------------------------//
+
+SBG_COMMON_LIB_API SbgErrorCode sbgThreadCreate(SbgThread **ppThread, SbgThreadFunc pFunc, void *pArg)
+{
+    SbgErrorCode                 errorCode = SBG_NO_ERROR;
+    SbgThread                   *pThread;
+
+    assert(ppThread);
+    assert(pFunc);
+
+    pThread = malloc(sizeof(*pThread));
+
+    if (pThread)
+    {
+        pThread->pFunc  = pFunc;
+        pThread->pArg   = pArg;
+
+#ifdef WIN32
+        pThread->handle = CreateThread(NULL, 0, sbgThreadStart, pThread, 0, NULL);
+
+        if (!pThread->handle)
+        {
+            errorCode = SBG_ERROR;
+        }
+#else
+        if (pthread_create(&pThread->thread, NULL, sbgThreadStart, pThread) != 0)
+        {
+            errorCode = SBG_ERROR;
+        }
+#endif
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            *ppThread = pThread;
+        }
+        else
+        {
+            SBG_LOG_ERROR(errorCode, "unable to create thread");
+            free(pThread);
+        }
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+        SBG_LOG_ERROR(errorCode, "unable to allocate thread");
+    }
+
+    return errorCode;
+}
+
+SBG_COMMON_LIB_API void sbgThreadJoin(SbgThread *pThread)
+{
+    assert(pThread);
+
+#ifdef WIN32
+    WaitForSingleObject(pThread->handle, INFINITE);
+    CloseHandle(pThread->handle);
+#else
+    pthread_join(pThread->thread, NULL);
+#endif
+
+    free(pThread);
+}
+
+SBG_COMMON_LIB_API SbgErrorCode sbgMutexCreate(SbgMutex **ppMutex)
+{
+    SbgErrorCode                 errorCode = SBG_NO_ERROR;
+    SbgMutex                    *pMutex;
+
+    assert(ppMutex);
+
+    pMutex = malloc(sizeof(*pMutex));
+
+    if (pMutex)
+    {
+#ifdef WIN32
+        InitializeCriticalSection(&pMutex->criticalSection);
+#else
+        if (pthread_mutex_init(&pMutex->mutex, NULL) != 0)
+        {
+            errorCode = SBG_ERROR;
+            SBG_LOG_ERROR(errorCode, "unable to initialize mutex");
+            free(pMutex);
+        }
+#endif
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            *ppMutex = pMutex;
+        }
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+        SBG_LOG_ERROR(errorCode, "unable to allocate mutex");
+    }
+
+    return errorCode;
+}
+
+SBG_COMMON_LIB_API void sbgMutexDestroy(SbgMutex *pMutex)
+{
+    assert(pMutex);
+
+#ifdef WIN32
+    DeleteCriticalSection(&pMutex->criticalSection);
+#else
+    pthread_mutex_destroy(&pMutex->mutex);
+#endif
+
+    free(pMutex);
+}
+
+SBG_COMMON_LIB_API void sbgMutexLock(SbgMutex *pMutex)
+{
+    assert(pMutex);
+
+#ifdef WIN32
+    EnterCriticalSection(&pMutex->criticalSection);
+#else
+    pthread_mutex_lock(&pMutex->mutex);
+#endif
+}
+
+SBG_COMMON_LIB_API void sbgMutexUnlock(SbgMutex *pMutex)
+{
+    assert(pMutex);
+
+#ifdef WIN32
+    LeaveCriticalSection(&pMutex->criticalSection);
+#else
+    pthread_mutex_unlock(&pMutex->mutex);
+#endif
+}
+
+SBG_COMMON_LIB_API SbgErrorCode sbgConditionCreate(SbgCondition **ppCondition)
+{
+    SbgErrorCode                 errorCode = SBG_NO_ERROR;
+    SbgCondition                *pCondition;
+
+    assert(ppCondition);
+
+    pCondition = malloc(sizeof(*pCondition));
+
+    if (pCondition)
+    {
+#ifdef WIN32
+        InitializeConditionVariable(&pCondition->condition);
+#else
+        pthread_condattr_t       attributes;
+
+        pthread_condattr_init(&attributes);
+
+        //
+        // Time outs are measured with the monotonic clock so that they aren't affected by changes of the system time
+        //
+    #ifndef __APPLE__
+        pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    #endif
+
+        if (pthread_cond_init(&pCondition->condition, &attributes) != 0)
+        {
+            errorCode = SBG_ERROR;
+            SBG_LOG_ERROR(errorCode, "unable to initialize condition variable");
+            free(pCondition);
+        }
+
+        pthread_condattr_destroy(&attributes);
+#endif
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            *ppCondition = pCondition;
+        }
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+        SBG_LOG_ERROR(errorCode, "unable to allocate condition variable");
+    }
+
+    return errorCode;
+}
+
+SBG_COMMON_LIB_API void sbgConditionDestroy(SbgCondition *pCondition)
+{
+    assert(pCondition);
+
+#ifndef WIN32
+    pthread_cond_destroy(&pCondition->condition);
+#endif
+
+    free(pCondition);
+}
+
+SBG_COMMON_LIB_API SbgErrorCode sbgConditionWait(SbgCondition *pCondition, SbgMutex *pMutex, uint32_t timeOut)
+{
+    SbgErrorCode                 errorCode = SBG_NO_ERROR;
+
+    assert(pCondition);
+    assert(pMutex);
+
+#ifdef WIN32
+    if (!SleepConditionVariableCS(&pCondition->condition, &pMutex->criticalSection, timeOut))
+    {
+        errorCode = SBG_TIME_OUT;
+    }
+#else
+    {
+        struct timespec          time;
+        int                      ret;
+
+    #ifdef __APPLE__
+        time.tv_sec     = timeOut / 1000;
+        time.tv_nsec    = (timeOut % 1000) * 1000000L;
+
+        ret = pthread_cond_timedwait_relative_np(&pCondition->condition, &pMutex->mutex, &time);
+    #else
+        clock_gettime(CLOCK_MONOTONIC, &time);
+
+        time.tv_sec     += timeOut / 1000;
+        time.tv_nsec    += (timeOut % 1000) * 1000000L;
+
+        if (time.tv_nsec >= 1000000000L)
+        {
+            time.tv_sec++;
+            time.tv_nsec -= 1000000000L;
+        }
+
+        ret = pthread_cond_timedwait(&pCondition->condition, &pMutex->mutex, &time);
+    #endif
+
+        if (ret == ETIMEDOUT)
+        {
+            errorCode = SBG_TIME_OUT;
+        }
+    }
+#endif
+
+    return errorCode;
+}
+
+SBG_COMMON_LIB_API void sbgConditionSignal(SbgCondition *pCondition)
+{
+    assert(pCondition);
+
+#ifdef WIN32
+    WakeConditionVariable(&pCondition->condition);
+#else
+    pthread_cond_signal(&pCondition->condition);
+#endif
+}
+
+SBG_COMMON_LIB_API void sbgConditionBroadcast(SbgCondition *pCondition)
+{
+    assert(pCondition);
+
+#ifdef WIN32
+    WakeAllConditionVariable(&pCondition->condition);
+#else
+    pthread_cond_broadcast(&pCondition->condition);
+#endif
+}
+
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
@@ -45,6 +45,10 @@
 #include <unistd.h>
 #endif
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 // sbgCommonLib headers
 #include <sbgDefines.h>
 #include <sbgErrorCodes.h>
@@ -108,4 +112,224 @@ SBG_COMMON_LIB_API void sbgCommonLibSetLogCallback(SbgCommonLibOnLogFunc logCall
  */
 SBG_COMMON_LIB_API void sbgPlatformDebugLogMsg(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pFormat, ...) SBG_CHECK_FORMAT(printf, 7, 8);
 
+#if SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Threading definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Thread, created with sbgThreadCreate().
+ */
+typedef struct _SbgThread SbgThread;
+
+/*!
+ * Mutex, created with sbgMutexCreate().
+ */
+typedef struct _SbgMutex SbgMutex;
+
+/*!
+ * Condition variable, created with sbgConditionCreate().
+ */
+typedef struct _SbgCondition SbgCondition;
+
+/*!
+ * Type for thread entry points.
+ *
+ * \param[in]   pArg                        Argument given to sbgThreadCreate().
+ */
+typedef void (*SbgThreadFunc)(void *pArg);
+
+//----------------------------------------------------------------------//
+//- Threading functions                                                -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Create and start a thread.
+ *
+ * \param[out]  ppThread                    Created thread.
+ * \param[in]   pFunc                       Thread entry point.
+ * \param[in]   pArg                        Argument given to the entry point.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SBG_COMMON_LIB_API SbgErrorCode sbgThreadCreate(SbgThread **ppThread, SbgThreadFunc pFunc, void *pArg);
+
+/*!
+ * Wait for a thread to exit and release it.
+ *
+ * \param[in]   pThread                     Thread.
+ */
+SBG_COMMON_LIB_API void sbgThreadJoin(SbgThread *pThread);
+
+/*!
+ * Create a mutex.
+ *
+ * \param[out]  ppMutex                     Created mutex.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SBG_COMMON_LIB_API SbgErrorCode sbgMutexCreate(SbgMutex **ppMutex);
+
+/*!
+ * Destroy a mutex.
+ *
+ * \param[in]   pMutex                      Mutex, must not be locked.
+ */
+SBG_COMMON_LIB_API void sbgMutexDestroy(SbgMutex *pMutex);
+
+/*!
+ * Lock a mutex.
+ *
+ * \param[in]   pMutex                      Mutex.
+ */
+SBG_COMMON_LIB_API void sbgMutexLock(SbgMutex *pMutex);
+
+/*!
+ * Unlock a mutex.
+ *
+ * \param[in]   pMutex                      Mutex.
+ */
+SBG_COMMON_LIB_API void sbgMutexUnlock(SbgMutex *pMutex);
+
+/*!
+ * Create a condition variable.
+ *
+ * \param[out]  ppCondition                 Created condition variable.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SBG_COMMON_LIB_API SbgErrorCode sbgConditionCreate(SbgCondition **ppCondition);
+
+/*!
+ * Destroy a condition variable.
+ *
+ * \param[in]   pCondition                  Condition variable, must not be waited on.
+ */
+SBG_COMMON_LIB_API void sbgConditionDestroy(SbgCondition *pCondition);
+
+/*!
+ * Wait on a condition variable.
+ *
+ * The mutex is released while waiting and locked again before returning. Spurious wake ups may occur,
+ * the condition must be checked again by the caller.
+ *
+ * \param[in]   pCondition                  Condition variable.
+ * \param[in]   pMutex                      Mutex, locked by the caller.
+ * \param[in]   timeOut                     Maximum time to wait, in ms.
+ * \return                                  SBG_NO_ERROR if woken up, SBG_TIME_OUT if the time out has elapsed.
+ */
+SBG_COMMON_LIB_API SbgErrorCode sbgConditionWait(SbgCondition *pCondition, SbgMutex *pMutex, uint32_t timeOut);
+
+/*!
+ * Wake up one thread waiting on a condition variable.
+ *
+ * \param[in]   pCondition                  Condition variable.
+ */
+SBG_COMMON_LIB_API void sbgConditionSignal(SbgCondition *pCondition);
+
+/*!
+ * Wake up all threads waiting on a condition variable.
+ *
+ * \param[in]   pCondition                  Condition variable.
+ */
+SBG_COMMON_LIB_API void sbgConditionBroadcast(SbgCondition *pCondition);
+
+//----------------------------------------------------------------------//
+//- Atomic operations                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Load a value with acquire semantics.
+ *
+ * \param[in]   pValue                      Value.
+ * \return                                  Loaded value.
+ */
+SBG_INLINE size_t sbgAtomicLoad(const volatile size_t *pValue)
+{
+#if defined(_MSC_VER)
+    #if defined(_WIN64)
+        return (size_t)_InterlockedCompareExchange64((volatile __int64 *)pValue, 0, 0);
+    #else
+        return (size_t)_InterlockedCompareExchange((volatile long *)pValue, 0, 0);
+    #endif
+#else
+    return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/*!
+ * Store a value with release semantics.
+ *
+ * \param[out]  pValue                      Value.
+ * \param[in]   value                       Value to store.
+ */
+SBG_INLINE void sbgAtomicStore(volatile size_t *pValue, size_t value)
+{
+#if defined(_MSC_VER)
+    #if defined(_WIN64)
+        _InterlockedExchange64((volatile __int64 *)pValue, (__int64)value);
+    #else
+        _InterlockedExchange((volatile long *)pValue, (long)value);
+    #endif
+#else
+    __atomic_store_n(pValue, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/*!
+ * Replace a value if it is equal to an expected value, with acquire and release semantics.
+ *
+ * \param[in]   pValue                      Value.
+ * \param[in]   expected                    Expected value.
+ * \param[in]   desired                     Value to store if the value is equal to the expected value.
+ * \return                                  True if the value has been replaced.
+ */
+SBG_INLINE bool sbgAtomicCompareExchange(volatile size_t *pValue, size_t expected, size_t desired)
+{
+#if defined(_MSC_VER)
+    #if defined(_WIN64)
+        return (size_t)_InterlockedCompareExchange64((volatile __int64 *)pValue, (__int64)desired, (__int64)expected) == expected;
+    #else
+        return (size_t)_InterlockedCompareExchange((volatile long *)pValue, (long)desired, (long)expected) == expected;
+    #endif
+#else
+    return __atomic_compare_exchange_n(pValue, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/*!
+ * Add to a value, with acquire and release semantics.
+ *
+ * \param[in]   pValue                      Value.
+ * \param[in]   increment                   Increment.
+ * \return                                  Value before the addition.
+ */
+SBG_INLINE size_t sbgAtomicAdd(volatile size_t *pValue, size_t increment)
+{
+#if defined(_MSC_VER)
+    #if defined(_WIN64)
+        return (size_t)_InterlockedExchangeAdd64((volatile __int64 *)pValue, (__int64)increment);
+    #else
+        return (size_t)_InterlockedExchangeAdd((volatile long *)pValue, (long)increment);
+    #endif
+#else
+    return __atomic_fetch_add(pValue, increment, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/*!
+ * Store a pointer with release semantics.
+ *
+ * \param[in]   ppValue                     Pointer.
+ * \param[in]   pValue                      Value to store.
+ */
+SBG_INLINE void sbgAtomicStorePointer(void * volatile *ppValue, void *pValue)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchangePointer(ppValue, pValue);
+#else
+    __atomic_store_n(ppValue, pValue, __ATOMIC_RELEASE);
+#endif
+}
+
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
 #endif // SBG_PLATFORM_H
@@ -51,11 +51,19 @@ extern "C" {
 /*!
  * If set to 0, the platform support only aligned memory access.
  * If set to 1, the platform support unaligned memory access.
- * Default: Support only Aligned access - Disabled
+ *
+ * Unaligned accesses are done with memcpy, that compilers turn into a single load or store
+ * on targets that support them, so they are safe with strict aliasing.
+ *
+ * Default: Enabled on x86, x86-64 and AArch64 - Disabled otherwise
  */
 #ifndef SBG_CONFIG_UNALIGNED_ACCESS_AUTH
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86) || defined(__aarch64__) || defined(_M_ARM64)
+#define SBG_CONFIG_UNALIGNED_ACCESS_AUTH                (1)
+#else
 #define SBG_CONFIG_UNALIGNED_ACCESS_AUTH                (0)
 #endif
+#endif
 
 /*!
  * If set to 0, the platform is using little endian.
@@ -114,6 +122,24 @@ extern "C" {
 #define SBG_CONFIG_PATH_MAX_SIZE                        ((size_t)(256))
 #endif
 
+/*!
+ * If set to 1, CRCs are computed 8 bytes at a time using additional lookup tables.
+ * If set to 0, CRCs are computed one byte at a time, which saves about 10 KB of constant data.
+ * Default: Enabled
+ */
+#ifndef SBG_CONFIG_CRC_USE_SLICING_BY_8
+#define SBG_CONFIG_CRC_USE_SLICING_BY_8                 (1)
+#endif
+
+/*!
+ * If set to 1, threads, mutexes, condition variables and atomic operations are provided by the platform.
+ * If set to 0, features that rely on them, such as the sbgECom reader thread, are not available.
+ * Default: Disabled
+ */
+#ifndef SBG_CONFIG_ENABLE_THREADS
+#define SBG_CONFIG_ENABLE_THREADS                       (0)
+#endif
+
 //----------------------------------------------------------------------//
 //- Headers                                                            -//
 //----------------------------------------------------------------------//
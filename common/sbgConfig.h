@@ -39,9 +39,9 @@
 //----------------------------------------------------------------------//
 
 /*!
- * Windows x86 & x64 support both aligned and unaligned access
+ * Unaligned access support is selected from the target architecture by sbgCommon.h
+ * Define SBG_CONFIG_UNALIGNED_ACCESS_AUTH to 0 or 1 to override it
  */
-#define SBG_CONFIG_UNALIGNED_ACCESS_AUTH                    (0)
 
 /*!
  * Windows is using little endianess
@@ -61,6 +61,28 @@
 #define SBG_CONFIG_ENABLE_LOG_INFO                          (1)
 #define SBG_CONFIG_ENABLE_LOG_DEBUG                         (1)
 
+//----------------------------------------------------------------------//
+//- CRC configuration                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Compute CRCs 8 bytes at a time using additional lookup tables
+ * Default: Enabled
+ */
+#define SBG_CONFIG_CRC_USE_SLICING_BY_8                     (1)
+
+//----------------------------------------------------------------------//
+//- Threading configuration                                            -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Provide threads, mutexes, condition variables and atomic operations
+ * Default: Disabled
+ */
+#ifndef SBG_CONFIG_ENABLE_THREADS
+#define SBG_CONFIG_ENABLE_THREADS                           (0)
+#endif
+
 //----------------------------------------------------------------------//
 //- JSON configuration                                                 -//
 //----------------------------------------------------------------------//
@@ -68,7 +68,7 @@ SBG_INLINE int16_t sbgStreamBufferReadInt16BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((int16_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(int16_t));
 
                 //
                 //  Increment the current pointer
@@ -137,7 +137,7 @@ SBG_INLINE uint16_t sbgStreamBufferReadUint16BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((uint16_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(uint16_t));
 
                 //
                 //  Increment the current pointer
@@ -338,7 +338,7 @@ SBG_INLINE int32_t sbgStreamBufferReadInt32BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((int32_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(int32_t));
 
                 //
                 //  Increment the current pointer
@@ -359,9 +359,9 @@ SBG_INLINE int32_t sbgStreamBufferReadInt32BE(SbgStreamBuffer *pHandle)
                 // Store data according to platform endianness
                 //
                 #if (SBG_CONFIG_BIG_ENDIAN == 1)
-                    return bytesValues[3] | (bytesValues[2] << 8) | (bytesValues[1] << 16) | (bytesValues[0] << 24);
+                    return (int32_t)((uint32_t)bytesValues[3] | ((uint32_t)bytesValues[2] << 8) | ((uint32_t)bytesValues[1] << 16) | ((uint32_t)bytesValues[0] << 24));
                 #else
-                    return bytesValues[0] | (bytesValues[1] << 8) | (bytesValues[2] << 16) | (bytesValues[3] << 24);
+                    return (int32_t)((uint32_t)bytesValues[0] | ((uint32_t)bytesValues[1] << 8) | ((uint32_t)bytesValues[2] << 16) | ((uint32_t)bytesValues[3] << 24));
                 #endif
             #endif
         }
@@ -409,7 +409,7 @@ SBG_INLINE uint32_t sbgStreamBufferReadUint32BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((uint32_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(uint32_t));
 
                 //
                 //  Increment the current pointer
@@ -892,7 +892,9 @@ SBG_INLINE int64_t sbgStreamBufferReadUint56BE(SbgStreamBuffer *pHandle)
 SBG_INLINE int64_t sbgStreamBufferReadInt64BE(SbgStreamBuffer *pHandle)
 {
     int64_t lowPart;
-    int64_t highPart;
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 0) || (SBG_CONFIG_BIG_ENDIAN == 0)
+        int64_t highPart;
+    #endif
 
     assert(pHandle);
 
@@ -913,7 +915,7 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                lowPart = *((int64_t*)pHandle->pCurrentPtr);
+                memcpy(&lowPart, pHandle->pCurrentPtr, sizeof(int64_t));
 
                 //
                 //  Increment the current pointer
@@ -932,9 +934,9 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64BE(SbgStreamBuffer *pHandle)
                 // Store data according to platform endianness
                 //
                 #if (SBG_CONFIG_BIG_ENDIAN == 1)
-                    return (lowPart << 32) | highPart;
+                    return (int64_t)(((uint64_t)lowPart << 32) | (uint64_t)highPart);
                 #else
-                    return lowPart | (highPart << 32);
+                    return (int64_t)((uint64_t)lowPart | ((uint64_t)highPart << 32));
                 #endif
             #endif
         }
@@ -962,7 +964,9 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64BE(SbgStreamBuffer *pHandle)
 SBG_INLINE uint64_t sbgStreamBufferReadUint64BE(SbgStreamBuffer *pHandle)
 {
     uint64_t lowPart;
-    uint64_t highPart;
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 0) || (SBG_CONFIG_BIG_ENDIAN == 0)
+        uint64_t highPart;
+    #endif
 
     assert(pHandle);
 
@@ -983,7 +987,7 @@ SBG_INLINE uint64_t sbgStreamBufferReadUint64BE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                lowPart = *((uint64_t*)pHandle->pCurrentPtr);
+                memcpy(&lowPart, pHandle->pCurrentPtr, sizeof(uint64_t));
 
                 //
                 //  Increment the current pointer
@@ -1194,7 +1198,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt16BE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int16_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int16_t));
 
                 //
                 //  Increment the current pointer
@@ -1253,7 +1257,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint16BE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint16_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint16_t));
 
                 //
                 //  Increment the current pointer
@@ -1430,7 +1434,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt32BE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int32_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int32_t));
 
                 //
                 //  Increment the current pointer
@@ -1493,7 +1497,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint32BE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint32_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint32_t));
 
                 //
                 //  Increment the current pointer
@@ -1609,7 +1613,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt64BE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int64_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int64_t));
 
                 //
                 //  Increment the current pointer
@@ -1680,7 +1684,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint64BE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint64_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint64_t));
 
                 //
                 //  Increment the current pointer
@@ -648,6 +648,58 @@ SBG_INLINE SbgErrorCode sbgStreamBufferReadBuffer(SbgStreamBuffer *pHandle, void
     return pHandle->errorCode;
 }
 
+//----------------------------------------------------------------------//
+//- Unchecked read operations methods                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Reserve a span of bytes to read from a stream buffer.
+ *
+ * Checks once that the stream buffer has no error and that the given number of bytes can be read.
+ * On success, the span can be decoded with the unchecked read methods, without any further check.
+ * The cursor isn't moved.
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[in]   size                Number of bytes to reserve.
+ * \return                          SBG_NO_ERROR if the span is available, SBG_BUFFER_OVERFLOW otherwise.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReserve(SbgStreamBuffer *pHandle, size_t size)
+{
+    assert(pHandle);
+
+    //
+    // Test if we haven't already an error
+    //
+    if (pHandle->errorCode == SBG_NO_ERROR)
+    {
+        //
+        // Test if we can access the whole span
+        //
+        if (sbgStreamBufferGetSpace(pHandle) < size)
+        {
+            pHandle->errorCode = SBG_BUFFER_OVERFLOW;
+        }
+    }
+
+    return pHandle->errorCode;
+}
+
+/*!
+ * Read an uint8_t from a stream buffer without any check.
+ *
+ * The byte must have been reserved with sbgStreamBufferReserve().
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE uint8_t sbgStreamBufferReadUint8Unchecked(SbgStreamBuffer *pHandle)
+{
+    assert(pHandle);
+    assert(sbgStreamBufferGetSpace(pHandle) >= sizeof(uint8_t));
+
+    return *(pHandle->pCurrentPtr++);
+}
+
 //----------------------------------------------------------------------//
 //- Write operations methods                                           -//
 //----------------------------------------------------------------------//
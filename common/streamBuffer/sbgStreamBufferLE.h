@@ -68,7 +68,7 @@ SBG_INLINE int16_t sbgStreamBufferReadInt16LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((int16_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(int16_t));
 
                 //
                 //  Increment the current pointer
@@ -137,7 +137,7 @@ SBG_INLINE uint16_t sbgStreamBufferReadUint16LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((uint16_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(uint16_t));
 
                 //
                 //  Increment the current pointer
@@ -338,7 +338,7 @@ SBG_INLINE int32_t sbgStreamBufferReadInt32LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((int32_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(int32_t));
 
                 //
                 //  Increment the current pointer
@@ -359,9 +359,9 @@ SBG_INLINE int32_t sbgStreamBufferReadInt32LE(SbgStreamBuffer *pHandle)
                 // Store data according to platform endianness
                 //
                 #if (SBG_CONFIG_BIG_ENDIAN == 1)
-                    return bytesValues[3] | (bytesValues[2] << 8) | (bytesValues[1] << 16) | (bytesValues[0] << 24);
+                    return (int32_t)((uint32_t)bytesValues[3] | ((uint32_t)bytesValues[2] << 8) | ((uint32_t)bytesValues[1] << 16) | ((uint32_t)bytesValues[0] << 24));
                 #else
-                    return bytesValues[0] | (bytesValues[1] << 8) | (bytesValues[2] << 16) | (bytesValues[3] << 24);
+                    return (int32_t)((uint32_t)bytesValues[0] | ((uint32_t)bytesValues[1] << 8) | ((uint32_t)bytesValues[2] << 16) | ((uint32_t)bytesValues[3] << 24));
                 #endif
             #endif
         }
@@ -409,7 +409,7 @@ SBG_INLINE uint32_t sbgStreamBufferReadUint32LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                bytesValues[0] = *((uint32_t*)pHandle->pCurrentPtr);
+                memcpy(&bytesValues[0], pHandle->pCurrentPtr, sizeof(uint32_t));
 
                 //
                 //  Increment the current pointer
@@ -892,7 +892,9 @@ SBG_INLINE uint64_t sbgStreamBufferReadUint56LE(SbgStreamBuffer *pHandle)
 SBG_INLINE int64_t sbgStreamBufferReadInt64LE(SbgStreamBuffer *pHandle)
 {
     int64_t lowPart;
-    int64_t highPart;
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 0) || (SBG_CONFIG_BIG_ENDIAN == 1)
+        int64_t highPart;
+    #endif
 
     assert(pHandle);
 
@@ -913,7 +915,7 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                lowPart = *((int64_t*)pHandle->pCurrentPtr);
+                memcpy(&lowPart, pHandle->pCurrentPtr, sizeof(int64_t));
 
                 //
                 //  Increment the current pointer
@@ -932,9 +934,9 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64LE(SbgStreamBuffer *pHandle)
                 // Store data according to platform endianness
                 //
                 #if (SBG_CONFIG_BIG_ENDIAN == 1)
-                    return (lowPart << 32) | highPart;
+                    return (int64_t)(((uint64_t)lowPart << 32) | (uint64_t)highPart);
                 #else
-                    return lowPart | (highPart << 32);
+                    return (int64_t)((uint64_t)lowPart | ((uint64_t)highPart << 32));
                 #endif
             #endif
         }
@@ -962,7 +964,9 @@ SBG_INLINE int64_t sbgStreamBufferReadInt64LE(SbgStreamBuffer *pHandle)
 SBG_INLINE uint64_t sbgStreamBufferReadUint64LE(SbgStreamBuffer *pHandle)
 {
     uint64_t lowPart;
-    uint64_t highPart;
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 0) || (SBG_CONFIG_BIG_ENDIAN == 1)
+        uint64_t highPart;
+    #endif
 
     assert(pHandle);
 
@@ -983,7 +987,7 @@ SBG_INLINE uint64_t sbgStreamBufferReadUint64LE(SbgStreamBuffer *pHandle)
                 //
                 // Read the current value
                 //
-                lowPart = *((uint64_t*)pHandle->pCurrentPtr);
+                memcpy(&lowPart, pHandle->pCurrentPtr, sizeof(uint64_t));
 
                 //
                 //  Increment the current pointer
@@ -1162,6 +1166,423 @@ SBG_INLINE double sbgStreamBufferReadDoubleLE(SbgStreamBuffer *pHandle)
     return 0.0;
 }
 
+/*!
+ * Read an array of values from a stream buffer (Little endian version).
+ *
+ * The whole array is bounds checked once and then copied, with a byte swap on big endian platforms.
+ * If an error occurs, the array is zeroed.
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \param[in]   valueSize           Size of each value, in bytes.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadArrayLE(SbgStreamBuffer *pHandle, void *pValues, size_t nrValues, size_t valueSize)
+{
+    size_t      size;
+
+    assert(pHandle);
+    assert((pValues) || (nrValues == 0));
+
+    size = nrValues * valueSize;
+
+    //
+    // Test if we haven't already an error
+    //
+    if (pHandle->errorCode == SBG_NO_ERROR)
+    {
+        //
+        // Test if we can access all items
+        //
+        if (sbgStreamBufferGetSpace(pHandle) >= size)
+        {
+            //
+            // Store data according to platform endianness
+            //
+            #if (SBG_CONFIG_BIG_ENDIAN == 1)
+                uint8_t        *pOutput = (uint8_t*)pValues;
+
+                for (size_t i = 0; i < size; i += valueSize)
+                {
+                    for (size_t j = 0; j < valueSize; j++)
+                    {
+                        pOutput[i + j] = pHandle->pCurrentPtr[i + valueSize - 1 - j];
+                    }
+                }
+            #else
+                memcpy(pValues, pHandle->pCurrentPtr, size);
+            #endif
+
+            //
+            // Increment the current pointer
+            //
+            pHandle->pCurrentPtr += size;
+        }
+        else
+        {
+            //
+            // We have a buffer overflow
+            //
+            pHandle->errorCode = SBG_BUFFER_OVERFLOW;
+        }
+    }
+
+    //
+    // Zero the values in case of error, the same way single value reads return 0
+    //
+    if ((pHandle->errorCode != SBG_NO_ERROR) && (size > 0))
+    {
+        memset(pValues, 0, size);
+    }
+
+    return pHandle->errorCode;
+}
+
+/*!
+ * Read an array of int16_t from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadInt16LEArray(SbgStreamBuffer *pHandle, int16_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(int16_t));
+}
+
+/*!
+ * Read an array of uint16_t from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadUint16LEArray(SbgStreamBuffer *pHandle, uint16_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(uint16_t));
+}
+
+/*!
+ * Read an array of int32_t from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadInt32LEArray(SbgStreamBuffer *pHandle, int32_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(int32_t));
+}
+
+/*!
+ * Read an array of uint32_t from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadUint32LEArray(SbgStreamBuffer *pHandle, uint32_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(uint32_t));
+}
+
+/*!
+ * Read an array of float from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadFloatLEArray(SbgStreamBuffer *pHandle, float *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(float));
+}
+
+/*!
+ * Read an array of double from a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \return                          SBG_NO_ERROR if the values have been read successfully.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferReadDoubleLEArray(SbgStreamBuffer *pHandle, double *pValues, size_t nrValues)
+{
+    return sbgStreamBufferReadArrayLE(pHandle, pValues, nrValues, sizeof(double));
+}
+
+//----------------------------------------------------------------------//
+//- Unchecked read operations methods                                  -//
+//----------------------------------------------------------------------//
+
+//
+// The following methods don't check the stream buffer error nor the remaining space, the bytes to
+// read must have been reserved with sbgStreamBufferReserve(). They are intended to decode fixed
+// layouts with a straight sequence of loads.
+//
+
+/*!
+ * Read an uint16_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE uint16_t sbgStreamBufferReadUint16LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    uint16_t value;
+
+    assert(pHandle);
+    assert(sbgStreamBufferGetSpace(pHandle) >= sizeof(uint16_t));
+
+    //
+    // Test if the platform supports un-aligned access and if the endianness is the same
+    //
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 1) && (SBG_CONFIG_BIG_ENDIAN == 0)
+        memcpy(&value, pHandle->pCurrentPtr, sizeof(uint16_t));
+    #else
+        value = (uint16_t)(((uint16_t)pHandle->pCurrentPtr[0]) | (((uint16_t)pHandle->pCurrentPtr[1]) << 8));
+    #endif
+
+    pHandle->pCurrentPtr += sizeof(uint16_t);
+
+    return value;
+}
+
+/*!
+ * Read an int16_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE int16_t sbgStreamBufferReadInt16LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    return (int16_t)sbgStreamBufferReadUint16LEUnchecked(pHandle);
+}
+
+/*!
+ * Read an uint32_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE uint32_t sbgStreamBufferReadUint32LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    uint32_t value;
+
+    assert(pHandle);
+    assert(sbgStreamBufferGetSpace(pHandle) >= sizeof(uint32_t));
+
+    //
+    // Test if the platform supports un-aligned access and if the endianness is the same
+    //
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 1) && (SBG_CONFIG_BIG_ENDIAN == 0)
+        memcpy(&value, pHandle->pCurrentPtr, sizeof(uint32_t));
+    #else
+        value = (uint32_t)(((uint32_t)pHandle->pCurrentPtr[0]) | (((uint32_t)pHandle->pCurrentPtr[1]) << 8) | (((uint32_t)pHandle->pCurrentPtr[2]) << 16) | (((uint32_t)pHandle->pCurrentPtr[3]) << 24));
+    #endif
+
+    pHandle->pCurrentPtr += sizeof(uint32_t);
+
+    return value;
+}
+
+/*!
+ * Read an int32_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE int32_t sbgStreamBufferReadInt32LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    return (int32_t)sbgStreamBufferReadUint32LEUnchecked(pHandle);
+}
+
+/*!
+ * Read an uint64_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE uint64_t sbgStreamBufferReadUint64LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    uint64_t value;
+
+    assert(pHandle);
+    assert(sbgStreamBufferGetSpace(pHandle) >= sizeof(uint64_t));
+
+    //
+    // Test if the platform supports un-aligned access and if the endianness is the same
+    //
+    #if (SBG_CONFIG_UNALIGNED_ACCESS_AUTH == 1) && (SBG_CONFIG_BIG_ENDIAN == 0)
+        memcpy(&value, pHandle->pCurrentPtr, sizeof(uint64_t));
+    #else
+        value = ((uint64_t)pHandle->pCurrentPtr[0]) | (((uint64_t)pHandle->pCurrentPtr[1]) << 8) | (((uint64_t)pHandle->pCurrentPtr[2]) << 16) | (((uint64_t)pHandle->pCurrentPtr[3]) << 24) |
+                (((uint64_t)pHandle->pCurrentPtr[4]) << 32) | (((uint64_t)pHandle->pCurrentPtr[5]) << 40) | (((uint64_t)pHandle->pCurrentPtr[6]) << 48) | (((uint64_t)pHandle->pCurrentPtr[7]) << 56);
+    #endif
+
+    pHandle->pCurrentPtr += sizeof(uint64_t);
+
+    return value;
+}
+
+/*!
+ * Read an int64_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE int64_t sbgStreamBufferReadInt64LEUnchecked(SbgStreamBuffer *pHandle)
+{
+    return (int64_t)sbgStreamBufferReadUint64LEUnchecked(pHandle);
+}
+
+/*!
+ * Read a float from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE float sbgStreamBufferReadFloatLEUnchecked(SbgStreamBuffer *pHandle)
+{
+    SbgFloatNint    floatInt;
+
+    floatInt.valU = sbgStreamBufferReadUint32LEUnchecked(pHandle);
+
+    return floatInt.valF;
+}
+
+/*!
+ * Read a double from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \return                          The read value.
+ */
+SBG_INLINE double sbgStreamBufferReadDoubleLEUnchecked(SbgStreamBuffer *pHandle)
+{
+    SbgDoubleNint   doubleInt;
+
+    doubleInt.valU = sbgStreamBufferReadUint64LEUnchecked(pHandle);
+
+    return doubleInt.valF;
+}
+
+/*!
+ * Read an array of values from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ * \param[in]   valueSize           Size of each value, in bytes.
+ */
+SBG_INLINE void sbgStreamBufferReadArrayLEUnchecked(SbgStreamBuffer *pHandle, void *pValues, size_t nrValues, size_t valueSize)
+{
+    size_t      size;
+
+    assert(pHandle);
+    assert((pValues) || (nrValues == 0));
+
+    size = nrValues * valueSize;
+
+    assert(sbgStreamBufferGetSpace(pHandle) >= size);
+
+    //
+    // Store data according to platform endianness
+    //
+    #if (SBG_CONFIG_BIG_ENDIAN == 1)
+        uint8_t        *pOutput = (uint8_t*)pValues;
+
+        for (size_t i = 0; i < size; i += valueSize)
+        {
+            for (size_t j = 0; j < valueSize; j++)
+            {
+                pOutput[i + j] = pHandle->pCurrentPtr[i + valueSize - 1 - j];
+            }
+        }
+    #else
+        memcpy(pValues, pHandle->pCurrentPtr, size);
+    #endif
+
+    pHandle->pCurrentPtr += size;
+}
+
+/*!
+ * Read an array of int16_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadInt16LEArrayUnchecked(SbgStreamBuffer *pHandle, int16_t *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(int16_t));
+}
+
+/*!
+ * Read an array of uint16_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadUint16LEArrayUnchecked(SbgStreamBuffer *pHandle, uint16_t *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(uint16_t));
+}
+
+/*!
+ * Read an array of int32_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadInt32LEArrayUnchecked(SbgStreamBuffer *pHandle, int32_t *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(int32_t));
+}
+
+/*!
+ * Read an array of uint32_t from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadUint32LEArrayUnchecked(SbgStreamBuffer *pHandle, uint32_t *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(uint32_t));
+}
+
+/*!
+ * Read an array of float from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadFloatLEArrayUnchecked(SbgStreamBuffer *pHandle, float *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(float));
+}
+
+/*!
+ * Read an array of double from a stream buffer without any check (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports read operations.
+ * \param[out]  pValues             Array of values to fill.
+ * \param[in]   nrValues            Number of values to read.
+ */
+SBG_INLINE void sbgStreamBufferReadDoubleLEArrayUnchecked(SbgStreamBuffer *pHandle, double *pValues, size_t nrValues)
+{
+    sbgStreamBufferReadArrayLEUnchecked(pHandle, pValues, nrValues, sizeof(double));
+}
+
 //----------------------------------------------------------------------//
 //- Write operations methods                                           -//
 //----------------------------------------------------------------------//
@@ -1194,7 +1615,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt16LE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int16_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int16_t));
 
                 //
                 //  Increment the current pointer
@@ -1253,7 +1674,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint16LE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint16_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint16_t));
 
                 //
                 //  Increment the current pointer
@@ -1431,7 +1852,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt32LE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int32_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int32_t));
 
                 //
                 //  Increment the current pointer
@@ -1494,7 +1915,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint32LE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint32_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint32_t));
 
                 //
                 //  Increment the current pointer
@@ -1610,7 +2031,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt64LE(SbgStreamBuffer *pHandle, in
                 //
                 //  Write the value
                 //
-                *((int64_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(int64_t));
 
                 //
                 //  Increment the current pointer
@@ -1681,7 +2102,7 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint64LE(SbgStreamBuffer *pHandle, u
                 //
                 //  Write the value
                 //
-                *((uint64_t*)(pHandle->pCurrentPtr)) = value;
+                memcpy(pHandle->pCurrentPtr, &value, sizeof(uint64_t));
 
                 //
                 //  Increment the current pointer
@@ -1827,6 +2248,148 @@ SBG_INLINE SbgErrorCode sbgStreamBufferWriteDoubleLE(SbgStreamBuffer *pHandle, d
     return pHandle->errorCode;
 }
 
+/*!
+ * Write an array of values into a stream buffer (Little endian version).
+ *
+ * The whole array is bounds checked once and then copied, with a byte swap on big endian platforms.
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \param[in]   valueSize           Size of each value, in bytes.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteArrayLE(SbgStreamBuffer *pHandle, const void *pValues, size_t nrValues, size_t valueSize)
+{
+    size_t      size;
+
+    assert(pHandle);
+    assert((pValues) || (nrValues == 0));
+
+    size = nrValues * valueSize;
+
+    //
+    // Test if we haven't already an error
+    //
+    if (pHandle->errorCode == SBG_NO_ERROR)
+    {
+        //
+        // Test if we can access all items
+        //
+        if (sbgStreamBufferGetSpace(pHandle) >= size)
+        {
+            //
+            // Store data according to platform endianness
+            //
+            #if (SBG_CONFIG_BIG_ENDIAN == 1)
+                const uint8_t  *pInput = (const uint8_t*)pValues;
+
+                for (size_t i = 0; i < size; i += valueSize)
+                {
+                    for (size_t j = 0; j < valueSize; j++)
+                    {
+                        pHandle->pCurrentPtr[i + j] = pInput[i + valueSize - 1 - j];
+                    }
+                }
+            #else
+                memcpy(pHandle->pCurrentPtr, pValues, size);
+            #endif
+
+            //
+            // Increment the current pointer
+            //
+            pHandle->pCurrentPtr += size;
+        }
+        else
+        {
+            //
+            // We are accessing a data that is outside the stream buffer
+            //
+            pHandle->errorCode = SBG_BUFFER_OVERFLOW;
+        }
+    }
+
+    return pHandle->errorCode;
+}
+
+/*!
+ * Write an array of int16_t into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt16LEArray(SbgStreamBuffer *pHandle, const int16_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(int16_t));
+}
+
+/*!
+ * Write an array of uint16_t into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint16LEArray(SbgStreamBuffer *pHandle, const uint16_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(uint16_t));
+}
+
+/*!
+ * Write an array of int32_t into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteInt32LEArray(SbgStreamBuffer *pHandle, const int32_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(int32_t));
+}
+
+/*!
+ * Write an array of uint32_t into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteUint32LEArray(SbgStreamBuffer *pHandle, const uint32_t *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(uint32_t));
+}
+
+/*!
+ * Write an array of float into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteFloatLEArray(SbgStreamBuffer *pHandle, const float *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(float));
+}
+
+/*!
+ * Write an array of double into a stream buffer (Little endian version).
+ *
+ * \param[in]   pHandle             Valid stream buffer handle that supports write operations.
+ * \param[in]   pValues             Array of values to write.
+ * \param[in]   nrValues            Number of values to write.
+ * \return                          SBG_NO_ERROR if the values have been successfully written.
+ */
+SBG_INLINE SbgErrorCode sbgStreamBufferWriteDoubleLEArray(SbgStreamBuffer *pHandle, const double *pValues, size_t nrValues)
+{
+    return sbgStreamBufferWriteArrayLE(pHandle, pValues, nrValues, sizeof(double));
+}
+
 /*!
 * Read a C String from a stream buffer (Little Endian Version).
 *
@@ -45,6 +45,7 @@
 #include "sbgEComCmdAdvanced.h"
 #include "sbgEComCmdAirData.h"
 #include "sbgEComCmdApi.h"
+#include "sbgEComCmdAsync.h"
 #include "sbgEComCmdDvl.h"
 #include "sbgEComCmdEthernet.h"
 #include "sbgEComCmdEvent.h"
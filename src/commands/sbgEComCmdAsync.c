@@ -0,0 +1,588 @@
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// Project headers
+#include <sbgECom.h>
+
+// Local headers
+#include "sbgEComCmdAsync.h"
+#include "sbgEComCmdCommon.h"
+
+//----------------------------------------------------------------------//
+//- Private functions                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Find the oldest request in a given state.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   state                       Request state.
+ * \return                                  Oldest request, NULL if no request is in this state.
+ */
+static SbgEComCmdAsyncRequest *sbgEComCmdAsyncFindOldest(SbgEComCmdAsync *pAsync, SbgEComCmdAsyncState state)
+{
+    SbgEComCmdAsyncRequest              *pOldest = NULL;
+
+    assert(pAsync);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        SbgEComCmdAsyncRequest          *pRequest = &pAsync->requests[i];
+
+        if ((pRequest->state == state) && (!pOldest || (pRequest->sequence < pOldest->sequence)))
+        {
+            pOldest = pRequest;
+        }
+    }
+
+    return pOldest;
+}
+
+/*!
+ * Check if a pending request may be sent.
+ *
+ * Once a request has timed out, the requests of the same class and ID are sent one at a time until
+ * it is completed, as an answer can't be told from a late answer to a previous trial.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   pRequest                    Pending request.
+ * \return                                  True if the request may be sent.
+ */
+static bool sbgEComCmdAsyncCanSend(const SbgEComCmdAsync *pAsync, const SbgEComCmdAsyncRequest *pRequest)
+{
+    bool                                 retrying = false;
+    bool                                 inFlight = false;
+
+    assert(pAsync);
+    assert(pRequest);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        const SbgEComCmdAsyncRequest    *pCandidate = &pAsync->requests[i];
+
+        if ((pCandidate->completion.msgClass == pRequest->completion.msgClass) && (pCandidate->completion.msgId == pRequest->completion.msgId))
+        {
+            if (pCandidate->state == SBG_ECOM_CMD_ASYNC_STATE_PENDING)
+            {
+                retrying = retrying || (pCandidate->completion.nrTrials != 0);
+            }
+            else if (pCandidate->state == SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT)
+            {
+                retrying = retrying || (pCandidate->completion.nrTrials > 1);
+                inFlight = true;
+            }
+        }
+    }
+
+    return !retrying || !inFlight;
+}
+
+/*!
+ * Find the oldest pending request that may be sent.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \return                                  Request to send, NULL if none.
+ */
+static SbgEComCmdAsyncRequest *sbgEComCmdAsyncFindNextToSend(SbgEComCmdAsync *pAsync)
+{
+    SbgEComCmdAsyncRequest              *pNext = NULL;
+
+    assert(pAsync);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        SbgEComCmdAsyncRequest          *pRequest = &pAsync->requests[i];
+
+        if ((pRequest->state == SBG_ECOM_CMD_ASYNC_STATE_PENDING) && (!pNext || (pRequest->sequence < pNext->sequence)) && sbgEComCmdAsyncCanSend(pAsync, pRequest))
+        {
+            pNext = pRequest;
+        }
+    }
+
+    return pNext;
+}
+
+/*!
+ * Complete a request, either calling its callback or queuing its completion.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   pRequest                    Request, pending or in flight.
+ * \param[in]   errorCode                   Request result.
+ */
+static void sbgEComCmdAsyncComplete(SbgEComCmdAsync *pAsync, SbgEComCmdAsyncRequest *pRequest, SbgErrorCode errorCode)
+{
+    assert(pAsync);
+    assert(pRequest);
+
+    if (pRequest->state == SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT)
+    {
+        pAsync->nrInFlight--;
+    }
+
+    pAsync->nrActive--;
+
+    free(pRequest->pData);
+    pRequest->pData = NULL;
+
+    pRequest->completion.errorCode = errorCode;
+
+    if (pRequest->pCallback)
+    {
+        SbgEComCmdAsyncCompletion        completion;
+
+        //
+        // The request is released before the callback, which may submit new requests
+        //
+        completion      = pRequest->completion;
+        pRequest->state = SBG_ECOM_CMD_ASYNC_STATE_FREE;
+
+        pRequest->pCallback(pAsync, &completion, pRequest->pUserArg);
+
+        sbgEComProtocolPayloadDestroy(&completion.payload);
+    }
+    else
+    {
+        pRequest->state     = SBG_ECOM_CMD_ASYNC_STATE_COMPLETED;
+        pRequest->sequence  = pAsync->nextSequence;
+
+        pAsync->nextSequence++;
+    }
+}
+
+/*!
+ * Complete the request a received command frame answers.
+ *
+ * Frames that don't answer any request in flight are ignored, as well as the frames received while an
+ * older request of the same class and ID waits to be resent: they may be late answers to its previous trial.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pPayload                    Payload, its buffer is moved to the completion of an answered request.
+ */
+static void sbgEComCmdAsyncHandleFrame(SbgEComCmdAsync *pAsync, uint8_t msgClass, uint8_t msgId, SbgEComProtocolPayload *pPayload)
+{
+    SbgEComCmdAsyncRequest              *pRequest = NULL;
+    bool                                 isAck;
+    uint8_t                              cmdClass;
+    uint8_t                              cmdId;
+    SbgErrorCode                         ackErrorCode = SBG_NO_ERROR;
+    bool                                 valid = true;
+
+    assert(pAsync);
+    assert(pPayload);
+
+    isAck       = (msgClass == SBG_ECOM_CLASS_LOG_CMD_0) && (msgId == SBG_ECOM_CMD_ACK);
+    cmdClass    = msgClass;
+    cmdId       = msgId;
+
+    if (isAck)
+    {
+        SbgStreamBuffer                  streamBuffer;
+
+        //
+        // The ACK frame contains the ACK message ID and class, and a uint16_t for the return error code
+        //
+        sbgStreamBufferInitForRead(&streamBuffer, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload));
+
+        cmdId           = sbgStreamBufferReadUint8LE(&streamBuffer);
+        cmdClass        = sbgStreamBufferReadUint8LE(&streamBuffer);
+        ackErrorCode    = (SbgErrorCode)sbgStreamBufferReadUint16LE(&streamBuffer);
+
+        valid = (sbgStreamBufferGetLastError(&streamBuffer) == SBG_NO_ERROR);
+    }
+
+    if (valid)
+    {
+        //
+        // The device answers in order, the oldest request sent with this class and ID is answered first
+        //
+        for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+        {
+            SbgEComCmdAsyncRequest      *pCandidate = &pAsync->requests[i];
+            bool                         sent;
+
+            sent = (pCandidate->state == SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT) ||
+                   ((pCandidate->state == SBG_ECOM_CMD_ASYNC_STATE_PENDING) && (pCandidate->completion.nrTrials != 0));
+
+            if (sent && (pCandidate->completion.msgClass == cmdClass) && (pCandidate->completion.msgId == cmdId) &&
+                (isAck || (pCandidate->reply == SBG_ECOM_CMD_ASYNC_REPLY_ANSWER)))
+            {
+                if (!pRequest || (pCandidate->sequence < pRequest->sequence))
+                {
+                    pRequest = pCandidate;
+                }
+            }
+        }
+
+        //
+        // The frame may be a late answer to a previous trial of a request waiting to be resent
+        //
+        if (pRequest && (pRequest->state != SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT))
+        {
+            pRequest = NULL;
+        }
+    }
+
+    if (pRequest)
+    {
+        SbgErrorCode                     errorCode;
+
+        if (isAck)
+        {
+            //
+            // An ACK received instead of an answer reports an error, even if successful
+            //
+            if ((pRequest->reply == SBG_ECOM_CMD_ASYNC_REPLY_ANSWER) && (ackErrorCode == SBG_NO_ERROR))
+            {
+                errorCode = SBG_ERROR;
+            }
+            else
+            {
+                errorCode = ackErrorCode;
+            }
+        }
+        else
+        {
+            size_t                       size;
+            void                        *pBuffer;
+
+            size    = sbgEComProtocolPayloadGetSize(pPayload);
+            pBuffer = sbgEComProtocolPayloadMoveBuffer(pPayload);
+
+            if (pBuffer || (size == 0))
+            {
+                pRequest->completion.payload.allocated  = true;
+                pRequest->completion.payload.pBuffer    = pBuffer;
+                pRequest->completion.payload.size       = size;
+
+                errorCode = SBG_NO_ERROR;
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+            }
+        }
+
+        sbgEComCmdAsyncComplete(pAsync, pRequest, errorCode);
+    }
+}
+
+/*!
+ * Resend or complete the timed out requests, and send the pending requests the window has room for.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ */
+static void sbgEComCmdAsyncUpdate(SbgEComCmdAsync *pAsync)
+{
+    uint32_t                             now;
+
+    assert(pAsync);
+
+    now = sbgGetTime();
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        SbgEComCmdAsyncRequest          *pRequest = &pAsync->requests[i];
+
+        if ((pRequest->state == SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT) && ((now - pRequest->sendTime) >= pRequest->timeOut))
+        {
+            if (pRequest->completion.nrTrials < pRequest->maxTrials)
+            {
+                //
+                // The request keeps its submission order, it is resent before the requests submitted after it
+                //
+                pRequest->state = SBG_ECOM_CMD_ASYNC_STATE_PENDING;
+                pAsync->nrInFlight--;
+            }
+            else
+            {
+                sbgEComCmdAsyncComplete(pAsync, pRequest, SBG_TIME_OUT);
+            }
+        }
+    }
+
+    while (pAsync->nrInFlight < pAsync->windowSize)
+    {
+        SbgEComCmdAsyncRequest          *pRequest;
+        SbgErrorCode                     errorCode;
+
+        pRequest = sbgEComCmdAsyncFindNextToSend(pAsync);
+
+        if (!pRequest)
+        {
+            break;
+        }
+
+        errorCode = sbgEComProtocolSend(&pAsync->pHandle->protocolHandle, pRequest->completion.msgClass, pRequest->completion.msgId, pRequest->pData, pRequest->size);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            pRequest->state     = SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT;
+            pRequest->sendTime  = sbgGetTime();
+
+            pRequest->completion.nrTrials++;
+            pAsync->nrInFlight++;
+        }
+        else
+        {
+            //
+            // We have a write error so don't retry
+            //
+            sbgEComCmdAsyncComplete(pAsync, pRequest, errorCode);
+        }
+    }
+}
+
+/*!
+ * Get the time until the first request in flight times out.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \return                                  Time until the first time out, in ms, at least 1.
+ */
+static uint32_t sbgEComCmdAsyncGetNextTimeOut(const SbgEComCmdAsync *pAsync)
+{
+    uint32_t                             nextTimeOut = UINT32_MAX;
+    uint32_t                             now;
+
+    assert(pAsync);
+
+    now = sbgGetTime();
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        const SbgEComCmdAsyncRequest    *pRequest = &pAsync->requests[i];
+
+        if (pRequest->state == SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT)
+        {
+            uint32_t                     elapsed;
+
+            elapsed = now - pRequest->sendTime;
+
+            if (elapsed < pRequest->timeOut)
+            {
+                nextTimeOut = sbgMin(nextTimeOut, pRequest->timeOut - elapsed);
+            }
+            else
+            {
+                nextTimeOut = 1;
+            }
+        }
+    }
+
+    return sbgMax(nextTimeOut, 1);
+}
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+void sbgEComCmdAsyncConstruct(SbgEComCmdAsync *pAsync, SbgEComHandle *pHandle)
+{
+    assert(pAsync);
+    assert(pHandle);
+
+    memset(pAsync, 0, sizeof(*pAsync));
+
+    pAsync->pHandle     = pHandle;
+    pAsync->windowSize  = SBG_ECOM_CMD_ASYNC_DEFAULT_WINDOW_SIZE;
+}
+
+void sbgEComCmdAsyncDestroy(SbgEComCmdAsync *pAsync)
+{
+    assert(pAsync);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pAsync->requests); i++)
+    {
+        SbgEComCmdAsyncRequest          *pRequest = &pAsync->requests[i];
+
+        if (pRequest->state != SBG_ECOM_CMD_ASYNC_STATE_FREE)
+        {
+            free(pRequest->pData);
+            sbgEComProtocolPayloadDestroy(&pRequest->completion.payload);
+
+            pRequest->state = SBG_ECOM_CMD_ASYNC_STATE_FREE;
+        }
+    }
+
+    pAsync->nrInFlight  = 0;
+    pAsync->nrActive    = 0;
+}
+
+void sbgEComCmdAsyncSetWindowSize(SbgEComCmdAsync *pAsync, size_t windowSize)
+{
+    assert(pAsync);
+    assert((windowSize >= 1) && (windowSize <= SBG_ECOM_CMD_ASYNC_MAX_REQUESTS));
+
+    pAsync->windowSize = windowSize;
+}
+
+SbgErrorCode sbgEComCmdAsyncSubmit(SbgEComCmdAsync *pAsync, uint8_t msgClass, uint8_t msgId, SbgEComCmdAsyncReply reply, const void *pData, size_t size, uint32_t maxTrials, uint32_t timeOut, SbgEComCmdAsyncCallback pCallback, void *pUserArg, uint32_t *pRequestId)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComCmdAsyncRequest              *pRequest;
+
+    assert(pAsync);
+    assert(pData || (size == 0));
+
+    pRequest = sbgEComCmdAsyncFindOldest(pAsync, SBG_ECOM_CMD_ASYNC_STATE_FREE);
+
+    if (pRequest)
+    {
+        pRequest->pData = NULL;
+
+        if (size != 0)
+        {
+            pRequest->pData = malloc(size);
+
+            if (pRequest->pData)
+            {
+                memcpy(pRequest->pData, pData, size);
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+                SBG_LOG_ERROR(errorCode, "unable to allocate request payload");
+            }
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            pRequest->state         = SBG_ECOM_CMD_ASYNC_STATE_PENDING;
+            pRequest->reply         = reply;
+            pRequest->sequence      = pAsync->nextSequence;
+            pRequest->size          = size;
+            pRequest->maxTrials     = (maxTrials != 0) ? maxTrials : sbgMax(pAsync->pHandle->numTrials, 1);
+            pRequest->timeOut       = (timeOut != 0) ? timeOut : pAsync->pHandle->cmdDefaultTimeOut;
+            pRequest->sendTime      = 0;
+            pRequest->pCallback     = pCallback;
+            pRequest->pUserArg      = pUserArg;
+
+            pRequest->completion.requestId  = pAsync->nextRequestId;
+            pRequest->completion.msgClass   = msgClass;
+            pRequest->completion.msgId      = msgId;
+            pRequest->completion.errorCode  = SBG_NOT_READY;
+            pRequest->completion.nrTrials   = 0;
+            sbgEComProtocolPayloadConstruct(&pRequest->completion.payload);
+
+            if (pRequestId)
+            {
+                *pRequestId = pAsync->nextRequestId;
+            }
+
+            pAsync->nextSequence++;
+            pAsync->nextRequestId++;
+            pAsync->nrActive++;
+        }
+    }
+    else
+    {
+        errorCode = SBG_BUFFER_OVERFLOW;
+        SBG_LOG_ERROR(errorCode, "too many requests not completed");
+    }
+
+    return errorCode;
+}
+
+void sbgEComCmdAsyncProcess(SbgEComCmdAsync *pAsync)
+{
+    SbgErrorCode                         errorCode;
+    SbgEComProtocolPayload               payload;
+
+    assert(pAsync);
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    //
+    // Handle all the received frames first, to free room in the window
+    //
+    do
+    {
+        uint8_t                          receivedMsgClass;
+        uint8_t                          receivedMsgId;
+
+        errorCode = sbgEComReceiveAnyCmd2(pAsync->pHandle, &receivedMsgClass, &receivedMsgId, &payload, 0);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComCmdAsyncHandleFrame(pAsync, receivedMsgClass, receivedMsgId, &payload);
+        }
+    } while (errorCode != SBG_NOT_READY);
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    sbgEComCmdAsyncUpdate(pAsync);
+}
+
+SbgErrorCode sbgEComCmdAsyncWaitAll(SbgEComCmdAsync *pAsync, uint32_t timeOut)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComProtocolPayload               payload;
+    uint32_t                             start;
+
+    assert(pAsync);
+
+    start = sbgGetTime();
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    sbgEComCmdAsyncProcess(pAsync);
+
+    while (pAsync->nrActive != 0)
+    {
+        uint32_t                         elapsed;
+        uint8_t                          receivedMsgClass;
+        uint8_t                          receivedMsgId;
+
+        elapsed = sbgGetTime() - start;
+
+        if (elapsed >= timeOut)
+        {
+            errorCode = SBG_TIME_OUT;
+            break;
+        }
+
+        //
+        // Block until a command frame is received or a request times out, received logs are handled meanwhile
+        //
+        if (sbgEComReceiveAnyCmd2(pAsync->pHandle, &receivedMsgClass, &receivedMsgId, &payload, sbgMin(timeOut - elapsed, sbgEComCmdAsyncGetNextTimeOut(pAsync))) == SBG_NO_ERROR)
+        {
+            sbgEComCmdAsyncHandleFrame(pAsync, receivedMsgClass, receivedMsgId, &payload);
+        }
+
+        sbgEComCmdAsyncProcess(pAsync);
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return errorCode;
+}
+
+size_t sbgEComCmdAsyncGetNrActive(const SbgEComCmdAsync *pAsync)
+{
+    assert(pAsync);
+
+    return pAsync->nrActive;
+}
+
+SbgErrorCode sbgEComCmdAsyncPopCompletion(SbgEComCmdAsync *pAsync, SbgEComCmdAsyncCompletion *pCompletion)
+{
+    SbgErrorCode                         errorCode = SBG_NOT_READY;
+    SbgEComCmdAsyncRequest              *pRequest;
+
+    assert(pAsync);
+    assert(pCompletion);
+
+    pRequest = sbgEComCmdAsyncFindOldest(pAsync, SBG_ECOM_CMD_ASYNC_STATE_COMPLETED);
+
+    if (pRequest)
+    {
+        *pCompletion    = pRequest->completion;
+        pRequest->state = SBG_ECOM_CMD_ASYNC_STATE_FREE;
+
+        errorCode = SBG_NO_ERROR;
+    }
+
+    return errorCode;
+}
@@ -0,0 +1,245 @@
+/*!
+ * \file            sbgEComCmdAsync.h
+ * \ingroup         commands
+ * \author          SBG Systems
+ * \date            16 October 2026
+ *
+ * \brief           Asynchronous commands, several requests being in flight at once.
+ *
+ * Requests are submitted without waiting for the device answer. They are sent in submission order,
+ * up to a window of requests in flight, and answers and ACKs are matched to them by message class
+ * and ID. As the device answers commands in order, requests sharing the same class and ID are
+ * completed in the order they have been sent.
+ *
+ * Each request is retried on its own time out, then completed with a callback or, if it has none,
+ * stored in a completion queue polled with sbgEComCmdAsyncPopCompletion(). While a request waits to
+ * be resent, the answers of its class and ID are ignored, as they may be late answers to its previous
+ * trial, and until it is completed the requests of its class and ID are sent one at a time.
+ *
+ * Requests are processed by sbgEComCmdAsyncProcess() or sbgEComCmdAsyncWaitAll(), from a single
+ * thread. Received logs are handled as with the synchronous commands.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+#ifndef SBG_ECOM_CMD_ASYNC_H
+#define SBG_ECOM_CMD_ASYNC_H
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// Project headers
+#include <sbgECom.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_CMD_ASYNC_MAX_REQUESTS         (64)        /*!< Maximum number of requests submitted and not completed, or completed and not popped. */
+#define SBG_ECOM_CMD_ASYNC_DEFAULT_WINDOW_SIZE  (8)         /*!< Default maximum number of requests in flight, kept low not to overflow the device input buffer. */
+
+/*!
+ * Answer expected for a request.
+ */
+typedef enum _SbgEComCmdAsyncReply
+{
+    SBG_ECOM_CMD_ASYNC_REPLY_ACK            = 0,            /*!< The device acknowledges the command, the request fails with the ACK error code. */
+    SBG_ECOM_CMD_ASYNC_REPLY_ANSWER         = 1,            /*!< The device answers with a frame of the same class and ID, or reports an error with an ACK. */
+} SbgEComCmdAsyncReply;
+
+/*!
+ * Request state.
+ */
+typedef enum _SbgEComCmdAsyncState
+{
+    SBG_ECOM_CMD_ASYNC_STATE_FREE           = 0,            /*!< Unused entry. */
+    SBG_ECOM_CMD_ASYNC_STATE_PENDING        = 1,            /*!< Waiting to be sent, or resent. */
+    SBG_ECOM_CMD_ASYNC_STATE_IN_FLIGHT      = 2,            /*!< Sent, waiting for the device answer. */
+    SBG_ECOM_CMD_ASYNC_STATE_COMPLETED      = 3,            /*!< Completed, waiting to be popped from the completion queue. */
+} SbgEComCmdAsyncState;
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Asynchronous command context pre-definition.
+ */
+typedef struct _SbgEComCmdAsync SbgEComCmdAsync;
+
+/*!
+ * Completion of a request.
+ */
+typedef struct _SbgEComCmdAsyncCompletion
+{
+    uint32_t                             requestId;                 /*!< Request ID returned on submission. */
+    uint8_t                              msgClass;                  /*!< Message class of the request. */
+    uint8_t                              msgId;                     /*!< Message ID of the request. */
+    SbgErrorCode                         errorCode;                 /*!< SBG_NO_ERROR if successful, SBG_TIME_OUT if all trials have timed out, or the error reported by the device. */
+    uint32_t                             nrTrials;                  /*!< Number of times the request has been sent. */
+    SbgEComProtocolPayload               payload;                   /*!< Answer payload, empty for SBG_ECOM_CMD_ASYNC_REPLY_ACK requests. */
+} SbgEComCmdAsyncCompletion;
+
+/*!
+ * Callback called when a request is completed.
+ *
+ * The completion, and its payload, are only valid during the call. New requests may be submitted from the callback.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   pCompletion                 Completion.
+ * \param[in]   pUserArg                    Optional user argument given on submission.
+ */
+typedef void (*SbgEComCmdAsyncCallback)(SbgEComCmdAsync *pAsync, const SbgEComCmdAsyncCompletion *pCompletion, void *pUserArg);
+
+/*!
+ * Request.
+ */
+typedef struct _SbgEComCmdAsyncRequest
+{
+    SbgEComCmdAsyncState                 state;                     /*!< Request state. */
+    SbgEComCmdAsyncReply                 reply;                     /*!< Answer expected. */
+    size_t                               sequence;                  /*!< Submission order, or completion order once completed. */
+    uint8_t                             *pData;                     /*!< Command payload, allocated with malloc(), NULL if empty. */
+    size_t                               size;                      /*!< Command payload size, in bytes. */
+    uint32_t                             maxTrials;                 /*!< Maximum number of times the request is sent. */
+    uint32_t                             timeOut;                   /*!< Time out of each trial, in ms. */
+    uint32_t                             sendTime;                  /*!< Time of the last trial, in ms. */
+    SbgEComCmdAsyncCallback              pCallback;                 /*!< Completion callback, NULL to use the completion queue. */
+    void                                *pUserArg;                  /*!< Optional user argument passed to the callback. */
+    SbgEComCmdAsyncCompletion            completion;                /*!< Completion, the request ID, class and ID are set on submission. */
+} SbgEComCmdAsyncRequest;
+
+/*!
+ * Asynchronous command context.
+ */
+struct _SbgEComCmdAsync
+{
+    SbgEComHandle                       *pHandle;                   /*!< sbgECom handle the commands are sent with. */
+    size_t                               windowSize;                /*!< Maximum number of requests in flight. */
+    size_t                               nrInFlight;                /*!< Number of requests in flight. */
+    size_t                               nrActive;                  /*!< Number of requests pending or in flight. */
+    size_t                               nextSequence;              /*!< Next sequence number. */
+    uint32_t                             nextRequestId;             /*!< ID of the next submitted request. */
+    SbgEComCmdAsyncRequest               requests[SBG_ECOM_CMD_ASYNC_MAX_REQUESTS];     /*!< Requests. */
+};
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Asynchronous command context constructor.
+ *
+ * \param[out]  pAsync                      Asynchronous command context.
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ */
+void sbgEComCmdAsyncConstruct(SbgEComCmdAsync *pAsync, SbgEComHandle *pHandle);
+
+/*!
+ * Asynchronous command context destructor.
+ *
+ * Requests that aren't completed are discarded, without calling their callback.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ */
+void sbgEComCmdAsyncDestroy(SbgEComCmdAsync *pAsync);
+
+/*!
+ * Set the maximum number of requests in flight.
+ *
+ * A window of 1 sends the requests one after the other, like the synchronous commands.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   windowSize                  Maximum number of requests in flight, between 1 and SBG_ECOM_CMD_ASYNC_MAX_REQUESTS.
+ */
+void sbgEComCmdAsyncSetWindowSize(SbgEComCmdAsync *pAsync, size_t windowSize);
+
+/*!
+ * Submit a request.
+ *
+ * The request is sent by the next call to sbgEComCmdAsyncProcess() or sbgEComCmdAsyncWaitAll().
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   reply                       Answer expected.
+ * \param[in]   pData                       Command payload, copied, may be NULL if size is 0.
+ * \param[in]   size                        Command payload size, in bytes.
+ * \param[in]   maxTrials                   Maximum number of times the request is sent, 0 for the handle number of trials.
+ * \param[in]   timeOut                     Time out of each trial, in ms, 0 for the handle default time out.
+ * \param[in]   pCallback                   Completion callback, NULL to use the completion queue.
+ * \param[in]   pUserArg                    Optional user argument passed to the callback.
+ * \param[out]  pRequestId                  Request ID, may be NULL.
+ * \return                                  SBG_NO_ERROR if the request has been submitted,
+ *                                          SBG_BUFFER_OVERFLOW if there are too many requests not completed or not popped.
+ */
+SbgErrorCode sbgEComCmdAsyncSubmit(SbgEComCmdAsync *pAsync, uint8_t msgClass, uint8_t msgId, SbgEComCmdAsyncReply reply, const void *pData, size_t size, uint32_t maxTrials, uint32_t timeOut, SbgEComCmdAsyncCallback pCallback, void *pUserArg, uint32_t *pRequestId);
+
+/*!
+ * Process the requests without waiting.
+ *
+ * Received answers complete their requests, timed out requests are resent or completed, and
+ * pending requests are sent as long as the window isn't full.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ */
+void sbgEComCmdAsyncProcess(SbgEComCmdAsync *pAsync);
+
+/*!
+ * Process the requests until all of them are completed.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   timeOut                     Time-out, in ms.
+ * \return                                  SBG_NO_ERROR if all requests are completed, SBG_TIME_OUT otherwise.
+ */
+SbgErrorCode sbgEComCmdAsyncWaitAll(SbgEComCmdAsync *pAsync, uint32_t timeOut);
+
+/*!
+ * Get the number of requests not completed yet.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \return                                  Number of requests pending or in flight.
+ */
+size_t sbgEComCmdAsyncGetNrActive(const SbgEComCmdAsync *pAsync);
+
+/*!
+ * Pop the oldest completion of the requests submitted without callback.
+ *
+ * The ownership of the completion payload is passed to the caller, it must be destroyed once unused.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[out]  pCompletion                 Completion.
+ * \return                                  SBG_NO_ERROR if a completion has been popped, SBG_NOT_READY if the queue is empty.
+ */
+SbgErrorCode sbgEComCmdAsyncPopCompletion(SbgEComCmdAsync *pAsync, SbgEComCmdAsyncCompletion *pCompletion);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SBG_ECOM_CMD_ASYNC_H
@@ -8,6 +8,51 @@
 // Local headers
 #include "sbgEComCmdCommon.h"
 
+//----------------------------------------------------------------------//
+//- Private functions                                                  -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Get the error reported by an ACK received instead of the answer to a command.
+ *
+ * \param[in]   pPayload                    ACK payload.
+ * \return                                  Error code reported by the ACK, SBG_ERROR if the ACK is successful.
+ */
+static SbgErrorCode sbgEComGetAckErrorCode(const SbgEComProtocolPayload *pPayload)
+{
+    SbgErrorCode                         errorCode;
+    SbgStreamBuffer                      streamBuffer;
+    SbgErrorCode                         ackErrorCode;
+
+    assert(pPayload);
+
+    sbgStreamBufferInitForRead(&streamBuffer, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload));
+
+    sbgStreamBufferSeek(&streamBuffer, 2 * sizeof(uint8_t), SB_SEEK_SET);
+    ackErrorCode = (SbgErrorCode)sbgStreamBufferReadUint16LE(&streamBuffer);
+
+    errorCode = sbgStreamBufferGetLastError(&streamBuffer);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        //
+        // If a successful ACK is expected, the caller should instead explicitly wait for it
+        //
+        if (ackErrorCode != SBG_NO_ERROR)
+        {
+            errorCode = ackErrorCode;
+        }
+        else
+        {
+            errorCode = SBG_ERROR;
+        }
+    }
+
+    return errorCode;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
 //----------------------------------------------------------------------//
 //- Common command reception operations                                -//
 //----------------------------------------------------------------------//
@@ -61,94 +106,111 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint8_t *pMsgClass, ui
 SbgErrorCode sbgEComReceiveAnyCmd2(SbgEComHandle *pHandle, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload, uint32_t timeOut)
 {
     SbgErrorCode                         errorCode;
-    uint32_t                             start;
 
     assert(pHandle);
 
-    if (timeOut > 0)
-    {
-        start = sbgGetTime();
-    }
-    else
-    {
-        //
-        // Avoid compiler warning
-        //
-        start = 0;
-    }
-
-    for (;;)
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
     {
         uint8_t                          receivedMsgClass;
         uint8_t                          receivedMsgId;
-        uint32_t                         now;
 
-        errorCode = sbgEComProtocolReceive2(&pHandle->protocolHandle, &receivedMsgClass, &receivedMsgId, pPayload);
+        //
+        // Logs are left to the thread handling them, only command frames are received
+        //
+        errorCode = sbgEComReceiveCmdFrame(pHandle, SBG_ECOM_CMD_MATCH_ANY, 0, 0, &receivedMsgClass, &receivedMsgId, pPayload, timeOut);
 
         if (errorCode == SBG_NO_ERROR)
         {
-            if (sbgEComMsgClassIsALog((SbgEComClass)receivedMsgClass))
+            if (pMsgClass)
             {
-                if (pHandle->pReceiveLogCallback)
-                {
-                    SbgEComLogUnion          logData;
-
-                    errorCode = sbgEComLogParse((SbgEComClass)receivedMsgClass, receivedMsgId, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload), &logData);
-
-                    if (errorCode == SBG_NO_ERROR)
-                    {
-                        pHandle->pReceiveLogCallback(pHandle, (SbgEComClass)receivedMsgClass, receivedMsgId, &logData, pHandle->pUserArg);                      
-
-                        sbgEComLogCleanup(&logData, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsgId);
-                    }
-                }
+                *pMsgClass = receivedMsgClass;
             }
-            else
-            {
-                if (pMsgClass)
-                {
-                    *pMsgClass = receivedMsgClass;
-                }
 
-                if (pMsgId)
-                {
-                    *pMsgId = receivedMsgId;
-                }
-
-                break;
+            if (pMsgId)
+            {
+                *pMsgId = receivedMsgId;
             }
         }
-        
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        uint32_t                         start;
+
         if (timeOut > 0)
+        {
+            start = sbgGetTime();
+        }
+        else
         {
             //
-            // Only sleep if the Rx buffer is empty, otherwise we should retry ASAP to drain it
+            // Avoid compiler warning
             //
-            if (errorCode == SBG_NOT_READY)
-            {
-                sbgSleep(1);
-            }
+            start = 0;
+        }
 
-            now = sbgGetTime();
+        for (;;)
+        {
+            uint8_t                      receivedMsgClass;
+            uint8_t                      receivedMsgId;
+            uint32_t                     now;
 
-            if ((now - start) >= timeOut)
+            errorCode = sbgEComReceiveFrame(pHandle, &receivedMsgClass, &receivedMsgId, pPayload);
+
+            if (errorCode == SBG_NO_ERROR)
             {
-                errorCode = SBG_TIME_OUT;
-                break;
+                if (sbgEComMsgClassIsALog((SbgEComClass)receivedMsgClass) || sbgEComLogGetDecoder((SbgEComClass)receivedMsgClass, receivedMsgId))
+                {
+                    sbgEComHandleLog(pHandle, (SbgEComClass)receivedMsgClass, receivedMsgId, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload));
+                }
+                else
+                {
+                    if (pMsgClass)
+                    {
+                        *pMsgClass = receivedMsgClass;
+                    }
+
+                    if (pMsgId)
+                    {
+                        *pMsgId = receivedMsgId;
+                    }
+
+                    break;
+                }
             }
-        }
-        else
-        {
-            if (errorCode == SBG_NO_ERROR)
+        
+            if (timeOut > 0)
             {
-                errorCode = SBG_TIME_OUT;
+                now = sbgGetTime();
+
+                if ((now - start) >= timeOut)
+                {
+                    errorCode = SBG_TIME_OUT;
+                    break;
+                }
+
+                //
+                // Only wait if the Rx buffer is empty, otherwise we should retry ASAP to drain it
+                //
+                if (errorCode == SBG_NOT_READY)
+                {
+                    sbgEComWaitFrame(pHandle, timeOut - (now - start));
+                }
             }
             else
             {
-                errorCode = SBG_NOT_READY;
-            }
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    errorCode = SBG_TIME_OUT;
+                }
+                else
+                {
+                    errorCode = SBG_NOT_READY;
+                }
             
-            break;
+                break;
+            }
         }
     }
 
@@ -200,71 +262,96 @@ SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t
 SbgErrorCode sbgEComReceiveCmd2(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t msgId, SbgEComProtocolPayload *pPayload, uint32_t timeOut)
 {
     SbgErrorCode                         errorCode;
-    uint32_t                             start;
 
     assert(pHandle);
 
-    start = sbgGetTime();
-
-    for (;;)
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
     {
         uint8_t                          receivedMsgClass;
         uint8_t                          receivedMsgId;
-        uint32_t                         now;
 
-        errorCode = sbgEComReceiveAnyCmd2(pHandle, &receivedMsgClass, &receivedMsgId, pPayload, 0);
+        //
+        // Only take the answer or the ACK of this command, frames of commands issued by other threads are left to them
+        //
+        errorCode = sbgEComReceiveCmdFrame(pHandle, SBG_ECOM_CMD_MATCH_REPLY, msgClass, msgId, &receivedMsgClass, &receivedMsgId, pPayload, timeOut);
 
-        if (errorCode == SBG_NO_ERROR)
+        if ((errorCode == SBG_NO_ERROR) && ((receivedMsgClass != msgClass) || (receivedMsgId != msgId)))
         {
-            if ((receivedMsgClass == msgClass) && (receivedMsgId == msgId))
-            {
-                break;
-            }
-            else if ((receivedMsgClass == SBG_ECOM_CLASS_LOG_CMD_0) && (receivedMsgId == SBG_ECOM_CMD_ACK))
-            {
-                SbgStreamBuffer          streamBuffer;
-                uint8_t                  ackMsgClass;
-                uint8_t                  ackMsgId;
-                SbgErrorCode             ackErrorCode;
+            errorCode = sbgEComGetAckErrorCode(pPayload);
+        }
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        uint32_t                         start;
 
-                sbgStreamBufferInitForRead(&streamBuffer, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload));
+        start = sbgGetTime();
 
-                ackMsgId        = sbgStreamBufferReadUint8(&streamBuffer);
-                ackMsgClass     = sbgStreamBufferReadUint8(&streamBuffer);
-                ackErrorCode    = (SbgErrorCode)sbgStreamBufferReadUint16LE(&streamBuffer);
+        for (;;)
+        {
+            uint8_t                      receivedMsgClass;
+            uint8_t                      receivedMsgId;
+            uint32_t                     now;
 
-                errorCode = sbgStreamBufferGetLastError(&streamBuffer);
+            errorCode = sbgEComReceiveAnyCmd2(pHandle, &receivedMsgClass, &receivedMsgId, pPayload, 0);
 
-                if ((errorCode == SBG_NO_ERROR) && (ackMsgClass == msgClass) && (ackMsgId == msgId))
+            if (errorCode == SBG_NO_ERROR)
+            {
+                if ((receivedMsgClass == msgClass) && (receivedMsgId == msgId))
                 {
-                    //
-                    // If a successful ACK is expected, the caller should instead explicitly wait for it.
-                    // Receiving a successful ACK that corresponds to the requested class/message is thus an error!
-                    //
-                    if (ackErrorCode != SBG_NO_ERROR)
-                    {
-                        errorCode = ackErrorCode;
-                    }
-                    else
+                    break;
+                }
+                else if ((receivedMsgClass == SBG_ECOM_CLASS_LOG_CMD_0) && (receivedMsgId == SBG_ECOM_CMD_ACK))
+                {
+                    SbgStreamBuffer      streamBuffer;
+                    uint8_t              ackMsgClass;
+                    uint8_t              ackMsgId;
+                    SbgErrorCode         ackErrorCode;
+
+                    sbgStreamBufferInitForRead(&streamBuffer, sbgEComProtocolPayloadGetBuffer(pPayload), sbgEComProtocolPayloadGetSize(pPayload));
+
+                    ackMsgId        = sbgStreamBufferReadUint8(&streamBuffer);
+                    ackMsgClass     = sbgStreamBufferReadUint8(&streamBuffer);
+                    ackErrorCode    = (SbgErrorCode)sbgStreamBufferReadUint16LE(&streamBuffer);
+
+                    errorCode = sbgStreamBufferGetLastError(&streamBuffer);
+
+                    if ((errorCode == SBG_NO_ERROR) && (ackMsgClass == msgClass) && (ackMsgId == msgId))
                     {
-                        errorCode = SBG_ERROR;
+                        //
+                        // If a successful ACK is expected, the caller should instead explicitly wait for it.
+                        // Receiving a successful ACK that corresponds to the requested class/message is thus an error!
+                        //
+                        if (ackErrorCode != SBG_NO_ERROR)
+                        {
+                            errorCode = ackErrorCode;
+                        }
+                        else
+                        {
+                            errorCode = SBG_ERROR;
+                        }
+
+                        break;
                     }
-
-                    break;
                 }
             }
-        }
-        else if (errorCode == SBG_NOT_READY)
-        {
-            sbgSleep(1);
-        }
         
-        now = sbgGetTime();
+            now = sbgGetTime();
 
-        if ((now - start) >= timeOut)
-        {
-            errorCode = SBG_TIME_OUT;
-            break;
+            if ((now - start) >= timeOut)
+            {
+                errorCode = SBG_TIME_OUT;
+                break;
+            }
+
+            //
+            // Wait for new data rather than sleeping, to handle the answer as soon as it is received
+            //
+            if (errorCode == SBG_NOT_READY)
+            {
+                sbgEComWaitFrame(pHandle, timeOut - (now - start));
+            }
         }
     }
 
@@ -286,10 +373,22 @@ SbgErrorCode sbgEComWaitForAck(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t
 
     sbgEComProtocolPayloadConstruct(&receivedPayload);
 
-    //
-    // Try to receive the ACK and discard any other received log
-    //
-    errorCode = sbgEComReceiveCmd2(pHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, &receivedPayload, timeOut);
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        //
+        // Only take the ACK of this command, ACKs of commands issued by other threads are left to them
+        //
+        errorCode = sbgEComReceiveCmdFrame(pHandle, SBG_ECOM_CMD_MATCH_ACK, msgClass, msg, &ackClass, &ackMsg, &receivedPayload, timeOut);
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        //
+        // Try to receive the ACK and discard any other received log
+        //
+        errorCode = sbgEComReceiveCmd2(pHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, &receivedPayload, timeOut);
+    }
 
     if (errorCode == SBG_NO_ERROR)
     {
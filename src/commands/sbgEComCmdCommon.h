@@ -98,7 +98,8 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint8_t *pMsgClass, ui
 /*!
  * Receive a command message.
  *
- * All binary logs received are handled trough the standard callback system.
+ * All binary logs received are handled trough the standard callback system, unless the reader thread
+ * is running in which case they are left to the thread handling them.
  *
  * This function is equivalent to sbgEComReceiveAnyCmd() with two exceptions :
  *  - the use of a payload object allows handling payloads not limited by the size of a user-provided buffer
@@ -147,7 +148,8 @@ SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t
  *
  * This function also processes ACK messages for the given class and ID.
  *
- * All binary logs received during this time are handled trough the standard callback system.
+ * All binary logs received during this time are handled trough the standard callback system, unless
+ * the reader thread is running. Several threads may then wait for different commands concurrently.
  *
  * This function is equivalent to sbgEComReceiveCmd() with two exceptions :
  *  - the use of a payload object allows handling payloads not limited by the size of a user-provided buffer
@@ -157,6 +157,26 @@ SbgErrorCode sbgEComCmdOutputSetConf(SbgEComHandle *pHandle, SbgEComOutputPort o
     return errorCode;
 }
 
+SbgErrorCode sbgEComCmdOutputSetConfAsync(SbgEComCmdAsync *pAsync, SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode, SbgEComCmdAsyncCallback pCallback, void *pUserArg, uint32_t *pRequestId)
+{
+    uint8_t             outputBuffer[5];
+    SbgStreamBuffer     outputStream;
+
+    assert(pAsync);
+
+    //
+    // Build the payload to send
+    //
+    sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+    sbgStreamBufferWriteUint8LE(&outputStream, (uint8_t)outputPort);
+    sbgStreamBufferWriteUint8LE(&outputStream, (uint8_t)msgId);
+    sbgStreamBufferWriteUint8LE(&outputStream, (uint8_t)classId);
+    sbgStreamBufferWriteUint16LE(&outputStream, (uint16_t)mode);
+
+    return sbgEComCmdAsyncSubmit(pAsync, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF, SBG_ECOM_CMD_ASYNC_REPLY_ACK, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream), 0, 0, pCallback, pUserArg, pRequestId);
+}
+
 SbgErrorCode sbgEComCmdOutputClassGetEnable(SbgEComHandle *pHandle, SbgEComOutputPort outputPort, SbgEComClass classId, bool *pEnable)
 {
     SbgErrorCode            errorCode = SBG_NO_ERROR;
@@ -39,6 +39,9 @@
 // Project headers
 #include <sbgECom.h>
 
+// Local headers
+#include "sbgEComCmdAsync.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -132,6 +135,23 @@ SbgErrorCode sbgEComCmdOutputGetConf(SbgEComHandle *pHandle, SbgEComOutputPort o
  */
 SbgErrorCode sbgEComCmdOutputSetConf(SbgEComHandle *pHandle, SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode);
 
+/*!
+ * Submit a request to set the configuration of one message for an output interface.
+ *
+ * Meant to configure many messages at once, without waiting for each ACK.
+ *
+ * \param[in]   pAsync                      Asynchronous command context.
+ * \param[in]   outputPort                  The output port of the device for the log concerned.
+ * \param[in]   classId                     The class of the concerned log.
+ * \param[in]   msgId                       The id of the concerned log.
+ * \param[in]   mode                        New output mode to set.
+ * \param[in]   pCallback                   Completion callback, NULL to use the completion queue.
+ * \param[in]   pUserArg                    Optional user argument passed to the callback.
+ * \param[out]  pRequestId                  Request ID, may be NULL.
+ * \return                                  SBG_NO_ERROR if the request has been submitted.
+ */
+SbgErrorCode sbgEComCmdOutputSetConfAsync(SbgEComCmdAsync *pAsync, SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode, SbgEComCmdAsyncCallback pCallback, void *pUserArg, uint32_t *pRequestId);
+
 /*!
  * Retrieve if a whole message class is enabled or not for an output interface.
  *
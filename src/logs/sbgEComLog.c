@@ -29,154 +29,213 @@
 #include "sbgEComLogUsbl.h"
 #include "sbgEComLogUtc.h"
 
+//----------------------------------------------------------------------//
+//- Private definitions                                                -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Define a decode function that wraps the stream reader of a log.
+ *
+ * \param[in]   logName                     Log name, as used by the sbgEComLog<logName>ReadFromStream method.
+ * \param[in]   logType                     Log structure type.
+ */
+#define SBG_ECOM_LOG_DEFINE_DECODE_FUNC(logName, logType)                                              \
+    static SbgErrorCode sbgEComLog##logName##Decode(void *pLogData, SbgStreamBuffer *pStreamBuffer)   \
+    {                                                                                                   \
+        return sbgEComLog##logName##ReadFromStream((logType *)pLogData, pStreamBuffer);                 \
+    }
+
+/*!
+ * Initializer for a built-in log decoder descriptor.
+ *
+ * \param[in]   logName                     Log name.
+ * \param[in]   logType                     Log structure type.
+ * \param[in]   minSize                     Minimum payload size, in bytes.
+ * \param[in]   maxSize                     Maximum payload size, in bytes.
+ */
+#define SBG_ECOM_LOG_DECODER(logName, logType, minSize, maxSize)        { sbgEComLog##logName##Decode, (minSize), (maxSize), sizeof(logType) }
+
+//----------------------------------------------------------------------//
+//- Private functions                                                  -//
+//----------------------------------------------------------------------//
+
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Status,         SbgEComLogStatus)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(ImuLegacy,      SbgEComLogImuLegacy)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(ImuShort,       SbgEComLogImuShort)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(ImuFastLegacy,  SbgEComLogImuFastLegacy)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(EkfEuler,       SbgEComLogEkfEuler)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(EkfQuat,        SbgEComLogEkfQuat)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(EkfNav,         SbgEComLogEkfNav)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(EkfVelBody,     SbgEComLogEkfVelBody)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(EkfRotAccel,    SbgEComLogEkfRotAccel)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(ShipMotion,     SbgEComLogShipMotion)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Odometer,       SbgEComLogOdometer)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Utc,            SbgEComLogUtc)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Ptp,            SbgEComLogPtp)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(GnssVel,        SbgEComLogGnssVel)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(GnssPos,        SbgEComLogGnssPos)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(GnssHdt,        SbgEComLogGnssHdt)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(RawData,        SbgEComLogRawData)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(SatList,        SbgEComLogSatList)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Mag,            SbgEComLogMag)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(MagCalib,       SbgEComLogMagCalib)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Dvl,            SbgEComLogDvl)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(AirData,        SbgEComLogAirData)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Usbl,           SbgEComLogUsbl)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Depth,          SbgEComLogDepth)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Event,          SbgEComLogEvent)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(Diag,           SbgEComLogDiagData)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(SessionInfo,    SbgEComLogSessionInfo)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(RawDataView,    SbgEComLogRawDataView)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(SatListView,    SbgEComLogSatListView)
+SBG_ECOM_LOG_DEFINE_DECODE_FUNC(DiagView,       SbgEComLogDiagView)
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+//
+// Minimum sizes cover the mandatory fields of each log. Logs with a fixed layout
+// don't have a maximum size as newer firmware may append fields to them.
+//
+
+/*!
+ * Built-in decoders of the SBG_ECOM_CLASS_LOG_ECOM_0 class.
+ */
+static const SbgEComLogDecoder          gLogEcom0Decoders[SBG_ECOM_LOG_DECODER_NR_MSG_IDS] =
+{
+    [SBG_ECOM_LOG_STATUS]               = SBG_ECOM_LOG_DECODER(Status,      SbgEComLogStatus,       22, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_IMU_DATA]             = SBG_ECOM_LOG_DECODER(ImuLegacy,   SbgEComLogImuLegacy,    SBG_ECOM_LOG_IMU_LEGACY_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_IMU_SHORT]            = SBG_ECOM_LOG_DECODER(ImuShort,    SbgEComLogImuShort,     SBG_ECOM_LOG_IMU_SHORT_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_EULER]            = SBG_ECOM_LOG_DECODER(EkfEuler,    SbgEComLogEkfEuler,     SBG_ECOM_LOG_EKF_EULER_MIN_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_QUAT]             = SBG_ECOM_LOG_DECODER(EkfQuat,     SbgEComLogEkfQuat,      SBG_ECOM_LOG_EKF_QUAT_MIN_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_NAV]              = SBG_ECOM_LOG_DECODER(EkfNav,      SbgEComLogEkfNav,       SBG_ECOM_LOG_EKF_NAV_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_VEL_BODY]         = SBG_ECOM_LOG_DECODER(EkfVelBody,  SbgEComLogEkfVelBody,   SBG_ECOM_LOG_EKF_VEL_BODY_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_ROT_ACCEL_BODY]   = SBG_ECOM_LOG_DECODER(EkfRotAccel, SbgEComLogEkfRotAccel,  SBG_ECOM_LOG_EKF_ROT_ACCEL_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EKF_ROT_ACCEL_NED]    = SBG_ECOM_LOG_DECODER(EkfRotAccel, SbgEComLogEkfRotAccel,  SBG_ECOM_LOG_EKF_ROT_ACCEL_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_SHIP_MOTION]          = SBG_ECOM_LOG_DECODER(ShipMotion,  SbgEComLogShipMotion,   32, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_SHIP_MOTION_HP]       = SBG_ECOM_LOG_DECODER(ShipMotion,  SbgEComLogShipMotion,   32, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_ODO_VEL]              = SBG_ECOM_LOG_DECODER(Odometer,    SbgEComLogOdometer,     10, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_UTC_TIME]             = SBG_ECOM_LOG_DECODER(Utc,         SbgEComLogUtc,          21, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_PTP_STATUS]           = SBG_ECOM_LOG_DECODER(Ptp,         SbgEComLogPtp,          76, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS1_VEL]             = SBG_ECOM_LOG_DECODER(GnssVel,     SbgEComLogGnssVel,      44, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS2_VEL]             = SBG_ECOM_LOG_DECODER(GnssVel,     SbgEComLogGnssVel,      44, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS1_POS]             = SBG_ECOM_LOG_DECODER(GnssPos,     SbgEComLogGnssPos,      52, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS2_POS]             = SBG_ECOM_LOG_DECODER(GnssPos,     SbgEComLogGnssPos,      52, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS1_HDT]             = SBG_ECOM_LOG_DECODER(GnssHdt,     SbgEComLogGnssHdt,      26, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS2_HDT]             = SBG_ECOM_LOG_DECODER(GnssHdt,     SbgEComLogGnssHdt,      26, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS1_RAW]             = SBG_ECOM_LOG_DECODER(RawData,     SbgEComLogRawData,      1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_GPS2_RAW]             = SBG_ECOM_LOG_DECODER(RawData,     SbgEComLogRawData,      1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_GPS1_SAT]             = SBG_ECOM_LOG_DECODER(SatList,     SbgEComLogSatList,      9,  SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS2_SAT]             = SBG_ECOM_LOG_DECODER(SatList,     SbgEComLogSatList,      9,  SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_RTCM_RAW]             = SBG_ECOM_LOG_DECODER(RawData,     SbgEComLogRawData,      1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_MAG]                  = SBG_ECOM_LOG_DECODER(Mag,         SbgEComLogMag,          30, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_MAG_CALIB]            = SBG_ECOM_LOG_DECODER(MagCalib,    SbgEComLogMagCalib,     22, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_DVL_BOTTOM_TRACK]     = SBG_ECOM_LOG_DECODER(Dvl,         SbgEComLogDvl,          30, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_DVL_WATER_TRACK]      = SBG_ECOM_LOG_DECODER(Dvl,         SbgEComLogDvl,          30, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_AIR_DATA]             = SBG_ECOM_LOG_DECODER(AirData,     SbgEComLogAirData,      14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_USBL]                 = SBG_ECOM_LOG_DECODER(Usbl,        SbgEComLogUsbl,         38, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_DEPTH]                = SBG_ECOM_LOG_DECODER(Depth,       SbgEComLogDepth,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_A]              = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_B]              = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_C]              = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_D]              = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_E]              = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_OUT_A]          = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_EVENT_OUT_B]          = SBG_ECOM_LOG_DECODER(Event,       SbgEComLogEvent,        14, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_DIAG]                 = SBG_ECOM_LOG_DECODER(Diag,        SbgEComLogDiagData,     6,  6 + SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE),
+    [SBG_ECOM_LOG_SESSION_INFO]         = SBG_ECOM_LOG_DECODER(SessionInfo, SbgEComLogSessionInfo,  6,  6 + sizeof(((SbgEComLogSessionInfo *)NULL)->buffer)),
+};
+
+/*!
+ * Built-in decoders of the SBG_ECOM_CLASS_LOG_ECOM_1 class.
+ */
+static const SbgEComLogDecoder          gLogEcom1Decoders[SBG_ECOM_LOG_DECODER_NR_MSG_IDS] =
+{
+    [SBG_ECOM_LOG_FAST_IMU_DATA]        = SBG_ECOM_LOG_DECODER(ImuFastLegacy, SbgEComLogImuFastLegacy, SBG_ECOM_LOG_IMU_FAST_LEGACY_SIZE, SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+};
+
+/*!
+ * Decoder tables, indexed by message class then message ID.
+ *
+ * A NULL entry means that no log of this class is supported.
+ */
+static const SbgEComLogDecoder         *gLogDecoderTables[SBG_ECOM_LOG_DECODER_NR_CLASSES] =
+{
+    [SBG_ECOM_CLASS_LOG_ECOM_0]         = gLogEcom0Decoders,
+    [SBG_ECOM_CLASS_LOG_ECOM_1]         = gLogEcom1Decoders,
+};
+
+/*!
+ * Decoder tables allocated by the registry, NULL for classes that still use their built-in table.
+ */
+static SbgEComLogDecoder               *gLogCustomDecoderTables[SBG_ECOM_LOG_DECODER_NR_CLASSES];
+
+/*!
+ * Zero-copy view decoders of the SBG_ECOM_CLASS_LOG_ECOM_0 class.
+ */
+static const SbgEComLogDecoder          gLogEcom0ViewDecoders[SBG_ECOM_LOG_DECODER_NR_MSG_IDS] =
+{
+    [SBG_ECOM_LOG_GPS1_RAW]             = SBG_ECOM_LOG_DECODER(RawDataView, SbgEComLogRawDataView,  1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_GPS2_RAW]             = SBG_ECOM_LOG_DECODER(RawDataView, SbgEComLogRawDataView,  1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_RTCM_RAW]             = SBG_ECOM_LOG_DECODER(RawDataView, SbgEComLogRawDataView,  1,  SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE),
+    [SBG_ECOM_LOG_GPS1_SAT]             = SBG_ECOM_LOG_DECODER(SatListView, SbgEComLogSatListView,  9,  SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_GPS2_SAT]             = SBG_ECOM_LOG_DECODER(SatListView, SbgEComLogSatListView,  9,  SBG_ECOM_LOG_DECODER_NO_MAX_SIZE),
+    [SBG_ECOM_LOG_DIAG]                 = SBG_ECOM_LOG_DECODER(DiagView,    SbgEComLogDiagView,     6,  6 + SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE),
+};
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
 
 SbgErrorCode sbgEComLogParse(SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, SbgEComLogUnion *pLogData)
 {
-    SbgErrorCode        errorCode = SBG_NO_ERROR;
-    SbgStreamBuffer     inputStream;
+    return sbgEComLogDecode(msgClass, msgId, pPayload, payloadSize, pLogData, sizeof(*pLogData));
+}
+
+SbgErrorCode sbgEComLogDecode(SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, void *pLogData, size_t logDataSize)
+{
+    return sbgEComLogDecodeWithDecoder(sbgEComLogGetDecoder(msgClass, msgId), msgClass, msgId, pPayload, payloadSize, pLogData, logDataSize);
+}
+
+SbgErrorCode sbgEComLogDecodeWithDecoder(const SbgEComLogDecoder *pDecoder, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, void *pLogData, size_t logDataSize)
+{
+    SbgErrorCode                         errorCode;
+    SbgStreamBuffer                      inputStream;
 
     assert(pPayload);
     assert(payloadSize > 0);
     assert(pLogData);
 
-    //
-    // Create an input stream buffer that points to the frame payload so we can easily parse it's content
-    //
-    sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-    //
-    // Handle the different classes of messages differently
-    //
-    if (msgClass == SBG_ECOM_CLASS_LOG_ECOM_0)
+    if (pDecoder)
     {
         //
-        // Parse the incoming log according to its type
+        // Reject payloads that can't be valid before reading any field
         //
-        switch (msgId)
+        if ((payloadSize < pDecoder->minSize) || (payloadSize > pDecoder->maxSize))
         {
-        case SBG_ECOM_LOG_STATUS:
-            errorCode = sbgEComLogStatusReadFromStream(&pLogData->statusData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_IMU_DATA:
-            errorCode = sbgEComLogImuLegacyReadFromStream(&pLogData->imuData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_IMU_SHORT:
-            errorCode = sbgEComLogImuShortReadFromStream(&pLogData->imuShort, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EKF_EULER:
-            errorCode = sbgEComLogEkfEulerReadFromStream(&pLogData->ekfEulerData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EKF_QUAT:
-            errorCode = sbgEComLogEkfQuatReadFromStream(&pLogData->ekfQuatData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EKF_NAV:
-            errorCode = sbgEComLogEkfNavReadFromStream(&pLogData->ekfNavData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EKF_VEL_BODY:
-            errorCode = sbgEComLogEkfVelBodyReadFromStream(&pLogData->ekfVelBody, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EKF_ROT_ACCEL_BODY:
-        case SBG_ECOM_LOG_EKF_ROT_ACCEL_NED:
-            errorCode = sbgEComLogEkfRotAccelReadFromStream(&pLogData->ekfRotAccel, &inputStream);
-            break;
-        case SBG_ECOM_LOG_SHIP_MOTION:
-        case SBG_ECOM_LOG_SHIP_MOTION_HP:
-            errorCode = sbgEComLogShipMotionReadFromStream(&pLogData->shipMotionData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_ODO_VEL:
-            errorCode = sbgEComLogOdometerReadFromStream(&pLogData->odometerData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_UTC_TIME:
-            errorCode = sbgEComLogUtcReadFromStream(&pLogData->utcData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_PTP_STATUS:
-            errorCode = sbgEComLogPtpReadFromStream(&pLogData->ptpData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_GPS1_VEL:
-        case SBG_ECOM_LOG_GPS2_VEL:
-            errorCode = sbgEComLogGnssVelReadFromStream(&pLogData->gpsVelData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_GPS1_POS:
-        case SBG_ECOM_LOG_GPS2_POS:
-            errorCode = sbgEComLogGnssPosReadFromStream(&pLogData->gpsPosData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_GPS1_HDT:
-        case SBG_ECOM_LOG_GPS2_HDT:
-            errorCode = sbgEComLogGnssHdtReadFromStream(&pLogData->gpsHdtData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_GPS1_RAW:
-        case SBG_ECOM_LOG_GPS2_RAW:
-            errorCode = sbgEComLogRawDataReadFromStream(&pLogData->gpsRawData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_GPS1_SAT:
-        case SBG_ECOM_LOG_GPS2_SAT:
-            errorCode = sbgEComLogSatListReadFromStream(&pLogData->satGroupData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_RTCM_RAW:
-            errorCode = sbgEComLogRawDataReadFromStream(&pLogData->rtcmRawData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_MAG:
-            errorCode = sbgEComLogMagReadFromStream(&pLogData->magData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_MAG_CALIB:
-            errorCode = sbgEComLogMagCalibReadFromStream(&pLogData->magCalibData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_DVL_BOTTOM_TRACK:
-            errorCode = sbgEComLogDvlReadFromStream(&pLogData->dvlData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_DVL_WATER_TRACK:
-            errorCode = sbgEComLogDvlReadFromStream(&pLogData->dvlData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_AIR_DATA:
-            errorCode = sbgEComLogAirDataReadFromStream(&pLogData->airData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_USBL:
-            errorCode = sbgEComLogUsblReadFromStream(&pLogData->usblData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_DEPTH:
-            errorCode = sbgEComLogDepthReadFromStream(&pLogData->depthData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_EVENT_A:
-        case SBG_ECOM_LOG_EVENT_B:
-        case SBG_ECOM_LOG_EVENT_C:
-        case SBG_ECOM_LOG_EVENT_D:
-        case SBG_ECOM_LOG_EVENT_E:
-        case SBG_ECOM_LOG_EVENT_OUT_A:
-        case SBG_ECOM_LOG_EVENT_OUT_B:
-            errorCode = sbgEComLogEventReadFromStream(&pLogData->eventMarker, &inputStream);
-            break;
-        case SBG_ECOM_LOG_DIAG:
-            errorCode = sbgEComLogDiagReadFromStream(&pLogData->diagData, &inputStream);
-            break;
-        case SBG_ECOM_LOG_SESSION_INFO:
-            errorCode = sbgEComLogSessionInfoReadFromStream(&pLogData->sessionInfoData, &inputStream);
-            break;
-
-        default:
-            errorCode = SBG_ERROR;
+            errorCode = SBG_INVALID_FRAME;
+            SBG_LOG_ERROR(errorCode, "invalid payload size %zu for log %#x:%#x", payloadSize, msgClass, msgId);
         }
-    }
-    else if (msgClass == SBG_ECOM_CLASS_LOG_ECOM_1)
-    {
-        //
-        // Parse the message depending on the message ID
-        //
-        switch ((SbgEComLog1)msgId)
+        else if (logDataSize < pDecoder->dataSize)
+        {
+            errorCode = SBG_BUFFER_OVERFLOW;
+            SBG_LOG_ERROR(errorCode, "log data size %zu too small for log %#x:%#x, %zu bytes required", logDataSize, msgClass, msgId, pDecoder->dataSize);
+        }
+        else
         {
-        case SBG_ECOM_LOG_FAST_IMU_DATA:
-            errorCode = sbgEComLogImuFastLegacyReadFromStream(&pLogData->fastImuData, &inputStream);
-            break;
-        default:
-            errorCode = SBG_ERROR;
+            //
+            // Create an input stream buffer that points to the frame payload so we can easily parse it's content
+            //
+            sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+
+            errorCode = pDecoder->pDecodeFunc(pLogData, &inputStream);
         }
     }
     else
     {
         //
-        // Unhandled message class
+        // Unhandled message class or ID
         //
         errorCode = SBG_ERROR;
     }
@@ -184,6 +243,21 @@ SbgErrorCode sbgEComLogParse(SbgEComClass msgClass, SbgEComMsgId msgId, const vo
     return errorCode;
 }
 
+size_t sbgEComLogGetDataSize(SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    const SbgEComLogDecoder             *pDecoder;
+    size_t                               dataSize = 0;
+
+    pDecoder = sbgEComLogGetDecoder(msgClass, msgId);
+
+    if (pDecoder)
+    {
+        dataSize = pDecoder->dataSize;
+    }
+
+    return dataSize;
+}
+
 void sbgEComLogCleanup(SbgEComLogUnion *pLogData, SbgEComClass msgClass, SbgEComMsgId msgId)
 {
     assert(pLogData);
@@ -197,6 +271,117 @@ void sbgEComLogCleanup(SbgEComLogUnion *pLogData, SbgEComClass msgClass, SbgECom
     //
 }
 
+const SbgEComLogDecoder *sbgEComLogGetDecoder(SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    const SbgEComLogDecoder             *pDecoder = NULL;
+
+    if ((size_t)msgClass < SBG_ECOM_LOG_DECODER_NR_CLASSES)
+    {
+        const SbgEComLogDecoder         *pTable;
+
+        pTable = gLogDecoderTables[msgClass];
+
+        if (pTable && pTable[msgId].pDecodeFunc)
+        {
+            pDecoder = &pTable[msgId];
+        }
+    }
+
+    return pDecoder;
+}
+
+SbgErrorCode sbgEComLogRegisterDecoder(SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogDecoder *pDecoder)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComLogDecoder                   *pTable;
+
+    if ((size_t)msgClass >= SBG_ECOM_LOG_DECODER_NR_CLASSES)
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "invalid message class %#x", msgClass);
+    }
+    else if (msgClass == SBG_ECOM_CLASS_LOG_CMD_0)
+    {
+        //
+        // Command frames, and ACKs in particular, must never be handled as logs
+        //
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "decoders can't be registered for command class %#x", msgClass);
+    }
+    else if (pDecoder && (!pDecoder->pDecodeFunc || (pDecoder->minSize > pDecoder->maxSize) || (pDecoder->dataSize > sizeof(SbgEComLogUnion))))
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "invalid decoder for log %#x:%#x", msgClass, msgId);
+    }
+    else
+    {
+        pTable = gLogCustomDecoderTables[msgClass];
+
+        if (!pTable)
+        {
+            //
+            // Create a writable copy of the class table on first registration
+            //
+            pTable = calloc(SBG_ECOM_LOG_DECODER_NR_MSG_IDS, sizeof(*pTable));
+
+            if (pTable)
+            {
+                if (gLogDecoderTables[msgClass])
+                {
+                    memcpy(pTable, gLogDecoderTables[msgClass], SBG_ECOM_LOG_DECODER_NR_MSG_IDS * sizeof(*pTable));
+                }
+
+                gLogCustomDecoderTables[msgClass]   = pTable;
+                gLogDecoderTables[msgClass]         = pTable;
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+                SBG_LOG_ERROR(errorCode, "unable to allocate decoder table");
+            }
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            if (pDecoder)
+            {
+                pTable[msgId] = *pDecoder;
+            }
+            else
+            {
+                memset(&pTable[msgId], 0, sizeof(pTable[msgId]));
+            }
+        }
+    }
+
+    return errorCode;
+}
+
+void sbgEComLogResetDecoders(void)
+{
+    for (size_t i = 0; i < SBG_ECOM_LOG_DECODER_NR_CLASSES; i++)
+    {
+        free(gLogCustomDecoderTables[i]);
+        gLogCustomDecoderTables[i]  = NULL;
+        gLogDecoderTables[i]        = NULL;
+    }
+
+    gLogDecoderTables[SBG_ECOM_CLASS_LOG_ECOM_0]    = gLogEcom0Decoders;
+    gLogDecoderTables[SBG_ECOM_CLASS_LOG_ECOM_1]    = gLogEcom1Decoders;
+}
+
+const SbgEComLogDecoder *sbgEComLogGetViewDecoder(SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    const SbgEComLogDecoder             *pDecoder = NULL;
+
+    if ((msgClass == SBG_ECOM_CLASS_LOG_ECOM_0) && gLogEcom0ViewDecoders[msgId].pDecodeFunc)
+    {
+        pDecoder = &gLogEcom0ViewDecoders[msgId];
+    }
+
+    return pDecoder;
+}
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -78,6 +78,11 @@ extern "C" {
 
 /*!
  *  Union used to store received logs data.
+ *
+ *  Logs passed to the log callbacks are decoded into a buffer as large as the union by default. With
+ *  compact log buffers or an application log buffer, see sbgEComSetCompactLogBuffer() and
+ *  sbgEComSetLogBuffer(), the buffer is only sized for the member of the received log. Only that member
+ *  may then be accessed: the union must never be copied as a whole. Copy the member instead.
  */
 typedef union _SbgEComLogUnion
 {
@@ -109,11 +114,43 @@ typedef union _SbgEComLogUnion
     SbgEComLogSatList               satGroupData;       /*!< Stores data for the SBG_ECOM_LOG_SAT message. */
     SbgEComLogSessionInfo           sessionInfoData;    /*!< Stores data for the SBG_ECOM_LOG_SESSION_INFO message. */
 
+    /* Zero-copy views, see sbgEComSetLogViews() */
+    SbgEComLogRawDataView           rawDataView;        /*!< Stores a view on the SBG_ECOM_LOG_GPS#_RAW or SBG_ECOM_LOG_RTCM_RAW message. */
+    SbgEComLogSatListView           satListView;        /*!< Stores a view on the SBG_ECOM_LOG_GPS#_SAT message. */
+    SbgEComLogDiagView              diagView;           /*!< Stores a view on the SBG_ECOM_LOG_DIAG message. */
+
     /* Fast logs */
     SbgEComLogImuFastLegacy         fastImuData;        /*!< Stores Fast IMU Data for 1KHz output */
 
 } SbgEComLogUnion;
 
+#define SBG_ECOM_LOG_DECODER_NR_CLASSES         (128)               /*!< Number of message classes that can be addressed by the decoder registry. */
+#define SBG_ECOM_LOG_DECODER_NR_MSG_IDS         (256)               /*!< Number of message IDs per class in the decoder registry. */
+#define SBG_ECOM_LOG_DECODER_NO_MAX_SIZE        (SIZE_MAX)          /*!< Maximum payload size for logs that accept trailing fields added by newer firmware. */
+
+/*!
+ * Function that decodes a log payload.
+ *
+ * The decoder is only called once the payload size has been validated against the decoder
+ * minimum and maximum sizes, so that fixed size fields can be read without any further check.
+ *
+ * \param[out]  pLogData                    Log data to fill, points to a SbgEComLogUnion or any user structure that fits in it.
+ * \param[in]   pStreamBuffer               Input stream buffer initialized on the log payload.
+ * \return                                  SBG_NO_ERROR if the log has been decoded successfully.
+ */
+typedef SbgErrorCode (*SbgEComLogDecodeFunc)(void *pLogData, SbgStreamBuffer *pStreamBuffer);
+
+/*!
+ * Log decoder descriptor.
+ */
+typedef struct _SbgEComLogDecoder
+{
+    SbgEComLogDecodeFunc             pDecodeFunc;       /*!< Decode function. */
+    size_t                           minSize;           /*!< Minimum payload size, in bytes. */
+    size_t                           maxSize;           /*!< Maximum payload size, in bytes. */
+    size_t                           dataSize;          /*!< Size, in bytes, of the decoded log structure. */
+} SbgEComLogDecoder;
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
@@ -129,6 +166,48 @@ typedef union _SbgEComLogUnion
  */
 SbgErrorCode sbgEComLogParse(SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, SbgEComLogUnion *pLogData);
 
+/*!
+ * Parse an incoming log into a caller provided structure.
+ *
+ * Unlike sbgEComLogParse(), the output storage only needs to be as large as the structure of
+ * the received log, see sbgEComLogGetDataSize(). It can be a typed structure, for example a
+ * SbgEComLogImuShort for SBG_ECOM_LOG_IMU_SHORT, or any buffer suitably aligned for it.
+ *
+ * \param[in]   msgClass                    Received message class
+ * \param[in]   msgId                       Received message ID
+ * \param[in]   pPayload                    Read only pointer on the payload buffer.
+ * \param[in]   payloadSize                 Payload size in bytes.
+ * \param[out]  pLogData                    Output log structure.
+ * \param[in]   logDataSize                 Size of the output log structure, in bytes.
+ * \return                                  SBG_NO_ERROR if the log has been decoded,
+ *                                          SBG_BUFFER_OVERFLOW if the output structure is too small.
+ */
+SbgErrorCode sbgEComLogDecode(SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, void *pLogData, size_t logDataSize);
+
+/*!
+ * Parse an incoming log with the given decoder.
+ *
+ * \param[in]   pDecoder                    Log decoder, NULL if the log isn't supported.
+ * \param[in]   msgClass                    Received message class
+ * \param[in]   msgId                       Received message ID
+ * \param[in]   pPayload                    Read only pointer on the payload buffer.
+ * \param[in]   payloadSize                 Payload size in bytes.
+ * \param[out]  pLogData                    Output log structure.
+ * \param[in]   logDataSize                 Size of the output log structure, in bytes.
+ * \return                                  SBG_NO_ERROR if the log has been decoded,
+ *                                          SBG_BUFFER_OVERFLOW if the output structure is too small.
+ */
+SbgErrorCode sbgEComLogDecodeWithDecoder(const SbgEComLogDecoder *pDecoder, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize, void *pLogData, size_t logDataSize);
+
+/*!
+ * Get the size of the structure a log is decoded into.
+ *
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \return                                  Size of the decoded log structure, in bytes, 0 if the log isn't supported.
+ */
+size_t sbgEComLogGetDataSize(SbgEComClass msgClass, SbgEComMsgId msgId);
+
 /*!
  * Clean up resources allocated during parsing, if any.
  *
@@ -138,6 +217,50 @@ SbgErrorCode sbgEComLogParse(SbgEComClass msgClass, SbgEComMsgId msgId, const vo
  */
 void sbgEComLogCleanup(SbgEComLogUnion *pLogData, SbgEComClass msgClass, SbgEComMsgId msgId);
 
+/*!
+ * Get the decoder of a log.
+ *
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \return                                  Log decoder, NULL if the log isn't supported.
+ */
+const SbgEComLogDecoder *sbgEComLogGetDecoder(SbgEComClass msgClass, SbgEComMsgId msgId);
+
+/*!
+ * Register a log decoder.
+ *
+ * Used to decode proprietary or third party logs, or to override a built-in decoder.
+ * The decoded structure must fit in a SbgEComLogUnion.
+ * Decoders can't be registered for the command class, SBG_ECOM_CLASS_LOG_CMD_0.
+ *
+ * The decoder registry isn't thread safe, and is shared by all the handles: decoders must be
+ * registered before any handle receives frames, and before any reader thread is started.
+ *
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pDecoder                    Log decoder, NULL to unregister the log.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SbgErrorCode sbgEComLogRegisterDecoder(SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogDecoder *pDecoder);
+
+/*!
+ * Get the zero-copy view decoder of a variable size log.
+ *
+ * View decoders decode raw data, satellite list and diagnostic logs into the rawDataView, satListView
+ * and diagView members of the log union, instead of gpsRawData/rtcmRawData, satGroupData and diagData.
+ * They are only used by the handles they are enabled on, see sbgEComSetLogViews().
+ *
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \return                                  View decoder, NULL if the log has no view.
+ */
+const SbgEComLogDecoder *sbgEComLogGetViewDecoder(SbgEComClass msgClass, SbgEComMsgId msgId);
+
+/*!
+ * Restore the built-in log decoders and release the resources allocated by the registry.
+ */
+void sbgEComLogResetDecoders(void);
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
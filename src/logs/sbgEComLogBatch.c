@@ -0,0 +1,557 @@
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// Project headers
+#include <protocol/sbgEComProtocol.h>
+
+// Local headers
+#include "sbgEComLogBatch.h"
+#include "sbgEComLogEkf.h"
+#include "sbgEComLogImu.h"
+
+//----------------------------------------------------------------------//
+//- Private constant definitions                                       -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_LOG_BATCH_NR_FRAMES                        (64)            /*!< Number of frames received at once from the protocol. */
+
+//----------------------------------------------------------------------//
+//- Private structure definitions                                      -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Column descriptor, used to grow all the columns of a table at once.
+ */
+typedef struct _SbgEComLogBatchColumn
+{
+    void                               **ppValues;                  /*!< Column values. */
+    size_t                               valueSize;                 /*!< Size of a value, in bytes. */
+} SbgEComLogBatchColumn;
+
+/*!
+ * Buffer read through an interface.
+ */
+typedef struct _SbgEComLogBatchBuffer
+{
+    const uint8_t                       *pBuffer;                   /*!< Buffer. */
+    size_t                               size;                      /*!< Buffer size, in bytes. */
+    size_t                               offset;                    /*!< Offset of the next byte to read. */
+} SbgEComLogBatchBuffer;
+
+//----------------------------------------------------------------------//
+//- Private functions                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Grow the columns of a table.
+ *
+ * The capacity is doubled to keep the number of reallocations logarithmic with the capture size.
+ *
+ * \param[in]   pColumns                    Column descriptors.
+ * \param[in]   nrColumns                   Number of columns.
+ * \param[in]   pCapacity                   Table capacity, in records.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchGrowColumns(const SbgEComLogBatchColumn *pColumns, size_t nrColumns, size_t *pCapacity)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    size_t                               capacity;
+
+    assert(pColumns);
+    assert(pCapacity);
+
+    capacity = sbgMax(*pCapacity * 2, SBG_ECOM_LOG_BATCH_MIN_CAPACITY);
+
+    for (size_t i = 0; i < nrColumns; i++)
+    {
+        void                            *pValues;
+
+        pValues = realloc(*pColumns[i].ppValues, capacity * pColumns[i].valueSize);
+
+        if (!pValues)
+        {
+            errorCode = SBG_MALLOC_FAILED;
+            SBG_LOG_ERROR(errorCode, "unable to grow column to %zu records", capacity);
+            break;
+        }
+
+        *pColumns[i].ppValues = pValues;
+    }
+
+    //
+    // Columns already grown keep their larger allocation, the capacity only reflects complete tables
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        *pCapacity = capacity;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Reserve a record in the IMU table.
+ *
+ * \param[in]   pColumns                    IMU table.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchImuReserve(SbgEComLogImuColumns *pColumns)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+
+    assert(pColumns);
+
+    if (pColumns->nrRecords == pColumns->capacity)
+    {
+        const SbgEComLogBatchColumn      columns[] =
+        {
+            { (void **)&pColumns->pTimeStamps,          sizeof(*pColumns->pTimeStamps)          },
+            { (void **)&pColumns->pStatus,              sizeof(*pColumns->pStatus)              },
+            { (void **)&pColumns->pAccelerometers[0],   sizeof(*pColumns->pAccelerometers[0])   },
+            { (void **)&pColumns->pAccelerometers[1],   sizeof(*pColumns->pAccelerometers[1])   },
+            { (void **)&pColumns->pAccelerometers[2],   sizeof(*pColumns->pAccelerometers[2])   },
+            { (void **)&pColumns->pGyroscopes[0],       sizeof(*pColumns->pGyroscopes[0])       },
+            { (void **)&pColumns->pGyroscopes[1],       sizeof(*pColumns->pGyroscopes[1])       },
+            { (void **)&pColumns->pGyroscopes[2],       sizeof(*pColumns->pGyroscopes[2])       },
+            { (void **)&pColumns->pTemperatures,        sizeof(*pColumns->pTemperatures)        },
+        };
+
+        errorCode = sbgEComLogBatchGrowColumns(columns, SBG_ARRAY_SIZE(columns), &pColumns->capacity);
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Reserve a record in the EKF navigation table.
+ *
+ * \param[in]   pColumns                    EKF navigation table.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchEkfNavReserve(SbgEComLogEkfNavColumns *pColumns)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+
+    assert(pColumns);
+
+    if (pColumns->nrRecords == pColumns->capacity)
+    {
+        const SbgEComLogBatchColumn      columns[] =
+        {
+            { (void **)&pColumns->pTimeStamps,          sizeof(*pColumns->pTimeStamps)          },
+            { (void **)&pColumns->pVelocities[0],       sizeof(*pColumns->pVelocities[0])       },
+            { (void **)&pColumns->pVelocities[1],       sizeof(*pColumns->pVelocities[1])       },
+            { (void **)&pColumns->pVelocities[2],       sizeof(*pColumns->pVelocities[2])       },
+            { (void **)&pColumns->pVelocityStdDevs[0],  sizeof(*pColumns->pVelocityStdDevs[0])  },
+            { (void **)&pColumns->pVelocityStdDevs[1],  sizeof(*pColumns->pVelocityStdDevs[1])  },
+            { (void **)&pColumns->pVelocityStdDevs[2],  sizeof(*pColumns->pVelocityStdDevs[2])  },
+            { (void **)&pColumns->pPositions[0],        sizeof(*pColumns->pPositions[0])        },
+            { (void **)&pColumns->pPositions[1],        sizeof(*pColumns->pPositions[1])        },
+            { (void **)&pColumns->pPositions[2],        sizeof(*pColumns->pPositions[2])        },
+            { (void **)&pColumns->pUndulations,         sizeof(*pColumns->pUndulations)         },
+            { (void **)&pColumns->pPositionStdDevs[0],  sizeof(*pColumns->pPositionStdDevs[0])  },
+            { (void **)&pColumns->pPositionStdDevs[1],  sizeof(*pColumns->pPositionStdDevs[1])  },
+            { (void **)&pColumns->pPositionStdDevs[2],  sizeof(*pColumns->pPositionStdDevs[2])  },
+            { (void **)&pColumns->pStatus,              sizeof(*pColumns->pStatus)              },
+        };
+
+        errorCode = sbgEComLogBatchGrowColumns(columns, SBG_ARRAY_SIZE(columns), &pColumns->capacity);
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Add an IMU data log to the IMU table.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   pStreamBuffer               Stream buffer on the log payload.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchAddImuLegacy(SbgEComLogBatch *pBatch, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode                         errorCode;
+    SbgEComLogImuLegacy                  imuLegacy;
+
+    assert(pBatch);
+    assert(pStreamBuffer);
+
+    errorCode = sbgEComLogImuLegacyReadFromStream(&imuLegacy, pStreamBuffer);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        //
+        // Pending IMU short records must be converted first as they must be contiguous
+        //
+        sbgEComLogBatchFlush(pBatch);
+
+        errorCode = sbgEComLogBatchImuReserve(&pBatch->imu);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComLogImuColumns        *pColumns = &pBatch->imu;
+            size_t                       index = pColumns->nrRecords;
+
+            pColumns->pTimeStamps[index]    = imuLegacy.timeStamp;
+            pColumns->pStatus[index]        = imuLegacy.status;
+            pColumns->pTemperatures[index]  = imuLegacy.temperature;
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pColumns->pAccelerometers[i][index] = imuLegacy.accelerometers[i];
+                pColumns->pGyroscopes[i][index]     = imuLegacy.gyroscopes[i];
+            }
+
+            pColumns->nrRecords++;
+        }
+    }
+    else
+    {
+        pBatch->nrInvalidFrames++;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Add an IMU short log to the IMU table.
+ *
+ * The time stamp and status are stored immediately, while the other fields are kept raw until
+ * a block of records is converted at once.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   pStreamBuffer               Stream buffer on the log payload.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchAddImuShort(SbgEComLogBatch *pBatch, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pBatch);
+    assert(pStreamBuffer);
+
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_IMU_SHORT_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComLogBatchImuReserve(&pBatch->imu);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComLogImuColumns        *pColumns = &pBatch->imu;
+            size_t                       index = pBatch->nrImuShorts;
+
+            if (index == 0)
+            {
+                pBatch->imuShortFirst = pColumns->nrRecords;
+            }
+
+            pColumns->pTimeStamps[pColumns->nrRecords]  = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+            pColumns->pStatus[pColumns->nrRecords]      = sbgStreamBufferReadUint16LEUnchecked(pStreamBuffer);
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pBatch->imuShortDeltaVelocities[i][index]   = sbgStreamBufferReadInt32LEUnchecked(pStreamBuffer);
+            }
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pBatch->imuShortDeltaAngles[i][index]       = sbgStreamBufferReadInt32LEUnchecked(pStreamBuffer);
+            }
+
+            pBatch->imuShortTemperatures[index]             = sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer);
+
+            pColumns->nrRecords++;
+            pBatch->nrImuShorts++;
+
+            if (pBatch->nrImuShorts == SBG_ECOM_LOG_BATCH_BLOCK_SIZE)
+            {
+                sbgEComLogBatchFlush(pBatch);
+            }
+        }
+    }
+    else
+    {
+        pBatch->nrInvalidFrames++;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Add an EKF navigation log to the EKF navigation table.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   pStreamBuffer               Stream buffer on the log payload.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComLogBatchAddEkfNav(SbgEComLogBatch *pBatch, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pBatch);
+    assert(pStreamBuffer);
+
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_NAV_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComLogBatchEkfNavReserve(&pBatch->ekfNav);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComLogEkfNavColumns     *pColumns = &pBatch->ekfNav;
+            size_t                       index = pColumns->nrRecords;
+
+            pColumns->pTimeStamps[index]            = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pColumns->pVelocities[i][index]         = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+            }
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pColumns->pVelocityStdDevs[i][index]    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+            }
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pColumns->pPositions[i][index]          = sbgStreamBufferReadDoubleLEUnchecked(pStreamBuffer);
+            }
+
+            pColumns->pUndulations[index]           = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pColumns->pPositionStdDevs[i][index]    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+            }
+
+            pColumns->pStatus[index]                = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+
+            pColumns->nrRecords++;
+        }
+    }
+    else
+    {
+        pBatch->nrInvalidFrames++;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Read data from a buffer interface.
+ *
+ * \param[in]   pInterface                  Interface.
+ * \param[out]  pBuffer                     Output buffer.
+ * \param[out]  pReadBytes                  Number of bytes read.
+ * \param[in]   bytesToRead                 Maximum number of bytes to read.
+ * \return                                  SBG_NO_ERROR, even once the whole buffer has been read.
+ */
+static SbgErrorCode sbgEComLogBatchBufferRead(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead)
+{
+    SbgEComLogBatchBuffer               *pBatchBuffer;
+    size_t                               size;
+
+    assert(pInterface);
+    assert(pBuffer);
+    assert(pReadBytes);
+
+    pBatchBuffer = pInterface->handle;
+
+    size = sbgMin(bytesToRead, pBatchBuffer->size - pBatchBuffer->offset);
+
+    memcpy(pBuffer, &pBatchBuffer->pBuffer[pBatchBuffer->offset], size);
+    pBatchBuffer->offset += size;
+
+    *pReadBytes = size;
+
+    return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+void sbgEComLogBatchConstruct(SbgEComLogBatch *pBatch)
+{
+    assert(pBatch);
+
+    memset(pBatch, 0, sizeof(*pBatch));
+}
+
+void sbgEComLogBatchDestroy(SbgEComLogBatch *pBatch)
+{
+    assert(pBatch);
+
+    free(pBatch->imu.pTimeStamps);
+    free(pBatch->imu.pStatus);
+    free(pBatch->imu.pTemperatures);
+
+    free(pBatch->ekfNav.pTimeStamps);
+    free(pBatch->ekfNav.pUndulations);
+    free(pBatch->ekfNav.pStatus);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        free(pBatch->imu.pAccelerometers[i]);
+        free(pBatch->imu.pGyroscopes[i]);
+
+        free(pBatch->ekfNav.pVelocities[i]);
+        free(pBatch->ekfNav.pVelocityStdDevs[i]);
+        free(pBatch->ekfNav.pPositions[i]);
+        free(pBatch->ekfNav.pPositionStdDevs[i]);
+    }
+
+    sbgEComLogBatchConstruct(pBatch);
+}
+
+SbgErrorCode sbgEComLogBatchAddLog(SbgEComLogBatch *pBatch, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgStreamBuffer                      streamBuffer;
+
+    assert(pBatch);
+    assert(pPayload || (payloadSize == 0));
+
+    sbgStreamBufferInitForRead(&streamBuffer, pPayload, payloadSize);
+
+    pBatch->nrFrames++;
+
+    if (msgClass == SBG_ECOM_CLASS_LOG_ECOM_0)
+    {
+        switch (msgId)
+        {
+        case SBG_ECOM_LOG_IMU_DATA:
+            errorCode = sbgEComLogBatchAddImuLegacy(pBatch, &streamBuffer);
+            break;
+        case SBG_ECOM_LOG_IMU_SHORT:
+            errorCode = sbgEComLogBatchAddImuShort(pBatch, &streamBuffer);
+            break;
+        case SBG_ECOM_LOG_EKF_NAV:
+            errorCode = sbgEComLogBatchAddEkfNav(pBatch, &streamBuffer);
+            break;
+        default:
+            pBatch->nrIgnoredFrames++;
+        }
+    }
+    else
+    {
+        pBatch->nrIgnoredFrames++;
+    }
+
+    //
+    // Invalid logs are only counted, they don't stop the decoding of a capture
+    //
+    if (errorCode != SBG_MALLOC_FAILED)
+    {
+        errorCode = SBG_NO_ERROR;
+    }
+
+    return errorCode;
+}
+
+void sbgEComLogBatchFlush(SbgEComLogBatch *pBatch)
+{
+    SbgEComLogImuColumns                *pColumns;
+    size_t                               first;
+    size_t                               nrImuShorts;
+
+    assert(pBatch);
+
+    pColumns    = &pBatch->imu;
+    first       = pBatch->imuShortFirst;
+    nrImuShorts = pBatch->nrImuShorts;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        sbgEComLogImuShortConvertDeltaVelocities(pBatch->imuShortDeltaVelocities[i], nrImuShorts, &pColumns->pAccelerometers[i][first]);
+        sbgEComLogImuShortConvertDeltaAngles(pBatch->imuShortDeltaAngles[i], &pColumns->pStatus[first], nrImuShorts, &pColumns->pGyroscopes[i][first]);
+    }
+
+    sbgEComLogImuShortConvertTemperatures(pBatch->imuShortTemperatures, nrImuShorts, &pColumns->pTemperatures[first]);
+
+    pBatch->nrImuShorts = 0;
+}
+
+SbgErrorCode sbgEComLogBatchDecodeInterface(SbgEComLogBatch *pBatch, SbgInterface *pInterface)
+{
+    SbgErrorCode                         errorCode;
+    SbgEComProtocol                      protocol;
+
+    assert(pBatch);
+    assert(pInterface);
+
+    errorCode = sbgEComProtocolInitWithRxBuffer(&protocol, pInterface, NULL, SBG_ECOM_LOG_BATCH_RX_BUFFER_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        SbgEComProtocolFrameDescriptor   frames[SBG_ECOM_LOG_BATCH_NR_FRAMES];
+
+        //
+        // Read frames until the interface is exhausted, a receive attempt may return no frame
+        // while bytes are still read, for example if the reception buffer only contains garbage
+        //
+        do
+        {
+            size_t                       nrFrames;
+            uint64_t                     nrBytesRead;
+
+            nrBytesRead = protocol.stats.nrBytesRead;
+
+            errorCode = sbgEComProtocolReceiveBatch(&protocol, frames, SBG_ARRAY_SIZE(frames), &nrFrames);
+
+            if ((errorCode == SBG_NOT_READY) && (protocol.stats.nrBytesRead != nrBytesRead))
+            {
+                errorCode = SBG_NO_ERROR;
+            }
+
+            for (size_t i = 0; i < nrFrames; i++)
+            {
+                SbgErrorCode             addErrorCode;
+
+                addErrorCode = sbgEComLogBatchAddLog(pBatch, (SbgEComClass)frames[i].msgClass, (SbgEComMsgId)frames[i].msgId, frames[i].pPayload, frames[i].payloadSize);
+
+                if (addErrorCode != SBG_NO_ERROR)
+                {
+                    errorCode = addErrorCode;
+                    break;
+                }
+            }
+        } while (errorCode == SBG_NO_ERROR);
+
+        if (errorCode == SBG_NOT_READY)
+        {
+            errorCode = SBG_NO_ERROR;
+        }
+
+        sbgEComLogBatchFlush(pBatch);
+
+        sbgEComProtocolClose(&protocol);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComLogBatchDecodeBuffer(SbgEComLogBatch *pBatch, const void *pBuffer, size_t size)
+{
+    SbgEComLogBatchBuffer                batchBuffer;
+    SbgInterface                         interface;
+
+    assert(pBatch);
+    assert(pBuffer || (size == 0));
+
+    batchBuffer.pBuffer     = pBuffer;
+    batchBuffer.size        = size;
+    batchBuffer.offset      = 0;
+
+    sbgInterfaceZeroInit(&interface);
+
+    interface.handle        = &batchBuffer;
+    interface.pReadFunc     = sbgEComLogBatchBufferRead;
+
+    return sbgEComLogBatchDecodeInterface(pBatch, &interface);
+}
@@ -0,0 +1,185 @@
+/*!
+ * \file            sbgEComLogBatch.h
+ * \ingroup         binaryLogs
+ * \author          SBG Systems
+ * \date            16 October 2026
+ *
+ * \brief           Decode whole captures of logs into columns, for offline analysis.
+ *
+ * Each supported log type is decoded into a table that stores one array per field (structure of
+ * arrays), ready to be processed with vectorized code or handed to analysis tools without copy.
+ *
+ * Supported logs:
+ *  - SBG_ECOM_LOG_IMU_DATA and SBG_ECOM_LOG_IMU_SHORT, into the IMU table.
+ *  - SBG_ECOM_LOG_EKF_NAV, into the EKF navigation table.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+#ifndef SBG_ECOM_LOG_BATCH_H
+#define SBG_ECOM_LOG_BATCH_H
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+
+// Project headers
+#include <sbgEComIds.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_LOG_BATCH_BLOCK_SIZE           (256)               /*!< Number of IMU short records converted at once. */
+#define SBG_ECOM_LOG_BATCH_MIN_CAPACITY         (4096)              /*!< Initial number of records of a table. */
+#define SBG_ECOM_LOG_BATCH_RX_BUFFER_SIZE       (64 * 1024)         /*!< Size of the reception buffer used to decode captures, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * IMU table, filled with SBG_ECOM_LOG_IMU_DATA and SBG_ECOM_LOG_IMU_SHORT logs.
+ *
+ * IMU short delta angles and velocities are converted in rad.s^-1 and m.s^-2, like the IMU data log.
+ */
+typedef struct _SbgEComLogImuColumns
+{
+    size_t                               nrRecords;                 /*!< Number of records. */
+    size_t                               capacity;                  /*!< Number of records that can be stored without growing the columns. */
+
+    uint32_t                            *pTimeStamps;               /*!< Time in us since the sensor power up. */
+    uint16_t                            *pStatus;                   /*!< IMU status bitmask. */
+    float                               *pAccelerometers[3];        /*!< X, Y, Z accelerometer readings in m.s^-2. */
+    float                               *pGyroscopes[3];            /*!< X, Y, Z gyroscope readings in rad.s^-1. */
+    float                               *pTemperatures;             /*!< Internal temperature in °C. */
+} SbgEComLogImuColumns;
+
+/*!
+ * EKF navigation table, filled with SBG_ECOM_LOG_EKF_NAV logs.
+ */
+typedef struct _SbgEComLogEkfNavColumns
+{
+    size_t                               nrRecords;                 /*!< Number of records. */
+    size_t                               capacity;                  /*!< Number of records that can be stored without growing the columns. */
+
+    uint32_t                            *pTimeStamps;               /*!< Time in us since the sensor power up. */
+    float                               *pVelocities[3];            /*!< North, East, Down velocity in m.s^-1. */
+    float                               *pVelocityStdDevs[3];       /*!< North, East, Down velocity 1 sigma standard deviation in m.s^-1. */
+    double                              *pPositions[3];             /*!< Latitude, Longitude in degrees positive North and East, Altitude above Mean Sea Level in meters. */
+    float                               *pUndulations;              /*!< Altitude difference between the geoid and the Ellipsoid in meters (Height above Ellipsoid = altitude + undulation). */
+    float                               *pPositionStdDevs[3];       /*!< Latitude, longitude and altitude 1 sigma standard deviation in meters. */
+    uint32_t                            *pStatus;                   /*!< EKF solution status bitmask and enum. */
+} SbgEComLogEkfNavColumns;
+
+/*!
+ * Batch decoder.
+ *
+ * Columns are only valid after sbgEComLogBatchFlush(), which is called by the capture decoding methods.
+ */
+typedef struct _SbgEComLogBatch
+{
+    SbgEComLogImuColumns                 imu;                                                   /*!< IMU table. */
+    SbgEComLogEkfNavColumns              ekfNav;                                                /*!< EKF navigation table. */
+
+    size_t                               nrFrames;                                              /*!< Number of frames decoded. */
+    size_t                               nrIgnoredFrames;                                       /*!< Number of frames ignored as they aren't supported. */
+    size_t                               nrInvalidFrames;                                       /*!< Number of supported frames ignored as they are invalid. */
+
+    size_t                               imuShortFirst;                                         /*!< Index, in the IMU table, of the first pending IMU short record. */
+    size_t                               nrImuShorts;                                           /*!< Number of pending IMU short records. */
+    int32_t                              imuShortDeltaVelocities[3][SBG_ECOM_LOG_BATCH_BLOCK_SIZE];    /*!< Raw delta velocities of the pending IMU short records. */
+    int32_t                              imuShortDeltaAngles[3][SBG_ECOM_LOG_BATCH_BLOCK_SIZE];        /*!< Raw delta angles of the pending IMU short records. */
+    int16_t                              imuShortTemperatures[SBG_ECOM_LOG_BATCH_BLOCK_SIZE];          /*!< Raw temperatures of the pending IMU short records. */
+} SbgEComLogBatch;
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Batch decoder constructor.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ */
+void sbgEComLogBatchConstruct(SbgEComLogBatch *pBatch);
+
+/*!
+ * Batch decoder destructor, release all columns.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ */
+void sbgEComLogBatchDestroy(SbgEComLogBatch *pBatch);
+
+/*!
+ * Add a log to the batch.
+ *
+ * Unsupported logs are counted and ignored.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pPayload                    Payload buffer.
+ * \param[in]   payloadSize                 Payload size, in bytes.
+ * \return                                  SBG_NO_ERROR if successful, SBG_MALLOC_FAILED if a table can't grow.
+ */
+SbgErrorCode sbgEComLogBatchAddLog(SbgEComLogBatch *pBatch, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize);
+
+/*!
+ * Complete the conversion of the pending records.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ */
+void sbgEComLogBatchFlush(SbgEComLogBatch *pBatch);
+
+/*!
+ * Decode all the frames that can be read from an interface, typically a file.
+ *
+ * Frames are read until the interface doesn't provide any more data.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   pInterface                  Interface to read the frames from.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SbgErrorCode sbgEComLogBatchDecodeInterface(SbgEComLogBatch *pBatch, SbgInterface *pInterface);
+
+/*!
+ * Decode all the frames of a buffer.
+ *
+ * \param[in]   pBatch                      Batch decoder.
+ * \param[in]   pBuffer                     Buffer of frames.
+ * \param[in]   size                        Buffer size, in bytes.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SbgErrorCode sbgEComLogBatchDecodeBuffer(SbgEComLogBatch *pBatch, const void *pBuffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SBG_ECOM_LOG_BATCH_H
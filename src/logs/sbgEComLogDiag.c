@@ -48,6 +48,43 @@ SbgErrorCode sbgEComLogDiagWriteToStream(const SbgEComLogDiagData *pLogData, Sbg
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
 
+SbgErrorCode sbgEComLogDiagViewReadFromStream(SbgEComLogDiagView *pView, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pView);
+    assert(pStreamBuffer);
+
+    pView->timestamp        = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    pView->type             = (SbgDebugLogType)sbgStreamBufferReadUint8(pStreamBuffer);
+    pView->errorCode        = (SbgErrorCode)sbgStreamBufferReadUint8(pStreamBuffer);
+
+    errorCode = sbgStreamBufferGetLastError(pStreamBuffer);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        const char                      *pEnd;
+        size_t                           size;
+
+        size                = sbgStreamBufferGetSpace(pStreamBuffer);
+        pView->pString      = sbgStreamBufferGetCursor(pStreamBuffer);
+        pEnd                = memchr(pView->pString, '\0', size);
+
+        if (pEnd)
+        {
+            pView->stringLength = (size_t)(pEnd - pView->pString);
+        }
+        else
+        {
+            pView->stringLength = size;
+        }
+
+        errorCode = sbgStreamBufferSeek(pStreamBuffer, size, SB_SEEK_CUR_INC);
+    }
+
+    return errorCode;
+}
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
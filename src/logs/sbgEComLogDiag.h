@@ -68,6 +68,21 @@ typedef struct _SbgEComLogDiagData
     char                                 string[SBG_ECOM_LOG_DIAG_MAX_STRING_SIZE]; /*!< Log string, null-terminated. */
 } SbgEComLogDiagData;
 
+/*!
+ * Read only view on a diagnostic log.
+ *
+ * The string refers to the received payload, no data is copied. It is only valid as long as the payload
+ * is, which is until the log callback returns for logs received through sbgECom.
+ */
+typedef struct _SbgEComLogDiagView
+{
+    uint32_t                             timestamp;                                 /*!< Timestamp, in microseconds. */
+    SbgDebugLogType                      type;                                      /*!< Log type. */
+    SbgErrorCode                         errorCode;                                 /*!< Error code. */
+    const char                          *pString;                                   /*!< Log string, not null-terminated. */
+    size_t                               stringLength;                              /*!< Log string length, in bytes. */
+} SbgEComLogDiagView;
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
@@ -90,6 +105,17 @@ SbgErrorCode sbgEComLogDiagReadFromStream(SbgEComLogDiagData *pLogData, SbgStrea
  */
 SbgErrorCode sbgEComLogDiagWriteToStream(const SbgEComLogDiagData *pLogData, SbgStreamBuffer *pStreamBuffer);
 
+/*!
+ * Initialize a view on a SBG_ECOM_LOG_DIAG message.
+ *
+ * The string ends at the first null character, or at the end of the payload.
+ *
+ * \param[out]  pView                       Diagnostic log view.
+ * \param[in]   pStreamBuffer               Input stream buffer to read the log from.
+ * \return                                  SBG_NO_ERROR if a valid log has been read from the stream buffer.
+ */
+SbgErrorCode sbgEComLogDiagViewReadFromStream(SbgEComLogDiagView *pView, SbgStreamBuffer *pStreamBuffer);
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
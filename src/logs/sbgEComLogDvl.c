@@ -12,13 +12,9 @@ SbgErrorCode sbgEComLogDvlReadFromStream(SbgEComLogDvl *pLogData, SbgStreamBuffe
     pLogData->timeStamp             = sbgStreamBufferReadUint32LE(pStreamBuffer);
     pLogData->status                = sbgStreamBufferReadUint16LE(pStreamBuffer);
 
-    pLogData->velocity[0]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[1]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[2]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
 
-    pLogData->velocityQuality[0]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityQuality[1]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityQuality[2]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->velocityQuality, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -31,13 +27,9 @@ SbgErrorCode sbgEComLogDvlWriteToStream(const SbgEComLogDvl *pLogData, SbgStream
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint16LE(pStreamBuffer, pLogData->status);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityQuality[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityQuality[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityQuality[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocityQuality, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -43,36 +43,39 @@ float sbgEComLogEkfEulerGetMagneticHeading(const SbgEComLogEkfEuler *pEkfEuler)
 
 SbgErrorCode sbgEComLogEkfEulerReadFromStream(SbgEComLogEkfEuler *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_EULER_MIN_SIZE);
 
-    pLogData->euler[0]          = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->euler[1]          = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->euler[2]          = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp         = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
 
-    pLogData->eulerStdDev[0]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->eulerStdDev[1]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->eulerStdDev[2]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->euler, 3);
 
-    pLogData->status            = sbgStreamBufferReadUint32LE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->eulerStdDev, 3);
 
-    //
-    // Added in sbgECom 5.0
-    //
-    if (sbgStreamBufferGetSpace(pStreamBuffer) >= 2*sizeof(float))
-    {
-        pLogData->magDeclination    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-        pLogData->magInclination    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    }
-    else
-    {
-        pLogData->magDeclination        = NAN;
-        pLogData->magInclination        = NAN;
+        pLogData->status            = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+
+        //
+        // Added in sbgECom 5.0
+        //
+        if (sbgStreamBufferGetSpace(pStreamBuffer) >= 2*sizeof(float))
+        {
+            pLogData->magDeclination    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+            pLogData->magInclination    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+        }
+        else
+        {
+            pLogData->magDeclination    = NAN;
+            pLogData->magInclination    = NAN;
+        }
     }
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogEkfEulerWriteToStream(const SbgEComLogEkfEuler *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -82,13 +85,9 @@ SbgErrorCode sbgEComLogEkfEulerWriteToStream(const SbgEComLogEkfEuler *pLogData,
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->euler[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->euler[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->euler[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->euler, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->eulerStdDev, 3);
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
 
@@ -107,37 +106,39 @@ SbgErrorCode sbgEComLogEkfEulerWriteToStream(const SbgEComLogEkfEuler *pLogData,
 
 SbgErrorCode sbgEComLogEkfQuatReadFromStream(SbgEComLogEkfQuat *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_QUAT_MIN_SIZE);
 
-    pLogData->quaternion[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->quaternion[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->quaternion[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->quaternion[3]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp         = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
 
-    pLogData->eulerStdDev[0]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->eulerStdDev[1]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->eulerStdDev[2]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->quaternion, 4);
 
-    pLogData->status            = sbgStreamBufferReadUint32LE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->eulerStdDev, 3);
 
-    //
-    // Added in sbgECom 5.0
-    //
-    if (sbgStreamBufferGetSpace(pStreamBuffer) >= 2*sizeof(float))
-    {
-        pLogData->magDeclination    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-        pLogData->magInclination    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    }
-    else
-    {
-        pLogData->magDeclination        = NAN;
-        pLogData->magInclination        = NAN;
+        pLogData->status            = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+
+        //
+        // Added in sbgECom 5.0
+        //
+        if (sbgStreamBufferGetSpace(pStreamBuffer) >= 2*sizeof(float))
+        {
+            pLogData->magDeclination    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+            pLogData->magInclination    = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
+        }
+        else
+        {
+            pLogData->magDeclination    = NAN;
+            pLogData->magInclination    = NAN;
+        }
     }
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogEkfQuatWriteToStream(const SbgEComLogEkfQuat *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -147,14 +148,9 @@ SbgErrorCode sbgEComLogEkfQuatWriteToStream(const SbgEComLogEkfQuat *pLogData, S
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->quaternion[0]); 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->quaternion[1]); 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->quaternion[2]); 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->quaternion[3]); 
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->quaternion, 4);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[0]); 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[1]); 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->eulerStdDev[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->eulerStdDev, 3);
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
 
@@ -173,32 +169,31 @@ SbgErrorCode sbgEComLogEkfQuatWriteToStream(const SbgEComLogEkfQuat *pLogData, S
 
 SbgErrorCode sbgEComLogEkfNavReadFromStream(SbgEComLogEkfNav *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp             = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_NAV_SIZE);
 
-    pLogData->velocity[0]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[1]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[2]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp             = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
 
-    pLogData->velocityStdDev[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityStdDev[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityStdDev[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->velocity, 3);
 
-    pLogData->position[0]           = sbgStreamBufferReadDoubleLE(pStreamBuffer);
-    pLogData->position[1]           = sbgStreamBufferReadDoubleLE(pStreamBuffer);
-    pLogData->position[2]           = sbgStreamBufferReadDoubleLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->velocityStdDev, 3);
 
-    pLogData->undulation            = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadDoubleLEArrayUnchecked(pStreamBuffer, pLogData->position, 3);
 
-    pLogData->positionStdDev[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->positionStdDev[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->positionStdDev[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        pLogData->undulation            = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
 
-    pLogData->status                = sbgStreamBufferReadUint32LE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->positionStdDev, 3);
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        pLogData->status                = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogEkfNavWriteToStream(const SbgEComLogEkfNav *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -208,23 +203,15 @@ SbgErrorCode sbgEComLogEkfNavWriteToStream(const SbgEComLogEkfNav *pLogData, Sbg
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocityStdDev, 3);
 
-    sbgStreamBufferWriteDoubleLE(pStreamBuffer, pLogData->position[0]);
-    sbgStreamBufferWriteDoubleLE(pStreamBuffer, pLogData->position[1]);
-    sbgStreamBufferWriteDoubleLE(pStreamBuffer, pLogData->position[2]);
+    sbgStreamBufferWriteDoubleLEArray(pStreamBuffer, pLogData->position, 3);
 
     sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->undulation);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->positionStdDev[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->positionStdDev[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->positionStdDev[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->positionStdDev, 3);
 
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
 
@@ -244,21 +231,24 @@ void sbgEComLogEkfVelBodyConstruct(SbgEComLogEkfVelBody *pLogData)
 
 SbgErrorCode sbgEComLogEkfVelBodyReadFromStream(SbgEComLogEkfVelBody *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp             = sbgStreamBufferReadUint32LE(pStreamBuffer);
-    pLogData->status                = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_VEL_BODY_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp             = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+        pLogData->status                = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
 
-    pLogData->velocity[0]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[1]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[2]           = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->velocity, 3);
 
-    pLogData->velocityStdDev[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityStdDev[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityStdDev[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->velocityStdDev, 3);
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogEkfVelBodyWriteToStream(const SbgEComLogEkfVelBody *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -269,13 +259,9 @@ SbgErrorCode sbgEComLogEkfVelBodyWriteToStream(const SbgEComLogEkfVelBody *pLogD
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityStdDev[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocityStdDev, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -72,6 +72,16 @@ extern "C" {
 #define SBG_ECOM_SOL_ALIGN_VALID            (0x00000001u << 27)     /*!< Set to 1 if sensor alignment and calibration parameters are valid */
 #define SBG_ECOM_SOL_DEPTH_USED             (0x00000001u << 28)     /*!< Set to 1 if Depth sensor (for sub-sea navigation) is used in solution (data used and valid since 3s). */
 #define SBG_ECOM_SOL_ZARU_USED              (0x00000001u << 29)     /*!< Set to 1 if a Zero Angular Rate Update (ZARU) is used in solution (data used and valid since 3s). */
+
+/*!
+ * Payload sizes, in bytes, of the EKF logs.
+ *
+ * The euler and quaternion logs can be followed by optional fields added in newer sbgECom versions.
+ */
+#define SBG_ECOM_LOG_EKF_EULER_MIN_SIZE     (32)                    /*!< Minimum payload size of the SBG_ECOM_LOG_EKF_EULER message. */
+#define SBG_ECOM_LOG_EKF_QUAT_MIN_SIZE      (36)                    /*!< Minimum payload size of the SBG_ECOM_LOG_EKF_QUAT message. */
+#define SBG_ECOM_LOG_EKF_NAV_SIZE           (72)                    /*!< Payload size of the SBG_ECOM_LOG_EKF_NAV message. */
+#define SBG_ECOM_LOG_EKF_VEL_BODY_SIZE      (32)                    /*!< Payload size of the SBG_ECOM_LOG_EKF_VEL_BODY message. */
 /*!
  * Solution filter mode enum.
  */
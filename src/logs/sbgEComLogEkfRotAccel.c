@@ -18,21 +18,24 @@ void sbgEComLogEkfRotAccelConstruct(SbgEComLogEkfRotAccel *pLogData)
 
 SbgErrorCode sbgEComLogEkfRotAccelReadFromStream(SbgEComLogEkfRotAccel *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp             = sbgStreamBufferReadUint32LE(pStreamBuffer);
-    pLogData->status                = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_EKF_ROT_ACCEL_SIZE);
 
-    pLogData->rate[0]               = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->rate[1]               = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->rate[2]               = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp             = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+        pLogData->status                = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
 
-    pLogData->acceleration[0]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->acceleration[1]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->acceleration[2]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->rate, 3);
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->acceleration, 3);
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogEkfRotAccelWriteToStream(const SbgEComLogEkfRotAccel *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -43,13 +46,9 @@ SbgErrorCode sbgEComLogEkfRotAccelWriteToStream(const SbgEComLogEkfRotAccel *pLo
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->rate[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->rate[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->rate[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->rate, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->acceleration[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->acceleration[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->acceleration[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->acceleration, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -65,6 +65,8 @@ extern "C" {
 //- Public definitions                                                 -//
 //----------------------------------------------------------------------//
 
+#define SBG_ECOM_LOG_EKF_ROT_ACCEL_SIZE     (32)                    /*!< Payload size of the SBG_ECOM_LOG_EKF_ROT_ACCEL_BODY and SBG_ECOM_LOG_EKF_ROT_ACCEL_NED messages. */
+
 /*!
  * INS compensated body or North, East, Down rotation rates and linear accelerations.
  */
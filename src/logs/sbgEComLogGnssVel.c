@@ -44,13 +44,9 @@ SbgErrorCode sbgEComLogGnssVelReadFromStream(SbgEComLogGnssVel *pLogData, SbgStr
     pLogData->status            = sbgStreamBufferReadUint32LE(pStreamBuffer);
     pLogData->timeOfWeek        = sbgStreamBufferReadUint32LE(pStreamBuffer);
     
-    pLogData->velocity[0]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[1]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocity[2]       = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
     
-    pLogData->velocityAcc[0]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityAcc[1]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->velocityAcc[2]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->velocityAcc, 3);
     
     pLogData->course            = sbgStreamBufferReadFloatLE(pStreamBuffer);
     pLogData->courseAcc         = sbgStreamBufferReadFloatLE(pStreamBuffer);
@@ -67,13 +63,9 @@ SbgErrorCode sbgEComLogGnssVelWriteToStream(const SbgEComLogGnssVel *pLogData, S
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->status);
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeOfWeek);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocity[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocity, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityAcc[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityAcc[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->velocityAcc[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->velocityAcc, 3);
 
     sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->course);
     sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->courseAcc);
@@ -1,4 +1,19 @@
-﻿#include "sbgEComLogImu.h"
+﻿// Standard headers
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SBG_ECOM_LOG_IMU_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SBG_ECOM_LOG_IMU_USE_NEON
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SBG_ECOM_LOG_IMU_USE_AVX2
+#endif
+
+// Local headers
+#include "sbgEComLogImu.h"
 
 //----------------------------------------------------------------------//
 //- Private constant definitions                                       -//
@@ -33,37 +48,41 @@
  */
 #define SBG_ECOM_LOG_IMU_TEMP_SCALE_STD                     (256.0f)
 
+/*!
+ * Number of IMU short records split in columns at once by sbgEComLogImuShortConvert().
+ */
+#define SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE           (64)
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
 
 SbgErrorCode sbgEComLogImuLegacyReadFromStream(SbgEComLogImuLegacy *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
-    pLogData->status            = sbgStreamBufferReadUint16LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_IMU_LEGACY_SIZE);
 
-    pLogData->accelerometers[0] = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->accelerometers[1] = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->accelerometers[2] = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp         = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+        pLogData->status            = sbgStreamBufferReadUint16LEUnchecked(pStreamBuffer);
 
-    pLogData->gyroscopes[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->gyroscopes[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->gyroscopes[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->accelerometers, 3);
 
-    pLogData->temperature       = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->gyroscopes, 3);
 
-    pLogData->deltaVelocity[0]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->deltaVelocity[1]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->deltaVelocity[2]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        pLogData->temperature       = sbgStreamBufferReadFloatLEUnchecked(pStreamBuffer);
 
-    pLogData->deltaAngle[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->deltaAngle[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->deltaAngle[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->deltaVelocity, 3);
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArrayUnchecked(pStreamBuffer, pLogData->deltaAngle, 3);
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogImuLegacyWriteToStream(const SbgEComLogImuLegacy *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -74,46 +93,41 @@ SbgErrorCode sbgEComLogImuLegacyWriteToStream(const SbgEComLogImuLegacy *pLogDat
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint16LE(pStreamBuffer, pLogData->status);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->accelerometers[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->accelerometers[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->accelerometers[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->accelerometers, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->gyroscopes[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->gyroscopes[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->gyroscopes[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->gyroscopes, 3);
 
     sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->temperature);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaVelocity[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaVelocity[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaVelocity[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->deltaVelocity, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaAngle[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaAngle[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->deltaAngle[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->deltaAngle, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
 
 SbgErrorCode sbgEComLogImuShortReadFromStream(SbgEComLogImuShort *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
-    pLogData->status            = sbgStreamBufferReadUint16LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_IMU_SHORT_SIZE);
 
-    pLogData->deltaVelocity[0]  = sbgStreamBufferReadInt32LE(pStreamBuffer);
-    pLogData->deltaVelocity[1]  = sbgStreamBufferReadInt32LE(pStreamBuffer);
-    pLogData->deltaVelocity[2]  = sbgStreamBufferReadInt32LE(pStreamBuffer);
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp         = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+        pLogData->status            = sbgStreamBufferReadUint16LEUnchecked(pStreamBuffer);
 
-    pLogData->deltaAngle[0]     = sbgStreamBufferReadInt32LE(pStreamBuffer);
-    pLogData->deltaAngle[1]     = sbgStreamBufferReadInt32LE(pStreamBuffer);
-    pLogData->deltaAngle[2]     = sbgStreamBufferReadInt32LE(pStreamBuffer);
+        sbgStreamBufferReadInt32LEArrayUnchecked(pStreamBuffer, pLogData->deltaVelocity, 3);
 
-    pLogData->temperature       = sbgStreamBufferReadInt16LE(pStreamBuffer);
+        sbgStreamBufferReadInt32LEArrayUnchecked(pStreamBuffer, pLogData->deltaAngle, 3);
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        pLogData->temperature       = sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer);
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogImuShortWriteToStream(const SbgEComLogImuShort *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -124,13 +138,9 @@ SbgErrorCode sbgEComLogImuShortWriteToStream(const SbgEComLogImuShort *pLogData,
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint16LE(pStreamBuffer, pLogData->status);
 
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaVelocity[0]);
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaVelocity[1]);
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaVelocity[2]);
+    sbgStreamBufferWriteInt32LEArray(pStreamBuffer, pLogData->deltaVelocity, 3);
 
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaAngle[0]);
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaAngle[1]);
-    sbgStreamBufferWriteInt32LE(pStreamBuffer,  pLogData->deltaAngle[2]);
+    sbgStreamBufferWriteInt32LEArray(pStreamBuffer, pLogData->deltaAngle, 3);
 
     sbgStreamBufferWriteInt16LE(pStreamBuffer,  pLogData->temperature);
 
@@ -139,21 +149,28 @@ SbgErrorCode sbgEComLogImuShortWriteToStream(const SbgEComLogImuShort *pLogData,
 
 SbgErrorCode sbgEComLogImuFastLegacyReadFromStream(SbgEComLogImuFastLegacy *pLogData, SbgStreamBuffer *pStreamBuffer)
 {
+    SbgErrorCode                 errorCode;
+
     assert(pStreamBuffer);
     assert(pLogData);
 
-    pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
-    pLogData->status            = sbgStreamBufferReadUint16LE(pStreamBuffer);
+    errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_IMU_FAST_LEGACY_SIZE);
 
-    pLogData->accelerometers[0] = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.01f;
-    pLogData->accelerometers[1] = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.01f;
-    pLogData->accelerometers[2] = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.01f;
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pLogData->timeStamp         = sbgStreamBufferReadUint32LEUnchecked(pStreamBuffer);
+        pLogData->status            = sbgStreamBufferReadUint16LEUnchecked(pStreamBuffer);
 
-    pLogData->gyroscopes[0]     = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.001f;
-    pLogData->gyroscopes[1]     = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.001f;
-    pLogData->gyroscopes[2]     = (float)sbgStreamBufferReadInt16LE(pStreamBuffer) * 0.001f;
+        pLogData->accelerometers[0] = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.01f;
+        pLogData->accelerometers[1] = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.01f;
+        pLogData->accelerometers[2] = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.01f;
 
-    return sbgStreamBufferGetLastError(pStreamBuffer);
+        pLogData->gyroscopes[0]     = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.001f;
+        pLogData->gyroscopes[1]     = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.001f;
+        pLogData->gyroscopes[2]     = (float)sbgStreamBufferReadInt16LEUnchecked(pStreamBuffer) * 0.001f;
+    }
+
+    return errorCode;
 }
 
 SbgErrorCode sbgEComLogImuFastLegacyWriteToStream(const SbgEComLogImuFastLegacy *pLogData, SbgStreamBuffer *pStreamBuffer)
@@ -254,6 +271,241 @@ void sbgEComLogImuShortSetTemperature(SbgEComLogImuShort *pImuShort, float tempe
     pImuShort->temperature = (int16_t)(temperature * SBG_ECOM_LOG_IMU_TEMP_SCALE_STD);
 }
 
+//----------------------------------------------------------------------//
+//- Public batch conversion methods                                    -//
+//----------------------------------------------------------------------//
+
+void sbgEComLogImuShortConvertDeltaAngles(const int32_t *pDeltaAngles, const uint16_t *pStatus, size_t nrValues, float *pOutput)
+{
+    size_t                               i = 0;
+
+    assert(pDeltaAngles || (nrValues == 0));
+    assert(pStatus || (nrValues == 0));
+    assert(pOutput || (nrValues == 0));
+
+    //
+    // The scale factor of each record is selected with a mask rather than a branch.
+    //
+#if defined(SBG_ECOM_LOG_IMU_USE_AVX2)
+    {
+        const __m256i                    highScale       = _mm256_set1_epi32(SBG_ECOM_IMU_GYROS_USE_HIGH_SCALE);
+        const __m256                     scaleFactorStd  = _mm256_set1_ps(SBG_ECOM_LOG_IMU_GYRO_SCALE_STD);
+        const __m256                     scaleFactorHigh = _mm256_set1_ps(SBG_ECOM_LOG_IMU_GYRO_SCALE_HIGH);
+
+        for (; (i + 8) <= nrValues; i += 8)
+        {
+            __m256i                      status;
+            __m256                       scaleFactor;
+
+            status      = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)&pStatus[i]));
+            status      = _mm256_cmpeq_epi32(_mm256_and_si256(status, highScale), highScale);
+            scaleFactor = _mm256_blendv_ps(scaleFactorStd, scaleFactorHigh, _mm256_castsi256_ps(status));
+
+            _mm256_storeu_ps(&pOutput[i], _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)&pDeltaAngles[i])), scaleFactor));
+        }
+    }
+#endif
+
+#if defined(SBG_ECOM_LOG_IMU_USE_SSE2)
+    {
+        const __m128i                    highScale       = _mm_set1_epi32(SBG_ECOM_IMU_GYROS_USE_HIGH_SCALE);
+        const __m128                     scaleFactorStd  = _mm_set1_ps(SBG_ECOM_LOG_IMU_GYRO_SCALE_STD);
+        const __m128                     scaleFactorHigh = _mm_set1_ps(SBG_ECOM_LOG_IMU_GYRO_SCALE_HIGH);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            __m128i                      status;
+            __m128                       mask;
+            __m128                       scaleFactor;
+
+            status      = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)&pStatus[i]), _mm_setzero_si128());
+            mask        = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(status, highScale), highScale));
+            scaleFactor = _mm_or_ps(_mm_and_ps(mask, scaleFactorHigh), _mm_andnot_ps(mask, scaleFactorStd));
+
+            _mm_storeu_ps(&pOutput[i], _mm_div_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&pDeltaAngles[i])), scaleFactor));
+        }
+    }
+#elif defined(SBG_ECOM_LOG_IMU_USE_NEON)
+    {
+        const uint32x4_t                 highScale       = vdupq_n_u32(SBG_ECOM_IMU_GYROS_USE_HIGH_SCALE);
+        const float32x4_t                scaleFactorStd  = vdupq_n_f32(SBG_ECOM_LOG_IMU_GYRO_SCALE_STD);
+        const float32x4_t                scaleFactorHigh = vdupq_n_f32(SBG_ECOM_LOG_IMU_GYRO_SCALE_HIGH);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            uint32x4_t                   mask;
+            float32x4_t                  scaleFactor;
+
+            mask        = vtstq_u32(vmovl_u16(vld1_u16(&pStatus[i])), highScale);
+            scaleFactor = vbslq_f32(mask, scaleFactorHigh, scaleFactorStd);
+
+            vst1q_f32(&pOutput[i], vdivq_f32(vcvtq_f32_s32(vld1q_s32(&pDeltaAngles[i])), scaleFactor));
+        }
+    }
+#endif
+
+    for (; i < nrValues; i++)
+    {
+        float                            scaleFactor;
+
+        scaleFactor = (pStatus[i] & SBG_ECOM_IMU_GYROS_USE_HIGH_SCALE) ? SBG_ECOM_LOG_IMU_GYRO_SCALE_HIGH : SBG_ECOM_LOG_IMU_GYRO_SCALE_STD;
+
+        pOutput[i] = pDeltaAngles[i] / scaleFactor;
+    }
+}
+
+void sbgEComLogImuShortConvertDeltaVelocities(const int32_t *pDeltaVelocities, size_t nrValues, float *pOutput)
+{
+    size_t                               i = 0;
+
+    assert(pDeltaVelocities || (nrValues == 0));
+    assert(pOutput || (nrValues == 0));
+
+#if defined(SBG_ECOM_LOG_IMU_USE_AVX2)
+    {
+        const __m256                     scaleFactor = _mm256_set1_ps(SBG_ECOM_LOG_IMU_ACCEL_SCALE_STD);
+
+        for (; (i + 8) <= nrValues; i += 8)
+        {
+            _mm256_storeu_ps(&pOutput[i], _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *)&pDeltaVelocities[i])), scaleFactor));
+        }
+    }
+#endif
+
+#if defined(SBG_ECOM_LOG_IMU_USE_SSE2)
+    {
+        const __m128                     scaleFactor = _mm_set1_ps(SBG_ECOM_LOG_IMU_ACCEL_SCALE_STD);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            _mm_storeu_ps(&pOutput[i], _mm_div_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&pDeltaVelocities[i])), scaleFactor));
+        }
+    }
+#elif defined(SBG_ECOM_LOG_IMU_USE_NEON)
+    {
+        const float32x4_t                scaleFactor = vdupq_n_f32(SBG_ECOM_LOG_IMU_ACCEL_SCALE_STD);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            vst1q_f32(&pOutput[i], vdivq_f32(vcvtq_f32_s32(vld1q_s32(&pDeltaVelocities[i])), scaleFactor));
+        }
+    }
+#endif
+
+    for (; i < nrValues; i++)
+    {
+        pOutput[i] = pDeltaVelocities[i] / SBG_ECOM_LOG_IMU_ACCEL_SCALE_STD;
+    }
+}
+
+void sbgEComLogImuShortConvertTemperatures(const int16_t *pTemperatures, size_t nrValues, float *pOutput)
+{
+    size_t                               i = 0;
+
+    assert(pTemperatures || (nrValues == 0));
+    assert(pOutput || (nrValues == 0));
+
+#if defined(SBG_ECOM_LOG_IMU_USE_AVX2)
+    {
+        const __m256                     scaleFactor = _mm256_set1_ps(SBG_ECOM_LOG_IMU_TEMP_SCALE_STD);
+
+        for (; (i + 8) <= nrValues; i += 8)
+        {
+            _mm256_storeu_ps(&pOutput[i], _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&pTemperatures[i]))), scaleFactor));
+        }
+    }
+#endif
+
+#if defined(SBG_ECOM_LOG_IMU_USE_SSE2)
+    {
+        const __m128                     scaleFactor = _mm_set1_ps(SBG_ECOM_LOG_IMU_TEMP_SCALE_STD);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            __m128i                      temperatures;
+
+            //
+            // Sign extend the 16 bits values by duplicating them in the upper half of each lane.
+            //
+            temperatures = _mm_loadl_epi64((const __m128i *)&pTemperatures[i]);
+            temperatures = _mm_srai_epi32(_mm_unpacklo_epi16(temperatures, temperatures), 16);
+
+            _mm_storeu_ps(&pOutput[i], _mm_div_ps(_mm_cvtepi32_ps(temperatures), scaleFactor));
+        }
+    }
+#elif defined(SBG_ECOM_LOG_IMU_USE_NEON)
+    {
+        const float32x4_t                scaleFactor = vdupq_n_f32(SBG_ECOM_LOG_IMU_TEMP_SCALE_STD);
+
+        for (; (i + 4) <= nrValues; i += 4)
+        {
+            vst1q_f32(&pOutput[i], vdivq_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(&pTemperatures[i]))), scaleFactor));
+        }
+    }
+#endif
+
+    for (; i < nrValues; i++)
+    {
+        pOutput[i] = pTemperatures[i] / SBG_ECOM_LOG_IMU_TEMP_SCALE_STD;
+    }
+}
+
+void sbgEComLogImuShortConvert(const SbgEComLogImuShort *pImuShorts, size_t nrRecords, float (*pDeltaVelocities)[3], float (*pDeltaAngles)[3], float *pTemperatures)
+{
+    assert(pImuShorts || (nrRecords == 0));
+    assert(pDeltaVelocities || (nrRecords == 0));
+    assert(pDeltaAngles || (nrRecords == 0));
+    assert(pTemperatures || (nrRecords == 0));
+
+    //
+    // Records are split in columns by blocks, small enough to stay in the L1 cache, and converted with the column methods.
+    //
+    for (size_t first = 0; first < nrRecords; first += SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE)
+    {
+        int32_t                          deltaVelocities[3][SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE];
+        int32_t                          deltaAngles[3][SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE];
+        uint16_t                         status[SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE];
+        int16_t                          temperatures[SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE];
+        float                            output[SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE];
+        size_t                           nrValues;
+
+        nrValues = sbgMin(nrRecords - first, SBG_ECOM_LOG_IMU_SHORT_CONVERT_BLOCK_SIZE);
+
+        for (size_t i = 0; i < nrValues; i++)
+        {
+            const SbgEComLogImuShort    *pImuShort = &pImuShorts[first + i];
+
+            status[i]       = pImuShort->status;
+            temperatures[i] = pImuShort->temperature;
+
+            for (size_t axis = 0; axis < 3; axis++)
+            {
+                deltaVelocities[axis][i]    = pImuShort->deltaVelocity[axis];
+                deltaAngles[axis][i]        = pImuShort->deltaAngle[axis];
+            }
+        }
+
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            sbgEComLogImuShortConvertDeltaVelocities(deltaVelocities[axis], nrValues, output);
+
+            for (size_t i = 0; i < nrValues; i++)
+            {
+                pDeltaVelocities[first + i][axis] = output[i];
+            }
+
+            sbgEComLogImuShortConvertDeltaAngles(deltaAngles[axis], status, nrValues, output);
+
+            for (size_t i = 0; i < nrValues; i++)
+            {
+                pDeltaAngles[first + i][axis] = output[i];
+            }
+        }
+
+        sbgEComLogImuShortConvertTemperatures(temperatures, nrValues, &pTemperatures[first]);
+    }
+}
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -63,6 +63,13 @@ extern "C" {
 #define SBG_ECOM_IMU_GYROS_IN_RANGE         (0x00000001u << 9)      /*!< Set to 1 if all gyroscopes are within operating range. */
 #define SBG_ECOM_IMU_GYROS_USE_HIGH_SCALE   (0x00000001u << 10)     /*!< Set if the gyroscope scale factor range is high. Applicable only for SBG_ECOM_LOG_IMU_SHORT logs. */
 
+/*!
+ * Payload sizes, in bytes, of the inertial logs.
+ */
+#define SBG_ECOM_LOG_IMU_LEGACY_SIZE        (58)                    /*!< Payload size of the SBG_ECOM_LOG_IMU_DATA message. */
+#define SBG_ECOM_LOG_IMU_SHORT_SIZE         (32)                    /*!< Payload size of the SBG_ECOM_LOG_IMU_SHORT message. */
+#define SBG_ECOM_LOG_IMU_FAST_LEGACY_SIZE   (18)                    /*!< Payload size of the SBG_ECOM_LOG_FAST_IMU_DATA message. */
+
 //----------------------------------------------------------------------//
 //- Log structure definitions                                          -//
 //----------------------------------------------------------------------//
@@ -236,6 +243,62 @@ float sbgEComLogImuShortGetTemperature(const SbgEComLogImuShort *pImuShort);
  */
 void sbgEComLogImuShortSetTemperature(SbgEComLogImuShort *pImuShort, float temperature);
 
+//----------------------------------------------------------------------//
+//- Public batch conversion methods                                    -//
+//----------------------------------------------------------------------//
+
+//
+// Batch conversions use SSE2, AVX2 or NEON if available at compile time. Scale factors are
+// applied with true divisions so that results don't depend on the instruction set used.
+//
+
+/*!
+ * Convert a column of IMU short delta angles in rad.s^-1.
+ *
+ * Results are identical to sbgEComLogImuShortGetDeltaAngle().
+ *
+ * \param[in]   pDeltaAngles                Delta angles of one axis, one per record.
+ * \param[in]   pStatus                     IMU status of each record, used to select the scale factor.
+ * \param[in]   nrValues                    Number of records.
+ * \param[out]  pOutput                     Delta angles converted in rad.s^-1.
+ */
+void sbgEComLogImuShortConvertDeltaAngles(const int32_t *pDeltaAngles, const uint16_t *pStatus, size_t nrValues, float *pOutput);
+
+/*!
+ * Convert a column of IMU short delta velocities in m.s^-2.
+ *
+ * Results are identical to sbgEComLogImuShortGetDeltaVelocity().
+ *
+ * \param[in]   pDeltaVelocities            Delta velocities of one axis, one per record.
+ * \param[in]   nrValues                    Number of records.
+ * \param[out]  pOutput                     Delta velocities converted in m.s^-2.
+ */
+void sbgEComLogImuShortConvertDeltaVelocities(const int32_t *pDeltaVelocities, size_t nrValues, float *pOutput);
+
+/*!
+ * Convert a column of IMU short temperatures in °C.
+ *
+ * Results are identical to sbgEComLogImuShortGetTemperature().
+ *
+ * \param[in]   pTemperatures               Temperatures, one per record.
+ * \param[in]   nrValues                    Number of records.
+ * \param[out]  pOutput                     Temperatures converted in °C.
+ */
+void sbgEComLogImuShortConvertTemperatures(const int16_t *pTemperatures, size_t nrValues, float *pOutput);
+
+/*!
+ * Convert IMU short records in rad.s^-1, m.s^-2 and °C.
+ *
+ * Results are identical to the IMU short getters.
+ *
+ * \param[in]   pImuShorts                  IMU short records.
+ * \param[in]   nrRecords                   Number of records.
+ * \param[out]  pDeltaVelocities            X, Y, Z delta velocities of each record, in m.s^-2.
+ * \param[out]  pDeltaAngles                X, Y, Z delta angles of each record, in rad.s^-1.
+ * \param[out]  pTemperatures               Temperature of each record, in °C.
+ */
+void sbgEComLogImuShortConvert(const SbgEComLogImuShort *pImuShorts, size_t nrRecords, float (*pDeltaVelocities)[3], float (*pDeltaAngles)[3], float *pTemperatures);
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -17,13 +17,9 @@ SbgErrorCode sbgEComLogMagReadFromStream(SbgEComLogMag *pLogData, SbgStreamBuffe
     pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
     pLogData->status            = sbgStreamBufferReadUint16LE(pStreamBuffer);
 
-    pLogData->magnetometers[0]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->magnetometers[1]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->magnetometers[2]  = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->magnetometers, 3);
                 
-    pLogData->accelerometers[0] = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->accelerometers[1] = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->accelerometers[2] = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->accelerometers, 3);
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -36,13 +32,9 @@ SbgErrorCode sbgEComLogMagWriteToStream(const SbgEComLogMag *pLogData, SbgStream
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteUint16LE(pStreamBuffer, pLogData->status);
     
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->magnetometers[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->magnetometers[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->magnetometers[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->magnetometers, 3);
         
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->accelerometers[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->accelerometers[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer, pLogData->accelerometers[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->accelerometers, 3);
     
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
@@ -88,10 +88,7 @@ SbgErrorCode sbgEComLogPtpReadFromStream(SbgEComLogPtp *pLogData, SbgStreamBuffe
     //
     if (sbgStreamBufferGetSpace(pStreamBuffer) >= sizeof(pLogData->masterMacAddress))
     {
-        for (size_t i = 0; i < SBG_ARRAY_SIZE(pLogData->masterMacAddress); i++)
-        {
-            pLogData->masterMacAddress[i] = sbgStreamBufferReadUint8(pStreamBuffer);
-        }
+        sbgStreamBufferReadBuffer(pStreamBuffer, pLogData->masterMacAddress, sizeof(pLogData->masterMacAddress));
     }
     else
     {
@@ -145,10 +142,7 @@ SbgErrorCode sbgEComLogPtpWriteToStream(const SbgEComLogPtp *pLogData, SbgStream
     //
     // Added in sbgECom 5.2
     //
-    for (size_t i = 0; i < SBG_ARRAY_SIZE(pLogData->masterMacAddress); i++)
-    {
-        sbgStreamBufferWriteUint8(pStreamBuffer, pLogData->masterMacAddress[i]);
-    }
+    sbgStreamBufferWriteBuffer(pStreamBuffer, pLogData->masterMacAddress, sizeof(pLogData->masterMacAddress));
 
     return sbgStreamBufferGetLastError(pStreamBuffer);
 }
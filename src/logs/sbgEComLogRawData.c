@@ -39,6 +39,31 @@ SbgErrorCode sbgEComLogRawDataWriteToStream(const SbgEComLogRawData *pLogData, S
     return sbgStreamBufferWriteBuffer(pStreamBuffer, pLogData->rawBuffer, pLogData->bufferSize);
 }
 
+SbgErrorCode sbgEComLogRawDataViewReadFromStream(SbgEComLogRawDataView *pView, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode    errorCode;
+    size_t          size;
+
+    assert(pStreamBuffer);
+    assert(pView);
+
+    size = sbgStreamBufferGetSpace(pStreamBuffer);
+
+    if (size <= SBG_ECOM_RAW_DATA_MAX_BUFFER_SIZE)
+    {
+        pView->pBuffer      = sbgStreamBufferGetCursor(pStreamBuffer);
+        pView->bufferSize   = size;
+
+        errorCode = sbgStreamBufferSeek(pStreamBuffer, size, SB_SEEK_CUR_INC);
+    }
+    else
+    {
+        errorCode = SBG_BUFFER_OVERFLOW;
+    }
+
+    return errorCode;
+}
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -60,6 +60,18 @@ typedef struct _SbgEComLogRawData
     size_t          bufferSize;                                     /*!< Raw buffer size in bytes. */
 } SbgEComLogRawData;
 
+/*!
+ * Read only view on a raw data message.
+ *
+ * The view refers to the received payload, no data is copied. It is only valid as long as the payload
+ * is, which is until the log callback returns for logs received through sbgECom.
+ */
+typedef struct _SbgEComLogRawDataView
+{
+    const uint8_t  *pBuffer;                                        /*!< Raw data. */
+    size_t          bufferSize;                                     /*!< Raw data size in bytes. */
+} SbgEComLogRawDataView;
+
 //----------------------------------------------------------------------//
 //- Public methods                                                     -//
 //----------------------------------------------------------------------//
@@ -82,6 +94,17 @@ SbgErrorCode sbgEComLogRawDataReadFromStream(SbgEComLogRawData *pLogData, SbgStr
  */
 SbgErrorCode sbgEComLogRawDataWriteToStream(const SbgEComLogRawData *pLogData, SbgStreamBuffer *pStreamBuffer);
 
+/*!
+ * Initialize a view on a raw data message.
+ *
+ * The whole remaining content of the stream buffer is referenced by the view and skipped.
+ *
+ * \param[out]  pView                       Raw data view.
+ * \param[in]   pStreamBuffer               Input stream buffer to read the log from.
+ * \return                                  SBG_NO_ERROR if a valid log has been read from the stream buffer.
+ */
+SbgErrorCode sbgEComLogRawDataViewReadFromStream(SbgEComLogRawDataView *pView, SbgStreamBuffer *pStreamBuffer);
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -61,6 +61,9 @@
 
 #define SBG_ECOM_LOG_SAT_SIGNAL_SNR_VALID                   (1u << 5)                                               /*!< Set if the SNR value is valid. */
 
+#define SBG_ECOM_LOG_SAT_SIGNAL_SIZE                        (3)                                                     /*!< Size of an encoded signal, in bytes. */
+#define SBG_ECOM_LOG_SAT_ENTRY_HEADER_SIZE                  (7)                                                     /*!< Size of an encoded satellite entry without its signals, in bytes. */
+
 //----------------------------------------------------------------------//
 //- Private functions                                                  -//
 //----------------------------------------------------------------------//
@@ -560,6 +563,100 @@ const char *sbgEComLogSatEntryGetTrackingStatusAsStr(const SbgEComLogSatEntry *p
     return sbgEComLogSatTrackingStatusToStr(sbgEComLogSatEntryGetTrackingStatus(pSatData));
 }
 
+//----------------------------------------------------------------------//
+//- Private functions (SbgEComLogSatList)                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Reset the index of a satellite list, for an empty list.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ */
+static void sbgEComLogSatListResetIndex(SbgEComLogSatList *pSatList)
+{
+    SbgEComLogSatListIndex              *pIndex;
+
+    assert(pSatList);
+
+    pIndex = &pSatList->index;
+
+    memset(pIndex->idHeads,             SBG_ECOM_SAT_INDEX_NONE, sizeof(pIndex->idHeads));
+    memset(pIndex->constellationHeads,  SBG_ECOM_SAT_INDEX_NONE, sizeof(pIndex->constellationHeads));
+    memset(pIndex->constellationTails,  SBG_ECOM_SAT_INDEX_NONE, sizeof(pIndex->constellationTails));
+
+    pIndex->valid = true;
+}
+
+/*!
+ * Add a satellite to the index of a satellite list.
+ *
+ * The satellite must be added after all the satellites that precede it in the list.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ * \param[in]   satIndex                    Index of the satellite in the satellite data array.
+ */
+static void sbgEComLogSatListIndexSatellite(SbgEComLogSatList *pSatList, size_t satIndex)
+{
+    SbgEComLogSatListIndex              *pIndex;
+    const SbgEComLogSatEntry            *pSatData;
+    size_t                               constellationId;
+    uint8_t                             *pLink;
+
+    assert(pSatList);
+    assert(pSatList->index.valid);
+    assert(satIndex < SBG_ARRAY_SIZE(pSatList->satData));
+
+    pIndex          = &pSatList->index;
+    pSatData        = &pSatList->satData[satIndex];
+    constellationId = sbgEComLogSatEntryGetConstellationId(pSatData);
+
+    assert(constellationId < SBG_ARRAY_SIZE(pIndex->constellationHeads));
+
+    pIndex->nextSameId[satIndex]            = SBG_ECOM_SAT_INDEX_NONE;
+    pIndex->nextSameConstellation[satIndex] = SBG_ECOM_SAT_INDEX_NONE;
+
+    //
+    // Satellites only share an ID across constellations, so this chain stays very short
+    //
+    pLink = &pIndex->idHeads[pSatData->id];
+
+    while (*pLink != SBG_ECOM_SAT_INDEX_NONE)
+    {
+        pLink = &pIndex->nextSameId[*pLink];
+    }
+
+    *pLink = (uint8_t)satIndex;
+
+    if (pIndex->constellationHeads[constellationId] == SBG_ECOM_SAT_INDEX_NONE)
+    {
+        pIndex->constellationHeads[constellationId] = (uint8_t)satIndex;
+    }
+    else
+    {
+        pIndex->nextSameConstellation[pIndex->constellationTails[constellationId]] = (uint8_t)satIndex;
+    }
+
+    pIndex->constellationTails[constellationId] = (uint8_t)satIndex;
+}
+
+/*!
+ * Get the index of a satellite list, built if needed.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ * \return                                  Satellite list index.
+ */
+static const SbgEComLogSatListIndex *sbgEComLogSatListGetIndex(SbgEComLogSatList *pSatList)
+{
+    assert(pSatList);
+
+    if (!pSatList->index.valid)
+    {
+        sbgEComLogSatListBuildIndex(pSatList);
+    }
+
+    return &pSatList->index;
+}
+
 //----------------------------------------------------------------------//
 //- Public methods (SbgEComLogSatList)                                 -//
 //----------------------------------------------------------------------//
@@ -571,6 +668,8 @@ void sbgEComLogSatListConstruct(SbgEComLogSatList *pSatList, uint32_t timeStamp)
     pSatList->timeStamp                 = timeStamp;
     pSatList->reserved                  = 0;
     pSatList->nrSatellites              = 0;
+
+    sbgEComLogSatListResetIndex(pSatList);
 }
 
 SbgEComLogSatEntry *sbgEComLogSatListAdd(SbgEComLogSatList *pSatList, uint8_t id, int8_t elevation, uint16_t azimuth, SbgEComConstellationId constellationId, SbgEComSatElevationStatus elevationStatus, SbgEComSatHealthStatus healthStatus, SbgEComSatTrackingStatus trackingStatus)
@@ -585,6 +684,11 @@ SbgEComLogSatEntry *sbgEComLogSatListAdd(SbgEComLogSatList *pSatList, uint8_t id
         pSatList->nrSatellites++;
 
         sbgEComLogSatEntryConstruct(pSatData, id, elevation, azimuth, constellationId, elevationStatus, healthStatus, trackingStatus);
+
+        if (pSatList->index.valid)
+        {
+            sbgEComLogSatListIndexSatellite(pSatList, pSatList->nrSatellites - 1);
+        }
     }
     else
     {
@@ -628,6 +732,15 @@ SbgErrorCode sbgEComLogSatListReadFromStream(SbgEComLogSatList *pSatList, SbgStr
         }
     }
 
+    if (errorCode == SBG_NO_ERROR)
+    {
+        sbgEComLogSatListBuildIndex(pSatList);
+    }
+    else
+    {
+        pSatList->index.valid = false;
+    }
+
     return errorCode;
 }
 
@@ -661,6 +774,19 @@ SbgErrorCode sbgEComLogSatListWriteToStream(const SbgEComLogSatList *pSatList, S
     return errorCode;
 }
 
+void sbgEComLogSatListBuildIndex(SbgEComLogSatList *pSatList)
+{
+    assert(pSatList);
+    assert(pSatList->nrSatellites <= SBG_ARRAY_SIZE(pSatList->satData));
+
+    sbgEComLogSatListResetIndex(pSatList);
+
+    for (size_t i = 0; i < pSatList->nrSatellites; i++)
+    {
+        sbgEComLogSatListIndexSatellite(pSatList, i);
+    }
+}
+
 //----------------------------------------------------------------------//
 //- Public setters/getters (SbgEComLogSatList)                         -//
 //----------------------------------------------------------------------//
@@ -668,14 +794,34 @@ SbgErrorCode sbgEComLogSatListWriteToStream(const SbgEComLogSatList *pSatList, S
 SbgEComLogSatEntry *sbgEComLogSatListGet(SbgEComLogSatList *pSatList, uint8_t id)
 {
     SbgEComLogSatEntry                      *pSatData = NULL;
+    const SbgEComLogSatListIndex            *pIndex;
 
     assert(pSatList);
 
-    for (size_t i = 0; i < pSatList->nrSatellites; i++)
+    pIndex = sbgEComLogSatListGetIndex(pSatList);
+
+    if (pIndex->idHeads[id] != SBG_ECOM_SAT_INDEX_NONE)
     {
-        if (pSatList->satData[i].id == id)
+        pSatData = &pSatList->satData[pIndex->idHeads[id]];
+    }
+
+    return pSatData;
+}
+
+SbgEComLogSatEntry *sbgEComLogSatListFind(SbgEComLogSatList *pSatList, SbgEComConstellationId constellationId, uint8_t id)
+{
+    SbgEComLogSatEntry                      *pSatData = NULL;
+    const SbgEComLogSatListIndex            *pIndex;
+
+    assert(pSatList);
+
+    pIndex = sbgEComLogSatListGetIndex(pSatList);
+
+    for (uint8_t satIndex = pIndex->idHeads[id]; satIndex != SBG_ECOM_SAT_INDEX_NONE; satIndex = pIndex->nextSameId[satIndex])
+    {
+        if (sbgEComLogSatEntryGetConstellationId(&pSatList->satData[satIndex]) == constellationId)
         {
-            pSatData = &pSatList->satData[i];
+            pSatData = &pSatList->satData[satIndex];
             break;
         }
     }
@@ -683,6 +829,226 @@ SbgEComLogSatEntry *sbgEComLogSatListGet(SbgEComLogSatList *pSatList, uint8_t id
     return pSatData;
 }
 
+SbgEComLogSatEntry *sbgEComLogSatListGetFirst(SbgEComLogSatList *pSatList, SbgEComConstellationId constellationId)
+{
+    SbgEComLogSatEntry                      *pSatData = NULL;
+    const SbgEComLogSatListIndex            *pIndex;
+
+    assert(pSatList);
+
+    pIndex = sbgEComLogSatListGetIndex(pSatList);
+
+    if (((size_t)constellationId < SBG_ARRAY_SIZE(pIndex->constellationHeads)) && (pIndex->constellationHeads[constellationId] != SBG_ECOM_SAT_INDEX_NONE))
+    {
+        pSatData = &pSatList->satData[pIndex->constellationHeads[constellationId]];
+    }
+
+    return pSatData;
+}
+
+SbgEComLogSatEntry *sbgEComLogSatListGetNext(SbgEComLogSatList *pSatList, const SbgEComLogSatEntry *pSatData)
+{
+    SbgEComLogSatEntry                      *pNextSatData = NULL;
+    const SbgEComLogSatListIndex            *pIndex;
+    size_t                                   satIndex;
+
+    assert(pSatList);
+    assert(pSatData);
+    assert((pSatData >= pSatList->satData) && (pSatData < &pSatList->satData[pSatList->nrSatellites]));
+
+    pIndex      = sbgEComLogSatListGetIndex(pSatList);
+    satIndex    = (size_t)(pSatData - pSatList->satData);
+
+    if (pIndex->nextSameConstellation[satIndex] != SBG_ECOM_SAT_INDEX_NONE)
+    {
+        pNextSatData = &pSatList->satData[pIndex->nextSameConstellation[satIndex]];
+    }
+
+    return pNextSatData;
+}
+
+//----------------------------------------------------------------------//
+//- Private functions (SbgEComLogSatEntryView)                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Decode a satellite entry view from a validated encoded satellite.
+ *
+ * \param[out]  pEntryView                  Satellite entry view.
+ * \param[in]   pSatellite                  Encoded satellite.
+ * \return                                  Next encoded satellite.
+ */
+static const uint8_t *sbgEComLogSatEntryViewInit(SbgEComLogSatEntryView *pEntryView, const uint8_t *pSatellite)
+{
+    SbgStreamBuffer                          streamBuffer;
+
+    assert(pEntryView);
+    assert(pSatellite);
+
+    sbgStreamBufferInitForRead(&streamBuffer, pSatellite, SBG_ECOM_LOG_SAT_ENTRY_HEADER_SIZE);
+
+    pEntryView->id                  = sbgStreamBufferReadUint8Unchecked(&streamBuffer);
+    pEntryView->elevation           = (int8_t)sbgStreamBufferReadUint8Unchecked(&streamBuffer);
+    pEntryView->azimuth             = sbgStreamBufferReadUint16LEUnchecked(&streamBuffer);
+    pEntryView->flags               = sbgStreamBufferReadUint16LEUnchecked(&streamBuffer);
+    pEntryView->nrSignals           = sbgStreamBufferReadUint8Unchecked(&streamBuffer);
+    pEntryView->pSignals            = &pSatellite[SBG_ECOM_LOG_SAT_ENTRY_HEADER_SIZE];
+
+    return &pEntryView->pSignals[pEntryView->nrSignals * SBG_ECOM_LOG_SAT_SIGNAL_SIZE];
+}
+
+//----------------------------------------------------------------------//
+//- Public methods (SbgEComLogSatEntryView)                            -//
+//----------------------------------------------------------------------//
+
+void sbgEComLogSatEntryViewGetSignal(const SbgEComLogSatEntryView *pEntryView, size_t index, SbgEComLogSatSignal *pSignalData)
+{
+    const uint8_t                           *pSignal;
+
+    assert(pEntryView);
+    assert(index < pEntryView->nrSignals);
+    assert(pSignalData);
+
+    pSignal = &pEntryView->pSignals[index * SBG_ECOM_LOG_SAT_SIGNAL_SIZE];
+
+    pSignalData->id                 = (SbgEComSignalId)pSignal[0];
+    pSignalData->flags              = pSignal[1];
+    pSignalData->snr                = pSignal[2];
+}
+
+void sbgEComLogSatEntryViewDecode(const SbgEComLogSatEntryView *pEntryView, SbgEComLogSatEntry *pSatData)
+{
+    assert(pEntryView);
+    assert(pEntryView->nrSignals <= SBG_ARRAY_SIZE(pSatData->signalData));
+    assert(pSatData);
+
+    pSatData->id                    = pEntryView->id;
+    pSatData->elevation             = pEntryView->elevation;
+    pSatData->azimuth               = pEntryView->azimuth;
+    pSatData->flags                 = pEntryView->flags;
+    pSatData->nrSignals             = pEntryView->nrSignals;
+
+    for (size_t i = 0; i < pEntryView->nrSignals; i++)
+    {
+        sbgEComLogSatEntryViewGetSignal(pEntryView, i, &pSatData->signalData[i]);
+    }
+}
+
+//----------------------------------------------------------------------//
+//- Public methods (SbgEComLogSatListView)                             -//
+//----------------------------------------------------------------------//
+
+SbgErrorCode sbgEComLogSatListViewReadFromStream(SbgEComLogSatListView *pView, SbgStreamBuffer *pStreamBuffer)
+{
+    SbgErrorCode                             errorCode;
+
+    assert(pView);
+    assert(pStreamBuffer);
+
+    pView->timeStamp                = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    pView->reserved                 = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    pView->nrSatellites             = sbgStreamBufferReadUint8LE(pStreamBuffer);
+    pView->pSatellites              = sbgStreamBufferGetCursor(pStreamBuffer);
+
+    errorCode = sbgStreamBufferGetLastError(pStreamBuffer);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        if (pView->nrSatellites <= SBG_ECOM_SAT_MAX_NR_SATELLITES)
+        {
+            //
+            // Validate the layout of all satellites once, so that views are decoded without any check
+            //
+            for (size_t i = 0; i < pView->nrSatellites; i++)
+            {
+                size_t                       nrSignals;
+
+                errorCode = sbgStreamBufferReserve(pStreamBuffer, SBG_ECOM_LOG_SAT_ENTRY_HEADER_SIZE);
+
+                if (errorCode != SBG_NO_ERROR)
+                {
+                    break;
+                }
+
+                sbgStreamBufferSeek(pStreamBuffer, SBG_ECOM_LOG_SAT_ENTRY_HEADER_SIZE - 1, SB_SEEK_CUR_INC);
+                nrSignals = sbgStreamBufferReadUint8Unchecked(pStreamBuffer);
+
+                if (nrSignals > SBG_ECOM_SAT_MAX_NR_SIGNALS)
+                {
+                    errorCode = SBG_INVALID_FRAME;
+                    SBG_LOG_ERROR(errorCode, "invalid number of signals: %zu", nrSignals);
+                    break;
+                }
+
+                errorCode = sbgStreamBufferReserve(pStreamBuffer, nrSignals * SBG_ECOM_LOG_SAT_SIGNAL_SIZE);
+
+                if (errorCode != SBG_NO_ERROR)
+                {
+                    break;
+                }
+
+                sbgStreamBufferSeek(pStreamBuffer, nrSignals * SBG_ECOM_LOG_SAT_SIGNAL_SIZE, SB_SEEK_CUR_INC);
+            }
+        }
+        else
+        {
+            errorCode = SBG_INVALID_FRAME;
+            SBG_LOG_ERROR(errorCode, "invalid number of satellites: %zu", pView->nrSatellites);
+        }
+    }
+
+    return errorCode;
+}
+
+bool sbgEComLogSatListViewGet(const SbgEComLogSatListView *pView, size_t index, SbgEComLogSatEntryView *pEntryView)
+{
+    SbgEComLogSatListViewIterator            iterator;
+    bool                                     found = false;
+
+    assert(pView);
+    assert(pEntryView);
+
+    if (index < pView->nrSatellites)
+    {
+        sbgEComLogSatListViewIteratorInit(&iterator, pView);
+
+        for (size_t i = 0; i <= index; i++)
+        {
+            found = sbgEComLogSatListViewIteratorNext(&iterator, pEntryView);
+        }
+    }
+
+    return found;
+}
+
+void sbgEComLogSatListViewIteratorInit(SbgEComLogSatListViewIterator *pIterator, const SbgEComLogSatListView *pView)
+{
+    assert(pIterator);
+    assert(pView);
+
+    pIterator->pView                = pView;
+    pIterator->index                = 0;
+    pIterator->pNext                = pView->pSatellites;
+}
+
+bool sbgEComLogSatListViewIteratorNext(SbgEComLogSatListViewIterator *pIterator, SbgEComLogSatEntryView *pEntryView)
+{
+    bool                                     found = false;
+
+    assert(pIterator);
+    assert(pEntryView);
+
+    if (pIterator->index < pIterator->pView->nrSatellites)
+    {
+        pIterator->pNext = sbgEComLogSatEntryViewInit(pEntryView, pIterator->pNext);
+        pIterator->index++;
+
+        found = true;
+    }
+
+    return found;
+}
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
@@ -58,6 +58,16 @@ extern "C" {
  */
 #define SBG_ECOM_SAT_MAX_NR_SIGNALS                         (8)
 
+/*!
+ * Number of constellation IDs that can be encoded in the satellite flags.
+ */
+#define SBG_ECOM_SAT_NR_CONSTELLATION_IDS                   (16)
+
+/*!
+ * Satellite index value used when there is no satellite.
+ */
+#define SBG_ECOM_SAT_INDEX_NONE                             (UINT8_MAX)
+
 //----------------------------------------------------------------------//
 //- Enumeration definitions                                            -//
 //----------------------------------------------------------------------//
@@ -154,8 +164,27 @@ typedef struct _SbgEComLogSatEntry
     SbgEComLogSatSignal                 signalData[SBG_ECOM_SAT_MAX_NR_SIGNALS];    /*!< Signal data array. */
 } SbgEComLogSatEntry;
 
+/*!
+ * Index of a satellite list, for constant time lookups.
+ *
+ * Satellites sharing the same ID, or the same constellation, are chained in list order
+ * using indexes in the satellite data array.
+ */
+typedef struct _SbgEComLogSatListIndex
+{
+    bool                                valid;                                                      /*!< True if the index matches the satellite data array. */
+    uint8_t                             idHeads[UINT8_MAX + 1];                                     /*!< First satellite of each satellite ID. */
+    uint8_t                             constellationHeads[SBG_ECOM_SAT_NR_CONSTELLATION_IDS];      /*!< First satellite of each constellation. */
+    uint8_t                             constellationTails[SBG_ECOM_SAT_NR_CONSTELLATION_IDS];      /*!< Last satellite of each constellation. */
+    uint8_t                             nextSameId[SBG_ECOM_SAT_MAX_NR_SATELLITES];                 /*!< Next satellite with the same satellite ID. */
+    uint8_t                             nextSameConstellation[SBG_ECOM_SAT_MAX_NR_SATELLITES];      /*!< Next satellite of the same constellation. */
+} SbgEComLogSatListIndex;
+
 /*!
  * List of visible satellites.
+ *
+ * The index is built by sbgEComLogSatListReadFromStream() and kept up to date by sbgEComLogSatListAdd().
+ * If satellite IDs or flags are modified directly, sbgEComLogSatListBuildIndex() must be called.
  */
 typedef struct _SbgEComLogSatList
 {
@@ -163,8 +192,49 @@ typedef struct _SbgEComLogSatList
     uint32_t                            reserved;                                   /*!< Reserved for future use. */
     size_t                              nrSatellites;                               /*!< Number of satellites. */
     SbgEComLogSatEntry                  satData[SBG_ECOM_SAT_MAX_NR_SATELLITES];    /*!< Satellite data array. */
+    SbgEComLogSatListIndex              index;                                      /*!< Satellite index, not part of the log. */
 } SbgEComLogSatList;
 
+/*!
+ * Read only view on a satellite entry.
+ *
+ * Signals are decoded on demand with sbgEComLogSatEntryViewGetSignal().
+ */
+typedef struct _SbgEComLogSatEntryView
+{
+    uint8_t                             id;                                         /*!< Satellite ID. */
+    int8_t                              elevation;                                  /*!< Elevation, in degrees [-90; +90], valid if and only if the elevation is known. */
+    uint16_t                            azimuth;                                    /*!< Azimuth, in degrees [0; 359], valid if and only if the elevation is known. */
+    uint16_t                            flags;                                      /*!< Flags. */
+    size_t                              nrSignals;                                  /*!< Number of signals. */
+    const uint8_t                      *pSignals;                                   /*!< Encoded signals, in the received payload. */
+} SbgEComLogSatEntryView;
+
+/*!
+ * Read only view on a list of visible satellites.
+ *
+ * The view refers to the received payload, no data is copied and satellites are decoded on demand.
+ * It is only valid as long as the payload is, which is until the log callback returns for logs received
+ * through sbgECom.
+ */
+typedef struct _SbgEComLogSatListView
+{
+    uint32_t                            timeStamp;                                  /*!< Time since the sensor power up, in us. */
+    uint32_t                            reserved;                                   /*!< Reserved for future use. */
+    size_t                              nrSatellites;                               /*!< Number of satellites. */
+    const uint8_t                      *pSatellites;                                /*!< Encoded satellites, in the received payload. */
+} SbgEComLogSatListView;
+
+/*!
+ * Iterator over the satellites of a list view.
+ */
+typedef struct _SbgEComLogSatListViewIterator
+{
+    const SbgEComLogSatListView        *pView;                                      /*!< Satellite list view. */
+    size_t                              index;                                      /*!< Index of the next satellite. */
+    const uint8_t                      *pNext;                                      /*!< Next encoded satellite. */
+} SbgEComLogSatListViewIterator;
+
 //----------------------------------------------------------------------//
 //- Public setters/getters (SbgEComLogSatSignal)                       -//
 //----------------------------------------------------------------------//
@@ -359,12 +429,23 @@ SbgErrorCode sbgEComLogSatListReadFromStream(SbgEComLogSatList *pSatList, SbgStr
  */
 SbgErrorCode sbgEComLogSatListWriteToStream(const SbgEComLogSatList *pSatList, SbgStreamBuffer *pStreamBuffer);
 
+/*!
+ * Build the index of a satellite list.
+ *
+ * Only required if satellite IDs, flags or the number of satellites have been modified directly.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ */
+void sbgEComLogSatListBuildIndex(SbgEComLogSatList *pSatList);
+
 //----------------------------------------------------------------------//
 //- Public setters/getters (SbgEComLogSatList)                         -//
 //----------------------------------------------------------------------//
 
 /*!
- * Get a satellite entry from its ID.
+ * Get a satellite entry from its ID, in constant time.
+ *
+ * If several constellations have a satellite with this ID, the first one in the list is returned.
  *
  * \param[in]   pSatList                    Satellite list instance.
  * \param[in]   id                          Satellite ID.
@@ -372,6 +453,106 @@ SbgErrorCode sbgEComLogSatListWriteToStream(const SbgEComLogSatList *pSatList, S
  */
 SbgEComLogSatEntry *sbgEComLogSatListGet(SbgEComLogSatList *pSatList, uint8_t id);
 
+/*!
+ * Get a satellite entry from its constellation and ID, in constant time.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ * \param[in]   constellationId             Constellation ID.
+ * \param[in]   id                          Satellite ID.
+ * \return                                  Satellite data, NULL if not found.
+ */
+SbgEComLogSatEntry *sbgEComLogSatListFind(SbgEComLogSatList *pSatList, SbgEComConstellationId constellationId, uint8_t id);
+
+/*!
+ * Get the first satellite entry of a constellation.
+ *
+ * Use with sbgEComLogSatListGetNext() to iterate over the satellites of a constellation:
+ *
+ *     for (pSatData = sbgEComLogSatListGetFirst(pSatList, id); pSatData; pSatData = sbgEComLogSatListGetNext(pSatList, pSatData))
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ * \param[in]   constellationId             Constellation ID.
+ * \return                                  Satellite data, NULL if there is no satellite for this constellation.
+ */
+SbgEComLogSatEntry *sbgEComLogSatListGetFirst(SbgEComLogSatList *pSatList, SbgEComConstellationId constellationId);
+
+/*!
+ * Get the next satellite entry of the same constellation.
+ *
+ * \param[in]   pSatList                    Satellite list instance.
+ * \param[in]   pSatData                    Satellite data, must belong to the list.
+ * \return                                  Next satellite data of the same constellation, NULL if none.
+ */
+SbgEComLogSatEntry *sbgEComLogSatListGetNext(SbgEComLogSatList *pSatList, const SbgEComLogSatEntry *pSatData);
+
+//----------------------------------------------------------------------//
+//- Public methods (SbgEComLogSatEntryView)                            -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Decode a signal of a satellite entry view.
+ *
+ * \param[in]   pEntryView                  Satellite entry view.
+ * \param[in]   index                       Signal index, lower than the number of signals.
+ * \param[out]  pSignalData                 Signal data.
+ */
+void sbgEComLogSatEntryViewGetSignal(const SbgEComLogSatEntryView *pEntryView, size_t index, SbgEComLogSatSignal *pSignalData);
+
+/*!
+ * Decode a satellite entry view with all its signals.
+ *
+ * The decoded entry can be used with the SbgEComLogSatEntry getters.
+ *
+ * \param[in]   pEntryView                  Satellite entry view.
+ * \param[out]  pSatData                    Satellite entry.
+ */
+void sbgEComLogSatEntryViewDecode(const SbgEComLogSatEntryView *pEntryView, SbgEComLogSatEntry *pSatData);
+
+//----------------------------------------------------------------------//
+//- Public methods (SbgEComLogSatListView)                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Initialize a view on a satellite list message.
+ *
+ * The layout of all satellites is validated, so that they can be decoded later without any check.
+ *
+ * \param[out]  pView                       Satellite list view.
+ * \param[in]   pStreamBuffer               Input stream buffer to read the log from.
+ * \return                                  SBG_NO_ERROR if a valid log has been read from the stream buffer.
+ */
+SbgErrorCode sbgEComLogSatListViewReadFromStream(SbgEComLogSatListView *pView, SbgStreamBuffer *pStreamBuffer);
+
+/*!
+ * Get a satellite entry view from its index.
+ *
+ * Satellites have a variable size, the list is walked up to the requested index. Use an iterator
+ * to go through all satellites.
+ *
+ * \param[in]   pView                       Satellite list view.
+ * \param[in]   index                       Satellite index.
+ * \param[out]  pEntryView                  Satellite entry view.
+ * \return                                  True if the satellite exists.
+ */
+bool sbgEComLogSatListViewGet(const SbgEComLogSatListView *pView, size_t index, SbgEComLogSatEntryView *pEntryView);
+
+/*!
+ * Initialize an iterator on the first satellite of a list view.
+ *
+ * \param[out]  pIterator                   Iterator.
+ * \param[in]   pView                       Satellite list view.
+ */
+void sbgEComLogSatListViewIteratorInit(SbgEComLogSatListViewIterator *pIterator, const SbgEComLogSatListView *pView);
+
+/*!
+ * Get the next satellite of a list view.
+ *
+ * \param[in]   pIterator                   Iterator.
+ * \param[out]  pEntryView                  Satellite entry view.
+ * \return                                  True if a satellite has been returned, false at the end of the list.
+ */
+bool sbgEComLogSatListViewIteratorNext(SbgEComLogSatListViewIterator *pIterator, SbgEComLogSatEntryView *pEntryView);
+
 //----------------------------------------------------------------------//
 //- DEPRECATED - Used for backward compatibility                       -//
 //----------------------------------------------------------------------//
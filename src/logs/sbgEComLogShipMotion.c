@@ -12,13 +12,9 @@ SbgErrorCode sbgEComLogShipMotionReadFromStream(SbgEComLogShipMotion *pLogData,
     pLogData->timeStamp         = sbgStreamBufferReadUint32LE(pStreamBuffer);
     pLogData->mainHeavePeriod   = sbgStreamBufferReadFloatLE(pStreamBuffer);
 
-    pLogData->shipMotion[0]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->shipMotion[1]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->shipMotion[2]     = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->shipMotion, 3);
     
-    pLogData->shipAccel[0]      = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->shipAccel[1]      = sbgStreamBufferReadFloatLE(pStreamBuffer);
-    pLogData->shipAccel[2]      = sbgStreamBufferReadFloatLE(pStreamBuffer);
+    sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->shipAccel, 3);
 
     //
     // Test if we have a additional information such as ship velocity and status (since version 1.4)
@@ -28,9 +24,7 @@ SbgErrorCode sbgEComLogShipMotionReadFromStream(SbgEComLogShipMotion *pLogData,
         //
         // Read new outputs
         //
-        pLogData->shipVel[0]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-        pLogData->shipVel[1]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
-        pLogData->shipVel[2]    = sbgStreamBufferReadFloatLE(pStreamBuffer);
+        sbgStreamBufferReadFloatLEArray(pStreamBuffer, pLogData->shipVel, 3);
 
         pLogData->status        = sbgStreamBufferReadUint16LE(pStreamBuffer);
     }
@@ -57,20 +51,14 @@ SbgErrorCode sbgEComLogShipMotionWriteToStream(const SbgEComLogShipMotion *pLogD
     sbgStreamBufferWriteUint32LE(pStreamBuffer, pLogData->timeStamp);
     sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->mainHeavePeriod);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipMotion[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipMotion[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipMotion[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->shipMotion, 3);
 
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipAccel[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipAccel[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipAccel[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->shipAccel, 3);
 
     //
     // Write additional fields added in version 1.4
     //
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipVel[0]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipVel[1]);
-    sbgStreamBufferWriteFloatLE(pStreamBuffer,  pLogData->shipVel[2]);
+    sbgStreamBufferWriteFloatLEArray(pStreamBuffer, pLogData->shipVel, 3);
 
     sbgStreamBufferWriteUint16LE(pStreamBuffer, pLogData->status);
 
@@ -0,0 +1,398 @@
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// Local headers
+#include "sbgEComFrameRing.h"
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Private functions                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get the payload storage of a slot.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \param[in]   index                       Monotonic slot index.
+ * \return                                  Slot payload storage.
+ */
+static uint8_t *sbgEComFrameRingGetSlotPayload(const SbgEComFrameRing *pRing, size_t index)
+{
+    assert(pRing);
+
+    return &pRing->pPayloads[(index % pRing->depth) * pRing->slotSize];
+}
+
+/*!
+ * Count a dropped frame.
+ *
+ * \param[in]   pRing                       Frame ring.
+ */
+static void sbgEComFrameRingCountDrop(SbgEComFrameRing *pRing)
+{
+    assert(pRing);
+
+    sbgAtomicStore(&pRing->nrDroppedFrames, pRing->nrDroppedFrames + 1);
+}
+
+/*!
+ * Lock the ring from the consumer thread, if the producer may drop the oldest frame.
+ *
+ * With the drop newest policy, the producer never writes a slot that isn't free, the
+ * consumer doesn't need to lock the ring.
+ *
+ * \param[in]   pRing                       Frame ring.
+ */
+static void sbgEComFrameRingLockConsumer(SbgEComFrameRing *pRing)
+{
+    assert(pRing);
+
+    if (pRing->dropPolicy == SBG_ECOM_FRAME_RING_DROP_OLDEST)
+    {
+        sbgMutexLock(pRing->pMutex);
+    }
+}
+
+/*!
+ * Unlock the ring from the consumer thread.
+ *
+ * \param[in]   pRing                       Frame ring.
+ */
+static void sbgEComFrameRingUnlockConsumer(SbgEComFrameRing *pRing)
+{
+    assert(pRing);
+
+    if (pRing->dropPolicy == SBG_ECOM_FRAME_RING_DROP_OLDEST)
+    {
+        sbgMutexUnlock(pRing->pMutex);
+    }
+}
+
+/*!
+ * Make room for a frame, from the producer thread.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \param[in]   head                        Producer index.
+ * \return                                  True if a slot is available, false if the frame must be dropped.
+ */
+static bool sbgEComFrameRingReserve(SbgEComFrameRing *pRing, size_t head)
+{
+    bool                                 available = true;
+    size_t                               tail;
+
+    assert(pRing);
+
+    tail = sbgAtomicLoad(&pRing->tail);
+
+    if ((head - tail) >= pRing->depth)
+    {
+        if (pRing->dropPolicy == SBG_ECOM_FRAME_RING_DROP_NEWEST)
+        {
+            available = false;
+        }
+        else
+        {
+            //
+            // Drop the oldest frame with the consumer mutex held, so that no consumer is copying it.
+            // If a consumer has popped it in the meantime, a slot is available anyway.
+            //
+            sbgMutexLock(pRing->pMutex);
+
+            tail = sbgAtomicLoad(&pRing->tail);
+
+            if ((head - tail) >= pRing->depth)
+            {
+                SbgEComFrameRingSlot            *pSlot = &pRing->pSlots[tail % pRing->depth];
+
+                free(pSlot->pLargePayload);
+                pSlot->pLargePayload = NULL;
+
+                sbgAtomicStore(&pRing->tail, tail + 1);
+                sbgEComFrameRingCountDrop(pRing);
+            }
+
+            sbgMutexUnlock(pRing->pMutex);
+        }
+    }
+
+    return available;
+}
+
+//----------------------------------------------------------------------//
+//- Public functions                                                   -//
+//----------------------------------------------------------------------//
+
+void sbgEComFrameRingGetDefaultConfig(SbgEComFrameRingConfig *pConfig)
+{
+    assert(pConfig);
+
+    pConfig->depth      = SBG_ECOM_FRAME_RING_DEFAULT_DEPTH;
+    pConfig->slotSize   = SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE;
+    pConfig->dropPolicy = SBG_ECOM_FRAME_RING_DROP_OLDEST;
+}
+
+SbgErrorCode sbgEComFrameRingConstruct(SbgEComFrameRing *pRing, const SbgEComFrameRingConfig *pConfig)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComFrameRingConfig               config;
+
+    assert(pRing);
+
+    if (pConfig)
+    {
+        config = *pConfig;
+    }
+    else
+    {
+        sbgEComFrameRingGetDefaultConfig(&config);
+    }
+
+    memset(pRing, 0, sizeof(*pRing));
+
+    if ((config.depth >= 2) && (config.slotSize != 0) && (config.depth <= (SIZE_MAX / config.slotSize)))
+    {
+        pRing->pSlots       = calloc(config.depth, sizeof(*pRing->pSlots));
+        pRing->pPayloads    = malloc(config.depth * config.slotSize);
+
+        if (pRing->pSlots && pRing->pPayloads)
+        {
+            errorCode = sbgMutexCreate(&pRing->pMutex);
+        }
+        else
+        {
+            errorCode = SBG_MALLOC_FAILED;
+            SBG_LOG_ERROR(errorCode, "unable to allocate frame ring of %zu slots", config.depth);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            pRing->depth        = config.depth;
+            pRing->slotSize     = config.slotSize;
+            pRing->dropPolicy   = config.dropPolicy;
+        }
+        else
+        {
+            free(pRing->pSlots);
+            free(pRing->pPayloads);
+
+            pRing->pSlots       = NULL;
+            pRing->pPayloads    = NULL;
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "invalid frame ring configuration: depth:%zu slot size:%zu", config.depth, config.slotSize);
+    }
+
+    return errorCode;
+}
+
+void sbgEComFrameRingDestroy(SbgEComFrameRing *pRing)
+{
+    assert(pRing);
+
+    if (pRing->pSlots)
+    {
+        for (size_t i = pRing->tail; i != pRing->head; i++)
+        {
+            free(pRing->pSlots[i % pRing->depth].pLargePayload);
+        }
+    }
+
+    if (pRing->pMutex)
+    {
+        sbgMutexDestroy(pRing->pMutex);
+    }
+
+    free(pRing->pSlots);
+    free(pRing->pPayloads);
+
+    pRing->pSlots       = NULL;
+    pRing->pPayloads    = NULL;
+    pRing->pMutex       = NULL;
+}
+
+bool sbgEComFrameRingPush(SbgEComFrameRing *pRing, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t payloadSize)
+{
+    bool                                 pushed = false;
+    size_t                               head;
+
+    assert(pRing);
+    assert(pPayload || (payloadSize == 0));
+
+    head = pRing->head;
+
+    if (sbgEComFrameRingReserve(pRing, head))
+    {
+        SbgEComFrameRingSlot                *pSlot = &pRing->pSlots[head % pRing->depth];
+
+        pSlot->msgClass     = msgClass;
+        pSlot->msgId        = msgId;
+        pSlot->payloadSize  = payloadSize;
+
+        if (payloadSize <= pRing->slotSize)
+        {
+            pSlot->pLargePayload = NULL;
+
+            if (payloadSize != 0)
+            {
+                memcpy(sbgEComFrameRingGetSlotPayload(pRing, head), pPayload, payloadSize);
+            }
+
+            pushed = true;
+        }
+        else
+        {
+            pSlot->pLargePayload = malloc(payloadSize);
+
+            if (pSlot->pLargePayload)
+            {
+                memcpy(pSlot->pLargePayload, pPayload, payloadSize);
+                pushed = true;
+            }
+        }
+
+        if (pushed)
+        {
+            size_t                               nrFrames;
+
+            sbgAtomicStore(&pRing->head, head + 1);
+            sbgAtomicStore(&pRing->nrPushedFrames, pRing->nrPushedFrames + 1);
+
+            nrFrames = head + 1 - sbgAtomicLoad(&pRing->tail);
+
+            if ((nrFrames <= pRing->depth) && (nrFrames > pRing->highWaterMark))
+            {
+                sbgAtomicStore(&pRing->highWaterMark, nrFrames);
+            }
+        }
+    }
+
+    if (!pushed)
+    {
+        sbgEComFrameRingCountDrop(pRing);
+    }
+
+    return pushed;
+}
+
+SbgErrorCode sbgEComFrameRingPop(SbgEComFrameRing *pRing, uint8_t *pMsgClass, uint8_t *pMsgId, void *pBuffer, SbgEComProtocolPayload *pPayload)
+{
+    SbgErrorCode                         errorCode = SBG_NOT_READY;
+
+    assert(pRing);
+    assert(pMsgClass);
+    assert(pMsgId);
+    assert(pBuffer);
+    assert(pPayload);
+
+    if (!sbgEComFrameRingIsEmpty(pRing))
+    {
+        size_t                           tail;
+        SbgEComFrameRingSlot             slot;
+
+        //
+        // The producer only writes the slots it has reserved, which are never the oldest one, unless it
+        // drops it, which is done with the mutex held. The frame can be copied without any race.
+        //
+        sbgEComFrameRingLockConsumer(pRing);
+
+        tail = sbgAtomicLoad(&pRing->tail);
+
+        if (tail != sbgAtomicLoad(&pRing->head))
+        {
+            slot = pRing->pSlots[tail % pRing->depth];
+
+            if (!slot.pLargePayload)
+            {
+                memcpy(pBuffer, sbgEComFrameRingGetSlotPayload(pRing, tail), slot.payloadSize);
+            }
+
+            sbgAtomicStore(&pRing->tail, tail + 1);
+            sbgAtomicStore(&pRing->nrPoppedFrames, pRing->nrPoppedFrames + 1);
+
+            errorCode = SBG_NO_ERROR;
+        }
+
+        sbgEComFrameRingUnlockConsumer(pRing);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComProtocolPayloadDestroy(pPayload);
+            sbgEComProtocolPayloadConstruct(pPayload);
+
+            if (slot.pLargePayload)
+            {
+                //
+                // The payload is constructed with the default allocator, it takes the ownership of the buffer.
+                // The slot itself is left untouched as it may already be written by the producer.
+                //
+                pPayload->allocated = true;
+                pPayload->pBuffer   = slot.pLargePayload;
+            }
+            else
+            {
+                pPayload->pBuffer   = pBuffer;
+            }
+
+            pPayload->size  = slot.payloadSize;
+            *pMsgClass      = slot.msgClass;
+            *pMsgId         = slot.msgId;
+        }
+    }
+
+    return errorCode;
+}
+
+size_t sbgEComFrameRingDiscard(SbgEComFrameRing *pRing)
+{
+    size_t                               nrFrames = 0;
+    size_t                               tail;
+    size_t                               head;
+
+    assert(pRing);
+
+    sbgEComFrameRingLockConsumer(pRing);
+
+    tail = sbgAtomicLoad(&pRing->tail);
+    head = sbgAtomicLoad(&pRing->head);
+
+    for (; tail != head; tail++)
+    {
+        SbgEComFrameRingSlot            *pSlot = &pRing->pSlots[tail % pRing->depth];
+
+        free(pSlot->pLargePayload);
+        pSlot->pLargePayload = NULL;
+
+        nrFrames++;
+    }
+
+    sbgAtomicStore(&pRing->tail, tail);
+    sbgAtomicStore(&pRing->nrPoppedFrames, pRing->nrPoppedFrames + nrFrames);
+
+    sbgEComFrameRingUnlockConsumer(pRing);
+
+    return nrFrames;
+}
+
+bool sbgEComFrameRingIsEmpty(const SbgEComFrameRing *pRing)
+{
+    assert(pRing);
+
+    return sbgAtomicLoad(&pRing->tail) == sbgAtomicLoad(&pRing->head);
+}
+
+void sbgEComFrameRingGetStats(const SbgEComFrameRing *pRing, SbgEComFrameRingStats *pStats)
+{
+    assert(pRing);
+    assert(pStats);
+
+    pStats->nrPushedFrames  = sbgAtomicLoad(&pRing->nrPushedFrames);
+    pStats->nrPoppedFrames  = sbgAtomicLoad(&pRing->nrPoppedFrames);
+    pStats->nrDroppedFrames = sbgAtomicLoad(&pRing->nrDroppedFrames);
+    pStats->highWaterMark   = sbgAtomicLoad(&pRing->highWaterMark);
+}
+
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
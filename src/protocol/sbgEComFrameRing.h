@@ -0,0 +1,231 @@
+/*!
+ * \file            sbgEComFrameRing.h
+ * \ingroup         protocol
+ * \author          SBG Systems
+ * \date            16 October 2026
+ *
+ * \brief           Lock-free single producer, single consumer ring of received frames.
+ *
+ * The ring hands validated frames over from a thread reading the interface to a thread decoding
+ * them. Frames are copied into fixed size slots, larger frames are copied into allocated buffers.
+ *
+ * The consumer copies a frame out of its slot before claiming it. When the ring is full and the
+ * oldest frames are dropped, the producer claims the oldest slot first, a consumer reading it
+ * concurrently then fails to claim it and retries with the next one.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+#ifndef SBG_ECOM_FRAME_RING_H
+#define SBG_ECOM_FRAME_RING_H
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// Local headers
+#include "sbgEComProtocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_FRAME_RING_DEFAULT_DEPTH       (256)               /*!< Default number of frames in the ring, about 100 ms of a 200 Hz output of 10 logs. */
+#define SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE   (512)               /*!< Default slot size, in bytes, larger frames such as raw GNSS data are allocated. */
+#define SBG_ECOM_FRAME_RING_CACHE_LINE_SIZE     (64)                /*!< Cache line size, used to keep the producer and consumer indexes apart. */
+
+//----------------------------------------------------------------------//
+//- Enumeration definitions                                            -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Frames dropped when the ring is full.
+ */
+typedef enum _SbgEComFrameRingDropPolicy
+{
+    SBG_ECOM_FRAME_RING_DROP_NEWEST             = 0,                        /*!< Drop the received frame, the ring keeps the oldest frames. */
+    SBG_ECOM_FRAME_RING_DROP_OLDEST             = 1,                        /*!< Drop the oldest frame, the ring keeps the most recent frames. */
+} SbgEComFrameRingDropPolicy;
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Frame ring configuration.
+ */
+typedef struct _SbgEComFrameRingConfig
+{
+    size_t                               depth;                                     /*!< Number of frames, at least 2. */
+    size_t                               slotSize;                                  /*!< Largest payload stored without allocation, in bytes. */
+    SbgEComFrameRingDropPolicy           dropPolicy;                                /*!< Frames dropped when the ring is full. */
+} SbgEComFrameRingConfig;
+
+/*!
+ * Frame ring statistics.
+ */
+typedef struct _SbgEComFrameRingStats
+{
+    size_t                               nrPushedFrames;                            /*!< Number of frames pushed by the producer. */
+    size_t                               nrPoppedFrames;                            /*!< Number of frames popped by the consumer. */
+    size_t                               nrDroppedFrames;                           /*!< Number of frames dropped because the ring was full or the frame couldn't be allocated. */
+    size_t                               highWaterMark;                             /*!< Highest number of frames in the ring. */
+} SbgEComFrameRingStats;
+
+/*!
+ * Frame ring slot.
+ */
+typedef struct _SbgEComFrameRingSlot
+{
+    uint8_t                              msgClass;                                  /*!< Message class. */
+    uint8_t                              msgId;                                     /*!< Message ID. */
+    size_t                               payloadSize;                               /*!< Payload size, in bytes. */
+    uint8_t                             *pLargePayload;                             /*!< Allocated payload if larger than the slot size, NULL otherwise. */
+} SbgEComFrameRingSlot;
+
+/*!
+ * Frame ring.
+ *
+ * Indexes increase monotonically, slots are addressed modulo the depth.
+ *
+ * A single producer pushes frames and a single consumer pops them. The producer never locks the ring.
+ * With the drop oldest policy, the producer drops the oldest frame with the ring mutex held, and the
+ * consumer holds it too, so that a slot is never released while it is copied. With the drop newest
+ * policy, the producer only writes free slots and the consumer doesn't lock the ring either.
+ */
+typedef struct _SbgEComFrameRing
+{
+    SbgEComFrameRingSlot                *pSlots;                                    /*!< Slots. */
+    uint8_t                             *pPayloads;                                 /*!< Slot payloads, slotSize bytes each. */
+    size_t                               depth;                                     /*!< Number of slots. */
+    size_t                               slotSize;                                  /*!< Slot payload size, in bytes. */
+    SbgEComFrameRingDropPolicy           dropPolicy;                                /*!< Frames dropped when the ring is full. */
+    SbgMutex                            *pMutex;                                    /*!< Held by the producer to drop the oldest frame, and by the consumer with the drop oldest policy. */
+
+    uint8_t                              padding1[SBG_ECOM_FRAME_RING_CACHE_LINE_SIZE];
+    volatile size_t                      head;                                      /*!< Index of the next slot written, only modified by the producer. */
+    volatile size_t                      nrPushedFrames;                            /*!< Number of frames pushed. */
+    volatile size_t                      nrDroppedFrames;                           /*!< Number of frames dropped. */
+    volatile size_t                      highWaterMark;                             /*!< Highest number of frames in the ring. */
+
+    uint8_t                              padding2[SBG_ECOM_FRAME_RING_CACHE_LINE_SIZE];
+    volatile size_t                      tail;                                      /*!< Index of the oldest slot, modified by the consumer, and by the producer with the mutex held. */
+    volatile size_t                      nrPoppedFrames;                            /*!< Number of frames popped. */
+    uint8_t                              padding3[SBG_ECOM_FRAME_RING_CACHE_LINE_SIZE];
+} SbgEComFrameRing;
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get the default frame ring configuration.
+ *
+ * \param[out]  pConfig                     Configuration.
+ */
+void sbgEComFrameRingGetDefaultConfig(SbgEComFrameRingConfig *pConfig);
+
+/*!
+ * Frame ring constructor.
+ *
+ * \param[out]  pRing                       Frame ring.
+ * \param[in]   pConfig                     Configuration, NULL for the default configuration.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+SbgErrorCode sbgEComFrameRingConstruct(SbgEComFrameRing *pRing, const SbgEComFrameRingConfig *pConfig);
+
+/*!
+ * Frame ring destructor.
+ *
+ * Neither the producer nor the consumer may use the ring anymore.
+ *
+ * \param[in]   pRing                       Frame ring.
+ */
+void sbgEComFrameRingDestroy(SbgEComFrameRing *pRing);
+
+/*!
+ * Push a frame, from the producer thread.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pPayload                    Payload.
+ * \param[in]   payloadSize                 Payload size, in bytes.
+ * \return                                  True if the frame has been pushed, false if it has been dropped.
+ */
+bool sbgEComFrameRingPush(SbgEComFrameRing *pRing, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t payloadSize);
+
+/*!
+ * Pop the oldest frame, from the consumer thread.
+ *
+ * The payload refers to the given buffer, unless the frame is larger than the slot size in which
+ * case the payload owns an allocated buffer.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \param[out]  pMsgClass                   Message class.
+ * \param[out]  pMsgId                      Message ID.
+ * \param[out]  pBuffer                     Buffer of at least slotSize bytes.
+ * \param[out]  pPayload                    Payload.
+ * \return                                  SBG_NO_ERROR if a frame has been popped, SBG_NOT_READY if the ring is empty.
+ */
+SbgErrorCode sbgEComFrameRingPop(SbgEComFrameRing *pRing, uint8_t *pMsgClass, uint8_t *pMsgId, void *pBuffer, SbgEComProtocolPayload *pPayload);
+
+/*!
+ * Discard all the frames of the ring, from the consumer thread.
+ *
+ * Discarded frames are counted as popped.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \return                                  Number of frames discarded.
+ */
+size_t sbgEComFrameRingDiscard(SbgEComFrameRing *pRing);
+
+/*!
+ * Check if the ring is empty.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \return                                  True if the ring is empty.
+ */
+bool sbgEComFrameRingIsEmpty(const SbgEComFrameRing *pRing);
+
+/*!
+ * Get the frame ring statistics, from any thread.
+ *
+ * \param[in]   pRing                       Frame ring.
+ * \param[out]  pStats                      Statistics.
+ */
+void sbgEComFrameRingGetStats(const SbgEComFrameRing *pRing, SbgEComFrameRingStats *pStats);
+
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SBG_ECOM_FRAME_RING_H
@@ -1,4 +1,18 @@
-﻿// sbgCommonLib headers
+﻿// Standard headers
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SBG_ECOM_PROTOCOL_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SBG_ECOM_PROTOCOL_USE_NEON
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SBG_ECOM_PROTOCOL_USE_AVX2
+#endif
+
+// sbgCommonLib headers
 #include <sbgCommon.h>
 #include <crc/sbgCrc.h>
 #include <interfaces/sbgInterface.h>
@@ -20,6 +34,47 @@
 //- Private functions                                                  -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Default allocation function for large transfer buffers.
+ *
+ * \param[in]   size                        Buffer size, in bytes.
+ * \param[in]   pUserArg                    Unused.
+ * \return                                  Allocated buffer, NULL if the allocation failed.
+ */
+static void *sbgEComProtocolDefaultAlloc(size_t size, void *pUserArg)
+{
+    SBG_UNUSED_PARAMETER(pUserArg);
+
+    return malloc(size);
+}
+
+/*!
+ * Default release function for large transfer buffers.
+ *
+ * \param[in]   pBuffer                     Buffer.
+ * \param[in]   pUserArg                    Unused.
+ */
+static void sbgEComProtocolDefaultFree(void *pBuffer, void *pUserArg)
+{
+    SBG_UNUSED_PARAMETER(pUserArg);
+
+    free(pBuffer);
+}
+
+/*!
+ * Get the default allocator.
+ *
+ * \param[out]  pAllocator                  Allocator.
+ */
+static void sbgEComProtocolGetDefaultAllocator(SbgEComProtocolAllocator *pAllocator)
+{
+    assert(pAllocator);
+
+    pAllocator->pAllocFunc  = sbgEComProtocolDefaultAlloc;
+    pAllocator->pFreeFunc   = sbgEComProtocolDefaultFree;
+    pAllocator->pUserArg    = NULL;
+}
+
 /*!
  * Clear the content of a payload.
  *
@@ -33,7 +88,7 @@ static void sbgEComProtocolPayloadClear(SbgEComProtocolPayload *pPayload)
 
     if (pPayload->allocated)
     {
-        free(pPayload->pBuffer);
+        pPayload->allocator.pFreeFunc(pPayload->pBuffer, pPayload->allocator.pUserArg);
 
         pPayload->allocated = false;
     }
@@ -46,20 +101,169 @@ static void sbgEComProtocolPayloadClear(SbgEComProtocolPayload *pPayload)
  * Set the properties of a payload.
  *
  * \param[in]   pPayload                    Payload.
- * \param[in]   allocated                   True if the given buffer is allocated with malloc().
+ * \param[in]   pAllocator                  Allocator of the buffer if allocated, used to move the buffer otherwise.
+ * \param[in]   allocated                   True if the given buffer is allocated with the given allocator.
  * \param[in]   pBuffer                     Buffer.
  * \param[in]   size                        Buffer size, in bytes.
  */
-static void sbgEComProtocolPayloadSet(SbgEComProtocolPayload *pPayload, bool allocated, void *pBuffer, size_t size)
+static void sbgEComProtocolPayloadSet(SbgEComProtocolPayload *pPayload, const SbgEComProtocolAllocator *pAllocator, bool allocated, void *pBuffer, size_t size)
 {
     assert(pPayload);
+    assert(pAllocator);
     assert(pBuffer);
 
+    pPayload->allocator = *pAllocator;
     pPayload->allocated = allocated;
     pPayload->pBuffer   = pBuffer;
     pPayload->size      = size;
 }
 
+/*!
+ * Get the index in the work buffer of a protocol of the byte at the given offset.
+ *
+ * Offsets are relative to the first valid byte of the work buffer.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Offset, in bytes.
+ * \return                                  Index in the work buffer.
+ */
+static size_t sbgEComProtocolGetRxIndex(const SbgEComProtocol *pProtocol, size_t offset)
+{
+    size_t                               index;
+
+    assert(pProtocol);
+    assert(offset <= pProtocol->rxBufferCapacity);
+
+    //
+    // A conditional subtraction is used rather than a mask so that any buffer capacity is supported.
+    //
+    index = pProtocol->rxBufferStart + offset;
+
+    if (index >= pProtocol->rxBufferCapacity)
+    {
+        index -= pProtocol->rxBufferCapacity;
+    }
+
+    return index;
+}
+
+/*!
+ * Get the byte at the given offset in the work buffer of a protocol.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Offset, in bytes.
+ * \return                                  Byte value.
+ */
+static uint8_t sbgEComProtocolGetRxByte(const SbgEComProtocol *pProtocol, size_t offset)
+{
+    assert(pProtocol);
+    assert(offset < pProtocol->rxBufferSize);
+
+    return pProtocol->pRxBuffer[sbgEComProtocolGetRxIndex(pProtocol, offset)];
+}
+
+/*!
+ * Copy bytes from the work buffer of a protocol.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Offset of the first byte to copy, in bytes.
+ * \param[out]  pBuffer                     Destination buffer.
+ * \param[in]   size                        Number of bytes to copy.
+ */
+static void sbgEComProtocolCopyRxBytes(const SbgEComProtocol *pProtocol, size_t offset, void *pBuffer, size_t size)
+{
+    size_t                               index;
+    size_t                               firstSize;
+
+    assert(pProtocol);
+    assert(pBuffer);
+    assert((offset + size) <= pProtocol->rxBufferSize);
+
+    index       = sbgEComProtocolGetRxIndex(pProtocol, offset);
+    firstSize   = sbgMin(size, pProtocol->rxBufferCapacity - index);
+
+    memcpy(pBuffer, &pProtocol->pRxBuffer[index], firstSize);
+    memcpy((uint8_t *)pBuffer + firstSize, pProtocol->pRxBuffer, size - firstSize);
+}
+
+/*!
+ * Compute the CRC of bytes in the work buffer of a protocol.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Offset of the first byte, in bytes.
+ * \param[in]   size                        Number of bytes.
+ * \return                                  CRC value.
+ */
+static uint16_t sbgEComProtocolComputeRxCrc(const SbgEComProtocol *pProtocol, size_t offset, size_t size)
+{
+    SbgCrc16                             crc;
+    size_t                               index;
+    size_t                               firstSize;
+
+    assert(pProtocol);
+    assert((offset + size) <= pProtocol->rxBufferSize);
+
+    index       = sbgEComProtocolGetRxIndex(pProtocol, offset);
+    firstSize   = sbgMin(size, pProtocol->rxBufferCapacity - index);
+
+    sbgCrc16Initialize(&crc);
+    sbgCrc16Update(&crc, &pProtocol->pRxBuffer[index], firstSize);
+    sbgCrc16Update(&crc, pProtocol->pRxBuffer, size - firstSize);
+
+    return sbgCrc16Get(&crc);
+}
+
+/*!
+ * Get a contiguous view on bytes in the work buffer of a protocol.
+ *
+ * In ring mode, bytes spanning the wrap point are copied to the wrap buffer, which is
+ * valid until the next call to this function.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Offset of the first byte, in bytes.
+ * \param[in]   size                        Number of bytes.
+ * \return                                  Pointer to the first byte.
+ */
+static uint8_t *sbgEComProtocolGetRxView(SbgEComProtocol *pProtocol, size_t offset, size_t size)
+{
+    uint8_t                             *pView;
+    size_t                               index;
+
+    assert(pProtocol);
+    assert((offset + size) <= pProtocol->rxBufferSize);
+
+    index = sbgEComProtocolGetRxIndex(pProtocol, offset);
+
+    if ((index + size) <= pProtocol->rxBufferCapacity)
+    {
+        pView = &pProtocol->pRxBuffer[index];
+    }
+    else
+    {
+        assert(pProtocol->rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING);
+        assert(pProtocol->pRxWrapBuffer);
+
+        sbgEComProtocolCopyRxBytes(pProtocol, offset, pProtocol->pRxWrapBuffer, size);
+        pView = pProtocol->pRxWrapBuffer;
+    }
+
+    return pView;
+}
+
+/*!
+ * Move the valid bytes of the work buffer of a protocol to its start, in linear mode.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ */
+static void sbgEComProtocolCompactRxBuffer(SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+    assert(pProtocol->rxMode == SBG_ECOM_PROTOCOL_RX_MODE_LINEAR);
+
+    memmove(pProtocol->pRxBuffer, &pProtocol->pRxBuffer[pProtocol->rxBufferStart], pProtocol->rxBufferSize);
+    pProtocol->rxBufferStart = 0;
+}
+
 /*!
  * Discard unused bytes from the work buffer of a protocol.
  *
@@ -73,35 +277,237 @@ static void sbgEComProtocolDiscardUnusedBytes(SbgEComProtocol *pProtocol)
     {
         assert(pProtocol->discardSize <= pProtocol->rxBufferSize);
 
-        memmove(pProtocol->rxBuffer, &pProtocol->rxBuffer[pProtocol->discardSize], pProtocol->rxBufferSize - pProtocol->discardSize);
-
+        pProtocol->rxBufferStart = sbgEComProtocolGetRxIndex(pProtocol, pProtocol->discardSize);
         pProtocol->rxBufferSize -= pProtocol->discardSize;
         pProtocol->discardSize  = 0;
+
+        //
+        // Restart from the beginning of the buffer when empty to limit the number of frames spanning the wrap point.
+        //
+        if (pProtocol->rxBufferSize == 0)
+        {
+            pProtocol->rxBufferStart = 0;
+        }
+        else if ((pProtocol->rxMode == SBG_ECOM_PROTOCOL_RX_MODE_LINEAR) && ((pProtocol->rxBufferCapacity - pProtocol->rxBufferStart) < SBG_ECOM_MAX_BUFFER_SIZE))
+        {
+            //
+            // In linear mode, the remaining bytes are only moved once a whole frame can't fit after the first one,
+            // so that fewer than SBG_ECOM_MAX_BUFFER_SIZE bytes are moved whatever the buffer capacity
+            //
+            sbgEComProtocolCompactRxBuffer(pProtocol);
+        }
+    }
+}
+
+/*!
+ * Get the size of the contiguous free space after the last valid byte of the work buffer of a protocol.
+ *
+ * In linear mode, the free space before the first valid byte is only reused once the buffer is compacted.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \return                                  Free size, in bytes.
+ */
+static size_t sbgEComProtocolGetRxFreeSize(const SbgEComProtocol *pProtocol)
+{
+    size_t                               freeSize;
+
+    assert(pProtocol);
+
+    if (pProtocol->rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING)
+    {
+        freeSize = sbgMin(pProtocol->rxBufferCapacity - pProtocol->rxBufferSize, pProtocol->rxBufferCapacity - sbgEComProtocolGetRxIndex(pProtocol, pProtocol->rxBufferSize));
+    }
+    else
+    {
+        freeSize = pProtocol->rxBufferCapacity - pProtocol->rxBufferStart - pProtocol->rxBufferSize;
     }
+
+    return freeSize;
 }
 
 /*!
  * Read data from the underlying interface into the work buffer of a protocol.
  *
+ * Reads are repeated until the interface is drained or the work buffer is full. In ring mode,
+ * the free space spanning the wrap point is filled by two consecutive reads.
+ *
  * \param[in]   pProtocol                   Protocol.
  */
 static void sbgEComProtocolRead(SbgEComProtocol *pProtocol)
 {
     SbgErrorCode                         errorCode;
+    size_t                               freeSize;
 
     assert(pProtocol);
 
-    if (pProtocol->rxBufferSize < sizeof(pProtocol->rxBuffer))
+    freeSize = sbgEComProtocolGetRxFreeSize(pProtocol);
+
+    while (freeSize != 0)
     {
+        size_t                           index;
         size_t                           nrBytesRead;
 
-        errorCode = sbgInterfaceRead(pProtocol->pLinkedInterface, &pProtocol->rxBuffer[pProtocol->rxBufferSize], &nrBytesRead, sizeof(pProtocol->rxBuffer) - pProtocol->rxBufferSize);
+        index = sbgEComProtocolGetRxIndex(pProtocol, pProtocol->rxBufferSize);
+
+        errorCode = sbgInterfaceRead(pProtocol->pLinkedInterface, &pProtocol->pRxBuffer[index], &nrBytesRead, freeSize);
 
         if (errorCode == SBG_NO_ERROR)
         {
-            pProtocol->rxBufferSize += nrBytesRead;
+            pProtocol->rxBufferSize         += nrBytesRead;
+            pProtocol->stats.nrBytesRead    += nrBytesRead;
+        }
+
+        if ((errorCode != SBG_NO_ERROR) || (nrBytesRead == 0))
+        {
+            break;
+        }
+
+        freeSize = sbgEComProtocolGetRxFreeSize(pProtocol);
+    }
+
+    if (freeSize == 0)
+    {
+        pProtocol->stats.nrBufferFullEvents++;
+    }
+}
+
+#if defined(SBG_ECOM_PROTOCOL_USE_SSE2) || defined(SBG_ECOM_PROTOCOL_USE_AVX2)
+/*!
+ * Get the index of the least significant bit set in a non-zero mask.
+ *
+ * \param[in]   mask                        Mask, must not be zero.
+ * \return                                  Index of the least significant bit set.
+ */
+static size_t sbgEComProtocolGetFirstBitSet(uint32_t mask)
+{
+    size_t                               index;
+
+    assert(mask != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+    index = (size_t)__builtin_ctz(mask);
+#else
+    for (index = 0; (mask & 1) == 0; index++)
+    {
+        mask >>= 1;
+    }
+#endif
+
+    return index;
+}
+#endif
+
+/*!
+ * Scan a contiguous buffer for SYNC bytes.
+ *
+ * Both SYNC bytes must be located in the buffer. Blocks of bytes are compared at once
+ * using SSE2, AVX2 or NEON if available at compile time, and the remaining bytes are
+ * scanned with memchr().
+ *
+ * \param[in]   pBuffer                     Buffer.
+ * \param[in]   size                        Buffer size, in bytes.
+ * \return                                  Offset of the first SYNC byte, or size if not found.
+ */
+static size_t sbgEComProtocolScanSyncBytes(const uint8_t *pBuffer, size_t size)
+{
+    const uint8_t                       *pCursor;
+    const uint8_t                       *pEnd;
+    size_t                               offset;
+
+    assert(pBuffer || (size == 0));
+
+    offset = 0;
+
+#if defined(SBG_ECOM_PROTOCOL_USE_AVX2)
+    {
+        const __m256i                    sync1 = _mm256_set1_epi8((char)SBG_ECOM_SYNC_1);
+        const __m256i                    sync2 = _mm256_set1_epi8((char)SBG_ECOM_SYNC_2);
+
+        for (; (offset + 33) <= size; offset += 32)
+        {
+            __m256i                      first;
+            __m256i                      second;
+            uint32_t                     mask;
+
+            first   = _mm256_loadu_si256((const __m256i *)&pBuffer[offset]);
+            second  = _mm256_loadu_si256((const __m256i *)&pBuffer[offset + 1]);
+            mask    = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, sync1), _mm256_cmpeq_epi8(second, sync2)));
+
+            if (mask != 0)
+            {
+                return offset + sbgEComProtocolGetFirstBitSet(mask);
+            }
+        }
+    }
+#endif
+
+#if defined(SBG_ECOM_PROTOCOL_USE_SSE2)
+    {
+        const __m128i                    sync1 = _mm_set1_epi8((char)SBG_ECOM_SYNC_1);
+        const __m128i                    sync2 = _mm_set1_epi8((char)SBG_ECOM_SYNC_2);
+
+        for (; (offset + 17) <= size; offset += 16)
+        {
+            __m128i                      first;
+            __m128i                      second;
+            uint32_t                     mask;
+
+            first   = _mm_loadu_si128((const __m128i *)&pBuffer[offset]);
+            second  = _mm_loadu_si128((const __m128i *)&pBuffer[offset + 1]);
+            mask    = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, sync1), _mm_cmpeq_epi8(second, sync2)));
+
+            if (mask != 0)
+            {
+                return offset + sbgEComProtocolGetFirstBitSet(mask);
+            }
+        }
+    }
+#elif defined(SBG_ECOM_PROTOCOL_USE_NEON)
+    {
+        const uint8x16_t                 sync1 = vdupq_n_u8(SBG_ECOM_SYNC_1);
+        const uint8x16_t                 sync2 = vdupq_n_u8(SBG_ECOM_SYNC_2);
+
+        for (; (offset + 17) <= size; offset += 16)
+        {
+            uint8x16_t                   match;
+
+            match = vandq_u8(vceqq_u8(vld1q_u8(&pBuffer[offset]), sync1), vceqq_u8(vld1q_u8(&pBuffer[offset + 1]), sync2));
+
+            if (vmaxvq_u8(match) != 0)
+            {
+                //
+                // The match is known to be in this block, locate it with the remaining scan.
+                //
+                break;
+            }
+        }
+    }
+#endif
+
+    //
+    // Scan the remaining bytes, only considering first SYNC bytes followed by another byte.
+    //
+    pCursor = &pBuffer[offset];
+    pEnd    = &pBuffer[size];
+
+    while ((pEnd - pCursor) >= 2)
+    {
+        pCursor = memchr(pCursor, SBG_ECOM_SYNC_1, (size_t)(pEnd - pCursor) - 1);
+
+        if (!pCursor)
+        {
+            break;
+        }
+
+        if (pCursor[1] == SBG_ECOM_SYNC_2)
+        {
+            return (size_t)(pCursor - pBuffer);
         }
+
+        pCursor++;
     }
+
+    return size;
 }
 
 /*!
@@ -119,18 +525,43 @@ static void sbgEComProtocolRead(SbgEComProtocol *pProtocol)
 static SbgErrorCode sbgEComProtocolFindSyncBytes(SbgEComProtocol *pProtocol, size_t startOffset, size_t *pOffset)
 {
     SbgErrorCode                         errorCode;
+    size_t                               offset;
 
     assert(pProtocol);
     assert(pOffset);
     assert(pProtocol->rxBufferSize > 0);
 
-    errorCode = SBG_NOT_READY;
+    errorCode   = SBG_NOT_READY;
+    offset      = startOffset;
 
-    for (size_t i = startOffset; i < (pProtocol->rxBufferSize - 1); i++)
+    //
+    // The work buffer is scanned in contiguous spans, which are two at most in ring mode.
+    //
+    while ((offset + 1) < pProtocol->rxBufferSize)
     {
-        if ((pProtocol->rxBuffer[i] == SBG_ECOM_SYNC_1) && (pProtocol->rxBuffer[i + 1] == SBG_ECOM_SYNC_2))
+        size_t                           index;
+        size_t                           spanSize;
+        size_t                           syncOffset;
+
+        index       = sbgEComProtocolGetRxIndex(pProtocol, offset);
+        spanSize    = sbgMin(pProtocol->rxBufferSize - offset, pProtocol->rxBufferCapacity - index);
+        syncOffset  = sbgEComProtocolScanSyncBytes(&pProtocol->pRxBuffer[index], spanSize);
+
+        if (syncOffset < spanSize)
         {
-            *pOffset    = i;
+            *pOffset    = offset + syncOffset;
+            errorCode   = SBG_NO_ERROR;
+            break;
+        }
+
+        offset += spanSize;
+
+        //
+        // Check SYNC bytes spanning the wrap point.
+        //
+        if ((offset < pProtocol->rxBufferSize) && (sbgEComProtocolGetRxByte(pProtocol, offset - 1) == SBG_ECOM_SYNC_1) && (sbgEComProtocolGetRxByte(pProtocol, offset) == SBG_ECOM_SYNC_2))
+        {
+            *pOffset    = offset - 1;
             errorCode   = SBG_NO_ERROR;
             break;
         }
@@ -140,7 +571,7 @@ static SbgErrorCode sbgEComProtocolFindSyncBytes(SbgEComProtocol *pProtocol, siz
     // The SYNC bytes were not found, but check if the last byte in the work buffer is the first SYNC byte,
     // as it could result from receiving a partial frame.
     //
-    if ((errorCode != SBG_NO_ERROR) && (pProtocol->rxBuffer[pProtocol->rxBufferSize - 1] == SBG_ECOM_SYNC_1))
+    if ((errorCode != SBG_NO_ERROR) && (sbgEComProtocolGetRxByte(pProtocol, pProtocol->rxBufferSize - 1) == SBG_ECOM_SYNC_1))
     {
         *pOffset    = pProtocol->rxBufferSize - 1;
         errorCode   = SBG_NOT_CONTINUOUS_FRAME;
@@ -149,11 +580,56 @@ static SbgErrorCode sbgEComProtocolFindSyncBytes(SbgEComProtocol *pProtocol, siz
     return errorCode;
 }
 
+/*!
+ * Check if the time spent waiting for the end of an incomplete frame is acceptable.
+ *
+ * The incomplete frame is considered the same as on the previous receive attempt if it's
+ * located at the beginning of the work buffer, as all preceding bytes are discarded.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   offset                      Incomplete frame offset in the protocol work buffer.
+ * \return                                  True if the incomplete frame may still be waited for.
+ */
+static bool sbgEComProtocolCheckPendingFrame(SbgEComProtocol *pProtocol, size_t offset)
+{
+    bool                                 waitFrame = true;
+
+    assert(pProtocol);
+
+    if (pProtocol->resyncConfig.maxPendingTime != 0)
+    {
+        uint32_t                         now;
+
+        now = sbgGetTime();
+
+        if (pProtocol->pendingFrame && (offset == 0))
+        {
+            if ((now - pProtocol->pendingFrameTimeStamp) >= pProtocol->resyncConfig.maxPendingTime)
+            {
+                SBG_LOG_ERROR(SBG_TIME_OUT, "incomplete frame dropped after %" PRIu32 " ms", now - pProtocol->pendingFrameTimeStamp);
+                waitFrame = false;
+            }
+        }
+        else
+        {
+            pProtocol->pendingFrameTimeStamp = now;
+        }
+    }
+
+    return waitFrame;
+}
+
 /*!
  * Parse a frame in the work buffer of a protocol.
  *
  * A non-zero number of pages indicates the reception of an extended frame.
  *
+ * The frame header is checked as soon as it's received, so that an invalid header is rejected
+ * without waiting for the number of bytes it announces.
+ *
+ * The frame is checked in place. Only a valid frame spanning the wrap point of the work
+ * buffer in ring mode is copied, in order to return a contiguous frame buffer.
+ *
  * \param[in]   pProtocol                   Protocol.
  * \param[in]   offset                      Frame offset in the protocol work buffer.
  * \param[out]  pEndOffset                  Frame end offset in the protocol work buffer.
@@ -162,20 +638,29 @@ static SbgErrorCode sbgEComProtocolFindSyncBytes(SbgEComProtocol *pProtocol, siz
  * \param[out]  pTransferId                 Transfer ID.
  * \param[out]  pPageIndex                  Page index.
  * \param[out]  pNrPages                    Number of pages.
+ * \param[out]  pFrameBuffer                Frame buffer, including the SYNC bytes and ETX.
  * \param[out]  pBuffer                     Payload buffer.
  * \param[out]  pSize                       Payload buffer size, in bytes.
+ * \param[in]   speculative                 Set to true to check a frame candidate without logging nor counting errors.
  * \return                                  SBG_NO_ERROR if successful,
  *                                          SBG_NOT_READY if the frame is incomplete,
  *                                          SBG_INVALID_FRAME if the frame is invalid,
  *                                          SBG_INVALID_CRC if the frame CRC is invalid.
  */
-static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t offset, size_t *pEndOffset, uint8_t *pMsgClass, uint8_t *pMsgId, uint8_t *pTransferId, uint16_t *pPageIndex, uint16_t *pNrPages, void **pBuffer, size_t *pSize)
+static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t offset, size_t *pEndOffset, uint8_t *pMsgClass, uint8_t *pMsgId, uint8_t *pTransferId, uint16_t *pPageIndex, uint16_t *pNrPages, void **pFrameBuffer, void **pBuffer, size_t *pSize, bool speculative)
 {
     SbgErrorCode                         errorCode;
     SbgStreamBuffer                      streamBuffer;
+    uint8_t                              header[11];
+    size_t                               nrHeaderBytes;
     uint8_t                              msgId;
     uint8_t                              msgClass;
     size_t                               standardPayloadSize;
+    size_t                               headerSize;
+    size_t                               payloadSize;
+    uint8_t                              transferId;
+    uint16_t                             pageIndex;
+    uint16_t                             nrPages;
 
     assert(pProtocol);
     assert(offset < pProtocol->rxBufferSize);
@@ -185,10 +670,17 @@ static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t
     assert(pTransferId);
     assert(pPageIndex);
     assert(pNrPages);
+    assert(pFrameBuffer);
     assert(pBuffer);
     assert(pSize);
 
-    sbgStreamBufferInitForRead(&streamBuffer, &pProtocol->rxBuffer[offset], pProtocol->rxBufferSize - offset);
+    //
+    // Only the standard and extended headers are copied, as they may span the wrap point in ring mode.
+    //
+    nrHeaderBytes = sbgMin(sizeof(header), pProtocol->rxBufferSize - offset);
+
+    sbgEComProtocolCopyRxBytes(pProtocol, offset, header, nrHeaderBytes);
+    sbgStreamBufferInitForRead(&streamBuffer, header, nrHeaderBytes);
 
     //
     // Skip SYNC bytes.
@@ -199,125 +691,162 @@ static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t
     msgClass            = sbgStreamBufferReadUint8(&streamBuffer);
     standardPayloadSize = sbgStreamBufferReadUint16LE(&streamBuffer);
 
-    errorCode = sbgStreamBufferGetLastError(&streamBuffer);
+    if (sbgStreamBufferGetLastError(&streamBuffer) != SBG_NO_ERROR)
+    {
+        return SBG_NOT_READY;
+    }
+
+    transferId  = 0;
+    pageIndex   = 0;
+    nrPages     = 0;
 
-    if (errorCode == SBG_NO_ERROR)
+    //
+    // Check the headers before waiting for the whole frame.
+    //
+    if (standardPayloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE)
     {
-        if (standardPayloadSize <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+        errorCode = SBG_INVALID_FRAME;
+
+        if (!speculative)
         {
-            if (sbgStreamBufferGetSize(&streamBuffer) >= (standardPayloadSize + 9))
-            {
-                size_t                   payloadSize;
-                uint8_t                  transferId;
-                uint16_t                 pageIndex;
-                uint16_t                 nrPages;
+            SBG_LOG_ERROR(errorCode, "invalid payload size %zu", standardPayloadSize);
+            pProtocol->stats.nrHeaderErrors++;
+        }
+    }
+    else if ((msgClass & 0x7f) > pProtocol->resyncConfig.maxMsgClass)
+    {
+        errorCode = SBG_INVALID_FRAME;
 
-                if ((msgClass & 0x80) == 0)
-                {
-                    payloadSize = standardPayloadSize;
+        if (!speculative)
+        {
+            SBG_LOG_ERROR(errorCode, "invalid message class %#" PRIx8, msgClass);
+            pProtocol->stats.nrHeaderErrors++;
+        }
+    }
+    else if ((msgClass & 0x80) == 0)
+    {
+        headerSize  = 6;
+        payloadSize = standardPayloadSize;
 
-                    transferId  = 0;
-                    pageIndex   = 0;
-                    nrPages     = 0;
+        errorCode = SBG_NO_ERROR;
+    }
+    else if (standardPayloadSize >= 5)
+    {
+        msgClass &= 0x7f;
 
-                    errorCode = SBG_NO_ERROR;
-                }
-                else
+        //
+        // In extended frames, the payload size includes the extended headers.
+        //
+        headerSize  = 11;
+        payloadSize = standardPayloadSize - 5;
+
+        transferId  = sbgStreamBufferReadUint8(&streamBuffer);
+        pageIndex   = sbgStreamBufferReadUint16LE(&streamBuffer);
+        nrPages     = sbgStreamBufferReadUint16LE(&streamBuffer);
+
+        if (sbgStreamBufferGetLastError(&streamBuffer) != SBG_NO_ERROR)
+        {
+            errorCode = SBG_NOT_READY;
+        }
+        else if (pageIndex < nrPages)
+        {
+            if ((transferId & 0xf0) != 0)
+            {
+                if (!speculative)
                 {
-                    msgClass &= 0x7f;
+                    SBG_LOG_WARNING(SBG_INVALID_FRAME, "reserved bits set in extended headers");
+                }
 
-                    //
-                    // In extended frames, the payload size includes the extended headers.
-                    //
-                    payloadSize = standardPayloadSize - 5;
+                transferId &= 0xf;
+            }
 
-                    transferId  = sbgStreamBufferReadUint8(&streamBuffer);
-                    pageIndex   = sbgStreamBufferReadUint16LE(&streamBuffer);
-                    nrPages     = sbgStreamBufferReadUint16LE(&streamBuffer);
+            errorCode = SBG_NO_ERROR;
+        }
+        else
+        {
+            errorCode = SBG_INVALID_FRAME;
 
-                    if ((transferId & 0xf0) != 0)
-                    {
-                        SBG_LOG_WARNING(SBG_INVALID_FRAME, "reserved bits set in extended headers");
-                        transferId &= 0xf;
-                    }
+            if (!speculative)
+            {
+                SBG_LOG_ERROR(errorCode, "invalid page information : %" PRIu16 "/%" PRIu16, pageIndex, nrPages);
+                pProtocol->stats.nrHeaderErrors++;
+            }
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_FRAME;
 
-                    if (pageIndex < nrPages)
-                    {
-                        errorCode = SBG_NO_ERROR;
-                    }
-                    else
-                    {
-                        errorCode = SBG_INVALID_FRAME;
-                        SBG_LOG_ERROR(errorCode, "invalid page information : %" PRIu16 "/%" PRIu16, pageIndex, nrPages);
-                    }
-                }
+        if (!speculative)
+        {
+            SBG_LOG_ERROR(errorCode, "invalid extended frame payload size %zu", standardPayloadSize);
+            pProtocol->stats.nrHeaderErrors++;
+        }
+    }
 
-                if (errorCode == SBG_NO_ERROR)
-                {
-                    void                *pPayloadAddr;
-                    uint16_t             frameCrc;
-                    uint8_t              lastByte;
+    if (errorCode == SBG_NO_ERROR)
+    {
+        if ((pProtocol->rxBufferSize - offset) >= (standardPayloadSize + 9))
+        {
+            uint16_t                     frameCrc;
+            uint8_t                      lastByte;
 
-                    pPayloadAddr = sbgStreamBufferGetCursor(&streamBuffer);
+            frameCrc    = sbgEComProtocolGetRxByte(pProtocol, offset + standardPayloadSize + 6);
+            frameCrc   |= (uint16_t)sbgEComProtocolGetRxByte(pProtocol, offset + standardPayloadSize + 7) << 8;
+            lastByte    = sbgEComProtocolGetRxByte(pProtocol, offset + standardPayloadSize + 8);
 
-                    sbgStreamBufferSeek(&streamBuffer, payloadSize, SB_SEEK_CUR_INC);
+            if (lastByte == SBG_ECOM_ETX)
+            {
+                uint16_t                 computedCrc;
 
-                    frameCrc    = sbgStreamBufferReadUint16LE(&streamBuffer);
-                    lastByte    = sbgStreamBufferReadUint8(&streamBuffer);
+                //
+                // The CRC spans from the header (excluding the SYNC bytes) up to the CRC bytes.
+                //
+                computedCrc = sbgEComProtocolComputeRxCrc(pProtocol, offset + 2, standardPayloadSize + 4);
 
-                    assert(sbgStreamBufferGetLastError(&streamBuffer) == SBG_NO_ERROR);
+                if (frameCrc == computedCrc)
+                {
+                    uint8_t             *pFrame;
+
+                    pFrame = sbgEComProtocolGetRxView(pProtocol, offset, standardPayloadSize + 9);
+
+                    *pEndOffset     = offset + standardPayloadSize + 9;
+                    *pMsgClass      = msgClass;
+                    *pMsgId         = msgId;
+                    *pTransferId    = transferId;
+                    *pPageIndex     = pageIndex;
+                    *pNrPages       = nrPages;
+                    *pFrameBuffer   = pFrame;
+                    *pBuffer        = &pFrame[headerSize];
+                    *pSize          = payloadSize;
+                }
+                else
+                {
+                    errorCode = SBG_INVALID_CRC;
 
-                    if (lastByte == SBG_ECOM_ETX)
-                    {
-                        uint16_t         computedCrc;
-
-                        //
-                        // The CRC spans from the header (excluding the SYNC bytes) up to the CRC bytes.
-                        //
-                        sbgStreamBufferSeek(&streamBuffer, 2, SB_SEEK_SET);
-                        computedCrc = sbgCrc16Compute(sbgStreamBufferGetCursor(&streamBuffer), standardPayloadSize + 4);
-
-                        if (frameCrc == computedCrc)
-                        {
-                            *pEndOffset     = offset + standardPayloadSize + 9;
-                            *pMsgClass      = msgClass;
-                            *pMsgId         = msgId;
-                            *pTransferId    = transferId;
-                            *pPageIndex     = pageIndex;
-                            *pNrPages       = nrPages;
-                            *pBuffer        = pPayloadAddr;
-                            *pSize          = payloadSize;
-
-                            errorCode = SBG_NO_ERROR;
-                        }
-                        else
-                        {
-                            errorCode = SBG_INVALID_CRC;
-                            SBG_LOG_ERROR(errorCode, "invalid CRC, frame:%#" PRIx16 " computed:%#" PRIx16, frameCrc, computedCrc);
-                        }
-                    }
-                    else
+                    if (!speculative)
                     {
-                        errorCode = SBG_INVALID_FRAME;
-                        SBG_LOG_ERROR(errorCode, "invalid end-of-frame: byte:%#" PRIx8, lastByte);
+                        SBG_LOG_ERROR(errorCode, "invalid CRC, frame:%#" PRIx16 " computed:%#" PRIx16, frameCrc, computedCrc);
+                        pProtocol->stats.nrCrcErrors++;
                     }
                 }
             }
             else
             {
-                errorCode = SBG_NOT_READY;
+                errorCode = SBG_INVALID_FRAME;
+
+                if (!speculative)
+                {
+                    SBG_LOG_ERROR(errorCode, "invalid end-of-frame: byte:%#" PRIx8, lastByte);
+                    pProtocol->stats.nrEtxErrors++;
+                }
             }
         }
         else
         {
-            errorCode = SBG_INVALID_FRAME;
-            SBG_LOG_ERROR(errorCode, "invalid payload size %zu", standardPayloadSize);
+            errorCode = SBG_NOT_READY;
         }
     }
-    else
-    {
-        errorCode = SBG_NOT_READY;
-    }
 
     return errorCode;
 }
@@ -325,9 +854,18 @@ static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t
 /*!
  * Find a frame in the work buffer of a protocol.
  *
+ * The search starts after the bytes already marked for discard, so that consecutive calls
+ * return consecutive frames.
+ *
+ * When an incomplete frame is found, the search may continue with the following SYNC bytes
+ * according to the resynchronization configuration. If a complete frame is found, the
+ * incomplete one is considered invalid and skipped, as a valid frame can't start inside
+ * another one.
+ *
  * If an extended frame is received, the number of pages is set to a non-zero value.
  *
  * \param[in]   pProtocol                   Protocol.
+ * \param[out]  pOffset                     Frame offset in the protocol work buffer.
  * \param[out]  pMsgClass                   Message class.
  * \param[out]  pMsgId                      Message ID.
  * \param[out]  pTransferId                 Transfer ID.
@@ -338,15 +876,22 @@ static SbgErrorCode sbgEComProtocolParseFrame(SbgEComProtocol *pProtocol, size_t
  * \return                                  SBG_NO_ERROR if successful,
  *                                          SBG_NOT_READY if no frame was found.
  */
-static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t *pMsgClass, uint8_t *pMsgId, uint8_t *pTransferId, uint16_t *pPageIndex, uint16_t *pNrPages, void **pBuffer, size_t *pSize)
+static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, size_t *pOffset, uint8_t *pMsgClass, uint8_t *pMsgId, uint8_t *pTransferId, uint16_t *pPageIndex, uint16_t *pNrPages, void **pBuffer, size_t *pSize)
 {
     SbgErrorCode                         errorCode;
+    size_t                               initialDiscardSize;
     size_t                               startOffset;
+    size_t                               frameSize;
+    bool                                 pendingFrame;
 
     assert(pProtocol);
+    assert(pOffset);
 
-    errorCode   = SBG_NOT_READY;
-    startOffset = 0;
+    errorCode           = SBG_NOT_READY;
+    initialDiscardSize  = pProtocol->discardSize;
+    startOffset         = pProtocol->discardSize;
+    frameSize           = 0;
+    pendingFrame        = false;
 
     while (startOffset < pProtocol->rxBufferSize)
     {
@@ -357,17 +902,36 @@ static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t
         if (errorCode == SBG_NO_ERROR)
         {
             size_t                       endOffset;
+            void                        *pFrameBuffer;
 
-            errorCode = sbgEComProtocolParseFrame(pProtocol, offset, &endOffset, pMsgClass, pMsgId, pTransferId, pPageIndex, pNrPages, pBuffer, pSize);
+            errorCode = sbgEComProtocolParseFrame(pProtocol, offset, &endOffset, pMsgClass, pMsgId, pTransferId, pPageIndex, pNrPages, &pFrameBuffer, pBuffer, pSize, pendingFrame);
 
             if (errorCode == SBG_NO_ERROR)
             {
+                if (pendingFrame)
+                {
+                    SBG_LOG_ERROR(SBG_INVALID_FRAME, "incomplete frame skipped");
+                    pProtocol->stats.nrResyncs++;
+                    pendingFrame = false;
+                }
+
                 //
                 // Valid frame found, discard all data up to and including that frame
                 // on the next read.
                 //
-                pProtocol->discardSize = endOffset;
-                
+                pProtocol->discardSize  = endOffset;
+                *pOffset                = offset;
+                frameSize               = endOffset - offset;
+
+                if ((*pMsgClass < SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES) && (*pMsgId < SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS))
+                {
+                    pProtocol->stats.nrFrames[*pMsgClass][*pMsgId]++;
+                }
+                else
+                {
+                    pProtocol->stats.nrOtherFrames++;
+                }
+
                 //
                 // If installed, call the method used to intercept received sbgECom frames
                 //
@@ -375,7 +939,7 @@ static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t
                 {
                     SbgStreamBuffer     fullFrameStream;
 
-                    sbgStreamBufferInitForRead(&fullFrameStream, &pProtocol->rxBuffer[offset], endOffset-offset);
+                    sbgStreamBufferInitForRead(&fullFrameStream, pFrameBuffer, endOffset-offset);
                     pProtocol->pReceiveFrameCb(pProtocol, *pMsgClass, *pMsgId, &fullFrameStream, pProtocol->pUserArg);
                 }
 
@@ -383,18 +947,50 @@ static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t
             }
             else if (errorCode == SBG_NOT_READY)
             {
-                //
-                // There may be a valid frame at the parse offset, but it's not complete.
-                // Have all preceding bytes discarded on the next read.
-                //
-                pProtocol->discardSize = offset;
-                break;
+                errorCode = SBG_NOT_READY;
+
+                if (pendingFrame)
+                {
+                    //
+                    // Another incomplete frame, keep looking ahead.
+                    //
+                    startOffset = offset + 2;
+                }
+                else if (sbgEComProtocolCheckPendingFrame(pProtocol, offset))
+                {
+                    //
+                    // There may be a valid frame at the parse offset, but it's not complete.
+                    // Have all preceding bytes discarded on the next read.
+                    //
+                    pProtocol->discardSize  = offset;
+                    pendingFrame            = true;
+
+                    if (!pProtocol->resyncConfig.lookAhead)
+                    {
+                        break;
+                    }
+
+                    startOffset = offset + 2;
+                }
+                else
+                {
+                    //
+                    // The frame has been waited for too long, skip SYNC bytes and try again.
+                    //
+                    pProtocol->stats.nrResyncs++;
+                    startOffset = offset + 2;
+                }
             }
             else
             {
                 //
                 // Not a valid frame, skip SYNC bytes and try again.
                 //
+                if (!pendingFrame)
+                {
+                    pProtocol->stats.nrResyncs++;
+                }
+
                 startOffset = offset + 2;
                 errorCode = SBG_NOT_READY;
             }
@@ -406,22 +1002,119 @@ static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t
             // frame, so keep the SYNC byte but have all preceding bytes discarded
             // on the next read.
             //
-            pProtocol->discardSize = offset;
+            if (!pendingFrame)
+            {
+                pProtocol->discardSize = offset;
+            }
+
             errorCode = SBG_NOT_READY;
             break;
         }
         else
         {
             //
-            // No SYNC byte found, discard all data.
+            // No SYNC byte found, discard all data on the next read.
             //
-            pProtocol->rxBufferSize = 0;
+            if (!pendingFrame)
+            {
+                pProtocol->discardSize = pProtocol->rxBufferSize;
+            }
+
             errorCode = SBG_NOT_READY;
             break;
         }
     }
 
+    //
+    // The SYNC bytes of the last candidate may be the last bytes of the work buffer.
+    //
+    if ((errorCode == SBG_NOT_READY) && !pendingFrame && (startOffset >= pProtocol->rxBufferSize))
+    {
+        pProtocol->discardSize = pProtocol->rxBufferSize;
+    }
+
+    pProtocol->pendingFrame = pendingFrame;
+
     assert(pProtocol->discardSize <= pProtocol->rxBufferSize);
+    assert((pProtocol->discardSize - initialDiscardSize) >= frameSize);
+
+    pProtocol->stats.nrBytesDiscarded += pProtocol->discardSize - initialDiscardSize - frameSize;
+
+    return errorCode;
+}
+
+/*!
+ * Write a frame to the interface of a protocol.
+ *
+ * The CRC is computed incrementally over the headers and the payload. If the interface supports
+ * scatter-gather writes, the headers, payload and trailer are written without copying the payload.
+ * Otherwise, the frame is assembled in a local buffer and written at once.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[in]   pHeader                     Frame headers, including the SYNC bytes.
+ * \param[in]   headerSize                  Frame headers size, in bytes.
+ * \param[in]   pData                       Data buffer.
+ * \param[in]   size                        Data buffer size, in bytes.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComProtocolWriteFrame(SbgEComProtocol *pProtocol, const uint8_t *pHeader, size_t headerSize, const void *pData, size_t size)
+{
+    SbgErrorCode                         errorCode;
+    SbgCrc16                             crc;
+    uint16_t                             crcValue;
+    uint8_t                              trailer[3];
+
+    assert(pProtocol);
+    assert(pHeader);
+    assert(headerSize > 2);
+    assert((headerSize + size + sizeof(trailer)) <= SBG_ECOM_MAX_BUFFER_SIZE);
+    assert(pData || (size == 0));
+
+    //
+    // The CRC spans from the header (excluding the SYNC bytes) up to the CRC bytes.
+    //
+    sbgCrc16Initialize(&crc);
+    sbgCrc16Update(&crc, &pHeader[2], headerSize - 2);
+
+    if (size != 0)
+    {
+        sbgCrc16Update(&crc, pData, size);
+    }
+
+    crcValue = sbgCrc16Get(&crc);
+
+    trailer[0] = (uint8_t)crcValue;
+    trailer[1] = (uint8_t)(crcValue >> 8);
+    trailer[2] = SBG_ECOM_ETX;
+
+    if (pProtocol->pLinkedInterface->pWriteVFunc)
+    {
+        SbgInterfaceIoVec                ioVecs[3];
+
+        ioVecs[0].pBuffer   = pHeader;
+        ioVecs[0].size      = headerSize;
+        ioVecs[1].pBuffer   = pData;
+        ioVecs[1].size      = size;
+        ioVecs[2].pBuffer   = trailer;
+        ioVecs[2].size      = sizeof(trailer);
+
+        errorCode = sbgInterfaceWriteV(pProtocol->pLinkedInterface, ioVecs, SBG_ARRAY_SIZE(ioVecs));
+    }
+    else
+    {
+        uint8_t                          buffer[SBG_ECOM_MAX_BUFFER_SIZE];
+        SbgStreamBuffer                  streamBuffer;
+
+        sbgStreamBufferInitForWrite(&streamBuffer, buffer, sizeof(buffer));
+
+        sbgStreamBufferWriteBuffer(&streamBuffer, pHeader, headerSize);
+        sbgStreamBufferWriteBuffer(&streamBuffer, pData, size);
+        sbgStreamBufferWriteBuffer(&streamBuffer, trailer, sizeof(trailer));
+
+        assert(sbgStreamBufferGetLastError(&streamBuffer) == SBG_NO_ERROR);
+
+        errorCode = sbgInterfaceWrite(pProtocol->pLinkedInterface, sbgStreamBufferGetLinkedBuffer(&streamBuffer), sbgStreamBufferGetLength(&streamBuffer));
+    }
 
     return errorCode;
 }
@@ -438,42 +1131,27 @@ static SbgErrorCode sbgEComProtocolFindFrame(SbgEComProtocol *pProtocol, uint8_t
  */
 static SbgErrorCode sbgEComProtocolSendStandardFrame(SbgEComProtocol *pProtocol, uint8_t msgClass, uint8_t msgId, const void *pData, size_t size)
 {
-    uint8_t                              buffer[SBG_ECOM_MAX_BUFFER_SIZE];
+    uint8_t                              header[6];
     SbgStreamBuffer                      streamBuffer;
-    const uint8_t                       *crcDataStart;
-    const uint8_t                       *crcDataEnd;
-    uint16_t                             crc;
 
     assert(pProtocol);
     assert((msgClass & 0x80) == 0);
     assert(size <= SBG_ECOM_MAX_PAYLOAD_SIZE);
     assert(pData || (size == 0));
 
-    sbgStreamBufferInitForWrite(&streamBuffer, buffer, sizeof(buffer));
+    sbgStreamBufferInitForWrite(&streamBuffer, header, sizeof(header));
 
     sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_SYNC_1);
     sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_SYNC_2);
 
-    crcDataStart = sbgStreamBufferGetCursor(&streamBuffer);
-
     sbgStreamBufferWriteUint8(&streamBuffer, msgId);
     sbgStreamBufferWriteUint8(&streamBuffer, msgClass);
 
     sbgStreamBufferWriteUint16LE(&streamBuffer, (uint16_t)size);
 
-    sbgStreamBufferWriteBuffer(&streamBuffer, pData, size);
-
-    crcDataEnd = sbgStreamBufferGetCursor(&streamBuffer);
-
-    crc = sbgCrc16Compute(crcDataStart, crcDataEnd - crcDataStart);
-
-    sbgStreamBufferWriteUint16LE(&streamBuffer, crc);
-
-    sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_ETX);
-
     assert(sbgStreamBufferGetLastError(&streamBuffer) == SBG_NO_ERROR);
 
-    return sbgInterfaceWrite(pProtocol->pLinkedInterface, sbgStreamBufferGetLinkedBuffer(&streamBuffer), sbgStreamBufferGetLength(&streamBuffer));
+    return sbgEComProtocolWriteFrame(pProtocol, header, sbgStreamBufferGetLength(&streamBuffer), pData, size);
 }
 
 /*!
@@ -492,11 +1170,8 @@ static SbgErrorCode sbgEComProtocolSendStandardFrame(SbgEComProtocol *pProtocol,
 static SbgErrorCode sbgEComProtocolSendExtendedFrame(SbgEComProtocol *pProtocol, uint8_t msgClass, uint8_t msgId, uint8_t transferId, size_t pageIndex, size_t nrPages, const void *pData, size_t size)
 {
     SbgErrorCode                         errorCode;
-    uint8_t                              buffer[SBG_ECOM_MAX_BUFFER_SIZE];
+    uint8_t                              header[11];
     SbgStreamBuffer                      streamBuffer;
-    const uint8_t                       *crcDataStart;
-    const uint8_t                       *crcDataEnd;
-    uint16_t                             crc;
 
     assert(pProtocol);
     assert((msgClass & 0x80) == 0);
@@ -507,13 +1182,11 @@ static SbgErrorCode sbgEComProtocolSendExtendedFrame(SbgEComProtocol *pProtocol,
     assert(size <= SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE);
     assert(pData || (size == 0));
 
-    sbgStreamBufferInitForWrite(&streamBuffer, buffer, sizeof(buffer));
+    sbgStreamBufferInitForWrite(&streamBuffer, header, sizeof(header));
 
     sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_SYNC_1);
     sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_SYNC_2);
 
-    crcDataStart = sbgStreamBufferGetCursor(&streamBuffer);
-
     sbgStreamBufferWriteUint8(&streamBuffer, msgId);
     sbgStreamBufferWriteUint8(&streamBuffer, 0x80 | msgClass);
 
@@ -526,21 +1199,11 @@ static SbgErrorCode sbgEComProtocolSendExtendedFrame(SbgEComProtocol *pProtocol,
     sbgStreamBufferWriteUint16LE(&streamBuffer, (uint16_t)pageIndex);
     sbgStreamBufferWriteUint16LE(&streamBuffer, (uint16_t)nrPages);
 
-    sbgStreamBufferWriteBuffer(&streamBuffer, pData, size);
-
-    crcDataEnd = sbgStreamBufferGetCursor(&streamBuffer);
-
-    crc = sbgCrc16Compute(crcDataStart, crcDataEnd - crcDataStart);
-
-    sbgStreamBufferWriteUint16LE(&streamBuffer, crc);
-
-    sbgStreamBufferWriteUint8(&streamBuffer, SBG_ECOM_ETX);
-
     assert(sbgStreamBufferGetLastError(&streamBuffer) == SBG_NO_ERROR);
 
     for (;;)
     {
-        errorCode = sbgInterfaceWrite(pProtocol->pLinkedInterface, sbgStreamBufferGetLinkedBuffer(&streamBuffer), sbgStreamBufferGetLength(&streamBuffer));
+        errorCode = sbgEComProtocolWriteFrame(pProtocol, header, sbgStreamBufferGetLength(&streamBuffer), pData, size);
 
         if (errorCode != SBG_BUFFER_OVERFLOW)
         {
@@ -612,11 +1275,30 @@ static void sbgEComProtocolClearLargeTransfer(SbgEComProtocol *pProtocol)
 {
     assert(pProtocol);
 
-    free(pProtocol->pLargeBuffer);
+    if (pProtocol->pLargeBuffer)
+    {
+        pProtocol->allocator.pFreeFunc(pProtocol->pLargeBuffer, pProtocol->allocator.pUserArg);
+    }
 
     sbgEComProtocolResetLargeTransfer(pProtocol);
 }
 
+/*!
+ * Abort the large transfer in progress.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ */
+static void sbgEComProtocolAbortLargeTransfer(SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+
+    SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
+
+    pProtocol->stats.nrLargeTransferAborts++;
+
+    sbgEComProtocolClearLargeTransfer(pProtocol);
+}
+
 /*!
  * Process an extended frame.
  *
@@ -648,14 +1330,12 @@ static SbgErrorCode sbgEComProtocolProcessExtendedFrame(SbgEComProtocol *pProtoc
         if (sbgEComProtocolLargeTransferInProgress(pProtocol))
         {
             SBG_LOG_ERROR(SBG_ERROR, "large transfer started while a large transfer is in progress");
-            SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
-
-            sbgEComProtocolClearLargeTransfer(pProtocol);
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
         }
 
         capacity = nrPages * SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE;
 
-        pProtocol->pLargeBuffer = malloc(capacity);
+        pProtocol->pLargeBuffer = pProtocol->allocator.pAllocFunc(capacity, pProtocol->allocator.pUserArg);
 
         if (pProtocol->pLargeBuffer)
         {
@@ -672,6 +1352,8 @@ static SbgErrorCode sbgEComProtocolProcessExtendedFrame(SbgEComProtocol *pProtoc
         {
             SBG_LOG_ERROR(SBG_MALLOC_FAILED, "unable to allocate buffer");
 
+            pProtocol->stats.nrLargeTransferAborts++;
+
             sbgEComProtocolResetLargeTransfer(pProtocol);
 
             errorCode = SBG_NOT_READY;
@@ -693,92 +1375,157 @@ static SbgErrorCode sbgEComProtocolProcessExtendedFrame(SbgEComProtocol *pProtoc
 
     if (errorCode == SBG_NO_ERROR)
     {
-        if (msgClass == pProtocol->msgClass)
-        {
-            errorCode = SBG_NO_ERROR;
-        }
-        else
+        //
+        // Only the first mismatch aborts the large transfer.
+        //
+        if (msgClass != pProtocol->msgClass)
         {
             SBG_LOG_ERROR(SBG_ERROR, "message class mismatch in extended frame");
-            SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
-
-            sbgEComProtocolClearLargeTransfer(pProtocol);
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
 
             errorCode = SBG_NOT_READY;
         }
-
-        if (msgId == pProtocol->msgId)
-        {
-            errorCode = SBG_NO_ERROR;
-        }
-        else
+        else if (msgId != pProtocol->msgId)
         {
             SBG_LOG_ERROR(SBG_ERROR, "message ID mismatch in extended frame");
-            SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
 
-            sbgEComProtocolClearLargeTransfer(pProtocol);
+            errorCode = SBG_NOT_READY;
+        }
+        else if (transferId != pProtocol->transferId)
+        {
+            SBG_LOG_ERROR(SBG_ERROR, "transfer ID mismatch in extended frame");
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
 
             errorCode = SBG_NOT_READY;
         }
+        else if (nrPages != pProtocol->nrPages)
+        {
+            SBG_LOG_ERROR(SBG_ERROR, "page count mismatch in extended frame");
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
 
-        if (transferId == pProtocol->transferId)
+            errorCode = SBG_NOT_READY;
+        }
+        else if (pageIndex != pProtocol->pageIndex)
         {
-            errorCode = SBG_NO_ERROR;
+            SBG_LOG_ERROR(SBG_ERROR, "extended frame received out of sequence");
+            sbgEComProtocolAbortLargeTransfer(pProtocol);
+
+            errorCode = SBG_NOT_READY;
         }
         else
         {
-            SBG_LOG_ERROR(SBG_ERROR, "transfer ID mismatch in extended frame");
-            SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
+            size_t                       offset;
+
+            offset = pageIndex * SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE;
+            memcpy(&pProtocol->pLargeBuffer[offset], pBuffer, size);
+
+            pProtocol->largeBufferSize += size;
+            pProtocol->pageIndex++;
+
+            if (pProtocol->pageIndex != pProtocol->nrPages)
+            {
+                errorCode = SBG_NOT_READY;
+            }
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Extract the next frame from the work buffer of a protocol.
+ *
+ * Extended frames are accumulated until a large transfer is complete. In that case, the returned
+ * buffer is allocated and its ownership is passed to the caller.
+ *
+ * All the pages of a large transfer found in the work buffer are consumed at once, so that
+ * SBG_NOT_READY is only returned once the work buffer holds no more complete frame, and callers
+ * may wait for new data.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ * \param[out]  pOffset                     Frame offset in the protocol work buffer.
+ * \param[out]  pMsgClass                   Message class.
+ * \param[out]  pMsgId                      Message ID.
+ * \param[out]  pBuffer                     Payload buffer.
+ * \param[out]  pSize                       Payload buffer size, in bytes.
+ * \param[out]  pAllocated                  True if the payload buffer is allocated with the protocol allocator.
+ * \return                                  SBG_NO_ERROR if successful,
+ *                                          SBG_NOT_READY if no complete frame or large transfer was found.
+ */
+static SbgErrorCode sbgEComProtocolExtractFrame(SbgEComProtocol *pProtocol, size_t *pOffset, uint8_t *pMsgClass, uint8_t *pMsgId, void **pBuffer, size_t *pSize, bool *pAllocated)
+{
+    SbgErrorCode                         errorCode;
+    uint8_t                              transferId = 0;
+    uint16_t                             pageIndex = 0;
+    uint16_t                             nrPages = 0;
+    bool                                 pageConsumed;
+
+    assert(pProtocol);
+    assert(pBuffer);
+    assert(pSize);
+    assert(pAllocated);
 
-            sbgEComProtocolClearLargeTransfer(pProtocol);
+    do
+    {
+        pageConsumed = false;
 
-            errorCode = SBG_NOT_READY;
-        }
+        errorCode = sbgEComProtocolFindFrame(pProtocol, pOffset, pMsgClass, pMsgId, &transferId, &pageIndex, &nrPages, pBuffer, pSize);
 
         if (errorCode == SBG_NO_ERROR)
         {
-            if (nrPages == pProtocol->nrPages)
+            if (nrPages == 0)
             {
-                if (pageIndex == pProtocol->pageIndex)
+                if (sbgEComProtocolLargeTransferInProgress(pProtocol))
                 {
-                    size_t               offset;
-
-                    offset = pageIndex * SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE;
-                    memcpy(&pProtocol->pLargeBuffer[offset], pBuffer, size);
-
-                    pProtocol->largeBufferSize += size;
-                    pProtocol->pageIndex++;
-
-                    if (pProtocol->pageIndex != pProtocol->nrPages)
-                    {
-                        errorCode = SBG_NOT_READY;
-                    }
+                    SBG_LOG_ERROR(SBG_ERROR, "standard frame received while a large transfer is in progress");
+                    sbgEComProtocolAbortLargeTransfer(pProtocol);
                 }
-                else
-                {
-                    SBG_LOG_ERROR(SBG_ERROR, "extended frame received out of sequence");
-                    SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
 
-                    sbgEComProtocolClearLargeTransfer(pProtocol);
-
-                    errorCode = SBG_NOT_READY;
-                }
+                *pAllocated = false;
             }
             else
             {
-                SBG_LOG_ERROR(SBG_ERROR, "page count mismatch in extended frame");
-                SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
+                errorCode = sbgEComProtocolProcessExtendedFrame(pProtocol, *pMsgClass, *pMsgId, transferId, pageIndex, nrPages, *pBuffer, *pSize);
 
-                sbgEComProtocolClearLargeTransfer(pProtocol);
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    *pBuffer    = pProtocol->pLargeBuffer;
+                    *pSize      = pProtocol->largeBufferSize;
+                    *pAllocated = true;
 
-                errorCode = SBG_NOT_READY;
+                    sbgEComProtocolResetLargeTransfer(pProtocol);
+                }
+                else if (errorCode == SBG_NOT_READY)
+                {
+                    //
+                    // The page has been consumed without completing a transfer, try the next frame
+                    //
+                    pageConsumed = true;
+                }
             }
         }
-    }
+    } while (pageConsumed);
 
     return errorCode;
 }
 
+/*!
+ * Release the large transfer buffer returned by the last batch reception, if any.
+ *
+ * \param[in]   pProtocol                   Protocol.
+ */
+static void sbgEComProtocolReleaseBatchLargeBuffer(SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+
+    if (pProtocol->pBatchLargeBuffer)
+    {
+        pProtocol->allocator.pFreeFunc(pProtocol->pBatchLargeBuffer, pProtocol->allocator.pUserArg);
+        pProtocol->pBatchLargeBuffer = NULL;
+    }
+}
+
 //----------------------------------------------------------------------//
 //- Public methods (SbgEComProtocolPayload)                            -//
 //----------------------------------------------------------------------//
@@ -787,6 +1534,8 @@ void sbgEComProtocolPayloadConstruct(SbgEComProtocolPayload *pPayload)
 {
     assert(pPayload);
 
+    sbgEComProtocolGetDefaultAllocator(&pPayload->allocator);
+
     pPayload->allocated = false;
     pPayload->pBuffer   = NULL;
     pPayload->size      = 0;
@@ -798,7 +1547,7 @@ void sbgEComProtocolPayloadDestroy(SbgEComProtocolPayload *pPayload)
 
     if (pPayload->allocated)
     {
-        free(pPayload->pBuffer);
+        pPayload->allocator.pFreeFunc(pPayload->pBuffer, pPayload->allocator.pUserArg);
     }
 }
 
@@ -824,7 +1573,7 @@ void *sbgEComProtocolPayloadMoveBuffer(SbgEComProtocolPayload *pPayload)
 
     if (pPayload->pBuffer)
     {
-        if (pPayload->allocated)
+        if (pPayload->allocated && (pPayload->allocator.pFreeFunc == sbgEComProtocolDefaultFree))
         {
             pBuffer = pPayload->pBuffer;
 
@@ -838,6 +1587,7 @@ void *sbgEComProtocolPayloadMoveBuffer(SbgEComProtocolPayload *pPayload)
             {
                 memcpy(pBuffer, pPayload->pBuffer, pPayload->size);
 
+                sbgEComProtocolPayloadClear(pPayload);
                 sbgEComProtocolPayloadConstruct(pPayload);
             }
             else
@@ -854,6 +1604,48 @@ void *sbgEComProtocolPayloadMoveBuffer(SbgEComProtocolPayload *pPayload)
     return pBuffer;
 }
 
+void *sbgEComProtocolPayloadMoveBufferWithAllocator(SbgEComProtocolPayload *pPayload, SbgEComProtocolAllocator *pAllocator)
+{
+    void                                *pBuffer;
+
+    assert(pPayload);
+    assert(pAllocator);
+
+    if (pPayload->pBuffer)
+    {
+        if (pPayload->allocated)
+        {
+            pBuffer = pPayload->pBuffer;
+        }
+        else
+        {
+            pBuffer = pPayload->allocator.pAllocFunc(pPayload->size, pPayload->allocator.pUserArg);
+
+            if (pBuffer)
+            {
+                memcpy(pBuffer, pPayload->pBuffer, pPayload->size);
+            }
+            else
+            {
+                SBG_LOG_ERROR(SBG_MALLOC_FAILED, "unable to allocate buffer");
+            }
+        }
+
+        if (pBuffer)
+        {
+            *pAllocator = pPayload->allocator;
+
+            sbgEComProtocolPayloadConstruct(pPayload);
+        }
+    }
+    else
+    {
+        pBuffer = NULL;
+    }
+
+    return pBuffer;
+}
+
 //----------------------------------------------------------------------//
 //- Public methods (SbgEComProtocol)                                   -//
 //----------------------------------------------------------------------//
@@ -866,26 +1658,216 @@ SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pProtocol, SbgInterface *pInte
     memset(pProtocol, 0x00, sizeof(*pProtocol));
 
     pProtocol->pLinkedInterface = pInterface;
+    pProtocol->pRxBuffer        = pProtocol->rxBuffer;
+    pProtocol->rxBufferCapacity = sizeof(pProtocol->rxBuffer);
+
+    sbgEComProtocolGetDefaultAllocator(&pProtocol->allocator);
+
+    pProtocol->resyncConfig.maxPendingTime  = 0;
+    pProtocol->resyncConfig.lookAhead       = false;
+    pProtocol->resyncConfig.maxMsgClass     = 0x7f;
 
     sbgEComProtocolResetLargeTransfer(pProtocol);
 
     return SBG_NO_ERROR;
 }
 
+SbgErrorCode sbgEComProtocolInitWithRxBuffer(SbgEComProtocol *pProtocol, SbgInterface *pInterface, void *pRxBuffer, size_t rxBufferSize)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pProtocol);
+    assert(pInterface);
+
+    errorCode = sbgEComProtocolInit(pProtocol, pInterface);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        if (rxBufferSize >= SBG_ECOM_MAX_BUFFER_SIZE)
+        {
+            if (pRxBuffer)
+            {
+                pProtocol->pRxBuffer            = pRxBuffer;
+                pProtocol->rxBufferAllocated    = false;
+            }
+            else
+            {
+                pProtocol->pRxBuffer            = malloc(rxBufferSize);
+                pProtocol->rxBufferAllocated    = true;
+            }
+
+            if (pProtocol->pRxBuffer)
+            {
+                pProtocol->rxBufferCapacity = rxBufferSize;
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+                SBG_LOG_ERROR(errorCode, "unable to allocate buffer");
+
+                sbgEComProtocolInit(pProtocol, pInterface);
+            }
+        }
+        else
+        {
+            errorCode = SBG_INVALID_PARAMETER;
+            SBG_LOG_ERROR(errorCode, "reception buffer too small: %zu", rxBufferSize);
+        }
+    }
+
+    return errorCode;
+}
+
 SbgErrorCode sbgEComProtocolClose(SbgEComProtocol *pProtocol)
 {
     assert(pProtocol);
 
     pProtocol->pLinkedInterface = NULL;
+    pProtocol->rxBufferStart    = 0;
     pProtocol->rxBufferSize     = 0;
     pProtocol->discardSize      = 0;
     pProtocol->nextLargeTxId    = 0;
+    pProtocol->rxMode           = SBG_ECOM_PROTOCOL_RX_MODE_LINEAR;
+    pProtocol->pendingFrame     = false;
+
+    free(pProtocol->pRxWrapBuffer);
+    pProtocol->pRxWrapBuffer    = NULL;
+
+    if (pProtocol->rxBufferAllocated)
+    {
+        free(pProtocol->pRxBuffer);
+    }
+
+    pProtocol->pRxBuffer            = pProtocol->rxBuffer;
+    pProtocol->rxBufferCapacity     = sizeof(pProtocol->rxBuffer);
+    pProtocol->rxBufferAllocated    = false;
 
+    sbgEComProtocolReleaseBatchLargeBuffer(pProtocol);
     sbgEComProtocolClearLargeTransfer(pProtocol);
 
     return SBG_NO_ERROR;
 }
 
+SbgErrorCode sbgEComProtocolSetRxMode(SbgEComProtocol *pProtocol, SbgEComProtocolRxMode rxMode)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+
+    assert(pProtocol);
+
+    if (rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING)
+    {
+        if (!pProtocol->pRxWrapBuffer)
+        {
+            pProtocol->pRxWrapBuffer = malloc(SBG_ECOM_MAX_BUFFER_SIZE);
+
+            if (!pProtocol->pRxWrapBuffer)
+            {
+                errorCode = SBG_MALLOC_FAILED;
+                SBG_LOG_ERROR(errorCode, "unable to allocate buffer");
+            }
+        }
+    }
+    else
+    {
+        assert(rxMode == SBG_ECOM_PROTOCOL_RX_MODE_LINEAR);
+
+        free(pProtocol->pRxWrapBuffer);
+        pProtocol->pRxWrapBuffer = NULL;
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pProtocol->rxMode           = rxMode;
+        pProtocol->rxBufferStart    = 0;
+        pProtocol->rxBufferSize     = 0;
+        pProtocol->discardSize      = 0;
+        pProtocol->pendingFrame     = false;
+    }
+
+    return errorCode;
+}
+
+void sbgEComProtocolSetAllocator(SbgEComProtocol *pProtocol, const SbgEComProtocolAllocator *pAllocator)
+{
+    assert(pProtocol);
+
+    //
+    // Buffers held by the protocol must be released with the previous allocator.
+    //
+    sbgEComProtocolReleaseBatchLargeBuffer(pProtocol);
+    sbgEComProtocolClearLargeTransfer(pProtocol);
+
+    if (pAllocator)
+    {
+        assert(pAllocator->pAllocFunc);
+        assert(pAllocator->pFreeFunc);
+
+        pProtocol->allocator = *pAllocator;
+    }
+    else
+    {
+        sbgEComProtocolGetDefaultAllocator(&pProtocol->allocator);
+    }
+}
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+void sbgEComProtocolSetTxMutex(SbgEComProtocol *pProtocol, SbgMutex *pTxMutex)
+{
+    assert(pProtocol);
+
+    pProtocol->pTxMutex = pTxMutex;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+void sbgEComProtocolSetResyncConfig(SbgEComProtocol *pProtocol, const SbgEComProtocolResyncConfig *pConfig)
+{
+    assert(pProtocol);
+    assert(pConfig);
+
+    pProtocol->resyncConfig = *pConfig;
+    pProtocol->pendingFrame = false;
+}
+
+void sbgEComProtocolGetResyncConfig(const SbgEComProtocol *pProtocol, SbgEComProtocolResyncConfig *pConfig)
+{
+    assert(pProtocol);
+    assert(pConfig);
+
+    *pConfig = pProtocol->resyncConfig;
+}
+
+const SbgEComProtocolStats *sbgEComProtocolGetStats(const SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+
+    return &pProtocol->stats;
+}
+
+void sbgEComProtocolResetStats(SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+
+    memset(&pProtocol->stats, 0x00, sizeof(pProtocol->stats));
+}
+
+uint32_t sbgEComProtocolStatsGetNrFrames(const SbgEComProtocolStats *pStats, uint8_t msgClass, uint8_t msgId)
+{
+    uint32_t                             nrFrames;
+
+    assert(pStats);
+
+    if ((msgClass < SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES) && (msgId < SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS))
+    {
+        nrFrames = pStats->nrFrames[msgClass][msgId];
+    }
+    else
+    {
+        nrFrames = 0;
+    }
+
+    return nrFrames;
+}
+
 SbgErrorCode sbgEComProtocolPurgeIncoming(SbgEComProtocol *pProtocol)
 {
     SbgErrorCode    errorCode = SBG_NO_ERROR;
@@ -895,10 +1877,14 @@ SbgErrorCode sbgEComProtocolPurgeIncoming(SbgEComProtocol *pProtocol)
     //
     // Reset the work buffer
     //
+    pProtocol->rxBufferStart    = 0;
     pProtocol->rxBufferSize     = 0;
     pProtocol->discardSize      = 0;
     pProtocol->nextLargeTxId    = 0;
+    pProtocol->pendingFrame     = false;
+    pProtocol->rxGeneration++;
 
+    sbgEComProtocolReleaseBatchLargeBuffer(pProtocol);
     sbgEComProtocolClearLargeTransfer(pProtocol);
 
     //
@@ -908,7 +1894,7 @@ SbgErrorCode sbgEComProtocolPurgeIncoming(SbgEComProtocol *pProtocol)
 
     do
     {
-        errorCode = sbgInterfaceRead(pProtocol->pLinkedInterface, pProtocol->rxBuffer, &numBytesRead, sizeof(pProtocol->rxBuffer));
+        errorCode = sbgInterfaceRead(pProtocol->pLinkedInterface, pProtocol->pRxBuffer, &numBytesRead, pProtocol->rxBufferCapacity);
 
         if (errorCode != SBG_NO_ERROR)
         {
@@ -933,6 +1919,13 @@ SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pProtocol, uint8_t msgClass, u
 {
     SbgErrorCode                         errorCode;
 
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pProtocol->pTxMutex)
+    {
+        sbgMutexLock(pProtocol->pTxMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
     if (size <= SBG_ECOM_MAX_PAYLOAD_SIZE)
     {
         errorCode = sbgEComProtocolSendStandardFrame(pProtocol, msgClass, msgId, pData, size);
@@ -984,6 +1977,13 @@ SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pProtocol, uint8_t msgClass, u
         }
     }
 
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pProtocol->pTxMutex)
+    {
+        sbgMutexUnlock(pProtocol->pTxMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
     return errorCode;
 }
 
@@ -1032,72 +2032,113 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pProtocol, uint8_t *pMsgCla
 SbgErrorCode sbgEComProtocolReceive2(SbgEComProtocol *pProtocol, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload)
 {
     SbgErrorCode                         errorCode;
+    size_t                               offset;
     uint8_t                              msgClass;
     uint8_t                              msgId;
-    uint8_t                              transferId;
-    uint16_t                             pageIndex;
-    uint16_t                             nrPages;
     void                                *pBuffer;
     size_t                               size;
+    bool                                 allocated;
 
     assert(pProtocol);
     assert(pProtocol->discardSize <= pProtocol->rxBufferSize);
 
     sbgEComProtocolPayloadClear(pPayload);
 
+    pProtocol->rxGeneration++;
+
+    sbgEComProtocolReleaseBatchLargeBuffer(pProtocol);
+
     sbgEComProtocolDiscardUnusedBytes(pProtocol);
 
     sbgEComProtocolRead(pProtocol);
 
-    errorCode = sbgEComProtocolFindFrame(pProtocol, &msgClass, &msgId, &transferId, &pageIndex, &nrPages, &pBuffer, &size);
+    errorCode = sbgEComProtocolExtractFrame(pProtocol, &offset, &msgClass, &msgId, &pBuffer, &size, &allocated);
 
     if (errorCode == SBG_NO_ERROR)
     {
-        if (nrPages == 0)
+        if (pMsgClass)
         {
-            if (sbgEComProtocolLargeTransferInProgress(pProtocol))
-            {
-                SBG_LOG_ERROR(SBG_ERROR, "standard frame received while a large transfer is in progress");
-                SBG_LOG_ERROR(SBG_ERROR, "terminating large transfer");
+            *pMsgClass = msgClass;
+        }
 
-                sbgEComProtocolClearLargeTransfer(pProtocol);
-            }
+        if (pMsgId)
+        {
+            *pMsgId = msgId;
+        }
 
-            if (pMsgClass)
-            {
-                *pMsgClass = msgClass;
-            }
+        sbgEComProtocolPayloadSet(pPayload, &pProtocol->allocator, allocated, pBuffer, size);
+    }
 
-            if (pMsgId)
-            {
-                *pMsgId = msgId;
-            }
+    return errorCode;
+}
 
-            sbgEComProtocolPayloadSet(pPayload, false, pBuffer, size);
-        }
-        else
-        {
-            errorCode = sbgEComProtocolProcessExtendedFrame(pProtocol, msgClass, msgId, transferId, pageIndex, nrPages, pBuffer, size);
+SbgErrorCode sbgEComProtocolReceiveBatch(SbgEComProtocol *pProtocol, SbgEComProtocolFrameDescriptor *pFrames, size_t maxFrames, size_t *pNrFrames)
+{
+    size_t                               nrFrames;
 
-            if (errorCode == SBG_NO_ERROR)
-            {
-                if (pMsgClass)
-                {
-                    *pMsgClass = msgClass;
-                }
+    assert(pProtocol);
+    assert(pProtocol->discardSize <= pProtocol->rxBufferSize);
+    assert(pFrames);
+    assert(maxFrames > 0);
+    assert(pNrFrames);
 
-                if (pMsgId)
-                {
-                    *pMsgId = msgId;
-                }
+    nrFrames = 0;
 
-                sbgEComProtocolPayloadSet(pPayload, true, pProtocol->pLargeBuffer, pProtocol->largeBufferSize);
-                sbgEComProtocolResetLargeTransfer(pProtocol);
-            }
+    pProtocol->rxGeneration++;
+
+    sbgEComProtocolReleaseBatchLargeBuffer(pProtocol);
+
+    sbgEComProtocolDiscardUnusedBytes(pProtocol);
+
+    sbgEComProtocolRead(pProtocol);
+
+    while (nrFrames < maxFrames)
+    {
+        SbgEComProtocolFrameDescriptor  *pFrame;
+        SbgErrorCode                     errorCode;
+        void                            *pBuffer;
+        bool                             allocated;
+
+        pFrame = &pFrames[nrFrames];
+
+        errorCode = sbgEComProtocolExtractFrame(pProtocol, &pFrame->offset, &pFrame->msgClass, &pFrame->msgId, &pBuffer, &pFrame->payloadSize, &allocated);
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            break;
+        }
+
+        pFrame->pPayload = pBuffer;
+        nrFrames++;
+
+        //
+        // The buffer of a completed large transfer is kept until the next receive attempt,
+        // and only one can be held at a time.
+        //
+        if (allocated)
+        {
+            pProtocol->pBatchLargeBuffer = pBuffer;
+            break;
         }
     }
 
-    return errorCode;
+    *pNrFrames = nrFrames;
+
+    if (nrFrames != 0)
+    {
+        return SBG_NO_ERROR;
+    }
+    else
+    {
+        return SBG_NOT_READY;
+    }
+}
+
+size_t sbgEComProtocolGetRxGeneration(const SbgEComProtocol *pProtocol)
+{
+    assert(pProtocol);
+
+    return pProtocol->rxGeneration;
 }
 
 void sbgEComProtocolSetOnFrameReceivedCb(SbgEComProtocol *pProtocol, SbgEComProtocolFrameCb pOnFrameReceivedCb, void *pUserArg)
@@ -60,6 +60,27 @@ extern "C" {
 
 #define SBG_ECOM_RX_TIME_OUT                    (450)                   /*!< Default time out for new frame reception. */
 
+#define SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES  (0x11)                  /*!< Number of message classes with per message frame counters, covers all log and command classes. */
+#define SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS      (64)                    /*!< Number of message IDs with per message frame counters. */
+
+/*!
+ * Receive modes of the protocol work buffer.
+ *
+ * In linear mode, processed bytes are released by advancing the start index, and the work
+ * buffer is compacted by moving the remaining bytes to its start once a whole frame can't
+ * fit after the first of them. With the default buffer size, it is compacted once each
+ * frame has been processed. This mode has the smallest memory footprint.
+ *
+ * In ring mode, the work buffer is used as a ring buffer and processed bytes are released
+ * by advancing the start index, so no bytes are moved. Frames spanning the wrap point are
+ * copied to an additional buffer only when they are returned to the caller.
+ */
+typedef enum _SbgEComProtocolRxMode
+{
+    SBG_ECOM_PROTOCOL_RX_MODE_LINEAR        = 0,                                /*!< Work buffer compacted with memmove() when needed, default mode. */
+    SBG_ECOM_PROTOCOL_RX_MODE_RING          = 1                                 /*!< Work buffer used as a ring buffer. */
+} SbgEComProtocolRxMode;
+
 //----------------------------------------------------------------------//
 //- Callbacks definitions                                              -//
 //----------------------------------------------------------------------//
@@ -83,10 +104,40 @@ typedef struct _SbgEComProtocol SbgEComProtocol;
  */
 typedef void (*SbgEComProtocolFrameCb)(SbgEComProtocol *pProtocol, uint8_t msgClass, uint8_t msgId, SbgStreamBuffer *pReceivedFrame, void *pUserArg);
 
+/*!
+ * Function called to allocate a buffer for a large transfer.
+ *
+ * \param[in]   size                                    Buffer size, in bytes.
+ * \param[in]   pUserArg                                Optional user supplied argument.
+ * \return                                              Allocated buffer, NULL if the allocation failed.
+ */
+typedef void *(*SbgEComProtocolAllocFunc)(size_t size, void *pUserArg);
+
+/*!
+ * Function called to release a buffer allocated for a large transfer.
+ *
+ * \param[in]   pBuffer                                 Buffer, never NULL.
+ * \param[in]   pUserArg                                Optional user supplied argument.
+ */
+typedef void (*SbgEComProtocolFreeFunc)(void *pBuffer, void *pUserArg);
+
 //----------------------------------------------------------------------//
 //- Structure definitions                                              -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Allocator used for large transfer buffers.
+ *
+ * The default allocator uses malloc() and free(). A custom allocator, e.g. based on a pool of
+ * preallocated buffers, avoids any heap use when large transfers are received repeatedly.
+ */
+typedef struct _SbgEComProtocolAllocator
+{
+    SbgEComProtocolAllocFunc             pAllocFunc;                                /*!< Allocation function. */
+    SbgEComProtocolFreeFunc              pFreeFunc;                                 /*!< Release function. */
+    void                                *pUserArg;                                  /*!< Optional user supplied argument for the allocator functions. */
+} SbgEComProtocolAllocator;
+
 /*!
  * Payload.
  *
@@ -95,11 +146,64 @@ typedef void (*SbgEComProtocolFrameCb)(SbgEComProtocol *pProtocol, uint8_t msgCl
  */
 typedef struct _SbgEComProtocolPayload
 {
-    bool                                 allocated;                                 /*!< True if the buffer is allocated with malloc(). */
+    bool                                 allocated;                                 /*!< True if the buffer is allocated with the payload allocator. */
+    SbgEComProtocolAllocator             allocator;                                 /*!< Allocator of the buffer. */
     void                                *pBuffer;                                   /*!< Buffer. */
     size_t                               size;                                      /*!< Buffer size, in bytes. */
 } SbgEComProtocolPayload;
 
+/*!
+ * Descriptor of a frame returned by a batch reception.
+ *
+ * The payload buffer directly refers to the protocol work buffer, or to the buffer of a completed
+ * large transfer. It is only valid until the next attempt to receive a frame.
+ */
+typedef struct _SbgEComProtocolFrameDescriptor
+{
+    uint8_t                              msgClass;                                  /*!< Message class. */
+    uint8_t                              msgId;                                     /*!< Message ID. */
+    const void                          *pPayload;                                  /*!< Payload buffer. */
+    size_t                               payloadSize;                               /*!< Payload buffer size, in bytes. */
+    size_t                               offset;                                    /*!< Offset of the frame in the protocol work buffer, in bytes. */
+} SbgEComProtocolFrameDescriptor;
+
+/*!
+ * Resynchronization configuration.
+ *
+ * These parameters bound the time spent waiting for the end of a frame announced by corrupted
+ * headers, e.g. a false SYNC pair followed by a large payload size.
+ *
+ * Frame headers are always checked as soon as they are received. With look-ahead enabled, the
+ * bytes following an incomplete frame are searched for complete and valid frames. As a valid
+ * frame can't start inside another one, the incomplete frame is skipped if one is found.
+ */
+typedef struct _SbgEComProtocolResyncConfig
+{
+    uint32_t                             maxPendingTime;                            /*!< Maximum time to wait for the end of an incomplete frame, in ms, 0 to wait indefinitely. */
+    bool                                 lookAhead;                                 /*!< Set to true to search for complete frames after an incomplete one, disabled by default. */
+    uint8_t                              maxMsgClass;                               /*!< Highest accepted message class, excluding the extended frame bit. */
+} SbgEComProtocolResyncConfig;
+
+/*!
+ * Protocol statistics.
+ *
+ * Counters are updated by the protocol without any allocation or formatting and wrap around
+ * on overflow. Errors found while looking ahead for frames after an incomplete one are not counted.
+ */
+typedef struct _SbgEComProtocolStats
+{
+    uint64_t                             nrBytesRead;                               /*!< Number of bytes read from the interface. */
+    uint64_t                             nrBytesDiscarded;                          /*!< Number of bytes discarded because not part of a valid frame. */
+    uint32_t                             nrFrames[SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES][SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS]; /*!< Number of valid frames per message class and ID. */
+    uint32_t                             nrOtherFrames;                             /*!< Number of valid frames with a message class or ID out of the per message counters range. */
+    uint32_t                             nrHeaderErrors;                            /*!< Number of frames with invalid headers. */
+    uint32_t                             nrCrcErrors;                               /*!< Number of frames with an invalid CRC. */
+    uint32_t                             nrEtxErrors;                               /*!< Number of frames with an invalid end-of-frame byte. */
+    uint32_t                             nrResyncs;                                 /*!< Number of frame candidates rejected, dropped after a time out or skipped. */
+    uint32_t                             nrLargeTransferAborts;                     /*!< Number of large transfers aborted. */
+    uint32_t                             nrBufferFullEvents;                        /*!< Number of times the work buffer was full after a read. */
+} SbgEComProtocolStats;
+
 /*!
  * Struct containing all protocol related data.
  *
@@ -108,10 +212,29 @@ typedef struct _SbgEComProtocolPayload
 struct _SbgEComProtocol
 {
     SbgInterface                        *pLinkedInterface;                          /*!< Associated interface used by the protocol to read/write bytes. */
-    uint8_t                              rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];        /*!< The reception buffer. */
+    uint8_t                              rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];        /*!< The default reception buffer. */
+    uint8_t                             *pRxBuffer;                                 /*!< The reception buffer, either the default one or a user-provided or allocated one. */
+    size_t                               rxBufferCapacity;                          /*!< Capacity of the reception buffer, in bytes. */
+    bool                                 rxBufferAllocated;                         /*!< True if the reception buffer is allocated with malloc(). */
+    size_t                               rxBufferStart;                             /*!< Index of the first valid byte in the reception buffer. */
     size_t                               rxBufferSize;                              /*!< The current reception buffer size in bytes. */
     size_t                               discardSize;                               /*!< Number of bytes to discard on the next receive attempt. */
+    SbgEComProtocolRxMode                rxMode;                                    /*!< Receive mode of the reception buffer. */
+    uint8_t                             *pRxWrapBuffer;                             /*!< Buffer used to return frames spanning the wrap point, allocated with malloc() in ring mode. */
+    SbgEComProtocolAllocator             allocator;                                 /*!< Allocator used for large transfer buffers. */
     uint8_t                              nextLargeTxId;                             /*!< Transfer ID of the next large send. */
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    SbgMutex                            *pTxMutex;                                  /*!< Mutex serializing the frames sent by several threads, NULL if unused. */
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    //
+    // Member variables related to resynchronization.
+    //
+    SbgEComProtocolResyncConfig          resyncConfig;                              /*!< Resynchronization configuration. */
+    bool                                 pendingFrame;                              /*!< True if an incomplete frame is waited for at the start of the work buffer. */
+    uint32_t                             pendingFrameTimeStamp;                     /*!< Time at which the incomplete frame was first found, in ms. */
+
+    SbgEComProtocolStats                 stats;                                     /*!< Statistics. */
 
     //
     // Raw stream sbgECom frame reception callback
@@ -122,13 +245,15 @@ struct _SbgEComProtocol
     //
     // Member variables related to large transfer reception.
     //
-    uint8_t                             *pLargeBuffer;                              /*!< Buffer for large transfers, allocated with malloc() if valid. */
+    uint8_t                             *pLargeBuffer;                              /*!< Buffer for large transfers, allocated with the protocol allocator if valid. */
     size_t                               largeBufferSize;                           /*!< Size of the large transfer buffer, in bytes. */
     uint8_t                              msgClass;                                  /*!< Message class for the current large transfer. */
     uint8_t                              msgId;                                     /*!< Message ID for the current large transfer. */
     uint8_t                              transferId;                                /*!< ID of the current large transfer. */
     uint16_t                             pageIndex;                                 /*!< Expected page index of the next frame. */
     uint16_t                             nrPages;                                   /*!< Number of pages in the current transfer. */
+    uint8_t                             *pBatchLargeBuffer;                         /*!< Buffer of a large transfer returned by the last batch reception, allocated with the protocol allocator if valid. */
+    size_t                               rxGeneration;                              /*!< Incremented by each attempt to receive a frame, or purge, invalidating the frames returned before. */
 };
 
 //----------------------------------------------------------------------//
@@ -171,13 +296,31 @@ size_t sbgEComProtocolPayloadGetSize(const SbgEComProtocolPayload *pPayload);
  * If successful, the ownership of the buffer is passed to the caller. Otherwise, the payload
  * is unchanged.
  *
- * The buffer must be released with free() once unused.
+ * The buffer must be released with free() once unused. If the payload buffer was allocated
+ * with a custom allocator, it's copied.
  *
  * \param[in]   pPayload                Payload.
  * \return                              Payload buffer if successful, NULL otherwise.
  */
 void *sbgEComProtocolPayloadMoveBuffer(SbgEComProtocolPayload *pPayload);
 
+/*!
+ * Move the buffer of a payload, along with its allocator.
+ *
+ * If successful, the ownership of the buffer is passed to the caller. Otherwise, the payload
+ * is unchanged.
+ *
+ * The buffer of a large transfer is passed without any copy. Otherwise, the payload is copied
+ * to a buffer allocated with the payload allocator.
+ *
+ * The buffer must be released with the free function of the returned allocator once unused.
+ *
+ * \param[in]   pPayload                Payload.
+ * \param[out]  pAllocator              Allocator of the returned buffer.
+ * \return                              Payload buffer if successful, NULL otherwise.
+ */
+void *sbgEComProtocolPayloadMoveBufferWithAllocator(SbgEComProtocolPayload *pPayload, SbgEComProtocolAllocator *pAllocator);
+
 //----------------------------------------------------------------------//
 //- Public methods (SbgEComProtocol)                                   -//
 //----------------------------------------------------------------------//
@@ -191,6 +334,27 @@ void *sbgEComProtocolPayloadMoveBuffer(SbgEComProtocolPayload *pPayload);
  */
 SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pProtocol, SbgInterface *pInterface);
 
+/*!
+ * Initialize the protocol system with a reception buffer of a custom size.
+ *
+ * A large reception buffer allows draining an interface in a single receive attempt, e.g. after a
+ * burst of UDP datagrams or a long scheduling pause. In linear mode, the remaining bytes are only
+ * moved once a whole frame can't fit before the end of the buffer, so the cost of the compaction
+ * doesn't grow with the buffer size.
+ *
+ * If no buffer is given, a buffer of the requested size is allocated with malloc() and released
+ * when the protocol is closed. Otherwise, the given buffer must remain valid until the protocol is closed.
+ *
+ * \param[in]   pProtocol                       Protocol instance to construct.
+ * \param[in]   pInterface                      Interface to use for read/write operations.
+ * \param[in]   pRxBuffer                       Reception buffer, may be NULL to have it allocated.
+ * \param[in]   rxBufferSize                    Reception buffer size, in bytes, at least SBG_ECOM_MAX_BUFFER_SIZE.
+ * \return                                      SBG_NO_ERROR if we have initialized the protocol system,
+ *                                              SBG_INVALID_PARAMETER if the buffer is too small,
+ *                                              SBG_MALLOC_FAILED if the buffer couldn't be allocated.
+ */
+SbgErrorCode sbgEComProtocolInitWithRxBuffer(SbgEComProtocol *pProtocol, SbgInterface *pInterface, void *pRxBuffer, size_t rxBufferSize);
+
 /*!
  * Close the protocol system.
  *
@@ -199,6 +363,91 @@ SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pProtocol, SbgInterface *pInte
  */
 SbgErrorCode sbgEComProtocolClose(SbgEComProtocol *pProtocol);
 
+/*!
+ * Set the receive mode of the protocol work buffer.
+ *
+ * The linear mode is used by default. The ring mode avoids moving received bytes in the
+ * work buffer after each frame, at the cost of an additional SBG_ECOM_MAX_BUFFER_SIZE bytes
+ * buffer allocated with malloc(). It is recommended with large reception buffers.
+ *
+ * Any data pending in the work buffer is discarded.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[in]   rxMode                          Receive mode.
+ * \return                                      SBG_NO_ERROR if successful,
+ *                                              SBG_MALLOC_FAILED if the ring mode buffer couldn't be allocated.
+ */
+SbgErrorCode sbgEComProtocolSetRxMode(SbgEComProtocol *pProtocol, SbgEComProtocolRxMode rxMode);
+
+/*!
+ * Set the allocator used for large transfer buffers.
+ *
+ * Any large transfer in progress is aborted. Payloads received before this call keep
+ * their allocator.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[in]   pAllocator                      Allocator, NULL to use malloc() and free().
+ */
+void sbgEComProtocolSetAllocator(SbgEComProtocol *pProtocol, const SbgEComProtocolAllocator *pAllocator);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Set the mutex locked while a frame, or all the pages of a large transfer, are sent.
+ *
+ * Required if several threads send frames, so that their frames aren't interleaved.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[in]   pTxMutex                        Mutex, NULL to send frames without locking.
+ */
+void sbgEComProtocolSetTxMutex(SbgEComProtocol *pProtocol, SbgMutex *pTxMutex);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+/*!
+ * Set the resynchronization configuration.
+ *
+ * By default, incomplete frames are waited for indefinitely, look-ahead is disabled and all
+ * message classes are accepted, as without any resynchronization configuration.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[in]   pConfig                         Resynchronization configuration.
+ */
+void sbgEComProtocolSetResyncConfig(SbgEComProtocol *pProtocol, const SbgEComProtocolResyncConfig *pConfig);
+
+/*!
+ * Get the resynchronization configuration.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[out]  pConfig                         Resynchronization configuration.
+ */
+void sbgEComProtocolGetResyncConfig(const SbgEComProtocol *pProtocol, SbgEComProtocolResyncConfig *pConfig);
+
+/*!
+ * Get the protocol statistics.
+ *
+ * The statistics are updated in place, the returned pointer is valid as long as the protocol.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \return                                      Statistics.
+ */
+const SbgEComProtocolStats *sbgEComProtocolGetStats(const SbgEComProtocol *pProtocol);
+
+/*!
+ * Reset the protocol statistics.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ */
+void sbgEComProtocolResetStats(SbgEComProtocol *pProtocol);
+
+/*!
+ * Get the number of valid frames received for a message.
+ *
+ * \param[in]   pStats                          Statistics.
+ * \param[in]   msgClass                        Message class.
+ * \param[in]   msgId                           Message ID.
+ * \return                                      Number of valid frames, 0 if the message is out of the per message counters range.
+ */
+uint32_t sbgEComProtocolStatsGetNrFrames(const SbgEComProtocolStats *pStats, uint8_t msgClass, uint8_t msgId);
+
 /*!
  * Purge the interface rx buffer as well as the sbgECom rx work buffer.
  *
@@ -262,6 +511,41 @@ SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pProtocol, uint8_t *pMsgCla
  */
 SbgErrorCode sbgEComProtocolReceive2(SbgEComProtocol *pProtocol, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload);
 
+/*!
+ * Receive all the frames available in the work buffer at once.
+ *
+ * New data is read from the interface once, then every complete frame found in the work buffer is
+ * described in the given array, in a single pass. The bytes of these frames are only discarded on
+ * the next attempt to receive a frame, so all the payload buffers remain valid until then.
+ *
+ * A completed large transfer ends the batch.
+ *
+ * Any receive or purge call on the protocol while the frames of a batch are processed, e.g. from a
+ * log callback sending a command, discards the frames of the batch and invalidates all their
+ * descriptors. Frames must either be processed without receiving, or the receive generation,
+ * returned by sbgEComProtocolGetRxGeneration(), must be checked before each descriptor is used, and
+ * the remaining descriptors dropped if it has changed.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \param[out]  pFrames                         Array of frame descriptors.
+ * \param[in]   maxFrames                       Number of descriptors in the array, must be greater than 0.
+ * \param[out]  pNrFrames                       Number of frames received.
+ * \return                                      SBG_NO_ERROR if at least one frame has been received,
+ *                                              SBG_NOT_READY if no complete frame has been received.
+ */
+SbgErrorCode sbgEComProtocolReceiveBatch(SbgEComProtocol *pProtocol, SbgEComProtocolFrameDescriptor *pFrames, size_t maxFrames, size_t *pNrFrames);
+
+/*!
+ * Get the receive generation.
+ *
+ * The generation changes on each attempt to receive a frame, and on purge. Frames returned by a
+ * receive function are valid as long as the generation hasn't changed.
+ *
+ * \param[in]   pProtocol                       A valid protocol instance.
+ * \return                                      Receive generation.
+ */
+size_t sbgEComProtocolGetRxGeneration(const SbgEComProtocol *pProtocol);
+
 /*!
  * Define the optional function called each time a valid sbgECom frame is received.
  * 
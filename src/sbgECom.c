@@ -8,167 +8,1706 @@
 #include "sbgECom.h"
 
 //----------------------------------------------------------------------//
-//- Public methods                                                     -//
+//- Private definitions                                                -//
 //----------------------------------------------------------------------//
 
-SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
+/*!
+ * Maximum time the reader thread waits for incoming data, in us, which bounds the time needed to stop it.
+ */
+#define SBG_ECOM_READER_WAIT_TIME_OUT                       (10000)
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Maximum number of threads waiting for a command frame at once.
+ */
+#define SBG_ECOM_CMD_NR_SLOTS                               (8)
+
+/*!
+ * Maximum number of command frames kept while no thread is waiting for them, enough for the answers to a full window of asynchronous commands.
+ */
+#define SBG_ECOM_CMD_MAILBOX_SIZE                           (64)
+
+/*!
+ * Command frame received by the reader thread.
+ */
+typedef struct _SbgEComCmdFrame
 {
-    SbgErrorCode errorCode = SBG_NO_ERROR;
-    
-    assert(pHandle);
-    assert(pInterface);
-    
-    //
-    // Initialize the sbgECom handle
-    //
-    pHandle->pReceiveLogCallback    = NULL;
-    pHandle->pUserArg               = NULL;
+    uint8_t                              msgClass;                  /*!< Message class. */
+    uint8_t                              msgId;                     /*!< Message ID. */
+    uint8_t                             *pPayload;                  /*!< Payload, allocated with malloc(), NULL if empty. */
+    size_t                               payloadSize;               /*!< Payload size, in bytes. */
+} SbgEComCmdFrame;
 
-    //
-    // Initialize the default number of trials and time out
-    //
-    pHandle->numTrials          = 3;
-    pHandle->cmdDefaultTimeOut  = SBG_ECOM_DEFAULT_CMD_TIME_OUT;
+/*!
+ * Completion slot of a thread waiting for a command frame.
+ */
+typedef struct _SbgEComCmdSlot
+{
+    bool                                 inUse;                     /*!< True while a thread is waiting. */
+    SbgEComCmdMatch                      match;                     /*!< Frames expected. */
+    uint8_t                              msgClass;                  /*!< Expected message class. */
+    uint8_t                              msgId;                     /*!< Expected message ID. */
+    size_t                               sequence;                  /*!< Registration order, the oldest slot is completed first. */
+    bool                                 completed;                 /*!< True once a frame has been handed over. */
+    SbgEComCmdFrame                      frame;                     /*!< Frame handed over. */
+    SbgCondition                        *pCondition;                /*!< Signaled when the slot is completed. */
+} SbgEComCmdSlot;
 
-    //
-    // Initialize the protocol 
-    //
-    errorCode = sbgEComProtocolInit(&pHandle->protocolHandle, pInterface);
-    
-    return errorCode;
-}
+/*!
+ * Reader thread.
+ */
+struct _SbgEComReader
+{
+    SbgEComProtocol                     *pProtocol;                 /*!< Protocol the frames are read from. */
+    const SbgEComHandle                 *pHandle;                   /*!< Handle whose log subscriptions are applied by the thread. */
+    uint32_t                             nrDroppedLogs;             /*!< Number of logs dropped by the thread because they aren't subscribed, protected by the mutex. */
+    SbgEComFrameRing                     ring;                      /*!< Logs read and not handled yet. */
+    SbgThread                           *pThread;                   /*!< Thread. */
+    volatile size_t                      stopRequested;             /*!< Set to stop the thread. */
+    void                                *pBuffer;                   /*!< Buffer the popped frames are copied into, one slot in size. */
+    SbgMutex                            *pMutex;                    /*!< Mutex of the frame condition, also protecting the log subscriptions. */
+    SbgCondition                        *pFrameCondition;           /*!< Signaled when frames are pushed. */
 
-SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
+    SbgMutex                            *pTxMutex;                  /*!< Mutex serializing the frames sent by the threads issuing commands. */
+    SbgMutex                            *pCmdMutex;                 /*!< Mutex protecting the command slots and mailbox, never held across I/O. */
+    SbgEComCmdSlot                       cmdSlots[SBG_ECOM_CMD_NR_SLOTS];       /*!< Threads waiting for command frames. */
+    SbgEComCmdFrame                      mailbox[SBG_ECOM_CMD_MAILBOX_SIZE];    /*!< Command frames no thread was waiting for, oldest first. */
+    size_t                               nrMailboxFrames;           /*!< Number of frames in the mailbox. */
+    uint32_t                             nrDroppedCmdFrames;        /*!< Number of frames dropped because the mailbox was full. */
+    size_t                               nextSequence;              /*!< Sequence number of the next registered slot. */
+};
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Lock the log subscriptions, read by the reader thread if it is running.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ */
+static void sbgEComLockSubscriptions(const SbgEComHandle *pHandle)
 {
-    SbgErrorCode errorCode = SBG_NO_ERROR;
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        sbgMutexLock(pHandle->pReader->pMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+}
 
+/*!
+ * Unlock the log subscriptions.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ */
+static void sbgEComUnlockSubscriptions(const SbgEComHandle *pHandle)
+{
     assert(pHandle);
 
-    //
-    // Close the protocol
-    //
-    errorCode = sbgEComProtocolClose(&pHandle->protocolHandle);
-    
-    return errorCode;
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        sbgMutexUnlock(pHandle->pReader->pMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
 }
 
-SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle)
+/*!
+ * Set the subscription state of a log.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   msgClass                    Message class, SBG_ECOM_CLASS_LOG_ALL for all classes.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   subscribed                  True to subscribe to the log, false to unsubscribe.
+ */
+static void sbgEComSetLogSubscription(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, bool subscribed)
 {
-    SbgErrorCode        errorCode = SBG_NO_ERROR;
-    SbgEComLogUnion     logData;
-    uint8_t             receivedMsg;
-    uint8_t             receivedMsgClass;
-    size_t              payloadSize;
-    uint8_t             payloadData[SBG_ECOM_MAX_PAYLOAD_SIZE];
+    uint32_t                             mask;
 
     assert(pHandle);
 
-    //
-    // Try to read a received frame
-    //
-    errorCode = sbgEComProtocolReceive(&pHandle->protocolHandle, &receivedMsgClass, &receivedMsg, payloadData, &payloadSize, sizeof(payloadData));
+    mask = 1u << (msgId % 32);
 
-    //
-    // Test if we have received a valid frame
-    //
-    if (errorCode == SBG_NO_ERROR)
+    sbgEComLockSubscriptions(pHandle);
+
+    for (size_t i = 0; i < SBG_ECOM_SUBSCRIPTION_NR_CLASSES; i++)
     {
-        //
-        // Test if the received frame is a binary log
-        //
-        if (sbgEComMsgClassIsALog((SbgEComClass)receivedMsgClass))
+        if ((msgClass == SBG_ECOM_CLASS_LOG_ALL) || ((size_t)msgClass == i))
         {
-            //
-            // The received frame is a binary log one
-            //
-            errorCode = sbgEComLogParse((SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg, payloadData, payloadSize, &logData);
-
-            //
-            // Test if the incoming log has been parsed successfully
-            //
-            if (errorCode == SBG_NO_ERROR)
+            if (subscribed)
             {
-                //
-                // Test if we have a valid callback to handle received logs
-                //
-                if (pHandle->pReceiveLogCallback)
-                {
-                    //
-                    // Call the binary log callback using the new method
-                    //
-                    errorCode = pHandle->pReceiveLogCallback(pHandle, (SbgEComClass)receivedMsgClass, receivedMsg, &logData, pHandle->pUserArg);
-                }
-
-                //
-                // Clean up resources allocated during parsing, if any.
-                //
-                sbgEComLogCleanup(&logData, (SbgEComClass)receivedMsgClass, (SbgEComMsgId)receivedMsg);
+                pHandle->logSubscriptions[i][msgId / 32] |= mask;
             }
             else
             {
-                //
-                // Call the on error callback
-                //
+                pHandle->logSubscriptions[i][msgId / 32] &= ~mask;
             }
         }
-        else
+    }
+
+    sbgEComUnlockSubscriptions(pHandle);
+
+    if ((msgClass != SBG_ECOM_CLASS_LOG_ALL) && ((size_t)msgClass >= SBG_ECOM_SUBSCRIPTION_NR_CLASSES))
+    {
+        SBG_LOG_WARNING(SBG_INVALID_PARAMETER, "class %#x can't be filtered", msgClass);
+    }
+}
+
+/*!
+ * Get the head of the callback chain a log callback belongs to.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   pLogCallback                Log callback.
+ * \return                                  Head of the callback chain.
+ */
+static uint8_t *sbgEComGetLogCallbackChain(SbgEComHandle *pHandle, const SbgEComLogCallback *pLogCallback)
+{
+    uint8_t                             *pHead;
+
+    assert(pHandle);
+    assert(pLogCallback);
+
+    if (!pLogCallback->allIds && (pLogCallback->msgClass < SBG_ECOM_SUBSCRIPTION_NR_CLASSES))
+    {
+        pHead = &pHandle->logCallbackHeads[pLogCallback->msgClass][pLogCallback->msgId];
+    }
+    else
+    {
+        pHead = &pHandle->wildcardLogCallbackHead;
+    }
+
+    return pHead;
+}
+
+/*!
+ * Check if a log callback must be called for a log.
+ *
+ * \param[in]   pLogCallback                Log callback.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \return                                  True if the callback must be called.
+ */
+static bool sbgEComLogCallbackMatches(const SbgEComLogCallback *pLogCallback, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    assert(pLogCallback);
+
+    return ((pLogCallback->msgClass == SBG_ECOM_CLASS_LOG_ALL) || (pLogCallback->msgClass == msgClass)) && (pLogCallback->allIds || (pLogCallback->msgId == msgId));
+}
+
+/*!
+ * Get the ID of a log callback.
+ *
+ * The ID combines the entry index with its generation, so that it is invalidated when the entry is reused.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   index                       Entry index.
+ * \return                                  Callback ID.
+ */
+static size_t sbgEComGetLogCallbackId(const SbgEComHandle *pHandle, size_t index)
+{
+    assert(pHandle);
+    assert(index < SBG_ARRAY_SIZE(pHandle->logCallbacks));
+
+    return ((size_t)pHandle->logCallbacks[index].generation << 8) | index;
+}
+
+/*!
+ * Unlink a log callback from its chain and release its entry.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   index                       Entry index.
+ */
+static void sbgEComReleaseLogCallback(SbgEComHandle *pHandle, size_t index)
+{
+    SbgEComLogCallback                  *pLogCallback;
+    uint8_t                             *pIndex;
+    uint16_t                             generation;
+
+    assert(pHandle);
+    assert(index < SBG_ARRAY_SIZE(pHandle->logCallbacks));
+
+    pLogCallback = &pHandle->logCallbacks[index];
+
+    pIndex = sbgEComGetLogCallbackChain(pHandle, pLogCallback);
+
+    while (*pIndex != index)
+    {
+        assert(*pIndex != SBG_ECOM_LOG_CALLBACK_NONE);
+
+        pIndex = &pHandle->logCallbacks[*pIndex].nextIndex;
+    }
+
+    *pIndex = pLogCallback->nextIndex;
+
+    generation = pLogCallback->generation;
+
+    memset(pLogCallback, 0, sizeof(*pLogCallback));
+
+    pLogCallback->generation = (uint16_t)(generation + 1);
+}
+
+/*!
+ * Release the log callbacks unregistered during a dispatch, once all dispatches are over.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ */
+static void sbgEComReleaseRemovedLogCallbacks(SbgEComHandle *pHandle)
+{
+    assert(pHandle);
+
+    if ((pHandle->logCallbackDepth == 0) && pHandle->logCallbackRemoved)
+    {
+        for (size_t i = 0; i < SBG_ARRAY_SIZE(pHandle->logCallbacks); i++)
+        {
+            if (pHandle->logCallbacks[i].removed)
+            {
+                sbgEComReleaseLogCallback(pHandle, i);
+            }
+        }
+
+        pHandle->logCallbackRemoved = false;
+    }
+}
+
+/*!
+ * Register a log callback.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   msgClass                    Message class, SBG_ECOM_CLASS_LOG_ALL for all classes.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   allIds                      True to call the callback for all message IDs.
+ * \param[in]   pCallback                   Callback.
+ * \param[in]   pUserArg                    Optional user argument passed to the callback.
+ * \param[out]  pCallbackId                 Callback ID, may be NULL.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComAddLogCallbackEntry(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, bool allIds, SbgEComReceiveLogFunc pCallback, void *pUserArg, size_t *pCallbackId)
+{
+    SbgErrorCode                         errorCode = SBG_BUFFER_OVERFLOW;
+
+    assert(pHandle);
+    assert(pCallback);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pHandle->logCallbacks); i++)
+    {
+        SbgEComLogCallback              *pLogCallback = &pHandle->logCallbacks[i];
+
+        if (!pLogCallback->pCallback)
         {
+            uint8_t                     *pIndex;
+
+            pLogCallback->pCallback     = pCallback;
+            pLogCallback->pUserArg      = pUserArg;
+            pLogCallback->msgClass      = (uint8_t)msgClass;
+            pLogCallback->msgId         = allIds ? 0 : msgId;
+            pLogCallback->allIds        = allIds;
+            pLogCallback->nextIndex     = SBG_ECOM_LOG_CALLBACK_NONE;
+
             //
-            // We have received a command, it shouldn't happen
+            // Append the callback to its chain to keep the registration order
             //
+            pIndex = sbgEComGetLogCallbackChain(pHandle, pLogCallback);
+
+            while (*pIndex != SBG_ECOM_LOG_CALLBACK_NONE)
+            {
+                pIndex = &pHandle->logCallbacks[*pIndex].nextIndex;
+            }
+
+            *pIndex = (uint8_t)i;
+
+            if (pCallbackId)
+            {
+                *pCallbackId = sbgEComGetLogCallbackId(pHandle, i);
+            }
+
+            errorCode = SBG_NO_ERROR;
+            break;
         }
     }
-    else if (errorCode != SBG_NOT_READY)
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "too many log callbacks");
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Call the log callbacks of a chain.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   headIndex                   Index of the first callback of the chain.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pLogData                    Decoded log.
+ * \return                                  SBG_NO_ERROR if all callbacks have been successful, the first error otherwise.
+ */
+static SbgErrorCode sbgEComCallLogCallbacks(SbgEComHandle *pHandle, uint8_t headIndex, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    uint8_t                              index;
+
+    assert(pHandle);
+
+    index = headIndex;
+
+    while (index != SBG_ECOM_LOG_CALLBACK_NONE)
     {
+        const SbgEComLogCallback        *pLogCallback = &pHandle->logCallbacks[index];
+
         //
-        // We have received an invalid frame
+        // Entries are only unlinked once all dispatches are over, so the link is still valid after the call
         //
-        SBG_LOG_WARNING(errorCode, "Invalid frame received");
+        if (!pLogCallback->removed && sbgEComLogCallbackMatches(pLogCallback, msgClass, msgId))
+        {
+            SbgErrorCode                 callbackErrorCode;
+
+            callbackErrorCode = pLogCallback->pCallback(pHandle, msgClass, msgId, pLogData, pLogCallback->pUserArg);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = callbackErrorCode;
+            }
+        }
+
+        index = pLogCallback->nextIndex;
     }
-    
+
     return errorCode;
 }
 
-SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle)
+/*!
+ * Get a buffer to decode a log into.
+ *
+ * The handle log buffer is allocated as large as the log union, or only grown to the decoded
+ * structure size with compact log buffers. A temporary buffer is allocated if the handle log
+ * buffer is already used, which happens when logs are handled from a log callback.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   dataSize                    Size of the decoded log structure, in bytes.
+ * \param[out]  ppLogBuffer                 Log buffer.
+ * \param[out]  pLogBufferSize              Log buffer size, in bytes.
+ * \return                                  SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode sbgEComAcquireLogBuffer(SbgEComHandle *pHandle, size_t dataSize, void **ppLogBuffer, size_t *pLogBufferSize)
 {
-    SbgErrorCode        errorCode = SBG_NO_ERROR;
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    size_t                               bufferSize;
 
     assert(pHandle);
+    assert(ppLogBuffer);
+    assert(pLogBufferSize);
 
     //
-    // Try to read all received frames, we thus loop until we get an SBG_NOT_READY error
+    // By default, buffers are as large as the union so that log callbacks may copy it as a whole
     //
-    do
+    if (pHandle->compactLogBuffer)
     {
-        //
-        // Try to read and parse one frame
-        //
-        errorCode = sbgEComHandleOneLog(pHandle);
-    } while (errorCode != SBG_NOT_READY);
-    
+        bufferSize = dataSize;
+    }
+    else
+    {
+        bufferSize = sizeof(SbgEComLogUnion);
+    }
+
+    if (pHandle->logBufferInUse)
+    {
+        *ppLogBuffer        = malloc(bufferSize);
+        *pLogBufferSize     = bufferSize;
+    }
+    else
+    {
+        if ((pHandle->logBufferSize < bufferSize) && (pHandle->logBufferAllocated || !pHandle->pLogBuffer))
+        {
+            void                        *pLogBuffer;
+
+            pLogBuffer = realloc(pHandle->logBufferAllocated ? pHandle->pLogBuffer : NULL, bufferSize);
+
+            if (pLogBuffer)
+            {
+                pHandle->pLogBuffer         = pLogBuffer;
+                pHandle->logBufferSize      = bufferSize;
+                pHandle->logBufferAllocated = true;
+            }
+        }
+
+        *ppLogBuffer        = pHandle->pLogBuffer;
+        *pLogBufferSize     = pHandle->logBufferSize;
+
+        pHandle->logBufferInUse = true;
+    }
+
+    if (!*ppLogBuffer)
+    {
+        errorCode = SBG_MALLOC_FAILED;
+        SBG_LOG_ERROR(errorCode, "unable to allocate log buffer");
+
+        pHandle->logBufferInUse = false;
+    }
+
     return errorCode;
 }
 
-SbgErrorCode sbgEComPurgeIncoming(SbgEComHandle *pHandle)
+/*!
+ * Release a buffer obtained with sbgEComAcquireLogBuffer().
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   pLogBuffer                  Log buffer.
+ */
+static void sbgEComReleaseLogBuffer(SbgEComHandle *pHandle, void *pLogBuffer)
 {
-    SbgErrorCode    errorCode = SBG_NO_ERROR;
+    assert(pHandle);
+    assert(pLogBuffer);
+
+    if (pLogBuffer == pHandle->pLogBuffer)
+    {
+        pHandle->logBufferInUse = false;
+    }
+    else
+    {
+        free(pLogBuffer);
+    }
+}
+
+/*!
+ * Handle a received frame and forward it to the log callbacks if the frame is a binary log.
+ *
+ * \param[in]   pHandle                     A valid sbgECom handle.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pPayload                    Payload buffer.
+ * \param[in]   payloadSize                 Payload size, in bytes.
+ * \return                                  SBG_NO_ERROR if the frame has been handled successfully.
+ */
+static SbgErrorCode sbgEComHandleFrame(SbgEComHandle *pHandle, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t payloadSize)
+{
+    SbgErrorCode        errorCode = SBG_NO_ERROR;
 
     assert(pHandle);
 
-    errorCode = sbgEComProtocolPurgeIncoming(&pHandle->protocolHandle);
+    //
+    // Test if the received frame is a binary log, either built-in or registered by the application
+    //
+    if (sbgEComMsgClassIsALog((SbgEComClass)msgClass) || sbgEComLogGetDecoder((SbgEComClass)msgClass, (SbgEComMsgId)msgId))
+    {
+        errorCode = sbgEComHandleLog(pHandle, (SbgEComClass)msgClass, (SbgEComMsgId)msgId, pPayload, payloadSize);
+    }
+    else
+    {
+        //
+        // We have received a command, it shouldn't happen
+        //
+    }
 
     return errorCode;
 }
 
-void sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceiveLogFunc pReceiveLogCallback, void *pUserArg)
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Check if a command frame matches what a thread is waiting for.
+ *
+ * \param[in]   pFrame                      Command frame.
+ * \param[in]   match                       Frames expected.
+ * \param[in]   msgClass                    Expected message class.
+ * \param[in]   msgId                       Expected message ID.
+ * \return                                  True if the frame matches.
+ */
+static bool sbgEComCmdFrameMatches(const SbgEComCmdFrame *pFrame, SbgEComCmdMatch match, uint8_t msgClass, uint8_t msgId)
 {
-    assert(pHandle);
+    bool                                 matches;
+    bool                                 isAck;
+
+    assert(pFrame);
 
     //
-    // Define the callback and the user argument
+    // An ACK payload starts with the message ID and class of the acknowledged command
     //
-    pHandle->pReceiveLogCallback    = pReceiveLogCallback;
-    pHandle->pUserArg               = pUserArg;
+    isAck = (pFrame->msgClass == SBG_ECOM_CLASS_LOG_CMD_0) && (pFrame->msgId == SBG_ECOM_CMD_ACK) &&
+            (pFrame->payloadSize >= 2) && (pFrame->pPayload[0] == msgId) && (pFrame->pPayload[1] == msgClass);
+
+    switch (match)
+    {
+    case SBG_ECOM_CMD_MATCH_ANY:
+        matches = true;
+        break;
+    case SBG_ECOM_CMD_MATCH_REPLY:
+        matches = isAck || ((pFrame->msgClass == msgClass) && (pFrame->msgId == msgId));
+        break;
+    case SBG_ECOM_CMD_MATCH_ACK:
+        matches = isAck;
+        break;
+    default:
+        matches = false;
+    }
+
+    return matches;
+}
+
+/*!
+ * Find the oldest completion slot waiting for a command frame.
+ *
+ * The command mutex must be locked.
+ *
+ * \param[in]   pReader                     Reader.
+ * \param[in]   pFrame                      Command frame.
+ * \param[in]   matchAny                    True to only search slots waiting for any command frame, false for the others.
+ * \return                                  Slot, NULL if no thread is waiting for the frame.
+ */
+static SbgEComCmdSlot *sbgEComReaderFindCmdSlot(SbgEComReader *pReader, const SbgEComCmdFrame *pFrame, bool matchAny)
+{
+    SbgEComCmdSlot                      *pSlot = NULL;
+
+    assert(pReader);
+    assert(pFrame);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pReader->cmdSlots); i++)
+    {
+        SbgEComCmdSlot                  *pCandidate = &pReader->cmdSlots[i];
+
+        if (pCandidate->inUse && !pCandidate->completed && ((pCandidate->match == SBG_ECOM_CMD_MATCH_ANY) == matchAny) &&
+            sbgEComCmdFrameMatches(pFrame, pCandidate->match, pCandidate->msgClass, pCandidate->msgId))
+        {
+            if (!pSlot || (pCandidate->sequence < pSlot->sequence))
+            {
+                pSlot = pCandidate;
+            }
+        }
+    }
+
+    return pSlot;
+}
+
+/*!
+ * Hand a command frame over to the thread waiting for it, or store it in the mailbox.
+ *
+ * The frame is routed when it arrives: threads waiting for a matching reply or ACK are served first,
+ * then threads waiting for any command frame, each in registration order. The frame is only stored
+ * in the mailbox if no thread is waiting for it.
+ *
+ * When the mailbox is full, its oldest frame is dropped and counted.
+ *
+ * \param[in]   pReader                     Reader.
+ * \param[in]   msgClass                    Message class.
+ * \param[in]   msgId                       Message ID.
+ * \param[in]   pPayload                    Payload.
+ * \param[in]   payloadSize                 Payload size, in bytes.
+ */
+static void sbgEComReaderDispatchCmd(SbgEComReader *pReader, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t payloadSize)
+{
+    SbgEComCmdFrame                      frame;
+
+    assert(pReader);
+
+    frame.msgClass      = msgClass;
+    frame.msgId         = msgId;
+    frame.payloadSize   = payloadSize;
+    frame.pPayload      = NULL;
+
+    if (payloadSize != 0)
+    {
+        frame.pPayload = malloc(payloadSize);
+    }
+
+    if (frame.pPayload || (payloadSize == 0))
+    {
+        SbgEComCmdSlot                  *pSlot;
+
+        if (payloadSize != 0)
+        {
+            memcpy(frame.pPayload, pPayload, payloadSize);
+        }
+
+        sbgMutexLock(pReader->pCmdMutex);
+
+        pSlot = sbgEComReaderFindCmdSlot(pReader, &frame, false);
+
+        if (!pSlot)
+        {
+            pSlot = sbgEComReaderFindCmdSlot(pReader, &frame, true);
+        }
+
+        if (pSlot)
+        {
+            pSlot->frame        = frame;
+            pSlot->completed    = true;
+
+            sbgConditionSignal(pSlot->pCondition);
+        }
+        else
+        {
+            if (pReader->nrMailboxFrames == SBG_ARRAY_SIZE(pReader->mailbox))
+            {
+                SBG_LOG_WARNING(SBG_BUFFER_OVERFLOW, "command frame %#"PRIx8":%#"PRIx8" dropped", pReader->mailbox[0].msgClass, pReader->mailbox[0].msgId);
+
+                free(pReader->mailbox[0].pPayload);
+
+                pReader->nrMailboxFrames--;
+                memmove(&pReader->mailbox[0], &pReader->mailbox[1], pReader->nrMailboxFrames * sizeof(pReader->mailbox[0]));
+
+                pReader->nrDroppedCmdFrames++;
+            }
+
+            pReader->mailbox[pReader->nrMailboxFrames] = frame;
+            pReader->nrMailboxFrames++;
+        }
+
+        sbgMutexUnlock(pReader->pCmdMutex);
+    }
+    else
+    {
+        SBG_LOG_ERROR(SBG_MALLOC_FAILED, "unable to allocate command frame %#"PRIx8":%#"PRIx8, msgClass, msgId);
+    }
+}
+
+/*!
+ * Take the oldest matching command frame from the mailbox.
+ *
+ * The command mutex must be locked.
+ *
+ * \param[in]   pReader                     Reader.
+ * \param[in]   match                       Frames expected.
+ * \param[in]   msgClass                    Expected message class.
+ * \param[in]   msgId                       Expected message ID.
+ * \param[out]  pFrame                      Frame taken.
+ * \return                                  SBG_NO_ERROR if a frame has been taken, SBG_NOT_READY otherwise.
+ */
+static SbgErrorCode sbgEComReaderPopMailbox(SbgEComReader *pReader, SbgEComCmdMatch match, uint8_t msgClass, uint8_t msgId, SbgEComCmdFrame *pFrame)
+{
+    SbgErrorCode                         errorCode = SBG_NOT_READY;
+
+    assert(pReader);
+    assert(pFrame);
+
+    for (size_t i = 0; i < pReader->nrMailboxFrames; i++)
+    {
+        if (sbgEComCmdFrameMatches(&pReader->mailbox[i], match, msgClass, msgId))
+        {
+            *pFrame = pReader->mailbox[i];
+
+            pReader->nrMailboxFrames--;
+            memmove(&pReader->mailbox[i], &pReader->mailbox[i + 1], (pReader->nrMailboxFrames - i) * sizeof(pReader->mailbox[0]));
+
+            errorCode = SBG_NO_ERROR;
+            break;
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Register a completion slot and wait until the reader thread hands a command frame over.
+ *
+ * The command mutex must be locked, it is released while waiting.
+ *
+ * \param[in]   pReader                     Reader.
+ * \param[in]   match                       Frames expected.
+ * \param[in]   msgClass                    Expected message class.
+ * \param[in]   msgId                       Expected message ID.
+ * \param[out]  pFrame                      Frame received.
+ * \param[in]   timeOut                     Time-out, in ms.
+ * \return                                  SBG_NO_ERROR if a frame has been received.
+ */
+static SbgErrorCode sbgEComReaderWaitCmd(SbgEComReader *pReader, SbgEComCmdMatch match, uint8_t msgClass, uint8_t msgId, SbgEComCmdFrame *pFrame, uint32_t timeOut)
+{
+    SbgErrorCode                         errorCode = SBG_BUFFER_OVERFLOW;
+
+    assert(pReader);
+    assert(pFrame);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pReader->cmdSlots); i++)
+    {
+        SbgEComCmdSlot                  *pSlot = &pReader->cmdSlots[i];
+
+        if (!pSlot->inUse)
+        {
+            uint32_t                     start;
+
+            pSlot->inUse        = true;
+            pSlot->match        = match;
+            pSlot->msgClass     = msgClass;
+            pSlot->msgId        = msgId;
+            pSlot->sequence     = pReader->nextSequence;
+            pSlot->completed    = false;
+
+            pReader->nextSequence++;
+
+            start = sbgGetTime();
+
+            for (;;)
+            {
+                uint32_t                 elapsed;
+
+                if (pSlot->completed)
+                {
+                    *pFrame     = pSlot->frame;
+                    errorCode   = SBG_NO_ERROR;
+                    break;
+                }
+
+                elapsed = sbgGetTime() - start;
+
+                if (elapsed >= timeOut)
+                {
+                    errorCode = SBG_TIME_OUT;
+                    break;
+                }
+
+                sbgConditionWait(pSlot->pCondition, pReader->pCmdMutex, timeOut - elapsed);
+            }
+
+            pSlot->inUse = false;
+            break;
+        }
+    }
+
+    if (errorCode == SBG_BUFFER_OVERFLOW)
+    {
+        SBG_LOG_ERROR(errorCode, "too many threads waiting for command frames");
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Release the resources of a reader, once its thread is stopped.
+ *
+ * \param[in]   pReader                     Reader.
+ */
+static void sbgEComReaderRelease(SbgEComReader *pReader)
+{
+    assert(pReader);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(pReader->cmdSlots); i++)
+    {
+        if (pReader->cmdSlots[i].pCondition)
+        {
+            sbgConditionDestroy(pReader->cmdSlots[i].pCondition);
+        }
+    }
+
+    for (size_t i = 0; i < pReader->nrMailboxFrames; i++)
+    {
+        free(pReader->mailbox[i].pPayload);
+    }
+
+    if (pReader->pCmdMutex)
+    {
+        sbgMutexDestroy(pReader->pCmdMutex);
+    }
+
+    if (pReader->pTxMutex)
+    {
+        sbgMutexDestroy(pReader->pTxMutex);
+    }
+
+    if (pReader->pFrameCondition)
+    {
+        sbgConditionDestroy(pReader->pFrameCondition);
+    }
+
+    if (pReader->pMutex)
+    {
+        sbgMutexDestroy(pReader->pMutex);
+    }
+
+    free(pReader->pBuffer);
+    sbgEComFrameRingDestroy(&pReader->ring);
+    free(pReader);
+}
+
+/*!
+ * Reader thread entry point.
+ *
+ * \param[in]   pArg                        Reader.
+ */
+static void sbgEComReaderRun(void *pArg)
+{
+    SbgEComReader                       *pReader = pArg;
+    SbgEComProtocolFrameDescriptor       frames[SBG_ECOM_HANDLE_BATCH_SIZE];
+
+    assert(pReader);
+
+    while (sbgAtomicLoad(&pReader->stopRequested) == 0)
+    {
+        SbgErrorCode                     errorCode;
+        size_t                           nrFrames;
+        size_t                           nrLogs = 0;
+        uint32_t                         nrDroppedLogs = 0;
+        bool                             subscribed[SBG_ECOM_HANDLE_BATCH_SIZE];
+
+        errorCode = sbgEComProtocolReceiveBatch(pReader->pProtocol, frames, SBG_ARRAY_SIZE(frames), &nrFrames);
+
+        //
+        // Check the subscriptions of the whole batch at once, logs that aren't subscribed don't reach the ring
+        //
+        if (nrFrames != 0)
+        {
+            sbgMutexLock(pReader->pMutex);
+
+            for (size_t i = 0; i < nrFrames; i++)
+            {
+                subscribed[i] = sbgEComIsLogSubscribed(pReader->pHandle, (SbgEComClass)frames[i].msgClass, (SbgEComMsgId)frames[i].msgId);
+            }
+
+            sbgMutexUnlock(pReader->pMutex);
+        }
+
+        for (size_t i = 0; i < nrFrames; i++)
+        {
+            //
+            // Logs go to the thread handling them, command frames to the threads issuing commands
+            //
+            if (sbgEComMsgClassIsALog((SbgEComClass)frames[i].msgClass) || sbgEComLogGetDecoder((SbgEComClass)frames[i].msgClass, (SbgEComMsgId)frames[i].msgId))
+            {
+                if (subscribed[i])
+                {
+                    sbgEComFrameRingPush(&pReader->ring, frames[i].msgClass, frames[i].msgId, frames[i].pPayload, frames[i].payloadSize);
+                    nrLogs++;
+                }
+                else
+                {
+                    nrDroppedLogs++;
+                }
+            }
+            else
+            {
+                sbgEComReaderDispatchCmd(pReader, frames[i].msgClass, frames[i].msgId, frames[i].pPayload, frames[i].payloadSize);
+            }
+        }
+
+        if ((nrLogs != 0) || (nrDroppedLogs != 0))
+        {
+            //
+            // Lock the mutex so that a consumer can't miss the signal between checking the ring and waiting
+            //
+            sbgMutexLock(pReader->pMutex);
+
+            pReader->nrDroppedLogs += nrDroppedLogs;
+
+            if (nrLogs != 0)
+            {
+                sbgConditionBroadcast(pReader->pFrameCondition);
+            }
+
+            sbgMutexUnlock(pReader->pMutex);
+        }
+
+        if (errorCode == SBG_NOT_READY)
+        {
+            sbgInterfaceWait(pReader->pProtocol->pLinkedInterface, SBG_ECOM_READER_WAIT_TIME_OUT);
+        }
+    }
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
+{
+    SbgErrorCode errorCode = SBG_NO_ERROR;
+    
+    assert(pHandle);
+    assert(pInterface);
+    
+    //
+    // Initialize the sbgECom handle
+    //
+    pHandle->pReceiveLogCallback    = NULL;
+    pHandle->pUserArg               = NULL;
+
+    //
+    // Initialize the default number of trials and time out
+    //
+    pHandle->numTrials          = 3;
+    pHandle->cmdDefaultTimeOut  = SBG_ECOM_DEFAULT_CMD_TIME_OUT;
+
+    //
+    // Subscribe to all logs by default
+    //
+    memset(pHandle->logSubscriptions, 0xff, sizeof(pHandle->logSubscriptions));
+    pHandle->nrDroppedLogs      = 0;
+
+    //
+    // No log callback registered
+    //
+    memset(pHandle->logCallbacks, 0, sizeof(pHandle->logCallbacks));
+    memset(pHandle->logCallbackHeads, SBG_ECOM_LOG_CALLBACK_NONE, sizeof(pHandle->logCallbackHeads));
+    pHandle->wildcardLogCallbackHead    = SBG_ECOM_LOG_CALLBACK_NONE;
+    pHandle->logCallbackDepth           = 0;
+    pHandle->logCallbackRemoved         = false;
+
+    //
+    // The log buffer is allocated on the first decoded log
+    //
+    pHandle->pLogBuffer             = NULL;
+    pHandle->logBufferSize          = 0;
+    pHandle->logBufferAllocated     = false;
+    pHandle->logBufferInUse         = false;
+    pHandle->compactLogBuffer       = false;
+    pHandle->logViews               = false;
+
+    pHandle->nrBatchFrames          = 0;
+    pHandle->batchIndex             = 0;
+    pHandle->batchGeneration        = 0;
+
+    pHandle->pReader                = NULL;
+
+    //
+    // Initialize the protocol 
+    //
+    errorCode = sbgEComProtocolInit(&pHandle->protocolHandle, pInterface);
+    
+    return errorCode;
+}
+
+SbgErrorCode sbgEComInitWithRxBuffer(SbgEComHandle *pHandle, SbgInterface *pInterface, void *pRxBuffer, size_t rxBufferSize)
+{
+    SbgErrorCode errorCode = SBG_NO_ERROR;
+
+    assert(pHandle);
+    assert(pInterface);
+
+    errorCode = sbgEComInit(pHandle, pInterface);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        //
+        // Initialize the protocol again, the default initialization doesn't allocate any resource
+        //
+        errorCode = sbgEComProtocolInitWithRxBuffer(&pHandle->protocolHandle, pInterface, pRxBuffer, rxBufferSize);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
+{
+    SbgErrorCode errorCode = SBG_NO_ERROR;
+
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    sbgEComStopReader(pHandle);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    //
+    // Close the protocol
+    //
+    errorCode = sbgEComProtocolClose(&pHandle->protocolHandle);
+
+    sbgEComSetLogBuffer(pHandle, NULL, 0);
+    
+    return errorCode;
+}
+
+SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComProtocolPayload               payload;
+    uint8_t                              receivedMsg;
+    uint8_t                              receivedMsgClass;
+
+    assert(pHandle);
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    //
+    // Try to read a received frame, the payload directly refers to the protocol work buffer or to the reader buffer
+    //
+    errorCode = sbgEComReceiveFrame(pHandle, &receivedMsgClass, &receivedMsg, &payload);
+
+    //
+    // Test if we have received a valid frame
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComHandleFrame(pHandle, receivedMsgClass, receivedMsg, sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload));
+    }
+    else if (errorCode != SBG_NOT_READY)
+    {
+        //
+        // We have received an invalid frame
+        //
+        SBG_LOG_WARNING(errorCode, "Invalid frame received");
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+    
+    return errorCode;
+}
+
+SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        SbgEComProtocolPayload           payload;
+
+        sbgEComProtocolPayloadConstruct(&payload);
+
+        //
+        // Handle all the frames stored by the reader thread, without waiting for new ones
+        //
+        do
+        {
+            uint8_t                      receivedMsgClass;
+            uint8_t                      receivedMsg;
+
+            errorCode = sbgEComReceiveFrame(pHandle, &receivedMsgClass, &receivedMsg, &payload);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                sbgEComHandleFrame(pHandle, receivedMsgClass, receivedMsg, sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload));
+            }
+        } while (errorCode != SBG_NOT_READY);
+
+        sbgEComProtocolPayloadDestroy(&payload);
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        //
+        // Try to read all received frames, by batches, until we get an SBG_NOT_READY error
+        //
+        // The batch is stored in the handle: frames received while it is dispatched, e.g. by a log
+        // callback sending a command, are taken from the batch first by sbgEComReceiveFrame(), and
+        // a nested call to this function dispatches the remaining frames of the batch.
+        //
+        do
+        {
+            if (pHandle->batchIndex == pHandle->nrBatchFrames)
+            {
+                errorCode = sbgEComProtocolReceiveBatch(&pHandle->protocolHandle, pHandle->batchFrames, SBG_ARRAY_SIZE(pHandle->batchFrames), &pHandle->nrBatchFrames);
+
+                pHandle->batchIndex         = 0;
+                pHandle->batchGeneration    = sbgEComProtocolGetRxGeneration(&pHandle->protocolHandle);
+            }
+            else
+            {
+                errorCode = SBG_NO_ERROR;
+            }
+
+            while (pHandle->batchIndex < pHandle->nrBatchFrames)
+            {
+                const SbgEComProtocolFrameDescriptor    *pFrame;
+
+                //
+                // A frame received directly from the protocol has discarded the remaining frames of the batch
+                //
+                if (sbgEComProtocolGetRxGeneration(&pHandle->protocolHandle) != pHandle->batchGeneration)
+                {
+                    SBG_LOG_WARNING(SBG_ERROR, "%zu received frames discarded by a protocol reception during dispatch", pHandle->nrBatchFrames - pHandle->batchIndex);
+
+                    pHandle->nrBatchFrames  = 0;
+                    pHandle->batchIndex     = 0;
+                    break;
+                }
+
+                pFrame = &pHandle->batchFrames[pHandle->batchIndex];
+                pHandle->batchIndex++;
+
+                sbgEComHandleFrame(pHandle, pFrame->msgClass, pFrame->msgId, pFrame->pPayload, pFrame->payloadSize);
+            }
+        } while (errorCode != SBG_NOT_READY);
+    }
+    
+    return errorCode;
+}
+
+SbgErrorCode sbgEComPurgeIncoming(SbgEComHandle *pHandle)
+{
+    SbgErrorCode    errorCode = SBG_NO_ERROR;
+
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        SbgEComReader                   *pReader = pHandle->pReader;
+
+        //
+        // The protocol belongs to the reader thread, only discard the frames it has stored
+        //
+        sbgEComFrameRingDiscard(&pReader->ring);
+
+        sbgMutexLock(pReader->pCmdMutex);
+
+        for (size_t i = 0; i < pReader->nrMailboxFrames; i++)
+        {
+            free(pReader->mailbox[i].pPayload);
+        }
+
+        pReader->nrMailboxFrames = 0;
+
+        sbgMutexUnlock(pReader->pCmdMutex);
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        pHandle->nrBatchFrames  = 0;
+        pHandle->batchIndex     = 0;
+
+        errorCode = sbgEComProtocolPurgeIncoming(&pHandle->protocolHandle);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComReceiveFrame(SbgEComHandle *pHandle, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        errorCode = sbgEComFrameRingPop(&pHandle->pReader->ring, pMsgClass, pMsgId, pHandle->pReader->pBuffer, pPayload);
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    if ((pHandle->batchIndex < pHandle->nrBatchFrames) && (sbgEComProtocolGetRxGeneration(&pHandle->protocolHandle) == pHandle->batchGeneration))
+    {
+        const SbgEComProtocolFrameDescriptor    *pFrame;
+
+        //
+        // The remaining frames of the batch dispatched by sbgEComHandle() are received first, so that
+        // none is discarded. The payload refers to the protocol buffers, as with sbgEComProtocolReceive2().
+        //
+        pFrame = &pHandle->batchFrames[pHandle->batchIndex];
+        pHandle->batchIndex++;
+
+        sbgEComProtocolPayloadDestroy(pPayload);
+        sbgEComProtocolPayloadConstruct(pPayload);
+
+        pPayload->pBuffer   = (void *)pFrame->pPayload;
+        pPayload->size      = pFrame->payloadSize;
+
+        if (pMsgClass)
+        {
+            *pMsgClass = pFrame->msgClass;
+        }
+
+        if (pMsgId)
+        {
+            *pMsgId = pFrame->msgId;
+        }
+
+        errorCode = SBG_NO_ERROR;
+    }
+    else
+    {
+        errorCode = sbgEComProtocolReceive2(&pHandle->protocolHandle, pMsgClass, pMsgId, pPayload);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComWaitFrame(SbgEComHandle *pHandle, uint32_t timeOut)
+{
+    SbgErrorCode                         errorCode;
+
+    assert(pHandle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        SbgEComReader                   *pReader = pHandle->pReader;
+
+        sbgMutexLock(pReader->pMutex);
+
+        if (sbgEComFrameRingIsEmpty(&pReader->ring))
+        {
+            errorCode = sbgConditionWait(pReader->pFrameCondition, pReader->pMutex, timeOut);
+        }
+        else
+        {
+            errorCode = SBG_NO_ERROR;
+        }
+
+        sbgMutexUnlock(pReader->pMutex);
+    }
+    else
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        errorCode = sbgInterfaceWait(pHandle->protocolHandle.pLinkedInterface, sbgMin(timeOut, UINT32_MAX / 1000) * 1000);
+    }
+
+    return errorCode;
+}
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+SbgErrorCode sbgEComStartReader(SbgEComHandle *pHandle, const SbgEComFrameRingConfig *pConfig)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    SbgEComReader                       *pReader;
+
+    assert(pHandle);
+
+    if (!pHandle->pReader)
+    {
+        //
+        // Zero initialize the reader so that it can be released at any step
+        //
+        pReader = calloc(1, sizeof(*pReader));
+
+        if (pReader)
+        {
+            pReader->pProtocol  = &pHandle->protocolHandle;
+            pReader->pHandle    = pHandle;
+
+            errorCode = sbgEComFrameRingConstruct(&pReader->ring, pConfig);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                pReader->pBuffer = malloc(pReader->ring.slotSize);
+
+                if (!pReader->pBuffer)
+                {
+                    errorCode = SBG_MALLOC_FAILED;
+                    SBG_LOG_ERROR(errorCode, "unable to allocate reader buffer");
+                }
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgMutexCreate(&pReader->pMutex);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgConditionCreate(&pReader->pFrameCondition);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgMutexCreate(&pReader->pTxMutex);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgMutexCreate(&pReader->pCmdMutex);
+            }
+
+            for (size_t i = 0; (i < SBG_ARRAY_SIZE(pReader->cmdSlots)) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                errorCode = sbgConditionCreate(&pReader->cmdSlots[i].pCondition);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                sbgEComProtocolSetTxMutex(&pHandle->protocolHandle, pReader->pTxMutex);
+
+                //
+                // Publish the reader before starting the thread, log callbacks it runs may send commands
+                //
+                sbgAtomicStorePointer((void * volatile *)&pHandle->pReader, pReader);
+
+                errorCode = sbgThreadCreate(&pReader->pThread, sbgEComReaderRun, pReader);
+
+                if (errorCode != SBG_NO_ERROR)
+                {
+                    sbgAtomicStorePointer((void * volatile *)&pHandle->pReader, NULL);
+                    sbgEComProtocolSetTxMutex(&pHandle->protocolHandle, NULL);
+                }
+            }
+
+            if (errorCode != SBG_NO_ERROR)
+            {
+                sbgEComReaderRelease(pReader);
+            }
+        }
+        else
+        {
+            errorCode = SBG_MALLOC_FAILED;
+            SBG_LOG_ERROR(errorCode, "unable to allocate reader");
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "reader already started");
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComStopReader(SbgEComHandle *pHandle)
+{
+    SbgEComReader                       *pReader;
+
+    assert(pHandle);
+
+    pReader = pHandle->pReader;
+
+    if (pReader)
+    {
+        sbgAtomicStore(&pReader->stopRequested, 1);
+        sbgThreadJoin(pReader->pThread);
+
+        sbgAtomicStorePointer((void * volatile *)&pHandle->pReader, NULL);
+
+        sbgEComProtocolSetTxMutex(&pHandle->protocolHandle, NULL);
+        sbgEComReaderRelease(pReader);
+    }
+
+    return SBG_NO_ERROR;
+}
+
+void sbgEComGetReaderStats(const SbgEComHandle *pHandle, SbgEComFrameRingStats *pStats)
+{
+    assert(pHandle);
+    assert(pStats);
+
+    if (pHandle->pReader)
+    {
+        sbgEComFrameRingGetStats(&pHandle->pReader->ring, pStats);
+    }
+    else
+    {
+        memset(pStats, 0, sizeof(*pStats));
+    }
+}
+
+uint32_t sbgEComGetNrDroppedCmdFrames(const SbgEComHandle *pHandle)
+{
+    uint32_t                             nrDroppedCmdFrames = 0;
+
+    assert(pHandle);
+
+    if (pHandle->pReader)
+    {
+        sbgMutexLock(pHandle->pReader->pCmdMutex);
+        nrDroppedCmdFrames = pHandle->pReader->nrDroppedCmdFrames;
+        sbgMutexUnlock(pHandle->pReader->pCmdMutex);
+    }
+
+    return nrDroppedCmdFrames;
+}
+
+SbgErrorCode sbgEComReceiveCmdFrame(SbgEComHandle *pHandle, SbgEComCmdMatch match, uint8_t msgClass, uint8_t msgId, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload, uint32_t timeOut)
+{
+    SbgErrorCode                         errorCode = SBG_NOT_READY;
+    SbgEComReader                       *pReader;
+
+    assert(pHandle);
+    assert(pMsgClass);
+    assert(pMsgId);
+    assert(pPayload);
+
+    pReader = pHandle->pReader;
+
+    if (pReader)
+    {
+        SbgEComCmdFrame                  frame;
+
+        sbgMutexLock(pReader->pCmdMutex);
+
+        //
+        // Frames received while no thread was waiting for them come first
+        //
+        errorCode = sbgEComReaderPopMailbox(pReader, match, msgClass, msgId, &frame);
+
+        if ((errorCode == SBG_NOT_READY) && (timeOut != 0))
+        {
+            errorCode = sbgEComReaderWaitCmd(pReader, match, msgClass, msgId, &frame, timeOut);
+        }
+
+        sbgMutexUnlock(pReader->pCmdMutex);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            //
+            // The payload is constructed with the default allocator, it takes the ownership of the buffer
+            //
+            sbgEComProtocolPayloadDestroy(pPayload);
+            sbgEComProtocolPayloadConstruct(pPayload);
+
+            pPayload->allocated = true;
+            pPayload->pBuffer   = frame.pPayload;
+            pPayload->size      = frame.payloadSize;
+
+            *pMsgClass  = frame.msgClass;
+            *pMsgId     = frame.msgId;
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "reader not started");
+    }
+
+    return errorCode;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+void sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceiveLogFunc pReceiveLogCallback, void *pUserArg)
+{
+    assert(pHandle);
+
+    //
+    // Define the callback and the user argument
+    //
+    pHandle->pReceiveLogCallback    = pReceiveLogCallback;
+    pHandle->pUserArg               = pUserArg;
+}
+
+void sbgEComSubscribeLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    sbgEComSetLogSubscription(pHandle, msgClass, msgId, true);
+}
+
+void sbgEComUnsubscribeLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    sbgEComSetLogSubscription(pHandle, msgClass, msgId, false);
+}
+
+void sbgEComSubscribeAllLogs(SbgEComHandle *pHandle)
+{
+    assert(pHandle);
+
+    sbgEComLockSubscriptions(pHandle);
+    memset(pHandle->logSubscriptions, 0xff, sizeof(pHandle->logSubscriptions));
+    sbgEComUnlockSubscriptions(pHandle);
+}
+
+void sbgEComUnsubscribeAllLogs(SbgEComHandle *pHandle)
+{
+    assert(pHandle);
+
+    sbgEComLockSubscriptions(pHandle);
+    memset(pHandle->logSubscriptions, 0x00, sizeof(pHandle->logSubscriptions));
+    sbgEComUnlockSubscriptions(pHandle);
+}
+
+bool sbgEComIsLogSubscribed(const SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    bool                                 subscribed = true;
+
+    assert(pHandle);
+
+    if ((size_t)msgClass < SBG_ECOM_SUBSCRIPTION_NR_CLASSES)
+    {
+        subscribed = (pHandle->logSubscriptions[msgClass][msgId / 32] & (1u << (msgId % 32))) != 0;
+    }
+
+    return subscribed;
+}
+
+uint32_t sbgEComGetNrDroppedLogs(const SbgEComHandle *pHandle)
+{
+    uint32_t                             nrDroppedLogs;
+
+    assert(pHandle);
+
+    nrDroppedLogs = pHandle->nrDroppedLogs;
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        sbgMutexLock(pHandle->pReader->pMutex);
+        nrDroppedLogs += pHandle->pReader->nrDroppedLogs;
+        sbgMutexUnlock(pHandle->pReader->pMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    return nrDroppedLogs;
+}
+
+void sbgEComResetNrDroppedLogs(SbgEComHandle *pHandle)
+{
+    assert(pHandle);
+
+    pHandle->nrDroppedLogs = 0;
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pHandle->pReader)
+    {
+        sbgMutexLock(pHandle->pReader->pMutex);
+        pHandle->pReader->nrDroppedLogs = 0;
+        sbgMutexUnlock(pHandle->pReader->pMutex);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+}
+
+SbgErrorCode sbgEComAddLogCallback(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, SbgEComReceiveLogFunc pCallback, void *pUserArg, size_t *pCallbackId)
+{
+    return sbgEComAddLogCallbackEntry(pHandle, msgClass, msgId, false, pCallback, pUserArg, pCallbackId);
+}
+
+SbgErrorCode sbgEComAddClassLogCallback(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComReceiveLogFunc pCallback, void *pUserArg, size_t *pCallbackId)
+{
+    return sbgEComAddLogCallbackEntry(pHandle, msgClass, 0, true, pCallback, pUserArg, pCallbackId);
+}
+
+SbgErrorCode sbgEComRemoveLogCallback(SbgEComHandle *pHandle, size_t callbackId)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    size_t                               index;
+
+    assert(pHandle);
+
+    index = callbackId & 0xff;
+
+    if ((index < SBG_ARRAY_SIZE(pHandle->logCallbacks)) && pHandle->logCallbacks[index].pCallback && !pHandle->logCallbacks[index].removed && (sbgEComGetLogCallbackId(pHandle, index) == callbackId))
+    {
+        if (pHandle->logCallbackDepth != 0)
+        {
+            //
+            // Callbacks are being called, keep the entry linked until they return
+            //
+            pHandle->logCallbacks[index].removed    = true;
+            pHandle->logCallbackRemoved             = true;
+        }
+        else
+        {
+            sbgEComReleaseLogCallback(pHandle, index);
+        }
+    }
+    else
+    {
+        errorCode = SBG_INVALID_PARAMETER;
+        SBG_LOG_ERROR(errorCode, "invalid log callback ID %zu", callbackId);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode sbgEComHandleLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    uint8_t                              headIndex = SBG_ECOM_LOG_CALLBACK_NONE;
+
+    assert(pHandle);
+
+    if ((size_t)msgClass < SBG_ECOM_SUBSCRIPTION_NR_CLASSES)
+    {
+        headIndex = pHandle->logCallbackHeads[msgClass][msgId];
+    }
+
+    //
+    // Drop logs the application isn't interested in before decoding them
+    //
+    if (!sbgEComIsLogSubscribed(pHandle, msgClass, msgId))
+    {
+        pHandle->nrDroppedLogs++;
+    }
+    else if (pHandle->pReceiveLogCallback || (headIndex != SBG_ECOM_LOG_CALLBACK_NONE) || (pHandle->wildcardLogCallbackHead != SBG_ECOM_LOG_CALLBACK_NONE))
+    {
+        const SbgEComLogDecoder         *pDecoder = NULL;
+        void                            *pLogBuffer;
+        size_t                           logBufferSize;
+
+        if (pHandle->logViews)
+        {
+            pDecoder = sbgEComLogGetViewDecoder(msgClass, msgId);
+        }
+
+        if (!pDecoder)
+        {
+            pDecoder = sbgEComLogGetDecoder(msgClass, msgId);
+        }
+
+        if (pDecoder)
+        {
+            errorCode = sbgEComAcquireLogBuffer(pHandle, pDecoder->dataSize, &pLogBuffer, &logBufferSize);
+        }
+        else
+        {
+            //
+            // Unhandled message class or ID
+            //
+            errorCode = SBG_ERROR;
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            const SbgEComLogUnion       *pLogData = pLogBuffer;
+
+            errorCode = sbgEComLogDecodeWithDecoder(pDecoder, msgClass, msgId, pPayload, payloadSize, pLogBuffer, logBufferSize);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                SbgErrorCode             callbackErrorCode;
+
+                pHandle->logCallbackDepth++;
+
+                if (pHandle->pReceiveLogCallback)
+                {
+                    errorCode = pHandle->pReceiveLogCallback(pHandle, msgClass, msgId, pLogData, pHandle->pUserArg);
+                }
+
+                callbackErrorCode = sbgEComCallLogCallbacks(pHandle, headIndex, msgClass, msgId, pLogData);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    errorCode = callbackErrorCode;
+                }
+
+                callbackErrorCode = sbgEComCallLogCallbacks(pHandle, pHandle->wildcardLogCallbackHead, msgClass, msgId, pLogData);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    errorCode = callbackErrorCode;
+                }
+
+                pHandle->logCallbackDepth--;
+
+                sbgEComReleaseRemovedLogCallbacks(pHandle);
+
+                //
+                // Clean up resources allocated during parsing, if any.
+                //
+                sbgEComLogCleanup(pLogBuffer, msgClass, msgId);
+            }
+
+            sbgEComReleaseLogBuffer(pHandle, pLogBuffer);
+        }
+    }
+
+    return errorCode;
+}
+
+void sbgEComSetLogBuffer(SbgEComHandle *pHandle, void *pLogBuffer, size_t logBufferSize)
+{
+    assert(pHandle);
+    assert(!pHandle->logBufferInUse);
+    assert(pLogBuffer || (logBufferSize == 0));
+
+    if (pHandle->logBufferAllocated)
+    {
+        free(pHandle->pLogBuffer);
+    }
+
+    pHandle->pLogBuffer             = pLogBuffer;
+    pHandle->logBufferSize          = logBufferSize;
+    pHandle->logBufferAllocated     = false;
+}
+
+void sbgEComSetCompactLogBuffer(SbgEComHandle *pHandle, bool enabled)
+{
+    assert(pHandle);
+
+    pHandle->compactLogBuffer = enabled;
+}
+
+void sbgEComSetLogViews(SbgEComHandle *pHandle, bool enabled)
+{
+    assert(pHandle);
+
+    pHandle->logViews = enabled;
 }
 
 void sbgEComSetCmdTrialsAndTimeOut(SbgEComHandle *pHandle, uint32_t numTrials, uint32_t cmdDefaultTimeOut)
@@ -51,6 +51,17 @@ extern "C" {
 #include "sbgEComIds.h"
 #include "logs/sbgEComLog.h"
 #include "protocol/sbgEComProtocol.h"
+#include "protocol/sbgEComFrameRing.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SBG_ECOM_SUBSCRIPTION_NR_CLASSES        (16)        /*!< Number of log classes, starting at 0, that can be filtered by the subscription bitmap. */
+#define SBG_ECOM_SUBSCRIPTION_NR_WORDS          (256 / 32)  /*!< Number of 32 bit words in the subscription bitmap of a class. */
+#define SBG_ECOM_MAX_LOG_CALLBACKS              (16)        /*!< Maximum number of log callbacks registered on a handle. */
+#define SBG_ECOM_LOG_CALLBACK_NONE              (0xff)      /*!< Invalid log callback index, used to terminate callback chains. */
+#define SBG_ECOM_HANDLE_BATCH_SIZE              (16)        /*!< Maximum number of frames received at once by sbgEComHandle(). */
 
 //----------------------------------------------------------------------//
 //- Predefinitions                                                     -//
@@ -61,6 +72,27 @@ extern "C" {
  */
 typedef struct _SbgEComHandle SbgEComHandle;
 
+/*!
+ * Reader thread, started with sbgEComStartReader().
+ */
+typedef struct _SbgEComReader SbgEComReader;
+
+//----------------------------------------------------------------------//
+//- Enumeration definitions                                            -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Command frames matched by sbgEComReceiveCmdFrame().
+ */
+typedef enum _SbgEComCmdMatch
+{
+    SBG_ECOM_CMD_MATCH_ANY                  = 0,            /*!< Any command frame. */
+    SBG_ECOM_CMD_MATCH_REPLY                = 1,            /*!< Frame of the given class and ID, or ACK of the given class and ID. */
+    SBG_ECOM_CMD_MATCH_ACK                  = 2,            /*!< ACK of the given class and ID. */
+} SbgEComCmdMatch;
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
 //----------------------------------------------------------------------//
 //- Callbacks definitions                                              -//
 //----------------------------------------------------------------------//
@@ -68,6 +100,10 @@ typedef struct _SbgEComHandle SbgEComHandle;
 /*!
  * Callback definition called each time a new log is received.
  *
+ * The log data is only valid during the call. With compact log buffers or an application log buffer,
+ * it only holds the union member of the received log and must not be copied as a whole union, see
+ * sbgEComSetCompactLogBuffer().
+ *
  * \param[in]   pHandle                                 Valid handle on the sbgECom instance that has called this callback.
  * \param[in]   msgClass                                Class of the message we have received
  * \param[in]   msg                                     Message ID of the log received.
@@ -81,6 +117,21 @@ typedef SbgErrorCode (*SbgEComReceiveLogFunc)(SbgEComHandle *pHandle, SbgEComCla
 //- Structures definitions                                             -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Log callback registered with sbgEComAddLogCallback() or sbgEComAddClassLogCallback().
+ */
+typedef struct _SbgEComLogCallback
+{
+    SbgEComReceiveLogFunc        pCallback;                 /*!< Callback, NULL if the entry is free. */
+    void                        *pUserArg;                  /*!< Optional user supplied argument. */
+    uint8_t                      msgClass;                  /*!< Message class, SBG_ECOM_CLASS_LOG_ALL for all classes. */
+    uint8_t                      msgId;                     /*!< Message ID, unused if allIds is set. */
+    bool                         allIds;                    /*!< Set if the callback is called for all message IDs. */
+    uint8_t                      nextIndex;                 /*!< Index of the next callback in the same chain, SBG_ECOM_LOG_CALLBACK_NONE if last. */
+    bool                         removed;                   /*!< Set if the callback is unregistered while log callbacks are called, the entry is released once they return. */
+    uint16_t                     generation;                /*!< Incremented each time the entry is released, so that the IDs of former callbacks are rejected. */
+} SbgEComLogCallback;
+
 /*!
  * Interface definition that stores methods used to communicate on the interface.
  */
@@ -93,6 +144,29 @@ struct _SbgEComHandle
 
     uint32_t                     numTrials;                 /*!< Number of trials when a command is sent (default is 3). */
     uint32_t                     cmdDefaultTimeOut;         /*!< Default time out in ms to get an answer from the device (default 500 ms). */
+
+    uint32_t                     logSubscriptions[SBG_ECOM_SUBSCRIPTION_NR_CLASSES][SBG_ECOM_SUBSCRIPTION_NR_WORDS];    /*!< Subscription bitmap, one bit per message ID. */
+    uint32_t                     nrDroppedLogs;             /*!< Number of received logs dropped because they aren't subscribed. */
+
+    SbgEComLogCallback           logCallbacks[SBG_ECOM_MAX_LOG_CALLBACKS];                                              /*!< Registered log callbacks. */
+    uint8_t                      logCallbackHeads[SBG_ECOM_SUBSCRIPTION_NR_CLASSES][256];                               /*!< Index of the first callback registered for each log, per class and message ID. */
+    uint8_t                      wildcardLogCallbackHead;   /*!< Index of the first callback registered with a wildcard or on a class that has no lookup table. */
+    uint32_t                     logCallbackDepth;          /*!< Number of nested log callback dispatches. */
+    bool                         logCallbackRemoved;        /*!< True if callbacks have been unregistered during a dispatch and must be released. */
+
+    void                        *pLogBuffer;                /*!< Buffer received logs are decoded into, NULL until the first log is decoded. */
+    size_t                       logBufferSize;             /*!< Log buffer size, in bytes. */
+    bool                         logBufferAllocated;        /*!< True if the log buffer is allocated with malloc(). */
+    bool                         logBufferInUse;            /*!< True while the log buffer is used by the log callbacks. */
+    bool                         compactLogBuffer;          /*!< True to size the allocated log buffers for the received log only. */
+    bool                         logViews;                  /*!< True to decode the variable size logs into zero-copy views. */
+
+    SbgEComProtocolFrameDescriptor batchFrames[SBG_ECOM_HANDLE_BATCH_SIZE];                                             /*!< Frames received by the batch being dispatched by sbgEComHandle(). */
+    size_t                       nrBatchFrames;             /*!< Number of frames in the batch. */
+    size_t                       batchIndex;                /*!< Index of the next frame of the batch to dispatch. */
+    size_t                       batchGeneration;           /*!< Protocol receive generation of the batch. */
+
+    SbgEComReader               *pReader;                   /*!< Reader thread, NULL if frames are read by the thread handling them. */
 };
 
 //----------------------------------------------------------------------//
@@ -108,6 +182,19 @@ struct _SbgEComHandle
  */
 SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface);
 
+/*!
+ * Initialize the protocol system with a reception buffer of a custom size.
+ *
+ * See sbgEComProtocolInitWithRxBuffer() for details about the reception buffer.
+ *
+ * \param[out]  pHandle                         Pointer used to store the allocated and initialized sbgECom handle.
+ * \param[in]   pInterface                      Interface to use for read/write operations.
+ * \param[in]   pRxBuffer                       Reception buffer, may be NULL to have it allocated.
+ * \param[in]   rxBufferSize                    Reception buffer size, in bytes, at least SBG_ECOM_MAX_BUFFER_SIZE.
+ * \return                                      SBG_NO_ERROR if we have initialized the protocol system.
+ */
+SbgErrorCode sbgEComInitWithRxBuffer(SbgEComHandle *pHandle, SbgInterface *pInterface, void *pRxBuffer, size_t rxBufferSize);
+
 /*!
  * Close the protocol system and release associated memory.
  * 
@@ -126,6 +213,10 @@ SbgErrorCode sbgEComHandleOneLog(SbgEComHandle *pHandle);
 
 /*!
  * Handle all incoming logs until no more log are available in the input interface.
+ *
+ * Log callbacks may send commands, the frames received with the log being handled are dispatched
+ * by the command in order. Frames must not be received directly from the protocol of the handle
+ * during this call, as it discards the frames not handled yet.
  * 
  * \param[in]   pHandle                         A valid sbgECom handle.
  * \return                                      SBG_NO_ERROR if no error occurs during incoming logs parsing.
@@ -138,12 +229,128 @@ SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle);
  * For example, if the program flow has been interrupted, this method can be helpful to discard all trash received data.
  * 
  * \note This method is blocking for 100ms and actively tries to read incoming data.
+ *       If the reader thread is running, only the frames already stored in its ring are discarded.
  * 
  * \param[in]   pHandle                         A valid sbgECom handle.
  * \return                                      SBG_NO_ERROR if the incoming data has been purged successfully.
  */
 SbgErrorCode sbgEComPurgeIncoming(SbgEComHandle *pHandle);
 
+/*!
+ * Receive a frame.
+ *
+ * Frames are taken from the reader thread if it is running, otherwise they are read from the interface.
+ * The reader thread only stores logs, command frames are received with sbgEComReceiveCmdFrame().
+ * While sbgEComHandle() dispatches frames, the frames it hasn't dispatched yet are received first.
+ * The payload is only valid until the next frame is received. If the reader thread is running, frames
+ * must only be received by the thread handling the logs.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[out]  pMsgClass                       Message class.
+ * \param[out]  pMsgId                          Message ID.
+ * \param[out]  pPayload                        Payload.
+ * \return                                      SBG_NO_ERROR if a frame has been received, SBG_NOT_READY if no frame is available.
+ */
+SbgErrorCode sbgEComReceiveFrame(SbgEComHandle *pHandle, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload);
+
+/*!
+ * Wait until a frame may be received.
+ *
+ * Blocks on the interface, or on the reader thread if it is running, until new data arrives or the
+ * time out elapses. Meant to be called after sbgEComReceiveFrame() has returned SBG_NOT_READY,
+ * instead of sleeping.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   timeOut                         Maximum time to wait, in ms.
+ * \return                                      SBG_NO_ERROR if a frame may be received, SBG_TIME_OUT if no data has been received in time.
+ */
+SbgErrorCode sbgEComWaitFrame(SbgEComHandle *pHandle, uint32_t timeOut);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Start a thread dedicated to reading the interface.
+ *
+ * The reader thread extracts the frames from the interface and demultiplexes them:
+ *  - logs are stored in a frame ring, so that slow log callbacks don't stall the reception.
+ *    sbgEComHandle() and sbgEComHandleOneLog() take them from the ring, from a single thread.
+ *  - command answers and ACKs are handed over to the threads waiting for them in sbgEComReceiveCmdFrame().
+ *
+ * Commands may then be sent from any thread, concurrently with the thread handling the logs. The
+ * frames sent are serialized by a mutex, no lock is held while waiting for an answer.
+ *
+ * Logs that aren't subscribed are dropped by the reader thread, and counted by sbgEComGetNrDroppedLogs().
+ * Logs are received from the ring by a single thread, as the payload returned by sbgEComReceiveFrame()
+ * refers to a buffer of the reader. sbgEComPurgeIncoming() may be called from any thread.
+ *
+ * The reader thread calls the protocol frame callback, see sbgEComProtocolSetOnFrameReceivedCb(),
+ * which must then be thread safe, and looks up the log decoder registry, see sbgEComLogRegisterDecoder(),
+ * which must be filled before the thread is started. The protocol must not be used to receive frames
+ * while the reader thread is running.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   pConfig                         Frame ring configuration, NULL for the default configuration.
+ * \return                                      SBG_NO_ERROR if the reader thread has been started.
+ */
+SbgErrorCode sbgEComStartReader(SbgEComHandle *pHandle, const SbgEComFrameRingConfig *pConfig);
+
+/*!
+ * Stop the reader thread.
+ *
+ * Frames remaining in the ring are discarded. No command may be pending.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \return                                      SBG_NO_ERROR if the reader thread has been stopped.
+ */
+SbgErrorCode sbgEComStopReader(SbgEComHandle *pHandle);
+
+/*!
+ * Get the statistics of the reader thread frame ring.
+ *
+ * All statistics are zero if the reader thread isn't running.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[out]  pStats                          Frame ring statistics.
+ */
+void sbgEComGetReaderStats(const SbgEComHandle *pHandle, SbgEComFrameRingStats *pStats);
+
+/*!
+ * Get the number of command frames dropped by the reader thread.
+ *
+ * Command frames no thread is waiting for are kept in a mailbox of 64 frames.
+ * When it is full, its oldest frame is dropped, with a warning, to store the new one.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \return                                      Number of command frames dropped since the reader thread has been started, 0 if it isn't running.
+ */
+uint32_t sbgEComGetNrDroppedCmdFrames(const SbgEComHandle *pHandle);
+
+/*!
+ * Receive a command frame from the reader thread, from any thread.
+ *
+ * Frames are routed by the reader thread when they are received. When several threads wait for the same
+ * frame, it is handed over to the one that has waited the longest. Threads waiting with SBG_ECOM_CMD_MATCH_ANY
+ * have the lowest priority: they only receive frames no thread is waiting for with SBG_ECOM_CMD_MATCH_REPLY
+ * or SBG_ECOM_CMD_MATCH_ACK. Frames received while no thread was waiting for them are kept in a small
+ * mailbox, and returned first.
+ *
+ * The payload owns its buffer, it remains valid until it is destroyed.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle, with the reader thread running.
+ * \param[in]   match                           Frames to receive.
+ * \param[in]   msgClass                        Message class, unused for SBG_ECOM_CMD_MATCH_ANY.
+ * \param[in]   msgId                           Message ID, unused for SBG_ECOM_CMD_MATCH_ANY.
+ * \param[out]  pMsgClass                       Message class of the received frame.
+ * \param[out]  pMsgId                          Message ID of the received frame.
+ * \param[out]  pPayload                        Payload.
+ * \param[in]   timeOut                         Time-out, in ms, 0 to only check the received frames.
+ * \return                                      SBG_NO_ERROR if a frame has been received,
+ *                                              SBG_NOT_READY if no frame has been received and timeOut is 0,
+ *                                              SBG_TIME_OUT if no frame has been received within the time out,
+ *                                              SBG_BUFFER_OVERFLOW if too many threads are already waiting for frames.
+ */
+SbgErrorCode sbgEComReceiveCmdFrame(SbgEComHandle *pHandle, SbgEComCmdMatch match, uint8_t msgClass, uint8_t msgId, uint8_t *pMsgClass, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload, uint32_t timeOut);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
 /*!
  * Define the callback that should be called each time a new binary log is received.
  * 
@@ -153,6 +360,175 @@ SbgErrorCode sbgEComPurgeIncoming(SbgEComHandle *pHandle);
  */
 void sbgEComSetReceiveLogCallback(SbgEComHandle *pHandle, SbgEComReceiveLogFunc pReceiveLogCallback, void *pUserArg);
 
+/*!
+ * Subscribe to a log.
+ *
+ * Logs that aren't subscribed are dropped as soon as they are received, without being decoded.
+ * All logs are subscribed by default. Only classes below SBG_ECOM_SUBSCRIPTION_NR_CLASSES can be filtered,
+ * logs of other classes are always handled.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class, SBG_ECOM_CLASS_LOG_ALL for all classes.
+ * \param[in]   msgId                           Message ID.
+ */
+void sbgEComSubscribeLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId);
+
+/*!
+ * Unsubscribe from a log.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class, SBG_ECOM_CLASS_LOG_ALL for all classes.
+ * \param[in]   msgId                           Message ID.
+ */
+void sbgEComUnsubscribeLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId);
+
+/*!
+ * Subscribe to all logs.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ */
+void sbgEComSubscribeAllLogs(SbgEComHandle *pHandle);
+
+/*!
+ * Unsubscribe from all logs.
+ *
+ * Used to start from an empty subscription set before subscribing to the few logs an application consumes.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ */
+void sbgEComUnsubscribeAllLogs(SbgEComHandle *pHandle);
+
+/*!
+ * Check if a log is subscribed.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class.
+ * \param[in]   msgId                           Message ID.
+ * \return                                      True if the log is subscribed.
+ */
+bool sbgEComIsLogSubscribed(const SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId);
+
+/*!
+ * Get the number of received logs dropped because they aren't subscribed.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \return                                      Number of dropped logs.
+ */
+uint32_t sbgEComGetNrDroppedLogs(const SbgEComHandle *pHandle);
+
+/*!
+ * Reset the number of dropped logs.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ */
+void sbgEComResetNrDroppedLogs(SbgEComHandle *pHandle);
+
+/*!
+ * Register a callback for a log.
+ *
+ * Several callbacks can be registered for the same log, they are called in registration order
+ * after the callback defined by sbgEComSetReceiveLogCallback(), if any.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class, SBG_ECOM_CLASS_LOG_ALL for all classes.
+ * \param[in]   msgId                           Message ID.
+ * \param[in]   pCallback                       Callback to call when the log is received.
+ * \param[in]   pUserArg                        Optional user argument passed to the callback.
+ * \param[out]  pCallbackId                     Callback ID used to unregister the callback, may be NULL.
+ * \return                                      SBG_NO_ERROR if successful, SBG_BUFFER_OVERFLOW if too many callbacks are registered.
+ */
+SbgErrorCode sbgEComAddLogCallback(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, SbgEComReceiveLogFunc pCallback, void *pUserArg, size_t *pCallbackId);
+
+/*!
+ * Register a callback for all the logs of a class.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class, SBG_ECOM_CLASS_LOG_ALL for all logs.
+ * \param[in]   pCallback                       Callback to call when a log of the class is received.
+ * \param[in]   pUserArg                        Optional user argument passed to the callback.
+ * \param[out]  pCallbackId                     Callback ID used to unregister the callback, may be NULL.
+ * \return                                      SBG_NO_ERROR if successful, SBG_BUFFER_OVERFLOW if too many callbacks are registered.
+ */
+SbgErrorCode sbgEComAddClassLogCallback(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComReceiveLogFunc pCallback, void *pUserArg, size_t *pCallbackId);
+
+/*!
+ * Unregister a log callback.
+ *
+ * Callbacks may be unregistered while log callbacks are called, including the one being called,
+ * in which case they aren't called anymore and their entry is released once the dispatch is over.
+ * The ID of a callback that has already been unregistered is rejected, even if its entry has been
+ * reused since.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   callbackId                      Callback ID returned when the callback was registered.
+ * \return                                      SBG_NO_ERROR if successful.
+ */
+SbgErrorCode sbgEComRemoveLogCallback(SbgEComHandle *pHandle, size_t callbackId);
+
+/*!
+ * Define the buffer received logs are decoded into.
+ *
+ * By default, the log buffer is allocated on the first decoded log, as large as SbgEComLogUnion, so that
+ * log callbacks may copy the whole union. See sbgEComSetCompactLogBuffer() to only allocate the storage
+ * of the logs received.
+ *
+ * A static buffer avoids any allocation. It must be suitably aligned for the log structures and as large
+ * as the largest decoded log, see sbgEComLogGetDataSize(), otherwise larger logs are discarded. Log
+ * callbacks may then only access the union member of the received log.
+ * Logs received while the buffer is used by a log callback, for example while a command is executed from
+ * a log callback, are decoded into a temporary allocated buffer.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   pLogBuffer                      Log buffer, NULL to use an allocated one.
+ * \param[in]   logBufferSize                   Log buffer size, in bytes.
+ */
+void sbgEComSetLogBuffer(SbgEComHandle *pHandle, void *pLogBuffer, size_t logBufferSize);
+
+/*!
+ * Enable or disable the compact log buffers, disabled by default.
+ *
+ * The allocated log buffer is then grown to the structure size of the largest log received so far,
+ * instead of the size of SbgEComLogUnion. Only the subscribed logs are decoded, an application that only
+ * receives small logs never allocates the storage of large ones such as raw GNSS data.
+ *
+ * Log callbacks may then only access the union member of the received log, the union must never be
+ * copied as a whole.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   enabled                         True to size the allocated log buffers for the received log only.
+ */
+void sbgEComSetCompactLogBuffer(SbgEComHandle *pHandle, bool enabled);
+
+/*!
+ * Enable or disable the zero-copy views of the variable size logs, disabled by default.
+ *
+ * Raw data, satellite list and diagnostic logs received by this handle are then passed to the log
+ * callbacks in the rawDataView, satListView and diagView members of the log union, instead of
+ * gpsRawData/rtcmRawData, satGroupData and diagData. Other handles aren't affected.
+ *
+ * Views refer to the received payload: they are only valid until the log callback returns, or
+ * receives a frame, for example by sending a command.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   enabled                         True to decode the variable size logs into views.
+ */
+void sbgEComSetLogViews(SbgEComHandle *pHandle, bool enabled);
+
+/*!
+ * Handle a received log.
+ *
+ * The log is dropped if it isn't subscribed, otherwise it is decoded, if it has at least one consumer,
+ * and forwarded to the log callbacks.
+ *
+ * \param[in]   pHandle                         A valid sbgECom handle.
+ * \param[in]   msgClass                        Message class.
+ * \param[in]   msgId                           Message ID.
+ * \param[in]   pPayload                        Payload buffer.
+ * \param[in]   payloadSize                     Payload size, in bytes.
+ * \return                                      SBG_NO_ERROR if the log has been handled successfully.
+ */
+SbgErrorCode sbgEComHandleLog(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const void *pPayload, size_t payloadSize);
+
 /*!
  * Define the default number of trials that should be done when a command is send to the device as well as the time out.
  * 
@@ -56,6 +56,7 @@ extern "C" {
 #include "sbgEComIds.h"
 #include "commands/sbgEComCmd.h"
 #include "logs/sbgEComLog.h"
+#include "logs/sbgEComLogBatch.h"
 #include "protocol/sbgEComProtocol.h"
 #include "sessionInfo/sbgEComSessionInfo.h"
 #include "sbgEComVersion.h"
@@ -0,0 +1,551 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the large transfer buffer allocator.
+ *
+ * Large transfers are received with a pool of preallocated buffers as allocator. Reassembled
+ * buffers must come from the pool and be released to it when the payload is destroyed, when the
+ * protocol is closed during a transfer, or by the caller after an ownership transfer without
+ * copy. Buffers must be copied when moved across allocators, an exhausted pool must abort the
+ * transfer, and the default allocator must move buffers without copy.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define ALLOCATOR_CHECK_NR_SLOTS            (2)             /*!< Number of buffers in the pool. */
+#define ALLOCATOR_CHECK_SLOT_SIZE           (16384)         /*!< Size of a pool buffer, in bytes. */
+#define ALLOCATOR_CHECK_LARGE_SIZE          (10000)         /*!< Size of the large transfers, in bytes. */
+#define ALLOCATOR_CHECK_SMALL_SIZE          (100)           /*!< Size of the small frames, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Pool of preallocated buffers.
+ */
+typedef struct _AllocatorCheckPool
+{
+    uint8_t                 buffers[ALLOCATOR_CHECK_NR_SLOTS][ALLOCATOR_CHECK_SLOT_SIZE];   /*!< Buffers. */
+    bool                    used[ALLOCATOR_CHECK_NR_SLOTS];                                 /*!< True if a buffer is allocated. */
+    size_t                  nrAllocs;                                                       /*!< Number of successful allocations. */
+    size_t                  nrFailedAllocs;                                                 /*!< Number of failed allocations. */
+    size_t                  nrFrees;                                                        /*!< Number of releases. */
+    size_t                  nrInvalidFrees;                                                 /*!< Number of releases of buffers not allocated from the pool. */
+} AllocatorCheckPool;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Pool, too large for the stack.
+ */
+static AllocatorCheckPool   gAllocatorCheckPool;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log function, discarding the errors reported when the pool is exhausted.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void allocatorCheckOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Allocate a buffer from the pool.
+ *
+ * \param[in]   size                    Buffer size, in bytes.
+ * \param[in]   pUserArg                Pool.
+ * \return                              Allocated buffer, NULL if the allocation failed.
+ */
+static void *allocatorCheckAlloc(size_t size, void *pUserArg)
+{
+    AllocatorCheckPool     *pPool = pUserArg;
+    void                   *pBuffer = NULL;
+
+    assert(pPool);
+
+    if (size <= ALLOCATOR_CHECK_SLOT_SIZE)
+    {
+        for (size_t i = 0; i < ALLOCATOR_CHECK_NR_SLOTS; i++)
+        {
+            if (!pPool->used[i])
+            {
+                pPool->used[i]  = true;
+                pBuffer         = pPool->buffers[i];
+                break;
+            }
+        }
+    }
+
+    if (pBuffer)
+    {
+        pPool->nrAllocs++;
+    }
+    else
+    {
+        pPool->nrFailedAllocs++;
+    }
+
+    return pBuffer;
+}
+
+/*!
+ * Release a buffer to the pool.
+ *
+ * \param[in]   pBuffer                 Buffer.
+ * \param[in]   pUserArg                Pool.
+ */
+static void allocatorCheckFree(void *pBuffer, void *pUserArg)
+{
+    AllocatorCheckPool     *pPool = pUserArg;
+    bool                    found = false;
+
+    assert(pPool);
+
+    for (size_t i = 0; i < ALLOCATOR_CHECK_NR_SLOTS; i++)
+    {
+        if ((pBuffer == pPool->buffers[i]) && pPool->used[i])
+        {
+            pPool->used[i]  = false;
+            found           = true;
+        }
+    }
+
+    if (found)
+    {
+        pPool->nrFrees++;
+    }
+    else
+    {
+        pPool->nrInvalidFrees++;
+    }
+}
+
+/*!
+ * Check if a buffer belongs to the pool.
+ *
+ * \param[in]   pPool                   Pool.
+ * \param[in]   pBuffer                 Buffer.
+ * \return                              True if the buffer belongs to the pool.
+ */
+static bool allocatorCheckIsPoolBuffer(const AllocatorCheckPool *pPool, const void *pBuffer)
+{
+    bool                    found = false;
+
+    assert(pPool);
+
+    for (size_t i = 0; i < ALLOCATOR_CHECK_NR_SLOTS; i++)
+    {
+        if (pBuffer == pPool->buffers[i])
+        {
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+/*!
+ * Get the number of pool buffers in use.
+ *
+ * \param[in]   pPool                   Pool.
+ * \return                              Number of pool buffers in use.
+ */
+static size_t allocatorCheckGetNrUsed(const AllocatorCheckPool *pPool)
+{
+    size_t                  nrUsed = 0;
+
+    assert(pPool);
+
+    for (size_t i = 0; i < ALLOCATOR_CHECK_NR_SLOTS; i++)
+    {
+        if (pPool->used[i])
+        {
+            nrUsed++;
+        }
+    }
+
+    return nrUsed;
+}
+
+/*!
+ * Send a message, whose payload bytes are derived from its message ID.
+ *
+ * \param[in]   pProtocol               Protocol.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   size                    Payload size, in bytes.
+ * \return                              SBG_NO_ERROR if the message has been sent.
+ */
+static SbgErrorCode allocatorCheckSend(SbgEComProtocol *pProtocol, uint8_t msgId, size_t size)
+{
+    SbgErrorCode            errorCode;
+    uint8_t                *pPayload;
+
+    assert(pProtocol);
+
+    pPayload = malloc(size);
+
+    if (pPayload)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            pPayload[i] = (uint8_t)(i * 7 + msgId);
+        }
+
+        errorCode = sbgEComProtocolSend(pProtocol, SBG_ECOM_CLASS_LOG_ECOM_0, msgId, pPayload, size);
+
+        free(pPayload);
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Check a received payload.
+ *
+ * \param[in]   pBuffer                 Payload buffer.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   expectedSize            Expected payload size, in bytes.
+ * \return                              True if the payload is valid.
+ */
+static bool allocatorCheckPayload(const uint8_t *pBuffer, size_t size, uint8_t msgId, size_t expectedSize)
+{
+    bool                    valid;
+
+    valid = pBuffer && (size == expectedSize);
+
+    for (size_t i = 0; valid && (i < size); i++)
+    {
+        valid = (pBuffer[i] == (uint8_t)(i * 7 + msgId));
+    }
+
+    return valid;
+}
+
+/*!
+ * Receive the next message.
+ *
+ * Pages of a large transfer are processed as they fit in the work buffer, so the reception
+ * is attempted several times.
+ *
+ * \param[in]   pProtocol               Protocol.
+ * \param[out]  pMsgId                  Message ID.
+ * \param[out]  pPayload                Payload.
+ * \return                              SBG_NO_ERROR if a message has been received.
+ */
+static SbgErrorCode allocatorCheckReceive(SbgEComProtocol *pProtocol, uint8_t *pMsgId, SbgEComProtocolPayload *pPayload)
+{
+    SbgErrorCode            errorCode = SBG_NOT_READY;
+
+    assert(pProtocol);
+
+    for (size_t i = 0; (i < 16) && (errorCode == SBG_NOT_READY); i++)
+    {
+        uint8_t             msgClass;
+
+        errorCode = sbgEComProtocolReceive2(pProtocol, &msgClass, pMsgId, pPayload);
+    }
+
+    return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode;
+    AllocatorCheckPool     *pPool = &gAllocatorCheckPool;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(allocatorCheckOnLog);
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComProtocolAllocator    allocator;
+            SbgEComProtocolAllocator    returnedAllocator;
+            SbgEComProtocolPayload      payload;
+            uint8_t                     msgId;
+            uint8_t                    *pBuffer;
+            const void                 *pPayloadBuffer;
+
+            allocator.pAllocFunc    = allocatorCheckAlloc;
+            allocator.pFreeFunc     = allocatorCheckFree;
+            allocator.pUserArg      = pPool;
+
+            sbgEComProtocolSetAllocator(&protocol, &allocator);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            //
+            // A large transfer is reassembled in a pool buffer, released when the payload is destroyed.
+            //
+            allocatorCheckSend(&protocol, 1, ALLOCATOR_CHECK_LARGE_SIZE);
+            errorCode = allocatorCheckReceive(&protocol, &msgId, &payload);
+
+            if ((errorCode != SBG_NO_ERROR) || (msgId != 1) || !allocatorCheckIsPoolBuffer(pPool, sbgEComProtocolPayloadGetBuffer(&payload)) ||
+                !allocatorCheckPayload(sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload), 1, ALLOCATOR_CHECK_LARGE_SIZE))
+            {
+                printf("pool: invalid large transfer\n");
+                nrErrors++;
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            if ((pPool->nrAllocs != 1) || (allocatorCheckGetNrUsed(pPool) != 0))
+            {
+                printf("pool: buffer not released\n");
+                nrErrors++;
+            }
+
+            //
+            // Moving a large transfer buffer with its allocator passes the pool buffer without copy.
+            //
+            allocatorCheckSend(&protocol, 2, ALLOCATOR_CHECK_LARGE_SIZE);
+            errorCode       = allocatorCheckReceive(&protocol, &msgId, &payload);
+            pPayloadBuffer  = sbgEComProtocolPayloadGetBuffer(&payload);
+            pBuffer         = sbgEComProtocolPayloadMoveBufferWithAllocator(&payload, &returnedAllocator);
+
+            if ((errorCode != SBG_NO_ERROR) || (pBuffer != pPayloadBuffer) || !allocatorCheckIsPoolBuffer(pPool, pBuffer) ||
+                (returnedAllocator.pFreeFunc != allocatorCheckFree) || (returnedAllocator.pUserArg != pPool) ||
+                (sbgEComProtocolPayloadGetBuffer(&payload) != NULL) || !allocatorCheckPayload(pBuffer, ALLOCATOR_CHECK_LARGE_SIZE, 2, ALLOCATOR_CHECK_LARGE_SIZE))
+            {
+                printf("move with allocator: large transfer buffer not passed\n");
+                nrErrors++;
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            if (allocatorCheckGetNrUsed(pPool) != 1)
+            {
+                printf("move with allocator: buffer released by the payload\n");
+                nrErrors++;
+            }
+
+            if (pBuffer)
+            {
+                returnedAllocator.pFreeFunc(pBuffer, returnedAllocator.pUserArg);
+            }
+
+            //
+            // Moving a small frame payload with its allocator copies it to a pool buffer.
+            //
+            allocatorCheckSend(&protocol, 3, ALLOCATOR_CHECK_SMALL_SIZE);
+            errorCode   = allocatorCheckReceive(&protocol, &msgId, &payload);
+            pBuffer     = sbgEComProtocolPayloadMoveBufferWithAllocator(&payload, &returnedAllocator);
+
+            if ((errorCode != SBG_NO_ERROR) || !allocatorCheckIsPoolBuffer(pPool, pBuffer) || (returnedAllocator.pFreeFunc != allocatorCheckFree) ||
+                !allocatorCheckPayload(pBuffer, ALLOCATOR_CHECK_SMALL_SIZE, 3, ALLOCATOR_CHECK_SMALL_SIZE))
+            {
+                printf("move with allocator: small frame payload not copied to the pool\n");
+                nrErrors++;
+            }
+
+            if (pBuffer)
+            {
+                returnedAllocator.pFreeFunc(pBuffer, returnedAllocator.pUserArg);
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            //
+            // Moving a pool buffer without allocator copies it to a malloc() buffer and releases
+            // the pool buffer.
+            //
+            allocatorCheckSend(&protocol, 4, ALLOCATOR_CHECK_LARGE_SIZE);
+            errorCode   = allocatorCheckReceive(&protocol, &msgId, &payload);
+            pBuffer     = sbgEComProtocolPayloadMoveBuffer(&payload);
+
+            if ((errorCode != SBG_NO_ERROR) || allocatorCheckIsPoolBuffer(pPool, pBuffer) || (allocatorCheckGetNrUsed(pPool) != 0) ||
+                !allocatorCheckPayload(pBuffer, ALLOCATOR_CHECK_LARGE_SIZE, 4, ALLOCATOR_CHECK_LARGE_SIZE))
+            {
+                printf("move: pool buffer not copied\n");
+                nrErrors++;
+            }
+
+            free(pBuffer);
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            //
+            // If the pool is exhausted, the large transfer is aborted and following ones are received.
+            //
+            pPool->used[0] = true;
+            pPool->used[1] = true;
+
+            allocatorCheckSend(&protocol, 5, ALLOCATOR_CHECK_LARGE_SIZE);
+            errorCode = allocatorCheckReceive(&protocol, &msgId, &payload);
+
+            if ((errorCode != SBG_NOT_READY) || (pPool->nrFailedAllocs != 1) || (sbgEComProtocolGetStats(&protocol)->nrLargeTransferAborts != 1))
+            {
+                printf("exhausted pool: large transfer not aborted\n");
+                nrErrors++;
+            }
+
+            pPool->used[0] = false;
+            pPool->used[1] = false;
+
+            allocatorCheckSend(&protocol, 6, ALLOCATOR_CHECK_LARGE_SIZE);
+            errorCode = allocatorCheckReceive(&protocol, &msgId, &payload);
+
+            if ((errorCode != SBG_NO_ERROR) || (msgId != 6) ||
+                !allocatorCheckPayload(sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload), 6, ALLOCATOR_CHECK_LARGE_SIZE))
+            {
+                printf("exhausted pool: next large transfer not received\n");
+                nrErrors++;
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            //
+            // A large transfer in progress is released to the pool when the protocol is closed.
+            //
+            allocatorCheckSend(&protocol, 7, ALLOCATOR_CHECK_LARGE_SIZE);
+
+            //
+            // Stop once the first page has been processed, while the next ones are pending.
+            //
+            for (size_t i = 0; (i < 16) && (allocatorCheckGetNrUsed(pPool) == 0); i++)
+            {
+                uint8_t         msgClass;
+
+                sbgEComProtocolReceive2(&protocol, &msgClass, &msgId, &payload);
+            }
+
+            if (allocatorCheckGetNrUsed(pPool) != 1)
+            {
+                printf("close: no large transfer in progress\n");
+                nrErrors++;
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+            sbgEComProtocolClose(&protocol);
+
+            if ((allocatorCheckGetNrUsed(pPool) != 0) || (pPool->nrInvalidFrees != 0) || (pPool->nrAllocs != pPool->nrFrees))
+            {
+                printf("close: %zu buffers in use, %zu allocations, %zu releases, %zu invalid releases\n",
+                       allocatorCheckGetNrUsed(pPool), pPool->nrAllocs, pPool->nrFrees, pPool->nrInvalidFrees);
+                nrErrors++;
+            }
+
+            //
+            // With the default allocator, a large transfer buffer is moved without copy.
+            //
+            errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                sbgEComProtocolPayloadConstruct(&payload);
+
+                allocatorCheckSend(&protocol, 8, ALLOCATOR_CHECK_LARGE_SIZE);
+                errorCode       = allocatorCheckReceive(&protocol, &msgId, &payload);
+                pPayloadBuffer  = sbgEComProtocolPayloadGetBuffer(&payload);
+                pBuffer         = sbgEComProtocolPayloadMoveBuffer(&payload);
+
+                if ((errorCode != SBG_NO_ERROR) || (pBuffer != pPayloadBuffer) || !allocatorCheckPayload(pBuffer, ALLOCATOR_CHECK_LARGE_SIZE, 8, ALLOCATOR_CHECK_LARGE_SIZE))
+                {
+                    printf("default allocator: large transfer buffer copied\n");
+                    nrErrors++;
+                }
+
+                free(pBuffer);
+                sbgEComProtocolPayloadDestroy(&payload);
+                sbgEComProtocolClose(&protocol);
+            }
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        nrErrors++;
+    }
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
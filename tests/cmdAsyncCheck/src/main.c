@@ -0,0 +1,840 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the asynchronous commands against a scripted device.
+ *
+ * A memory interface is given a responder that replies to each request as its payload asks: at
+ * once, with an ACK reporting an error, after dropping trials, late, or when released by the
+ * check. Dropped requests must be resent up to their maximum number of trials, a late answer must
+ * not complete the next request of the same class and ID, an ACK must complete a request
+ * expecting an answer at once, completions must be queued in completion order, and no more
+ * requests than the window size may be in flight.
+ *
+ * The checks run without and, when threads are enabled, with the reader thread.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+#include <commands/sbgEComCmdAsync.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+#include "testResponder.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define CMD_ASYNC_CHECK_MAX_TAGS            (32)            /*!< Maximum number of requests in a check. */
+#define CMD_ASYNC_CHECK_FIRST_MSG_ID        (0x60)          /*!< First message ID used by the requests, unknown to the library. */
+#define CMD_ASYNC_CHECK_TIME_OUT            (30)            /*!< Time out of the trials that are expected to time out, in ms. */
+#define CMD_ASYNC_CHECK_LONG_TIME_OUT       (5000)          /*!< Time out of the trials that must not time out, in ms. */
+#define CMD_ASYNC_CHECK_MAX_DURATION        (10000)         /*!< Maximum duration of a check, in ms. */
+#define CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS  (20)            /*!< Number of requests sent through a small window. */
+#define CMD_ASYNC_CHECK_WINDOW_SIZE         (3)             /*!< Size of the small window. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Responder action, set by each request.
+ */
+typedef enum _CmdAsyncCheckAction
+{
+    CMD_ASYNC_CHECK_ACTION_REPLY            = 0,            /*!< Reply to each trial, with an answer or a successful ACK depending on the request. */
+    CMD_ASYNC_CHECK_ACTION_ACK_OK           = 1,            /*!< Reply to each trial with a successful ACK. */
+    CMD_ASYNC_CHECK_ACTION_ACK_ERROR        = 2,            /*!< Reply to each trial with an ACK reporting SBG_INVALID_PARAMETER. */
+    CMD_ASYNC_CHECK_ACTION_DROP_FIRST       = 3,            /*!< Drop the first trial, reply to the next ones. */
+    CMD_ASYNC_CHECK_ACTION_DROP_ALL         = 4,            /*!< Drop all the trials. */
+    CMD_ASYNC_CHECK_ACTION_HOLD             = 5,            /*!< Hold the reply until it is released by the check. */
+    CMD_ASYNC_CHECK_ACTION_LATE_REPLY       = 6,            /*!< Drop the first trial, reply to it late, just before replying to the second trial. */
+} CmdAsyncCheckAction;
+
+/*!
+ * Command payload, read by the responder.
+ */
+typedef struct _CmdAsyncCheckCommand
+{
+    uint32_t                tag;                            /*!< Request tag, unique in a check. */
+    uint32_t                action;                         /*!< Responder action. */
+    uint32_t                reply;                          /*!< Reply expected by the request. */
+} CmdAsyncCheckCommand;
+
+/*!
+ * Answer payload, written by the responder.
+ */
+typedef struct _CmdAsyncCheckAnswer
+{
+    uint32_t                tag;                            /*!< Tag of the answered request. */
+    uint32_t                trial;                          /*!< Answered trial, starting at 1. */
+} CmdAsyncCheckAnswer;
+
+/*!
+ * Reply held by the responder.
+ */
+typedef struct _CmdAsyncCheckHeld
+{
+    uint8_t                 msgClass;                       /*!< Message class of the request. */
+    uint8_t                 msgId;                          /*!< Message ID of the request. */
+    CmdAsyncCheckCommand    command;                        /*!< Request command. */
+    uint32_t                trial;                          /*!< Held trial. */
+} CmdAsyncCheckHeld;
+
+/*!
+ * Expected completion.
+ */
+typedef struct _CmdAsyncCheckExpected
+{
+    uint32_t                tag;                            /*!< Request tag. */
+    SbgErrorCode            errorCode;                      /*!< Request result. */
+    uint32_t                nrTrials;                       /*!< Number of trials. */
+    uint32_t                answerTrial;                    /*!< Trial the answer payload belongs to, 0 if the payload is empty. */
+} CmdAsyncCheckExpected;
+
+/*!
+ * Check context.
+ */
+typedef struct _CmdAsyncCheckContext
+{
+    SbgInterface            interface;                      /*!< Memory interface. */
+    SbgEComHandle           handle;                         /*!< sbgECom handle. */
+    SbgEComCmdAsync         async;                          /*!< Asynchronous command context. */
+    TestResponder           responder;                      /*!< Scripted device. */
+    bool                    useReader;                      /*!< True if the reader thread receives the frames. */
+    uint32_t                requestIds[CMD_ASYNC_CHECK_MAX_TAGS];   /*!< Request ID of each tag. */
+    uint32_t                nrTrials[CMD_ASYNC_CHECK_MAX_TAGS];     /*!< Number of trials received for each tag. */
+    size_t                  nrReceived;                     /*!< Number of trials received. */
+    CmdAsyncCheckHeld       held[CMD_ASYNC_CHECK_MAX_TAGS]; /*!< Held replies, in reception order. */
+    size_t                  nrHeld;                         /*!< Number of held replies. */
+} CmdAsyncCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Reply to a trial, with an answer or a successful ACK depending on the request.
+ *
+ * \param[in]   pContext                Check context.
+ * \param[in]   msgClass                Message class of the request.
+ * \param[in]   msgId                   Message ID of the request.
+ * \param[in]   pCommand                Request command.
+ * \param[in]   trial                   Answered trial.
+ */
+static void cmdAsyncCheckReply(CmdAsyncCheckContext *pContext, uint8_t msgClass, uint8_t msgId, const CmdAsyncCheckCommand *pCommand, uint32_t trial)
+{
+    assert(pContext);
+    assert(pCommand);
+
+    if (pCommand->reply == SBG_ECOM_CMD_ASYNC_REPLY_ANSWER)
+    {
+        CmdAsyncCheckAnswer     answer;
+
+        answer.tag      = pCommand->tag;
+        answer.trial    = trial;
+
+        testResponderSend(&pContext->responder, msgClass, msgId, &answer, sizeof(answer));
+    }
+    else
+    {
+        testResponderSendAck(&pContext->responder, msgClass, msgId, SBG_NO_ERROR);
+    }
+}
+
+/*!
+ * Script callback, reply to each request as its command asks.
+ *
+ * \param[in]   pResponder              Responder.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   pUserArg                Check context.
+ */
+static void cmdAsyncCheckOnCommand(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, const uint8_t *pPayload, size_t size, void *pUserArg)
+{
+    CmdAsyncCheckContext   *pContext = pUserArg;
+    CmdAsyncCheckCommand    command;
+
+    assert(pContext);
+
+    if (size == sizeof(command))
+    {
+        uint32_t            trial;
+
+        memcpy(&command, pPayload, sizeof(command));
+        assert(command.tag < CMD_ASYNC_CHECK_MAX_TAGS);
+
+        pContext->nrReceived++;
+        pContext->nrTrials[command.tag]++;
+
+        trial = pContext->nrTrials[command.tag];
+
+        switch (command.action)
+        {
+        case CMD_ASYNC_CHECK_ACTION_REPLY:
+            cmdAsyncCheckReply(pContext, msgClass, msgId, &command, trial);
+            break;
+        case CMD_ASYNC_CHECK_ACTION_ACK_OK:
+            testResponderSendAck(pResponder, msgClass, msgId, SBG_NO_ERROR);
+            break;
+        case CMD_ASYNC_CHECK_ACTION_ACK_ERROR:
+            testResponderSendAck(pResponder, msgClass, msgId, SBG_INVALID_PARAMETER);
+            break;
+        case CMD_ASYNC_CHECK_ACTION_DROP_FIRST:
+            if (trial > 1)
+            {
+                cmdAsyncCheckReply(pContext, msgClass, msgId, &command, trial);
+            }
+            break;
+        case CMD_ASYNC_CHECK_ACTION_HOLD:
+            assert(pContext->nrHeld < SBG_ARRAY_SIZE(pContext->held));
+
+            pContext->held[pContext->nrHeld].msgClass   = msgClass;
+            pContext->held[pContext->nrHeld].msgId      = msgId;
+            pContext->held[pContext->nrHeld].command    = command;
+            pContext->held[pContext->nrHeld].trial      = trial;
+            pContext->nrHeld++;
+            break;
+        case CMD_ASYNC_CHECK_ACTION_LATE_REPLY:
+            if (trial > 1)
+            {
+                cmdAsyncCheckReply(pContext, msgClass, msgId, &command, trial - 1);
+                cmdAsyncCheckReply(pContext, msgClass, msgId, &command, trial);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/*!
+ * Release the held replies.
+ *
+ * \param[in]   pContext                Check context.
+ * \param[in]   reversed                True to release the most recent reply first.
+ */
+static void cmdAsyncCheckRelease(CmdAsyncCheckContext *pContext, bool reversed)
+{
+    assert(pContext);
+
+    for (size_t i = 0; i < pContext->nrHeld; i++)
+    {
+        const CmdAsyncCheckHeld *pHeld;
+
+        pHeld = &pContext->held[reversed ? (pContext->nrHeld - 1 - i) : i];
+
+        cmdAsyncCheckReply(pContext, pHeld->msgClass, pHeld->msgId, &pHeld->command, pHeld->trial);
+    }
+
+    pContext->nrHeld = 0;
+}
+
+/*!
+ * Open a check context, with a scripted device on a memory interface.
+ *
+ * \param[out]  pContext                Check context.
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode cmdAsyncCheckOpen(CmdAsyncCheckContext *pContext, bool useReader)
+{
+    SbgErrorCode            errorCode;
+
+    assert(pContext);
+
+    memset(pContext, 0, sizeof(*pContext));
+
+    pContext->useReader = useReader;
+
+    errorCode = testInterfaceMemoryCreate(&pContext->interface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&pContext->handle, &pContext->interface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            testResponderConstruct(&pContext->responder, &pContext->interface, cmdAsyncCheckOnCommand, pContext);
+            sbgEComCmdAsyncConstruct(&pContext->async, &pContext->handle);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+            if (useReader)
+            {
+                errorCode = sbgEComStartReader(&pContext->handle, NULL);
+            }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+            if (errorCode != SBG_NO_ERROR)
+            {
+                sbgEComCmdAsyncDestroy(&pContext->async);
+                sbgEComClose(&pContext->handle);
+            }
+        }
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            sbgInterfaceDestroy(&pContext->interface);
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Close a check context.
+ *
+ * \param[in]   pContext                Check context.
+ */
+static void cmdAsyncCheckClose(CmdAsyncCheckContext *pContext)
+{
+    assert(pContext);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    if (pContext->useReader)
+    {
+        sbgEComStopReader(&pContext->handle);
+    }
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    sbgEComCmdAsyncDestroy(&pContext->async);
+    sbgEComClose(&pContext->handle);
+    sbgInterfaceDestroy(&pContext->interface);
+}
+
+/*!
+ * Submit a request, its command payload is read by the responder.
+ *
+ * \param[in]   pContext                Check context.
+ * \param[in]   tag                     Request tag.
+ * \param[in]   msgId                   Message ID, in the CMD_0 class.
+ * \param[in]   reply                   Reply expected.
+ * \param[in]   action                  Responder action.
+ * \param[in]   maxTrials               Maximum number of trials.
+ * \param[in]   timeOut                 Time out of each trial, in ms.
+ * \return                              SBG_NO_ERROR if the request has been submitted.
+ */
+static SbgErrorCode cmdAsyncCheckSubmit(CmdAsyncCheckContext *pContext, uint32_t tag, uint8_t msgId, SbgEComCmdAsyncReply reply, CmdAsyncCheckAction action, uint32_t maxTrials, uint32_t timeOut)
+{
+    CmdAsyncCheckCommand    command;
+
+    assert(pContext);
+    assert(tag < CMD_ASYNC_CHECK_MAX_TAGS);
+
+    command.tag     = tag;
+    command.action  = action;
+    command.reply   = reply;
+
+    return sbgEComCmdAsyncSubmit(&pContext->async, SBG_ECOM_CLASS_LOG_CMD_0, msgId, reply, &command, sizeof(command), maxTrials, timeOut, NULL, NULL, &pContext->requestIds[tag]);
+}
+
+/*!
+ * Check a completion against the expected one.
+ *
+ * \param[in]   pContext                Check context.
+ * \param[in]   pName                   Check name.
+ * \param[in]   pCompletion             Completion.
+ * \param[in]   pExpected               Expected completion.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckCompletion(const CmdAsyncCheckContext *pContext, const char *pName, const SbgEComCmdAsyncCompletion *pCompletion, const CmdAsyncCheckExpected *pExpected)
+{
+    size_t                  nrErrors = 0;
+    size_t                  size;
+
+    assert(pContext);
+    assert(pName);
+    assert(pCompletion);
+    assert(pExpected);
+
+    size = sbgEComProtocolPayloadGetSize(&pCompletion->payload);
+
+    if ((pCompletion->requestId != pContext->requestIds[pExpected->tag]) || (pCompletion->errorCode != pExpected->errorCode) || (pCompletion->nrTrials != pExpected->nrTrials))
+    {
+        printf("%s: request %" PRIu32 " completed as %" PRIu32 " with %s after %" PRIu32 " trials, instead of %s after %" PRIu32 " trials\n",
+               pName, pExpected->tag, pCompletion->requestId, sbgErrorCodeToString(pCompletion->errorCode), pCompletion->nrTrials,
+               sbgErrorCodeToString(pExpected->errorCode), pExpected->nrTrials);
+        nrErrors++;
+    }
+    else if (pExpected->answerTrial == 0)
+    {
+        if (size != 0)
+        {
+            printf("%s: request %" PRIu32 " completed with a %zu bytes payload instead of none\n", pName, pExpected->tag, size);
+            nrErrors++;
+        }
+    }
+    else
+    {
+        CmdAsyncCheckAnswer answer;
+
+        if (size == sizeof(answer))
+        {
+            memcpy(&answer, sbgEComProtocolPayloadGetBuffer(&pCompletion->payload), sizeof(answer));
+        }
+
+        if ((size != sizeof(answer)) || (answer.tag != pExpected->tag) || (answer.trial != pExpected->answerTrial))
+        {
+            printf("%s: request %" PRIu32 " completed with the wrong answer\n", pName, pExpected->tag);
+            nrErrors++;
+        }
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Pop all the completions and check them.
+ *
+ * \param[in]   pContext                Check context.
+ * \param[in]   pName                   Check name.
+ * \param[in]   pExpected               Expected completions.
+ * \param[in]   nrExpected              Number of expected completions.
+ * \param[in]   ordered                 True if the completions must be popped in the expected order.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckPopAll(CmdAsyncCheckContext *pContext, const char *pName, const CmdAsyncCheckExpected *pExpected, size_t nrExpected, bool ordered)
+{
+    SbgEComCmdAsyncCompletion   completion;
+    size_t                      nrPopped = 0;
+    size_t                      nrErrors = 0;
+
+    assert(pContext);
+    assert(pName);
+    assert(pExpected);
+
+    while (sbgEComCmdAsyncPopCompletion(&pContext->async, &completion) == SBG_NO_ERROR)
+    {
+        const CmdAsyncCheckExpected *pMatch = NULL;
+
+        if (ordered)
+        {
+            if (nrPopped < nrExpected)
+            {
+                pMatch = &pExpected[nrPopped];
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < nrExpected; i++)
+            {
+                if (pContext->requestIds[pExpected[i].tag] == completion.requestId)
+                {
+                    pMatch = &pExpected[i];
+                }
+            }
+        }
+
+        if (pMatch)
+        {
+            nrErrors += cmdAsyncCheckCompletion(pContext, pName, &completion, pMatch);
+        }
+        else
+        {
+            printf("%s: unexpected completion of request %" PRIu32 "\n", pName, completion.requestId);
+            nrErrors++;
+        }
+
+        sbgEComProtocolPayloadDestroy(&completion.payload);
+        nrPopped++;
+    }
+
+    if (nrPopped != nrExpected)
+    {
+        printf("%s: %zu completions instead of %zu\n", pName, nrPopped, nrExpected);
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check that dropped requests are resent, until their maximum number of trials.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckRetries(bool useReader)
+{
+    CmdAsyncCheckContext    context;
+    size_t                  nrErrors = 0;
+
+    if (cmdAsyncCheckOpen(&context, useReader) == SBG_NO_ERROR)
+    {
+        static const CmdAsyncCheckExpected  expected[] =
+        {
+            { 0, SBG_NO_ERROR,  2,  2 },
+            { 1, SBG_NO_ERROR,  2,  0 },
+            { 2, SBG_TIME_OUT,  2,  0 },
+            { 3, SBG_NO_ERROR,  1,  1 },
+        };
+
+        cmdAsyncCheckSubmit(&context, 0, CMD_ASYNC_CHECK_FIRST_MSG_ID + 0, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_DROP_FIRST, 3, CMD_ASYNC_CHECK_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 1, CMD_ASYNC_CHECK_FIRST_MSG_ID + 1, SBG_ECOM_CMD_ASYNC_REPLY_ACK, CMD_ASYNC_CHECK_ACTION_DROP_FIRST, 3, CMD_ASYNC_CHECK_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 2, CMD_ASYNC_CHECK_FIRST_MSG_ID + 2, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_DROP_ALL, 2, CMD_ASYNC_CHECK_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 3, CMD_ASYNC_CHECK_FIRST_MSG_ID + 3, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_REPLY, 3, CMD_ASYNC_CHECK_TIME_OUT);
+
+        if (sbgEComCmdAsyncWaitAll(&context.async, CMD_ASYNC_CHECK_MAX_DURATION) == SBG_NO_ERROR)
+        {
+            nrErrors += cmdAsyncCheckPopAll(&context, "retries", expected, SBG_ARRAY_SIZE(expected), false);
+        }
+        else
+        {
+            printf("retries: requests not completed\n");
+            nrErrors++;
+        }
+
+        cmdAsyncCheckClose(&context);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check that a late answer to a previous trial doesn't complete the next request of the same class and ID.
+ *
+ * The late answer and the answer to the second trial are received together, one request is sent at a
+ * time so that the next request is sent once both are handled.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckLateAnswer(bool useReader)
+{
+    CmdAsyncCheckContext    context;
+    size_t                  nrErrors = 0;
+
+    if (cmdAsyncCheckOpen(&context, useReader) == SBG_NO_ERROR)
+    {
+        static const CmdAsyncCheckExpected  expected[] =
+        {
+            { 0, SBG_NO_ERROR,  2,  1 },
+            { 1, SBG_NO_ERROR,  1,  1 },
+        };
+
+        sbgEComCmdAsyncSetWindowSize(&context.async, 1);
+
+        cmdAsyncCheckSubmit(&context, 0, CMD_ASYNC_CHECK_FIRST_MSG_ID, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_LATE_REPLY, 3, CMD_ASYNC_CHECK_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 1, CMD_ASYNC_CHECK_FIRST_MSG_ID, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_REPLY, 3, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+
+        if (sbgEComCmdAsyncWaitAll(&context.async, CMD_ASYNC_CHECK_MAX_DURATION) == SBG_NO_ERROR)
+        {
+            nrErrors += cmdAsyncCheckPopAll(&context, "late answer", expected, SBG_ARRAY_SIZE(expected), true);
+        }
+        else
+        {
+            printf("late answer: requests not completed\n");
+            nrErrors++;
+        }
+
+        cmdAsyncCheckClose(&context);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the ACKs received by requests expecting an answer or an ACK.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckAcks(bool useReader)
+{
+    CmdAsyncCheckContext    context;
+    size_t                  nrErrors = 0;
+
+    if (cmdAsyncCheckOpen(&context, useReader) == SBG_NO_ERROR)
+    {
+        //
+        // An ACK completes a request expecting an answer at once, as an error even if successful
+        //
+        static const CmdAsyncCheckExpected  expected[] =
+        {
+            { 0, SBG_INVALID_PARAMETER, 1,  0 },
+            { 1, SBG_ERROR,             1,  0 },
+            { 2, SBG_NO_ERROR,          1,  0 },
+            { 3, SBG_INVALID_PARAMETER, 1,  0 },
+        };
+
+        cmdAsyncCheckSubmit(&context, 0, CMD_ASYNC_CHECK_FIRST_MSG_ID + 0, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_ACK_ERROR, 3, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 1, CMD_ASYNC_CHECK_FIRST_MSG_ID + 1, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_ACK_OK, 3, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 2, CMD_ASYNC_CHECK_FIRST_MSG_ID + 2, SBG_ECOM_CMD_ASYNC_REPLY_ACK, CMD_ASYNC_CHECK_ACTION_ACK_OK, 3, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+        cmdAsyncCheckSubmit(&context, 3, CMD_ASYNC_CHECK_FIRST_MSG_ID + 3, SBG_ECOM_CMD_ASYNC_REPLY_ACK, CMD_ASYNC_CHECK_ACTION_ACK_ERROR, 3, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+
+        if (sbgEComCmdAsyncWaitAll(&context.async, CMD_ASYNC_CHECK_MAX_DURATION) == SBG_NO_ERROR)
+        {
+            nrErrors += cmdAsyncCheckPopAll(&context, "acks", expected, SBG_ARRAY_SIZE(expected), false);
+        }
+        else
+        {
+            printf("acks: requests not completed\n");
+            nrErrors++;
+        }
+
+        cmdAsyncCheckClose(&context);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check that the completions are queued in completion order, and not in submission order.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckCompletionOrder(bool useReader)
+{
+    CmdAsyncCheckContext    context;
+    size_t                  nrErrors = 0;
+
+    if (cmdAsyncCheckOpen(&context, useReader) == SBG_NO_ERROR)
+    {
+        static const CmdAsyncCheckExpected  expected[] =
+        {
+            { 3, SBG_NO_ERROR,  1,  1 },
+            { 2, SBG_NO_ERROR,  1,  0 },
+            { 1, SBG_NO_ERROR,  1,  1 },
+            { 0, SBG_NO_ERROR,  1,  0 },
+        };
+
+        for (uint32_t i = 0; i < SBG_ARRAY_SIZE(expected); i++)
+        {
+            SbgEComCmdAsyncReply    reply;
+
+            reply = ((i % 2) == 0) ? SBG_ECOM_CMD_ASYNC_REPLY_ACK : SBG_ECOM_CMD_ASYNC_REPLY_ANSWER;
+
+            cmdAsyncCheckSubmit(&context, i, (uint8_t)(CMD_ASYNC_CHECK_FIRST_MSG_ID + i), reply, CMD_ASYNC_CHECK_ACTION_HOLD, 1, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+        }
+
+        sbgEComCmdAsyncProcess(&context.async);
+
+        if (context.nrHeld == SBG_ARRAY_SIZE(expected))
+        {
+            cmdAsyncCheckRelease(&context, true);
+
+            if (sbgEComCmdAsyncWaitAll(&context.async, CMD_ASYNC_CHECK_MAX_DURATION) == SBG_NO_ERROR)
+            {
+                nrErrors += cmdAsyncCheckPopAll(&context, "completion order", expected, SBG_ARRAY_SIZE(expected), true);
+            }
+            else
+            {
+                printf("completion order: requests not completed\n");
+                nrErrors++;
+            }
+        }
+        else
+        {
+            printf("completion order: %zu requests sent instead of %zu\n", context.nrHeld, SBG_ARRAY_SIZE(expected));
+            nrErrors++;
+        }
+
+        cmdAsyncCheckClose(&context);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check that no more requests than the window size are in flight, and that the window is kept full.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckWindow(bool useReader)
+{
+    CmdAsyncCheckContext    context;
+    size_t                  nrErrors = 0;
+
+    if (cmdAsyncCheckOpen(&context, useReader) == SBG_NO_ERROR)
+    {
+        CmdAsyncCheckExpected   expected[CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS];
+        size_t                  nrCompleted = 0;
+        uint32_t                nextTag = 0;
+        uint32_t                start;
+
+        sbgEComCmdAsyncSetWindowSize(&context.async, CMD_ASYNC_CHECK_WINDOW_SIZE);
+
+        for (uint32_t i = 0; i < CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS; i++)
+        {
+            expected[i].tag         = i;
+            expected[i].errorCode   = SBG_NO_ERROR;
+            expected[i].nrTrials    = 1;
+            expected[i].answerTrial = 1;
+
+            cmdAsyncCheckSubmit(&context, i, CMD_ASYNC_CHECK_FIRST_MSG_ID, SBG_ECOM_CMD_ASYNC_REPLY_ANSWER, CMD_ASYNC_CHECK_ACTION_HOLD, 1, CMD_ASYNC_CHECK_LONG_TIME_OUT);
+        }
+
+        start = sbgGetTime();
+
+        while ((nrErrors == 0) && (nrCompleted < CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS))
+        {
+            size_t              nrInFlight;
+
+            sbgEComCmdAsyncProcess(&context.async);
+
+            nrCompleted = CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS - sbgEComCmdAsyncGetNrActive(&context.async);
+            nrInFlight  = context.nrReceived - nrCompleted;
+
+            if (nrInFlight > CMD_ASYNC_CHECK_WINDOW_SIZE)
+            {
+                printf("window: %zu requests in flight\n", nrInFlight);
+                nrErrors++;
+            }
+            else if (nrInFlight == context.nrHeld)
+            {
+                //
+                // All the released replies have been handled, the window must be full again
+                //
+                if (nrInFlight != sbgMin(CMD_ASYNC_CHECK_WINDOW_SIZE, CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS - nrCompleted))
+                {
+                    printf("window: %zu requests in flight with %zu requests to complete\n", nrInFlight, CMD_ASYNC_CHECK_NR_WINDOW_REQUESTS - nrCompleted);
+                    nrErrors++;
+                }
+
+                for (size_t i = 0; i < context.nrHeld; i++)
+                {
+                    if (context.held[i].command.tag != nextTag)
+                    {
+                        printf("window: request %" PRIu32 " sent instead of %" PRIu32 "\n", context.held[i].command.tag, nextTag);
+                        nrErrors++;
+                    }
+
+                    nextTag++;
+                }
+
+                cmdAsyncCheckRelease(&context, false);
+            }
+            else
+            {
+                sbgSleep(1);
+            }
+
+            if ((sbgGetTime() - start) > CMD_ASYNC_CHECK_MAX_DURATION)
+            {
+                printf("window: requests not completed\n");
+                nrErrors++;
+            }
+        }
+
+        if (nrErrors == 0)
+        {
+            nrErrors += cmdAsyncCheckPopAll(&context, "window", expected, SBG_ARRAY_SIZE(expected), true);
+        }
+
+        cmdAsyncCheckClose(&context);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Run all the checks.
+ *
+ * \param[in]   useReader               True to receive the frames with the reader thread.
+ * \return                              Number of errors.
+ */
+static size_t cmdAsyncCheckRun(bool useReader)
+{
+    size_t                  nrErrors = 0;
+
+    nrErrors += cmdAsyncCheckRetries(useReader);
+    nrErrors += cmdAsyncCheckAcks(useReader);
+    nrErrors += cmdAsyncCheckCompletionOrder(useReader);
+    nrErrors += cmdAsyncCheckWindow(useReader);
+
+    //
+    // The reader thread may route the late answer and the next answer separately, the next request
+    // could then be sent in between and take the next answer, as a device answering late would
+    //
+    if (!useReader)
+    {
+        nrErrors += cmdAsyncCheckLateAnswer(useReader);
+    }
+
+    printf("%s: %zu errors\n", useReader ? "reader thread" : "no reader thread", nrErrors);
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += cmdAsyncCheckRun(false);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    nrErrors += cmdAsyncCheckRun(true);
+#else
+    printf("threads are disabled, the reader thread isn't checked\n");
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
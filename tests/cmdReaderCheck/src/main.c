@@ -0,0 +1,534 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the routing of command frames by the reader thread.
+ *
+ * A memory interface is given a responder that acknowledges and answers set and get model ID
+ * commands, dropping the first trial of some of them. Several threads send these commands while
+ * logs are streamed and handled: each value read back must be the one set by the same thread,
+ * dropped commands must be resent, and logs must be received in order.
+ *
+ * A frame awaited as a reply must go to the thread waiting for it and not to a thread waiting for
+ * any frame, and a frame nobody waits for must be kept in the mailbox.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+#include "testResponder.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define CMD_READER_CHECK_NR_THREADS         (4)             /*!< Number of threads sending commands. */
+#define CMD_READER_CHECK_NR_COMMANDS        (30)            /*!< Number of set and get commands sent by each thread. */
+#define CMD_READER_CHECK_DROP_PERIOD        (7)             /*!< Number of commands from a thread between two dropped commands. */
+#define CMD_READER_CHECK_FIRST_MSG_ID       (0x60)          /*!< Message ID of the first thread, unknown to the library. */
+#define CMD_READER_CHECK_CMD_TIME_OUT       (100)           /*!< Command time out, in ms. */
+#define CMD_READER_CHECK_LOG_BURST          (4)             /*!< Number of logs streamed every ms. */
+#define CMD_READER_CHECK_WAITER_DELAY       (100)           /*!< Time given to the waiting threads to wait, in ms. */
+#define CMD_READER_CHECK_WAIT_TIME_OUT      (1000)          /*!< Time out of the waiting threads, in ms. */
+#define CMD_READER_CHECK_TIME_OUT           (10000)         /*!< Maximum duration of a check, in ms. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Check context.
+ */
+typedef struct _CmdReaderCheckContext
+{
+    SbgInterface            interface;                      /*!< Memory interface. */
+    SbgEComHandle           handle;                         /*!< sbgECom handle. */
+    TestResponder           responder;                      /*!< Scripted device. */
+    uint32_t                modelIds[CMD_READER_CHECK_NR_THREADS];  /*!< Model ID set by each thread. */
+    size_t                  nrCommands[CMD_READER_CHECK_NR_THREADS];    /*!< Number of commands received from each thread, dropped ones included. */
+    size_t                  nrDropped;                      /*!< Number of dropped commands. */
+    volatile size_t         stop;                           /*!< Set to stop streaming logs. */
+    volatile size_t         nrThreadsDone;                  /*!< Number of threads done sending commands. */
+    size_t                  nrLogsSent;                     /*!< Number of logs streamed. */
+    size_t                  nrLogsReceived;                 /*!< Number of logs received. */
+    uint32_t                nextTimeStamp;                  /*!< Minimum time stamp of the next log received. */
+    size_t                  nrErrors;                       /*!< Number of errors of the log callback. */
+} CmdReaderCheckContext;
+
+/*!
+ * Thread sending commands.
+ */
+typedef struct _CmdReaderCheckSender
+{
+    CmdReaderCheckContext  *pContext;                       /*!< Check context. */
+    size_t                  index;                          /*!< Thread index. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+    SbgThread              *pThread;                        /*!< Thread. */
+} CmdReaderCheckSender;
+
+/*!
+ * Thread waiting for a command frame.
+ */
+typedef struct _CmdReaderCheckWaiter
+{
+    SbgEComHandle          *pHandle;                        /*!< sbgECom handle. */
+    bool                    matchAny;                       /*!< True to wait for any command frame, false for a reply. */
+    uint8_t                 msgId;                          /*!< Message ID of the reply. */
+    SbgErrorCode            errorCode;                      /*!< Reception result. */
+    uint8_t                 receivedMsgId;                  /*!< Message ID of the received frame. */
+    SbgThread              *pThread;                        /*!< Thread. */
+} CmdReaderCheckWaiter;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Script callback, reply to the set and get model ID commands.
+ *
+ * The responder is called with the transmission mutex of the reader held, one command at a time.
+ *
+ * \param[in]   pResponder              Responder.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   pUserArg                Check context.
+ */
+static void cmdReaderCheckOnCommand(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, const uint8_t *pPayload, size_t size, void *pUserArg)
+{
+    CmdReaderCheckContext  *pContext = pUserArg;
+    size_t                  index;
+
+    assert(pContext);
+
+    index = (size_t)msgId - CMD_READER_CHECK_FIRST_MSG_ID;
+
+    if ((msgClass == SBG_ECOM_CLASS_LOG_CMD_0) && (index < CMD_READER_CHECK_NR_THREADS))
+    {
+        pContext->nrCommands[index]++;
+
+        //
+        // The first trial of a command is dropped regularly, it must be resent
+        //
+        if ((pContext->nrCommands[index] % CMD_READER_CHECK_DROP_PERIOD) == 0)
+        {
+            pContext->nrDropped++;
+        }
+        else if (size == sizeof(uint32_t))
+        {
+            memcpy(&pContext->modelIds[index], pPayload, sizeof(uint32_t));
+            testResponderSendAck(pResponder, msgClass, msgId, SBG_NO_ERROR);
+        }
+        else if (size == 0)
+        {
+            testResponderSend(pResponder, msgClass, msgId, &pContext->modelIds[index], sizeof(uint32_t));
+        }
+    }
+}
+
+/*!
+ * Log callback, check that the logs are received in order.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode cmdReaderCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    CmdReaderCheckContext  *pContext = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pContext);
+    assert(pLogData);
+
+    if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != SBG_ECOM_LOG_IMU_SHORT) || (pLogData->imuShort.timeStamp < pContext->nextTimeStamp))
+    {
+        printf("log %zu received out of order\n", pContext->nrLogsReceived);
+        pContext->nrErrors++;
+    }
+    else
+    {
+        pContext->nextTimeStamp = pLogData->imuShort.timeStamp + 1;
+    }
+
+    pContext->nrLogsReceived++;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Stream IMU short logs until stopped.
+ *
+ * \param[in]   pArg                    Check context.
+ */
+static void cmdReaderCheckStream(void *pArg)
+{
+    CmdReaderCheckContext  *pContext = pArg;
+
+    assert(pContext);
+
+    while (sbgAtomicLoad(&pContext->stop) == 0)
+    {
+        for (size_t i = 0; i < CMD_READER_CHECK_LOG_BURST; i++)
+        {
+            SbgEComLogImuShort  imuShort;
+            SbgStreamBuffer     streamBuffer;
+            uint8_t             payload[64];
+
+            memset(&imuShort, 0, sizeof(imuShort));
+            imuShort.timeStamp = (uint32_t)pContext->nrLogsSent;
+
+            sbgStreamBufferInitForWrite(&streamBuffer, payload, sizeof(payload));
+            sbgEComLogImuShortWriteToStream(&imuShort, &streamBuffer);
+
+            if (testResponderSend(&pContext->responder, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, payload, sbgStreamBufferGetLength(&streamBuffer)) == SBG_NO_ERROR)
+            {
+                pContext->nrLogsSent++;
+            }
+        }
+
+        sbgSleep(1);
+    }
+}
+
+/*!
+ * Set and get the model ID of a thread, checking each value read back.
+ *
+ * \param[in]   pArg                    Sender.
+ */
+static void cmdReaderCheckSend(void *pArg)
+{
+    CmdReaderCheckSender   *pSender = pArg;
+    uint8_t                 msgId;
+
+    assert(pSender);
+
+    msgId = (uint8_t)(CMD_READER_CHECK_FIRST_MSG_ID + pSender->index);
+
+    for (uint32_t i = 0; i < CMD_READER_CHECK_NR_COMMANDS; i++)
+    {
+        SbgErrorCode        errorCode;
+        uint32_t            modelId;
+        uint32_t            readModelId = 0;
+
+        modelId = (uint32_t)(pSender->index << 16) | i;
+
+        errorCode = sbgEComCmdGenericSetModelId(&pSender->pContext->handle, SBG_ECOM_CLASS_LOG_CMD_0, msgId, modelId);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComCmdGenericGetModelId(&pSender->pContext->handle, SBG_ECOM_CLASS_LOG_CMD_0, msgId, &readModelId);
+        }
+
+        if ((errorCode != SBG_NO_ERROR) || (readModelId != modelId))
+        {
+            printf("thread %zu: %s, model ID %#" PRIx32 " read instead of %#" PRIx32 "\n", pSender->index, sbgErrorCodeToString(errorCode), readModelId, modelId);
+            pSender->nrErrors++;
+        }
+    }
+
+    sbgAtomicAdd(&pSender->pContext->nrThreadsDone, 1);
+}
+
+/*!
+ * Wait for a command frame.
+ *
+ * \param[in]   pArg                    Waiter.
+ */
+static void cmdReaderCheckWait(void *pArg)
+{
+    CmdReaderCheckWaiter   *pWaiter = pArg;
+    SbgEComProtocolPayload  payload;
+    uint8_t                 receivedMsgClass;
+
+    assert(pWaiter);
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    if (pWaiter->matchAny)
+    {
+        pWaiter->errorCode = sbgEComReceiveAnyCmd2(pWaiter->pHandle, &receivedMsgClass, &pWaiter->receivedMsgId, &payload, CMD_READER_CHECK_WAIT_TIME_OUT);
+    }
+    else
+    {
+        pWaiter->errorCode      = sbgEComReceiveCmd2(pWaiter->pHandle, SBG_ECOM_CLASS_LOG_CMD_0, pWaiter->msgId, &payload, CMD_READER_CHECK_WAIT_TIME_OUT);
+        pWaiter->receivedMsgId  = pWaiter->msgId;
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+}
+
+/*!
+ * Check that the command frames are routed to the threads waiting for them when they are received.
+ *
+ * A frame awaited as a reply must not go to a thread waiting for any frame, and a frame nobody
+ * waits for must be kept in the mailbox.
+ *
+ * \param[in]   pContext                Check context, with the reader thread running.
+ * \return                              Number of errors.
+ */
+static size_t cmdReaderCheckRouting(CmdReaderCheckContext *pContext)
+{
+    CmdReaderCheckWaiter    replyWaiter;
+    CmdReaderCheckWaiter    anyWaiter;
+    SbgEComProtocolPayload  payload;
+    SbgErrorCode            errorCode;
+    uint8_t                 data = 0;
+    size_t                  nrErrors = 0;
+
+    assert(pContext);
+
+    memset(&replyWaiter, 0, sizeof(replyWaiter));
+    memset(&anyWaiter, 0, sizeof(anyWaiter));
+
+    replyWaiter.pHandle = &pContext->handle;
+    replyWaiter.msgId   = CMD_READER_CHECK_FIRST_MSG_ID;
+
+    anyWaiter.pHandle   = &pContext->handle;
+    anyWaiter.matchAny  = true;
+
+    if ((sbgThreadCreate(&replyWaiter.pThread, cmdReaderCheckWait, &replyWaiter) == SBG_NO_ERROR) &&
+        (sbgThreadCreate(&anyWaiter.pThread, cmdReaderCheckWait, &anyWaiter) == SBG_NO_ERROR))
+    {
+        sbgSleep(CMD_READER_CHECK_WAITER_DELAY);
+
+        testResponderSend(&pContext->responder, SBG_ECOM_CLASS_LOG_CMD_0, CMD_READER_CHECK_FIRST_MSG_ID, &data, sizeof(data));
+        testResponderSend(&pContext->responder, SBG_ECOM_CLASS_LOG_CMD_0, CMD_READER_CHECK_FIRST_MSG_ID + 1, &data, sizeof(data));
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    if (replyWaiter.pThread)
+    {
+        sbgThreadJoin(replyWaiter.pThread);
+    }
+
+    if (anyWaiter.pThread)
+    {
+        sbgThreadJoin(anyWaiter.pThread);
+    }
+
+    if ((replyWaiter.errorCode != SBG_NO_ERROR) || (anyWaiter.errorCode != SBG_NO_ERROR) || (anyWaiter.receivedMsgId != CMD_READER_CHECK_FIRST_MSG_ID + 1))
+    {
+        printf("routing: reply %s, any %s with message %u\n", sbgErrorCodeToString(replyWaiter.errorCode), sbgErrorCodeToString(anyWaiter.errorCode), anyWaiter.receivedMsgId);
+        nrErrors++;
+    }
+
+    //
+    // The frame is received while no thread waits for it
+    //
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    testResponderSend(&pContext->responder, SBG_ECOM_CLASS_LOG_CMD_0, CMD_READER_CHECK_FIRST_MSG_ID + 2, &data, sizeof(data));
+    sbgSleep(CMD_READER_CHECK_WAITER_DELAY);
+
+    errorCode = sbgEComReceiveCmd2(&pContext->handle, SBG_ECOM_CLASS_LOG_CMD_0, CMD_READER_CHECK_FIRST_MSG_ID + 2, &payload, 0);
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        printf("routing: %s for a frame kept in the mailbox\n", sbgErrorCodeToString(errorCode));
+        nrErrors++;
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return nrErrors;
+}
+
+/*!
+ * Send commands from several threads while logs are streamed and handled.
+ *
+ * \param[in]   pContext                Check context, with the reader thread running.
+ * \return                              Number of errors.
+ */
+static size_t cmdReaderCheckConcurrentCommands(CmdReaderCheckContext *pContext)
+{
+    CmdReaderCheckSender    senders[CMD_READER_CHECK_NR_THREADS];
+    SbgThread              *pStreamThread = NULL;
+    SbgEComFrameRingStats   stats;
+    uint32_t                startTime;
+    size_t                  nrErrors = 0;
+
+    assert(pContext);
+
+    memset(senders, 0, sizeof(senders));
+    memset(&stats, 0, sizeof(stats));
+
+    sbgEComSetCmdTrialsAndTimeOut(&pContext->handle, 3, CMD_READER_CHECK_CMD_TIME_OUT);
+    sbgEComSetReceiveLogCallback(&pContext->handle, cmdReaderCheckOnLogReceived, pContext);
+
+    if (sbgThreadCreate(&pStreamThread, cmdReaderCheckStream, pContext) != SBG_NO_ERROR)
+    {
+        nrErrors++;
+    }
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(senders); i++)
+    {
+        senders[i].pContext = pContext;
+        senders[i].index    = i;
+
+        if (sbgThreadCreate(&senders[i].pThread, cmdReaderCheckSend, &senders[i]) != SBG_NO_ERROR)
+        {
+            sbgAtomicAdd(&pContext->nrThreadsDone, 1);
+            nrErrors++;
+        }
+    }
+
+    //
+    // Logs are handled while the commands are sent
+    //
+    startTime = sbgGetTime();
+
+    while ((sbgAtomicLoad(&pContext->nrThreadsDone) < SBG_ARRAY_SIZE(senders)) && ((sbgGetTime() - startTime) < CMD_READER_CHECK_TIME_OUT))
+    {
+        sbgEComHandle(&pContext->handle);
+        sbgEComWaitFrame(&pContext->handle, 10);
+    }
+
+    sbgAtomicStore(&pContext->stop, 1);
+
+    if (pStreamThread)
+    {
+        sbgThreadJoin(pStreamThread);
+    }
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(senders); i++)
+    {
+        if (senders[i].pThread)
+        {
+            sbgThreadJoin(senders[i].pThread);
+        }
+
+        nrErrors += senders[i].nrErrors;
+    }
+
+    //
+    // Logs received plus logs dropped by the ring must account for all the logs streamed
+    //
+    while ((pContext->nrLogsReceived + stats.nrDroppedFrames < pContext->nrLogsSent) && ((sbgGetTime() - startTime) < CMD_READER_CHECK_TIME_OUT))
+    {
+        sbgEComHandle(&pContext->handle);
+        sbgEComWaitFrame(&pContext->handle, 10);
+        sbgEComGetReaderStats(&pContext->handle, &stats);
+    }
+
+    if ((pContext->nrLogsReceived == 0) || (pContext->nrLogsReceived + stats.nrDroppedFrames != pContext->nrLogsSent))
+    {
+        printf("%zu logs received and %zu dropped, %zu sent\n", pContext->nrLogsReceived, stats.nrDroppedFrames, pContext->nrLogsSent);
+        nrErrors++;
+    }
+
+    if (pContext->nrDropped == 0)
+    {
+        printf("no command dropped\n");
+        nrErrors++;
+    }
+
+    nrErrors += pContext->nrErrors;
+
+    printf("%zu logs received, %zu dropped by the ring, %zu commands dropped and resent\n", pContext->nrLogsReceived, stats.nrDroppedFrames, pContext->nrDropped);
+
+    return nrErrors;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    {
+        static CmdReaderCheckContext    context;
+        SbgErrorCode                    errorCode;
+
+        errorCode = testInterfaceMemoryCreate(&context.interface, 0);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComInit(&context.handle, &context.interface);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                testResponderConstruct(&context.responder, &context.interface, cmdReaderCheckOnCommand, &context);
+
+                errorCode = sbgEComStartReader(&context.handle, NULL);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    nrErrors += cmdReaderCheckRouting(&context);
+                    nrErrors += cmdReaderCheckConcurrentCommands(&context);
+
+                    sbgEComStopReader(&context.handle);
+                }
+
+                sbgEComClose(&context.handle);
+            }
+
+            sbgInterfaceDestroy(&context.interface);
+        }
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            SBG_LOG_ERROR(errorCode, "unable to run the check");
+            nrErrors++;
+        }
+    }
+#else
+    printf("threads are disabled, the command routing of the reader thread isn't checked\n");
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// Local headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Memory interface handle.
+ */
+typedef struct _TestInterfaceMemory
+{
+    uint8_t                             *pBuffer;                   /*!< Bytes written, allocated with malloc(). */
+    size_t                               size;                      /*!< Number of bytes written. */
+    size_t                               capacity;                  /*!< Buffer capacity, in bytes. */
+    size_t                               readOffset;                /*!< Offset of the next byte to read. */
+    size_t                               maxReadSize;               /*!< Maximum number of bytes returned by each read, 0 for no limit. */
+    uint32_t                             randomState;               /*!< State of the read size generator. */
+    TestInterfaceMemoryWriteFunc         pWriteCallback;            /*!< Callback receiving the bytes written, NULL to append them. */
+    void                                *pWriteUserArg;             /*!< User argument passed to the write callback. */
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    SbgMutex                            *pMutex;                    /*!< Protects the buffer. */
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+} TestInterfaceMemory;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Lock a memory interface, if threads are enabled.
+ *
+ * \param[in]   pMemory                 Memory interface handle.
+ */
+static void testInterfaceMemoryLock(const TestInterfaceMemory *pMemory)
+{
+    assert(pMemory);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    sbgMutexLock(pMemory->pMutex);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+}
+
+/*!
+ * Unlock a memory interface, if threads are enabled.
+ *
+ * \param[in]   pMemory                 Memory interface handle.
+ */
+static void testInterfaceMemoryUnlock(const TestInterfaceMemory *pMemory)
+{
+    assert(pMemory);
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    sbgMutexUnlock(pMemory->pMutex);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+}
+
+/*!
+ * Destroy a memory interface.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode testInterfaceMemoryDestroy(SbgInterface *pInterface)
+{
+    TestInterfaceMemory                 *pMemory;
+
+    assert(pInterface);
+
+    pMemory = pInterface->handle;
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+    sbgMutexDestroy(pMemory->pMutex);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+    free(pMemory->pBuffer);
+    free(pMemory);
+
+    sbgInterfaceZeroInit(pInterface);
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Write bytes to the interface, they are passed to the write callback or appended to the bytes to read.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   pBuffer                 Bytes to write.
+ * \param[in]   bytesToWrite            Number of bytes to write.
+ * \return                              SBG_NO_ERROR if the bytes have been written.
+ */
+static SbgErrorCode testInterfaceMemoryWrite(SbgInterface *pInterface, const void *pBuffer, size_t bytesToWrite)
+{
+    SbgErrorCode                         errorCode;
+    TestInterfaceMemory                 *pMemory;
+
+    assert(pInterface);
+    assert(pBuffer || (bytesToWrite == 0));
+
+    pMemory = pInterface->handle;
+
+    if (pMemory->pWriteCallback)
+    {
+        errorCode = pMemory->pWriteCallback(pInterface, pBuffer, bytesToWrite, pMemory->pWriteUserArg);
+    }
+    else
+    {
+        errorCode = testInterfaceMemoryAppend(pInterface, pBuffer, bytesToWrite);
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Read bytes from the memory buffer.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[out]  pReadBytes              Number of bytes read.
+ * \param[in]   bytesToRead             Maximum number of bytes to read.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode testInterfaceMemoryRead(SbgInterface *pInterface, void *pBuffer, size_t *pReadBytes, size_t bytesToRead)
+{
+    TestInterfaceMemory                 *pMemory;
+    size_t                               size;
+
+    assert(pInterface);
+    assert(pBuffer);
+    assert(pReadBytes);
+
+    pMemory = pInterface->handle;
+
+    testInterfaceMemoryLock(pMemory);
+
+    size = sbgMin(bytesToRead, pMemory->size - pMemory->readOffset);
+
+    if (pMemory->maxReadSize != 0)
+    {
+        pMemory->randomState ^= pMemory->randomState << 13;
+        pMemory->randomState ^= pMemory->randomState >> 17;
+        pMemory->randomState ^= pMemory->randomState << 5;
+
+        size = sbgMin(size, (pMemory->randomState % pMemory->maxReadSize) + 1);
+    }
+
+    if (size != 0)
+    {
+        memcpy(pBuffer, &pMemory->pBuffer[pMemory->readOffset], size);
+    }
+
+    pMemory->readOffset += size;
+    *pReadBytes         = size;
+
+    testInterfaceMemoryUnlock(pMemory);
+
+    return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+SbgErrorCode testInterfaceMemoryCreate(SbgInterface *pInterface, size_t maxReadSize)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    TestInterfaceMemory                 *pMemory;
+
+    assert(pInterface);
+
+    sbgInterfaceZeroInit(pInterface);
+
+    pMemory = calloc(1, sizeof(*pMemory));
+
+    if (pMemory)
+    {
+#if SBG_CONFIG_ENABLE_THREADS != 0
+        errorCode = sbgMutexCreate(&pMemory->pMutex);
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        pMemory->maxReadSize    = maxReadSize;
+        pMemory->randomState    = 0x13579bdf;
+
+        pInterface->handle          = pMemory;
+        pInterface->type            = TEST_IF_TYPE_MEMORY;
+        pInterface->pDestroyFunc    = testInterfaceMemoryDestroy;
+        pInterface->pWriteFunc      = testInterfaceMemoryWrite;
+        pInterface->pReadFunc       = testInterfaceMemoryRead;
+
+        sbgInterfaceNameSet(pInterface, "memory");
+    }
+    else
+    {
+        free(pMemory);
+        SBG_LOG_ERROR(errorCode, "unable to allocate memory interface");
+    }
+
+    return errorCode;
+}
+
+size_t testInterfaceMemoryGetNrPendingBytes(const SbgInterface *pInterface)
+{
+    const TestInterfaceMemory           *pMemory;
+    size_t                               nrPendingBytes;
+
+    assert(pInterface);
+
+    pMemory = pInterface->handle;
+
+    testInterfaceMemoryLock(pMemory);
+    nrPendingBytes = pMemory->size - pMemory->readOffset;
+    testInterfaceMemoryUnlock(pMemory);
+
+    return nrPendingBytes;
+}
+
+void testInterfaceMemorySetWriteCallback(SbgInterface *pInterface, TestInterfaceMemoryWriteFunc pWriteCallback, void *pUserArg)
+{
+    TestInterfaceMemory                 *pMemory;
+
+    assert(pInterface);
+
+    pMemory = pInterface->handle;
+
+    pMemory->pWriteCallback = pWriteCallback;
+    pMemory->pWriteUserArg  = pUserArg;
+}
+
+SbgErrorCode testInterfaceMemoryAppend(SbgInterface *pInterface, const void *pBuffer, size_t size)
+{
+    SbgErrorCode                         errorCode = SBG_NO_ERROR;
+    TestInterfaceMemory                 *pMemory;
+
+    assert(pInterface);
+    assert(pBuffer || (size == 0));
+
+    pMemory = pInterface->handle;
+
+    testInterfaceMemoryLock(pMemory);
+
+    if ((pMemory->size + size) > pMemory->capacity)
+    {
+        size_t                           capacity;
+        uint8_t                         *pNewBuffer;
+
+        capacity    = sbgMax(pMemory->capacity * 2, pMemory->size + size);
+        pNewBuffer  = realloc(pMemory->pBuffer, capacity);
+
+        if (pNewBuffer)
+        {
+            pMemory->pBuffer    = pNewBuffer;
+            pMemory->capacity   = capacity;
+        }
+        else
+        {
+            errorCode = SBG_MALLOC_FAILED;
+        }
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        if (size != 0)
+        {
+            memcpy(&pMemory->pBuffer[pMemory->size], pBuffer, size);
+        }
+
+        pMemory->size += size;
+    }
+
+    testInterfaceMemoryUnlock(pMemory);
+
+    return errorCode;
+}
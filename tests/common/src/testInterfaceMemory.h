@@ -0,0 +1,115 @@
+/*!
+ * \file            testInterfaceMemory.h
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Memory interface used by the tests.
+ *
+ * Bytes written to the interface are appended to a memory buffer, and read back in
+ * pseudo random chunks, to exercise the frame parsing at every buffer position.
+ * A write callback can instead receive the bytes written, to script the answers
+ * of a device. The interface is thread safe when threads are enabled.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+#ifndef TEST_INTERFACE_MEMORY_H
+#define TEST_INTERFACE_MEMORY_H
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define TEST_IF_TYPE_MEMORY                 (SBG_IF_TYPE_LAST_RESERVED + 1)     /*!< Memory interface type. */
+
+//----------------------------------------------------------------------//
+//- Callbacks definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Callback receiving the bytes written to a memory interface, instead of appending them to the bytes to read.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   pBuffer                 Bytes written.
+ * \param[in]   size                    Number of bytes written.
+ * \param[in]   pUserArg                User argument.
+ * \return                              SBG_NO_ERROR if the bytes have been handled.
+ */
+typedef SbgErrorCode (*TestInterfaceMemoryWriteFunc)(SbgInterface *pInterface, const void *pBuffer, size_t size, void *pUserArg);
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Create a memory interface.
+ *
+ * The interface must be destroyed with sbgInterfaceDestroy().
+ *
+ * \param[out]  pInterface              Interface.
+ * \param[in]   maxReadSize             Maximum number of bytes returned by each read, 0 for no limit.
+ * \return                              SBG_NO_ERROR if the interface has been created.
+ */
+SbgErrorCode testInterfaceMemoryCreate(SbgInterface *pInterface, size_t maxReadSize);
+
+/*!
+ * Get the number of bytes written and not read yet.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \return                              Number of bytes left to read.
+ */
+size_t testInterfaceMemoryGetNrPendingBytes(const SbgInterface *pInterface);
+
+/*!
+ * Set the callback receiving the bytes written to the interface.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   pWriteCallback          Write callback, NULL to append the bytes written to the bytes to read.
+ * \param[in]   pUserArg                User argument passed to the callback.
+ */
+void testInterfaceMemorySetWriteCallback(SbgInterface *pInterface, TestInterfaceMemoryWriteFunc pWriteCallback, void *pUserArg);
+
+/*!
+ * Append bytes to read, from any thread.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   pBuffer                 Bytes to append.
+ * \param[in]   size                    Number of bytes to append.
+ * \return                              SBG_NO_ERROR if the bytes have been appended.
+ */
+SbgErrorCode testInterfaceMemoryAppend(SbgInterface *pInterface, const void *pBuffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_INTERFACE_MEMORY_H
@@ -0,0 +1,192 @@
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <crc/sbgCrc.h>
+
+// Project headers
+#include <sbgEComIds.h>
+
+// Local headers
+#include "testInterfaceMemory.h"
+#include "testResponder.h"
+
+//----------------------------------------------------------------------//
+//- Private definitions                                                -//
+//----------------------------------------------------------------------//
+
+#define TEST_RESPONDER_HEADER_SIZE          (6)                         /*!< Sync bytes, message ID, class and payload size. */
+#define TEST_RESPONDER_FOOTER_SIZE          (3)                         /*!< CRC and end of frame byte. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Parse the frames received, and pass them to the script callback.
+ *
+ * Bytes that don't start a valid frame are skipped.
+ *
+ * \param[in]   pResponder              Responder.
+ */
+static void testResponderParse(TestResponder *pResponder)
+{
+    size_t                               offset = 0;
+    bool                                 incomplete = false;
+
+    assert(pResponder);
+
+    while (!incomplete && ((pResponder->size - offset) >= (TEST_RESPONDER_HEADER_SIZE + TEST_RESPONDER_FOOTER_SIZE)))
+    {
+        const uint8_t                   *pFrame = &pResponder->buffer[offset];
+        size_t                           payloadSize;
+        size_t                           frameSize;
+
+        payloadSize = pFrame[4] | (pFrame[5] << 8);
+        frameSize   = TEST_RESPONDER_HEADER_SIZE + payloadSize + TEST_RESPONDER_FOOTER_SIZE;
+
+        if ((pFrame[0] != SBG_ECOM_SYNC_1) || (pFrame[1] != SBG_ECOM_SYNC_2) || (payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE))
+        {
+            offset++;
+        }
+        else if ((pResponder->size - offset) < frameSize)
+        {
+            incomplete = true;
+        }
+        else
+        {
+            uint16_t                     crc;
+
+            crc = pFrame[TEST_RESPONDER_HEADER_SIZE + payloadSize] | (pFrame[TEST_RESPONDER_HEADER_SIZE + payloadSize + 1] << 8);
+
+            if ((crc == sbgCrc16Compute(&pFrame[2], TEST_RESPONDER_HEADER_SIZE - 2 + payloadSize)) && (pFrame[frameSize - 1] == SBG_ECOM_ETX))
+            {
+                pResponder->nrFrames++;
+                pResponder->pFunc(pResponder, pFrame[3], pFrame[2], &pFrame[TEST_RESPONDER_HEADER_SIZE], payloadSize, pResponder->pUserArg);
+
+                offset += frameSize;
+            }
+            else
+            {
+                offset++;
+            }
+        }
+    }
+
+    pResponder->size -= offset;
+    memmove(pResponder->buffer, &pResponder->buffer[offset], pResponder->size);
+}
+
+/*!
+ * Memory interface write callback, store the bytes written and parse the complete frames.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   pBuffer                 Bytes written.
+ * \param[in]   size                    Number of bytes written.
+ * \param[in]   pUserArg                Responder.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode testResponderOnWrite(SbgInterface *pInterface, const void *pBuffer, size_t size, void *pUserArg)
+{
+    TestResponder                       *pResponder = pUserArg;
+    const uint8_t                       *pBytes = pBuffer;
+
+    SBG_UNUSED_PARAMETER(pInterface);
+
+    assert(pResponder);
+
+    while (size != 0)
+    {
+        size_t                           copySize;
+
+        copySize = sbgMin(size, sizeof(pResponder->buffer) - pResponder->size);
+
+        memcpy(&pResponder->buffer[pResponder->size], pBytes, copySize);
+
+        pResponder->size    += copySize;
+        pBytes              += copySize;
+        size                -= copySize;
+
+        testResponderParse(pResponder);
+
+        //
+        // A full buffer without a complete frame can't hold a valid frame
+        //
+        if (pResponder->size == sizeof(pResponder->buffer))
+        {
+            pResponder->size = 0;
+        }
+    }
+
+    return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+void testResponderConstruct(TestResponder *pResponder, SbgInterface *pInterface, TestResponderFunc pFunc, void *pUserArg)
+{
+    assert(pResponder);
+    assert(pInterface);
+    assert(pFunc);
+
+    memset(pResponder, 0, sizeof(*pResponder));
+
+    pResponder->pInterface  = pInterface;
+    pResponder->pFunc       = pFunc;
+    pResponder->pUserArg    = pUserArg;
+
+    testInterfaceMemorySetWriteCallback(pInterface, testResponderOnWrite, pResponder);
+}
+
+SbgErrorCode testResponderSend(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t size)
+{
+    SbgErrorCode                         errorCode = SBG_INVALID_PARAMETER;
+
+    assert(pResponder);
+    assert(pPayload || (size == 0));
+
+    if (size <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+    {
+        uint8_t                          frame[TEST_RESPONDER_HEADER_SIZE + SBG_ECOM_MAX_PAYLOAD_SIZE + TEST_RESPONDER_FOOTER_SIZE];
+        uint16_t                         crc;
+
+        frame[0]    = SBG_ECOM_SYNC_1;
+        frame[1]    = SBG_ECOM_SYNC_2;
+        frame[2]    = msgId;
+        frame[3]    = msgClass;
+        frame[4]    = (uint8_t)size;
+        frame[5]    = (uint8_t)(size >> 8);
+
+        if (size != 0)
+        {
+            memcpy(&frame[TEST_RESPONDER_HEADER_SIZE], pPayload, size);
+        }
+
+        crc = sbgCrc16Compute(&frame[2], TEST_RESPONDER_HEADER_SIZE - 2 + size);
+
+        frame[TEST_RESPONDER_HEADER_SIZE + size]        = (uint8_t)crc;
+        frame[TEST_RESPONDER_HEADER_SIZE + size + 1]    = (uint8_t)(crc >> 8);
+        frame[TEST_RESPONDER_HEADER_SIZE + size + 2]    = SBG_ECOM_ETX;
+
+        errorCode = testInterfaceMemoryAppend(pResponder->pInterface, frame, TEST_RESPONDER_HEADER_SIZE + size + TEST_RESPONDER_FOOTER_SIZE);
+    }
+
+    return errorCode;
+}
+
+SbgErrorCode testResponderSendAck(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, SbgErrorCode errorCode)
+{
+    uint8_t                              payload[4];
+
+    assert(pResponder);
+
+    //
+    // The ACK payload contains the acknowledged message ID and class, and a uint16_t for the error code
+    //
+    payload[0]  = msgId;
+    payload[1]  = msgClass;
+    payload[2]  = (uint8_t)errorCode;
+    payload[3]  = (uint8_t)((uint16_t)errorCode >> 8);
+
+    return testResponderSend(pResponder, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, payload, sizeof(payload));
+}
@@ -0,0 +1,124 @@
+/*!
+ * \file            testResponder.h
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Scripted device responder used by the command tests.
+ *
+ * The responder receives the frames written to a memory interface and passes
+ * them to a script callback, which answers by appending frames to read.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+#ifndef TEST_RESPONDER_H
+#define TEST_RESPONDER_H
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterface.h>
+
+// Project headers
+#include <protocol/sbgEComProtocol.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Responder pre-definition.
+ */
+typedef struct _TestResponder TestResponder;
+
+/*!
+ * Script callback, called for each frame written to the interface, in the thread writing it.
+ *
+ * \param[in]   pResponder              Responder.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   pUserArg                User argument.
+ */
+typedef void (*TestResponderFunc)(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, const uint8_t *pPayload, size_t size, void *pUserArg);
+
+/*!
+ * Responder.
+ */
+struct _TestResponder
+{
+    SbgInterface                        *pInterface;                /*!< Memory interface. */
+    TestResponderFunc                    pFunc;                     /*!< Script callback. */
+    void                                *pUserArg;                  /*!< User argument passed to the script callback. */
+    uint8_t                              buffer[SBG_ECOM_MAX_BUFFER_SIZE];  /*!< Bytes written and not parsed yet. */
+    size_t                               size;                      /*!< Number of bytes in the buffer. */
+    size_t                               nrFrames;                  /*!< Number of frames received. */
+};
+
+//----------------------------------------------------------------------//
+//- Public methods                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Responder constructor, the frames written to the memory interface are passed to the script callback.
+ *
+ * \param[out]  pResponder              Responder.
+ * \param[in]   pInterface              Memory interface created with testInterfaceMemoryCreate().
+ * \param[in]   pFunc                   Script callback.
+ * \param[in]   pUserArg                User argument passed to the script callback.
+ */
+void testResponderConstruct(TestResponder *pResponder, SbgInterface *pInterface, TestResponderFunc pFunc, void *pUserArg);
+
+/*!
+ * Send a frame, from any thread.
+ *
+ * \param[in]   pResponder              Responder.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload, may be NULL if size is 0.
+ * \param[in]   size                    Payload size, in bytes.
+ * \return                              SBG_NO_ERROR if the frame has been sent.
+ */
+SbgErrorCode testResponderSend(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t size);
+
+/*!
+ * Send an ACK, from any thread.
+ *
+ * \param[in]   pResponder              Responder.
+ * \param[in]   msgClass                Message class of the acknowledged command.
+ * \param[in]   msgId                   Message ID of the acknowledged command.
+ * \param[in]   errorCode               Error code reported.
+ * \return                              SBG_NO_ERROR if the ACK has been sent.
+ */
+SbgErrorCode testResponderSendAck(TestResponder *pResponder, uint8_t msgClass, uint8_t msgId, SbgErrorCode errorCode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TEST_RESPONDER_H
@@ -0,0 +1,232 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the CRC16 and CRC32 implementations against bitwise references.
+ *
+ * CRCs are computed over random data of every length up to a few hundred bytes, at every
+ * alignment, and compared to bit by bit implementations. CRCs computed in several updates
+ * are compared to the CRCs computed at once.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <crc/sbgCrc.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define CRC_CHECK_MAX_LENGTH                (300)           /*!< Maximum length of the data the CRCs are computed over. */
+#define CRC_CHECK_MAX_ALIGNMENT             (8)             /*!< Number of data alignments checked. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Compute a CRC16 bit by bit.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC16.
+ */
+static uint16_t crcCheckReferenceCrc16(const uint8_t *pData, size_t dataSize)
+{
+    uint16_t            crc = 0;
+
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        crc ^= pData[i];
+
+        for (size_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+/*!
+ * Update a CRC32 bit by bit with a byte.
+ *
+ * \param[in]   crc                     CRC32.
+ * \param[in]   byte                    Byte.
+ * \return                              Updated CRC32.
+ */
+static uint32_t crcCheckReferenceCrc32Update(uint32_t crc, uint8_t byte)
+{
+    crc ^= (uint32_t)byte << 24;
+
+    for (size_t bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04C11DB7) : (crc << 1);
+    }
+
+    return crc;
+}
+
+/*!
+ * Compute a CRC32 bit by bit.
+ *
+ * The data is processed as 32-bit words in reversed byte order, the remaining bytes in reversed order.
+ *
+ * \param[in]   pData                   Data.
+ * \param[in]   dataSize                Data size, in bytes.
+ * \return                              CRC32.
+ */
+static uint32_t crcCheckReferenceCrc32(const uint8_t *pData, size_t dataSize)
+{
+    uint32_t            crc = 0xFFFFFFFF;
+    size_t              nrWordBytes;
+
+    nrWordBytes = dataSize & ~(size_t)0x03;
+
+    for (size_t i = 0; i < nrWordBytes; i++)
+    {
+        crc = crcCheckReferenceCrc32Update(crc, pData[i ^ 0x03]);
+    }
+
+    for (size_t i = dataSize; i > nrWordBytes; i--)
+    {
+        crc = crcCheckReferenceCrc32Update(crc, pData[i - 1]);
+    }
+
+    return crc;
+}
+
+/*!
+ * Fill a buffer with pseudo random bytes.
+ *
+ * \param[out]  pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ */
+static void crcCheckFillRandom(uint8_t *pBuffer, size_t size)
+{
+    uint32_t            state = 0x12345678;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        state       = state * 1664525 + 1013904223;
+        pBuffer[i]  = (uint8_t)(state >> 24);
+    }
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static uint8_t      buffer[CRC_CHECK_MAX_LENGTH + CRC_CHECK_MAX_ALIGNMENT];
+    size_t              nrErrors = 0;
+    size_t              nrChecks = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    crcCheckFillRandom(buffer, sizeof(buffer));
+
+    //
+    // CRC16 check value, this CRC is also known as CRC-16/KERMIT
+    //
+    if (sbgCrc16Compute("123456789", 9) != 0x2189)
+    {
+        printf("CRC16 check value mismatch\n");
+        nrErrors++;
+    }
+
+    for (size_t alignment = 0; alignment < CRC_CHECK_MAX_ALIGNMENT; alignment++)
+    {
+        for (size_t length = 0; length <= CRC_CHECK_MAX_LENGTH; length++)
+        {
+            const uint8_t      *pData = &buffer[alignment];
+
+            if (sbgCrc16Compute(pData, length) != crcCheckReferenceCrc16(pData, length))
+            {
+                printf("CRC16 mismatch, alignment %zu length %zu\n", alignment, length);
+                nrErrors++;
+            }
+
+            if (sbgCrc32Compute(pData, length) != crcCheckReferenceCrc32(pData, length))
+            {
+                printf("CRC32 mismatch, alignment %zu length %zu\n", alignment, length);
+                nrErrors++;
+            }
+
+            nrChecks += 2;
+        }
+    }
+
+    //
+    // CRCs updated in two parts, CRC32 updates are only equivalent when split on 32-bit words
+    //
+    for (size_t split = 0; split <= CRC_CHECK_MAX_LENGTH; split++)
+    {
+        SbgCrc16        crc16;
+        SbgCrc32        crc32;
+
+        sbgCrc16Initialize(&crc16);
+        sbgCrc16Update(&crc16, buffer, split);
+        sbgCrc16Update(&crc16, &buffer[split], CRC_CHECK_MAX_LENGTH - split);
+
+        if (sbgCrc16Get(&crc16) != crcCheckReferenceCrc16(buffer, CRC_CHECK_MAX_LENGTH))
+        {
+            printf("CRC16 mismatch, split at %zu\n", split);
+            nrErrors++;
+        }
+
+        nrChecks++;
+
+        if ((split % 4) == 0)
+        {
+            sbgCrc32Initialize(&crc32);
+            sbgCrc32Update(&crc32, buffer, split);
+            sbgCrc32Update(&crc32, &buffer[split], CRC_CHECK_MAX_LENGTH - split);
+
+            if (sbgCrc32Get(&crc32) != crcCheckReferenceCrc32(buffer, CRC_CHECK_MAX_LENGTH))
+            {
+                printf("CRC32 mismatch, split at %zu\n", split);
+                nrErrors++;
+            }
+
+            nrChecks++;
+        }
+    }
+
+    printf("%zu CRC checks, %zu errors\n", nrChecks, nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,510 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the log decoder registry.
+ *
+ * Each built-in decoder must decode a payload of its minimum size without reading past its end,
+ * and payloads out of its size bounds must be rejected. Decoders registered for a proprietary
+ * class, overriding or removing a built-in log, must be used until the registry is reset, and
+ * invalid registrations, including any for the command class, must be rejected. Frames of a
+ * proprietary class must reach the log callback of a handle once a decoder is registered.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define REGISTRY_CHECK_MAX_PAYLOAD_SIZE     (8192)          /*!< Size of the payload buffer, in bytes. */
+#define REGISTRY_CHECK_CUSTOM_CLASS         (0x20)          /*!< Proprietary message class. */
+#define REGISTRY_CHECK_CUSTOM_ID            (5)             /*!< Proprietary message ID. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Proprietary log.
+ */
+typedef struct _RegistryCheckLog
+{
+    uint32_t                value;                          /*!< Value. */
+    uint32_t                magic;                          /*!< Set by the decoder. */
+} RegistryCheckLog;
+
+/*!
+ * Logs received by a handle.
+ */
+typedef struct _RegistryCheckReception
+{
+    size_t                  nrLogs;                         /*!< Number of logs received. */
+    SbgEComClass            msgClass;                       /*!< Message class of the last log. */
+    SbgEComMsgId            msgId;                          /*!< Message ID of the last log. */
+    RegistryCheckLog        log;                            /*!< Last log, if proprietary. */
+} RegistryCheckReception;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Payload, large enough for any built-in log.
+ */
+static uint8_t              gRegistryCheckPayload[REGISTRY_CHECK_MAX_PAYLOAD_SIZE];
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log function, discarding the errors reported for rejected payloads.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void registryCheckOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Decode a proprietary log.
+ *
+ * \param[out]  pLogData                Log data.
+ * \param[in]   pStreamBuffer           Input stream buffer.
+ * \return                              SBG_NO_ERROR if the log has been decoded.
+ */
+static SbgErrorCode registryCheckDecode(void *pLogData, SbgStreamBuffer *pStreamBuffer)
+{
+    RegistryCheckLog       *pLog = pLogData;
+
+    pLog->value = sbgStreamBufferReadUint32LE(pStreamBuffer);
+    pLog->magic = 0x600dc0de;
+
+    return sbgStreamBufferGetLastError(pStreamBuffer);
+}
+
+/*!
+ * Log callback.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log data.
+ * \param[in]   pUserArg                Reception.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode registryCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    RegistryCheckReception *pReception = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pReception);
+
+    pReception->nrLogs++;
+    pReception->msgClass    = msgClass;
+    pReception->msgId       = msgId;
+
+    if (msgClass == REGISTRY_CHECK_CUSTOM_CLASS)
+    {
+        memcpy(&pReception->log, pLogData, sizeof(pReception->log));
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Parse a built-in log from a zero payload.
+ *
+ * Session information pages are only valid with a consistent page header.
+ *
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[out]  pLogData                Log data.
+ * \return                              Decoder result.
+ */
+static SbgErrorCode registryCheckParse(SbgEComClass msgClass, SbgEComMsgId msgId, size_t size, SbgEComLogUnion *pLogData)
+{
+    SbgErrorCode            errorCode;
+
+    assert(size <= sizeof(gRegistryCheckPayload));
+
+    memset(gRegistryCheckPayload, 0, sizeof(gRegistryCheckPayload));
+
+    if ((msgClass == SBG_ECOM_CLASS_LOG_ECOM_0) && (msgId == SBG_ECOM_LOG_SESSION_INFO) && (size >= 6))
+    {
+        SbgStreamBuffer     outputStream;
+
+        sbgStreamBufferInitForWrite(&outputStream, gRegistryCheckPayload, size);
+        sbgStreamBufferWriteUint16LE(&outputStream, 0);
+        sbgStreamBufferWriteUint16LE(&outputStream, 1);
+        sbgStreamBufferWriteUint16LE(&outputStream, (uint16_t)(size - 6));
+    }
+
+    errorCode = sbgEComLogParse(msgClass, msgId, gRegistryCheckPayload, size, pLogData);
+
+    memset(gRegistryCheckPayload, 0, sizeof(gRegistryCheckPayload));
+
+    return errorCode;
+}
+
+/*!
+ * Check the payload size bounds of the built-in decoders.
+ *
+ * Payloads of the minimum size must be decoded without reading past their end, and payloads
+ * out of the bounds must be rejected before decoding.
+ *
+ * \return                              Number of errors.
+ */
+static size_t registryCheckBuiltInDecoders(void)
+{
+    static const SbgEComClass   msgClasses[] = { SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_CLASS_LOG_ECOM_1 };
+    size_t                      nrDecoders = 0;
+    size_t                      nrErrors = 0;
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(msgClasses); i++)
+    {
+        for (size_t msgId = 0; msgId < SBG_ECOM_LOG_DECODER_NR_MSG_IDS; msgId++)
+        {
+            const SbgEComLogDecoder *pDecoder;
+
+            pDecoder = sbgEComLogGetDecoder(msgClasses[i], (SbgEComMsgId)msgId);
+
+            if (pDecoder)
+            {
+                SbgEComLogUnion         logData;
+                size_t                  minSize;
+
+                nrDecoders++;
+                minSize = sbgMax(pDecoder->minSize, 1);
+
+                if ((pDecoder->dataSize == 0) || (pDecoder->dataSize > sizeof(SbgEComLogUnion)))
+                {
+                    printf("log %#zx:%#zx: invalid data size %zu\n", (size_t)msgClasses[i], msgId, pDecoder->dataSize);
+                    nrErrors++;
+                }
+
+                if (registryCheckParse(msgClasses[i], (SbgEComMsgId)msgId, minSize, &logData) != SBG_NO_ERROR)
+                {
+                    printf("log %#zx:%#zx: payload of minimum size %zu not decoded\n", (size_t)msgClasses[i], msgId, minSize);
+                    nrErrors++;
+                }
+
+                if ((minSize > 1) && (registryCheckParse(msgClasses[i], (SbgEComMsgId)msgId, minSize - 1, &logData) != SBG_INVALID_FRAME))
+                {
+                    printf("log %#zx:%#zx: payload below minimum size not rejected\n", (size_t)msgClasses[i], msgId);
+                    nrErrors++;
+                }
+
+                if (pDecoder->maxSize != SBG_ECOM_LOG_DECODER_NO_MAX_SIZE)
+                {
+                    if ((pDecoder->maxSize + 1) > sizeof(gRegistryCheckPayload))
+                    {
+                        printf("log %#zx:%#zx: maximum size %zu too large\n", (size_t)msgClasses[i], msgId, pDecoder->maxSize);
+                        nrErrors++;
+                    }
+                    else if ((registryCheckParse(msgClasses[i], (SbgEComMsgId)msgId, pDecoder->maxSize, &logData) != SBG_NO_ERROR) ||
+                             (registryCheckParse(msgClasses[i], (SbgEComMsgId)msgId, pDecoder->maxSize + 1, &logData) != SBG_INVALID_FRAME))
+                    {
+                        printf("log %#zx:%#zx: maximum size %zu not enforced\n", (size_t)msgClasses[i], msgId, pDecoder->maxSize);
+                        nrErrors++;
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Some well known logs must be supported, and unknown ones rejected.
+    //
+    if (!sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME) || !sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV) ||
+        !sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_FAST_IMU_DATA) || sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, 200) ||
+        sbgEComLogGetDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID) || sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK))
+    {
+        printf("built-in decoders: unexpected table content\n");
+        nrErrors++;
+    }
+
+    printf("%zu built-in decoders\n", nrDecoders);
+
+    return nrErrors;
+}
+
+/*!
+ * Check decoder registration, overrides and reset.
+ *
+ * \return                              Number of errors.
+ */
+static size_t registryCheckRegistration(void)
+{
+    SbgEComLogDecoder       decoder;
+    SbgEComLogDecoder       invalidDecoder;
+    SbgEComLogUnion         logData;
+    RegistryCheckLog       *pLog = (RegistryCheckLog *)&logData;
+    uint8_t                 payload[8] = { 0x78, 0x56, 0x34, 0x12 };
+    size_t                  nrErrors = 0;
+
+    decoder.pDecodeFunc = registryCheckDecode;
+    decoder.minSize     = 4;
+    decoder.maxSize     = 4;
+    decoder.dataSize    = sizeof(RegistryCheckLog);
+
+    //
+    // Invalid registrations.
+    //
+    invalidDecoder = decoder;
+    invalidDecoder.pDecodeFunc = NULL;
+
+    if (sbgEComLogRegisterDecoder(SBG_ECOM_LOG_DECODER_NR_CLASSES, 0, &decoder) != SBG_INVALID_PARAMETER)
+    {
+        printf("registration: invalid class accepted\n");
+        nrErrors++;
+    }
+
+    if (sbgEComLogRegisterDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, &invalidDecoder) != SBG_INVALID_PARAMETER)
+    {
+        printf("registration: decoder without function accepted\n");
+        nrErrors++;
+    }
+
+    invalidDecoder = decoder;
+    invalidDecoder.minSize = 5;
+
+    if (sbgEComLogRegisterDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, &invalidDecoder) != SBG_INVALID_PARAMETER)
+    {
+        printf("registration: decoder with invalid size bounds accepted\n");
+        nrErrors++;
+    }
+
+    //
+    // Command frames, and ACKs in particular, must never be handled as logs.
+    //
+    if (sbgEComLogRegisterDecoder(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, &decoder) != SBG_INVALID_PARAMETER)
+    {
+        printf("registration: command class accepted\n");
+        nrErrors++;
+    }
+
+    invalidDecoder = decoder;
+    invalidDecoder.dataSize = sizeof(SbgEComLogUnion) + 1;
+
+    if (sbgEComLogRegisterDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, &invalidDecoder) != SBG_INVALID_PARAMETER)
+    {
+        printf("registration: decoder larger than the log union accepted\n");
+        nrErrors++;
+    }
+
+    //
+    // Proprietary class.
+    //
+    if ((sbgEComLogRegisterDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, &decoder) != SBG_NO_ERROR) ||
+        (sbgEComLogGetDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID) == NULL) ||
+        (sbgEComLogGetDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID + 1) != NULL))
+    {
+        printf("registration: proprietary decoder not registered\n");
+        nrErrors++;
+    }
+
+    memset(&logData, 0, sizeof(logData));
+
+    if ((sbgEComLogParse(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, payload, 4, &logData) != SBG_NO_ERROR) ||
+        (pLog->value != 0x12345678) || (pLog->magic != 0x600dc0de) ||
+        (sbgEComLogParse(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, payload, 5, &logData) != SBG_INVALID_FRAME))
+    {
+        printf("registration: proprietary log not decoded\n");
+        nrErrors++;
+    }
+
+    //
+    // Built-in override and removal, without effect on the other logs of the class.
+    //
+    decoder.maxSize = SBG_ECOM_LOG_DECODER_NO_MAX_SIZE;
+    memset(&logData, 0, sizeof(logData));
+
+    if ((sbgEComLogRegisterDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, &decoder) != SBG_NO_ERROR) ||
+        (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, payload, sizeof(payload), &logData) != SBG_NO_ERROR) ||
+        (pLog->magic != 0x600dc0de))
+    {
+        printf("registration: built-in decoder not overridden\n");
+        nrErrors++;
+    }
+
+    if ((sbgEComLogRegisterDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS, NULL) != SBG_NO_ERROR) ||
+        (sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS) != NULL) ||
+        (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS, gRegistryCheckPayload, 64, &logData) != SBG_ERROR))
+    {
+        printf("registration: built-in decoder not removed\n");
+        nrErrors++;
+    }
+
+    if (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, gRegistryCheckPayload, 72, &logData) != SBG_NO_ERROR)
+    {
+        printf("registration: other built-in decoder affected\n");
+        nrErrors++;
+    }
+
+    //
+    // Reset.
+    //
+    sbgEComLogResetDecoders();
+
+    memset(&logData, 0, sizeof(logData));
+
+    if ((sbgEComLogGetDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID) != NULL) ||
+        (sbgEComLogGetDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS) == NULL) ||
+        (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, gRegistryCheckPayload, 64, &logData) != SBG_NO_ERROR) ||
+        (pLog->magic == 0x600dc0de))
+    {
+        printf("reset: built-in decoders not restored\n");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check that frames of a proprietary class with a registered decoder reach the log callback.
+ *
+ * \return                              Number of errors.
+ */
+static size_t registryCheckHandle(void)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComHandle           handle;
+    RegistryCheckReception  reception;
+    SbgEComLogDecoder       decoder;
+    static const uint8_t    payload[4] = { 0x04, 0x03, 0x02, 0x01 };
+    size_t                  nrErrors = 0;
+
+    decoder.pDecodeFunc = registryCheckDecode;
+    decoder.minSize     = 4;
+    decoder.maxSize     = 4;
+    decoder.dataSize    = sizeof(RegistryCheckLog);
+
+    memset(&reception, 0, sizeof(reception));
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComSetReceiveLogCallback(&handle, registryCheckOnLogReceived, &reception);
+
+            //
+            // Without decoder, the frame isn't a log.
+            //
+            sbgEComProtocolSend(&handle.protocolHandle, REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, payload, sizeof(payload));
+            sbgEComHandle(&handle);
+
+            if (reception.nrLogs != 0)
+            {
+                printf("handle: unregistered proprietary frame received as a log\n");
+                nrErrors++;
+            }
+
+            sbgEComLogRegisterDecoder(REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, &decoder);
+
+            sbgEComProtocolSend(&handle.protocolHandle, REGISTRY_CHECK_CUSTOM_CLASS, REGISTRY_CHECK_CUSTOM_ID, payload, sizeof(payload));
+            sbgEComHandle(&handle);
+
+            if ((reception.nrLogs != 1) || (reception.msgClass != REGISTRY_CHECK_CUSTOM_CLASS) || (reception.msgId != REGISTRY_CHECK_CUSTOM_ID) ||
+                (reception.log.value != 0x01020304) || (reception.log.magic != 0x600dc0de))
+            {
+                printf("handle: proprietary log not received\n");
+                nrErrors++;
+            }
+
+            sbgEComLogResetDecoders();
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to check the handle");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(registryCheckOnLog);
+
+    nrErrors += registryCheckBuiltInDecoders();
+    nrErrors += registryCheckRegistration();
+    nrErrors += registryCheckHandle();
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
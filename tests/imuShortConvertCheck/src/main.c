@@ -0,0 +1,245 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the IMU short batch conversions against the getters.
+ *
+ * Random IMU short records, including extreme values and both gyroscope scale factors, are
+ * converted with sbgEComLogImuShortConvert() and the column conversions. Results must be bit
+ * identical to the getters, whatever the instruction set used.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define IMU_CHECK_MAX_RECORDS               (200)           /*!< Maximum number of records converted at once. */
+#define IMU_CHECK_MAX_OFFSET                (4)             /*!< Number of column offsets checked. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t imuCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill IMU short records with pseudo random values, the first ones with extreme values.
+ *
+ * \param[out]  pImuShorts              IMU short records.
+ * \param[in]   nrRecords               Number of records.
+ */
+static void imuCheckFillRecords(SbgEComLogImuShort *pImuShorts, size_t nrRecords)
+{
+    static const int32_t    extremes[] = { INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX - 1, INT32_MAX };
+    uint32_t                state = 0x2468ace0;
+
+    for (size_t i = 0; i < nrRecords; i++)
+    {
+        SbgEComLogImuShort     *pImuShort = &pImuShorts[i];
+
+        pImuShort->timeStamp    = (uint32_t)i;
+        pImuShort->status       = (uint16_t)imuCheckRandom(&state);
+        pImuShort->temperature  = (int16_t)imuCheckRandom(&state);
+
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            if (i < SBG_ARRAY_SIZE(extremes))
+            {
+                pImuShort->deltaVelocity[axis]  = extremes[i];
+                pImuShort->deltaAngle[axis]     = extremes[(i + axis) % SBG_ARRAY_SIZE(extremes)];
+            }
+            else
+            {
+                pImuShort->deltaVelocity[axis]  = (int32_t)imuCheckRandom(&state);
+                pImuShort->deltaAngle[axis]     = (int32_t)imuCheckRandom(&state) >> (imuCheckRandom(&state) % 24);
+            }
+        }
+
+        if (i < SBG_ARRAY_SIZE(extremes))
+        {
+            pImuShort->temperature = (int16_t)(extremes[i] >> 16);
+        }
+    }
+}
+
+/*!
+ * Compare two floats bit for bit.
+ *
+ * \param[in]   value                   Value.
+ * \param[in]   expected                Expected value.
+ * \return                              True if both floats are bit identical.
+ */
+static bool imuCheckIsIdentical(float value, float expected)
+{
+    return memcmp(&value, &expected, sizeof(value)) == 0;
+}
+
+/*!
+ * Check the record conversions.
+ *
+ * \param[in]   pImuShorts              IMU short records.
+ * \param[in]   nrRecords               Number of records.
+ * \return                              Number of values not identical to the getters.
+ */
+static size_t imuCheckRecords(const SbgEComLogImuShort *pImuShorts, size_t nrRecords)
+{
+    static float            deltaVelocities[IMU_CHECK_MAX_RECORDS][3];
+    static float            deltaAngles[IMU_CHECK_MAX_RECORDS][3];
+    static float            temperatures[IMU_CHECK_MAX_RECORDS];
+    size_t                  nrErrors = 0;
+
+    sbgEComLogImuShortConvert(pImuShorts, nrRecords, deltaVelocities, deltaAngles, temperatures);
+
+    for (size_t i = 0; i < nrRecords; i++)
+    {
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            if (!imuCheckIsIdentical(deltaVelocities[i][axis], sbgEComLogImuShortGetDeltaVelocity(&pImuShorts[i], axis)))
+            {
+                printf("delta velocity mismatch, %zu records, record %zu axis %zu\n", nrRecords, i, axis);
+                nrErrors++;
+            }
+
+            if (!imuCheckIsIdentical(deltaAngles[i][axis], sbgEComLogImuShortGetDeltaAngle(&pImuShorts[i], axis)))
+            {
+                printf("delta angle mismatch, %zu records, record %zu axis %zu\n", nrRecords, i, axis);
+                nrErrors++;
+            }
+        }
+
+        if (!imuCheckIsIdentical(temperatures[i], sbgEComLogImuShortGetTemperature(&pImuShorts[i])))
+        {
+            printf("temperature mismatch, %zu records, record %zu\n", nrRecords, i);
+            nrErrors++;
+        }
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the column conversions, with columns starting at a given offset.
+ *
+ * \param[in]   pImuShorts              IMU short records.
+ * \param[in]   nrRecords               Number of records.
+ * \param[in]   offset                  Offset of the first value in the columns.
+ * \return                              Number of values not identical to the getters.
+ */
+static size_t imuCheckColumns(const SbgEComLogImuShort *pImuShorts, size_t nrRecords, size_t offset)
+{
+    static int32_t          deltaVelocities[IMU_CHECK_MAX_RECORDS + IMU_CHECK_MAX_OFFSET];
+    static int32_t          deltaAngles[IMU_CHECK_MAX_RECORDS + IMU_CHECK_MAX_OFFSET];
+    static uint16_t         status[IMU_CHECK_MAX_RECORDS + IMU_CHECK_MAX_OFFSET];
+    static int16_t          temperatures[IMU_CHECK_MAX_RECORDS + IMU_CHECK_MAX_OFFSET];
+    static float            outputs[3][IMU_CHECK_MAX_RECORDS + IMU_CHECK_MAX_OFFSET];
+    size_t                  nrErrors = 0;
+
+    for (size_t i = 0; i < nrRecords; i++)
+    {
+        deltaVelocities[offset + i] = pImuShorts[i].deltaVelocity[0];
+        deltaAngles[offset + i]     = pImuShorts[i].deltaAngle[0];
+        status[offset + i]          = pImuShorts[i].status;
+        temperatures[offset + i]    = pImuShorts[i].temperature;
+    }
+
+    sbgEComLogImuShortConvertDeltaVelocities(&deltaVelocities[offset], nrRecords, &outputs[0][offset]);
+    sbgEComLogImuShortConvertDeltaAngles(&deltaAngles[offset], &status[offset], nrRecords, &outputs[1][offset]);
+    sbgEComLogImuShortConvertTemperatures(&temperatures[offset], nrRecords, &outputs[2][offset]);
+
+    for (size_t i = 0; i < nrRecords; i++)
+    {
+        if (!imuCheckIsIdentical(outputs[0][offset + i], sbgEComLogImuShortGetDeltaVelocity(&pImuShorts[i], 0)) ||
+            !imuCheckIsIdentical(outputs[1][offset + i], sbgEComLogImuShortGetDeltaAngle(&pImuShorts[i], 0)) ||
+            !imuCheckIsIdentical(outputs[2][offset + i], sbgEComLogImuShortGetTemperature(&pImuShorts[i])))
+        {
+            printf("column mismatch, %zu records at offset %zu, record %zu\n", nrRecords, offset, i);
+            nrErrors++;
+        }
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static SbgEComLogImuShort   imuShorts[IMU_CHECK_MAX_RECORDS];
+    size_t                      nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    imuCheckFillRecords(imuShorts, SBG_ARRAY_SIZE(imuShorts));
+
+    //
+    // Every number of records, to cover the vector bodies and their scalar tails
+    //
+    for (size_t nrRecords = 0; nrRecords <= IMU_CHECK_MAX_RECORDS; nrRecords++)
+    {
+        nrErrors += imuCheckRecords(imuShorts, nrRecords);
+
+        for (size_t offset = 0; offset < IMU_CHECK_MAX_OFFSET; offset++)
+        {
+            nrErrors += imuCheckColumns(imuShorts, nrRecords, offset);
+        }
+    }
+
+    printf("IMU short conversions checked up to %d records, %zu errors\n", IMU_CHECK_MAX_RECORDS, nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
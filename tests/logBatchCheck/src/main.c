@@ -0,0 +1,582 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the columnar batch decoder against the log decoders.
+ *
+ * A capture of IMU, EKF navigation, unsupported and invalid logs is decoded in batches, log by
+ * log, from a buffer and from an interface read in random chunks. The tables are compared bit
+ * for bit to the records decoded log by log with the regular decoders and getters.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+#include <logs/sbgEComLogBatch.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define BATCH_CHECK_NR_LOGS                 (20000)         /*!< Number of logs in the capture. */
+#define BATCH_CHECK_MAX_PAYLOAD_SIZE        (128)           /*!< Maximum payload size of the logs, in bytes. */
+#define BATCH_CHECK_MAX_READ_SIZE           (300)           /*!< Maximum number of bytes read at once. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log of the capture.
+ */
+typedef struct _BatchCheckLog
+{
+    SbgEComMsgId            msgId;                          /*!< Message ID. */
+    size_t                  size;                           /*!< Payload size, in bytes. */
+    uint8_t                 payload[BATCH_CHECK_MAX_PAYLOAD_SIZE];  /*!< Payload. */
+} BatchCheckLog;
+
+/*!
+ * IMU record expected in the IMU table.
+ */
+typedef struct _BatchCheckImuRecord
+{
+    uint32_t                timeStamp;                      /*!< Time stamp. */
+    uint16_t                status;                         /*!< IMU status. */
+    float                   accelerometers[3];              /*!< Accelerometers. */
+    float                   gyroscopes[3];                  /*!< Gyroscopes. */
+    float                   temperature;                    /*!< Temperature. */
+} BatchCheckImuRecord;
+
+/*!
+ * Capture and the tables expected once it is decoded.
+ */
+typedef struct _BatchCheckCapture
+{
+    BatchCheckLog          *pLogs;                          /*!< Logs. */
+    BatchCheckImuRecord    *pImuRecords;                    /*!< Expected IMU records. */
+    size_t                  nrImuRecords;                   /*!< Number of expected IMU records. */
+    SbgEComLogEkfNav       *pEkfNavRecords;                 /*!< Expected EKF navigation records. */
+    size_t                  nrEkfNavRecords;                /*!< Number of expected EKF navigation records. */
+    size_t                  nrIgnoredFrames;                /*!< Number of unsupported logs. */
+    size_t                  nrInvalidFrames;                /*!< Number of invalid logs. */
+} BatchCheckCapture;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t batchCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Build a log filled with pseudo random values.
+ *
+ * Bytes are chosen so that floating point values are finite.
+ *
+ * \param[out]  pLog                    Log.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the log has been built.
+ */
+static SbgErrorCode batchCheckBuildLog(BatchCheckLog *pLog, SbgEComMsgId msgId, uint32_t *pState)
+{
+    SbgErrorCode            errorCode;
+    SbgStreamBuffer         streamBuffer;
+    SbgEComLogUnion         logData;
+    uint8_t                *pBytes = (uint8_t *)&logData;
+
+    assert(pLog);
+
+    for (size_t i = 0; i < sizeof(logData); i++)
+    {
+        pBytes[i] = (uint8_t)(0x10 + (batchCheckRandom(pState) % 0x30));
+    }
+
+    pLog->msgId = msgId;
+
+    sbgStreamBufferInitForWrite(&streamBuffer, pLog->payload, sizeof(pLog->payload));
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_IMU_DATA:
+        errorCode = sbgEComLogImuLegacyWriteToStream(&logData.imuData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_IMU_SHORT:
+        logData.imuShort.status         = (uint16_t)batchCheckRandom(pState);
+        logData.imuShort.temperature    = (int16_t)batchCheckRandom(pState);
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            logData.imuShort.deltaVelocity[i]   = (int32_t)batchCheckRandom(pState);
+            logData.imuShort.deltaAngle[i]      = (int32_t)batchCheckRandom(pState);
+        }
+
+        errorCode = sbgEComLogImuShortWriteToStream(&logData.imuShort, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_EKF_NAV:
+        errorCode = sbgEComLogEkfNavWriteToStream(&logData.ekfNavData, &streamBuffer);
+        break;
+    default:
+        errorCode = sbgEComLogUtcWriteToStream(&logData.utcData, &streamBuffer);
+    }
+
+    pLog->size = sbgStreamBufferGetLength(&streamBuffer);
+
+    return errorCode;
+}
+
+/*!
+ * Add the records a log is expected to produce.
+ *
+ * \param[in]   pCapture                Capture.
+ * \param[in]   pLog                    Log, it must be valid.
+ * \return                              SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode batchCheckAddExpected(BatchCheckCapture *pCapture, const BatchCheckLog *pLog)
+{
+    SbgErrorCode            errorCode;
+    SbgEComLogUnion         logData;
+
+    assert(pCapture);
+    assert(pLog);
+
+    errorCode = sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, pLog->msgId, pLog->payload, pLog->size, &logData);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        BatchCheckImuRecord    *pImuRecord = &pCapture->pImuRecords[pCapture->nrImuRecords];
+
+        switch (pLog->msgId)
+        {
+        case SBG_ECOM_LOG_IMU_DATA:
+            pImuRecord->timeStamp   = logData.imuData.timeStamp;
+            pImuRecord->status      = logData.imuData.status;
+            pImuRecord->temperature = logData.imuData.temperature;
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pImuRecord->accelerometers[i]   = logData.imuData.accelerometers[i];
+                pImuRecord->gyroscopes[i]       = logData.imuData.gyroscopes[i];
+            }
+
+            pCapture->nrImuRecords++;
+            break;
+        case SBG_ECOM_LOG_IMU_SHORT:
+            pImuRecord->timeStamp   = logData.imuShort.timeStamp;
+            pImuRecord->status      = logData.imuShort.status;
+            pImuRecord->temperature = sbgEComLogImuShortGetTemperature(&logData.imuShort);
+
+            for (size_t i = 0; i < 3; i++)
+            {
+                pImuRecord->accelerometers[i]   = sbgEComLogImuShortGetDeltaVelocity(&logData.imuShort, i);
+                pImuRecord->gyroscopes[i]       = sbgEComLogImuShortGetDeltaAngle(&logData.imuShort, i);
+            }
+
+            pCapture->nrImuRecords++;
+            break;
+        case SBG_ECOM_LOG_EKF_NAV:
+            pCapture->pEkfNavRecords[pCapture->nrEkfNavRecords] = logData.ekfNavData;
+            pCapture->nrEkfNavRecords++;
+            break;
+        default:
+            pCapture->nrIgnoredFrames++;
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Compare two floats bit for bit.
+ *
+ * \param[in]   value1                  First value.
+ * \param[in]   value2                  Second value.
+ * \return                              True if they are identical.
+ */
+static bool batchCheckSameFloat(float value1, float value2)
+{
+    return memcmp(&value1, &value2, sizeof(value1)) == 0;
+}
+
+/*!
+ * Compare two doubles bit for bit.
+ *
+ * \param[in]   value1                  First value.
+ * \param[in]   value2                  Second value.
+ * \return                              True if they are identical.
+ */
+static bool batchCheckSameDouble(double value1, double value2)
+{
+    return memcmp(&value1, &value2, sizeof(value1)) == 0;
+}
+
+/*!
+ * Compare the tables of a batch decoder to the expected records.
+ *
+ * \param[in]   pCapture                Capture.
+ * \param[in]   pBatch                  Batch decoder the capture has been decoded with.
+ * \param[in]   pName                   Decoding method, for error messages.
+ * \return                              Number of errors.
+ */
+static size_t batchCheckCompare(const BatchCheckCapture *pCapture, const SbgEComLogBatch *pBatch, const char *pName)
+{
+    const SbgEComLogImuColumns         *pImu = &pBatch->imu;
+    const SbgEComLogEkfNavColumns      *pEkfNav = &pBatch->ekfNav;
+    size_t                              nrErrors = 0;
+
+    assert(pCapture);
+    assert(pBatch);
+
+    if ((pBatch->nrFrames != BATCH_CHECK_NR_LOGS) || (pBatch->nrIgnoredFrames != pCapture->nrIgnoredFrames) || (pBatch->nrInvalidFrames != pCapture->nrInvalidFrames) ||
+        (pImu->nrRecords != pCapture->nrImuRecords) || (pEkfNav->nrRecords != pCapture->nrEkfNavRecords))
+    {
+        printf("%s: %zu frames, %zu ignored, %zu invalid, %zu IMU and %zu EKF records, %d, %zu, %zu, %zu and %zu expected\n", pName,
+               pBatch->nrFrames, pBatch->nrIgnoredFrames, pBatch->nrInvalidFrames, pImu->nrRecords, pEkfNav->nrRecords,
+               BATCH_CHECK_NR_LOGS, pCapture->nrIgnoredFrames, pCapture->nrInvalidFrames, pCapture->nrImuRecords, pCapture->nrEkfNavRecords);
+        nrErrors++;
+    }
+    else
+    {
+        for (size_t i = 0; i < pImu->nrRecords; i++)
+        {
+            const BatchCheckImuRecord  *pRecord = &pCapture->pImuRecords[i];
+            bool                        match;
+
+            match = (pImu->pTimeStamps[i] == pRecord->timeStamp) && (pImu->pStatus[i] == pRecord->status) && batchCheckSameFloat(pImu->pTemperatures[i], pRecord->temperature);
+
+            for (size_t j = 0; j < 3; j++)
+            {
+                match = match && batchCheckSameFloat(pImu->pAccelerometers[j][i], pRecord->accelerometers[j]) && batchCheckSameFloat(pImu->pGyroscopes[j][i], pRecord->gyroscopes[j]);
+            }
+
+            if (!match)
+            {
+                printf("%s: IMU record %zu mismatch\n", pName, i);
+                nrErrors++;
+            }
+        }
+
+        for (size_t i = 0; i < pEkfNav->nrRecords; i++)
+        {
+            const SbgEComLogEkfNav     *pRecord = &pCapture->pEkfNavRecords[i];
+            bool                        match;
+
+            match = (pEkfNav->pTimeStamps[i] == pRecord->timeStamp) && (pEkfNav->pStatus[i] == pRecord->status) && batchCheckSameFloat(pEkfNav->pUndulations[i], pRecord->undulation);
+
+            for (size_t j = 0; j < 3; j++)
+            {
+                match = match && batchCheckSameFloat(pEkfNav->pVelocities[j][i], pRecord->velocity[j]) && batchCheckSameFloat(pEkfNav->pVelocityStdDevs[j][i], pRecord->velocityStdDev[j]) &&
+                        batchCheckSameDouble(pEkfNav->pPositions[j][i], pRecord->position[j]) && batchCheckSameFloat(pEkfNav->pPositionStdDevs[j][i], pRecord->positionStdDev[j]);
+            }
+
+            if (!match)
+            {
+                printf("%s: EKF navigation record %zu mismatch\n", pName, i);
+                nrErrors++;
+            }
+        }
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Build a capture of pseudo random logs.
+ *
+ * IMU short logs are the most frequent, so that their blocks are converted both full and partial,
+ * some supported logs are truncated to be invalid, and some logs aren't supported.
+ *
+ * \param[out]  pCapture                Capture.
+ * \return                              SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode batchCheckBuildCapture(BatchCheckCapture *pCapture)
+{
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    uint32_t                state = 0xba7c4ed0;
+
+    assert(pCapture);
+
+    memset(pCapture, 0, sizeof(*pCapture));
+
+    pCapture->pLogs             = malloc(BATCH_CHECK_NR_LOGS * sizeof(*pCapture->pLogs));
+    pCapture->pImuRecords       = malloc(BATCH_CHECK_NR_LOGS * sizeof(*pCapture->pImuRecords));
+    pCapture->pEkfNavRecords    = malloc(BATCH_CHECK_NR_LOGS * sizeof(*pCapture->pEkfNavRecords));
+
+    if (!pCapture->pLogs || !pCapture->pImuRecords || !pCapture->pEkfNavRecords)
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    for (size_t i = 0; (i < BATCH_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+    {
+        static const SbgEComMsgId   supportedMsgIds[] = { SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_IMU_SHORT, SBG_ECOM_LOG_EKF_NAV };
+        BatchCheckLog              *pLog = &pCapture->pLogs[i];
+        uint32_t                    choice;
+        bool                        invalid = false;
+
+        choice = batchCheckRandom(&state) % 20;
+
+        if (choice < 12)
+        {
+            errorCode = batchCheckBuildLog(pLog, SBG_ECOM_LOG_IMU_SHORT, &state);
+        }
+        else if (choice < 14)
+        {
+            errorCode = batchCheckBuildLog(pLog, SBG_ECOM_LOG_IMU_DATA, &state);
+        }
+        else if (choice < 17)
+        {
+            errorCode = batchCheckBuildLog(pLog, SBG_ECOM_LOG_EKF_NAV, &state);
+        }
+        else if (choice < 18)
+        {
+            errorCode = batchCheckBuildLog(pLog, SBG_ECOM_LOG_UTC_TIME, &state);
+        }
+        else
+        {
+            errorCode = batchCheckBuildLog(pLog, supportedMsgIds[batchCheckRandom(&state) % SBG_ARRAY_SIZE(supportedMsgIds)], &state);
+
+            pLog->size  = 1 + (batchCheckRandom(&state) % (pLog->size - 1));
+            invalid     = true;
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            if (invalid)
+            {
+                pCapture->nrInvalidFrames++;
+            }
+            else
+            {
+                errorCode = batchCheckAddExpected(pCapture, pLog);
+            }
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Encode the logs of a capture into frames.
+ *
+ * \param[in]   pCapture                Capture.
+ * \param[out]  ppBuffer                Frames, allocated with malloc().
+ * \param[out]  pSize                   Frames size, in bytes.
+ * \return                              SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode batchCheckEncodeCapture(const BatchCheckCapture *pCapture, uint8_t **ppBuffer, size_t *pSize)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+
+    assert(pCapture);
+    assert(ppBuffer);
+    assert(pSize);
+
+    *ppBuffer   = NULL;
+    *pSize      = 0;
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            for (size_t i = 0; (i < BATCH_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                errorCode = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, pCapture->pLogs[i].msgId, pCapture->pLogs[i].payload, pCapture->pLogs[i].size);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                *pSize      = testInterfaceMemoryGetNrPendingBytes(&memoryInterface);
+                *ppBuffer   = malloc(*pSize);
+
+                if (*ppBuffer)
+                {
+                    size_t          nrBytesRead;
+
+                    errorCode = sbgInterfaceRead(&memoryInterface, *ppBuffer, &nrBytesRead, *pSize);
+
+                    if ((errorCode == SBG_NO_ERROR) && (nrBytesRead != *pSize))
+                    {
+                        errorCode = SBG_READ_ERROR;
+                    }
+                }
+                else
+                {
+                    errorCode = SBG_MALLOC_FAILED;
+                }
+            }
+
+            sbgEComProtocolClose(&protocol);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode                errorCode;
+    BatchCheckCapture           capture;
+    static SbgEComLogBatch      batch;
+    uint8_t                    *pFrames = NULL;
+    size_t                      framesSize;
+    size_t                      nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    errorCode = batchCheckBuildCapture(&capture);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = batchCheckEncodeCapture(&capture, &pFrames, &framesSize);
+    }
+
+    //
+    // Logs added one by one
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        sbgEComLogBatchConstruct(&batch);
+
+        for (size_t i = 0; (i < BATCH_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            errorCode = sbgEComLogBatchAddLog(&batch, SBG_ECOM_CLASS_LOG_ECOM_0, capture.pLogs[i].msgId, capture.pLogs[i].payload, capture.pLogs[i].size);
+        }
+
+        sbgEComLogBatchFlush(&batch);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            nrErrors += batchCheckCompare(&capture, &batch, "logs");
+        }
+
+        sbgEComLogBatchDestroy(&batch);
+    }
+
+    //
+    // Frames decoded from a buffer
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        sbgEComLogBatchConstruct(&batch);
+
+        errorCode = sbgEComLogBatchDecodeBuffer(&batch, pFrames, framesSize);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            nrErrors += batchCheckCompare(&capture, &batch, "buffer");
+        }
+
+        sbgEComLogBatchDestroy(&batch);
+    }
+
+    //
+    // Frames decoded from an interface, read in random chunks
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        SbgInterface            memoryInterface;
+
+        errorCode = testInterfaceMemoryCreate(&memoryInterface, BATCH_CHECK_MAX_READ_SIZE);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgInterfaceWrite(&memoryInterface, pFrames, framesSize);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                sbgEComLogBatchConstruct(&batch);
+
+                errorCode = sbgEComLogBatchDecodeInterface(&batch, &memoryInterface);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    nrErrors += batchCheckCompare(&capture, &batch, "interface");
+                }
+
+                sbgEComLogBatchDestroy(&batch);
+            }
+
+            sbgInterfaceDestroy(&memoryInterface);
+        }
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        nrErrors++;
+    }
+
+    printf("%d logs decoded in batches, %zu IMU and %zu EKF records, %zu errors\n", BATCH_CHECK_NR_LOGS, capture.nrImuRecords, capture.nrEkfNavRecords, nrErrors);
+
+    free(pFrames);
+    free(capture.pLogs);
+    free(capture.pImuRecords);
+    free(capture.pEkfNavRecords);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
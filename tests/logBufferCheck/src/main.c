@@ -0,0 +1,494 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the buffer received logs are decoded into.
+ *
+ * Logs must be decoded into storage of the exact structure size, and be passed to the callbacks
+ * as decoded whatever the handle log buffer: the default one, as large as the log union, a compact
+ * one, one provided by the application or a temporary one for logs handled from a log callback.
+ * Logs too large for an application buffer must be discarded.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define LOG_BUFFER_CHECK_UNKNOWN_MSG_ID     (250)           /*!< Message ID without any decoder in the ECOM_0 class. */
+#define LOG_BUFFER_CHECK_RAW_DATA_SIZE      (100)           /*!< Payload size of the raw data logs, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context.
+ */
+typedef struct _LogBufferCheckContext
+{
+    size_t                  nrLogs;                         /*!< Number of logs received by the callback. */
+    const void             *pLogData;                       /*!< Last log passed to the callback. */
+    SbgEComLogUnion         logData;                        /*!< Copy of the last log passed to the callback. */
+    SbgEComLogUnion         outerLogData;                   /*!< Copy of the log the nested log is handled from. */
+    const uint8_t          *pNestedPayload;                 /*!< Payload of an EKF_NAV log handled from the callback, NULL if none. */
+    const void             *pNestedLogData;                 /*!< Log passed to the callback for the nested log. */
+    bool                    outerLogModified;               /*!< Set if the outer log is modified by the nested one. */
+} LogBufferCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context, too large for the stack.
+ */
+static LogBufferCheckContext    gLogBufferCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t logBufferCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a buffer with pseudo random bytes.
+ *
+ * \param[in]   pState                  Generator state.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ */
+static void logBufferCheckFill(uint32_t *pState, void *pBuffer, size_t size)
+{
+    uint8_t                *pBytes = pBuffer;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pBytes[i] = (uint8_t)(logBufferCheckRandom(pState) >> 11);
+    }
+}
+
+/*!
+ * Log function, discarding the errors reported for rejected logs.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void logBufferCheckOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Compare two decoded logs.
+ *
+ * The logs are encoded back to compare their fields only, regardless of the structure padding.
+ *
+ * \param[in]   msgId                   ID of the log, in the ECOM_0 class.
+ * \param[in]   pLogData1               First log.
+ * \param[in]   pLogData2               Second log.
+ * \return                              true if both logs are identical.
+ */
+static bool logBufferCheckIsEqual(SbgEComMsgId msgId, const void *pLogData1, const void *pLogData2)
+{
+    uint8_t                 buffers[2][SBG_ECOM_MAX_PAYLOAD_SIZE];
+    SbgStreamBuffer         streams[2];
+    const void             *pLogData[2] = { pLogData1, pLogData2 };
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        sbgStreamBufferInitForWrite(&streams[i], buffers[i], sizeof(buffers[i]));
+
+        if (msgId == SBG_ECOM_LOG_IMU_SHORT)
+        {
+            sbgEComLogImuShortWriteToStream(pLogData[i], &streams[i]);
+        }
+        else if (msgId == SBG_ECOM_LOG_EKF_NAV)
+        {
+            sbgEComLogEkfNavWriteToStream(pLogData[i], &streams[i]);
+        }
+        else
+        {
+            assert(msgId == SBG_ECOM_LOG_GPS1_RAW);
+
+            sbgEComLogRawDataWriteToStream(pLogData[i], &streams[i]);
+        }
+    }
+
+    return (sbgStreamBufferGetLength(&streams[0]) == sbgStreamBufferGetLength(&streams[1])) &&
+           (memcmp(buffers[0], buffers[1], sbgStreamBufferGetLength(&streams[0])) == 0);
+}
+
+/*!
+ * Receive log callback.
+ *
+ * The log is copied, with only the size of its own structure, into the check context. If a nested
+ * payload is set, it's handled as an EKF_NAV log from the callback, and the outer log must be left
+ * unchanged.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Class of the message.
+ * \param[in]   msgId                   ID of the message.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR if successful.
+ */
+static SbgErrorCode logBufferCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    LogBufferCheckContext  *pContext = pUserArg;
+    size_t                  dataSize;
+
+    assert(pContext);
+
+    dataSize = sbgEComLogGetDataSize(msgClass, msgId);
+
+    pContext->nrLogs++;
+    pContext->pLogData = pLogData;
+    memcpy(&pContext->logData, pLogData, dataSize);
+
+    if (pContext->pNestedPayload)
+    {
+        const uint8_t      *pNestedPayload = pContext->pNestedPayload;
+
+        pContext->pNestedPayload = NULL;
+        memcpy(&pContext->outerLogData, pLogData, dataSize);
+
+        sbgEComHandleLog(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, pNestedPayload, SBG_ECOM_LOG_EKF_NAV_SIZE);
+
+        pContext->pNestedLogData = pContext->pLogData;
+
+        if (!logBufferCheckIsEqual(msgId, pLogData, &pContext->outerLogData))
+        {
+            pContext->outerLogModified = true;
+        }
+
+        pContext->pLogData = pLogData;
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Check the decoded structure sizes.
+ *
+ * \return                              Number of errors.
+ */
+static size_t logBufferCheckDataSizes(void)
+{
+    size_t                  nrErrors = 0;
+
+    if ((sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT) != sizeof(SbgEComLogImuShort)) ||
+        (sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV) != sizeof(SbgEComLogEkfNav)) ||
+        (sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_GPS1_RAW) != sizeof(SbgEComLogRawData)))
+    {
+        printf("decoded structure size differs from the log structure\n");
+        nrErrors++;
+    }
+
+    if (sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, LOG_BUFFER_CHECK_UNKNOWN_MSG_ID) != 0)
+    {
+        printf("unknown log has a decoded structure size\n");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the decoding into exactly sized storage.
+ *
+ * Logs are decoded into allocated storage of the exact structure size, so that any access past the
+ * structure is caught by the address sanitizer, and must match the union based parser.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Number of errors.
+ */
+static size_t logBufferCheckDecode(uint32_t *pState)
+{
+    uint8_t                 payload[SBG_ECOM_LOG_EKF_NAV_SIZE];
+    SbgEComLogImuShort     *pImuShort;
+    SbgEComLogEkfNav       *pEkfNav;
+    SbgEComLogUnion        *pLogUnion;
+    size_t                  nrErrors = 0;
+
+    pImuShort   = malloc(sizeof(*pImuShort));
+    pEkfNav     = malloc(sizeof(*pEkfNav));
+    pLogUnion   = malloc(sizeof(*pLogUnion));
+    assert(pImuShort && pEkfNav && pLogUnion);
+
+    logBufferCheckFill(pState, payload, sizeof(payload));
+
+    if ((sbgEComLogDecode(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, payload, SBG_ECOM_LOG_IMU_SHORT_SIZE, pImuShort, sizeof(*pImuShort)) != SBG_NO_ERROR) ||
+        (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, payload, SBG_ECOM_LOG_IMU_SHORT_SIZE, pLogUnion) != SBG_NO_ERROR) ||
+        (!logBufferCheckIsEqual(SBG_ECOM_LOG_IMU_SHORT, pImuShort, &pLogUnion->imuShort)))
+    {
+        printf("IMU_SHORT decoded into typed storage differs from the union\n");
+        nrErrors++;
+    }
+
+    if ((sbgEComLogDecode(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, payload, SBG_ECOM_LOG_EKF_NAV_SIZE, pEkfNav, sizeof(*pEkfNav)) != SBG_NO_ERROR) ||
+        (sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, payload, SBG_ECOM_LOG_EKF_NAV_SIZE, pLogUnion) != SBG_NO_ERROR) ||
+        (!logBufferCheckIsEqual(SBG_ECOM_LOG_EKF_NAV, pEkfNav, &pLogUnion->ekfNavData)))
+    {
+        printf("EKF_NAV decoded into typed storage differs from the union\n");
+        nrErrors++;
+    }
+
+    if (sbgEComLogDecode(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV, payload, SBG_ECOM_LOG_EKF_NAV_SIZE, pImuShort, sizeof(*pImuShort)) != SBG_BUFFER_OVERFLOW)
+    {
+        printf("EKF_NAV decoded into a too small storage\n");
+        nrErrors++;
+    }
+
+    free(pImuShort);
+    free(pEkfNav);
+    free(pLogUnion);
+
+    return nrErrors;
+}
+
+/*!
+ * Handle a log and check that it's passed to the callback, decoded as expected.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgId                   ID of the log, in the ECOM_0 class.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   payloadSize             Payload size, in bytes.
+ * \return                              Number of errors.
+ */
+static size_t logBufferCheckHandle(SbgEComHandle *pHandle, SbgEComMsgId msgId, const uint8_t *pPayload, size_t payloadSize)
+{
+    LogBufferCheckContext  *pContext = &gLogBufferCheckContext;
+    SbgEComLogUnion        *pExpected;
+    size_t                  nrLogs;
+    size_t                  nrErrors = 0;
+
+    pExpected = malloc(sizeof(*pExpected));
+    assert(pExpected);
+
+    nrLogs = pContext->nrLogs;
+
+    sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, msgId, pPayload, payloadSize, pExpected);
+
+    if ((sbgEComHandleLog(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, msgId, pPayload, payloadSize) != SBG_NO_ERROR) || (pContext->nrLogs != nrLogs + 1) ||
+        (!logBufferCheckIsEqual(msgId, &pContext->logData, pExpected)))
+    {
+        printf("log %#x not passed to the callback as decoded\n", msgId);
+        nrErrors++;
+    }
+
+    sbgEComLogCleanup(pExpected, SBG_ECOM_CLASS_LOG_ECOM_0, msgId);
+    free(pExpected);
+
+    return nrErrors;
+}
+
+/*!
+ * Check the handle log buffer.
+ *
+ * With the default buffer, as large as the union, logs of any size must be handled, and a log handled
+ * from a log callback must be decoded into another buffer, leaving the outer log unchanged. A compact
+ * buffer must only be grown to the largest log received. With an application buffer, logs must be
+ * decoded into it, and logs too large for it must be discarded.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Number of errors.
+ */
+static size_t logBufferCheckHandleBuffer(uint32_t *pState)
+{
+    LogBufferCheckContext  *pContext = &gLogBufferCheckContext;
+    SbgInterface            interface;
+    SbgEComHandle           handle;
+    SbgEComLogEkfNav        staticBuffer;
+    uint8_t                 imuShortPayload[SBG_ECOM_LOG_IMU_SHORT_SIZE];
+    uint8_t                 ekfNavPayload[SBG_ECOM_LOG_EKF_NAV_SIZE];
+    uint8_t                 rawDataPayload[LOG_BUFFER_CHECK_RAW_DATA_SIZE];
+    size_t                  nrLogs;
+    size_t                  nrErrors = 0;
+
+    logBufferCheckFill(pState, imuShortPayload, sizeof(imuShortPayload));
+    logBufferCheckFill(pState, ekfNavPayload, sizeof(ekfNavPayload));
+    logBufferCheckFill(pState, rawDataPayload, sizeof(rawDataPayload));
+
+    testInterfaceMemoryCreate(&interface, 0);
+    sbgEComInit(&handle, &interface);
+    sbgEComSetReceiveLogCallback(&handle, logBufferCheckOnLogReceived, pContext);
+
+    //
+    // Default buffer, as large as the union, small and large logs
+    //
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_IMU_SHORT, imuShortPayload, sizeof(imuShortPayload));
+
+    if (handle.logBufferSize != sizeof(SbgEComLogUnion))
+    {
+        printf("default log buffer of %zu bytes instead of the union size\n", handle.logBufferSize);
+        nrErrors++;
+    }
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_GPS1_RAW, rawDataPayload, sizeof(rawDataPayload));
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_EKF_NAV, ekfNavPayload, sizeof(ekfNavPayload));
+
+    //
+    // Log handled from a log callback
+    //
+    pContext->nrLogs            = 0;
+    pContext->pNestedPayload    = ekfNavPayload;
+    pContext->pNestedLogData    = NULL;
+    pContext->outerLogModified  = false;
+
+    sbgEComHandleLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT, imuShortPayload, sizeof(imuShortPayload));
+
+    if ((pContext->nrLogs != 2) || (pContext->pNestedLogData == NULL) || (pContext->pNestedLogData == pContext->pLogData) || pContext->outerLogModified)
+    {
+        printf("nested log not decoded into a separate buffer\n");
+        nrErrors++;
+    }
+
+    //
+    // Compact buffer, grown to the largest log received
+    //
+    sbgEComSetLogBuffer(&handle, NULL, 0);
+    sbgEComSetCompactLogBuffer(&handle, true);
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_IMU_SHORT, imuShortPayload, sizeof(imuShortPayload));
+
+    if (handle.logBufferSize != sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_SHORT))
+    {
+        printf("compact log buffer of %zu bytes for an IMU short log\n", handle.logBufferSize);
+        nrErrors++;
+    }
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_EKF_NAV, ekfNavPayload, sizeof(ekfNavPayload));
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_IMU_SHORT, imuShortPayload, sizeof(imuShortPayload));
+
+    if (handle.logBufferSize != sbgEComLogGetDataSize(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_NAV))
+    {
+        printf("compact log buffer of %zu bytes after an EKF nav log\n", handle.logBufferSize);
+        nrErrors++;
+    }
+
+    //
+    // Application buffer
+    //
+    pContext->nrLogs = 0;
+    sbgEComSetLogBuffer(&handle, &staticBuffer, sizeof(staticBuffer));
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_IMU_SHORT, imuShortPayload, sizeof(imuShortPayload));
+
+    if (pContext->pLogData != (const void *)&staticBuffer)
+    {
+        printf("log not decoded into the application buffer\n");
+        nrErrors++;
+    }
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_EKF_NAV, ekfNavPayload, sizeof(ekfNavPayload));
+
+    nrLogs = pContext->nrLogs;
+
+    if ((sbgEComHandleLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_GPS1_RAW, rawDataPayload, sizeof(rawDataPayload)) == SBG_NO_ERROR) ||
+        (pContext->nrLogs != nrLogs))
+    {
+        printf("log larger than the application buffer not discarded\n");
+        nrErrors++;
+    }
+
+    //
+    // Back to the default buffer
+    //
+    sbgEComSetLogBuffer(&handle, NULL, 0);
+
+    nrErrors += logBufferCheckHandle(&handle, SBG_ECOM_LOG_GPS1_RAW, rawDataPayload, sizeof(rawDataPayload));
+
+    sbgEComClose(&handle);
+    sbgInterfaceDestroy(&interface);
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    uint32_t                state = 0x327b23c6;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(logBufferCheckOnLog);
+
+    nrErrors += logBufferCheckDataSizes();
+    nrErrors += logBufferCheckDecode(&state);
+    nrErrors += logBufferCheckHandleBuffer(&state);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
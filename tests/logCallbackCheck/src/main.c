@@ -0,0 +1,481 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check log callbacks.
+ *
+ * Callbacks registered on a message, on a class and on all classes must be called once per
+ * matching log, after the callback set with sbgEComSetReceiveLogCallback(), in a stable order.
+ * Removed callbacks, including the one being called, must not be called anymore, the callback
+ * pool must be bounded, and logs must only be decoded if a callback consumes them. Callbacks
+ * removed by another callback during a dispatch must not be called nor break the dispatch, and
+ * the ID of a removed callback must not remove the callback reusing its entry.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define CALLBACK_CHECK_NO_REMOVAL           (SIZE_MAX)      /*!< No callback removed by an entry. */
+#define CALLBACK_CHECK_MAX_TRACE_SIZE       (64)            /*!< Maximum number of callback calls traced for a log. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Callback registered by the check.
+ */
+typedef struct _CallbackCheckEntry
+{
+    char                    tag;                            /*!< Character traced when the callback is called. */
+    size_t                  callbackId;                     /*!< Callback ID. */
+    size_t                  removeIndex;                    /*!< Index of the entry removed when the callback is called, CALLBACK_CHECK_NO_REMOVAL if none. */
+} CallbackCheckEntry;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Callbacks registered by the check.
+ */
+static CallbackCheckEntry   gCallbackCheckEntries[2 * SBG_ECOM_MAX_LOG_CALLBACKS];
+
+/*!
+ * Tags of the callbacks called for the last log.
+ */
+static char                 gCallbackCheckTrace[CALLBACK_CHECK_MAX_TRACE_SIZE + 1];
+
+/*!
+ * Number of callback calls traced.
+ */
+static size_t               gCallbackCheckTraceSize;
+
+/*!
+ * Number of calls to the counting decoder.
+ */
+static size_t               gCallbackCheckNrDecodes;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log callback, tracing its call and removing a callback if requested.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log data.
+ * \param[in]   pUserArg                Callback entry.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode callbackCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    CallbackCheckEntry     *pEntry = pUserArg;
+
+    SBG_UNUSED_PARAMETER(msgClass);
+    SBG_UNUSED_PARAMETER(msgId);
+    SBG_UNUSED_PARAMETER(pLogData);
+
+    assert(pEntry);
+
+    if (gCallbackCheckTraceSize < CALLBACK_CHECK_MAX_TRACE_SIZE)
+    {
+        gCallbackCheckTrace[gCallbackCheckTraceSize] = pEntry->tag;
+        gCallbackCheckTraceSize++;
+    }
+
+    if (pEntry->removeIndex != CALLBACK_CHECK_NO_REMOVAL)
+    {
+        sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[pEntry->removeIndex].callbackId);
+        pEntry->removeIndex = CALLBACK_CHECK_NO_REMOVAL;
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Decoder counting its calls.
+ *
+ * \param[out]  pLogData                Log data.
+ * \param[in]   pStreamBuffer           Input stream buffer.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode callbackCheckDecode(void *pLogData, SbgStreamBuffer *pStreamBuffer)
+{
+    SBG_UNUSED_PARAMETER(pLogData);
+    SBG_UNUSED_PARAMETER(pStreamBuffer);
+
+    gCallbackCheckNrDecodes++;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Register a callback for a log.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   index                   Entry index.
+ * \param[in]   tag                     Character traced when the callback is called.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \return                              Registration result.
+ */
+static SbgErrorCode callbackCheckAdd(SbgEComHandle *pHandle, size_t index, char tag, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    CallbackCheckEntry     *pEntry = &gCallbackCheckEntries[index];
+
+    pEntry->tag         = tag;
+    pEntry->removeIndex = CALLBACK_CHECK_NO_REMOVAL;
+
+    return sbgEComAddLogCallback(pHandle, msgClass, msgId, callbackCheckOnLogReceived, pEntry, &pEntry->callbackId);
+}
+
+/*!
+ * Register a callback for all the logs of a class.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   index                   Entry index.
+ * \param[in]   tag                     Character traced when the callback is called.
+ * \param[in]   msgClass                Message class.
+ * \return                              Registration result.
+ */
+static SbgErrorCode callbackCheckAddClass(SbgEComHandle *pHandle, size_t index, char tag, SbgEComClass msgClass)
+{
+    CallbackCheckEntry     *pEntry = &gCallbackCheckEntries[index];
+
+    pEntry->tag         = tag;
+    pEntry->removeIndex = CALLBACK_CHECK_NO_REMOVAL;
+
+    return sbgEComAddClassLogCallback(pHandle, msgClass, callbackCheckOnLogReceived, pEntry, &pEntry->callbackId);
+}
+
+/*!
+ * Receive a log and compare the callbacks called with the expected ones.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pExpectedTrace          Tags of the callbacks expected to be called, in order.
+ * \return                              Number of errors.
+ */
+static size_t callbackCheckReceive(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const char *pExpectedTrace)
+{
+    static const uint8_t    payload[128];
+    const SbgEComLogDecoder *pDecoder;
+    size_t                  nrErrors = 0;
+
+    assert(pHandle);
+    assert(pExpectedTrace);
+
+    pDecoder = sbgEComLogGetDecoder(msgClass, msgId);
+    assert(pDecoder && (pDecoder->minSize <= sizeof(payload)));
+
+    memset(gCallbackCheckTrace, 0, sizeof(gCallbackCheckTrace));
+    gCallbackCheckTraceSize = 0;
+
+    sbgEComProtocolSend(&pHandle->protocolHandle, msgClass, msgId, payload, sbgMax(pDecoder->minSize, 1));
+    sbgEComHandle(pHandle);
+
+    if (strcmp(gCallbackCheckTrace, pExpectedTrace) != 0)
+    {
+        printf("log %#x:%#x: callbacks \"%s\" called instead of \"%s\"\n", msgClass, msgId, gCallbackCheckTrace, pExpectedTrace);
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the callbacks called for several logs, their removal and the callback pool size.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \return                              Number of errors.
+ */
+static size_t callbackCheckDispatch(SbgEComHandle *pHandle)
+{
+    CallbackCheckEntry      mainEntry = { 'M', 0, CALLBACK_CHECK_NO_REMOVAL };
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    size_t                  nrRegistered;
+    size_t                  endIndex;
+    size_t                  nrErrors = 0;
+
+    assert(pHandle);
+
+    //
+    // The callback set with sbgEComSetReceiveLogCallback() is called first, then the callbacks of
+    // the message in registration order, then the class and wildcard ones in registration order.
+    //
+    sbgEComSetReceiveLogCallback(pHandle, callbackCheckOnLogReceived, &mainEntry);
+
+    callbackCheckAdd(pHandle, 0, 'A', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    callbackCheckAdd(pHandle, 1, 'B', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    callbackCheckAddClass(pHandle, 2, 'C', SBG_ECOM_CLASS_LOG_ECOM_0);
+    callbackCheckAddClass(pHandle, 3, 'D', SBG_ECOM_CLASS_LOG_ALL);
+    callbackCheckAdd(pHandle, 4, 'E', SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_FAST_IMU_DATA);
+    callbackCheckAdd(pHandle, 5, 'F', SBG_ECOM_CLASS_LOG_ALL, SBG_ECOM_LOG_STATUS);
+    callbackCheckAdd(pHandle, 6, 'G', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "MABGCD");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS, "MCDF");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_FAST_IMU_DATA, "MED");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, "MCD");
+
+    //
+    // Removal, which fails the second time.
+    //
+    if ((sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[1].callbackId) != SBG_NO_ERROR) ||
+        (sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[1].callbackId) == SBG_NO_ERROR))
+    {
+        printf("removal: unexpected result\n");
+        nrErrors++;
+    }
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "MAGCD");
+
+    //
+    // Removal of the callback being called.
+    //
+    gCallbackCheckEntries[0].removeIndex = 0;
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "MAGCD");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "MGCD");
+
+    //
+    // Callback pool, with five callbacks still registered.
+    //
+    nrRegistered    = 5;
+    endIndex        = 7;
+
+    while ((errorCode == SBG_NO_ERROR) && (endIndex < SBG_ARRAY_SIZE(gCallbackCheckEntries)))
+    {
+        errorCode = callbackCheckAdd(pHandle, endIndex, 'X', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_DATA);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            nrRegistered++;
+            endIndex++;
+        }
+    }
+
+    if ((nrRegistered != SBG_ECOM_MAX_LOG_CALLBACKS) || (errorCode != SBG_BUFFER_OVERFLOW))
+    {
+        printf("pool: %zu callbacks registered\n", nrRegistered);
+        nrErrors++;
+    }
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_DATA, "MXXXXXXXXXXXCD");
+
+    for (size_t i = 7; i < endIndex; i++)
+    {
+        sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[i].callbackId);
+    }
+
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[2].callbackId);
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[3].callbackId);
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[4].callbackId);
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[6].callbackId);
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_IMU_DATA, "M");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS, "MF");
+
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[5].callbackId);
+    sbgEComSetReceiveLogCallback(pHandle, NULL, NULL);
+
+    return nrErrors;
+}
+
+/*!
+ * Check that logs are only decoded if a callback consumes them.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \return                              Number of errors.
+ */
+static size_t callbackCheckDecoding(SbgEComHandle *pHandle)
+{
+    SbgEComLogDecoder       decoder;
+    size_t                  nrErrors = 0;
+
+    assert(pHandle);
+
+    decoder.pDecodeFunc = callbackCheckDecode;
+    decoder.minSize     = 1;
+    decoder.maxSize     = SBG_ECOM_LOG_DECODER_NO_MAX_SIZE;
+    decoder.dataSize    = 1;
+
+    sbgEComLogRegisterDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, &decoder);
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "");
+
+    if (gCallbackCheckNrDecodes != 0)
+    {
+        printf("decoding: log decoded without callback\n");
+        nrErrors++;
+    }
+
+    callbackCheckAdd(pHandle, 0, 'A', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "A");
+
+    if (gCallbackCheckNrDecodes != 1)
+    {
+        printf("decoding: log not decoded once\n");
+        nrErrors++;
+    }
+
+    sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[0].callbackId);
+    sbgEComLogResetDecoders();
+
+    return nrErrors;
+}
+
+/*!
+ * Check removals during a dispatch and stale callback IDs.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \return                              Number of errors.
+ */
+static size_t callbackCheckDeferredRemoval(SbgEComHandle *pHandle)
+{
+    size_t                  staleCallbackId;
+    size_t                  nrErrors = 0;
+
+    assert(pHandle);
+
+    //
+    // A callback removing the following one, which must not be called, nor break the chain.
+    //
+    callbackCheckAdd(pHandle, 0, 'X', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    callbackCheckAdd(pHandle, 1, 'Y', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    callbackCheckAdd(pHandle, 2, 'Z', SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    callbackCheckAddClass(pHandle, 3, 'W', SBG_ECOM_CLASS_LOG_ALL);
+
+    gCallbackCheckEntries[0].removeIndex = 1;
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "XZW");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "XZW");
+
+    //
+    // A callback removing every other one, including wildcard ones, during the same dispatch.
+    //
+    gCallbackCheckEntries[2].removeIndex = 0;
+    gCallbackCheckEntries[0].removeIndex = CALLBACK_CHECK_NO_REMOVAL;
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "XZW");
+
+    gCallbackCheckEntries[2].removeIndex = 3;
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "Z");
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "Z");
+
+    //
+    // The ID of a removed callback must not remove the callback reusing its entry.
+    //
+    staleCallbackId = gCallbackCheckEntries[2].callbackId;
+    sbgEComRemoveLogCallback(pHandle, staleCallbackId);
+
+    for (size_t i = 0; i < SBG_ECOM_MAX_LOG_CALLBACKS; i++)
+    {
+        callbackCheckAdd(pHandle, i, (char)('a' + i), SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+    }
+
+    if (sbgEComRemoveLogCallback(pHandle, staleCallbackId) == SBG_NO_ERROR)
+    {
+        printf("stale ID: callback removed\n");
+        nrErrors++;
+    }
+
+    nrErrors += callbackCheckReceive(pHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, "abcdefghijklmnop");
+
+    for (size_t i = 0; i < SBG_ECOM_MAX_LOG_CALLBACKS; i++)
+    {
+        sbgEComRemoveLogCallback(pHandle, gCallbackCheckEntries[i].callbackId);
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComHandle           handle;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            nrErrors += callbackCheckDispatch(&handle);
+            nrErrors += callbackCheckDecoding(&handle);
+            nrErrors += callbackCheckDeferredRemoval(&handle);
+
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        nrErrors++;
+    }
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
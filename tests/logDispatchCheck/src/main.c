@@ -0,0 +1,331 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the logs dispatched by an sbgECom handle.
+ *
+ * Logs of several types, filled with pseudo random values, are sent through a memory interface
+ * and read back in pseudo random chunks by an sbgECom handle. Each log passed to the callback
+ * is encoded again, and must match the payload it has been parsed from.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define LOG_CHECK_NR_LOGS                   (5000)          /*!< Number of logs sent. */
+#define LOG_CHECK_MAX_PAYLOAD_SIZE          (256)           /*!< Maximum payload size, in bytes. */
+#define LOG_CHECK_MAX_READ_SIZE             (300)           /*!< Maximum number of bytes read at once. */
+#define LOG_CHECK_MAX_DIAG_LENGTH           (128)           /*!< Maximum length of diagnostic strings. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log sent.
+ */
+typedef struct _LogCheckLog
+{
+    SbgEComMsgId            msgId;                          /*!< Message ID. */
+    size_t                  size;                           /*!< Payload size, in bytes. */
+    uint8_t                 payload[LOG_CHECK_MAX_PAYLOAD_SIZE];    /*!< Payload. */
+} LogCheckLog;
+
+/*!
+ * Check context.
+ */
+typedef struct _LogCheckContext
+{
+    LogCheckLog            *pLogs;                          /*!< Logs sent. */
+    size_t                  nrLogs;                         /*!< Number of logs received. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} LogCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Message IDs of the logs sent, in turn.
+ */
+static const SbgEComMsgId   gLogCheckMsgIds[] =
+{
+    SBG_ECOM_LOG_STATUS,
+    SBG_ECOM_LOG_UTC_TIME,
+    SBG_ECOM_LOG_EKF_EULER,
+    SBG_ECOM_LOG_GPS1_POS,
+    SBG_ECOM_LOG_IMU_SHORT,
+    SBG_ECOM_LOG_DIAG,
+};
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t logCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Encode a log.
+ *
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[out]  pPayload                Payload.
+ * \param[out]  pSize                   Payload size, in bytes.
+ * \return                              SBG_NO_ERROR if the log has been encoded.
+ */
+static SbgErrorCode logCheckEncode(SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, uint8_t *pPayload, size_t *pSize)
+{
+    SbgErrorCode            errorCode;
+    SbgStreamBuffer         streamBuffer;
+
+    assert(pLogData);
+    assert(pPayload);
+    assert(pSize);
+
+    sbgStreamBufferInitForWrite(&streamBuffer, pPayload, LOG_CHECK_MAX_PAYLOAD_SIZE);
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_STATUS:
+        errorCode = sbgEComLogStatusWriteToStream(&pLogData->statusData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_UTC_TIME:
+        errorCode = sbgEComLogUtcWriteToStream(&pLogData->utcData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_EKF_EULER:
+        errorCode = sbgEComLogEkfEulerWriteToStream(&pLogData->ekfEulerData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_GPS1_POS:
+        errorCode = sbgEComLogGnssPosWriteToStream(&pLogData->gpsPosData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_IMU_SHORT:
+        errorCode = sbgEComLogImuShortWriteToStream(&pLogData->imuShort, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_DIAG:
+        errorCode = sbgEComLogDiagWriteToStream(&pLogData->diagData, &streamBuffer);
+        break;
+    default:
+        errorCode = SBG_INVALID_PARAMETER;
+    }
+
+    *pSize = sbgStreamBufferGetLength(&streamBuffer);
+
+    return errorCode;
+}
+
+/*!
+ * Build a log filled with pseudo random values.
+ *
+ * Bytes are chosen so that floating point values are finite, and encoded again identically.
+ *
+ * \param[out]  pLog                    Log.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the log has been built.
+ */
+static SbgErrorCode logCheckBuildLog(LogCheckLog *pLog, SbgEComMsgId msgId, uint32_t *pState)
+{
+    SbgEComLogUnion         logData;
+    uint8_t                *pBytes = (uint8_t *)&logData;
+
+    assert(pLog);
+
+    for (size_t i = 0; i < sizeof(logData); i++)
+    {
+        pBytes[i] = (uint8_t)(0x10 + (logCheckRandom(pState) % 0x30));
+    }
+
+    if (msgId == SBG_ECOM_LOG_DIAG)
+    {
+        size_t              length;
+
+        length = logCheckRandom(pState) % LOG_CHECK_MAX_DIAG_LENGTH;
+
+        logData.diagData.string[length] = '\0';
+    }
+
+    pLog->msgId = msgId;
+
+    return logCheckEncode(msgId, &logData, pLog->payload, &pLog->size);
+}
+
+/*!
+ * Log callback, check a received log against the log sent.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode logCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    LogCheckContext        *pContext = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pContext);
+
+    if (pContext->nrLogs < LOG_CHECK_NR_LOGS)
+    {
+        const LogCheckLog  *pLog = &pContext->pLogs[pContext->nrLogs];
+        uint8_t             payload[LOG_CHECK_MAX_PAYLOAD_SIZE];
+        size_t              size;
+
+        if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != pLog->msgId) ||
+            (logCheckEncode(msgId, pLogData, payload, &size) != SBG_NO_ERROR) ||
+            (size != pLog->size) || (memcmp(payload, pLog->payload, size) != 0))
+        {
+            printf("log %zu mismatch, message %u:%u\n", pContext->nrLogs, msgClass, msgId);
+            pContext->nrErrors++;
+        }
+    }
+
+    pContext->nrLogs++;
+
+    return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode                errorCode;
+    SbgInterface                memoryInterface;
+    SbgEComHandle               handle;
+    LogCheckContext             context;
+    uint32_t                    state = 0x0badf00d;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    memset(&context, 0, sizeof(context));
+
+    context.pLogs = malloc(LOG_CHECK_NR_LOGS * sizeof(*context.pLogs));
+
+    if (context.pLogs)
+    {
+        errorCode = testInterfaceMemoryCreate(&memoryInterface, LOG_CHECK_MAX_READ_SIZE);
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComSetReceiveLogCallback(&handle, logCheckOnLogReceived, &context);
+
+            for (size_t i = 0; (i < LOG_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                LogCheckLog    *pLog = &context.pLogs[i];
+
+                errorCode = logCheckBuildLog(pLog, gLogCheckMsgIds[i % SBG_ARRAY_SIZE(gLogCheckMsgIds)], &state);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    errorCode = sbgEComProtocolSend(&handle.protocolHandle, SBG_ECOM_CLASS_LOG_ECOM_0, pLog->msgId, pLog->payload, pLog->size);
+                }
+            }
+
+            //
+            // sbgEComHandle() returns SBG_NOT_READY once all the received frames are handled
+            //
+            while ((errorCode == SBG_NO_ERROR) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) != 0))
+            {
+                errorCode = sbgEComHandle(&handle);
+
+                if (errorCode == SBG_NOT_READY)
+                {
+                    errorCode = SBG_NO_ERROR;
+                }
+            }
+
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        context.nrErrors++;
+    }
+
+    if (context.nrLogs != LOG_CHECK_NR_LOGS)
+    {
+        printf("%zu logs received, %d expected\n", context.nrLogs, LOG_CHECK_NR_LOGS);
+        context.nrErrors++;
+    }
+
+    printf("%zu logs dispatched, %zu errors\n", context.nrLogs, context.nrErrors);
+
+    free(context.pLogs);
+
+    return (context.nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
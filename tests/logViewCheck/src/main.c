@@ -0,0 +1,529 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the zero-copy log views against the regular log decoders.
+ *
+ * Raw data, diagnostic and satellite list logs filled with random values are decoded into views
+ * and compared to the logs decoded by the regular decoders, whole or truncated. The same logs are
+ * then received through a handle with views enabled.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define VIEW_CHECK_NR_LOGS                  (2000)          /*!< Number of logs checked. */
+#define VIEW_CHECK_MAX_RAW_SIZE             (600)           /*!< Maximum raw data size, in bytes. */
+#define VIEW_CHECK_MAX_DIAG_LENGTH          (128)           /*!< Maximum diagnostic string length, in bytes. */
+#define VIEW_CHECK_MAX_READ_SIZE            (300)           /*!< Maximum number of bytes read at once. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log sent.
+ */
+typedef struct _ViewCheckLog
+{
+    SbgEComMsgId            msgId;                          /*!< Message ID. */
+    size_t                  size;                           /*!< Payload size, in bytes. */
+    uint8_t                 payload[SBG_ECOM_MAX_PAYLOAD_SIZE];     /*!< Payload. */
+} ViewCheckLog;
+
+/*!
+ * Check context.
+ */
+typedef struct _ViewCheckContext
+{
+    ViewCheckLog           *pLogs;                          /*!< Logs sent. */
+    size_t                  nrLogs;                         /*!< Number of logs received. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} ViewCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Message IDs of the logs sent, in turn.
+ */
+static const SbgEComMsgId   gViewCheckMsgIds[] =
+{
+    SBG_ECOM_LOG_GPS1_RAW,
+    SBG_ECOM_LOG_RTCM_RAW,
+    SBG_ECOM_LOG_DIAG,
+    SBG_ECOM_LOG_GPS1_SAT,
+    SBG_ECOM_LOG_GPS2_SAT,
+};
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t viewCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Encode a pseudo random satellite list.
+ *
+ * \param[out]  pStreamBuffer           Stream buffer.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the satellite list has been encoded.
+ */
+static SbgErrorCode viewCheckWriteSatList(SbgStreamBuffer *pStreamBuffer, uint32_t *pState)
+{
+    static SbgEComLogSatList    satList;
+    size_t                      nrSatellites;
+
+    sbgEComLogSatListConstruct(&satList, viewCheckRandom(pState));
+
+    satList.reserved    = viewCheckRandom(pState);
+    nrSatellites        = viewCheckRandom(pState) % (SBG_ECOM_SAT_MAX_NR_SATELLITES + 1);
+
+    for (size_t i = 0; i < nrSatellites; i++)
+    {
+        SbgEComLogSatEntry     *pSatData;
+        size_t                  nrSignals;
+
+        pSatData = sbgEComLogSatListAdd(&satList, (uint8_t)viewCheckRandom(pState), (int8_t)((int32_t)(viewCheckRandom(pState) % 181) - 90), (uint16_t)(viewCheckRandom(pState) % 360),
+                                        (SbgEComConstellationId)(viewCheckRandom(pState) % 9), (SbgEComSatElevationStatus)(viewCheckRandom(pState) % 3),
+                                        (SbgEComSatHealthStatus)(viewCheckRandom(pState) % 3), (SbgEComSatTrackingStatus)(viewCheckRandom(pState) % 6));
+
+        assert(pSatData);
+
+        nrSignals = viewCheckRandom(pState) % (SBG_ECOM_SAT_MAX_NR_SIGNALS + 1);
+
+        for (size_t j = 0; j < nrSignals; j++)
+        {
+            sbgEComLogSatEntryAdd(pSatData, (SbgEComSignalId)(uint8_t)viewCheckRandom(pState), (SbgEComSatHealthStatus)(viewCheckRandom(pState) % 3),
+                                  (SbgEComSatTrackingStatus)(viewCheckRandom(pState) % 6), (viewCheckRandom(pState) % 2) != 0, (uint8_t)viewCheckRandom(pState));
+        }
+    }
+
+    return sbgEComLogSatListWriteToStream(&satList, pStreamBuffer);
+}
+
+/*!
+ * Build a log filled with pseudo random values.
+ *
+ * \param[out]  pLog                    Log.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the log has been built.
+ */
+static SbgErrorCode viewCheckBuildLog(ViewCheckLog *pLog, SbgEComMsgId msgId, uint32_t *pState)
+{
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    SbgStreamBuffer         streamBuffer;
+    size_t                  size;
+
+    assert(pLog);
+
+    pLog->msgId = msgId;
+
+    sbgStreamBufferInitForWrite(&streamBuffer, pLog->payload, sizeof(pLog->payload));
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_GPS1_RAW:
+    case SBG_ECOM_LOG_RTCM_RAW:
+        size = 1 + (viewCheckRandom(pState) % VIEW_CHECK_MAX_RAW_SIZE);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            sbgStreamBufferWriteUint8(&streamBuffer, (uint8_t)viewCheckRandom(pState));
+        }
+        break;
+    case SBG_ECOM_LOG_DIAG:
+        sbgStreamBufferWriteUint32LE(&streamBuffer, viewCheckRandom(pState));
+        sbgStreamBufferWriteUint8(&streamBuffer, (uint8_t)viewCheckRandom(pState));
+        sbgStreamBufferWriteUint8(&streamBuffer, (uint8_t)viewCheckRandom(pState));
+
+        size = viewCheckRandom(pState) % VIEW_CHECK_MAX_DIAG_LENGTH;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            sbgStreamBufferWriteUint8(&streamBuffer, (uint8_t)(' ' + (viewCheckRandom(pState) % 95)));
+        }
+
+        //
+        // The string null terminator is optional
+        //
+        if ((viewCheckRandom(pState) % 2) != 0)
+        {
+            sbgStreamBufferWriteUint8(&streamBuffer, '\0');
+        }
+        break;
+    default:
+        errorCode = viewCheckWriteSatList(&streamBuffer, pState);
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgStreamBufferGetLastError(&streamBuffer);
+    }
+
+    pLog->size = sbgStreamBufferGetLength(&streamBuffer);
+
+    return errorCode;
+}
+
+/*!
+ * Compare a satellite entry view to a decoded satellite entry.
+ *
+ * \param[in]   pEntryView              Satellite entry view.
+ * \param[in]   pSatData                Decoded satellite entry.
+ * \return                              True if they match.
+ */
+static bool viewCheckCompareSatEntry(const SbgEComLogSatEntryView *pEntryView, const SbgEComLogSatEntry *pSatData)
+{
+    SbgEComLogSatEntry      decoded;
+    bool                    match;
+
+    assert(pEntryView);
+    assert(pSatData);
+
+    match = (pEntryView->id == pSatData->id) && (pEntryView->elevation == pSatData->elevation) && (pEntryView->azimuth == pSatData->azimuth) &&
+            (pEntryView->flags == pSatData->flags) && (pEntryView->nrSignals == pSatData->nrSignals);
+
+    if (match)
+    {
+        sbgEComLogSatEntryViewDecode(pEntryView, &decoded);
+
+        match = (decoded.id == pSatData->id) && (decoded.elevation == pSatData->elevation) && (decoded.azimuth == pSatData->azimuth) &&
+                (decoded.flags == pSatData->flags) && (decoded.nrSignals == pSatData->nrSignals);
+
+        for (size_t i = 0; match && (i < pSatData->nrSignals); i++)
+        {
+            SbgEComLogSatSignal     signalData;
+
+            sbgEComLogSatEntryViewGetSignal(pEntryView, i, &signalData);
+
+            match = (signalData.id == pSatData->signalData[i].id) && (signalData.flags == pSatData->signalData[i].flags) && (signalData.snr == pSatData->signalData[i].snr) &&
+                    (decoded.signalData[i].id == pSatData->signalData[i].id) && (decoded.signalData[i].flags == pSatData->signalData[i].flags) &&
+                    (decoded.signalData[i].snr == pSatData->signalData[i].snr);
+        }
+    }
+
+    return match;
+}
+
+/*!
+ * Compare a log decoded into a view to the same log decoded by the regular decoder.
+ *
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pViewData               Log decoded into a view.
+ * \param[in]   pLogData                Log decoded by the regular decoder.
+ * \return                              True if they match.
+ */
+static bool viewCheckCompare(SbgEComMsgId msgId, const SbgEComLogUnion *pViewData, const SbgEComLogUnion *pLogData)
+{
+    bool                    match;
+
+    assert(pViewData);
+    assert(pLogData);
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_GPS1_RAW:
+    case SBG_ECOM_LOG_RTCM_RAW:
+        match = (pViewData->rawDataView.bufferSize == pLogData->gpsRawData.bufferSize) &&
+                (memcmp(pViewData->rawDataView.pBuffer, pLogData->gpsRawData.rawBuffer, pLogData->gpsRawData.bufferSize) == 0);
+        break;
+    case SBG_ECOM_LOG_DIAG:
+        match = (pViewData->diagView.timestamp == pLogData->diagData.timestamp) && (pViewData->diagView.type == pLogData->diagData.type) &&
+                (pViewData->diagView.errorCode == pLogData->diagData.errorCode) && (pViewData->diagView.stringLength == strlen(pLogData->diagData.string)) &&
+                (memcmp(pViewData->diagView.pString, pLogData->diagData.string, pViewData->diagView.stringLength) == 0);
+        break;
+    default:
+        {
+            const SbgEComLogSatListView        *pSatListView = &pViewData->satListView;
+            const SbgEComLogSatList            *pSatList = &pLogData->satGroupData;
+            SbgEComLogSatListViewIterator       iterator;
+            SbgEComLogSatEntryView              entryView;
+
+            match = (pSatListView->timeStamp == pSatList->timeStamp) && (pSatListView->reserved == pSatList->reserved) &&
+                    (pSatListView->nrSatellites == pSatList->nrSatellites);
+
+            sbgEComLogSatListViewIteratorInit(&iterator, pSatListView);
+
+            for (size_t i = 0; match && (i < pSatList->nrSatellites); i++)
+            {
+                match = sbgEComLogSatListViewIteratorNext(&iterator, &entryView) && viewCheckCompareSatEntry(&entryView, &pSatList->satData[i]);
+
+                if (match)
+                {
+                    match = sbgEComLogSatListViewGet(pSatListView, i, &entryView) && viewCheckCompareSatEntry(&entryView, &pSatList->satData[i]);
+                }
+            }
+
+            if (match)
+            {
+                match = !sbgEComLogSatListViewIteratorNext(&iterator, &entryView) && !sbgEComLogSatListViewGet(pSatListView, pSatList->nrSatellites, &entryView);
+            }
+        }
+    }
+
+    return match;
+}
+
+/*!
+ * Decode a payload with the view and the regular decoders, and compare the results.
+ *
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   mustSucceed             True if the payload is a valid log.
+ * \return                              True if the decoders agree.
+ */
+static bool viewCheckDecode(SbgEComMsgId msgId, const uint8_t *pPayload, size_t size, bool mustSucceed)
+{
+    static SbgEComLogUnion              logData;
+    SbgEComLogUnion                     viewData;
+    SbgErrorCode                        logErrorCode;
+    SbgErrorCode                        viewErrorCode;
+    bool                                match;
+
+    memset(&logData, 0, sizeof(logData));
+
+    logErrorCode    = sbgEComLogParse(SBG_ECOM_CLASS_LOG_ECOM_0, msgId, pPayload, size, &logData);
+    viewErrorCode   = sbgEComLogDecodeWithDecoder(sbgEComLogGetViewDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, msgId), SBG_ECOM_CLASS_LOG_ECOM_0, msgId, pPayload, size, &viewData, sizeof(viewData));
+
+    if (mustSucceed && (logErrorCode != SBG_NO_ERROR))
+    {
+        match = false;
+    }
+    else if ((logErrorCode == SBG_NO_ERROR) && (viewErrorCode == SBG_NO_ERROR))
+    {
+        match = viewCheckCompare(msgId, &viewData, &logData);
+    }
+    else
+    {
+        match = (logErrorCode != SBG_NO_ERROR) && (viewErrorCode != SBG_NO_ERROR);
+    }
+
+    return match;
+}
+
+/*!
+ * Log callback, check a received view against the log sent.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode viewCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    ViewCheckContext       *pContext = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pContext);
+
+    if (pContext->nrLogs < VIEW_CHECK_NR_LOGS)
+    {
+        static SbgEComLogUnion  logData;
+        const ViewCheckLog     *pLog = &pContext->pLogs[pContext->nrLogs];
+
+        memset(&logData, 0, sizeof(logData));
+
+        if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != pLog->msgId) ||
+            (sbgEComLogParse(msgClass, msgId, pLog->payload, pLog->size, &logData) != SBG_NO_ERROR) ||
+            !viewCheckCompare(msgId, pLogData, &logData))
+        {
+            printf("log %zu mismatch, message %u:%u\n", pContext->nrLogs, msgClass, msgId);
+            pContext->nrErrors++;
+        }
+    }
+
+    pContext->nrLogs++;
+
+    return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode                errorCode = SBG_NO_ERROR;
+    SbgInterface                memoryInterface;
+    SbgEComHandle               handle;
+    ViewCheckContext            context;
+    uint32_t                    state = 0x5eed1e55;
+    size_t                      nrDecodes = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    memset(&context, 0, sizeof(context));
+
+    context.pLogs = malloc(VIEW_CHECK_NR_LOGS * sizeof(*context.pLogs));
+
+    if (!context.pLogs)
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    //
+    // Decode each log, and a truncated copy of it, with the view and the regular decoders
+    //
+    for (size_t i = 0; (i < VIEW_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+    {
+        ViewCheckLog           *pLog = &context.pLogs[i];
+
+        errorCode = viewCheckBuildLog(pLog, gViewCheckMsgIds[i % SBG_ARRAY_SIZE(gViewCheckMsgIds)], &state);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            const SbgEComLogDecoder    *pDecoder;
+
+            if (!viewCheckDecode(pLog->msgId, pLog->payload, pLog->size, true))
+            {
+                printf("log %zu decode mismatch, message %u\n", i, pLog->msgId);
+                context.nrErrors++;
+            }
+
+            //
+            // Payloads shorter than the minimum size are rejected by both decoders before being read
+            //
+            pDecoder = sbgEComLogGetViewDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, pLog->msgId);
+
+            if (pLog->size > pDecoder->minSize)
+            {
+                size_t                  size;
+
+                size = pDecoder->minSize + (viewCheckRandom(&state) % (pLog->size - pDecoder->minSize));
+
+                if (!viewCheckDecode(pLog->msgId, pLog->payload, size, false))
+                {
+                    printf("log %zu truncated to %zu bytes decode mismatch, message %u\n", i, size, pLog->msgId);
+                    context.nrErrors++;
+                }
+
+                nrDecodes++;
+            }
+
+            nrDecodes++;
+        }
+    }
+
+    //
+    // Receive the logs through a handle with views enabled
+    //
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = testInterfaceMemoryCreate(&memoryInterface, VIEW_CHECK_MAX_READ_SIZE);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComInit(&handle, &memoryInterface);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                sbgEComSetLogViews(&handle, true);
+                sbgEComSetReceiveLogCallback(&handle, viewCheckOnLogReceived, &context);
+
+                for (size_t i = 0; (i < VIEW_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+                {
+                    errorCode = sbgEComProtocolSend(&handle.protocolHandle, SBG_ECOM_CLASS_LOG_ECOM_0, context.pLogs[i].msgId, context.pLogs[i].payload, context.pLogs[i].size);
+                }
+
+                //
+                // sbgEComHandle() returns SBG_NOT_READY once all the received frames are handled
+                //
+                while ((errorCode == SBG_NO_ERROR) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) != 0))
+                {
+                    errorCode = sbgEComHandle(&handle);
+
+                    if (errorCode == SBG_NOT_READY)
+                    {
+                        errorCode = SBG_NO_ERROR;
+                    }
+                }
+
+                sbgEComClose(&handle);
+            }
+
+            sbgInterfaceDestroy(&memoryInterface);
+        }
+
+        if (context.nrLogs != VIEW_CHECK_NR_LOGS)
+        {
+            printf("%zu logs received, %d expected\n", context.nrLogs, VIEW_CHECK_NR_LOGS);
+            context.nrErrors++;
+        }
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        context.nrErrors++;
+    }
+
+    printf("%zu logs decoded, %zu logs received as views, %zu errors\n", nrDecodes, context.nrLogs, context.nrErrors);
+
+    free(context.pLogs);
+
+    return (context.nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
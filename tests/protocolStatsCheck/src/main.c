@@ -0,0 +1,680 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the protocol statistics counters.
+ *
+ * Valid frames of several classes and IDs, some out of the per message counters range, are
+ * received and counted. Invalid bytes, frames with an invalid CRC, end-of-frame byte or header,
+ * each followed by a valid frame, must update the matching error, resynchronization and discarded
+ * bytes counters. A restarted large transfer must be counted as aborted, and all counters must be
+ * cleared on reset.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define STATS_CHECK_NR_FRAMES               (500)           /*!< Number of valid frames sent in the first step. */
+#define STATS_CHECK_MAX_PAYLOAD_SIZE        (200)           /*!< Maximum payload size of the small frames, in bytes. */
+#define STATS_CHECK_LARGE_SIZE              (10000)         /*!< Size of the large transfer, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context.
+ */
+typedef struct _StatsCheckContext
+{
+    SbgInterface            interface;                      /*!< Memory interface read by the protocol. */
+    SbgEComProtocol         protocol;                       /*!< Protocol under check. */
+    SbgEComProtocolStats    expected;                       /*!< Expected statistics. */
+    uint32_t                state;                          /*!< Generator state. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} StatsCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context, too large for the stack.
+ */
+static StatsCheckContext    gStatsCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t statsCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Log function, discarding the errors reported for invalid frames.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void statsCheckOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Encode a frame with random payload bytes.
+ *
+ * Only the first SYNC byte of the frame is 0xff, so that corrupting the frame can't create
+ * a frame candidate inside it.
+ *
+ * \param[in]   pContext                Context.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[out]  pFrame                  Frame, at least STATS_CHECK_MAX_PAYLOAD_SIZE + 9 bytes.
+ * \return                              Frame size, in bytes.
+ */
+static size_t statsCheckEncode(StatsCheckContext *pContext, uint8_t msgClass, uint8_t msgId, uint8_t *pFrame)
+{
+    size_t                  frameSize;
+    bool                    valid;
+
+    assert(pContext);
+    assert(pFrame);
+
+    do
+    {
+        SbgStreamBuffer     outputStream;
+        size_t              streamCursor;
+        size_t              payloadSize;
+
+        payloadSize = statsCheckRandom(&pContext->state) % (STATS_CHECK_MAX_PAYLOAD_SIZE + 1);
+
+        sbgStreamBufferInitForWrite(&outputStream, pFrame, STATS_CHECK_MAX_PAYLOAD_SIZE + 9);
+        sbgEComStartFrameGeneration(&outputStream, msgClass, msgId, &streamCursor);
+
+        for (size_t i = 0; i < payloadSize; i++)
+        {
+            sbgStreamBufferWriteUint8(&outputStream, (uint8_t)(statsCheckRandom(&pContext->state) % 0xff));
+        }
+
+        sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+
+        frameSize   = sbgStreamBufferGetLength(&outputStream);
+        valid       = true;
+
+        for (size_t i = 1; i < frameSize; i++)
+        {
+            if (pFrame[i] == SBG_ECOM_SYNC_1)
+            {
+                valid = false;
+            }
+        }
+    } while (!valid);
+
+    return frameSize;
+}
+
+/*!
+ * Write bytes to the interface read by the protocol and count them as read.
+ *
+ * \param[in]   pContext                Context.
+ * \param[in]   pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ */
+static void statsCheckWrite(StatsCheckContext *pContext, const void *pBuffer, size_t size)
+{
+    SbgErrorCode            errorCode;
+
+    assert(pContext);
+
+    errorCode = sbgInterfaceWrite(&pContext->interface, pBuffer, size);
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to write bytes");
+        pContext->nrErrors++;
+    }
+
+    pContext->expected.nrBytesRead += size;
+}
+
+/*!
+ * Receive all pending frames.
+ *
+ * \param[in]   pContext                Context.
+ * \return                              Number of frames received.
+ */
+static size_t statsCheckReceive(StatsCheckContext *pContext)
+{
+    SbgEComProtocolPayload  payload;
+    size_t                  nrFrames = 0;
+
+    assert(pContext);
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    for (;;)
+    {
+        SbgErrorCode        errorCode;
+        uint8_t             msgClass;
+        uint8_t             msgId;
+
+        errorCode = sbgEComProtocolReceive2(&pContext->protocol, &msgClass, &msgId, &payload);
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            break;
+        }
+
+        nrFrames++;
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return nrFrames;
+}
+
+/*!
+ * Compare the protocol statistics with the expected ones.
+ *
+ * \param[in]   pContext                Context.
+ * \param[in]   pStep                   Step name.
+ */
+static void statsCheckCompare(StatsCheckContext *pContext, const char *pStep)
+{
+    const SbgEComProtocolStats *pStats;
+    const SbgEComProtocolStats *pExpected;
+
+    assert(pContext);
+    assert(pStep);
+
+    pStats      = sbgEComProtocolGetStats(&pContext->protocol);
+    pExpected   = &pContext->expected;
+
+    if ((pStats->nrBytesRead != pExpected->nrBytesRead) || (pStats->nrBytesDiscarded != pExpected->nrBytesDiscarded) ||
+        (memcmp(pStats->nrFrames, pExpected->nrFrames, sizeof(pStats->nrFrames)) != 0) || (pStats->nrOtherFrames != pExpected->nrOtherFrames) ||
+        (pStats->nrHeaderErrors != pExpected->nrHeaderErrors) || (pStats->nrCrcErrors != pExpected->nrCrcErrors) ||
+        (pStats->nrEtxErrors != pExpected->nrEtxErrors) || (pStats->nrResyncs != pExpected->nrResyncs) ||
+        (pStats->nrLargeTransferAborts != pExpected->nrLargeTransferAborts) || (pStats->nrBufferFullEvents != pExpected->nrBufferFullEvents))
+    {
+        printf("%s: unexpected statistics\n", pStep);
+        printf("  read:%" PRIu64 "/%" PRIu64 " discarded:%" PRIu64 "/%" PRIu64 " other:%" PRIu32 "/%" PRIu32 " header:%" PRIu32 "/%" PRIu32 "\n",
+               pStats->nrBytesRead, pExpected->nrBytesRead, pStats->nrBytesDiscarded, pExpected->nrBytesDiscarded,
+               pStats->nrOtherFrames, pExpected->nrOtherFrames, pStats->nrHeaderErrors, pExpected->nrHeaderErrors);
+        printf("  crc:%" PRIu32 "/%" PRIu32 " etx:%" PRIu32 "/%" PRIu32 " resyncs:%" PRIu32 "/%" PRIu32 " aborts:%" PRIu32 "/%" PRIu32 " full:%" PRIu32 "/%" PRIu32 "\n",
+               pStats->nrCrcErrors, pExpected->nrCrcErrors, pStats->nrEtxErrors, pExpected->nrEtxErrors, pStats->nrResyncs, pExpected->nrResyncs,
+               pStats->nrLargeTransferAborts, pExpected->nrLargeTransferAborts, pStats->nrBufferFullEvents, pExpected->nrBufferFullEvents);
+        pContext->nrErrors++;
+    }
+}
+
+/*!
+ * Account for a valid frame in the expected statistics.
+ *
+ * \param[in]   pContext                Context.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ */
+static void statsCheckExpectFrame(StatsCheckContext *pContext, uint8_t msgClass, uint8_t msgId)
+{
+    assert(pContext);
+
+    if ((msgClass < SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES) && (msgId < SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS))
+    {
+        pContext->expected.nrFrames[msgClass][msgId]++;
+    }
+    else
+    {
+        pContext->expected.nrOtherFrames++;
+    }
+}
+
+/*!
+ * Check the frame counters with valid frames of various classes and IDs.
+ *
+ * \param[in]   pContext                Context.
+ */
+static void statsCheckValidFrames(StatsCheckContext *pContext)
+{
+    static const uint8_t    msgClasses[] = { SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_CLASS_LOG_CMD_0, 0x42 };
+    size_t                  nrFrames = 0;
+
+    assert(pContext);
+
+    for (size_t i = 0; i < STATS_CHECK_NR_FRAMES; i++)
+    {
+        uint8_t             frame[STATS_CHECK_MAX_PAYLOAD_SIZE + 9];
+        size_t              frameSize;
+        uint8_t             msgClass;
+        uint8_t             msgId;
+
+        msgClass    = msgClasses[statsCheckRandom(&pContext->state) % SBG_ARRAY_SIZE(msgClasses)];
+        msgId       = (uint8_t)(statsCheckRandom(&pContext->state) % 128);
+        frameSize   = statsCheckEncode(pContext, msgClass, msgId, frame);
+
+        statsCheckWrite(pContext, frame, frameSize);
+        statsCheckExpectFrame(pContext, msgClass, msgId);
+
+        //
+        // Keep the pending bytes below the work buffer size, which is checked in another step.
+        //
+        if ((testInterfaceMemoryGetNrPendingBytes(&pContext->interface) > (SBG_ECOM_MAX_BUFFER_SIZE / 2)) || ((statsCheckRandom(&pContext->state) % 8) == 0))
+        {
+            nrFrames += statsCheckReceive(pContext);
+        }
+    }
+
+    nrFrames += statsCheckReceive(pContext);
+
+    if (nrFrames != STATS_CHECK_NR_FRAMES)
+    {
+        printf("valid frames: %zu frames received instead of %d\n", nrFrames, STATS_CHECK_NR_FRAMES);
+        pContext->nrErrors++;
+    }
+
+    statsCheckCompare(pContext, "valid frames");
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(msgClasses); i++)
+    {
+        for (uint8_t msgId = 0; msgId < 128; msgId++)
+        {
+            uint32_t        expectedNrFrames = 0;
+
+            if ((msgClasses[i] < SBG_ECOM_PROTOCOL_STATS_NR_MSG_CLASSES) && (msgId < SBG_ECOM_PROTOCOL_STATS_NR_MSG_IDS))
+            {
+                expectedNrFrames = pContext->expected.nrFrames[msgClasses[i]][msgId];
+            }
+
+            if (sbgEComProtocolStatsGetNrFrames(sbgEComProtocolGetStats(&pContext->protocol), msgClasses[i], msgId) != expectedNrFrames)
+            {
+                printf("valid frames: invalid frame count for class %#x ID %#x\n", msgClasses[i], msgId);
+                pContext->nrErrors++;
+            }
+        }
+    }
+}
+
+/*!
+ * Check the error counters with invalid bytes, each followed by a valid frame.
+ *
+ * \param[in]   pContext                Context.
+ */
+static void statsCheckErrors(StatsCheckContext *pContext)
+{
+    static const uint8_t    invalidHeader[] = { SBG_ECOM_SYNC_1, SBG_ECOM_SYNC_2, 0x01, 0x00, 0x00, 0x7f };
+    uint8_t                 invalidBytes[STATS_CHECK_MAX_PAYLOAD_SIZE + 9];
+    size_t                  invalidSize;
+    uint8_t                 frame[STATS_CHECK_MAX_PAYLOAD_SIZE + 9];
+    size_t                  frameSize;
+
+    assert(pContext);
+
+    //
+    // Bytes without SYNC byte.
+    //
+    invalidSize = 100;
+
+    for (size_t i = 0; i < invalidSize; i++)
+    {
+        invalidBytes[i] = (uint8_t)(statsCheckRandom(&pContext->state) % 0xff);
+    }
+
+    statsCheckWrite(pContext, invalidBytes, invalidSize);
+    pContext->expected.nrBytesDiscarded += invalidSize;
+
+    frameSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 1, frame);
+    statsCheckWrite(pContext, frame, frameSize);
+    statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 1);
+
+    if (statsCheckReceive(pContext) != 1)
+    {
+        printf("garbage: frame not received\n");
+        pContext->nrErrors++;
+    }
+
+    statsCheckCompare(pContext, "garbage");
+
+    //
+    // Invalid CRC.
+    //
+    invalidSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 2, invalidBytes);
+    invalidBytes[invalidSize - 3] ^= 0x01;
+
+    statsCheckWrite(pContext, invalidBytes, invalidSize);
+    pContext->expected.nrBytesDiscarded += invalidSize;
+    pContext->expected.nrCrcErrors++;
+    pContext->expected.nrResyncs++;
+
+    frameSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 3, frame);
+    statsCheckWrite(pContext, frame, frameSize);
+    statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 3);
+
+    if (statsCheckReceive(pContext) != 1)
+    {
+        printf("invalid CRC: frame not received\n");
+        pContext->nrErrors++;
+    }
+
+    statsCheckCompare(pContext, "invalid CRC");
+
+    //
+    // Invalid end-of-frame byte.
+    //
+    invalidSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 4, invalidBytes);
+    invalidBytes[invalidSize - 1] = 0x00;
+
+    statsCheckWrite(pContext, invalidBytes, invalidSize);
+    pContext->expected.nrBytesDiscarded += invalidSize;
+    pContext->expected.nrEtxErrors++;
+    pContext->expected.nrResyncs++;
+
+    frameSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 5, frame);
+    statsCheckWrite(pContext, frame, frameSize);
+    statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 5);
+
+    if (statsCheckReceive(pContext) != 1)
+    {
+        printf("invalid end-of-frame: frame not received\n");
+        pContext->nrErrors++;
+    }
+
+    statsCheckCompare(pContext, "invalid end-of-frame");
+
+    //
+    // Invalid payload size in the header.
+    //
+    statsCheckWrite(pContext, invalidHeader, sizeof(invalidHeader));
+    pContext->expected.nrBytesDiscarded += sizeof(invalidHeader);
+    pContext->expected.nrHeaderErrors++;
+    pContext->expected.nrResyncs++;
+
+    frameSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 6, frame);
+    statsCheckWrite(pContext, frame, frameSize);
+    statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 6);
+
+    if (statsCheckReceive(pContext) != 1)
+    {
+        printf("invalid header: frame not received\n");
+        pContext->nrErrors++;
+    }
+
+    statsCheckCompare(pContext, "invalid header");
+}
+
+/*!
+ * Check the work buffer full counter.
+ *
+ * \param[in]   pContext                Context.
+ */
+static void statsCheckBufferFull(StatsCheckContext *pContext)
+{
+    size_t                  nrFrames = 0;
+    size_t                  totalSize = 0;
+    const SbgEComProtocolStats *pStats;
+
+    assert(pContext);
+
+    while (totalSize < (3 * SBG_ECOM_MAX_BUFFER_SIZE))
+    {
+        uint8_t             frame[STATS_CHECK_MAX_PAYLOAD_SIZE + 9];
+        size_t              frameSize;
+
+        frameSize = statsCheckEncode(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 7, frame);
+        statsCheckWrite(pContext, frame, frameSize);
+        statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 7);
+
+        totalSize += frameSize;
+        nrFrames++;
+    }
+
+    if (statsCheckReceive(pContext) != nrFrames)
+    {
+        printf("buffer full: frames not received\n");
+        pContext->nrErrors++;
+    }
+
+    //
+    // The exact number of events depends on how frames are aligned with the buffer end.
+    //
+    pStats = sbgEComProtocolGetStats(&pContext->protocol);
+
+    if (pStats->nrBufferFullEvents == 0)
+    {
+        printf("buffer full: no event counted\n");
+        pContext->nrErrors++;
+    }
+
+    pContext->expected.nrBufferFullEvents = pStats->nrBufferFullEvents;
+
+    statsCheckCompare(pContext, "buffer full");
+}
+
+/*!
+ * Check the large transfer abort counter, with a large transfer restarted after its first page.
+ *
+ * \param[in]   pContext                Context.
+ */
+static void statsCheckLargeTransferAbort(StatsCheckContext *pContext)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            encoderInterface;
+    SbgEComProtocol         encoder;
+    uint8_t                *pPayload;
+    uint8_t                *pFrames;
+    size_t                  size = 0;
+
+    assert(pContext);
+
+    pPayload    = malloc(STATS_CHECK_LARGE_SIZE);
+    pFrames     = malloc(2 * STATS_CHECK_LARGE_SIZE);
+
+    errorCode = testInterfaceMemoryCreate(&encoderInterface, 0);
+
+    if ((errorCode == SBG_NO_ERROR) && pPayload && pFrames)
+    {
+        sbgEComProtocolInit(&encoder, &encoderInterface);
+
+        for (size_t i = 0; i < STATS_CHECK_LARGE_SIZE; i++)
+        {
+            pPayload[i] = (uint8_t)statsCheckRandom(&pContext->state);
+        }
+
+        errorCode = sbgEComProtocolSend(&encoder, SBG_ECOM_CLASS_LOG_ECOM_0, 8, pPayload, STATS_CHECK_LARGE_SIZE);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgInterfaceRead(&encoderInterface, pFrames, &size, 2 * STATS_CHECK_LARGE_SIZE);
+        }
+
+        sbgEComProtocolClose(&encoder);
+        sbgInterfaceDestroy(&encoderInterface);
+    }
+    else
+    {
+        errorCode = SBG_MALLOC_FAILED;
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        SbgEComProtocolPayload  payload;
+        size_t              firstPageSize;
+        size_t              nrPages = 0;
+        uint8_t             msgClass;
+        uint8_t             msgId;
+
+        firstPageSize = 9 + (pFrames[4] | (pFrames[5] << 8));
+
+        for (size_t offset = 0; offset < size; offset += 9 + (pFrames[offset + 4] | (pFrames[offset + 5] << 8)))
+        {
+            nrPages++;
+        }
+
+        statsCheckWrite(pContext, pFrames, firstPageSize);
+        statsCheckWrite(pContext, pFrames, size);
+        pContext->expected.nrLargeTransferAborts++;
+
+        for (size_t i = 0; i < (nrPages + 1); i++)
+        {
+            statsCheckExpectFrame(pContext, SBG_ECOM_CLASS_LOG_ECOM_0, 8);
+        }
+
+        sbgEComProtocolPayloadConstruct(&payload);
+
+        //
+        // Pages are processed as they fit in the work buffer.
+        //
+        for (size_t i = 0; i < (2 * nrPages); i++)
+        {
+            errorCode = sbgEComProtocolReceive2(&pContext->protocol, &msgClass, &msgId, &payload);
+
+            if (errorCode != SBG_NOT_READY)
+            {
+                break;
+            }
+        }
+
+        if ((errorCode != SBG_NO_ERROR) || (msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != 8) ||
+            (sbgEComProtocolPayloadGetSize(&payload) != STATS_CHECK_LARGE_SIZE) || (memcmp(sbgEComProtocolPayloadGetBuffer(&payload), pPayload, STATS_CHECK_LARGE_SIZE) != 0))
+        {
+            printf("large transfer abort: large transfer not received\n");
+            pContext->nrErrors++;
+        }
+
+        sbgEComProtocolPayloadDestroy(&payload);
+
+        //
+        // The exact number of events depends on how pages are aligned with the buffer end.
+        //
+        pContext->expected.nrBufferFullEvents = sbgEComProtocolGetStats(&pContext->protocol)->nrBufferFullEvents;
+
+        statsCheckCompare(pContext, "large transfer abort");
+    }
+    else
+    {
+        SBG_LOG_ERROR(errorCode, "unable to encode large transfer");
+        pContext->nrErrors++;
+    }
+
+    free(pFrames);
+    free(pPayload);
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode;
+    StatsCheckContext      *pContext = &gStatsCheckContext;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(statsCheckOnLog);
+
+    memset(pContext, 0, sizeof(*pContext));
+    pContext->state = 0x2545f491;
+
+    errorCode = testInterfaceMemoryCreate(&pContext->interface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&pContext->protocol, &pContext->interface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            statsCheckCompare(pContext, "init");
+
+            statsCheckValidFrames(pContext);
+            statsCheckErrors(pContext);
+            statsCheckBufferFull(pContext);
+            statsCheckLargeTransferAbort(pContext);
+
+            sbgEComProtocolResetStats(&pContext->protocol);
+            memset(&pContext->expected, 0, sizeof(pContext->expected));
+
+            statsCheckCompare(pContext, "reset");
+
+            sbgEComProtocolClose(&pContext->protocol);
+        }
+
+        sbgInterfaceDestroy(&pContext->interface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        pContext->nrErrors++;
+    }
+
+    printf("%zu errors\n", pContext->nrErrors);
+
+    return (pContext->nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
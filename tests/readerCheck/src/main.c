@@ -0,0 +1,471 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the reader thread delivers logs in order and accounts for the logs it drops.
+ *
+ * Logs, some of them larger than the ring slots and some of them not subscribed, are received
+ * through the reader thread with a ring deep enough to never drop logs, then with small rings
+ * and a slow consumer, for both drop policies.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define READER_CHECK_NR_LOGS                (4000)          /*!< Number of logs sent in each run. */
+#define READER_CHECK_MAX_PAYLOAD_SIZE       (1600)          /*!< Maximum payload size, in bytes, larger than the default ring slots. */
+#define READER_CHECK_MAX_READ_SIZE          (300)           /*!< Maximum number of bytes read at once. */
+#define READER_CHECK_SLOW_PERIOD            (64)            /*!< Number of logs between two pauses of a slow consumer. */
+#define READER_CHECK_TIME_OUT               (10000)         /*!< Maximum duration of a run, in ms. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log sent.
+ */
+typedef struct _ReaderCheckLog
+{
+    SbgEComMsgId            msgId;                          /*!< Message ID. */
+    size_t                  size;                           /*!< Payload size, in bytes. */
+    uint8_t                 payload[READER_CHECK_MAX_PAYLOAD_SIZE];     /*!< Payload. */
+} ReaderCheckLog;
+
+/*!
+ * Check context.
+ */
+typedef struct _ReaderCheckContext
+{
+    const ReaderCheckLog   *pLogs;                          /*!< Logs sent. */
+    bool                    slowConsumer;                   /*!< True to pause regularly in the log callback. */
+    size_t                  nrLogs;                         /*!< Number of logs received. */
+    size_t                  nextIndex;                      /*!< Lowest index of the next log expected. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} ReaderCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Message IDs of the logs sent, in turn, SBG_ECOM_LOG_EKF_EULER logs aren't subscribed.
+ */
+static const SbgEComMsgId   gReaderCheckMsgIds[] =
+{
+    SBG_ECOM_LOG_STATUS,
+    SBG_ECOM_LOG_UTC_TIME,
+    SBG_ECOM_LOG_IMU_SHORT,
+    SBG_ECOM_LOG_EKF_EULER,
+    SBG_ECOM_LOG_GPS1_RAW,
+};
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t readerCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Encode a log.
+ *
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[out]  pPayload                Payload.
+ * \param[out]  pSize                   Payload size, in bytes.
+ * \return                              SBG_NO_ERROR if the log has been encoded.
+ */
+static SbgErrorCode readerCheckEncode(SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, uint8_t *pPayload, size_t *pSize)
+{
+    SbgErrorCode            errorCode;
+    SbgStreamBuffer         streamBuffer;
+
+    assert(pLogData);
+    assert(pPayload);
+    assert(pSize);
+
+    sbgStreamBufferInitForWrite(&streamBuffer, pPayload, READER_CHECK_MAX_PAYLOAD_SIZE);
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_STATUS:
+        errorCode = sbgEComLogStatusWriteToStream(&pLogData->statusData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_UTC_TIME:
+        errorCode = sbgEComLogUtcWriteToStream(&pLogData->utcData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_IMU_SHORT:
+        errorCode = sbgEComLogImuShortWriteToStream(&pLogData->imuShort, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_EKF_EULER:
+        errorCode = sbgEComLogEkfEulerWriteToStream(&pLogData->ekfEulerData, &streamBuffer);
+        break;
+    case SBG_ECOM_LOG_GPS1_RAW:
+        errorCode = sbgEComLogRawDataWriteToStream(&pLogData->gpsRawData, &streamBuffer);
+        break;
+    default:
+        errorCode = SBG_INVALID_PARAMETER;
+    }
+
+    *pSize = sbgStreamBufferGetLength(&streamBuffer);
+
+    return errorCode;
+}
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Get the index of a log, stored in its time stamp or in the first bytes of raw data.
+ *
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \return                              Log index.
+ */
+static size_t readerCheckGetIndex(SbgEComMsgId msgId, const SbgEComLogUnion *pLogData)
+{
+    size_t                  index;
+
+    assert(pLogData);
+
+    switch (msgId)
+    {
+    case SBG_ECOM_LOG_STATUS:
+        index = pLogData->statusData.timeStamp;
+        break;
+    case SBG_ECOM_LOG_UTC_TIME:
+        index = pLogData->utcData.timeStamp;
+        break;
+    case SBG_ECOM_LOG_IMU_SHORT:
+        index = pLogData->imuShort.timeStamp;
+        break;
+    case SBG_ECOM_LOG_EKF_EULER:
+        index = pLogData->ekfEulerData.timeStamp;
+        break;
+    default:
+        memcpy(&index, pLogData->gpsRawData.rawBuffer, sizeof(index));
+    }
+
+    return index;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+/*!
+ * Build a log filled with pseudo random values.
+ *
+ * Bytes are chosen so that floating point values are finite, and encoded again identically.
+ *
+ * \param[out]  pLog                    Log.
+ * \param[in]   index                   Log index.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the log has been built.
+ */
+static SbgErrorCode readerCheckBuildLog(ReaderCheckLog *pLog, size_t index, uint32_t *pState)
+{
+    static SbgEComLogUnion  logData;
+    uint8_t                *pBytes = (uint8_t *)&logData;
+
+    assert(pLog);
+
+    for (size_t i = 0; i < sizeof(logData); i++)
+    {
+        pBytes[i] = (uint8_t)(0x10 + (readerCheckRandom(pState) % 0x30));
+    }
+
+    pLog->msgId = gReaderCheckMsgIds[index % SBG_ARRAY_SIZE(gReaderCheckMsgIds)];
+
+    switch (pLog->msgId)
+    {
+    case SBG_ECOM_LOG_STATUS:
+        logData.statusData.timeStamp    = (uint32_t)index;
+        break;
+    case SBG_ECOM_LOG_UTC_TIME:
+        logData.utcData.timeStamp       = (uint32_t)index;
+        break;
+    case SBG_ECOM_LOG_IMU_SHORT:
+        logData.imuShort.timeStamp      = (uint32_t)index;
+        break;
+    case SBG_ECOM_LOG_EKF_EULER:
+        logData.ekfEulerData.timeStamp  = (uint32_t)index;
+        break;
+    default:
+        logData.gpsRawData.bufferSize   = sizeof(index) + (readerCheckRandom(pState) % (READER_CHECK_MAX_PAYLOAD_SIZE - sizeof(index)));
+        memcpy(logData.gpsRawData.rawBuffer, &index, sizeof(index));
+    }
+
+    return readerCheckEncode(pLog->msgId, &logData, pLog->payload, &pLog->size);
+}
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+/*!
+ * Log callback, check a received log against the log sent.
+ *
+ * Logs may be dropped when the ring is full, but those received must be in order and unmodified.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode readerCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    ReaderCheckContext     *pContext = pUserArg;
+    uint8_t                 payload[READER_CHECK_MAX_PAYLOAD_SIZE];
+    size_t                  index;
+    size_t                  size;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+
+    assert(pContext);
+
+    index = readerCheckGetIndex(msgId, pLogData);
+
+    if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId == SBG_ECOM_LOG_EKF_EULER) ||
+        (index < pContext->nextIndex) || (index >= READER_CHECK_NR_LOGS) || (msgId != pContext->pLogs[index].msgId) ||
+        (readerCheckEncode(msgId, pLogData, payload, &size) != SBG_NO_ERROR) ||
+        (size != pContext->pLogs[index].size) || (memcmp(payload, pContext->pLogs[index].payload, size) != 0))
+    {
+        printf("log %zu mismatch, message %u:%u, index %zu, %zu expected at least\n", pContext->nrLogs, msgClass, msgId, index, pContext->nextIndex);
+        pContext->nrErrors++;
+    }
+    else
+    {
+        pContext->nextIndex = index + 1;
+    }
+
+    pContext->nrLogs++;
+
+    if (pContext->slowConsumer && ((pContext->nrLogs % READER_CHECK_SLOW_PERIOD) == 0))
+    {
+        sbgSleep(2);
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Receive all the logs with the reader thread.
+ *
+ * The logs are written to the interface before the reader is started, so that it reads them
+ * as fast as it can. Logs received plus logs dropped by the ring must account for all the
+ * subscribed logs sent.
+ *
+ * \param[in]   pLogs                   Logs sent.
+ * \param[in]   pConfig                 Frame ring configuration.
+ * \param[in]   slowConsumer            True to pause regularly in the log callback.
+ * \param[in]   mayDrop                 True if the ring may drop logs.
+ * \return                              Number of errors.
+ */
+static size_t readerCheckRun(const ReaderCheckLog *pLogs, const SbgEComFrameRingConfig *pConfig, bool slowConsumer, bool mayDrop)
+{
+    SbgErrorCode                errorCode;
+    SbgInterface                memoryInterface;
+    SbgEComHandle               handle;
+    ReaderCheckContext          context;
+    SbgEComFrameRingStats       stats;
+    size_t                      nrSubscribedLogs = 0;
+    uint32_t                    nrDroppedLogs = 0;
+
+    memset(&context, 0, sizeof(context));
+    memset(&stats, 0, sizeof(stats));
+
+    context.pLogs           = pLogs;
+    context.slowConsumer    = slowConsumer;
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, READER_CHECK_MAX_READ_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComSetReceiveLogCallback(&handle, readerCheckOnLogReceived, &context);
+            sbgEComUnsubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER);
+
+            for (size_t i = 0; (i < READER_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                errorCode = sbgEComProtocolSend(&handle.protocolHandle, SBG_ECOM_CLASS_LOG_ECOM_0, pLogs[i].msgId, pLogs[i].payload, pLogs[i].size);
+
+                if (pLogs[i].msgId != SBG_ECOM_LOG_EKF_EULER)
+                {
+                    nrSubscribedLogs++;
+                }
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                errorCode = sbgEComStartReader(&handle, pConfig);
+            }
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                uint32_t        startTime;
+
+                startTime = sbgGetTime();
+
+                //
+                // sbgEComHandle() returns SBG_NOT_READY once the ring is empty
+                //
+                while ((errorCode == SBG_NO_ERROR) &&
+                       ((context.nrLogs + stats.nrDroppedFrames < nrSubscribedLogs) || (nrDroppedLogs != READER_CHECK_NR_LOGS - nrSubscribedLogs)))
+                {
+                    errorCode = sbgEComHandle(&handle);
+
+                    if (errorCode == SBG_NOT_READY)
+                    {
+                        errorCode = SBG_NO_ERROR;
+                    }
+
+                    if ((errorCode == SBG_NO_ERROR) && ((sbgGetTime() - startTime) > READER_CHECK_TIME_OUT))
+                    {
+                        errorCode = SBG_TIME_OUT;
+                    }
+
+                    sbgEComWaitFrame(&handle, 10);
+
+                    sbgEComGetReaderStats(&handle, &stats);
+                    nrDroppedLogs = sbgEComGetNrDroppedLogs(&handle);
+                }
+
+                sbgEComStopReader(&handle);
+            }
+
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        context.nrErrors++;
+    }
+    else if ((context.nrLogs + stats.nrDroppedFrames != nrSubscribedLogs) || (!mayDrop && (stats.nrDroppedFrames != 0)))
+    {
+        printf("%zu logs received and %zu dropped, %zu sent\n", context.nrLogs, stats.nrDroppedFrames, nrSubscribedLogs);
+        context.nrErrors++;
+    }
+
+    printf("ring of %zu frames, %zu logs received, %zu dropped by the ring, %" PRIu32 " unsubscribed, %zu errors\n",
+           pConfig->depth, context.nrLogs, stats.nrDroppedFrames, nrDroppedLogs, context.nrErrors);
+
+    return context.nrErrors;
+}
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    ReaderCheckLog             *pLogs;
+    uint32_t                    state = 0x7eade125;
+    size_t                      nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    pLogs = malloc(READER_CHECK_NR_LOGS * sizeof(*pLogs));
+
+    if (pLogs)
+    {
+        for (size_t i = 0; i < READER_CHECK_NR_LOGS; i++)
+        {
+            if (readerCheckBuildLog(&pLogs[i], i, &state) != SBG_NO_ERROR)
+            {
+                printf("unable to build log %zu\n", i);
+                nrErrors++;
+            }
+        }
+
+#if SBG_CONFIG_ENABLE_THREADS != 0
+        if (nrErrors == 0)
+        {
+            const SbgEComFrameRingConfig    configs[] =
+            {
+                { READER_CHECK_NR_LOGS, SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE, SBG_ECOM_FRAME_RING_DROP_NEWEST },
+                { 4,                    SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE, SBG_ECOM_FRAME_RING_DROP_NEWEST },
+                { 4,                    SBG_ECOM_FRAME_RING_DEFAULT_SLOT_SIZE, SBG_ECOM_FRAME_RING_DROP_OLDEST },
+            };
+
+            //
+            // The reader reads the whole capture at once, a ring as deep as the capture never drops logs
+            //
+            nrErrors += readerCheckRun(pLogs, &configs[0], false, false);
+            nrErrors += readerCheckRun(pLogs, &configs[1], true, true);
+            nrErrors += readerCheckRun(pLogs, &configs[2], true, true);
+        }
+#else
+        printf("threads are disabled, the reader thread isn't checked\n");
+#endif // SBG_CONFIG_ENABLE_THREADS != 0
+
+        free(pLogs);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,424 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the batch reception of frames.
+ *
+ * Frames, large transfers included, are received by batches of pseudo random sizes in both
+ * receive modes. Every descriptor of a batch must remain valid until the next receive attempt,
+ * and a large transfer must end its batch.
+ *
+ * Logs are also handled with sbgEComHandle() while the log callback receives frames, as a command
+ * sent from a callback does. Frames must be received in order, whether dispatched or received
+ * from the callback.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define BATCH_CHECK_NR_FRAMES               (4000)          /*!< Number of frames sent in each receive mode. */
+#define BATCH_CHECK_MAX_LARGE_SIZE          (10000)         /*!< Maximum payload size of a large transfer, in bytes. */
+#define BATCH_CHECK_MAX_BATCH_SIZE          (8)             /*!< Maximum number of frames received at once. */
+#define BATCH_CHECK_MAX_READ_SIZE           (2000)          /*!< Maximum number of bytes read at once. */
+#define BATCH_CHECK_NR_LOGS                 (2000)          /*!< Number of logs handled. */
+#define BATCH_CHECK_RECEIVE_PERIOD          (5)             /*!< Number of logs between two frames received from a log callback. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log handling check context.
+ */
+typedef struct _BatchCheckContext
+{
+    size_t                  nextIndex;                      /*!< Index of the next log expected. */
+    size_t                  nrHandledLogs;                  /*!< Number of logs passed to the log callback. */
+    size_t                  nrReceivedLogs;                 /*!< Number of logs received from the log callback. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} BatchCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Payload buffer, too large for the stack.
+ */
+static uint8_t              gBatchCheckPayload[BATCH_CHECK_MAX_LARGE_SIZE];
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t batchCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a payload with the bytes expected for a frame.
+ *
+ * \param[in]   frameIndex              Frame index.
+ * \param[out]  pPayload                Payload.
+ * \return                              Payload size, in bytes.
+ */
+static size_t batchCheckGetPayload(size_t frameIndex, uint8_t *pPayload)
+{
+    uint32_t                state;
+    size_t                  size;
+    uint32_t                kind;
+
+    state   = (uint32_t)frameIndex * 2246822519u + 7;
+    kind    = batchCheckRandom(&state) % 100;
+
+    if (kind < 70)
+    {
+        size = batchCheckRandom(&state) % 80;
+    }
+    else if (kind < 98)
+    {
+        size = batchCheckRandom(&state) % (SBG_ECOM_MAX_PAYLOAD_SIZE + 1);
+    }
+    else
+    {
+        size = SBG_ECOM_MAX_PAYLOAD_SIZE + 1 + (batchCheckRandom(&state) % (BATCH_CHECK_MAX_LARGE_SIZE - SBG_ECOM_MAX_PAYLOAD_SIZE));
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pPayload[i] = (uint8_t)(batchCheckRandom(&state) >> 7);
+    }
+
+    return size;
+}
+
+/*!
+ * Check a frame descriptor against the expected frame.
+ *
+ * \param[in]   pFrame                  Frame descriptor.
+ * \param[in]   frameIndex              Frame index.
+ * \return                              True if the frame matches.
+ */
+static bool batchCheckFrame(const SbgEComProtocolFrameDescriptor *pFrame, size_t frameIndex)
+{
+    size_t                  size;
+
+    assert(pFrame);
+
+    size = batchCheckGetPayload(frameIndex, gBatchCheckPayload);
+
+    return (pFrame->msgClass == SBG_ECOM_CLASS_LOG_ECOM_0) && (pFrame->msgId == (frameIndex % 128)) && (pFrame->payloadSize == size) &&
+           ((size == 0) || (memcmp(pFrame->pPayload, gBatchCheckPayload, size) == 0));
+}
+
+/*!
+ * Send frames and receive them back by batches in a receive mode.
+ *
+ * All the descriptors of a batch are checked once the batch is received, so a payload moved or
+ * overwritten before the next receive attempt is reported.
+ *
+ * \param[in]   rxMode                  Receive mode.
+ * \return                              Number of errors.
+ */
+static size_t batchCheckRun(SbgEComProtocolRxMode rxMode)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    uint32_t                state = 0x0badcafe;
+    size_t                  nrFrames = 0;
+    size_t                  nrBatches = 0;
+    size_t                  nrErrors = 0;
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, BATCH_CHECK_MAX_READ_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComProtocolSetRxMode(&protocol, rxMode);
+        }
+
+        for (size_t i = 0; (i < BATCH_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            size_t          size;
+
+            size        = batchCheckGetPayload(i, gBatchCheckPayload);
+            errorCode   = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(i % 128), gBatchCheckPayload, size);
+        }
+
+        while ((nrFrames < BATCH_CHECK_NR_FRAMES) && ((errorCode == SBG_NO_ERROR) || (errorCode == SBG_NOT_READY)))
+        {
+            SbgEComProtocolFrameDescriptor  frames[BATCH_CHECK_MAX_BATCH_SIZE];
+            size_t                          maxFrames;
+            size_t                          nrBatchFrames;
+
+            maxFrames = 1 + (batchCheckRandom(&state) % BATCH_CHECK_MAX_BATCH_SIZE);
+            errorCode = sbgEComProtocolReceiveBatch(&protocol, frames, maxFrames, &nrBatchFrames);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                if ((nrBatchFrames == 0) || (nrBatchFrames > maxFrames))
+                {
+                    printf("batch %zu: %zu frames received, at most %zu expected\n", nrBatches, nrBatchFrames, maxFrames);
+                    nrErrors++;
+                }
+
+                for (size_t i = 0; (i < nrBatchFrames) && (i < maxFrames); i++)
+                {
+                    if (!batchCheckFrame(&frames[i], nrFrames))
+                    {
+                        printf("batch %zu: frame %zu mismatch\n", nrBatches, nrFrames);
+                        nrErrors++;
+                    }
+                    else if ((frames[i].payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE) && (i != (nrBatchFrames - 1)))
+                    {
+                        printf("batch %zu: large transfer %zu doesn't end the batch\n", nrBatches, nrFrames);
+                        nrErrors++;
+                    }
+
+                    nrFrames++;
+                }
+
+                nrBatches++;
+            }
+            else if ((errorCode == SBG_NOT_READY) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) == 0))
+            {
+                errorCode = SBG_TIME_OUT;
+            }
+        }
+
+        if (nrFrames != BATCH_CHECK_NR_FRAMES)
+        {
+            printf("%zu frames received, %d expected\n", nrFrames, BATCH_CHECK_NR_FRAMES);
+            nrErrors++;
+        }
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    printf("%s mode: %zu frames received in %zu batches, %zu errors\n",
+           (rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING) ? "ring" : "linear", nrFrames, nrBatches, nrErrors);
+
+    return nrErrors;
+}
+
+/*!
+ * Log callback, check the logs are handled in order and receive a frame from time to time.
+ *
+ * A frame received from the callback, as a command sent from a callback does, must be the next
+ * log of the batch being dispatched.
+ *
+ * \param[in]   pHandle                 sbgECom handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log.
+ * \param[in]   pUserArg                Check context.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode batchCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    BatchCheckContext      *pContext = pUserArg;
+
+    assert(pContext);
+
+    if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != SBG_ECOM_LOG_UTC_TIME) || (pLogData->utcData.timeStamp != pContext->nextIndex))
+    {
+        printf("log %zu mismatch\n", pContext->nextIndex);
+        pContext->nrErrors++;
+    }
+
+    pContext->nextIndex = pLogData->utcData.timeStamp + 1;
+    pContext->nrHandledLogs++;
+
+    if ((pContext->nrHandledLogs % BATCH_CHECK_RECEIVE_PERIOD) == 0)
+    {
+        SbgErrorCode            errorCode;
+        SbgEComProtocolPayload  payload;
+        uint8_t                 receivedClass;
+        uint8_t                 receivedId;
+
+        sbgEComProtocolPayloadConstruct(&payload);
+
+        errorCode = sbgEComReceiveFrame(pHandle, &receivedClass, &receivedId, &payload);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComLogUtc       utcLog;
+            SbgStreamBuffer     inputStream;
+
+            sbgStreamBufferInitForRead(&inputStream, sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload));
+
+            errorCode = sbgEComLogUtcReadFromStream(&utcLog, &inputStream);
+
+            if ((errorCode != SBG_NO_ERROR) || (receivedId != SBG_ECOM_LOG_UTC_TIME) || (utcLog.timeStamp != pContext->nextIndex))
+            {
+                printf("log %zu received from a callback mismatch\n", pContext->nextIndex);
+                pContext->nrErrors++;
+            }
+
+            pContext->nextIndex = utcLog.timeStamp + 1;
+            pContext->nrReceivedLogs++;
+        }
+
+        sbgEComProtocolPayloadDestroy(&payload);
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Handle logs with sbgEComHandle() while the log callback receives frames.
+ *
+ * \return                              Number of errors.
+ */
+static size_t batchCheckHandle(void)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComHandle           handle;
+    BatchCheckContext       context;
+
+    memset(&context, 0, sizeof(context));
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, BATCH_CHECK_MAX_READ_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComSetReceiveLogCallback(&handle, batchCheckOnLogReceived, &context);
+
+            for (size_t i = 0; (i < BATCH_CHECK_NR_LOGS) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                SbgEComLogUtc   utcLog;
+                SbgStreamBuffer outputStream;
+
+                memset(&utcLog, 0, sizeof(utcLog));
+                utcLog.timeStamp = (uint32_t)i;
+
+                sbgStreamBufferInitForWrite(&outputStream, gBatchCheckPayload, sizeof(gBatchCheckPayload));
+
+                errorCode = sbgEComLogUtcWriteToStream(&utcLog, &outputStream);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    errorCode = sbgEComProtocolSend(&handle.protocolHandle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME, gBatchCheckPayload, sbgStreamBufferGetLength(&outputStream));
+                }
+            }
+
+            while ((errorCode == SBG_NO_ERROR) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) != 0))
+            {
+                errorCode = sbgEComHandle(&handle);
+
+                if (errorCode == SBG_NOT_READY)
+                {
+                    errorCode = SBG_NO_ERROR;
+                }
+            }
+
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to handle the logs");
+        context.nrErrors++;
+    }
+
+    if ((context.nextIndex != BATCH_CHECK_NR_LOGS) || (context.nrReceivedLogs == 0))
+    {
+        printf("%zu logs handled, %d expected\n", context.nextIndex, BATCH_CHECK_NR_LOGS);
+        context.nrErrors++;
+    }
+
+    printf("handle: %zu logs dispatched, %zu received from a callback, %zu errors\n", context.nrHandledLogs, context.nrReceivedLogs, context.nrErrors);
+
+    return context.nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += batchCheckRun(SBG_ECOM_PROTOCOL_RX_MODE_LINEAR);
+    nrErrors += batchCheckRun(SBG_ECOM_PROTOCOL_RX_MODE_RING);
+    nrErrors += batchCheckHandle();
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,526 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Stress the protocol resynchronization with bit errors.
+ *
+ * A stream of frames is corrupted at several bit error rates and arrives by small chunks, as from
+ * a serial link. It is received with look-ahead disabled and enabled, with and without early
+ * message class rejection.
+ *
+ * Frames without flipped bits must all be received and corrupted frames must all be rejected. The
+ * recovery latency, the number of stream bytes arrived after the end of the first frame following
+ * a corrupted one before it's received, is reported. Some frames carry a nested frame, as raw
+ * data forwarded from another device, which look-ahead may receive instead of the carrying frame.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define RESYNC_CHECK_NR_FRAMES              (3000)          /*!< Number of frames in the stream. */
+#define RESYNC_CHECK_MIN_PAYLOAD_SIZE       (4)             /*!< Minimum payload size, holding the frame index, in bytes. */
+#define RESYNC_CHECK_MAX_PAYLOAD_SIZE       (200)           /*!< Maximum payload size, in bytes. */
+#define RESYNC_CHECK_NESTED_PERIOD          (50)            /*!< Number of frames between two frames carrying a nested frame. */
+#define RESYNC_CHECK_NESTED_ID              (0xc0)          /*!< Message ID of the nested frames. */
+#define RESYNC_CHECK_CHUNK_SIZE             (64)            /*!< Number of bytes arriving between two receive attempts. */
+#define RESYNC_CHECK_PADDING_SIZE           (8192)          /*!< Number of padding bytes after the stream, completing any pending frame. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Frame of the stream.
+ */
+typedef struct _ResyncCheckFrame
+{
+    size_t                  endOffset;                      /*!< Offset of the byte following the frame in the stream. */
+    bool                    nested;                         /*!< True if the payload carries a nested frame. */
+    bool                    corrupted;                      /*!< True if at least one bit of the frame has been flipped. */
+} ResyncCheckFrame;
+
+/*!
+ * Corrupted stream.
+ */
+typedef struct _ResyncCheckStream
+{
+    uint8_t                *pBuffer;                        /*!< Stream bytes, allocated with malloc(). */
+    size_t                  size;                           /*!< Stream size, in bytes. */
+    ResyncCheckFrame        frames[RESYNC_CHECK_NR_FRAMES]; /*!< Frames. */
+    size_t                  nrFlippedBits;                  /*!< Number of bits flipped. */
+    size_t                  nrCorruptedFrames;              /*!< Number of frames with flipped bits. */
+} ResyncCheckStream;
+
+/*!
+ * Result of a run.
+ */
+typedef struct _ResyncCheckResult
+{
+    size_t                  nrFrames;                       /*!< Number of frames received. */
+    size_t                  nrLostFrames;                   /*!< Number of frames without flipped bits not received. */
+    size_t                  nrSkippedFrames;                /*!< Number of frames carrying a nested frame, without flipped bits, not received. */
+    size_t                  nrUndetectedErrors;             /*!< Number of frames received with flipped bits. */
+    size_t                  nrRecoveries;                   /*!< Number of frames received right after a corrupted frame. */
+    size_t                  totalRecoveryLatency;           /*!< Sum of the recovery latencies, in bytes. */
+    size_t                  maxRecoveryLatency;             /*!< Maximum recovery latency, in bytes. */
+    uint32_t                duration;                       /*!< Processing duration, in ms. */
+} ResyncCheckResult;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Corrupted stream, too large for the stack.
+ */
+static ResyncCheckStream    gResyncCheckStream;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t resyncCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Log function, discarding the errors reported for corrupted frames.
+ *
+ * \param[in]   pFileName               File name.
+ * \param[in]   pFunctionName           Function name.
+ * \param[in]   line                    Line number.
+ * \param[in]   pCategory               Category.
+ * \param[in]   logType                 Log type.
+ * \param[in]   errorCode               Error code.
+ * \param[in]   pMessage                Message.
+ */
+static void resyncCheckOnLog(const char *pFileName, const char *pFunctionName, uint32_t line, const char *pCategory, SbgDebugLogType logType, SbgErrorCode errorCode, const char *pMessage)
+{
+    SBG_UNUSED_PARAMETER(pFileName);
+    SBG_UNUSED_PARAMETER(pFunctionName);
+    SBG_UNUSED_PARAMETER(line);
+    SBG_UNUSED_PARAMETER(pCategory);
+    SBG_UNUSED_PARAMETER(logType);
+    SBG_UNUSED_PARAMETER(errorCode);
+    SBG_UNUSED_PARAMETER(pMessage);
+}
+
+/*!
+ * Fill a payload with the bytes expected for a frame.
+ *
+ * The payload starts with the frame index. Some payloads carry a whole nested frame, as raw
+ * data forwarding another sbgECom device would.
+ *
+ * \param[in]   frameIndex              Frame index.
+ * \param[out]  pPayload                Payload.
+ * \return                              Payload size, in bytes.
+ */
+static size_t resyncCheckGetPayload(size_t frameIndex, uint8_t *pPayload)
+{
+    uint32_t                state;
+    size_t                  size;
+    SbgStreamBuffer         outputStream;
+
+    state   = (uint32_t)frameIndex * 2654435761u + 3;
+    size    = RESYNC_CHECK_MIN_PAYLOAD_SIZE + (resyncCheckRandom(&state) % (RESYNC_CHECK_MAX_PAYLOAD_SIZE - RESYNC_CHECK_MIN_PAYLOAD_SIZE + 1));
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pPayload[i] = (uint8_t)(resyncCheckRandom(&state) >> 9);
+    }
+
+    sbgStreamBufferInitForWrite(&outputStream, pPayload, size);
+    sbgStreamBufferWriteUint32LE(&outputStream, (uint32_t)frameIndex);
+
+    if (((frameIndex % RESYNC_CHECK_NESTED_PERIOD) == 0) && (size >= 64))
+    {
+        size_t              streamCursor;
+
+        sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, RESYNC_CHECK_NESTED_ID, &streamCursor);
+        sbgStreamBufferWriteUint32LE(&outputStream, (uint32_t)frameIndex);
+        sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+    }
+
+    return size;
+}
+
+/*!
+ * Build a stream of frames and flip its bits at a given bit error rate.
+ *
+ * \param[out]  pStream                 Stream.
+ * \param[in]   bitErrorRate            Bit error rate.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the stream has been built.
+ */
+static SbgErrorCode resyncCheckBuildStream(ResyncCheckStream *pStream, double bitErrorRate, uint32_t *pState)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+
+    assert(pStream);
+
+    free(pStream->pBuffer);
+    memset(pStream, 0, sizeof(*pStream));
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        for (size_t i = 0; (i < RESYNC_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            uint8_t         payload[RESYNC_CHECK_MAX_PAYLOAD_SIZE];
+            size_t          size;
+
+            size        = resyncCheckGetPayload(i, payload);
+            errorCode   = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(i % 128), payload, size);
+
+            pStream->frames[i].endOffset    = testInterfaceMemoryGetNrPendingBytes(&memoryInterface);
+            pStream->frames[i].nested       = ((i % RESYNC_CHECK_NESTED_PERIOD) == 0) && (size >= 64);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            pStream->size       = testInterfaceMemoryGetNrPendingBytes(&memoryInterface);
+            pStream->pBuffer    = malloc(pStream->size);
+
+            if (pStream->pBuffer)
+            {
+                errorCode = sbgInterfaceRead(&memoryInterface, pStream->pBuffer, &pStream->size, pStream->size);
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+            }
+        }
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        uint32_t            threshold;
+        size_t              frameIndex = 0;
+
+        //
+        // Each byte is corrupted with a probability of 8 times the bit error rate, on a single bit
+        //
+        threshold = (uint32_t)(bitErrorRate * 8.0 * 4294967296.0);
+
+        for (size_t i = 0; i < pStream->size; i++)
+        {
+            while (pStream->frames[frameIndex].endOffset <= i)
+            {
+                frameIndex++;
+            }
+
+            if (resyncCheckRandom(pState) < threshold)
+            {
+                pStream->pBuffer[i] ^= (uint8_t)(1 << (resyncCheckRandom(pState) % 8));
+                pStream->nrFlippedBits++;
+
+                if (!pStream->frames[frameIndex].corrupted)
+                {
+                    pStream->frames[frameIndex].corrupted = true;
+                    pStream->nrCorruptedFrames++;
+                }
+            }
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Account for frames not received.
+ *
+ * \param[in]   pStream                 Stream.
+ * \param[in]   startIndex              Index of the first frame not received.
+ * \param[in]   endIndex                Index of the frame following the last frame not received.
+ * \param[in]   pResult                 Result.
+ */
+static void resyncCheckCountMissed(const ResyncCheckStream *pStream, size_t startIndex, size_t endIndex, ResyncCheckResult *pResult)
+{
+    assert(pStream);
+    assert(pResult);
+
+    for (size_t i = startIndex; i < endIndex; i++)
+    {
+        if (!pStream->frames[i].corrupted)
+        {
+            if (pStream->frames[i].nested)
+            {
+                pResult->nrSkippedFrames++;
+            }
+            else
+            {
+                pResult->nrLostFrames++;
+            }
+        }
+    }
+}
+
+/*!
+ * Check a received frame, and account for the frames missed before it.
+ *
+ * \param[in]   pStream                 Stream.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \param[in]   nrArrivedBytes          Number of stream bytes arrived so far.
+ * \param[in]   pNextIndex              Index of the next frame expected.
+ * \param[in]   pResult                 Result.
+ */
+static void resyncCheckFrame(const ResyncCheckStream *pStream, uint8_t msgId, const uint8_t *pPayload, size_t size, size_t nrArrivedBytes, size_t *pNextIndex, ResyncCheckResult *pResult)
+{
+    uint8_t                 expected[RESYNC_CHECK_MAX_PAYLOAD_SIZE];
+    size_t                  frameIndex = RESYNC_CHECK_NR_FRAMES;
+
+    assert(pStream);
+    assert(pNextIndex);
+    assert(pResult);
+
+    if ((msgId != RESYNC_CHECK_NESTED_ID) && (size >= RESYNC_CHECK_MIN_PAYLOAD_SIZE))
+    {
+        frameIndex = pPayload[0] | (pPayload[1] << 8) | (pPayload[2] << 16) | ((size_t)pPayload[3] << 24);
+    }
+
+    if ((frameIndex < RESYNC_CHECK_NR_FRAMES) && (frameIndex >= *pNextIndex) && (msgId == (frameIndex % 128)) &&
+        (resyncCheckGetPayload(frameIndex, expected) == size) && (memcmp(pPayload, expected, size) == 0))
+    {
+        resyncCheckCountMissed(pStream, *pNextIndex, frameIndex, pResult);
+
+        if ((frameIndex != 0) && pStream->frames[frameIndex - 1].corrupted)
+        {
+            size_t          latency;
+
+            latency = nrArrivedBytes - pStream->frames[frameIndex].endOffset;
+
+            pResult->nrRecoveries++;
+            pResult->totalRecoveryLatency   += latency;
+            pResult->maxRecoveryLatency     = sbgMax(pResult->maxRecoveryLatency, latency);
+        }
+
+        if (pStream->frames[frameIndex].corrupted)
+        {
+            pResult->nrUndetectedErrors++;
+        }
+
+        pResult->nrFrames++;
+        *pNextIndex = frameIndex + 1;
+    }
+    else if (msgId != RESYNC_CHECK_NESTED_ID)
+    {
+        pResult->nrUndetectedErrors++;
+    }
+}
+
+/*!
+ * Receive a corrupted stream, arriving by chunks, with a resynchronization configuration.
+ *
+ * \param[in]   pStream                 Stream.
+ * \param[in]   pConfig                 Resynchronization configuration.
+ * \param[out]  pResult                 Result.
+ * \return                              SBG_NO_ERROR if the stream has been received.
+ */
+static SbgErrorCode resyncCheckRun(const ResyncCheckStream *pStream, const SbgEComProtocolResyncConfig *pConfig, ResyncCheckResult *pResult)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    SbgEComProtocolPayload  payload;
+    size_t                  nextIndex = 0;
+    size_t                  nrArrivedBytes = 0;
+    uint32_t                startTime;
+
+    assert(pStream);
+    assert(pResult);
+
+    memset(pResult, 0, sizeof(*pResult));
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        sbgEComProtocolSetResyncConfig(&protocol, pConfig);
+
+        startTime = sbgGetTime();
+
+        while ((nrArrivedBytes < (pStream->size + RESYNC_CHECK_PADDING_SIZE)) && (errorCode == SBG_NO_ERROR))
+        {
+            size_t          size;
+
+            //
+            // Stream bytes arrive by chunks, then zero bytes complete any frame still pending
+            //
+            if (nrArrivedBytes < pStream->size)
+            {
+                size        = sbgMin(RESYNC_CHECK_CHUNK_SIZE, pStream->size - nrArrivedBytes);
+                errorCode   = sbgInterfaceWrite(&memoryInterface, &pStream->pBuffer[nrArrivedBytes], size);
+            }
+            else
+            {
+                static const uint8_t    padding[RESYNC_CHECK_CHUNK_SIZE];
+
+                size        = RESYNC_CHECK_CHUNK_SIZE;
+                errorCode   = sbgInterfaceWrite(&memoryInterface, padding, size);
+            }
+
+            nrArrivedBytes += size;
+
+            while (errorCode == SBG_NO_ERROR)
+            {
+                uint8_t     msgClass;
+                uint8_t     msgId;
+
+                errorCode = sbgEComProtocolReceive2(&protocol, &msgClass, &msgId, &payload);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    resyncCheckFrame(pStream, msgId, sbgEComProtocolPayloadGetBuffer(&payload), sbgEComProtocolPayloadGetSize(&payload), nrArrivedBytes, &nextIndex, pResult);
+                }
+            }
+
+            if (errorCode == SBG_NOT_READY)
+            {
+                errorCode = SBG_NO_ERROR;
+            }
+        }
+
+        pResult->duration = sbgGetTime() - startTime;
+
+        resyncCheckCountMissed(pStream, nextIndex, RESYNC_CHECK_NR_FRAMES, pResult);
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static const double     bitErrorRates[] = { 1e-5, 1e-4, 1e-3 };
+    uint32_t                state = 0x31415927;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    sbgCommonLibSetLogCallback(resyncCheckOnLog);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(bitErrorRates); i++)
+    {
+        SbgErrorCode                errorCode;
+
+        errorCode = resyncCheckBuildStream(&gResyncCheckStream, bitErrorRates[i], &state);
+
+        printf("bit error rate %g: %zu bits flipped, %zu corrupted frames out of %d\n", bitErrorRates[i], gResyncCheckStream.nrFlippedBits, gResyncCheckStream.nrCorruptedFrames, RESYNC_CHECK_NR_FRAMES);
+
+        for (size_t j = 0; (j < 4) && (errorCode == SBG_NO_ERROR); j++)
+        {
+            SbgEComProtocolResyncConfig     config;
+            ResyncCheckResult               result;
+
+            config.maxPendingTime   = 0;
+            config.lookAhead        = (j % 2) != 0;
+            config.maxMsgClass      = (j < 2) ? 0x7f : SBG_ECOM_CLASS_LOG_ECOM_0;
+
+            errorCode = resyncCheckRun(&gResyncCheckStream, &config, &result);
+
+            printf("  look-ahead %s, max class 0x%02x: %zu frames, %zu lost, %zu with a nested frame skipped, %zu undetected errors, "
+                   "recovery latency %zu bytes mean %zu max, %" PRIu32 " ms\n",
+                   config.lookAhead ? "on " : "off", config.maxMsgClass, result.nrFrames, result.nrLostFrames, result.nrSkippedFrames, result.nrUndetectedErrors,
+                   (result.nrRecoveries != 0) ? (result.totalRecoveryLatency / result.nrRecoveries) : 0, result.maxRecoveryLatency, result.duration);
+
+            //
+            // Frames without flipped bits must always be received, except frames carrying a nested
+            // frame that look-ahead may skip. Without look-ahead, no frame may be skipped, and with
+            // look-ahead a frame is received soon after its last byte has arrived.
+            //
+            if ((result.nrLostFrames != 0) || (result.nrUndetectedErrors != 0) || (!config.lookAhead && (result.nrSkippedFrames != 0)) ||
+                (config.lookAhead && (result.maxRecoveryLatency > (RESYNC_CHECK_CHUNK_SIZE + RESYNC_CHECK_MAX_PAYLOAD_SIZE))))
+            {
+                nrErrors++;
+            }
+        }
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            SBG_LOG_ERROR(errorCode, "unable to run the check");
+            nrErrors++;
+        }
+    }
+
+    free(gResyncCheckStream.pBuffer);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,308 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the runtime-sized reception buffers of the protocol.
+ *
+ * Reception buffers smaller than SBG_ECOM_MAX_BUFFER_SIZE must be rejected. A burst of frames is
+ * received with a provided buffer of the minimum size, a larger provided buffer and an allocated
+ * buffer, in both receive modes. The first receive attempt must drain the interface up to the
+ * buffer size, and every frame must be received in order. In linear mode, larger buffers must only
+ * be compacted once a whole frame can't fit after the first valid byte.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define RX_BUFFER_CHECK_NR_FRAMES           (2000)          /*!< Number of frames sent in each run. */
+#define RX_BUFFER_CHECK_MAX_PAYLOAD_SIZE    (200)           /*!< Maximum payload size, in bytes. */
+#define RX_BUFFER_CHECK_USER_SIZE           (65536)         /*!< Size of the reception buffer provided by the check, in bytes. */
+#define RX_BUFFER_CHECK_ALLOCATED_SIZE      (262144)        /*!< Size of the allocated reception buffer, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Reception buffer provided by the check.
+ */
+static uint8_t              gRxBufferCheckBuffer[RX_BUFFER_CHECK_USER_SIZE];
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fill a payload with the bytes expected for a frame.
+ *
+ * \param[in]   frameIndex              Frame index.
+ * \param[out]  pPayload                Payload.
+ * \return                              Payload size, in bytes.
+ */
+static size_t rxBufferCheckGetPayload(size_t frameIndex, uint8_t *pPayload)
+{
+    size_t                  size;
+
+    size = (frameIndex * 37) % (RX_BUFFER_CHECK_MAX_PAYLOAD_SIZE + 1);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pPayload[i] = (uint8_t)(frameIndex * 3 + i);
+    }
+
+    return size;
+}
+
+/*!
+ * Check that reception buffers smaller than SBG_ECOM_MAX_BUFFER_SIZE are rejected.
+ *
+ * \return                              Number of errors.
+ */
+static size_t rxBufferCheckMinSize(void)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    size_t                  nrErrors = 0;
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        SbgEComProtocol     protocol;
+        SbgEComHandle       handle;
+
+        if (sbgEComProtocolInitWithRxBuffer(&protocol, &memoryInterface, gRxBufferCheckBuffer, SBG_ECOM_MAX_BUFFER_SIZE - 1) != SBG_INVALID_PARAMETER)
+        {
+            printf("protocol reception buffer of %d bytes accepted\n", SBG_ECOM_MAX_BUFFER_SIZE - 1);
+            nrErrors++;
+        }
+
+        if (sbgEComProtocolInitWithRxBuffer(&protocol, &memoryInterface, NULL, 0) != SBG_INVALID_PARAMETER)
+        {
+            printf("empty protocol reception buffer accepted\n");
+            nrErrors++;
+        }
+
+        if (sbgEComInitWithRxBuffer(&handle, &memoryInterface, gRxBufferCheckBuffer, SBG_ECOM_MAX_BUFFER_SIZE - 1) != SBG_INVALID_PARAMETER)
+        {
+            printf("handle reception buffer of %d bytes accepted\n", SBG_ECOM_MAX_BUFFER_SIZE - 1);
+            nrErrors++;
+        }
+
+        if (sbgEComProtocolInitWithRxBuffer(&protocol, &memoryInterface, gRxBufferCheckBuffer, SBG_ECOM_MAX_BUFFER_SIZE) == SBG_NO_ERROR)
+        {
+            sbgEComProtocolClose(&protocol);
+        }
+        else
+        {
+            printf("protocol reception buffer of %d bytes rejected\n", SBG_ECOM_MAX_BUFFER_SIZE);
+            nrErrors++;
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Send a burst of frames and receive them back with a reception buffer.
+ *
+ * The first receive attempt must drain the interface, up to the reception buffer size.
+ *
+ * \param[in]   pRxBuffer               Reception buffer, NULL to have it allocated.
+ * \param[in]   rxBufferSize            Reception buffer size, in bytes.
+ * \param[in]   rxMode                  Receive mode.
+ * \return                              Number of errors.
+ */
+static size_t rxBufferCheckRun(uint8_t *pRxBuffer, size_t rxBufferSize, SbgEComProtocolRxMode rxMode)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    size_t                  totalSize = 0;
+    size_t                  nrFrames = 0;
+    size_t                  nrOffsetFrames = 0;
+    size_t                  nrErrors = 0;
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInitWithRxBuffer(&protocol, &memoryInterface, pRxBuffer, rxBufferSize);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComProtocolSetRxMode(&protocol, rxMode);
+
+            for (size_t i = 0; (i < RX_BUFFER_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                uint8_t         payload[RX_BUFFER_CHECK_MAX_PAYLOAD_SIZE];
+                size_t          size;
+
+                size        = rxBufferCheckGetPayload(i, payload);
+                errorCode   = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(i % 128), payload, size);
+            }
+
+            totalSize = testInterfaceMemoryGetNrPendingBytes(&memoryInterface);
+
+            while ((nrFrames < RX_BUFFER_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR))
+            {
+                SbgEComProtocolPayload  payload;
+                uint8_t                 msgClass;
+                uint8_t                 msgId;
+
+                sbgEComProtocolPayloadConstruct(&payload);
+
+                errorCode = sbgEComProtocolReceive2(&protocol, &msgClass, &msgId, &payload);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    uint8_t             expected[RX_BUFFER_CHECK_MAX_PAYLOAD_SIZE];
+                    const uint8_t      *pBuffer;
+                    size_t              size;
+
+                    size    = rxBufferCheckGetPayload(nrFrames, expected);
+                    pBuffer = sbgEComProtocolPayloadGetBuffer(&payload);
+
+                    if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != (nrFrames % 128)) || (sbgEComProtocolPayloadGetSize(&payload) != size) ||
+                        ((size != 0) && (memcmp(pBuffer, expected, size) != 0)))
+                    {
+                        printf("frame %zu mismatch\n", nrFrames);
+                        nrErrors++;
+                    }
+
+                    //
+                    // In ring mode, frames spanning the wrap point are returned from the wrap buffer
+                    //
+                    if (pRxBuffer && ((pBuffer < pRxBuffer) || (pBuffer > &pRxBuffer[rxBufferSize])) &&
+                        ((pBuffer < protocol.pRxWrapBuffer) || (pBuffer > &protocol.pRxWrapBuffer[SBG_ECOM_MAX_BUFFER_SIZE])))
+                    {
+                        printf("frame %zu not received in the reception buffer\n", nrFrames);
+                        nrErrors++;
+                    }
+
+                    if ((nrFrames == 0) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) != (totalSize - sbgMin(totalSize, rxBufferSize))))
+                    {
+                        printf("%zu bytes left after the first receive attempt, %zu expected\n",
+                               testInterfaceMemoryGetNrPendingBytes(&memoryInterface), totalSize - sbgMin(totalSize, rxBufferSize));
+                        nrErrors++;
+                    }
+
+                    //
+                    // In linear mode, the first valid byte must only move away from the start of the buffer while a whole frame can fit after it
+                    //
+                    if ((rxMode == SBG_ECOM_PROTOCOL_RX_MODE_LINEAR) && (protocol.rxBufferStart != 0))
+                    {
+                        if ((rxBufferSize - protocol.rxBufferStart) < SBG_ECOM_MAX_BUFFER_SIZE)
+                        {
+                            printf("frame %zu received %zu bytes before the end of the buffer\n", nrFrames, rxBufferSize - protocol.rxBufferStart);
+                            nrErrors++;
+                        }
+
+                        nrOffsetFrames++;
+                    }
+
+                    nrFrames++;
+                }
+
+                sbgEComProtocolPayloadDestroy(&payload);
+            }
+
+            sbgEComProtocolClose(&protocol);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (nrFrames != RX_BUFFER_CHECK_NR_FRAMES)
+    {
+        SBG_LOG_ERROR(errorCode, "%zu frames received, %d expected", nrFrames, RX_BUFFER_CHECK_NR_FRAMES);
+        nrErrors++;
+    }
+
+    if ((rxMode == SBG_ECOM_PROTOCOL_RX_MODE_LINEAR) && ((nrOffsetFrames == 0) != (rxBufferSize == SBG_ECOM_MAX_BUFFER_SIZE)))
+    {
+        printf("%zu frames received away from the start of the buffer\n", nrOffsetFrames);
+        nrErrors++;
+    }
+
+    printf("%s buffer of %zu bytes, %s mode: %zu bytes in %zu frames, %zu errors\n", pRxBuffer ? "user" : "allocated", rxBufferSize,
+           (rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING) ? "ring" : "linear", totalSize, nrFrames, nrErrors);
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += rxBufferCheckMinSize();
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        SbgEComProtocolRxMode   rxMode;
+
+        rxMode = (i == 0) ? SBG_ECOM_PROTOCOL_RX_MODE_LINEAR : SBG_ECOM_PROTOCOL_RX_MODE_RING;
+
+        nrErrors += rxBufferCheckRun(gRxBufferCheckBuffer, SBG_ECOM_MAX_BUFFER_SIZE, rxMode);
+        nrErrors += rxBufferCheckRun(gRxBufferCheckBuffer, RX_BUFFER_CHECK_USER_SIZE, rxMode);
+        nrErrors += rxBufferCheckRun(NULL, RX_BUFFER_CHECK_ALLOCATED_SIZE, rxMode);
+    }
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
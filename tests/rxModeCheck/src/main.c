@@ -0,0 +1,414 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the linear and ring receive modes of the protocol.
+ *
+ * Frames of every size, large transfers included, are separated by garbage and read back in
+ * pseudo random chunks, so that frames span the wrap point of the ring buffer at every offset.
+ * Frames must be received identically in both modes, and the frame callback must get whole and
+ * valid frames.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <crc/sbgCrc.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define RX_MODE_CHECK_NR_FRAMES             (3000)          /*!< Number of frames sent in each receive mode. */
+#define RX_MODE_CHECK_MAX_LARGE_SIZE        (12000)         /*!< Maximum payload size of a large transfer, in bytes. */
+#define RX_MODE_CHECK_MAX_GARBAGE_SIZE      (40)            /*!< Maximum number of garbage bytes before a frame. */
+#define RX_MODE_CHECK_MAX_READ_SIZE         (1500)          /*!< Maximum number of bytes read at once. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context.
+ */
+typedef struct _RxModeCheckContext
+{
+    size_t                  nrFrames;                       /*!< Number of frames passed to the frame callback. */
+    size_t                  nrErrors;                       /*!< Number of errors. */
+} RxModeCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Payload buffers, too large for the stack.
+ */
+static uint8_t              gRxModeCheckPayload[RX_MODE_CHECK_MAX_LARGE_SIZE];
+static uint8_t              gRxModeCheckExpected[RX_MODE_CHECK_MAX_LARGE_SIZE];
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t rxModeCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a payload with the bytes expected for a frame.
+ *
+ * Most frames are small, some are close to the maximum frame size and a few are sent as
+ * large transfers, so that frames span the wrap point of the ring buffer at every offset.
+ *
+ * \param[in]   frameIndex              Frame index.
+ * \param[out]  pPayload                Payload.
+ * \return                              Payload size, in bytes.
+ */
+static size_t rxModeCheckGetPayload(size_t frameIndex, uint8_t *pPayload)
+{
+    uint32_t                state;
+    size_t                  size;
+    uint32_t                kind;
+
+    state   = (uint32_t)frameIndex * 2654435761u + 1;
+    kind    = rxModeCheckRandom(&state) % 100;
+
+    if (kind < 50)
+    {
+        size = rxModeCheckRandom(&state) % 65;
+    }
+    else if (kind < 85)
+    {
+        size = rxModeCheckRandom(&state) % 1001;
+    }
+    else if (kind < 97)
+    {
+        size = 3000 + (rxModeCheckRandom(&state) % (SBG_ECOM_MAX_PAYLOAD_SIZE - 3000 + 1));
+    }
+    else
+    {
+        size = SBG_ECOM_MAX_PAYLOAD_SIZE + 1 + (rxModeCheckRandom(&state) % (RX_MODE_CHECK_MAX_LARGE_SIZE - SBG_ECOM_MAX_PAYLOAD_SIZE));
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pPayload[i] = (uint8_t)(rxModeCheckRandom(&state) >> 11);
+    }
+
+    return size;
+}
+
+/*!
+ * Get the number of frames sent on the wire for a payload.
+ *
+ * \param[in]   size                    Payload size, in bytes.
+ * \return                              Number of frames.
+ */
+static size_t rxModeCheckGetNrWireFrames(size_t size)
+{
+    size_t                  nrFrames;
+
+    if (size <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+    {
+        nrFrames = 1;
+    }
+    else
+    {
+        nrFrames = (size + SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE - 1) / SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE;
+    }
+
+    return nrFrames;
+}
+
+/*!
+ * Write garbage bytes that never contain a SYNC sequence.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the garbage has been written.
+ */
+static SbgErrorCode rxModeCheckWriteGarbage(SbgInterface *pInterface, uint32_t *pState)
+{
+    uint8_t                 garbage[RX_MODE_CHECK_MAX_GARBAGE_SIZE];
+    size_t                  size;
+
+    size = rxModeCheckRandom(pState) % (RX_MODE_CHECK_MAX_GARBAGE_SIZE + 1);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        garbage[i] = (uint8_t)(rxModeCheckRandom(pState) % SBG_ECOM_SYNC_1);
+    }
+
+    return sbgInterfaceWrite(pInterface, garbage, size);
+}
+
+/*!
+ * Frame callback, check a whole frame.
+ *
+ * \param[in]   pProtocol               Protocol.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pReceivedFrame          Whole frame.
+ * \param[in]   pUserArg                Check context.
+ */
+static void rxModeCheckOnFrameReceived(SbgEComProtocol *pProtocol, uint8_t msgClass, uint8_t msgId, SbgStreamBuffer *pReceivedFrame, void *pUserArg)
+{
+    RxModeCheckContext     *pContext = pUserArg;
+    const uint8_t          *pFrame;
+    size_t                  size;
+
+    SBG_UNUSED_PARAMETER(pProtocol);
+
+    assert(pContext);
+
+    pFrame  = sbgStreamBufferGetLinkedBuffer(pReceivedFrame);
+    size    = sbgStreamBufferGetSize(pReceivedFrame);
+
+    //
+    // The CRC covers the frame from the message ID to the payload end
+    //
+    if ((size < 9) || (pFrame[0] != SBG_ECOM_SYNC_1) || (pFrame[1] != SBG_ECOM_SYNC_2) || (pFrame[2] != msgId) || ((pFrame[3] & 0x7f) != msgClass) ||
+        (pFrame[size - 1] != SBG_ECOM_ETX) || (sbgCrc16Compute(&pFrame[2], size - 5) != (pFrame[size - 3] | (pFrame[size - 2] << 8))))
+    {
+        printf("frame callback %zu mismatch\n", pContext->nrFrames);
+        pContext->nrErrors++;
+    }
+
+    pContext->nrFrames++;
+}
+
+/*!
+ * Receive the expected frame.
+ *
+ * Frames are alternately received with sbgEComProtocolReceive2() and sbgEComProtocolReceive().
+ *
+ * \param[in]   pProtocol               Protocol.
+ * \param[in]   frameIndex              Frame index.
+ * \param[in]   size                    Expected payload size, in bytes.
+ * \param[out]  pWrapped                Set to true if the frame is returned from the wrap buffer.
+ * \return                              SBG_NO_ERROR if the frame has been received and matches.
+ */
+static SbgErrorCode rxModeCheckReceive(SbgEComProtocol *pProtocol, size_t frameIndex, size_t size, bool *pWrapped)
+{
+    SbgErrorCode            errorCode;
+    uint8_t                 msgClass;
+    uint8_t                 msgId;
+    const uint8_t          *pBuffer;
+    size_t                  receivedSize;
+    SbgEComProtocolPayload  payload;
+
+    assert(pProtocol);
+    assert(pWrapped);
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    if (((frameIndex % 2) == 0) || (size > SBG_ECOM_MAX_PAYLOAD_SIZE))
+    {
+        errorCode       = sbgEComProtocolReceive2(pProtocol, &msgClass, &msgId, &payload);
+        pBuffer         = sbgEComProtocolPayloadGetBuffer(&payload);
+        receivedSize    = sbgEComProtocolPayloadGetSize(&payload);
+
+        *pWrapped = (pProtocol->pRxWrapBuffer != NULL) && (pBuffer >= pProtocol->pRxWrapBuffer) && (pBuffer < &pProtocol->pRxWrapBuffer[SBG_ECOM_MAX_BUFFER_SIZE]);
+    }
+    else
+    {
+        errorCode       = sbgEComProtocolReceive(pProtocol, &msgClass, &msgId, gRxModeCheckPayload, &receivedSize, sizeof(gRxModeCheckPayload));
+        pBuffer         = gRxModeCheckPayload;
+
+        *pWrapped = false;
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != (frameIndex % 128)) || (receivedSize != size) ||
+            ((size != 0) && (memcmp(pBuffer, gRxModeCheckExpected, size) != 0)))
+        {
+            errorCode = SBG_INVALID_FRAME;
+        }
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return errorCode;
+}
+
+/*!
+ * Send frames and receive them back in a receive mode.
+ *
+ * \param[in]   rxMode                  Receive mode.
+ * \return                              Number of errors.
+ */
+static size_t rxModeCheckRun(SbgEComProtocolRxMode rxMode)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    RxModeCheckContext      context;
+    uint32_t                state = 0x2468ace1;
+    size_t                  nrWireFrames = 0;
+    size_t                  nrFrames = 0;
+    size_t                  nrWrappedFrames = 0;
+
+    memset(&context, 0, sizeof(context));
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, RX_MODE_CHECK_MAX_READ_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgEComProtocolSetRxMode(&protocol, rxMode);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgEComProtocolSetOnFrameReceivedCb(&protocol, rxModeCheckOnFrameReceived, &context);
+
+            for (size_t i = 0; (i < RX_MODE_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR); i++)
+            {
+                size_t          size;
+
+                errorCode = rxModeCheckWriteGarbage(&memoryInterface, &state);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    size            = rxModeCheckGetPayload(i, gRxModeCheckPayload);
+                    nrWireFrames    += rxModeCheckGetNrWireFrames(size);
+                    errorCode       = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(i % 128), gRxModeCheckPayload, size);
+                }
+            }
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            while ((nrFrames < RX_MODE_CHECK_NR_FRAMES) && ((errorCode == SBG_NO_ERROR) || (errorCode == SBG_NOT_READY)))
+            {
+                size_t          size;
+                bool            wrapped;
+
+                size        = rxModeCheckGetPayload(nrFrames, gRxModeCheckExpected);
+                errorCode   = rxModeCheckReceive(&protocol, nrFrames, size, &wrapped);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    if (wrapped)
+                    {
+                        nrWrappedFrames++;
+                    }
+
+                    nrFrames++;
+                }
+                else if ((errorCode == SBG_NOT_READY) && (testInterfaceMemoryGetNrPendingBytes(&memoryInterface) == 0))
+                {
+                    errorCode = SBG_TIME_OUT;
+                }
+            }
+
+            if (errorCode != SBG_NO_ERROR)
+            {
+                printf("frame %zu not received\n", nrFrames);
+                context.nrErrors++;
+            }
+        }
+        else
+        {
+            SBG_LOG_ERROR(errorCode, "unable to write frames");
+            context.nrErrors++;
+        }
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+    else
+    {
+        context.nrErrors++;
+    }
+
+    if (context.nrFrames != nrWireFrames)
+    {
+        printf("%zu frames passed to the frame callback, %zu expected\n", context.nrFrames, nrWireFrames);
+        context.nrErrors++;
+    }
+
+    if ((rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING) && (nrWrappedFrames == 0))
+    {
+        printf("no frame spanning the wrap point\n");
+        context.nrErrors++;
+    }
+
+    printf("%s mode: %zu frames received, %zu spanning the wrap point, %zu errors\n",
+           (rxMode == SBG_ECOM_PROTOCOL_RX_MODE_RING) ? "ring" : "linear", nrFrames, nrWrappedFrames, context.nrErrors);
+
+    return context.nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += rxModeCheckRun(SBG_ECOM_PROTOCOL_RX_MODE_LINEAR);
+    nrErrors += rxModeCheckRun(SBG_ECOM_PROTOCOL_RX_MODE_RING);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,268 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the satellite list index lookups against linear searches.
+ *
+ * Satellite lists sharing IDs between constellations are looked up by ID, by constellation and
+ * ID, and iterated by constellation, while satellites are added, once read from a payload, and
+ * once modified directly and the index rebuilt.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SAT_CHECK_NR_ROUNDS                 (100)           /*!< Number of satellite lists checked. */
+#define SAT_CHECK_NR_IDS                    (40)            /*!< Number of satellite IDs used, kept low so that IDs are shared between constellations. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t satCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Find a satellite entry with a linear search.
+ *
+ * \param[in]   pSatList                Satellite list.
+ * \param[in]   anyConstellation        True to ignore the constellation ID.
+ * \param[in]   constellationId         Constellation ID.
+ * \param[in]   id                      Satellite ID.
+ * \return                              First matching satellite entry, NULL if not found.
+ */
+static SbgEComLogSatEntry *satCheckReferenceFind(SbgEComLogSatList *pSatList, bool anyConstellation, SbgEComConstellationId constellationId, uint8_t id)
+{
+    SbgEComLogSatEntry         *pSatData = NULL;
+
+    assert(pSatList);
+
+    for (size_t i = 0; i < pSatList->nrSatellites; i++)
+    {
+        if ((pSatList->satData[i].id == id) && (anyConstellation || (sbgEComLogSatEntryGetConstellationId(&pSatList->satData[i]) == constellationId)))
+        {
+            pSatData = &pSatList->satData[i];
+            break;
+        }
+    }
+
+    return pSatData;
+}
+
+/*!
+ * Check all the lookups of a satellite list against linear searches.
+ *
+ * \param[in]   pSatList                Satellite list.
+ * \param[in]   pName                   List description, for error messages.
+ * \return                              Number of errors.
+ */
+static size_t satCheckLookups(SbgEComLogSatList *pSatList, const char *pName)
+{
+    size_t                      nrErrors = 0;
+
+    assert(pSatList);
+
+    for (size_t id = 0; id <= UINT8_MAX; id++)
+    {
+        if (sbgEComLogSatListGet(pSatList, (uint8_t)id) != satCheckReferenceFind(pSatList, true, SBG_ECOM_CONSTELLATION_ID_UNKNOWN, (uint8_t)id))
+        {
+            printf("%s: get mismatch, %zu satellites, ID %zu\n", pName, pSatList->nrSatellites, id);
+            nrErrors++;
+        }
+    }
+
+    for (size_t constellationId = 0; constellationId < SBG_ECOM_SAT_NR_CONSTELLATION_IDS; constellationId++)
+    {
+        SbgEComLogSatEntry     *pSatData;
+        size_t                  satIndex = 0;
+
+        for (size_t id = 0; id <= SAT_CHECK_NR_IDS; id++)
+        {
+            if (sbgEComLogSatListFind(pSatList, (SbgEComConstellationId)constellationId, (uint8_t)id) != satCheckReferenceFind(pSatList, false, (SbgEComConstellationId)constellationId, (uint8_t)id))
+            {
+                printf("%s: find mismatch, %zu satellites, constellation %zu ID %zu\n", pName, pSatList->nrSatellites, constellationId, id);
+                nrErrors++;
+            }
+        }
+
+        //
+        // Satellites of a constellation are iterated in list order
+        //
+        for (pSatData = sbgEComLogSatListGetFirst(pSatList, (SbgEComConstellationId)constellationId); pSatData; pSatData = sbgEComLogSatListGetNext(pSatList, pSatData))
+        {
+            while ((satIndex < pSatList->nrSatellites) && (sbgEComLogSatEntryGetConstellationId(&pSatList->satData[satIndex]) != constellationId))
+            {
+                satIndex++;
+            }
+
+            if ((satIndex == pSatList->nrSatellites) || (pSatData != &pSatList->satData[satIndex]))
+            {
+                printf("%s: iteration mismatch, %zu satellites, constellation %zu\n", pName, pSatList->nrSatellites, constellationId);
+                nrErrors++;
+                break;
+            }
+
+            satIndex++;
+        }
+
+        if (!pSatData)
+        {
+            while ((satIndex < pSatList->nrSatellites) && (sbgEComLogSatEntryGetConstellationId(&pSatList->satData[satIndex]) != constellationId))
+            {
+                satIndex++;
+            }
+
+            if (satIndex != pSatList->nrSatellites)
+            {
+                printf("%s: iteration ended early, %zu satellites, constellation %zu\n", pName, pSatList->nrSatellites, constellationId);
+                nrErrors++;
+            }
+        }
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static SbgEComLogSatList    satList;
+    static SbgEComLogSatList    readSatList;
+    static uint8_t              payload[SBG_ECOM_MAX_PAYLOAD_SIZE];
+    uint32_t                    state = 0x5a7e1175;
+    size_t                      nrErrors = 0;
+    size_t                      nrChecks = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    for (size_t round = 0; round < SAT_CHECK_NR_ROUNDS; round++)
+    {
+        SbgStreamBuffer         streamBuffer;
+        SbgErrorCode            errorCode;
+        size_t                  nrSatellites;
+
+        //
+        // Index kept up to date while satellites are added
+        //
+        sbgEComLogSatListConstruct(&satList, 0);
+
+        nrErrors += satCheckLookups(&satList, "empty");
+        nrChecks++;
+
+        nrSatellites = satCheckRandom(&state) % (SBG_ECOM_SAT_MAX_NR_SATELLITES + 1);
+
+        for (size_t i = 0; i < nrSatellites; i++)
+        {
+            sbgEComLogSatListAdd(&satList, (uint8_t)(satCheckRandom(&state) % SAT_CHECK_NR_IDS), 0, 0, (SbgEComConstellationId)(satCheckRandom(&state) % SBG_ECOM_SAT_NR_CONSTELLATION_IDS),
+                                 SBG_ECOM_SAT_ELEVATION_STATUS_UNKNOWN, SBG_ECOM_SAT_HEALTH_STATUS_UNKNOWN, SBG_ECOM_SAT_TRACKING_STATUS_UNKNOWN);
+
+            nrErrors += satCheckLookups(&satList, "added");
+            nrChecks++;
+        }
+
+        //
+        // Index built when the list is read
+        //
+        sbgStreamBufferInitForWrite(&streamBuffer, payload, sizeof(payload));
+        errorCode = sbgEComLogSatListWriteToStream(&satList, &streamBuffer);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            sbgStreamBufferInitForRead(&streamBuffer, payload, sbgStreamBufferGetLength(&streamBuffer));
+            errorCode = sbgEComLogSatListReadFromStream(&readSatList, &streamBuffer);
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            nrErrors += satCheckLookups(&readSatList, "read");
+        }
+        else
+        {
+            printf("unable to encode and decode a list of %zu satellites\n", nrSatellites);
+            nrErrors++;
+        }
+
+        nrChecks++;
+
+        //
+        // Index rebuilt once satellite IDs and the number of satellites are modified directly
+        //
+        if (satList.nrSatellites != 0)
+        {
+            for (size_t i = 0; i < satList.nrSatellites; i++)
+            {
+                if ((satCheckRandom(&state) % 4) == 0)
+                {
+                    satList.satData[i].id = (uint8_t)(satCheckRandom(&state) % SAT_CHECK_NR_IDS);
+                }
+            }
+
+            satList.nrSatellites = satCheckRandom(&state) % (satList.nrSatellites + 1);
+
+            sbgEComLogSatListBuildIndex(&satList);
+
+            nrErrors += satCheckLookups(&satList, "rebuilt");
+            nrChecks++;
+        }
+    }
+
+    printf("%zu satellite index checks, %zu errors\n", nrChecks, nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
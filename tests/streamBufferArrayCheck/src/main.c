@@ -0,0 +1,314 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the array readers and writers of stream buffers.
+ *
+ * Random arrays of every supported type are written and read at unaligned offsets with the array
+ * functions and value by value, and both must give the same bytes and values. Reads and writes
+ * past the end must fail and zero the output, and logs decoded with the array readers must be
+ * encoded back to the same bytes.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define ARRAY_CHECK_MAX_VALUES              (64)            /*!< Maximum number of values in an array. */
+#define ARRAY_CHECK_NR_ITERATIONS           (200)           /*!< Number of random arrays checked for each type. */
+#define ARRAY_CHECK_MAX_LOG_SIZE            (256)           /*!< Maximum size of a log payload, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t arrayCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a buffer with pseudo random bytes.
+ *
+ * \param[in]   pState                  Generator state.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ */
+static void arrayCheckFill(uint32_t *pState, void *pBuffer, size_t size)
+{
+    uint8_t                *pBytes = pBuffer;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pBytes[i] = (uint8_t)(arrayCheckRandom(pState) >> 11);
+    }
+}
+
+/*!
+ * Define a check of the array reader and writer of a type.
+ *
+ * Random arrays are written at a random, possibly unaligned, offset both value by value and with
+ * the array writer, and the two streams must be identical. The stream is then read back with the
+ * array reader, which must return the original bit patterns and leave the stream at the same
+ * position as the value by value reader.
+ *
+ * Reading or writing one value too many must fail without moving the stream, the output of a
+ * failed read must be zeroed, and later calls must fail as well.
+ *
+ * \param[in]   name                    Type name, used in the function name and the messages.
+ * \param[in]   type                    C type.
+ * \param[in]   readFunc                Single value reader.
+ * \param[in]   writeFunc               Single value writer.
+ * \param[in]   readArrayFunc           Array reader.
+ * \param[in]   writeArrayFunc          Array writer.
+ */
+#define ARRAY_CHECK_DEFINE(name, type, readFunc, writeFunc, readArrayFunc, writeArrayFunc)                      \
+static size_t arrayCheck##name(uint32_t *pState)                                                                \
+{                                                                                                               \
+    type                    values[ARRAY_CHECK_MAX_VALUES];                                                     \
+    type                    readValues[ARRAY_CHECK_MAX_VALUES];                                                 \
+    uint8_t                 expected[ARRAY_CHECK_MAX_VALUES * sizeof(type) + 4];                                \
+    uint8_t                 buffer[ARRAY_CHECK_MAX_VALUES * sizeof(type) + 4];                                  \
+    SbgStreamBuffer         refStream;                                                                          \
+    SbgStreamBuffer         stream;                                                                             \
+    SbgErrorCode            errorCode;                                                                          \
+    size_t                  nrErrors = 0;                                                                       \
+                                                                                                                \
+    for (size_t iteration = 0; iteration < ARRAY_CHECK_NR_ITERATIONS; iteration++)                              \
+    {                                                                                                           \
+        size_t              nrValues    = arrayCheckRandom(pState) % (ARRAY_CHECK_MAX_VALUES + 1);              \
+        size_t              offset      = arrayCheckRandom(pState) % 4;                                         \
+        size_t              size        = offset + nrValues * sizeof(type);                                     \
+                                                                                                                \
+        arrayCheckFill(pState, values, sizeof(values));                                                         \
+        arrayCheckFill(pState, expected, sizeof(expected));                                                     \
+        memcpy(buffer, expected, sizeof(buffer));                                                               \
+                                                                                                                \
+        sbgStreamBufferInitForWrite(&refStream, expected, size);                                                \
+        sbgStreamBufferInitForWrite(&stream, buffer, size);                                                     \
+        sbgStreamBufferSeek(&refStream, offset, SB_SEEK_SET);                                                   \
+        sbgStreamBufferSeek(&stream, offset, SB_SEEK_SET);                                                      \
+                                                                                                                \
+        for (size_t i = 0; i < nrValues; i++)                                                                   \
+        {                                                                                                       \
+            writeFunc(&refStream, values[i]);                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        errorCode = writeArrayFunc(&stream, values, nrValues);                                                  \
+                                                                                                                \
+        if ((errorCode != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != sbgStreamBufferTell(&refStream)) || \
+            (memcmp(buffer, expected, sizeof(buffer)) != 0))                                                    \
+        {                                                                                                       \
+            printf(#name ": array write of %zu values at offset %zu differs\n", nrValues, offset);              \
+            nrErrors++;                                                                                         \
+        }                                                                                                       \
+                                                                                                                \
+        sbgStreamBufferInitForRead(&stream, buffer, size);                                                      \
+        sbgStreamBufferSeek(&stream, offset, SB_SEEK_SET);                                                      \
+        memset(readValues, 0xaa, sizeof(readValues));                                                           \
+                                                                                                                \
+        errorCode = readArrayFunc(&stream, readValues, nrValues);                                               \
+                                                                                                                \
+        if ((errorCode != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != size) ||                            \
+            (memcmp(readValues, values, nrValues * sizeof(type)) != 0))                                         \
+        {                                                                                                       \
+            printf(#name ": array read of %zu values at offset %zu differs\n", nrValues, offset);               \
+            nrErrors++;                                                                                         \
+        }                                                                                                       \
+                                                                                                                \
+        sbgStreamBufferInitForRead(&refStream, buffer, size);                                                   \
+        sbgStreamBufferSeek(&refStream, offset, SB_SEEK_SET);                                                   \
+                                                                                                                \
+        for (size_t i = 0; i < nrValues; i++)                                                                   \
+        {                                                                                                       \
+            type            value = readFunc(&refStream);                                                       \
+                                                                                                                \
+            if (memcmp(&value, &readValues[i], sizeof(type)) != 0)                                              \
+            {                                                                                                   \
+                printf(#name ": value %zu differs from the single value reader\n", i);                          \
+                nrErrors++;                                                                                     \
+            }                                                                                                   \
+        }                                                                                                       \
+                                                                                                                \
+        if (nrValues > 0)                                                                                       \
+        {                                                                                                       \
+            sbgStreamBufferInitForRead(&stream, buffer, size - 1);                                              \
+            sbgStreamBufferSeek(&stream, offset, SB_SEEK_SET);                                                  \
+            memset(readValues, 0xaa, sizeof(readValues));                                                       \
+                                                                                                                \
+            errorCode = readArrayFunc(&stream, readValues, nrValues);                                           \
+                                                                                                                \
+            for (size_t i = 0; i < nrValues * sizeof(type); i++)                                                \
+            {                                                                                                   \
+                if (((const uint8_t *)readValues)[i] != 0)                                                      \
+                {                                                                                               \
+                    printf(#name ": output of a failed read not zeroed\n");                                     \
+                    nrErrors++;                                                                                 \
+                    break;                                                                                      \
+                }                                                                                               \
+            }                                                                                                   \
+                                                                                                                \
+            if ((errorCode != SBG_BUFFER_OVERFLOW) || (sbgStreamBufferTell(&stream) != offset) ||               \
+                (readArrayFunc(&stream, readValues, 0) != SBG_BUFFER_OVERFLOW))                                 \
+            {                                                                                                   \
+                printf(#name ": read of %zu values past the end not rejected\n", nrValues);                     \
+                nrErrors++;                                                                                     \
+            }                                                                                                   \
+                                                                                                                \
+            sbgStreamBufferInitForWrite(&stream, buffer, size - 1);                                             \
+            sbgStreamBufferSeek(&stream, offset, SB_SEEK_SET);                                                  \
+                                                                                                                \
+            errorCode = writeArrayFunc(&stream, values, nrValues);                                              \
+                                                                                                                \
+            if ((errorCode != SBG_BUFFER_OVERFLOW) || (sbgStreamBufferTell(&stream) != offset) ||               \
+                (writeArrayFunc(&stream, values, 0) != SBG_BUFFER_OVERFLOW))                                    \
+            {                                                                                                   \
+                printf(#name ": write of %zu values past the end not rejected\n", nrValues);                    \
+                nrErrors++;                                                                                     \
+            }                                                                                                   \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    return nrErrors;                                                                                            \
+}
+
+ARRAY_CHECK_DEFINE(Int16,   int16_t,    sbgStreamBufferReadInt16LE,     sbgStreamBufferWriteInt16LE,    sbgStreamBufferReadInt16LEArray,    sbgStreamBufferWriteInt16LEArray)
+ARRAY_CHECK_DEFINE(Uint16,  uint16_t,   sbgStreamBufferReadUint16LE,    sbgStreamBufferWriteUint16LE,   sbgStreamBufferReadUint16LEArray,   sbgStreamBufferWriteUint16LEArray)
+ARRAY_CHECK_DEFINE(Int32,   int32_t,    sbgStreamBufferReadInt32LE,     sbgStreamBufferWriteInt32LE,    sbgStreamBufferReadInt32LEArray,    sbgStreamBufferWriteInt32LEArray)
+ARRAY_CHECK_DEFINE(Uint32,  uint32_t,   sbgStreamBufferReadUint32LE,    sbgStreamBufferWriteUint32LE,   sbgStreamBufferReadUint32LEArray,   sbgStreamBufferWriteUint32LEArray)
+ARRAY_CHECK_DEFINE(Float,   float,      sbgStreamBufferReadFloatLE,     sbgStreamBufferWriteFloatLE,    sbgStreamBufferReadFloatLEArray,    sbgStreamBufferWriteFloatLEArray)
+ARRAY_CHECK_DEFINE(Double,  double,     sbgStreamBufferReadDoubleLE,    sbgStreamBufferWriteDoubleLE,   sbgStreamBufferReadDoubleLEArray,   sbgStreamBufferWriteDoubleLEArray)
+
+/*!
+ * Define a read then write round trip check of a log.
+ *
+ * A random payload is decoded and encoded back, and the encoded bytes must be identical to the
+ * bytes consumed by the decoder.
+ *
+ * \param[in]   name                    Log name, used in the function name and the messages.
+ * \param[in]   type                    Log structure type.
+ * \param[in]   readFunc                Log reader.
+ * \param[in]   writeFunc               Log writer.
+ */
+#define ARRAY_CHECK_DEFINE_LOG(name, type, readFunc, writeFunc)                                                 \
+static size_t arrayCheckLog##name(uint32_t *pState)                                                             \
+{                                                                                                               \
+    uint8_t                 payload[ARRAY_CHECK_MAX_LOG_SIZE];                                                  \
+    uint8_t                 output[ARRAY_CHECK_MAX_LOG_SIZE];                                                   \
+    SbgStreamBuffer         stream;                                                                             \
+    type                    logData;                                                                            \
+    size_t                  size;                                                                               \
+    size_t                  nrErrors = 0;                                                                       \
+                                                                                                                \
+    for (size_t iteration = 0; iteration < ARRAY_CHECK_NR_ITERATIONS; iteration++)                              \
+    {                                                                                                           \
+        arrayCheckFill(pState, payload, sizeof(payload));                                                       \
+        memset(output, 0, sizeof(output));                                                                      \
+                                                                                                                \
+        sbgStreamBufferInitForRead(&stream, payload, sizeof(payload));                                          \
+                                                                                                                \
+        if (readFunc(&logData, &stream) != SBG_NO_ERROR)                                                        \
+        {                                                                                                       \
+            printf(#name ": unable to read the log\n");                                                         \
+            nrErrors++;                                                                                         \
+            continue;                                                                                           \
+        }                                                                                                       \
+                                                                                                                \
+        size = sbgStreamBufferTell(&stream);                                                                    \
+                                                                                                                \
+        sbgStreamBufferInitForWrite(&stream, output, sizeof(output));                                           \
+                                                                                                                \
+        if ((writeFunc(&logData, &stream) != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != size) ||         \
+            (memcmp(output, payload, size) != 0))                                                               \
+        {                                                                                                       \
+            printf(#name ": round trip of a %zu bytes payload differs\n", size);                                \
+            nrErrors++;                                                                                         \
+        }                                                                                                       \
+    }                                                                                                           \
+                                                                                                                \
+    return nrErrors;                                                                                            \
+}
+
+ARRAY_CHECK_DEFINE_LOG(EkfNav,      SbgEComLogEkfNav,       sbgEComLogEkfNavReadFromStream,         sbgEComLogEkfNavWriteToStream)
+ARRAY_CHECK_DEFINE_LOG(EkfQuat,     SbgEComLogEkfQuat,      sbgEComLogEkfQuatReadFromStream,        sbgEComLogEkfQuatWriteToStream)
+ARRAY_CHECK_DEFINE_LOG(ImuLegacy,   SbgEComLogImuLegacy,    sbgEComLogImuLegacyReadFromStream,      sbgEComLogImuLegacyWriteToStream)
+ARRAY_CHECK_DEFINE_LOG(ShipMotion,  SbgEComLogShipMotion,   sbgEComLogShipMotionReadFromStream,     sbgEComLogShipMotionWriteToStream)
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    uint32_t                state = 0x2545f491;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += arrayCheckInt16(&state);
+    nrErrors += arrayCheckUint16(&state);
+    nrErrors += arrayCheckInt32(&state);
+    nrErrors += arrayCheckUint32(&state);
+    nrErrors += arrayCheckFloat(&state);
+    nrErrors += arrayCheckDouble(&state);
+
+    nrErrors += arrayCheckLogEkfNav(&state);
+    nrErrors += arrayCheckLogEkfQuat(&state);
+    nrErrors += arrayCheckLogImuLegacy(&state);
+    nrErrors += arrayCheckLogShipMotion(&state);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,735 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the stream buffer reads and writes against byte by byte references.
+ *
+ * Every integer, float and double type is read and written in little and big endian at every
+ * buffer offset, and compared to values assembled byte by byte. The last read or write of a
+ * buffer must overflow without touching the bytes following the buffer.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define STREAM_CHECK_BUFFER_SIZE            (64)            /*!< Size of the buffer values are read from or written to, in bytes. */
+#define STREAM_CHECK_MAX_OFFSET             (8)             /*!< Number of buffer offsets checked. */
+#define STREAM_CHECK_GUARD_SIZE             (8)             /*!< Number of bytes after the buffer that must never be written. */
+#define STREAM_CHECK_NR_ROUNDS              (64)            /*!< Number of times each case is checked with new random data. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Kind of value read or written.
+ */
+typedef enum _StreamCheckKind
+{
+    STREAM_CHECK_KIND_UNSIGNED,                             /*!< Unsigned integer. */
+    STREAM_CHECK_KIND_SIGNED,                               /*!< Signed integer. */
+    STREAM_CHECK_KIND_REAL,                                 /*!< Float or double, handled as its bit pattern. */
+} StreamCheckKind;
+
+/*!
+ * Value type checked.
+ */
+typedef struct _StreamCheckType
+{
+    size_t                               size;                      /*!< Size, in bytes. */
+    StreamCheckKind                      kind;                      /*!< Kind of value. */
+    bool                                 hasWrite;                  /*!< True if the stream buffer has a write method for this type. */
+} StreamCheckType;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Value types checked.
+ */
+static const StreamCheckType            gStreamCheckTypes[] =
+{
+    {   2,  STREAM_CHECK_KIND_UNSIGNED, true    },
+    {   2,  STREAM_CHECK_KIND_SIGNED,   true    },
+    {   3,  STREAM_CHECK_KIND_UNSIGNED, true    },
+    {   3,  STREAM_CHECK_KIND_SIGNED,   true    },
+    {   4,  STREAM_CHECK_KIND_UNSIGNED, true    },
+    {   4,  STREAM_CHECK_KIND_SIGNED,   true    },
+    {   5,  STREAM_CHECK_KIND_UNSIGNED, false   },
+    {   5,  STREAM_CHECK_KIND_SIGNED,   false   },
+    {   6,  STREAM_CHECK_KIND_UNSIGNED, true    },
+    {   6,  STREAM_CHECK_KIND_SIGNED,   false   },
+    {   7,  STREAM_CHECK_KIND_UNSIGNED, false   },
+    {   7,  STREAM_CHECK_KIND_SIGNED,   false   },
+    {   8,  STREAM_CHECK_KIND_UNSIGNED, true    },
+    {   8,  STREAM_CHECK_KIND_SIGNED,   true    },
+    {   4,  STREAM_CHECK_KIND_REAL,     true    },
+    {   8,  STREAM_CHECK_KIND_REAL,     true    },
+};
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t streamCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Get a pseudo random value of a given size.
+ *
+ * Values are biased toward their minimum and maximum so that sign extensions are exercised.
+ *
+ * \param[in]   pState                  Generator state.
+ * \param[in]   size                    Value size, in bytes.
+ * \return                              Pseudo random value, its unused bits cleared.
+ */
+static uint64_t streamCheckRandomValue(uint32_t *pState, size_t size)
+{
+    uint64_t            value;
+
+    assert(size <= sizeof(uint64_t));
+
+    value = ((uint64_t)streamCheckRandom(pState) << 32) | streamCheckRandom(pState);
+
+    switch (streamCheckRandom(pState) % 4)
+    {
+    case 0:
+        value |= UINT64_C(0xFFFFFFFFFFFFFF00);
+        break;
+    case 1:
+        value &= UINT64_C(0xFF);
+        break;
+    default:
+        break;
+    }
+
+    if (size < sizeof(uint64_t))
+    {
+        value &= (UINT64_C(1) << (size * 8)) - 1;
+    }
+
+    return value;
+}
+
+/*!
+ * Sign extend an integer to 64 bits.
+ *
+ * \param[in]   value                   Integer, its unused bits cleared.
+ * \param[in]   size                    Integer size, in bytes.
+ * \return                              Sign extended integer.
+ */
+static uint64_t streamCheckSignExtend(uint64_t value, size_t size)
+{
+    if ((size < sizeof(uint64_t)) && ((value >> (size * 8 - 1)) & 1))
+    {
+        value |= UINT64_MAX << (size * 8);
+    }
+
+    return value;
+}
+
+/*!
+ * Assemble a value byte by byte.
+ *
+ * \param[in]   pData                   Value bytes.
+ * \param[in]   pType                   Value type.
+ * \param[in]   bigEndian               True if the value is stored in big endian.
+ * \return                              Value, sign extended to 64 bits for signed integers.
+ */
+static uint64_t streamCheckReferenceRead(const uint8_t *pData, const StreamCheckType *pType, bool bigEndian)
+{
+    uint64_t            value = 0;
+
+    assert(pData);
+    assert(pType);
+
+    for (size_t i = 0; i < pType->size; i++)
+    {
+        size_t          byteIndex;
+
+        byteIndex = bigEndian ? i : (pType->size - 1 - i);
+        value = (value << 8) | pData[byteIndex];
+    }
+
+    if (pType->kind == STREAM_CHECK_KIND_SIGNED)
+    {
+        value = streamCheckSignExtend(value, pType->size);
+    }
+
+    return value;
+}
+
+/*!
+ * Store a value byte by byte.
+ *
+ * \param[out]  pData                   Value bytes.
+ * \param[in]   pType                   Value type.
+ * \param[in]   bigEndian               True if the value is stored in big endian.
+ * \param[in]   value                   Value.
+ */
+static void streamCheckReferenceWrite(uint8_t *pData, const StreamCheckType *pType, bool bigEndian, uint64_t value)
+{
+    assert(pData);
+    assert(pType);
+
+    for (size_t i = 0; i < pType->size; i++)
+    {
+        size_t          byteIndex;
+
+        byteIndex = bigEndian ? (pType->size - 1 - i) : i;
+        pData[byteIndex] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+/*!
+ * Read a value in little endian with the stream buffer.
+ *
+ * \param[in]   pStream                 Stream buffer.
+ * \param[in]   pType                   Value type.
+ * \return                              Value, sign extended to 64 bits for signed integers.
+ */
+static uint64_t streamCheckReadLE(SbgStreamBuffer *pStream, const StreamCheckType *pType)
+{
+    uint64_t            value = 0;
+
+    assert(pType);
+
+    if (pType->kind == STREAM_CHECK_KIND_REAL)
+    {
+        if (pType->size == sizeof(float))
+        {
+            float       valueFloat;
+            uint32_t    valueBits;
+
+            valueFloat = sbgStreamBufferReadFloatLE(pStream);
+            memcpy(&valueBits, &valueFloat, sizeof(valueBits));
+            value = valueBits;
+        }
+        else
+        {
+            double      valueDouble;
+
+            valueDouble = sbgStreamBufferReadDoubleLE(pStream);
+            memcpy(&value, &valueDouble, sizeof(value));
+        }
+    }
+    else if (pType->kind == STREAM_CHECK_KIND_SIGNED)
+    {
+        switch (pType->size)
+        {
+        case 2:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt16LE(pStream);
+            break;
+        case 3:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt24LE(pStream);
+            break;
+        case 4:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt32LE(pStream);
+            break;
+        case 5:
+            value = (uint64_t)sbgStreamBufferReadInt40LE(pStream);
+            break;
+        case 6:
+            value = (uint64_t)sbgStreamBufferReadInt48LE(pStream);
+            break;
+        case 7:
+            value = (uint64_t)sbgStreamBufferReadInt56LE(pStream);
+            break;
+        default:
+            value = (uint64_t)sbgStreamBufferReadInt64LE(pStream);
+            break;
+        }
+    }
+    else
+    {
+        switch (pType->size)
+        {
+        case 2:
+            value = sbgStreamBufferReadUint16LE(pStream);
+            break;
+        case 3:
+            value = sbgStreamBufferReadUint24LE(pStream);
+            break;
+        case 4:
+            value = sbgStreamBufferReadUint32LE(pStream);
+            break;
+        case 5:
+            value = sbgStreamBufferReadUint40LE(pStream);
+            break;
+        case 6:
+            value = sbgStreamBufferReadUint48LE(pStream);
+            break;
+        case 7:
+            value = sbgStreamBufferReadUint56LE(pStream);
+            break;
+        default:
+            value = sbgStreamBufferReadUint64LE(pStream);
+            break;
+        }
+    }
+
+    return value;
+}
+
+/*!
+ * Read a value in big endian with the stream buffer.
+ *
+ * \param[in]   pStream                 Stream buffer.
+ * \param[in]   pType                   Value type.
+ * \return                              Value, sign extended to 64 bits for signed integers.
+ */
+static uint64_t streamCheckReadBE(SbgStreamBuffer *pStream, const StreamCheckType *pType)
+{
+    uint64_t            value = 0;
+
+    assert(pType);
+
+    if (pType->kind == STREAM_CHECK_KIND_REAL)
+    {
+        if (pType->size == sizeof(float))
+        {
+            float       valueFloat;
+            uint32_t    valueBits;
+
+            valueFloat = sbgStreamBufferReadFloatBE(pStream);
+            memcpy(&valueBits, &valueFloat, sizeof(valueBits));
+            value = valueBits;
+        }
+        else
+        {
+            double      valueDouble;
+
+            valueDouble = sbgStreamBufferReadDoubleBE(pStream);
+            memcpy(&value, &valueDouble, sizeof(value));
+        }
+    }
+    else if (pType->kind == STREAM_CHECK_KIND_SIGNED)
+    {
+        switch (pType->size)
+        {
+        case 2:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt16BE(pStream);
+            break;
+        case 3:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt24BE(pStream);
+            break;
+        case 4:
+            value = (uint64_t)(int64_t)sbgStreamBufferReadInt32BE(pStream);
+            break;
+        case 5:
+            value = (uint64_t)sbgStreamBufferReadInt40BE(pStream);
+            break;
+        case 6:
+            value = (uint64_t)sbgStreamBufferReadInt48BE(pStream);
+            break;
+        case 7:
+            value = (uint64_t)sbgStreamBufferReadInt56BE(pStream);
+            break;
+        default:
+            value = (uint64_t)sbgStreamBufferReadInt64BE(pStream);
+            break;
+        }
+    }
+    else
+    {
+        switch (pType->size)
+        {
+        case 2:
+            value = sbgStreamBufferReadUint16BE(pStream);
+            break;
+        case 3:
+            value = sbgStreamBufferReadUint24BE(pStream);
+            break;
+        case 4:
+            value = sbgStreamBufferReadUint32BE(pStream);
+            break;
+        case 5:
+            value = sbgStreamBufferReadUint40BE(pStream);
+            break;
+        case 6:
+            value = sbgStreamBufferReadUint48BE(pStream);
+            break;
+        case 7:
+            value = sbgStreamBufferReadUint56BE(pStream);
+            break;
+        default:
+            value = sbgStreamBufferReadUint64BE(pStream);
+            break;
+        }
+    }
+
+    return value;
+}
+
+/*!
+ * Write a value in little endian with the stream buffer.
+ *
+ * \param[in]   pStream                 Stream buffer.
+ * \param[in]   pType                   Value type, it must have a write method.
+ * \param[in]   value                   Value, its unused bits cleared.
+ * \return                              SBG_NO_ERROR if the value has been written.
+ */
+static SbgErrorCode streamCheckWriteLE(SbgStreamBuffer *pStream, const StreamCheckType *pType, uint64_t value)
+{
+    SbgErrorCode        errorCode;
+
+    assert(pType);
+    assert(pType->hasWrite);
+
+    if (pType->kind == STREAM_CHECK_KIND_REAL)
+    {
+        if (pType->size == sizeof(float))
+        {
+            float       valueFloat;
+            uint32_t    valueBits = (uint32_t)value;
+
+            memcpy(&valueFloat, &valueBits, sizeof(valueFloat));
+            errorCode = sbgStreamBufferWriteFloatLE(pStream, valueFloat);
+        }
+        else
+        {
+            double      valueDouble;
+
+            memcpy(&valueDouble, &value, sizeof(valueDouble));
+            errorCode = sbgStreamBufferWriteDoubleLE(pStream, valueDouble);
+        }
+    }
+    else if (pType->kind == STREAM_CHECK_KIND_SIGNED)
+    {
+        switch (pType->size)
+        {
+        case 2:
+            errorCode = sbgStreamBufferWriteInt16LE(pStream, (int16_t)value);
+            break;
+        case 3:
+            errorCode = sbgStreamBufferWriteInt24LE(pStream, (int32_t)streamCheckSignExtend(value, pType->size));
+            break;
+        case 4:
+            errorCode = sbgStreamBufferWriteInt32LE(pStream, (int32_t)value);
+            break;
+        default:
+            errorCode = sbgStreamBufferWriteInt64LE(pStream, (int64_t)value);
+            break;
+        }
+    }
+    else
+    {
+        switch (pType->size)
+        {
+        case 2:
+            errorCode = sbgStreamBufferWriteUint16LE(pStream, (uint16_t)value);
+            break;
+        case 3:
+            errorCode = sbgStreamBufferWriteUint24LE(pStream, (uint32_t)value);
+            break;
+        case 4:
+            errorCode = sbgStreamBufferWriteUint32LE(pStream, (uint32_t)value);
+            break;
+        case 6:
+            errorCode = sbgStreamBufferWriteUint48LE(pStream, value);
+            break;
+        default:
+            errorCode = sbgStreamBufferWriteUint64LE(pStream, value);
+            break;
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Write a value in big endian with the stream buffer.
+ *
+ * \param[in]   pStream                 Stream buffer.
+ * \param[in]   pType                   Value type, it must have a write method.
+ * \param[in]   value                   Value, its unused bits cleared.
+ * \return                              SBG_NO_ERROR if the value has been written.
+ */
+static SbgErrorCode streamCheckWriteBE(SbgStreamBuffer *pStream, const StreamCheckType *pType, uint64_t value)
+{
+    SbgErrorCode        errorCode;
+
+    assert(pType);
+    assert(pType->hasWrite);
+
+    if (pType->kind == STREAM_CHECK_KIND_REAL)
+    {
+        if (pType->size == sizeof(float))
+        {
+            float       valueFloat;
+            uint32_t    valueBits = (uint32_t)value;
+
+            memcpy(&valueFloat, &valueBits, sizeof(valueFloat));
+            errorCode = sbgStreamBufferWriteFloatBE(pStream, valueFloat);
+        }
+        else
+        {
+            double      valueDouble;
+
+            memcpy(&valueDouble, &value, sizeof(valueDouble));
+            errorCode = sbgStreamBufferWriteDoubleBE(pStream, valueDouble);
+        }
+    }
+    else if (pType->kind == STREAM_CHECK_KIND_SIGNED)
+    {
+        switch (pType->size)
+        {
+        case 2:
+            errorCode = sbgStreamBufferWriteInt16BE(pStream, (int16_t)value);
+            break;
+        case 3:
+            errorCode = sbgStreamBufferWriteInt24BE(pStream, (int32_t)streamCheckSignExtend(value, pType->size));
+            break;
+        case 4:
+            errorCode = sbgStreamBufferWriteInt32BE(pStream, (int32_t)value);
+            break;
+        default:
+            errorCode = sbgStreamBufferWriteInt64BE(pStream, (int64_t)value);
+            break;
+        }
+    }
+    else
+    {
+        switch (pType->size)
+        {
+        case 2:
+            errorCode = sbgStreamBufferWriteUint16BE(pStream, (uint16_t)value);
+            break;
+        case 3:
+            errorCode = sbgStreamBufferWriteUint24BE(pStream, (uint32_t)value);
+            break;
+        case 4:
+            errorCode = sbgStreamBufferWriteUint32BE(pStream, (uint32_t)value);
+            break;
+        case 6:
+            errorCode = sbgStreamBufferWriteUint48BE(pStream, value);
+            break;
+        default:
+            errorCode = sbgStreamBufferWriteUint64BE(pStream, value);
+            break;
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Check the reads of a value type at a buffer offset.
+ *
+ * Values are read one after the other until the end of the buffer, the last read must overflow.
+ *
+ * \param[in]   pType                   Value type.
+ * \param[in]   bigEndian               True to check big endian reads.
+ * \param[in]   pBuffer                 Buffer values are read from.
+ * \param[in]   size                    Buffer size, in bytes.
+ * \return                              Number of errors.
+ */
+static size_t streamCheckReads(const StreamCheckType *pType, bool bigEndian, const uint8_t *pBuffer, size_t size)
+{
+    SbgStreamBuffer     stream;
+    size_t              nrErrors = 0;
+    size_t              nrValues;
+    uint64_t            value;
+
+    assert(pType);
+    assert(pBuffer);
+
+    nrValues = size / pType->size;
+
+    sbgStreamBufferInitForRead(&stream, pBuffer, size);
+
+    for (size_t i = 0; i < nrValues; i++)
+    {
+        value = bigEndian ? streamCheckReadBE(&stream, pType) : streamCheckReadLE(&stream, pType);
+
+        if ((value != streamCheckReferenceRead(&pBuffer[i * pType->size], pType, bigEndian)) || (sbgStreamBufferGetLastError(&stream) != SBG_NO_ERROR))
+        {
+            nrErrors++;
+        }
+    }
+
+    value = bigEndian ? streamCheckReadBE(&stream, pType) : streamCheckReadLE(&stream, pType);
+
+    if ((value != 0) || (sbgStreamBufferGetLastError(&stream) != SBG_BUFFER_OVERFLOW))
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the writes of a value type at a buffer offset.
+ *
+ * Values are written one after the other until the end of the buffer, the last write must overflow
+ * and the bytes following the buffer must be left untouched.
+ *
+ * \param[in]   pType                   Value type.
+ * \param[in]   bigEndian               True to check big endian writes.
+ * \param[in]   pState                  Generator state.
+ * \param[out]  pBuffer                 Buffer values are written to, followed by STREAM_CHECK_GUARD_SIZE bytes.
+ * \param[in]   size                    Buffer size, in bytes.
+ * \return                              Number of errors.
+ */
+static size_t streamCheckWrites(const StreamCheckType *pType, bool bigEndian, uint32_t *pState, uint8_t *pBuffer, size_t size)
+{
+    uint8_t             reference[STREAM_CHECK_BUFFER_SIZE + STREAM_CHECK_GUARD_SIZE];
+    SbgStreamBuffer     stream;
+    SbgErrorCode        errorCode;
+    size_t              nrErrors = 0;
+    size_t              nrValues;
+    uint64_t            value;
+
+    assert(pType);
+    assert(pBuffer);
+    assert(size <= STREAM_CHECK_BUFFER_SIZE);
+
+    nrValues = size / pType->size;
+
+    memset(pBuffer, 0x5A, size + STREAM_CHECK_GUARD_SIZE);
+    memset(reference, 0x5A, sizeof(reference));
+
+    sbgStreamBufferInitForWrite(&stream, pBuffer, size);
+
+    for (size_t i = 0; i < nrValues; i++)
+    {
+        value = streamCheckRandomValue(pState, pType->size);
+
+        streamCheckReferenceWrite(&reference[i * pType->size], pType, bigEndian, value);
+        errorCode = bigEndian ? streamCheckWriteBE(&stream, pType, value) : streamCheckWriteLE(&stream, pType, value);
+
+        if (errorCode != SBG_NO_ERROR)
+        {
+            nrErrors++;
+        }
+    }
+
+    errorCode = bigEndian ? streamCheckWriteBE(&stream, pType, 0) : streamCheckWriteLE(&stream, pType, 0);
+
+    if ((errorCode != SBG_BUFFER_OVERFLOW) || (sbgStreamBufferGetLength(&stream) != (nrValues * pType->size)))
+    {
+        nrErrors++;
+    }
+
+    if (memcmp(pBuffer, reference, size + STREAM_CHECK_GUARD_SIZE) != 0)
+    {
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static uint8_t      buffer[STREAM_CHECK_MAX_OFFSET + STREAM_CHECK_BUFFER_SIZE + STREAM_CHECK_GUARD_SIZE];
+    uint32_t            state = 0x12345678;
+    size_t              nrErrors = 0;
+    size_t              nrChecks = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    for (size_t round = 0; round < STREAM_CHECK_NR_ROUNDS; round++)
+    {
+        for (size_t offset = 0; offset < STREAM_CHECK_MAX_OFFSET; offset++)
+        {
+            for (size_t typeIndex = 0; typeIndex < SBG_ARRAY_SIZE(gStreamCheckTypes); typeIndex++)
+            {
+                const StreamCheckType          *pType = &gStreamCheckTypes[typeIndex];
+
+                for (size_t endianness = 0; endianness < 2; endianness++)
+                {
+                    bool                        bigEndian = (endianness != 0);
+                    size_t                      size;
+                    size_t                      nrNewErrors;
+
+                    //
+                    // The buffer size isn't always a multiple of the value size so that the last read or write overflows
+                    //
+                    size = STREAM_CHECK_BUFFER_SIZE - (streamCheckRandom(&state) % pType->size);
+
+                    for (size_t i = 0; i < sizeof(buffer); i++)
+                    {
+                        buffer[i] = (uint8_t)streamCheckRandom(&state);
+                    }
+
+                    nrNewErrors = streamCheckReads(pType, bigEndian, &buffer[offset], size);
+
+                    if (pType->hasWrite)
+                    {
+                        nrNewErrors += streamCheckWrites(pType, bigEndian, &state, &buffer[offset], size);
+                        nrChecks++;
+                    }
+
+                    if (nrNewErrors != 0)
+                    {
+                        printf("%zu errors, %s %zu-byte %s value at offset %zu\n", nrNewErrors, bigEndian ? "BE" : "LE", pType->size,
+                               (pType->kind == STREAM_CHECK_KIND_REAL) ? "real" : ((pType->kind == STREAM_CHECK_KIND_SIGNED) ? "signed" : "unsigned"), offset);
+                    }
+
+                    nrErrors += nrNewErrors;
+                    nrChecks++;
+                }
+            }
+        }
+    }
+
+    printf("%zu stream buffer checks, %zu errors\n", nrChecks, nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,429 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check log subscriptions.
+ *
+ * Random logs are received by a handle with all logs subscribed, a few logs subscribed, and a log
+ * unsubscribed for all classes at once. Only subscribed logs must reach the log callback, and the
+ * others must be counted as dropped without being decoded, including logs received while waiting
+ * for a command.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SUBSCRIPTION_CHECK_NR_LOGS          (2000)          /*!< Number of logs sent. */
+#define SUBSCRIPTION_CHECK_CUSTOM_CLASS     (0x20)          /*!< Proprietary message class, out of the subscription bitmap. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Log sent by the check.
+ */
+typedef struct _SubscriptionCheckLog
+{
+    SbgEComClass            msgClass;                       /*!< Message class. */
+    SbgEComMsgId            msgId;                          /*!< Message ID. */
+} SubscriptionCheckLog;
+
+/*!
+ * Logs received by a handle.
+ */
+typedef struct _SubscriptionCheckReception
+{
+    size_t                  nrLogs[SBG_ECOM_SUBSCRIPTION_NR_CLASSES][256];  /*!< Number of logs received per class and ID. */
+    size_t                  nrCustomLogs;                                   /*!< Number of proprietary logs received. */
+} SubscriptionCheckReception;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Logs sent by the check.
+ */
+static const SubscriptionCheckLog   gSubscriptionCheckLogs[] =
+{
+    { SBG_ECOM_CLASS_LOG_ECOM_0,    SBG_ECOM_LOG_UTC_TIME },
+    { SBG_ECOM_CLASS_LOG_ECOM_0,    SBG_ECOM_LOG_STATUS },
+    { SBG_ECOM_CLASS_LOG_ECOM_0,    SBG_ECOM_LOG_EKF_EULER },
+    { SBG_ECOM_CLASS_LOG_ECOM_0,    SBG_ECOM_LOG_IMU_DATA },
+    { SBG_ECOM_CLASS_LOG_ECOM_1,    SBG_ECOM_LOG_FAST_IMU_DATA },
+};
+
+/*!
+ * Number of calls to the counting decoder.
+ */
+static size_t               gSubscriptionCheckNrDecodes;
+
+/*!
+ * Reception, too large for the stack.
+ */
+static SubscriptionCheckReception   gSubscriptionCheckReception;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t subscriptionCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Decoder counting its calls.
+ *
+ * \param[out]  pLogData                Log data.
+ * \param[in]   pStreamBuffer           Input stream buffer.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode subscriptionCheckDecode(void *pLogData, SbgStreamBuffer *pStreamBuffer)
+{
+    SBG_UNUSED_PARAMETER(pLogData);
+    SBG_UNUSED_PARAMETER(pStreamBuffer);
+
+    gSubscriptionCheckNrDecodes++;
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Log callback.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pLogData                Log data.
+ * \param[in]   pUserArg                Reception.
+ * \return                              SBG_NO_ERROR.
+ */
+static SbgErrorCode subscriptionCheckOnLogReceived(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId, const SbgEComLogUnion *pLogData, void *pUserArg)
+{
+    SubscriptionCheckReception *pReception = pUserArg;
+
+    SBG_UNUSED_PARAMETER(pHandle);
+    SBG_UNUSED_PARAMETER(pLogData);
+
+    assert(pReception);
+
+    if ((size_t)msgClass < SBG_ECOM_SUBSCRIPTION_NR_CLASSES)
+    {
+        pReception->nrLogs[msgClass][msgId]++;
+    }
+    else
+    {
+        pReception->nrCustomLogs++;
+    }
+
+    return SBG_NO_ERROR;
+}
+
+/*!
+ * Send a log with a zero payload of its minimum size.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ */
+static void subscriptionCheckSend(SbgEComHandle *pHandle, SbgEComClass msgClass, SbgEComMsgId msgId)
+{
+    static const uint8_t    payload[256];
+    const SbgEComLogDecoder *pDecoder;
+    size_t                  size;
+
+    assert(pHandle);
+
+    pDecoder    = sbgEComLogGetDecoder(msgClass, msgId);
+    size        = pDecoder ? sbgMax(pDecoder->minSize, 1) : 4;
+
+    assert(size <= sizeof(payload));
+
+    sbgEComProtocolSend(&pHandle->protocolHandle, msgClass, msgId, payload, size);
+}
+
+/*!
+ * Send random logs and check the logs received and dropped.
+ *
+ * \param[in]   pHandle                 Handle.
+ * \param[in]   pState                  Generator state.
+ * \param[in]   pStep                   Step name.
+ * \return                              Number of errors.
+ */
+static size_t subscriptionCheckStream(SbgEComHandle *pHandle, uint32_t *pState, const char *pStep)
+{
+    SubscriptionCheckReception *pReception = &gSubscriptionCheckReception;
+    size_t                  nrSent[SBG_ARRAY_SIZE(gSubscriptionCheckLogs)] = { 0 };
+    size_t                  nrDroppedLogs = 0;
+    size_t                  nrErrors = 0;
+
+    assert(pHandle);
+
+    memset(pReception, 0, sizeof(*pReception));
+    sbgEComResetNrDroppedLogs(pHandle);
+
+    for (size_t i = 0; i < SUBSCRIPTION_CHECK_NR_LOGS; i++)
+    {
+        size_t              index;
+
+        index = subscriptionCheckRandom(pState) % SBG_ARRAY_SIZE(gSubscriptionCheckLogs);
+
+        subscriptionCheckSend(pHandle, gSubscriptionCheckLogs[index].msgClass, gSubscriptionCheckLogs[index].msgId);
+        nrSent[index]++;
+
+        if ((subscriptionCheckRandom(pState) % 16) == 0)
+        {
+            sbgEComHandle(pHandle);
+        }
+    }
+
+    sbgEComHandle(pHandle);
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(gSubscriptionCheckLogs); i++)
+    {
+        const SubscriptionCheckLog *pLog = &gSubscriptionCheckLogs[i];
+        size_t              expectedNrLogs;
+
+        if (sbgEComIsLogSubscribed(pHandle, pLog->msgClass, pLog->msgId))
+        {
+            expectedNrLogs = nrSent[i];
+        }
+        else
+        {
+            expectedNrLogs  = 0;
+            nrDroppedLogs   += nrSent[i];
+        }
+
+        if (pReception->nrLogs[pLog->msgClass][pLog->msgId] != expectedNrLogs)
+        {
+            printf("%s: %zu logs %#x:%#x received instead of %zu\n", pStep, pReception->nrLogs[pLog->msgClass][pLog->msgId], pLog->msgClass, pLog->msgId, expectedNrLogs);
+            nrErrors++;
+        }
+    }
+
+    if (sbgEComGetNrDroppedLogs(pHandle) != nrDroppedLogs)
+    {
+        printf("%s: %" PRIu32 " logs dropped instead of %zu\n", pStep, sbgEComGetNrDroppedLogs(pHandle), nrDroppedLogs);
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode            errorCode;
+    SbgInterface            memoryInterface;
+    SbgEComHandle           handle;
+    uint32_t                state = 0x1b873593;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComInit(&handle, &memoryInterface);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComLogDecoder       decoder;
+            SubscriptionCheckReception *pReception = &gSubscriptionCheckReception;
+
+            sbgEComSetReceiveLogCallback(&handle, subscriptionCheckOnLogReceived, pReception);
+
+            //
+            // All logs are subscribed by default.
+            //
+            for (size_t msgClass = 0; msgClass < SBG_ECOM_SUBSCRIPTION_NR_CLASSES; msgClass++)
+            {
+                for (size_t msgId = 0; msgId < 256; msgId++)
+                {
+                    if (!sbgEComIsLogSubscribed(&handle, (SbgEComClass)msgClass, (SbgEComMsgId)msgId))
+                    {
+                        printf("default: log %#zx:%#zx not subscribed\n", msgClass, msgId);
+                        nrErrors++;
+                    }
+                }
+            }
+
+            nrErrors += subscriptionCheckStream(&handle, &state, "default");
+
+            //
+            // Only a few logs subscribed.
+            //
+            sbgEComUnsubscribeAllLogs(&handle);
+            sbgEComSubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+            sbgEComSubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_FAST_IMU_DATA);
+
+            if (sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS) ||
+                !sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME) ||
+                !sbgEComIsLogSubscribed(&handle, SUBSCRIPTION_CHECK_CUSTOM_CLASS, 0))
+            {
+                printf("subscribed: unexpected subscriptions\n");
+                nrErrors++;
+            }
+
+            nrErrors += subscriptionCheckStream(&handle, &state, "subscribed");
+
+            //
+            // Class wildcard.
+            //
+            sbgEComSubscribeAllLogs(&handle);
+            sbgEComUnsubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ALL, SBG_ECOM_LOG_STATUS);
+
+            if (sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS) ||
+                sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_STATUS) ||
+                !sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME))
+            {
+                printf("wildcard: unexpected subscriptions\n");
+                nrErrors++;
+            }
+
+            nrErrors += subscriptionCheckStream(&handle, &state, "wildcard");
+
+            sbgEComSubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ALL, SBG_ECOM_LOG_STATUS);
+
+            if (!sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS) ||
+                !sbgEComIsLogSubscribed(&handle, SBG_ECOM_CLASS_LOG_ECOM_1, SBG_ECOM_LOG_STATUS))
+            {
+                printf("wildcard: log not subscribed again\n");
+                nrErrors++;
+            }
+
+            //
+            // Unsubscribed logs are never decoded.
+            //
+            decoder.pDecodeFunc = subscriptionCheckDecode;
+            decoder.minSize     = 1;
+            decoder.maxSize     = SBG_ECOM_LOG_DECODER_NO_MAX_SIZE;
+            decoder.dataSize    = 1;
+
+            sbgEComLogRegisterDecoder(SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, &decoder);
+            sbgEComUnsubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER);
+
+            nrErrors += subscriptionCheckStream(&handle, &state, "decoding");
+
+            if (gSubscriptionCheckNrDecodes != 0)
+            {
+                printf("decoding: %zu unsubscribed logs decoded\n", gSubscriptionCheckNrDecodes);
+                nrErrors++;
+            }
+
+            sbgEComSubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER);
+            subscriptionCheckSend(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER);
+            sbgEComHandle(&handle);
+
+            if (gSubscriptionCheckNrDecodes != 1)
+            {
+                printf("decoding: subscribed log not decoded\n");
+                nrErrors++;
+            }
+
+            sbgEComLogResetDecoders();
+
+            //
+            // Logs received while waiting for a command are filtered too.
+            //
+            memset(pReception, 0, sizeof(*pReception));
+            sbgEComResetNrDroppedLogs(&handle);
+            sbgEComUnsubscribeLog(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS);
+
+            subscriptionCheckSend(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_STATUS);
+            subscriptionCheckSend(&handle, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_UTC_TIME);
+            sbgEComProtocolSend(&handle.protocolHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO, NULL, 0);
+
+            {
+                SbgEComProtocolPayload  payload;
+
+                sbgEComProtocolPayloadConstruct(&payload);
+
+                errorCode = sbgEComReceiveCmd2(&handle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO, &payload, 100);
+
+                sbgEComProtocolPayloadDestroy(&payload);
+            }
+
+            if ((errorCode != SBG_NO_ERROR) || (pReception->nrLogs[SBG_ECOM_CLASS_LOG_ECOM_0][SBG_ECOM_LOG_UTC_TIME] != 1) ||
+                (pReception->nrLogs[SBG_ECOM_CLASS_LOG_ECOM_0][SBG_ECOM_LOG_STATUS] != 0) || (sbgEComGetNrDroppedLogs(&handle) != 1))
+            {
+                printf("command: logs not filtered\n");
+                nrErrors++;
+            }
+
+            sbgEComClose(&handle);
+        }
+
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to run the check");
+        nrErrors++;
+    }
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
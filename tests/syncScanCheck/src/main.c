@@ -0,0 +1,245 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the SYNC bytes scan of the protocol.
+ *
+ * Frames are separated by garbage full of SYNC bytes that never form a SYNC sequence, and
+ * read back in pseudo random chunks so that the SYNC bytes are found at every position of
+ * the reception buffer. Every frame must be received, in order and without any error.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define SYNC_CHECK_NR_FRAMES                (20000)         /*!< Number of frames sent. */
+#define SYNC_CHECK_MAX_GARBAGE_SIZE         (80)            /*!< Maximum number of garbage bytes before a frame. */
+#define SYNC_CHECK_MAX_PAYLOAD_SIZE         (100)           /*!< Maximum payload size, in bytes. */
+#define SYNC_CHECK_MAX_READ_SIZE            (300)           /*!< Maximum number of bytes read at once. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t syncCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a payload with the bytes expected for a frame.
+ *
+ * \param[in]   frameIndex              Frame index.
+ * \param[out]  pPayload                Payload.
+ * \return                              Payload size, in bytes.
+ */
+static size_t syncCheckGetPayload(size_t frameIndex, uint8_t *pPayload)
+{
+    size_t                  size;
+
+    size = (frameIndex * 7) % (SYNC_CHECK_MAX_PAYLOAD_SIZE + 1);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pPayload[i] = (uint8_t)(frameIndex + i);
+    }
+
+    return size;
+}
+
+/*!
+ * Write garbage bytes, mostly SYNC bytes, that never contain a SYNC sequence.
+ *
+ * The garbage never ends with the first SYNC byte, which would form a SYNC sequence with the
+ * first SYNC byte of the next frame followed by the second one.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[in]   pState                  Generator state.
+ * \return                              SBG_NO_ERROR if the garbage has been written.
+ */
+static SbgErrorCode syncCheckWriteGarbage(SbgInterface *pInterface, uint32_t *pState)
+{
+    uint8_t                 garbage[SYNC_CHECK_MAX_GARBAGE_SIZE];
+    size_t                  size;
+
+    size = syncCheckRandom(pState) % (SYNC_CHECK_MAX_GARBAGE_SIZE + 1);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        uint32_t            value;
+
+        value = syncCheckRandom(pState);
+
+        if ((value % 4) == 0)
+        {
+            garbage[i] = (uint8_t)(value >> 8);
+        }
+        else if ((value % 4) == 1)
+        {
+            garbage[i] = SBG_ECOM_SYNC_1;
+        }
+        else
+        {
+            garbage[i] = SBG_ECOM_SYNC_2;
+        }
+
+        if ((i != 0) && (garbage[i - 1] == SBG_ECOM_SYNC_1) && (garbage[i] == SBG_ECOM_SYNC_2))
+        {
+            garbage[i] = SBG_ECOM_SYNC_1;
+        }
+    }
+
+    if ((size != 0) && (garbage[size - 1] == SBG_ECOM_SYNC_1))
+    {
+        garbage[size - 1] = 0;
+    }
+
+    return sbgInterfaceWrite(pInterface, garbage, size);
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgErrorCode                errorCode;
+    SbgInterface                memoryInterface;
+    SbgEComProtocol             protocol;
+    uint32_t                    state = 0xdeadbeef;
+    size_t                      nrFrames = 0;
+    size_t                      nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, SYNC_CHECK_MAX_READ_SIZE);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        for (size_t i = 0; (i < SYNC_CHECK_NR_FRAMES) && (errorCode == SBG_NO_ERROR); i++)
+        {
+            uint8_t             payload[SYNC_CHECK_MAX_PAYLOAD_SIZE];
+            size_t              size;
+
+            errorCode = syncCheckWriteGarbage(&memoryInterface, &state);
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                size        = syncCheckGetPayload(i, payload);
+                errorCode   = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, (uint8_t)(i % 128), payload, size);
+            }
+        }
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            SbgEComProtocolPayload      payload;
+
+            sbgEComProtocolPayloadConstruct(&payload);
+
+            while ((testInterfaceMemoryGetNrPendingBytes(&memoryInterface) != 0) || (errorCode == SBG_NO_ERROR))
+            {
+                uint8_t                 msgClass;
+                uint8_t                 msgId;
+
+                errorCode = sbgEComProtocolReceive2(&protocol, &msgClass, &msgId, &payload);
+
+                if (errorCode == SBG_NO_ERROR)
+                {
+                    uint8_t             expected[SYNC_CHECK_MAX_PAYLOAD_SIZE];
+                    size_t              size;
+
+                    size = syncCheckGetPayload(nrFrames, expected);
+
+                    if ((msgClass != SBG_ECOM_CLASS_LOG_ECOM_0) || (msgId != (nrFrames % 128)) || (sbgEComProtocolPayloadGetSize(&payload) != size) ||
+                        ((size != 0) && (memcmp(sbgEComProtocolPayloadGetBuffer(&payload), expected, size) != 0)))
+                    {
+                        printf("frame %zu mismatch\n", nrFrames);
+                        nrErrors++;
+                    }
+
+                    nrFrames++;
+                }
+            }
+
+            sbgEComProtocolPayloadDestroy(&payload);
+        }
+        else
+        {
+            SBG_LOG_ERROR(errorCode, "unable to write frames");
+            nrErrors++;
+        }
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+    else
+    {
+        nrErrors++;
+    }
+
+    if (nrFrames != SYNC_CHECK_NR_FRAMES)
+    {
+        printf("%zu frames received, %d expected\n", nrFrames, SYNC_CHECK_NR_FRAMES);
+        nrErrors++;
+    }
+
+    printf("%zu frames received through SYNC bytes garbage, %zu errors\n", nrFrames, nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,362 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check the reserved span and unchecked stream buffer readers.
+ *
+ * The unchecked readers must return the same values as the checked ones once a span is reserved,
+ * and the fixed layout log decoders built on them must accept payloads of the exact size, reject
+ * truncated payloads and streams already in error, and round trip with their encoders.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define UNCHECKED_CHECK_NR_ITERATIONS       (500)           /*!< Number of random buffers checked. */
+#define UNCHECKED_CHECK_BUFFER_SIZE         (128)           /*!< Size of the random buffers, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Get a pseudo random 32-bit value.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Pseudo random value.
+ */
+static uint32_t uncheckedCheckRandom(uint32_t *pState)
+{
+    assert(pState);
+
+    *pState ^= *pState << 13;
+    *pState ^= *pState >> 17;
+    *pState ^= *pState << 5;
+
+    return *pState;
+}
+
+/*!
+ * Fill a buffer with pseudo random bytes.
+ *
+ * \param[in]   pState                  Generator state.
+ * \param[out]  pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ */
+static void uncheckedCheckFill(uint32_t *pState, void *pBuffer, size_t size)
+{
+    uint8_t                *pBytes = pBuffer;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        pBytes[i] = (uint8_t)(uncheckedCheckRandom(pState) >> 11);
+    }
+}
+
+/*!
+ * Check the span reservation.
+ *
+ * A reservation within the buffer must succeed without moving the cursor, a reservation past the
+ * end must set the buffer overflow error, and once an error is set every reservation must fail.
+ *
+ * \return                              Number of errors.
+ */
+static size_t uncheckedCheckReserve(void)
+{
+    uint8_t                 buffer[16] = { 0 };
+    SbgStreamBuffer         stream;
+    size_t                  nrErrors = 0;
+
+    sbgStreamBufferInitForRead(&stream, buffer, sizeof(buffer));
+    sbgStreamBufferSeek(&stream, 3, SB_SEEK_SET);
+
+    if ((sbgStreamBufferReserve(&stream, 0) != SBG_NO_ERROR) || (sbgStreamBufferReserve(&stream, sizeof(buffer) - 3) != SBG_NO_ERROR) ||
+        (sbgStreamBufferTell(&stream) != 3))
+    {
+        printf("reservation within the buffer rejected or cursor moved\n");
+        nrErrors++;
+    }
+
+    if ((sbgStreamBufferReserve(&stream, sizeof(buffer) - 2) != SBG_BUFFER_OVERFLOW) || (sbgStreamBufferTell(&stream) != 3) ||
+        (sbgStreamBufferGetLastError(&stream) != SBG_BUFFER_OVERFLOW))
+    {
+        printf("reservation past the end not rejected\n");
+        nrErrors++;
+    }
+
+    if (sbgStreamBufferReserve(&stream, 0) != SBG_BUFFER_OVERFLOW)
+    {
+        printf("reservation accepted after an error\n");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check the unchecked readers against the checked ones.
+ *
+ * The same random bytes are read at an unaligned offset with both sets of readers, and the values
+ * and the cursor positions must be identical.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Number of errors.
+ */
+static size_t uncheckedCheckReaders(uint32_t *pState)
+{
+    uint8_t                 buffer[UNCHECKED_CHECK_BUFFER_SIZE];
+    SbgStreamBuffer         checked;
+    SbgStreamBuffer         unchecked;
+    size_t                  nrErrors = 0;
+
+    for (size_t iteration = 0; iteration < UNCHECKED_CHECK_NR_ITERATIONS; iteration++)
+    {
+        size_t              offset = uncheckedCheckRandom(pState) % 8;
+        uint8_t             u8[2];
+        uint16_t            u16[2];
+        int16_t             i16[2];
+        uint32_t            u32[2];
+        int32_t             i32[2];
+        uint64_t            u64[2];
+        int64_t             i64[2];
+        float               f[2];
+        double              d[2];
+        float               fArray[2][3];
+        int32_t             i32Array[2][4];
+        double              dArray[2][2];
+
+        uncheckedCheckFill(pState, buffer, sizeof(buffer));
+
+        sbgStreamBufferInitForRead(&checked, buffer, sizeof(buffer));
+        sbgStreamBufferInitForRead(&unchecked, buffer, sizeof(buffer));
+        sbgStreamBufferSeek(&checked, offset, SB_SEEK_SET);
+        sbgStreamBufferSeek(&unchecked, offset, SB_SEEK_SET);
+
+        u8[0]   = sbgStreamBufferReadUint8(&checked);
+        u16[0]  = sbgStreamBufferReadUint16LE(&checked);
+        i16[0]  = sbgStreamBufferReadInt16LE(&checked);
+        u32[0]  = sbgStreamBufferReadUint32LE(&checked);
+        i32[0]  = sbgStreamBufferReadInt32LE(&checked);
+        u64[0]  = sbgStreamBufferReadUint64LE(&checked);
+        i64[0]  = sbgStreamBufferReadInt64LE(&checked);
+        f[0]    = sbgStreamBufferReadFloatLE(&checked);
+        d[0]    = sbgStreamBufferReadDoubleLE(&checked);
+        sbgStreamBufferReadFloatLEArray(&checked, fArray[0], 3);
+        sbgStreamBufferReadInt32LEArray(&checked, i32Array[0], 4);
+        sbgStreamBufferReadDoubleLEArray(&checked, dArray[0], 2);
+
+        if (sbgStreamBufferReserve(&unchecked, sbgStreamBufferTell(&checked) - offset) != SBG_NO_ERROR)
+        {
+            printf("unable to reserve %zu bytes\n", sbgStreamBufferTell(&checked) - offset);
+            nrErrors++;
+            continue;
+        }
+
+        u8[1]   = sbgStreamBufferReadUint8Unchecked(&unchecked);
+        u16[1]  = sbgStreamBufferReadUint16LEUnchecked(&unchecked);
+        i16[1]  = sbgStreamBufferReadInt16LEUnchecked(&unchecked);
+        u32[1]  = sbgStreamBufferReadUint32LEUnchecked(&unchecked);
+        i32[1]  = sbgStreamBufferReadInt32LEUnchecked(&unchecked);
+        u64[1]  = sbgStreamBufferReadUint64LEUnchecked(&unchecked);
+        i64[1]  = sbgStreamBufferReadInt64LEUnchecked(&unchecked);
+        f[1]    = sbgStreamBufferReadFloatLEUnchecked(&unchecked);
+        d[1]    = sbgStreamBufferReadDoubleLEUnchecked(&unchecked);
+        sbgStreamBufferReadFloatLEArrayUnchecked(&unchecked, fArray[1], 3);
+        sbgStreamBufferReadInt32LEArrayUnchecked(&unchecked, i32Array[1], 4);
+        sbgStreamBufferReadDoubleLEArrayUnchecked(&unchecked, dArray[1], 2);
+
+        if ((u8[0] != u8[1]) || (u16[0] != u16[1]) || (i16[0] != i16[1]) || (u32[0] != u32[1]) || (i32[0] != i32[1]) ||
+            (u64[0] != u64[1]) || (i64[0] != i64[1]) || (memcmp(&f[0], &f[1], sizeof(f[0])) != 0) || (memcmp(&d[0], &d[1], sizeof(d[0])) != 0) ||
+            (memcmp(fArray[0], fArray[1], sizeof(fArray[0])) != 0) || (memcmp(i32Array[0], i32Array[1], sizeof(i32Array[0])) != 0) ||
+            (memcmp(dArray[0], dArray[1], sizeof(dArray[0])) != 0))
+        {
+            printf("unchecked values at offset %zu differ from the checked ones\n", offset);
+            nrErrors++;
+        }
+
+        if ((sbgStreamBufferTell(&checked) != sbgStreamBufferTell(&unchecked)) || (sbgStreamBufferGetLastError(&unchecked) != SBG_NO_ERROR))
+        {
+            printf("unchecked cursor at offset %zu differs from the checked one\n", offset);
+            nrErrors++;
+        }
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Define a check of a fixed layout log decoder.
+ *
+ * Random payloads of the exact size, with and without the optional fields, must be decoded and
+ * consume the expected number of bytes. When the log can be encoded back without any loss, the
+ * encoded bytes must match the payload. A payload one byte short, or a stream already in error,
+ * must be rejected without moving the cursor.
+ *
+ * \param[in]   name                    Log name, used in the function name and the messages.
+ * \param[in]   type                    Log structure type.
+ * \param[in]   readFunc                Log reader.
+ * \param[in]   writeFunc               Log writer.
+ * \param[in]   size                    Payload size, or minimum payload size, in bytes.
+ * \param[in]   optionalSize            Size of the optional fields, in bytes.
+ * \param[in]   roundTrip               true if the log can be encoded back without any loss.
+ */
+#define UNCHECKED_CHECK_DEFINE_LOG(name, type, readFunc, writeFunc, size, optionalSize, roundTrip)                 \
+static size_t uncheckedCheckLog##name(uint32_t *pState)                                                            \
+{                                                                                                                  \
+    uint8_t                 payload[UNCHECKED_CHECK_BUFFER_SIZE];                                                  \
+    uint8_t                 output[UNCHECKED_CHECK_BUFFER_SIZE];                                                   \
+    SbgStreamBuffer         stream;                                                                                \
+    type                    logData;                                                                               \
+    size_t                  nrErrors = 0;                                                                          \
+                                                                                                                   \
+    for (size_t iteration = 0; iteration < UNCHECKED_CHECK_NR_ITERATIONS; iteration++)                             \
+    {                                                                                                              \
+        size_t              payloadSize = size + ((iteration % 2) ? optionalSize : 0);                             \
+                                                                                                                   \
+        uncheckedCheckFill(pState, payload, sizeof(payload));                                                      \
+        sbgStreamBufferInitForRead(&stream, payload, payloadSize);                                                 \
+                                                                                                                   \
+        if ((readFunc(&logData, &stream) != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != payloadSize))        \
+        {                                                                                                          \
+            printf(#name ": unable to read a %zu bytes payload\n", payloadSize);                                   \
+            nrErrors++;                                                                                            \
+        }                                                                                                          \
+        else if ((roundTrip) && (payloadSize == size + optionalSize))                                              \
+        {                                                                                                          \
+            sbgStreamBufferInitForWrite(&stream, output, sizeof(output));                                          \
+                                                                                                                   \
+            if ((writeFunc(&logData, &stream) != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != payloadSize) || \
+                (memcmp(output, payload, payloadSize) != 0))                                                       \
+            {                                                                                                      \
+                printf(#name ": round trip of a %zu bytes payload differs\n", payloadSize);                        \
+                nrErrors++;                                                                                        \
+            }                                                                                                      \
+        }                                                                                                          \
+                                                                                                                   \
+        sbgStreamBufferInitForRead(&stream, payload, size - 1);                                                    \
+                                                                                                                   \
+        if ((readFunc(&logData, &stream) != SBG_BUFFER_OVERFLOW) || (sbgStreamBufferTell(&stream) != 0))           \
+        {                                                                                                          \
+            printf(#name ": truncated payload not rejected\n");                                                    \
+            nrErrors++;                                                                                            \
+        }                                                                                                          \
+                                                                                                                   \
+        sbgStreamBufferInitForRead(&stream, payload, payloadSize);                                                 \
+        sbgStreamBufferReserve(&stream, payloadSize + 1);                                                          \
+                                                                                                                   \
+        if ((readFunc(&logData, &stream) == SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != 0))                  \
+        {                                                                                                          \
+            printf(#name ": payload decoded from a stream in error\n");                                            \
+            nrErrors++;                                                                                            \
+        }                                                                                                          \
+    }                                                                                                              \
+                                                                                                                   \
+    return nrErrors;                                                                                               \
+}
+
+UNCHECKED_CHECK_DEFINE_LOG(ImuLegacy,       SbgEComLogImuLegacy,        sbgEComLogImuLegacyReadFromStream,      sbgEComLogImuLegacyWriteToStream,       SBG_ECOM_LOG_IMU_LEGACY_SIZE,       0, true)
+UNCHECKED_CHECK_DEFINE_LOG(ImuShort,        SbgEComLogImuShort,         sbgEComLogImuShortReadFromStream,       sbgEComLogImuShortWriteToStream,        SBG_ECOM_LOG_IMU_SHORT_SIZE,        0, true)
+UNCHECKED_CHECK_DEFINE_LOG(ImuFastLegacy,   SbgEComLogImuFastLegacy,    sbgEComLogImuFastLegacyReadFromStream,  sbgEComLogImuFastLegacyWriteToStream,   SBG_ECOM_LOG_IMU_FAST_LEGACY_SIZE,  0, false)
+UNCHECKED_CHECK_DEFINE_LOG(EkfEuler,        SbgEComLogEkfEuler,         sbgEComLogEkfEulerReadFromStream,       sbgEComLogEkfEulerWriteToStream,        SBG_ECOM_LOG_EKF_EULER_MIN_SIZE,    8, true)
+UNCHECKED_CHECK_DEFINE_LOG(EkfQuat,         SbgEComLogEkfQuat,          sbgEComLogEkfQuatReadFromStream,        sbgEComLogEkfQuatWriteToStream,         SBG_ECOM_LOG_EKF_QUAT_MIN_SIZE,     8, true)
+UNCHECKED_CHECK_DEFINE_LOG(EkfNav,          SbgEComLogEkfNav,           sbgEComLogEkfNavReadFromStream,         sbgEComLogEkfNavWriteToStream,          SBG_ECOM_LOG_EKF_NAV_SIZE,          0, true)
+UNCHECKED_CHECK_DEFINE_LOG(EkfVelBody,      SbgEComLogEkfVelBody,       sbgEComLogEkfVelBodyReadFromStream,     sbgEComLogEkfVelBodyWriteToStream,      SBG_ECOM_LOG_EKF_VEL_BODY_SIZE,     0, true)
+UNCHECKED_CHECK_DEFINE_LOG(EkfRotAccel,     SbgEComLogEkfRotAccel,      sbgEComLogEkfRotAccelReadFromStream,    sbgEComLogEkfRotAccelWriteToStream,     SBG_ECOM_LOG_EKF_ROT_ACCEL_SIZE,    0, true)
+
+/*!
+ * Check that the optional magnetic fields of the euler log are only read when fully present.
+ *
+ * \param[in]   pState                  Generator state.
+ * \return                              Number of errors.
+ */
+static size_t uncheckedCheckOptionalFields(uint32_t *pState)
+{
+    uint8_t                 payload[UNCHECKED_CHECK_BUFFER_SIZE];
+    SbgStreamBuffer         stream;
+    SbgEComLogEkfEuler      logData;
+    size_t                  nrErrors = 0;
+
+    for (size_t extraSize = 0; extraSize < 8; extraSize++)
+    {
+        uncheckedCheckFill(pState, payload, sizeof(payload));
+        sbgStreamBufferInitForRead(&stream, payload, SBG_ECOM_LOG_EKF_EULER_MIN_SIZE + extraSize);
+
+        if ((sbgEComLogEkfEulerReadFromStream(&logData, &stream) != SBG_NO_ERROR) || (sbgStreamBufferTell(&stream) != SBG_ECOM_LOG_EKF_EULER_MIN_SIZE) ||
+            (!isnan(logData.magDeclination)) || (!isnan(logData.magInclination)))
+        {
+            printf("EkfEuler: partial optional fields of %zu bytes not ignored\n", extraSize);
+            nrErrors++;
+        }
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    uint32_t                state = 0x6b8b4567;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += uncheckedCheckReserve();
+    nrErrors += uncheckedCheckReaders(&state);
+
+    nrErrors += uncheckedCheckLogImuLegacy(&state);
+    nrErrors += uncheckedCheckLogImuShort(&state);
+    nrErrors += uncheckedCheckLogImuFastLegacy(&state);
+    nrErrors += uncheckedCheckLogEkfEuler(&state);
+    nrErrors += uncheckedCheckLogEkfQuat(&state);
+    nrErrors += uncheckedCheckLogEkfNav(&state);
+    nrErrors += uncheckedCheckLogEkfVelBody(&state);
+    nrErrors += uncheckedCheckLogEkfRotAccel(&state);
+    nrErrors += uncheckedCheckOptionalFields(&state);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,391 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check that commands wait for incoming data instead of sleeping.
+ *
+ * A memory interface is given a wait method that reports pending data at once, lets an answer
+ * arrive during the wait, or waits for the whole time out. Commands must time out after their
+ * time out only, complete as soon as their answer arrives, and never wait for data already
+ * received, including the pages of a large transfer.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define WAIT_CHECK_TIME_OUT                 (50)            /*!< Command time out, in ms. */
+#define WAIT_CHECK_MAX_DURATION             (1000)          /*!< Maximum duration of a command that doesn't time out, in ms. */
+#define WAIT_CHECK_MAX_FRAME_SIZE           (64)            /*!< Maximum size of a frame written by the wait method, in bytes. */
+#define WAIT_CHECK_LARGE_SIZE               (9000)          /*!< Payload size of the large transfer, in bytes. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context.
+ */
+typedef struct _WaitCheckContext
+{
+    size_t                  nrWaits;                        /*!< Number of calls to the wait method. */
+    size_t                  nrBlockingWaits;                /*!< Number of calls to the wait method without any pending data. */
+    uint32_t                maxTimeOut;                     /*!< Maximum time out passed to the wait method, in us. */
+    uint8_t                 frame[WAIT_CHECK_MAX_FRAME_SIZE];   /*!< Frame written by the next blocking wait. */
+    size_t                  frameSize;                      /*!< Size of the frame written by the next blocking wait, 0 if none. */
+} WaitCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check context, shared with the wait method.
+ */
+static WaitCheckContext     gWaitCheckContext;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Wait method of the memory interface.
+ *
+ * Returns immediately if data is pending. Otherwise, the data arrives during the wait if a frame is
+ * set in the check context, or the wait lasts for the whole time out.
+ *
+ * \param[in]   pInterface              Memory interface.
+ * \param[in]   timeOut                 Maximum time to wait, in us.
+ * \return                              SBG_NO_ERROR if data may be read, SBG_TIME_OUT if no data has been received in time.
+ */
+static SbgErrorCode waitCheckWait(SbgInterface *pInterface, uint32_t timeOut)
+{
+    WaitCheckContext       *pContext = &gWaitCheckContext;
+    SbgErrorCode            errorCode;
+
+    assert(pInterface);
+
+    pContext->nrWaits++;
+    pContext->maxTimeOut = sbgMax(pContext->maxTimeOut, timeOut);
+
+    if (testInterfaceMemoryGetNrPendingBytes(pInterface) != 0)
+    {
+        errorCode = SBG_NO_ERROR;
+    }
+    else
+    {
+        pContext->nrBlockingWaits++;
+
+        if (pContext->frameSize != 0)
+        {
+            sbgInterfaceWrite(pInterface, pContext->frame, pContext->frameSize);
+            pContext->frameSize = 0;
+
+            errorCode = SBG_NO_ERROR;
+        }
+        else
+        {
+            sbgSleep((timeOut + 999) / 1000);
+
+            errorCode = SBG_TIME_OUT;
+        }
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Reset the wait statistics of the check context.
+ */
+static void waitCheckReset(void)
+{
+    gWaitCheckContext.nrWaits           = 0;
+    gWaitCheckContext.nrBlockingWaits   = 0;
+    gWaitCheckContext.maxTimeOut        = 0;
+    gWaitCheckContext.frameSize         = 0;
+}
+
+/*!
+ * Encode a frame.
+ *
+ * \param[in]   msgClass                Message class.
+ * \param[in]   msgId                   Message ID.
+ * \param[in]   pPayload                Payload.
+ * \param[in]   payloadSize             Payload size, in bytes.
+ * \param[out]  pFrames                 Encoded frames.
+ * \param[in]   maxSize                 Size of the frame buffer, in bytes.
+ * \return                              Size of the encoded frames, in bytes.
+ */
+static size_t waitCheckEncode(uint8_t msgClass, uint8_t msgId, const void *pPayload, size_t payloadSize, uint8_t *pFrames, size_t maxSize)
+{
+    SbgInterface            encoderInterface;
+    SbgEComProtocol         encoder;
+    size_t                  size = 0;
+
+    testInterfaceMemoryCreate(&encoderInterface, 0);
+    sbgEComProtocolInit(&encoder, &encoderInterface);
+
+    sbgEComProtocolSend(&encoder, msgClass, msgId, pPayload, payloadSize);
+    sbgInterfaceRead(&encoderInterface, pFrames, &size, maxSize);
+
+    sbgEComProtocolClose(&encoder);
+    sbgInterfaceDestroy(&encoderInterface);
+
+    return size;
+}
+
+/*!
+ * Encode an ACK.
+ *
+ * \param[in]   msgClass                Class of the acknowledged command.
+ * \param[in]   msgId                   ID of the acknowledged command.
+ * \param[out]  pFrame                  Encoded frame.
+ * \param[in]   maxSize                 Size of the frame buffer, in bytes.
+ * \return                              Size of the encoded frame, in bytes.
+ */
+static size_t waitCheckEncodeAck(uint8_t msgClass, uint8_t msgId, uint8_t *pFrame, size_t maxSize)
+{
+    uint8_t                 payload[4];
+
+    payload[0] = msgId;
+    payload[1] = msgClass;
+    payload[2] = 0;
+    payload[3] = 0;
+
+    return waitCheckEncode(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK, payload, sizeof(payload), pFrame, maxSize);
+}
+
+/*!
+ * Check the wait fallback of interfaces without a wait method.
+ *
+ * \return                              Number of errors.
+ */
+static size_t waitCheckFallback(void)
+{
+    SbgInterface            interface;
+    size_t                  nrErrors = 0;
+
+    testInterfaceMemoryCreate(&interface, 0);
+
+    if ((interface.pWaitFunc != NULL) || (sbgInterfaceWait(&interface, 0) != SBG_NO_ERROR) || (sbgInterfaceWait(&interface, 5000) != SBG_NO_ERROR))
+    {
+        printf("wait fallback doesn't report that data may be read\n");
+        nrErrors++;
+    }
+
+    sbgInterfaceDestroy(&interface);
+
+    return nrErrors;
+}
+
+/*!
+ * Check the command reception waits.
+ *
+ * \param[in]   pHandle                 sbgECom handle, on a memory interface with the check wait method.
+ * \return                              Number of errors.
+ */
+static size_t waitCheckCommands(SbgEComHandle *pHandle)
+{
+    WaitCheckContext       *pContext = &gWaitCheckContext;
+    SbgInterface           *pInterface = pHandle->protocolHandle.pLinkedInterface;
+    SbgEComProtocolPayload  payload;
+    SbgErrorCode            errorCode;
+    uint8_t                 frame[WAIT_CHECK_MAX_FRAME_SIZE];
+    size_t                  frameSize;
+    uint32_t                start;
+    uint32_t                duration;
+    size_t                  nrErrors = 0;
+
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    //
+    // No answer, the command must wait on the interface up to its time out
+    //
+    waitCheckReset();
+    start       = sbgGetTime();
+    errorCode   = sbgEComReceiveCmd2(pHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO, &payload, WAIT_CHECK_TIME_OUT);
+    duration    = sbgGetTime() - start;
+
+    if ((errorCode != SBG_TIME_OUT) || (duration < WAIT_CHECK_TIME_OUT) || (duration > WAIT_CHECK_MAX_DURATION))
+    {
+        printf("no answer: %s after %" PRIu32 " ms\n", sbgErrorCodeToString(errorCode), duration);
+        nrErrors++;
+    }
+
+    if ((pContext->nrBlockingWaits == 0) || (pContext->maxTimeOut > WAIT_CHECK_TIME_OUT * 1000))
+    {
+        printf("no answer: %zu waits, up to %" PRIu32 " us\n", pContext->nrBlockingWaits, pContext->maxTimeOut);
+        nrErrors++;
+    }
+
+    //
+    // Answer received during the wait, the command must complete at once
+    //
+    waitCheckReset();
+    pContext->frameSize = waitCheckEncodeAck(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SETTINGS_ACTION, pContext->frame, sizeof(pContext->frame));
+
+    start       = sbgGetTime();
+    errorCode   = sbgEComWaitForAck(pHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SETTINGS_ACTION, WAIT_CHECK_MAX_DURATION);
+    duration    = sbgGetTime() - start;
+
+    if ((errorCode != SBG_NO_ERROR) || (pContext->nrBlockingWaits != 1) || (duration >= WAIT_CHECK_MAX_DURATION))
+    {
+        printf("answer during the wait: %s after %zu waits and %" PRIu32 " ms\n", sbgErrorCodeToString(errorCode), pContext->nrBlockingWaits, duration);
+        nrErrors++;
+    }
+
+    //
+    // Answer already received, the command must not wait at all
+    //
+    waitCheckReset();
+    frameSize = waitCheckEncodeAck(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SETTINGS_ACTION, frame, sizeof(frame));
+    sbgInterfaceWrite(pInterface, frame, frameSize);
+
+    errorCode = sbgEComWaitForAck(pHandle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SETTINGS_ACTION, WAIT_CHECK_MAX_DURATION);
+
+    if ((errorCode != SBG_NO_ERROR) || (pContext->nrWaits != 0))
+    {
+        printf("answer already received: %s after %zu waits\n", sbgErrorCodeToString(errorCode), pContext->nrWaits);
+        nrErrors++;
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+
+    return nrErrors;
+}
+
+/*!
+ * Check that the pages of a large transfer already received are consumed without waiting.
+ *
+ * The handle is given a reception buffer large enough to hold all the pages at once.
+ *
+ * \return                              Number of errors.
+ */
+static size_t waitCheckLargeTransfer(void)
+{
+    WaitCheckContext       *pContext = &gWaitCheckContext;
+    SbgInterface            interface;
+    SbgEComHandle           handle;
+    SbgEComProtocolPayload  payload;
+    SbgErrorCode            errorCode;
+    uint8_t                *pPayload;
+    uint8_t                *pFrames;
+    size_t                  framesSize;
+    size_t                  nrErrors = 0;
+
+    pPayload    = malloc(WAIT_CHECK_LARGE_SIZE);
+    pFrames     = malloc(2 * WAIT_CHECK_LARGE_SIZE);
+    assert(pPayload && pFrames);
+
+    for (size_t i = 0; i < WAIT_CHECK_LARGE_SIZE; i++)
+    {
+        pPayload[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+
+    framesSize = waitCheckEncode(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO, pPayload, WAIT_CHECK_LARGE_SIZE, pFrames, 2 * WAIT_CHECK_LARGE_SIZE);
+
+    testInterfaceMemoryCreate(&interface, 0);
+    interface.pWaitFunc = waitCheckWait;
+
+    sbgEComInitWithRxBuffer(&handle, &interface, NULL, 2 * WAIT_CHECK_LARGE_SIZE);
+
+    waitCheckReset();
+    sbgInterfaceWrite(&interface, pFrames, framesSize);
+    sbgEComProtocolPayloadConstruct(&payload);
+
+    errorCode = sbgEComReceiveCmd2(&handle, SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO, &payload, WAIT_CHECK_TIME_OUT);
+
+    if ((errorCode != SBG_NO_ERROR) || (sbgEComProtocolPayloadGetSize(&payload) != WAIT_CHECK_LARGE_SIZE) ||
+        (memcmp(sbgEComProtocolPayloadGetBuffer(&payload), pPayload, WAIT_CHECK_LARGE_SIZE) != 0))
+    {
+        printf("large transfer: %s\n", sbgErrorCodeToString(errorCode));
+        nrErrors++;
+    }
+
+    if (pContext->nrBlockingWaits != 0)
+    {
+        printf("large transfer: %zu waits for pages already received\n", pContext->nrBlockingWaits);
+        nrErrors++;
+    }
+
+    sbgEComProtocolPayloadDestroy(&payload);
+    sbgEComClose(&handle);
+    sbgInterfaceDestroy(&interface);
+
+    free(pPayload);
+    free(pFrames);
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    SbgInterface            interface;
+    SbgEComHandle           handle;
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    nrErrors += waitCheckFallback();
+
+    testInterfaceMemoryCreate(&interface, 0);
+    interface.pWaitFunc = waitCheckWait;
+
+    sbgEComInit(&handle, &interface);
+
+    nrErrors += waitCheckCommands(&handle);
+
+    sbgEComClose(&handle);
+    sbgInterfaceDestroy(&interface);
+
+    nrErrors += waitCheckLargeTransfer();
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,520 @@
+﻿/*!
+ * \file            main.c
+ * \author          SBG Systems
+ * \date            17/10/2026
+ *
+ * \brief           Check scatter-gather writes.
+ *
+ * Payloads of several sizes, up to large transfers, are sent to interfaces with and without
+ * scatter-gather write support. The written bytes must match the copying path, frames must be
+ * written in a single call each, and with scatter-gather writes the payload must never be copied.
+ * Buffers written to a UDP interface over the loopback interface must arrive in datagrams of at
+ * most 1400 bytes.
+ *
+ * \copyright       Copyright (C) 2007-2024, SBG Systems SAS. All rights reserved.
+ * \beginlicense    The MIT license
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * \endlicense
+ */
+
+// sbgCommonLib headers
+#include <sbgCommon.h>
+#include <interfaces/sbgInterfaceUdp.h>
+#include <network/sbgNetwork.h>
+
+// sbgECom headers
+#include <sbgEComLib.h>
+
+// Test headers
+#include "testInterfaceMemory.h"
+
+//----------------------------------------------------------------------//
+//- Constant definitions                                               -//
+//----------------------------------------------------------------------//
+
+#define WRITEV_CHECK_MAX_SIZE               (65536)         /*!< Maximum number of bytes recorded. */
+#define WRITEV_CHECK_UDP_PACKET_MAX_SIZE    (1400)          /*!< Maximum size of the datagrams sent by UDP interfaces, in bytes. */
+#define WRITEV_CHECK_UDP_PORT               (47810)         /*!< First UDP port used on the loopback interface. */
+
+//----------------------------------------------------------------------//
+//- Structure definitions                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Interface recording written bytes and write calls.
+ */
+typedef struct _WriteVCheckRecorder
+{
+    uint8_t                 buffer[WRITEV_CHECK_MAX_SIZE];  /*!< Bytes written. */
+    size_t                  size;                           /*!< Number of bytes written. */
+    size_t                  nrWriteCalls;                   /*!< Number of write calls. */
+    size_t                  nrWriteVCalls;                  /*!< Number of scatter-gather write calls. */
+    const uint8_t          *pPayload;                       /*!< Payload sent, NULL if unknown. */
+    size_t                  payloadSize;                    /*!< Payload size, in bytes. */
+    size_t                  nrPayloadBytesReferenced;       /*!< Number of bytes written directly from the payload buffer. */
+} WriteVCheckRecorder;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Recorder, too large for the stack.
+ */
+static WriteVCheckRecorder  gWriteVCheckRecorder;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Record a buffer.
+ *
+ * \param[in]   pRecorder               Recorder.
+ * \param[in]   pBuffer                 Buffer.
+ * \param[in]   size                    Buffer size, in bytes.
+ * \return                              SBG_NO_ERROR if the buffer has been recorded.
+ */
+static SbgErrorCode writeVCheckRecord(WriteVCheckRecorder *pRecorder, const void *pBuffer, size_t size)
+{
+    SbgErrorCode            errorCode;
+
+    assert(pRecorder);
+
+    if (size <= (WRITEV_CHECK_MAX_SIZE - pRecorder->size))
+    {
+        const uint8_t      *pBytes = pBuffer;
+
+        memcpy(&pRecorder->buffer[pRecorder->size], pBuffer, size);
+        pRecorder->size += size;
+
+        if (pRecorder->pPayload && (pBytes >= pRecorder->pPayload) && (pBytes < (pRecorder->pPayload + pRecorder->payloadSize)))
+        {
+            pRecorder->nrPayloadBytesReferenced += size;
+        }
+
+        errorCode = SBG_NO_ERROR;
+    }
+    else
+    {
+        errorCode = SBG_BUFFER_OVERFLOW;
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Write method of the recording interface.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[in]   pBuffer                 Buffer.
+ * \param[in]   bytesToWrite            Number of bytes to write.
+ * \return                              SBG_NO_ERROR if the bytes have been written.
+ */
+static SbgErrorCode writeVCheckWrite(SbgInterface *pInterface, const void *pBuffer, size_t bytesToWrite)
+{
+    WriteVCheckRecorder    *pRecorder;
+
+    assert(pInterface);
+
+    pRecorder = pInterface->handle;
+    pRecorder->nrWriteCalls++;
+
+    return writeVCheckRecord(pRecorder, pBuffer, bytesToWrite);
+}
+
+/*!
+ * Scatter-gather write method of the recording interface.
+ *
+ * \param[in]   pInterface              Interface.
+ * \param[in]   pIoVecs                 Array of buffer descriptors.
+ * \param[in]   nrIoVecs                Number of buffer descriptors.
+ * \return                              SBG_NO_ERROR if the bytes have been written.
+ */
+static SbgErrorCode writeVCheckWriteV(SbgInterface *pInterface, const SbgInterfaceIoVec *pIoVecs, size_t nrIoVecs)
+{
+    SbgErrorCode            errorCode = SBG_NO_ERROR;
+    WriteVCheckRecorder    *pRecorder;
+
+    assert(pInterface);
+
+    pRecorder = pInterface->handle;
+    pRecorder->nrWriteVCalls++;
+
+    for (size_t i = 0; (i < nrIoVecs) && (errorCode == SBG_NO_ERROR); i++)
+    {
+        errorCode = writeVCheckRecord(pRecorder, pIoVecs[i].pBuffer, pIoVecs[i].size);
+    }
+
+    return errorCode;
+}
+
+/*!
+ * Initialize a recording interface.
+ *
+ * \param[out]  pInterface              Interface.
+ * \param[in]   pRecorder               Recorder.
+ * \param[in]   useWriteV               True to implement scatter-gather writes.
+ */
+static void writeVCheckInitRecorder(SbgInterface *pInterface, WriteVCheckRecorder *pRecorder, bool useWriteV)
+{
+    assert(pInterface);
+    assert(pRecorder);
+
+    memset(pRecorder, 0, sizeof(*pRecorder));
+
+    sbgInterfaceZeroInit(pInterface);
+    sbgInterfaceNameSet(pInterface, "recorder");
+
+    pInterface->handle      = pRecorder;
+    pInterface->pWriteFunc  = writeVCheckWrite;
+
+    if (useWriteV)
+    {
+        pInterface->pWriteVFunc = writeVCheckWriteV;
+    }
+}
+
+/*!
+ * Get the number of frames sent for a payload.
+ *
+ * \param[in]   size                    Payload size, in bytes.
+ * \return                              Number of frames.
+ */
+static size_t writeVCheckGetNrFrames(size_t size)
+{
+    size_t                  nrFrames;
+
+    if (size <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+    {
+        nrFrames = 1;
+    }
+    else
+    {
+        nrFrames = (size + SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE - 1) / SBG_ECOM_MAX_EXTENDED_PAYLOAD_SIZE;
+    }
+
+    return nrFrames;
+}
+
+/*!
+ * Check frames sent with and without scatter-gather writes against the copying path.
+ *
+ * \param[in]   pPayload                Payload.
+ * \param[in]   size                    Payload size, in bytes.
+ * \return                              Number of errors.
+ */
+static size_t writeVCheckSend(const uint8_t *pPayload, size_t size)
+{
+    SbgErrorCode            errorCode;
+    WriteVCheckRecorder    *pRecorder = &gWriteVCheckRecorder;
+    SbgInterface            memoryInterface;
+    SbgEComProtocol         protocol;
+    uint8_t                *pReference = NULL;
+    size_t                  referenceSize = 0;
+    size_t                  nrErrors = 0;
+
+    //
+    // The memory interface doesn't implement scatter-gather writes, frames are assembled and copied.
+    //
+    errorCode = testInterfaceMemoryCreate(&memoryInterface, 0);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        sbgEComProtocolInit(&protocol, &memoryInterface);
+
+        errorCode = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, 0x2a, pPayload, size);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            referenceSize   = testInterfaceMemoryGetNrPendingBytes(&memoryInterface);
+            pReference      = malloc(referenceSize);
+
+            if (pReference)
+            {
+                errorCode = sbgInterfaceRead(&memoryInterface, pReference, &referenceSize, referenceSize);
+            }
+            else
+            {
+                errorCode = SBG_MALLOC_FAILED;
+            }
+        }
+
+        sbgEComProtocolClose(&protocol);
+        sbgInterfaceDestroy(&memoryInterface);
+    }
+
+    //
+    // A frame holding the whole payload must match a frame generated in a stream buffer.
+    //
+    if ((errorCode == SBG_NO_ERROR) && (size <= SBG_ECOM_MAX_PAYLOAD_SIZE))
+    {
+        static uint8_t      frame[SBG_ECOM_MAX_BUFFER_SIZE];
+        SbgStreamBuffer     outputStream;
+        size_t              streamCursor;
+
+        sbgStreamBufferInitForWrite(&outputStream, frame, sizeof(frame));
+        sbgEComStartFrameGeneration(&outputStream, SBG_ECOM_CLASS_LOG_ECOM_0, 0x2a, &streamCursor);
+        sbgStreamBufferWriteBuffer(&outputStream, pPayload, size);
+        sbgEComFinalizeFrameGeneration(&outputStream, streamCursor);
+
+        if ((sbgStreamBufferGetLength(&outputStream) != referenceSize) || (memcmp(frame, pReference, referenceSize) != 0))
+        {
+            printf("size %zu: copied frame differs from the generated frame\n", size);
+            nrErrors++;
+        }
+    }
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        SbgInterface        recorderInterface;
+
+        //
+        // With scatter-gather writes, each frame is written at once, directly from the payload buffer.
+        //
+        writeVCheckInitRecorder(&recorderInterface, pRecorder, true);
+        pRecorder->pPayload     = pPayload;
+        pRecorder->payloadSize  = size;
+
+        sbgEComProtocolInit(&protocol, &recorderInterface);
+        errorCode = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, 0x2a, pPayload, size);
+        sbgEComProtocolClose(&protocol);
+
+        if ((errorCode != SBG_NO_ERROR) || (pRecorder->size != referenceSize) || (memcmp(pRecorder->buffer, pReference, referenceSize) != 0))
+        {
+            printf("size %zu: scatter-gather write differs from the copying path\n", size);
+            nrErrors++;
+        }
+
+        if ((pRecorder->nrWriteCalls != 0) || (pRecorder->nrWriteVCalls != writeVCheckGetNrFrames(size)) || (pRecorder->nrPayloadBytesReferenced != size))
+        {
+            printf("size %zu: %zu writes, %zu scatter-gather writes, %zu payload bytes not copied\n", size, pRecorder->nrWriteCalls, pRecorder->nrWriteVCalls, pRecorder->nrPayloadBytesReferenced);
+            nrErrors++;
+        }
+
+        //
+        // Without scatter-gather writes, each frame is assembled and written at once.
+        //
+        writeVCheckInitRecorder(&recorderInterface, pRecorder, false);
+
+        sbgEComProtocolInit(&protocol, &recorderInterface);
+        errorCode = sbgEComProtocolSend(&protocol, SBG_ECOM_CLASS_LOG_ECOM_0, 0x2a, pPayload, size);
+        sbgEComProtocolClose(&protocol);
+
+        if ((errorCode != SBG_NO_ERROR) || (pRecorder->size != referenceSize) || (memcmp(pRecorder->buffer, pReference, referenceSize) != 0) ||
+            (pRecorder->nrWriteCalls != writeVCheckGetNrFrames(size)))
+        {
+            printf("size %zu: write without scatter-gather support differs from the copying path\n", size);
+            nrErrors++;
+        }
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to send payload");
+        nrErrors++;
+    }
+
+    free(pReference);
+
+    return nrErrors;
+}
+
+/*!
+ * Check the fallback of scatter-gather writes on interfaces without support.
+ *
+ * \return                              Number of errors.
+ */
+static size_t writeVCheckFallback(void)
+{
+    static const uint8_t    first[] = { 1, 2, 3 };
+    static const uint8_t    second[] = { 4, 5, 6, 7 };
+    static const uint8_t    expected[] = { 1, 2, 3, 4, 5, 6, 7 };
+    SbgErrorCode            errorCode;
+    WriteVCheckRecorder    *pRecorder = &gWriteVCheckRecorder;
+    SbgInterface            recorderInterface;
+    SbgInterfaceIoVec       ioVecs[3];
+    size_t                  nrErrors = 0;
+
+    ioVecs[0].pBuffer   = first;
+    ioVecs[0].size      = sizeof(first);
+    ioVecs[1].pBuffer   = NULL;
+    ioVecs[1].size      = 0;
+    ioVecs[2].pBuffer   = second;
+    ioVecs[2].size      = sizeof(second);
+
+    writeVCheckInitRecorder(&recorderInterface, pRecorder, false);
+
+    errorCode = sbgInterfaceWriteV(&recorderInterface, ioVecs, SBG_ARRAY_SIZE(ioVecs));
+
+    //
+    // Empty buffers are skipped.
+    //
+    if ((errorCode != SBG_NO_ERROR) || (pRecorder->nrWriteCalls != 2) || (pRecorder->size != sizeof(expected)) || (memcmp(pRecorder->buffer, expected, sizeof(expected)) != 0))
+    {
+        printf("fallback: buffers not written in turn\n");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+/*!
+ * Check scatter-gather writes on a UDP interface over the loopback interface.
+ *
+ * \param[in]   pPayload                Payload, at least 5000 bytes.
+ * \return                              Number of errors.
+ */
+static size_t writeVCheckUdp(const uint8_t *pPayload)
+{
+    static const size_t     ioVecSizes[] = { 11, 0, 1389, 1, 1400, 1500, 699 };
+    SbgErrorCode            errorCode;
+    SbgInterface            senderInterface;
+    SbgInterface            receiverInterface;
+    SbgInterfaceIoVec       ioVecs[SBG_ARRAY_SIZE(ioVecSizes)];
+    size_t                  totalSize = 0;
+    size_t                  nrErrors = 0;
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(ioVecSizes); i++)
+    {
+        ioVecs[i].pBuffer   = &pPayload[totalSize];
+        ioVecs[i].size      = ioVecSizes[i];
+
+        totalSize += ioVecSizes[i];
+    }
+
+    errorCode = sbgInterfaceUdpCreate(&receiverInterface, sbgIpAddr(127, 0, 0, 1), WRITEV_CHECK_UDP_PORT + 1, WRITEV_CHECK_UDP_PORT);
+
+    if (errorCode == SBG_NO_ERROR)
+    {
+        errorCode = sbgInterfaceUdpCreate(&senderInterface, sbgIpAddr(127, 0, 0, 1), WRITEV_CHECK_UDP_PORT, WRITEV_CHECK_UDP_PORT + 1);
+
+        if (errorCode == SBG_NO_ERROR)
+        {
+            errorCode = sbgInterfaceWriteV(&senderInterface, ioVecs, SBG_ARRAY_SIZE(ioVecs));
+
+            if (errorCode == SBG_NO_ERROR)
+            {
+                static uint8_t  received[WRITEV_CHECK_MAX_SIZE];
+                size_t          receivedSize = 0;
+                size_t          nrDatagrams = 0;
+                uint32_t        startTime;
+
+                startTime = sbgGetTime();
+
+                while ((receivedSize < totalSize) && ((sbgGetTime() - startTime) < 1000))
+                {
+                    size_t      nrBytesRead;
+
+                    errorCode = sbgInterfaceRead(&receiverInterface, &received[receivedSize], &nrBytesRead, sizeof(received) - receivedSize);
+
+                    if (errorCode != SBG_NO_ERROR)
+                    {
+                        break;
+                    }
+
+                    if (nrBytesRead != 0)
+                    {
+                        if (nrBytesRead > WRITEV_CHECK_UDP_PACKET_MAX_SIZE)
+                        {
+                            printf("UDP: datagram of %zu bytes\n", nrBytesRead);
+                            nrErrors++;
+                        }
+
+                        receivedSize += nrBytesRead;
+                        nrDatagrams++;
+                    }
+                    else
+                    {
+                        sbgSleep(1);
+                    }
+                }
+
+                if ((receivedSize != totalSize) || (memcmp(received, pPayload, totalSize) != 0))
+                {
+                    printf("UDP: %zu bytes received instead of %zu\n", receivedSize, totalSize);
+                    nrErrors++;
+                }
+
+#ifndef WIN32
+                //
+                // Buffers are gathered in full datagrams.
+                //
+                if (nrDatagrams != ((totalSize + WRITEV_CHECK_UDP_PACKET_MAX_SIZE - 1) / WRITEV_CHECK_UDP_PACKET_MAX_SIZE))
+                {
+                    printf("UDP: %zu datagrams received\n", nrDatagrams);
+                    nrErrors++;
+                }
+#endif // WIN32
+            }
+
+            sbgInterfaceDestroy(&senderInterface);
+        }
+
+        sbgInterfaceDestroy(&receiverInterface);
+    }
+
+    if (errorCode != SBG_NO_ERROR)
+    {
+        SBG_LOG_ERROR(errorCode, "unable to check UDP interfaces");
+        nrErrors++;
+    }
+
+    return nrErrors;
+}
+
+//----------------------------------------------------------------------//
+//  Main program                                                        //
+//----------------------------------------------------------------------//
+
+/*!
+ * Program entry point.
+ *
+ * \param[in]   argc                    Number of input arguments.
+ * \param[in]   argv                    Input arguments as an array of strings.
+ * \return                              EXIT_SUCCESS if successful.
+ */
+int main(int argc, char** argv)
+{
+    static const size_t     sizes[] = { 0, 1, 100, SBG_ECOM_MAX_PAYLOAD_SIZE, SBG_ECOM_MAX_PAYLOAD_SIZE + 1, 10000, 20000 };
+    static uint8_t          payload[20000];
+    size_t                  nrErrors = 0;
+
+    SBG_UNUSED_PARAMETER(argc);
+    SBG_UNUSED_PARAMETER(argv);
+
+    for (size_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = (uint8_t)((i * 131) ^ (i >> 8));
+    }
+
+    for (size_t i = 0; i < SBG_ARRAY_SIZE(sizes); i++)
+    {
+        nrErrors += writeVCheckSend(payload, sizes[i]);
+    }
+
+    nrErrors += writeVCheckFallback();
+    nrErrors += writeVCheckUdp(payload);
+
+    printf("%zu errors\n", nrErrors);
+
+    return (nrErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}